@@ -37,7 +37,6 @@ sys.path.append( '../pymod' )
 
 from osgeo import gdal
 
-import ogrtest
 import gdaltest
 
 ###############################################################################
@@ -51,9 +50,6 @@ def cutline_1():
 
 def cutline_2():
 
-    if not ogrtest.have_geos():
-        return 'skip'
-
     tst = gdaltest.GDALTest( 'VRT', 'cutline_blend.vrt', 1, 21395 )
     return tst.testOpen()
 
@@ -61,18 +57,41 @@ def cutline_2():
 
 def cutline_3():
 
-    if not ogrtest.have_geos():
-        return 'skip'
-
     tst = gdaltest.GDALTest( 'VRT', 'cutline_multipolygon.vrt', 1, 20827 )
     return tst.testOpen()
 
+###############################################################################
+# Check that the blended mask does not depend on the chunking, by warping
+# cutline_blend.vrt by 16x16 blocks.
+
+def cutline_4():
+
+    vrt_xml = open('data/cutline_blend.vrt').read()
+    vrt_xml = vrt_xml.replace('<BlockXSize>512</BlockXSize>',
+                              '<BlockXSize>16</BlockXSize>')
+    vrt_xml = vrt_xml.replace('<BlockYSize>128</BlockYSize>',
+                              '<BlockYSize>16</BlockYSize>')
+    vrt_xml = vrt_xml.replace('relativeToVRT="1">../../gcore',
+                              'relativeToVRT="0">../gcore')
+
+    ds = gdal.Open( vrt_xml )
+    cs = ds.GetRasterBand(1).Checksum()
+    ds = None
+
+    if cs != 21395:
+        gdaltest.post_reason( 'did not get expected checksum' )
+        print(cs)
+        return 'fail'
+
+    return 'success'
+
 ###############################################################################
 
 gdaltest_list = [
     cutline_1,
     cutline_2,
-    cutline_3
+    cutline_3,
+    cutline_4
     ]
 
 if __name__ == '__main__':
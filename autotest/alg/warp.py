@@ -1213,6 +1213,256 @@ def warp_39():
     os.unlink(out_file)
     return 'success'
 
+###############################################################################
+# Test that ChunkAndWarpMulti() with various number of threads produces the
+# same result as ChunkAndWarpImage(), with many chunks
+
+def warp_40():
+
+    if test_cli_utilities.get_gdalwarp_path() is None:
+        return 'skip'
+
+    src_ds = gdal.GetDriverByName('GTiff').Create('tmp/warp_40_src.tif', 400, 400)
+    src_ds.SetGCPs( [ gdal.GCP(0, 0, 0, 0, 0),
+                      gdal.GCP(410, 30, 0, 400, 0),
+                      gdal.GCP(-20, 390, 0, 0, 400),
+                      gdal.GCP(380, 430, 0, 400, 400),
+                      gdal.GCP(195, 210, 0, 200, 200) ], '' )
+    data = ''.join([ chr((i * 7 + (i // 400) * 13) % 251) for i in range(400 * 400) ])
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 400, 400, data)
+    src_ds = None
+
+    ref_cs = None
+    for options in [ '', '-multi', '-multi -wo NUM_THREADS=3',
+                     '-multi -wo NUM_THREADS=ALL_CPUS', '-multi -wo NUM_THREADS=16',
+                     '-multi -co TILED=YES -co BLOCKXSIZE=32 -co BLOCKYSIZE=32' ]:
+        try:
+            os.unlink('tmp/warp_40_dst.tif')
+        except:
+            pass
+        gdaltest.runexternal(test_cli_utilities.get_gdalwarp_path() +
+            ' -tps -et 0 -r cubic -wm 100000 ' + options +
+            ' tmp/warp_40_src.tif tmp/warp_40_dst.tif')
+
+        ds = gdal.Open('tmp/warp_40_dst.tif')
+        cs = ds.GetRasterBand(1).Checksum()
+        ds = None
+
+        if ref_cs is None:
+            ref_cs = cs
+        elif cs != ref_cs:
+            gdaltest.post_reason('failure with options "%s"' % options)
+            print(cs)
+            print(ref_cs)
+            return 'fail'
+
+    os.unlink('tmp/warp_40_src.tif')
+    os.unlink('tmp/warp_40_dst.tif')
+
+    return 'success'
+
+###############################################################################
+# Test that the separable cubic spline and lanczos resampling, used for
+# scale-only warps, gives the same result as the general case
+
+def warp_41():
+
+    if test_cli_utilities.get_gdalwarp_path() is None:
+        return 'skip'
+
+    for resampling in [ 'cubicspline', 'lanczos' ]:
+        for options in [ '-ts 67 43', '-ts 13 7', '-ts 67 43 -srcnodata 107',
+                         '-ts 40 13 -srcnodata 107 -dstalpha' ]:
+            for dst_file in [ 'tmp/warp_41_general.tif', 'tmp/warp_41.tif' ]:
+                try:
+                    os.unlink(dst_file)
+                except:
+                    pass
+            cmd = test_cli_utilities.get_gdalwarp_path() + \
+                  ' -ot Float32 -r ' + resampling + ' ' + options + \
+                  ' ../gcore/data/byte.tif '
+            gdaltest.runexternal(cmd + 'tmp/warp_41.tif')
+            gdaltest.runexternal(cmd + '-wo USE_GENERAL_CASE=TRUE tmp/warp_41_general.tif')
+
+            ds = gdal.Open('tmp/warp_41.tif')
+            ref_ds = gdal.Open('tmp/warp_41_general.tif')
+            maxdiff = gdaltest.compare_ds(ds, ref_ds, verbose = 0)
+            ds = None
+            ref_ds = None
+
+            if maxdiff > 1e-3:
+                gdaltest.post_reason('failure with %s %s' % (resampling, options))
+                print(maxdiff)
+                return 'fail'
+
+    os.unlink('tmp/warp_41.tif')
+    os.unlink('tmp/warp_41_general.tif')
+
+    return 'success'
+
+###############################################################################
+# Test that the optimized kernels for the non complex data types give the
+# same result as the general case, with and without masks
+
+def warp_42():
+
+    if test_cli_utilities.get_gdalwarp_path() is None:
+        return 'skip'
+
+    import struct
+
+    # data type, struct format, scale, offset
+    datatypes = [ (gdal.GDT_Byte, 'B', 1, 0),
+                  (gdal.GDT_Int16, 'h', 250, -32000),
+                  (gdal.GDT_UInt16, 'H', 250, 0),
+                  (gdal.GDT_Int32, 'i', 100000, -12500000),
+                  (gdal.GDT_UInt32, 'I', 1000000, 0),
+                  (gdal.GDT_Float32, 'f', 1. / 7, -18),
+                  (gdal.GDT_Float64, 'd', 1. / 7, -18) ]
+
+    for (datatype, fmt, scale, offset) in datatypes:
+        src_ds = gdal.GetDriverByName('GTiff').Create('tmp/warp_42_src.tif', 40, 30, 1, datatype)
+        src_ds.SetGCPs( [ gdal.GCP(0, 0, 0, 0, 0),
+                          gdal.GCP(35, 20, 0, 40, 0),
+                          gdal.GCP(-15, 26, 0, 0, 30),
+                          gdal.GCP(20, 46, 0, 40, 30) ], '' )
+        values = [ ((i * 7 + (i // 40) * 13) % 251) * scale + offset for i in range(40 * 30) ]
+        if fmt not in ('f', 'd'):
+            values = [ int(v) for v in values ]
+        src_ds.GetRasterBand(1).WriteRaster(0, 0, 40, 30, struct.pack(fmt * 40 * 30, *values))
+        src_ds = None
+
+        nodata = str(values[0])
+
+        for resampling in [ 'near', 'bilinear', 'cubic', 'cubicspline' ]:
+            if resampling == 'near':
+                mask_options = [ '', '-dstalpha',
+                                 '-srcnodata %s -dstnodata %s' % (nodata, nodata),
+                                 '-srcnodata %s -dstalpha' % nodata ]
+            else:
+                mask_options = [ '', '-dstalpha', '-dstnodata %s' % nodata ]
+
+            for options in mask_options:
+                # Without any mask, the Byte and Int16 cubic spline kernels
+                # flip the sampling over the edges of the source image, as
+                # they always did, instead of clipping the kernel like the
+                # general case.
+                if resampling == 'cubicspline' and options == '' and \
+                   datatype in (gdal.GDT_Byte, gdal.GDT_Int16):
+                    continue
+
+                for size in [ '-ts 57 41', '-ts 23 17' ]:
+                    for dst_file in [ 'tmp/warp_42_general.tif', 'tmp/warp_42.tif' ]:
+                        try:
+                            os.unlink(dst_file)
+                        except:
+                            pass
+                    cmd = test_cli_utilities.get_gdalwarp_path() + \
+                          ' -order 1 -r ' + resampling + ' ' + size + ' ' + \
+                          options + ' tmp/warp_42_src.tif '
+                    gdaltest.runexternal(cmd + 'tmp/warp_42.tif')
+                    gdaltest.runexternal(cmd + '-wo USE_GENERAL_CASE=TRUE tmp/warp_42_general.tif')
+
+                    ds = gdal.Open('tmp/warp_42.tif')
+                    ref_ds = gdal.Open('tmp/warp_42_general.tif')
+                    maxdiff = gdaltest.compare_ds(ds, ref_ds, verbose = 0)
+                    ds = None
+                    ref_ds = None
+
+                    if maxdiff > 1e-6:
+                        gdaltest.post_reason('failure with %s %s %s %s' % (gdal.GetDataTypeName(datatype), resampling, size, options))
+                        print(maxdiff)
+                        return 'fail'
+
+    os.unlink('tmp/warp_42_src.tif')
+    os.unlink('tmp/warp_42.tif')
+    os.unlink('tmp/warp_42_general.tif')
+
+    return 'success'
+
+###############################################################################
+# Test mode resampling of values that the previous kernels mishandled:
+# a most frequent value of -1 with Int16, and Float64 values that are not
+# representable as Float32
+
+def warp_43():
+
+    import struct
+
+    for (datatype, fmt, majority, minority) in \
+            [ (gdal.GDT_Int16, 'h', -1, 7),
+              (gdal.GDT_Float64, 'd', 1.0000000001, 2.5) ]:
+        src_ds = gdal.GetDriverByName('MEM').Create('', 4, 4, 1, datatype)
+        src_ds.SetGeoTransform( [ 0, 1, 0, 4, 0, -1 ] )
+        values = [ minority ] * 4 + [ majority ] * 12
+        src_ds.GetRasterBand(1).WriteRaster(0, 0, 4, 4, struct.pack(fmt * 16, *values))
+
+        dst_ds = gdal.GetDriverByName('MEM').Create('', 1, 1, 1, datatype)
+        dst_ds.SetGeoTransform( [ 0, 4, 0, 4, 0, -4 ] )
+        dst_ds.GetRasterBand(1).Fill(100)
+
+        gdal.ReprojectImage( src_ds, dst_ds, None, None, gdal.GRA_Mode )
+
+        data = dst_ds.GetRasterBand(1).ReadRaster(0, 0, 1, 1)
+        got = struct.unpack(fmt, data)[0]
+        if got != majority:
+            gdaltest.post_reason('did not get expected value')
+            print(got)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Test that the SSE2 and AVX2 bilinear and cubic kernels give exactly the same
+# result as the scalar code (GDAL_USE_SSE2=NO)
+
+def warp_44():
+
+    import struct
+
+    # data type, struct format, scale, offset
+    datatypes = [ (gdal.GDT_Byte, 'B', 1, 0),
+                  (gdal.GDT_Int16, 'h', 250, -32000),
+                  (gdal.GDT_UInt16, 'H', 250, 0),
+                  (gdal.GDT_Int32, 'i', 100000, -12500000),
+                  (gdal.GDT_UInt32, 'I', 1000000, 0),
+                  (gdal.GDT_Float32, 'f', 1. / 7, -18),
+                  (gdal.GDT_Float64, 'd', 1. / 7, -18) ]
+
+    for (datatype, fmt, scale, offset) in datatypes:
+        src_ds = gdal.GetDriverByName('MEM').Create('', 60, 50, 2, datatype)
+        src_ds.SetGeoTransform( [ 0, 0.866, 0.5, 0, 0.5, -0.866 ] )
+        for iband in range(2):
+            values = [ ((i * 7 + (i // 60) * 13 + (i % 60) * (i // 60) % 31 + iband * 50) % 251) * scale + offset for i in range(60 * 50) ]
+            if fmt not in ('f', 'd'):
+                values = [ int(v) for v in values ]
+            src_ds.GetRasterBand(iband + 1).WriteRaster(0, 0, 60, 50, struct.pack(fmt * 60 * 50, *values))
+
+        for resampling in [ gdal.GRA_Bilinear, gdal.GRA_Cubic ]:
+            for nodata in [ None, values[0] ]:
+                results = []
+                for (use_sse2, use_avx2) in [ ('NO', 'NO'), ('YES', 'NO'), (None, None) ]:
+                    dst_ds = gdal.GetDriverByName('MEM').Create('', 97, 83, 2, datatype)
+                    dst_ds.SetGeoTransform( [ 0, 76.3 / 97, 0, 25, 0, -76.3 / 83 ] )
+                    if nodata is not None:
+                        for iband in range(2):
+                            dst_ds.GetRasterBand(iband + 1).SetNoDataValue(nodata)
+
+                    gdal.SetConfigOption('GDAL_USE_SSE2', use_sse2)
+                    gdal.SetConfigOption('GDAL_USE_AVX2', use_avx2)
+                    gdal.ReprojectImage( src_ds, dst_ds, None, None, resampling )
+                    gdal.SetConfigOption('GDAL_USE_SSE2', None)
+                    gdal.SetConfigOption('GDAL_USE_AVX2', None)
+
+                    results.append(dst_ds.ReadRaster(0, 0, 97, 83))
+                    dst_ds = None
+
+                if results[1] != results[0] or results[2] != results[0]:
+                    gdaltest.post_reason('failure with %s %d %s' % (gdal.GetDataTypeName(datatype), resampling, str(nodata)))
+                    return 'fail'
+
+    return 'success'
+
 ###############################################################################
 
 gdaltest_list = [
@@ -1260,6 +1510,11 @@ gdaltest_list = [
     warp_37,
     warp_38,
     warp_39,
+    warp_40,
+    warp_41,
+    warp_42,
+    warp_43,
+    warp_44,
     ]
 
 
@@ -31,8 +31,12 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 #include <tut.h>
+#include <tut_gdal.h>
+#include <gdal_common.h>
 #include <ogrsf_frmts.h>
+#include <ogr_p.h>
 #include <string>
+#include <vector>
 
 namespace tut
 {
@@ -117,4 +121,680 @@ namespace tut
         ensure("Shapefile driver is not registered", NULL != drv);
     }
 
+    // Test OGRWKBGeometryView and lazily decoded WKB in OGRFeature
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        char* pszWKT = (char*) "GEOMETRYCOLLECTION (POINT (1 2),"
+            "LINESTRING (3 4,-5 6),POLYGON EMPTY,"
+            "MULTIPOLYGON (((0 0,1 0,1 -7,0 0)),((5 5,6 5,6 6,5 5))))";
+        OGRGeometry* poGeom = NULL;
+        OGRGeometryFactory::createFromWkt(&pszWKT, NULL, &poGeom);
+        ensure(NULL != poGeom);
+
+        OGREnvelope sEnvelope;
+        poGeom->getEnvelope(&sEnvelope);
+
+        const int nSize = poGeom->WkbSize();
+        GByte* pabyWKB = (GByte*) CPLMalloc(nSize);
+
+        for( int iOrder = 0; iOrder < 2; iOrder++ )
+        {
+            poGeom->exportToWkb(iOrder == 0 ? wkbNDR : wkbXDR, pabyWKB);
+
+            OGRWKBGeometryView oView;
+            ensure_equals(oView.Init(pabyWKB, nSize), OGRERR_NONE);
+            ensure_equals(oView.getGeometryType(), wkbGeometryCollection);
+            ensure_equals(oView.getWkbSize(), nSize);
+            ensure_equals(oView.getNumPoints(), 11);
+            // Only what exportToWkb(wkbNDR) writes can be copied as is
+            ensure_equals(oView.IsCanonicalNDR(), iOrder == 0);
+            ensure_equals(oView.getX(0), 1.0);
+            ensure_equals(oView.getY(2), 6.0);
+            ensure_equals(oView.getX(10), 5.0);
+
+            OGREnvelope sViewEnvelope;
+            oView.getEnvelope(&sViewEnvelope);
+            ensure_equals(sViewEnvelope.MinX, sEnvelope.MinX);
+            ensure_equals(sViewEnvelope.MinY, sEnvelope.MinY);
+            ensure_equals(sViewEnvelope.MaxX, sEnvelope.MaxX);
+            ensure_equals(sViewEnvelope.MaxY, sEnvelope.MaxY);
+
+            // Truncated buffers must be rejected
+            for( int nTruncated = 0; nTruncated < nSize; nTruncated++ )
+                ensure(oView.Init(pabyWKB, nTruncated) != OGRERR_NONE);
+        }
+
+        // An empty collection flagged 3D is written back as 2D
+        GByte abyEmpty3D[9] = { wkbNDR, 7, 0, 0, 0x80, 0, 0, 0, 0 };
+        OGRWKBGeometryView oEmptyView;
+        ensure_equals(oEmptyView.Init(abyEmpty3D, 9), OGRERR_NONE);
+        ensure(!oEmptyView.IsCanonicalNDR());
+        abyEmpty3D[4] = 0;
+        ensure_equals(oEmptyView.Init(abyEmpty3D, 9), OGRERR_NONE);
+        ensure(oEmptyView.IsCanonicalNDR());
+
+        OGRFeatureDefn* poDefn = new OGRFeatureDefn("test");
+        poDefn->Reference();
+        OGRFeature* poFeature = new OGRFeature(poDefn);
+
+        ensure_equals(poFeature->SetGeomFieldWkbDirectly(0, pabyWKB, nSize),
+                      OGRERR_NONE);
+
+        int nPendingSize = 0;
+        ensure(NULL != poFeature->GetGeomFieldWkbRef(0, &nPendingSize));
+        ensure_equals(nPendingSize, nSize);
+
+        OGREnvelope sFeatureEnvelope;
+        ensure_equals(poFeature->GetGeomFieldEnvelope(0, &sFeatureEnvelope),
+                      OGRERR_NONE);
+        ensure_equals(sFeatureEnvelope.MinY, sEnvelope.MinY);
+
+        // Cloning keeps the geometry pending
+        OGRFeature* poClone = poFeature->Clone();
+        ensure(NULL != poClone->GetGeomFieldWkbRef(0, NULL));
+
+        // So does SetFrom(), without decoding the source
+        OGRFeature* poCopy = new OGRFeature(poDefn);
+        ensure_equals(poCopy->SetFrom(poFeature), OGRERR_NONE);
+        ensure(NULL != poCopy->GetGeomFieldWkbRef(0, NULL));
+        ensure(NULL != poFeature->GetGeomFieldWkbRef(0, NULL));
+
+        // Requesting the geometry decodes it
+        ensure(NULL != poFeature->GetGeometryRef());
+        ensure(NULL == poFeature->GetGeomFieldWkbRef(0, NULL));
+        ensure(poFeature->GetGeometryRef()->Equals(poGeom));
+        ensure(poClone->GetGeometryRef()->Equals(poGeom));
+        ensure(poCopy->GetGeometryRef()->Equals(poGeom));
+
+        delete poCopy;
+        delete poClone;
+        delete poFeature;
+        poDefn->Release();
+        delete poGeom;
+    }
+
+    // Test OGRFormatDoubleRoundTrip(), OGRFastAtof() and WKT round trips
+    template<>
+    template<>
+    void object::test<5>()
+    {
+        char szBuffer[64];
+
+        OGRFormatDoubleRoundTrip(szBuffer, sizeof(szBuffer), 0.1);
+        ensure_equals(std::string(szBuffer), std::string("0.1"));
+        OGRFormatDoubleRoundTrip(szBuffer, sizeof(szBuffer), -2.5);
+        ensure_equals(std::string(szBuffer), std::string("-2.5"));
+        OGRFormatDoubleRoundTrip(szBuffer, sizeof(szBuffer), 3.0);
+        ensure_equals(std::string(szBuffer), std::string("3.0"));
+        OGRFormatDoubleRoundTrip(szBuffer, sizeof(szBuffer), 1e-30);
+        ensure_equals(std::string(szBuffer), std::string("1e-30"));
+
+        const double adfValues[] = { 0.1, 1.0/3, 2.0/3, 1e-7, 123456.789,
+                                     4503599627370497.0, 1.7976931348623157e308,
+                                     2.2250738585072014e-308, -170.12345678901234,
+                                     5e-324 };
+        for( int i = 0; i < (int)(sizeof(adfValues)/sizeof(adfValues[0])); i++ )
+        {
+            OGRFormatDoubleRoundTrip(szBuffer, sizeof(szBuffer), adfValues[i]);
+            ensure_equals(OGRFastAtof(szBuffer), adfValues[i]);
+            ensure_equals(CPLAtof(szBuffer), adfValues[i]);
+        }
+
+        ensure_equals(OGRFastAtof(" 1.25e2"), 125.0);
+        ensure_equals(OGRFastAtof("0.30000000000000004"), 0.1 + 0.2);
+        ensure_equals(OGRFastAtof("123456789012345678901234"),
+                      CPLAtof("123456789012345678901234"));
+
+        // The default WKT output keeps 15 significant digits
+        OGRLineString oLS;
+        oLS.addPoint(0.1, 1.0/3);
+        oLS.addPoint(-170.12345678901234, 1e-30);
+        char* pszWKT = NULL;
+        ensure_equals(oLS.exportToWkt(&pszWKT), OGRERR_NONE);
+        ensure_equals(std::string(pszWKT), std::string("LINESTRING (0.1 0.333333333333333,-170.123456789012351 0.0)"));
+        CPLFree(pszWKT);
+        pszWKT = NULL;
+
+        CPLSetConfigOption("OGR_DOUBLE_ROUND_TRIP", "YES");
+        OGRErr eErr = oLS.exportToWkt(&pszWKT);
+        CPLSetConfigOption("OGR_DOUBLE_ROUND_TRIP", NULL);
+        ensure_equals(eErr, OGRERR_NONE);
+
+        OGRLineString oLS2;
+        char* pszIter = pszWKT;
+        ensure_equals(oLS2.importFromWkt(&pszIter), OGRERR_NONE);
+        CPLFree(pszWKT);
+        ensure_equals(oLS2.getNumPoints(), 2);
+        ensure_equals(oLS2.getX(0), 0.1);
+        ensure_equals(oLS2.getY(0), 1.0/3);
+        ensure_equals(oLS2.getX(1), -170.12345678901234);
+        ensure_equals(oLS2.getY(1), 1e-30);
+    }
+
+    // Test OGRLineString bulk construction and growth
+    template<>
+    template<>
+    void object::test<6>()
+    {
+        OGRLineString oLS;
+        ensure_equals(oLS.reservePoints(10), OGRERR_NONE);
+        ensure_equals(oLS.getNumPoints(), 0);
+        for( int i = 0; i < 1000; i++ )
+            oLS.addPoint(i, -i, 2 * i);
+        ensure_equals(oLS.getNumPoints(), 1000);
+        ensure_equals(oLS.getCoordinateDimension(), 3);
+        ensure_equals(oLS.getY(999), -999.0);
+        ensure_equals(oLS.getZ(999), 1998.0);
+
+        // Interleaved XYZ
+        double adfXYZ[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        oLS.setPoints(3, adfXYZ, 24, adfXYZ + 1, 24, adfXYZ + 2, 24);
+        ensure_equals(oLS.getNumPoints(), 3);
+        ensure_equals(oLS.getX(2), 7.0);
+        ensure_equals(oLS.getY(1), 5.0);
+        ensure_equals(oLS.getZ(0), 3.0);
+
+        // Interleaved XY
+        oLS.setPoints(4, adfXYZ, 16, adfXYZ + 1, 16);
+        ensure_equals(oLS.getNumPoints(), 4);
+        ensure_equals(oLS.getCoordinateDimension(), 2);
+        ensure_equals(oLS.getX(3), 7.0);
+        ensure_equals(oLS.getY(3), 8.0);
+
+        OGRRawPoint* paoPoints = (OGRRawPoint*) CPLMalloc(2 * sizeof(OGRRawPoint));
+        paoPoints[0].x = 10;
+        paoPoints[0].y = 20;
+        paoPoints[1].x = 30;
+        paoPoints[1].y = 40;
+        oLS.setPointsDirectly(2, paoPoints);
+        ensure_equals(oLS.getNumPoints(), 2);
+        ensure_equals(oLS.getCoordinateDimension(), 2);
+        ensure_equals(oLS.getY(1), 40.0);
+        oLS.addPoint(50, 60);
+        ensure_equals(oLS.getNumPoints(), 3);
+        ensure_equals(oLS.getX(0), 10.0);
+        ensure_equals(oLS.getX(2), 50.0);
+    }
+
+    // Organize nCopies copies of a set of rings, the copy i being shifted
+    // by 100 * i along X
+    static OGRGeometry* organize_rings(const char* const* papszWKT, int nRings,
+                                       int iFirstCopy, int nCopies,
+                                       int* pbIsValid,
+                                       const char* pszMethod = NULL)
+    {
+        std::vector<OGRGeometry*> apoRings;
+        for( int iCopy = iFirstCopy; iCopy < iFirstCopy + nCopies; iCopy++ )
+        {
+            for( int i = 0; i < nRings; i++ )
+            {
+                OGRGeometry* poGeom = NULL;
+                char* pszWKT = (char*) papszWKT[i];
+                ensure_equals(OGRGeometryFactory::createFromWkt(&pszWKT, NULL,
+                                                                &poGeom),
+                              OGRERR_NONE);
+                OGRLinearRing* poRing =
+                    ((OGRPolygon*) poGeom)->getExteriorRing();
+                for( int j = 0; j < poRing->getNumPoints(); j++ )
+                    poRing->setPoint(j, poRing->getX(j) + 100 * iCopy,
+                                     poRing->getY(j));
+                apoRings.push_back(poGeom);
+            }
+        }
+
+        const char* apszOptions[] = { pszMethod, NULL };
+        return OGRGeometryFactory::organizePolygons(
+            &apoRings[0], (int) apoRings.size(), pbIsValid,
+            pszMethod ? apszOptions : NULL);
+    }
+
+    static std::string organize_rings_wkt(const char* const* papszWKT,
+                                          int nRings, int* pbIsValid,
+                                          const char* pszMethod = NULL)
+    {
+        OGRGeometry* poGeom =
+            organize_rings(papszWKT, nRings, 0, 1, pbIsValid, pszMethod);
+        char* pszWKT = NULL;
+        poGeom->exportToWkt(&pszWKT);
+        std::string osWKT(pszWKT);
+        CPLFree(pszWKT);
+        delete poGeom;
+        return osWKT;
+    }
+
+    // Test OGRGeometryFactory::organizePolygons()
+    template<>
+    template<>
+    void object::test<7>()
+    {
+        int bIsValid = FALSE;
+
+        // Shell, island, hole
+        const char* apszNested[] = {
+            "POLYGON ((0 0,0 10,10 10,10 0,0 0))",
+            "POLYGON ((4 4,6 4,6 6,4 6,4 4))",
+            "POLYGON ((2 2,8 2,8 8,2 8,2 2))" };
+        ensure_equals(organize_rings_wkt(apszNested, 3, &bIsValid),
+                      std::string("MULTIPOLYGON (((0 0,0 10,10 10,10 0,0 0),"
+                                  "(2 2,8 2,8 8,2 8,2 2)),"
+                                  "((4 4,6 4,6 6,4 6,4 4)))"));
+        ensure(bIsValid);
+
+        ensure_equals(organize_rings_wkt(apszNested, 3, &bIsValid,
+                                         "METHOD=ONLY_CCW"),
+                      std::string("POLYGON ((0 0,0 10,10 10,10 0,0 0),"
+                                  "(4 4,6 4,6 6,4 6,4 4),"
+                                  "(2 2,8 2,8 8,2 8,2 2))"));
+        ensure(bIsValid);
+
+        ensure_equals(organize_rings_wkt(apszNested, 3, &bIsValid,
+                                         "METHOD=SKIP"),
+                      std::string("MULTIPOLYGON (((0 0,0 10,10 10,10 0,0 0)),"
+                                  "((4 4,6 4,6 6,4 6,4 4)),"
+                                  "((2 2,8 2,8 8,2 8,2 2)))"));
+        ensure(!bIsValid);
+
+        const char* apszDisjoint[] = {
+            "POLYGON ((0 0,0 1,1 1,1 0,0 0))",
+            "POLYGON ((5 5,5 6,6 6,6 5,5 5))" };
+        ensure_equals(organize_rings_wkt(apszDisjoint, 2, &bIsValid),
+                      std::string("MULTIPOLYGON (((0 0,0 1,1 1,1 0,0 0)),"
+                                  "((5 5,5 6,6 6,6 5,5 5)))"));
+        ensure(bIsValid);
+
+        // Rings sharing an edge
+        const char* apszTouching[] = {
+            "POLYGON ((0 0,0 10,10 10,10 0,0 0))",
+            "POLYGON ((10 0,10 10,20 10,20 0,10 0))" };
+        ensure_equals(organize_rings_wkt(apszTouching, 2, &bIsValid),
+                      std::string("MULTIPOLYGON (((0 0,0 10,10 10,10 0,0 0)),"
+                                  "((10 0,10 10,20 10,20 0,10 0)))"));
+        ensure(bIsValid);
+
+        // Hole touching the shell
+        const char* apszTouchingHole[] = {
+            "POLYGON ((0 0,0 10,10 10,10 0,0 0))",
+            "POLYGON ((0 0,5 0,5 5,0 5,0 0))" };
+        ensure_equals(organize_rings_wkt(apszTouchingHole, 2, &bIsValid),
+                      std::string("POLYGON ((0 0,0 10,10 10,10 0,0 0),"
+                                  "(0 0,5 0,5 5,0 5,0 0))"));
+        ensure(bIsValid);
+
+        const char* apszOverlapping[] = {
+            "POLYGON ((0 0,0 10,10 10,10 0,0 0))",
+            "POLYGON ((5 5,5 15,15 15,15 5,5 5))" };
+        ensure_equals(organize_rings_wkt(apszOverlapping, 2, &bIsValid),
+                      std::string("MULTIPOLYGON (((0 0,0 10,10 10,10 0,0 0)),"
+                                  "((5 5,5 15,15 15,15 5,5 5)))"));
+        ensure(bIsValid);
+
+        // Above 100 rings, the enclosing ring candidates are found with
+        // a spatial index: the result must be the one of each copy
+        // organized alone.
+        const char* apszMixed[] = {
+            "POLYGON ((0 0,0 10,10 10,10 0,0 0))",
+            "POLYGON ((4 4,6 4,6 6,4 6,4 4))",
+            "POLYGON ((2 2,8 2,8 8,2 8,2 2))",
+            "POLYGON ((20 0,20 10,30 10,30 0,20 0))",
+            "POLYGON ((30 0,30 10,40 10,40 0,30 0))",
+            "POLYGON ((50 0,50 10,60 10,60 0,50 0))",
+            "POLYGON ((55 5,55 15,65 15,65 5,55 5))" };
+        const int nCopies = 40;
+
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        OGRGeometry* poGeom =
+            organize_rings(apszMixed, 7, 0, nCopies, &bIsValid);
+        CPLPopErrorHandler();
+        ensure(bIsValid);
+        ensure_equals(wkbFlatten(poGeom->getGeometryType()), wkbMultiPolygon);
+
+        OGRMultiPolygon* poMP = (OGRMultiPolygon*) poGeom;
+        ensure_equals(poMP->getNumGeometries(), 6 * nCopies);
+        for( int iCopy = 0; iCopy < nCopies; iCopy++ )
+        {
+            OGRMultiPolygon* poRef = (OGRMultiPolygon*)
+                organize_rings(apszMixed, 7, iCopy, 1, &bIsValid);
+            ensure_equals(poRef->getNumGeometries(), 6);
+            for( int i = 0; i < 6; i++ )
+                ensure("polygon differs from the one of the copy alone",
+                       poMP->getGeometryRef(6 * iCopy + i)->Equals(
+                           poRef->getGeometryRef(i)));
+            delete poRef;
+        }
+        delete poGeom;
+    }
+
+    // Describe the FID, fields and geometry of a feature
+    static std::string describe_feature(OGRFeature* poFeature)
+    {
+        CPLString osDesc;
+        osDesc.Printf("%ld", poFeature->GetFID());
+        for( int i = 0; i < poFeature->GetFieldCount(); i++ )
+        {
+            osDesc += "|";
+            if( poFeature->IsFieldSet(i) )
+                osDesc += poFeature->GetFieldAsString(i);
+            else
+                osDesc += "(unset)";
+        }
+        osDesc += "|";
+        OGRGeometry* poGeom = poFeature->GetGeometryRef();
+        if( poGeom != NULL )
+        {
+            char* pszWKT = NULL;
+            poGeom->exportToWkt(&pszWKT);
+            osDesc += pszWKT;
+            CPLFree(pszWKT);
+        }
+        else
+            osDesc += "(null)";
+        return osDesc;
+    }
+
+    // Read a layer with GetNextFeature(), or with GetNextFeatureInto() into
+    // a single feature that initially holds a point and a long string
+    static std::vector<std::string> read_layer(OGRLayer* poLayer, bool bInto)
+    {
+        std::vector<std::string> aosDesc;
+
+        poLayer->ResetReading();
+        if( !bInto )
+        {
+            OGRFeature* poFeature;
+            while( (poFeature = poLayer->GetNextFeature()) != NULL )
+            {
+                aosDesc.push_back(describe_feature(poFeature));
+                delete poFeature;
+            }
+            return aosDesc;
+        }
+
+        OGRFeature* poFeature = new OGRFeature(poLayer->GetLayerDefn());
+        poFeature->SetGeometryDirectly(new OGRPoint(1, 2));
+        for( int i = 0; i < poFeature->GetFieldCount(); i++ )
+            poFeature->SetField(i, "a string longer than any value read");
+        while( poLayer->GetNextFeatureInto(poFeature) )
+            aosDesc.push_back(describe_feature(poFeature));
+        delete poFeature;
+
+        return aosDesc;
+    }
+
+    // Read a layer with GetNextBatch(), each row being turned back into a
+    // feature so that it can be described as by read_layer()
+    static std::vector<std::string> read_layer_by_batches(OGRLayer* poLayer,
+                                                          int nBatchSize)
+    {
+        std::vector<std::string> aosDesc;
+        OGRFeatureBatch oBatch(nBatchSize);
+        int nCount;
+
+        poLayer->ResetReading();
+        while( (nCount = poLayer->GetNextBatch(&oBatch)) > 0 )
+        {
+            for( int iRow = 0; iRow < nCount; iRow++ )
+            {
+                OGRFeature oFeature(poLayer->GetLayerDefn());
+                oFeature.SetFID(oBatch.GetFIDs()[iRow]);
+
+                for( int iCol = 0; iCol < oBatch.GetColumnCount(); iCol++ )
+                {
+                    const GByte* pabyValidity = oBatch.GetColumnValidity(iCol);
+                    if( !((pabyValidity[iRow / 8] >> (iRow % 8)) & 1) )
+                        continue;
+
+                    int iField = oBatch.GetColumnFieldIndex(iCol);
+                    if( oBatch.GetColumnType(iCol) == OFTInteger )
+                        oFeature.SetField(iField,
+                            oBatch.GetColumnAsIntegers(iCol)[iRow]);
+                    else if( oBatch.GetColumnType(iCol) == OFTReal )
+                        oFeature.SetField(iField,
+                            oBatch.GetColumnAsDoubles(iCol)[iRow]);
+                    else
+                    {
+                        const int* panOffsets =
+                            oBatch.GetColumnStringOffsets(iCol);
+                        std::string osValue;
+                        if( panOffsets[iRow + 1] > panOffsets[iRow] )
+                            osValue.assign(
+                                oBatch.GetColumnStringData(iCol) + panOffsets[iRow],
+                                panOffsets[iRow + 1] - panOffsets[iRow]);
+                        oFeature.SetField(iField, osValue.c_str());
+                    }
+                }
+
+                const int* panWKBOffsets = oBatch.GetGeometryOffsets();
+                if( oBatch.HasGeometry()
+                    && panWKBOffsets[iRow + 1] > panWKBOffsets[iRow] )
+                {
+                    OGRGeometry* poGeom = NULL;
+                    OGRGeometryFactory::createFromWkb(
+                        (unsigned char*) oBatch.GetGeometryData()
+                            + panWKBOffsets[iRow],
+                        NULL, &poGeom,
+                        panWKBOffsets[iRow + 1] - panWKBOffsets[iRow]);
+                    oFeature.SetGeometryDirectly(poGeom);
+                }
+
+                aosDesc.push_back(describe_feature(&oFeature));
+            }
+        }
+
+        return aosDesc;
+    }
+
+    // Test GetNextFeatureInto() with the Shapefile, CSV and SQLite drivers
+    template<>
+    template<>
+    void object::test<8>()
+    {
+        // Values growing and shrinking, a NULL geometry, and points
+        // followed by lines (Shapefile layers have only lines)
+        const char* apszNames[] = { "a", "abcdefghijklmnopqrstuvwxyz", NULL,
+                                    "ab", "abcdef" };
+        const char* apszWKT[] = { "POINT (1 2)",
+                                  "LINESTRING (0 0,1 1,2 2,3 3)",
+                                  NULL,
+                                  "LINESTRING (10 10,11 11)",
+                                  "POINT (10 10)" };
+        const char* apszShapeWKT[] = { "LINESTRING (1 2,3 4,5 6)",
+                                       "LINESTRING (0 0,1 1,2 2,3 3)",
+                                       NULL,
+                                       "LINESTRING (10 10,11 11)",
+                                       "LINESTRING (10 10,12 12,14 14)" };
+        const int nFeatures = 5;
+        const char* apszDrivers[] = { "ESRI Shapefile", "CSV", "SQLite" };
+        const char* apszFiles[] = { "reuse.shp", "reuse.csv", "reuse.sqlite" };
+
+        for( int iDrv = 0; iDrv < 3; iDrv++ )
+        {
+            OGRSFDriver* poDriver = drv_reg_->GetDriverByName(apszDrivers[iDrv]);
+            if( poDriver == NULL )
+                continue;
+            bool bShape = (iDrv == 0);
+
+            std::string osFile(tut::common::tmp_basedir);
+            osFile += SEP;
+            osFile += apszFiles[iDrv];
+            VSIUnlink(osFile.c_str());
+
+            // Write the test layer
+            OGRDataSource* poDS = poDriver->CreateDataSource(osFile.c_str());
+            ensure("Can't create datasource", NULL != poDS);
+            const char* apszOptions[] = { "GEOMETRY=AS_WKT", NULL };
+            OGRLayer* poLayer = poDS->CreateLayer("reuse", NULL,
+                bShape ? wkbLineString : wkbUnknown,
+                (char**) ((iDrv == 1) ? apszOptions : NULL));
+            ensure("Can't create layer", NULL != poLayer);
+            OGRFieldDefn oFieldId("id", OFTInteger);
+            ensure_equals(poLayer->CreateField(&oFieldId), OGRERR_NONE);
+            OGRFieldDefn oFieldName("name", OFTString);
+            ensure_equals(poLayer->CreateField(&oFieldName), OGRERR_NONE);
+
+            for( int i = 0; i < nFeatures; i++ )
+            {
+                OGRFeature oFeature(poLayer->GetLayerDefn());
+                oFeature.SetField("id", i + 1);
+                if( apszNames[i] != NULL )
+                    oFeature.SetField("name", apszNames[i]);
+                const char* pszWKT = bShape ? apszShapeWKT[i] : apszWKT[i];
+                if( pszWKT != NULL )
+                {
+                    OGRGeometry* poGeom = NULL;
+                    char* pszWKTIter = (char*) pszWKT;
+                    OGRGeometryFactory::createFromWkt(&pszWKTIter, NULL, &poGeom);
+                    oFeature.SetGeometryDirectly(poGeom);
+                }
+                ensure_equals(poLayer->CreateFeature(&oFeature), OGRERR_NONE);
+            }
+            OGRDataSource::DestroyDataSource(poDS);
+
+            // Read it back, without filter and with attribute and spatial
+            // filters, each feature read being compared with the ones
+            // returned by GetNextFeature()
+            poDS = OGRSFDriverRegistrar::Open(osFile.c_str(), FALSE);
+            ensure("Can't open datasource", NULL != poDS);
+            poLayer = poDS->GetLayer(0);
+            ensure("Can't get layer", NULL != poLayer);
+
+            OGRLinearRing oRing;
+            oRing.addPoint(9, 9);
+            oRing.addPoint(9, 20);
+            oRing.addPoint(20, 20);
+            oRing.addPoint(20, 9);
+            oRing.addPoint(9, 9);
+            OGRPolygon oFilter;
+            oFilter.addRing(&oRing);
+
+            const char* apszAttrFilters[] = { NULL, "name LIKE 'a%'", NULL,
+                                              "name LIKE 'a%'" };
+            const bool abSpatialFilter[] = { false, false, true, true };
+            // The feature without geometry passes the spatial filter
+            const size_t anExpected[] = { 5, 4, 3, 2 };
+            for( int iFilter = 0; iFilter < 4; iFilter++ )
+            {
+                ensure_equals(poLayer->SetAttributeFilter(apszAttrFilters[iFilter]),
+                              OGRERR_NONE);
+                poLayer->SetSpatialFilter(abSpatialFilter[iFilter] ? &oFilter : NULL);
+
+                std::vector<std::string> aosRef = read_layer(poLayer, false);
+                std::vector<std::string> aosInto = read_layer(poLayer, true);
+                ensure_equals(apszDrivers[iDrv],
+                              aosRef.size(), anExpected[iFilter]);
+                ensure_equals(apszDrivers[iDrv],
+                              aosInto.size(), aosRef.size());
+                for( size_t i = 0; i < aosRef.size(); i++ )
+                    ensure_equals(apszDrivers[iDrv],
+                                  aosInto[i], aosRef[i]);
+            }
+
+            OGRDataSource::DestroyDataSource(poDS);
+            if( poDriver->TestCapability(ODrCDeleteDataSource) )
+                poDriver->DeleteDataSource(osFile.c_str());
+            else
+                VSIUnlink(osFile.c_str());
+        }
+    }
+
+    // Test GetNextBatch() with the CSV driver, which fills the batch
+    // directly, and the Memory driver, which uses the generic
+    // OGRLayer::GetNextBatch()
+    template<>
+    template<>
+    void object::test<9>()
+    {
+        // Unset string, real and integer values, NULL geometries, and a
+        // feature count that is not a multiple of the batch size
+        const char* apszNames[] = { "a", NULL, "abcdefghijklmnopqrstuvwxyz",
+                                    "", "ab", NULL, "abc" };
+        const char* apszWKT[] = { "POINT (1 2)", NULL,
+                                  "LINESTRING (0 0,1 1,2 2,3 3)",
+                                  "POINT (3 4)", NULL, NULL,
+                                  "POLYGON ((0 0,0 1,1 1,0 0))" };
+        const int nFeatures = 7;
+        const int nBatchSize = 3;
+        const char* apszDrivers[] = { "CSV", "Memory" };
+        const char* apszFiles[] = { "batch.csv", "batch" };
+
+        for( int iDrv = 0; iDrv < 2; iDrv++ )
+        {
+            OGRSFDriver* poDriver = drv_reg_->GetDriverByName(apszDrivers[iDrv]);
+            if( poDriver == NULL )
+                continue;
+            bool bCSV = (iDrv == 0);
+
+            std::string osFile(tut::common::tmp_basedir);
+            osFile += SEP;
+            osFile += apszFiles[iDrv];
+            if( bCSV )
+            {
+                VSIUnlink(osFile.c_str());
+                VSIUnlink(CPLResetExtension(osFile.c_str(), "csvt"));
+            }
+
+            // Write the test layer, with a .csvt file so that the CSV
+            // fields are read back with their types
+            OGRDataSource* poDS = poDriver->CreateDataSource(osFile.c_str());
+            ensure("Can't create datasource", NULL != poDS);
+            const char* apszOptions[] = { "GEOMETRY=AS_WKT", "CREATE_CSVT=YES",
+                                          NULL };
+            OGRLayer* poLayer = poDS->CreateLayer("batch", NULL, wkbUnknown,
+                (char**) (bCSV ? apszOptions : NULL));
+            ensure("Can't create layer", NULL != poLayer);
+            OGRFieldDefn oFieldId("id", OFTInteger);
+            ensure_equals(poLayer->CreateField(&oFieldId), OGRERR_NONE);
+            OGRFieldDefn oFieldName("name", OFTString);
+            ensure_equals(poLayer->CreateField(&oFieldName), OGRERR_NONE);
+            OGRFieldDefn oFieldValue("value", OFTReal);
+            ensure_equals(poLayer->CreateField(&oFieldValue), OGRERR_NONE);
+
+            for( int i = 0; i < nFeatures; i++ )
+            {
+                OGRFeature oFeature(poLayer->GetLayerDefn());
+                if( i != 4 )
+                    oFeature.SetField("id", i + 1);
+                if( apszNames[i] != NULL )
+                    oFeature.SetField("name", apszNames[i]);
+                if( i % 3 != 1 )
+                    oFeature.SetField("value", i * 1.25 - 2);
+                if( apszWKT[i] != NULL )
+                {
+                    OGRGeometry* poGeom = NULL;
+                    char* pszWKTIter = (char*) apszWKT[i];
+                    OGRGeometryFactory::createFromWkt(&pszWKTIter, NULL, &poGeom);
+                    oFeature.SetGeometryDirectly(poGeom);
+                }
+                ensure_equals(poLayer->CreateFeature(&oFeature), OGRERR_NONE);
+            }
+
+            if( bCSV )
+            {
+                OGRDataSource::DestroyDataSource(poDS);
+                poDS = OGRSFDriverRegistrar::Open(osFile.c_str(), FALSE);
+                ensure("Can't open datasource", NULL != poDS);
+                poLayer = poDS->GetLayer(0);
+                ensure("Can't get layer", NULL != poLayer);
+            }
+
+            // Read it by batches and compare the rows with the features
+            // returned by GetNextFeature()
+            std::vector<std::string> aosRef = read_layer(poLayer, false);
+            std::vector<std::string> aosBatch =
+                read_layer_by_batches(poLayer, nBatchSize);
+            ensure_equals(apszDrivers[iDrv], aosRef.size(), (size_t) nFeatures);
+            ensure_equals(apszDrivers[iDrv], aosBatch.size(), aosRef.size());
+            for( size_t i = 0; i < aosRef.size(); i++ )
+                ensure_equals(apszDrivers[iDrv], aosBatch[i], aosRef[i]);
+
+            OGRDataSource::DestroyDataSource(poDS);
+            if( bCSV )
+            {
+                VSIUnlink(osFile.c_str());
+                VSIUnlink(CPLResetExtension(osFile.c_str(), "csvt"));
+            }
+        }
+    }
+
 } // namespace tut
@@ -413,4 +413,89 @@ namespace tut
         OGR_DS_Destroy(ds);
     }
 
+    // Test reading by batches
+    template<>
+    template<>
+    void object::test<11>()
+    {
+        std::string tmp(data_tmp_);
+        tmp += SEP;
+        tmp += "tpoly.shp";
+        OGRDataSourceH ds = OGR_Dr_Open(drv_, tmp.c_str(), false);
+        ensure("Can't open layer", NULL != ds);
+
+        OGRLayerH lyr = OGR_DS_GetLayer(ds, 0);
+        ensure("Can't get layer", NULL != lyr);
+
+        const char* ignored[] = { "AREA", "PRFEDEA", NULL };
+        OGRErr err = OGR_L_SetIgnoredFields(lyr, ignored);
+        ensure_equals("Can't set ignored fields", OGRERR_NONE, err);
+
+        // Read the layer feature by feature
+        std::vector<long> fids;
+        std::vector<int> eas_ids;
+        std::vector<int> eas_ids_set;
+        std::vector<std::string> wkbs;
+        OGRFeatureH feat = NULL;
+        while( (feat = OGR_L_GetNextFeature(lyr)) != NULL )
+        {
+            fids.push_back(OGR_F_GetFID(feat));
+            eas_ids.push_back(OGR_F_GetFieldAsInteger(feat, 1));
+            eas_ids_set.push_back(OGR_F_IsFieldSet(feat, 1));
+
+            std::string wkb;
+            OGRGeometryH geom = OGR_F_GetGeometryRef(feat);
+            if( NULL != geom )
+            {
+                wkb.resize(OGR_G_WkbSize(geom));
+                OGR_G_ExportToWkb(geom, wkbNDR, (unsigned char*) &wkb[0]);
+            }
+            wkbs.push_back(wkb);
+
+            OGR_F_Destroy(feat);
+        }
+        ensure("No feature read", !fids.empty());
+
+        // Read it again by batches of 4 features
+        OGRFeatureBatchH batch = OGR_FB_Create(4);
+        size_t i = 0;
+        int count = 0;
+
+        OGR_L_ResetReading(lyr);
+        while( (count = OGR_L_GetNextBatch(lyr, batch)) > 0 )
+        {
+            ensure_equals("Unexpected column count",
+                          OGR_FB_GetColumnCount(batch), 1);
+            ensure_equals("Unexpected column field",
+                          OGR_FB_GetColumnFieldIndex(batch, 0), 1);
+            ensure_equals("Unexpected column type",
+                          OGR_FB_GetColumnType(batch, 0), OFTInteger);
+            ensure("Geometry expected", OGR_FB_HasGeometry(batch));
+
+            const long* batch_fids = OGR_FB_GetFIDs(batch);
+            const int* values = OGR_FB_GetColumnAsIntegers(batch, 0);
+            const GByte* validity = OGR_FB_GetColumnValidity(batch, 0);
+            const int* offsets = OGR_FB_GetGeometryOffsets(batch);
+            const GByte* data = OGR_FB_GetGeometryData(batch);
+
+            for( int row = 0; row < count; row++, i++ )
+            {
+                ensure("Too many features", i < fids.size());
+                ensure_equals("FID mismatch", batch_fids[row], fids[i]);
+                ensure_equals("Validity mismatch",
+                              (validity[row / 8] >> (row % 8)) & 1,
+                              eas_ids_set[i]);
+                ensure_equals("Value mismatch", values[row], eas_ids[i]);
+
+                std::string wkb((const char*) data + offsets[row],
+                                offsets[row + 1] - offsets[row]);
+                ensure("Geometry mismatch", wkb == wkbs[i]);
+            }
+        }
+        ensure_equals("Unexpected feature count", i, fids.size());
+
+        OGR_FB_Destroy(batch);
+        OGR_DS_Destroy(ds);
+    }
+
 } // namespace tut
@@ -0,0 +1,214 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OGR Core
+ * Purpose:  Test performance of OGRLayer::GetNextFeatureInto().
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "ogrsf_frmts.h"
+#include "ogr_api.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+/* Reads the same layer with GetNextFeature() and with GetNextFeatureInto(), */
+/* with the Shapefile, CSV and SQLite drivers, and reports the time spent */
+/* and, with glibc, the number of memory allocations. */
+
+#ifdef __GLIBC__
+/* Count the allocations of the whole process, GDAL included, by */
+/* interposing the allocation functions of the C library. */
+extern "C" void *__libc_malloc( size_t );
+extern "C" void *__libc_calloc( size_t, size_t );
+extern "C" void *__libc_realloc( void *, size_t );
+
+static unsigned long nAllocCount = 0;
+
+extern "C" void *malloc( size_t nSize )
+{
+    nAllocCount ++;
+    return __libc_malloc( nSize );
+}
+
+extern "C" void *calloc( size_t nCount, size_t nSize )
+{
+    nAllocCount ++;
+    return __libc_calloc( nCount, nSize );
+}
+
+extern "C" void *realloc( void *pData, size_t nSize )
+{
+    nAllocCount ++;
+    return __libc_realloc( pData, nSize );
+}
+#define HAVE_ALLOC_COUNT
+#endif
+
+static void CreateLayer( const char* pszDriver, const char* pszFilename,
+                         int nFeatures )
+{
+    OGRSFDriver* poDriver =
+        OGRSFDriverRegistrar::GetRegistrar()->GetDriverByName(pszDriver);
+    OGRDataSource* poDS = poDriver->CreateDataSource(pszFilename);
+    const char* apszOptions[] = { "GEOMETRY=AS_WKT", NULL };
+    OGRLayer* poLayer = poDS->CreateLayer("test", NULL, wkbLineString,
+        (char**) (EQUAL(pszDriver, "CSV") ? apszOptions : NULL));
+
+    OGRFieldDefn oFieldInt("ival", OFTInteger);
+    poLayer->CreateField(&oFieldInt);
+    OGRFieldDefn oFieldReal("dval", OFTReal);
+    poLayer->CreateField(&oFieldReal);
+    OGRFieldDefn oFieldStr("sval", OFTString);
+    oFieldStr.SetWidth(32);
+    poLayer->CreateField(&oFieldStr);
+
+    if( EQUAL(pszDriver, "SQLite") )
+        poDS->ExecuteSQL("BEGIN", NULL, NULL);
+
+    OGRFeature* poFeature = new OGRFeature(poLayer->GetLayerDefn());
+    for( int i = 0; i < nFeatures; i++ )
+    {
+        poFeature->SetFID(OGRNullFID);
+        poFeature->SetField(0, i);
+        poFeature->SetField(1, i * 0.5);
+        poFeature->SetField(2, CPLSPrintf("feature %d", i));
+
+        OGRLineString* poLS = new OGRLineString();
+        for( int j = 0; j < 2 + (i % 8); j++ )
+            poLS->addPoint(i + j, i - j);
+        poFeature->SetGeometryDirectly(poLS);
+
+        poLayer->CreateFeature(poFeature);
+    }
+    delete poFeature;
+
+    if( EQUAL(pszDriver, "SQLite") )
+        poDS->ExecuteSQL("COMMIT", NULL, NULL);
+
+    OGRDataSource::DestroyDataSource(poDS);
+}
+
+/* Returns a checksum of the features read, so that both ways of reading */
+/* can be compared. */
+static double ReadLayer( OGRLayer* poLayer, int bInto )
+{
+    double dfSum = 0;
+
+    poLayer->ResetReading();
+    if( bInto )
+    {
+        OGRFeature* poFeature = new OGRFeature(poLayer->GetLayerDefn());
+        while( poLayer->GetNextFeatureInto(poFeature) )
+        {
+            dfSum += poFeature->GetFieldAsInteger(0)
+                   + poFeature->GetFieldAsDouble(1)
+                   + strlen(poFeature->GetFieldAsString(2))
+                   + ((OGRLineString*) poFeature->GetGeometryRef())->getNumPoints();
+        }
+        delete poFeature;
+    }
+    else
+    {
+        OGRFeature* poFeature;
+        while( (poFeature = poLayer->GetNextFeature()) != NULL )
+        {
+            dfSum += poFeature->GetFieldAsInteger(0)
+                   + poFeature->GetFieldAsDouble(1)
+                   + strlen(poFeature->GetFieldAsString(2))
+                   + ((OGRLineString*) poFeature->GetGeometryRef())->getNumPoints();
+            delete poFeature;
+        }
+    }
+
+    return dfSum;
+}
+
+int main(int argc, char* argv[])
+{
+    int nFeatures = 200 * 1000;
+    const char* apszDrivers[] = { "ESRI Shapefile", "CSV", "SQLite" };
+    const char* apszExtensions[] = { "shp", "csv", "sqlite" };
+    int iDriver, iPass;
+    int nRet = 0;
+
+    if( argc == 2 )
+        nFeatures = atoi(argv[1]);
+
+    OGRRegisterAll();
+
+    for(iDriver=0;iDriver<3;iDriver++)
+    {
+        if( OGRSFDriverRegistrar::GetRegistrar()->GetDriverByName(
+                                        apszDrivers[iDriver]) == NULL )
+            continue;
+
+        /* The SQLite driver cannot write in /vsimem */
+        CPLString osFilename = CPLResetExtension(
+            CPLGenerateTempFilename("testperf"), apszExtensions[iDriver]);
+
+        CreateLayer(apszDrivers[iDriver], osFilename, nFeatures);
+
+        OGRDataSource* poDS = OGRSFDriverRegistrar::Open(osFilename, FALSE);
+        OGRLayer* poLayer = poDS->GetLayer(0);
+        double adfSum[2] = { 0, 0 };
+
+        for(iPass=0;iPass<2;iPass++)
+        {
+            clock_t start, end;
+#ifdef HAVE_ALLOC_COUNT
+            unsigned long nAllocCountBefore = nAllocCount;
+#endif
+
+            start = clock();
+            adfSum[iPass] = ReadLayer(poLayer, iPass == 1);
+            end = clock();
+
+            printf("%s, %s : %.2f s",
+                   apszDrivers[iDriver],
+                   (iPass == 0) ? "GetNextFeature()" : "GetNextFeatureInto()",
+                   (end - start) * 1.0 / CLOCKS_PER_SEC);
+#ifdef HAVE_ALLOC_COUNT
+            printf(", %.1f allocations per feature",
+                   (double)(nAllocCount - nAllocCountBefore) / nFeatures);
+#endif
+            printf("\n");
+        }
+
+        if( adfSum[0] != adfSum[1] )
+        {
+            printf("%s : features read differ\n", apszDrivers[iDriver]);
+            nRet = 1;
+        }
+
+        OGRDataSource::DestroyDataSource(poDS);
+        OGRSFDriverRegistrar::GetRegistrar()->GetDriverByName(
+            apszDrivers[iDriver])->DeleteDataSource(osFilename);
+    }
+
+    OGRCleanupAll();
+
+    return nRet;
+}
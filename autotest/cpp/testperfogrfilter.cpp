@@ -0,0 +1,124 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OGR Core
+ * Purpose:  Test performance of OGRFeatureQuery::Evaluate().
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "ogr_feature.h"
+#include "cpl_conv.h"
+
+/* Filters 10 million features, with the compiled evaluation of */
+/* OGRFeatureQuery and with the generic swq_expr_node evaluation. */
+
+static const char* apszFilters[] =
+{
+    "ival = 5",
+    "ival > 10 AND dval < 0.5",
+    "ival IN (1, 3, 5, 7, 11, 13) OR dval BETWEEN 0.2 AND 0.3",
+    "sval = 'abc' AND ival >= 50",
+    "sval LIKE 'a%' OR ival IS NULL",
+    NULL
+};
+
+int main(int argc, char* argv[])
+{
+    int nFeatures = 10 * 1000 * 1000;
+    int i, iFilter, iPass;
+    static const char* apszStrings[] = { "abc", "def", "ABC", "xyz" };
+
+    if( argc == 2 )
+        nFeatures = atoi(argv[1]);
+
+    OGRFeatureDefn* poDefn = new OGRFeatureDefn("test");
+    poDefn->Reference();
+
+    OGRFieldDefn oFieldInt("ival", OFTInteger);
+    poDefn->AddFieldDefn(&oFieldInt);
+    OGRFieldDefn oFieldReal("dval", OFTReal);
+    poDefn->AddFieldDefn(&oFieldReal);
+    OGRFieldDefn oFieldStr("sval", OFTString);
+    poDefn->AddFieldDefn(&oFieldStr);
+
+    OGRFeature* poFeature = new OGRFeature(poDefn);
+
+    for(iFilter=0;apszFilters[iFilter]!=NULL;iFilter++)
+    {
+        int anMatches[2];
+
+        for(iPass=0;iPass<2;iPass++)
+        {
+            OGRFeatureQuery oQuery;
+            clock_t start, end;
+
+            CPLSetConfigOption("OGR_FEATURE_QUERY_COMPILE",
+                               (iPass == 0) ? "YES" : "NO");
+            if( oQuery.Compile(poDefn, apszFilters[iFilter]) != OGRERR_NONE )
+                return 1;
+
+            anMatches[iPass] = 0;
+
+            start = clock();
+
+            for(i=0;i<nFeatures;i++)
+            {
+                /* Cheap pseudo-random field values, every 17th ival unset */
+                poFeature->SetFID(i);
+                if( (i % 17) == 0 )
+                    poFeature->UnsetField(0);
+                else
+                    poFeature->SetField(0, (i * 7) % 101);
+                poFeature->SetField(1, ((i * 13) % 1000) / 1000.0);
+                poFeature->SetField(2, apszStrings[i % 4]);
+
+                if( oQuery.Evaluate(poFeature) )
+                    anMatches[iPass] ++;
+            }
+
+            end = clock();
+
+            printf("%s (%s) : %d matches, %.2f s\n",
+                   apszFilters[iFilter],
+                   (iPass == 0) ? "compiled" : "tree",
+                   anMatches[iPass],
+                   (end - start) * 1.0 / CLOCKS_PER_SEC);
+        }
+
+        if( anMatches[0] != anMatches[1] )
+        {
+            printf("Mismatch for %s\n", apszFilters[iFilter]);
+            return 1;
+        }
+    }
+
+    CPLSetConfigOption("OGR_FEATURE_QUERY_COMPILE", NULL);
+
+    delete poFeature;
+    poDefn->Release();
+
+    return 0;
+}
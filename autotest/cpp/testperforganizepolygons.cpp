@@ -0,0 +1,127 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OGR Core
+ * Purpose:  Test performance of OGRGeometryFactory::organizePolygons().
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "ogr_geometry.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+/* Organizes a square shell with nSide x nSide square holes, each hole */
+/* containing an island, so 1 + 2 * nSide * nSide rings in total. */
+
+static OGRPolygon* CreateSquare(double dfX, double dfY, double dfSize,
+                                int bClockwise)
+{
+    OGRLinearRing* poRing = new OGRLinearRing();
+    poRing->addPoint(dfX, dfY);
+    if( bClockwise )
+    {
+        poRing->addPoint(dfX, dfY + dfSize);
+        poRing->addPoint(dfX + dfSize, dfY + dfSize);
+        poRing->addPoint(dfX + dfSize, dfY);
+    }
+    else
+    {
+        poRing->addPoint(dfX + dfSize, dfY);
+        poRing->addPoint(dfX + dfSize, dfY + dfSize);
+        poRing->addPoint(dfX, dfY + dfSize);
+    }
+    poRing->addPoint(dfX, dfY);
+
+    OGRPolygon* poPoly = new OGRPolygon();
+    poPoly->addRingDirectly(poRing);
+    return poPoly;
+}
+
+int main(int argc, char* argv[])
+{
+    int nSide = 150;
+    int i, j, iMethod;
+    static const char* apszMethods[] = { "DEFAULT", "ONLY_CCW" };
+
+    if( argc == 2 )
+        nSide = atoi(argv[1]);
+
+    int nPolygons = 1 + 2 * nSide * nSide;
+
+    for(iMethod = 0; iMethod < 2; iMethod++)
+    {
+        OGRGeometry** papoPolygons = new OGRGeometry*[nPolygons];
+        int nCount = 0;
+
+        papoPolygons[nCount++] = CreateSquare(0, 0, 10 * (nSide + 1), TRUE);
+        for(j = 0; j < nSide; j++)
+        {
+            for(i = 0; i < nSide; i++)
+            {
+                papoPolygons[nCount++] =
+                    CreateSquare(10 * i + 5, 10 * j + 5, 8, FALSE);
+                papoPolygons[nCount++] =
+                    CreateSquare(10 * i + 7, 10 * j + 7, 4, TRUE);
+            }
+        }
+
+        char** papszOptions =
+            CSLSetNameValue(NULL, "METHOD", apszMethods[iMethod]);
+        int bIsValid = FALSE;
+        clock_t start, end;
+
+        start = clock();
+        OGRGeometry* poGeom = OGRGeometryFactory::organizePolygons(
+            papoPolygons, nPolygons, &bIsValid, (const char**)papszOptions);
+        end = clock();
+
+        int nParts = 0, nRings = 0;
+        if( wkbFlatten(poGeom->getGeometryType()) == wkbMultiPolygon )
+        {
+            OGRMultiPolygon* poMP = (OGRMultiPolygon*) poGeom;
+            nParts = poMP->getNumGeometries();
+            for(i = 0; i < nParts; i++)
+                nRings += 1 + ((OGRPolygon*)poMP->getGeometryRef(i))->
+                    getNumInteriorRings();
+        }
+
+        printf("%d rings, METHOD=%s : %d polygons, %d rings, valid=%d, %.2f s\n",
+               nPolygons, apszMethods[iMethod], nParts, nRings, bIsValid,
+               (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+        if( nParts != 1 + nSide * nSide || nRings != nPolygons || !bIsValid )
+        {
+            printf("Unexpected result\n");
+            return 1;
+        }
+
+        delete poGeom;
+        delete[] papoPolygons;
+        CSLDestroy(papszOptions);
+    }
+
+    return 0;
+}
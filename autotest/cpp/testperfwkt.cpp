@@ -0,0 +1,152 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OGR Core
+ * Purpose:  Test performance of WKT parsing and formatting of coordinates.
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "ogr_geometry.h"
+#include "ogr_p.h"
+#include "cpl_conv.h"
+
+/* Exports and re-imports a line string as WKT, and checks that the */
+/* coordinates survive the round trip exactly. Also times the number */
+/* conversion functions alone. */
+
+int main(int argc, char* argv[])
+{
+    int nPoints = 1000 * 1000;
+    int nIter = 10;
+    int i, iIter;
+    clock_t start, end;
+
+    if( argc == 2 )
+        nPoints = atoi(argv[1]);
+
+    CPLSetConfigOption("OGR_DOUBLE_ROUND_TRIP", "YES");
+
+/* -------------------------------------------------------------------- */
+/*      Coordinates with a few decimals, as found in most datasets,     */
+/*      and full precision ones, as produced by reprojection.           */
+/* -------------------------------------------------------------------- */
+    OGRLineString oLS;
+    oLS.setNumPoints(nPoints);
+    for(i=0;i<nPoints;i++)
+    {
+        if( (i % 2) == 0 )
+            oLS.setPoint(i, 400000 + (i % 100000) * 0.01,
+                            4500000 + (i % 77777) * 0.125);
+        else
+            oLS.setPoint(i, -180 + (i * 0.6180339887498949) / nPoints * 360,
+                            -90 + (i * 0.7071067811865476) / nPoints * 180);
+    }
+
+    char* pszWKT = NULL;
+
+    start = clock();
+    for(iIter=0;iIter<nIter;iIter++)
+    {
+        CPLFree(pszWKT);
+        pszWKT = NULL;
+        oLS.exportToWkt(&pszWKT);
+    }
+    end = clock();
+    printf("exportToWkt() : %.2f s\n", (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+    OGRLineString oLS2;
+    start = clock();
+    for(iIter=0;iIter<nIter;iIter++)
+    {
+        char* pszIter = pszWKT;
+        oLS2.importFromWkt(&pszIter);
+    }
+    end = clock();
+    printf("importFromWkt() : %.2f s\n", (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+    if( oLS2.getNumPoints() != nPoints )
+    {
+        printf("Got %d points instead of %d\n", oLS2.getNumPoints(), nPoints);
+        return 1;
+    }
+    for(i=0;i<nPoints;i++)
+    {
+        if( oLS2.getX(i) != oLS.getX(i) || oLS2.getY(i) != oLS.getY(i) )
+        {
+            printf("Point %d does not round-trip: %.17g %.17g != %.17g %.17g\n",
+                   i, oLS2.getX(i), oLS2.getY(i), oLS.getX(i), oLS.getY(i));
+            return 1;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Number conversions alone.                                       */
+/* -------------------------------------------------------------------- */
+    char szBuffer[64];
+    int nMismatch = 0;
+
+    start = clock();
+    for(i=0;i<nPoints;i++)
+        OGRFormatDouble(szBuffer, sizeof(szBuffer), oLS.getX(i), '.');
+    end = clock();
+    printf("OGRFormatDouble() : %.2f s\n", (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+    start = clock();
+    for(i=0;i<nPoints;i++)
+        OGRFormatDoubleRoundTrip(szBuffer, sizeof(szBuffer), oLS.getX(i));
+    end = clock();
+    printf("OGRFormatDoubleRoundTrip() : %.2f s\n", (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+    start = clock();
+    for(i=0;i<nPoints;i++)
+    {
+        OGRFormatDoubleRoundTrip(szBuffer, sizeof(szBuffer), oLS.getX(i));
+        if( CPLAtof(szBuffer) != oLS.getX(i) )
+            nMismatch ++;
+    }
+    end = clock();
+    printf("CPLAtof() (+ formatting) : %.2f s\n", (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+    start = clock();
+    for(i=0;i<nPoints;i++)
+    {
+        OGRFormatDoubleRoundTrip(szBuffer, sizeof(szBuffer), oLS.getX(i));
+        if( OGRFastAtof(szBuffer) != oLS.getX(i) )
+            nMismatch ++;
+    }
+    end = clock();
+    printf("OGRFastAtof() (+ formatting) : %.2f s\n", (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+    CPLFree(pszWKT);
+
+    if( nMismatch != 0 )
+    {
+        printf("%d values do not round-trip\n", nMismatch);
+        return 1;
+    }
+
+    return 0;
+}
@@ -45,9 +45,47 @@ def geoloc_1():
     tst = gdaltest.GDALTest( 'VRT', 'warpsst.vrt', 1, 62299 )
     return tst.testOpen()
 
+###############################################################################
+# Verify that transformers on the same geolocation arrays, sharing their
+# backmap, and a backmap cache limited to a single tile give the same results.
+
+def geoloc_2():
+
+    ds = gdal.Open('data/sstgeo.vrt')
+
+    tr1 = gdal.Transformer( ds, None, [ 'METHOD=GEOLOC_ARRAY' ] )
+    tr2 = gdal.Transformer( ds, None, [ 'METHOD=GEOLOC_ARRAY' ] )
+    (success1,pnt1) = tr1.TransformPoint( 1, -81.961341857910156, 29.612689971923828 )
+    (success2,pnt2) = tr2.TransformPoint( 1, -81.961341857910156, 29.612689971923828 )
+    tr1 = None
+    tr2 = None
+
+    if not success1 or not success2 or pnt1 != pnt2 \
+       or abs(pnt1[0]-19.554539744554866) > 0.001 \
+       or abs(pnt1[1]-9.1910760024906537) > 0.001:
+        print(pnt1, pnt2)
+        gdaltest.post_reason( 'got wrong reverse transform result.' )
+        return 'fail'
+
+    for temp_file in [ 'YES', 'NO' ]:
+        gdal.SetConfigOption( 'GDAL_GEOLOC_BACKMAP_CACHE_MB', '0' )
+        gdal.SetConfigOption( 'GDAL_GEOLOC_BACKMAP_TEMP_FILE', temp_file )
+        warp_ds = gdal.Open( 'data/warpsst.vrt' )
+        cs = warp_ds.GetRasterBand(1).Checksum()
+        warp_ds = None
+        gdal.SetConfigOption( 'GDAL_GEOLOC_BACKMAP_CACHE_MB', None )
+        gdal.SetConfigOption( 'GDAL_GEOLOC_BACKMAP_TEMP_FILE', None )
+
+        if cs != 62299:
+            print(cs)
+            gdaltest.post_reason( 'got wrong checksum' )
+            return 'fail'
+
+    return 'success'
 
 gdaltest_list = [
-    geoloc_1 ]
+    geoloc_1,
+    geoloc_2 ]
 
 if __name__ == '__main__':
 
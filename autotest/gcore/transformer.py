@@ -29,12 +29,14 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import math
 import os
 import sys
 
 sys.path.append( '../pymod' )
 
 import gdaltest
+import test_cli_utilities
 from osgeo import gdal
 from osgeo import gdalconst
 from osgeo import osr
@@ -313,8 +315,8 @@ def transformer_5():
     (success,pnt) = tr.TransformPoint( 0, 20, 10, 0 )
 
     if not success \
-       or abs(pnt[0]-125.64830100509131) > 0.000001 \
-       or abs(pnt[1]-39.869433991997553) > 0.000001 :
+       or abs(pnt[0]-125.64828521533849) > 0.000001 \
+       or abs(pnt[1]-39.869345204440144) > 0.000001 :
         print(success, pnt)
         gdaltest.post_reason( 'got wrong forward transform result.(4)' )
         return 'fail'
@@ -357,13 +359,125 @@ def transformer_6():
 
     return 'success' 
 
+###############################################################################
+# Create a copy of utmsmall.tif georeferenced by a smooth non polynomial
+# warp sampled at count GCPs, laid out 40 per row with some jitter.
+
+def transformer_create_gcp_ds( filename, count ):
+
+    src_ds = gdal.Open('data/utmsmall.tif')
+    data = src_ds.GetRasterBand(1).ReadRaster(0, 0, 100, 100)
+    wkt = src_ds.GetProjectionRef()
+    src_ds = None
+
+    gcps = []
+    for i in range(count):
+        pixel = 1.25 + 2.5 * (i % 40) + 0.75 * math.sin(i)
+        line = 1.25 + 2.5 * (i // 40) + 0.75 * math.cos(i)
+        x = 440720 + 60 * pixel + 20 * math.sin(line / 9.0)
+        y = 3751320 - 60 * line + 20 * math.cos(pixel / 11.0)
+        gcps.append( gdal.GCP( x, y, 0, pixel, line ) )
+
+    ds = gdal.GetDriverByName('GTiff').Create( filename, 100, 100, 1 )
+    ds.GetRasterBand(1).WriteRaster(0, 0, 100, 100, data)
+    ds.SetGCPs( gcps, wkt )
+    ds = None
+
+    return gcps
+
+###############################################################################
+# Test the thin plate spline transformer on several hundred GCPs, which
+# goes through the blocked LU solve: the transformation must go through
+# the GCPs in both directions.
+
+def transformer_7():
+
+    if not gdaltest.have_ng:
+        return 'skip'
+
+    gcps = transformer_create_gcp_ds( 'tmp/transformer_7.tif', 400 )
+
+    ds = gdal.Open( 'tmp/transformer_7.tif' )
+    tr = gdal.Transformer( ds, None, [ 'METHOD=GCP_TPS' ] )
+
+    (pnt, success) = tr.TransformPoints( 0,
+                        [ (gcp.GCPPixel, gcp.GCPLine) for gcp in gcps ] )
+    for i in range(len(gcps)):
+        if success[i] == 0 \
+           or abs(pnt[i][0] - gcps[i].GCPX) > 1e-4 \
+           or abs(pnt[i][1] - gcps[i].GCPY) > 1e-4:
+            print(i, success[i], pnt[i])
+            gdaltest.post_reason( 'got wrong forward transform result.' )
+            return 'fail'
+
+    (pnt, success) = tr.TransformPoints( 1,
+                        [ (gcp.GCPX, gcp.GCPY) for gcp in gcps ] )
+    for i in range(len(gcps)):
+        if success[i] == 0 \
+           or abs(pnt[i][0] - gcps[i].GCPPixel) > 1e-6 \
+           or abs(pnt[i][1] - gcps[i].GCPLine) > 1e-6:
+            print(i, success[i], pnt[i])
+            gdaltest.post_reason( 'got wrong reverse transform result.' )
+            return 'fail'
+
+    tr = None
+    ds = None
+    gdal.GetDriverByName('GTiff').Delete( 'tmp/transformer_7.tif' )
+
+    return 'success'
+
+###############################################################################
+# Test that GDAL_APPROX_TRANSFORMER_USE_GRID=AUTO, the default, uses the
+# interpolation grid from 1000 GCPs on with a thin plate spline, and that
+# the result is the one without the grid, within the error threshold.
+
+def transformer_8():
+
+    if test_cli_utilities.get_gdalwarp_path() is None:
+        return 'skip'
+
+    for count in [ 999, 1000 ]:
+        transformer_create_gcp_ds( 'tmp/transformer_8_%d.tif' % count, count )
+        gdaltest.runexternal(test_cli_utilities.get_gdalwarp_path() + ' -of VRT -tps -r bilinear tmp/transformer_8_%d.tif tmp/transformer_8_%d.vrt' % (count, count))
+
+        f = open( 'tmp/transformer_8_%d.vrt' % count )
+        content = f.read()
+        f.close()
+
+        if (content.find( '<Grid>' ) >= 0) != (count >= 1000):
+            gdaltest.post_reason( 'wrong use of the interpolation grid with %d GCPs' % count )
+            print(content)
+            return 'fail'
+
+    gdaltest.runexternal(test_cli_utilities.get_gdalwarp_path() + ' -of VRT -tps -r bilinear tmp/transformer_8_1000.tif tmp/transformer_8_nogrid.vrt --config GDAL_APPROX_TRANSFORMER_USE_GRID NO')
+
+    ds = gdal.Open( 'tmp/transformer_8_1000.vrt' )
+    ref_ds = gdal.Open( 'tmp/transformer_8_nogrid.vrt' )
+    maxdiff = gdaltest.compare_ds(ds, ref_ds, verbose = 0)
+    ds = None
+    ref_ds = None
+
+    if maxdiff > 1:
+        gdaltest.post_reason('Image too different from reference')
+        print(maxdiff)
+        return 'fail'
+
+    for name in [ '999', '1000', 'nogrid' ]:
+        gdal.GetDriverByName('VRT').Delete( 'tmp/transformer_8_%s.vrt' % name )
+    for count in [ 999, 1000 ]:
+        gdal.GetDriverByName('GTiff').Delete( 'tmp/transformer_8_%d.tif' % count )
+
+    return 'success'
+
 gdaltest_list = [
     transformer_1,
     transformer_2,
     transformer_3,
     transformer_4,
     transformer_5,
-    transformer_6 ]
+    transformer_6,
+    transformer_7,
+    transformer_8 ]
 
 if __name__ == '__main__':
 
@@ -93,10 +93,53 @@ def vrtwarp_3():
 
     return 'success'
 
+###############################################################################
+# Test that the interpolation grid of the approximate transformer is saved
+# in the VRT, and used when reading it back.
+
+def vrtwarp_4():
+
+    gcp_ds = gdal.OpenShared( 'data/rgb_gcp.vrt', gdal.GA_ReadOnly )
+
+    gdal.SetConfigOption( 'GDAL_APPROX_TRANSFORMER_USE_GRID', 'YES' )
+    vrtwarp_ds = gdal.AutoCreateWarpedVRT( gcp_ds, None, None,
+                                           gdal.GRA_NearestNeighbour, 0.125 )
+    gdal.SetConfigOption( 'GDAL_APPROX_TRANSFORMER_USE_GRID', None )
+
+    gcp_ds = None
+
+    expected = vrtwarp_ds.GetRasterBand(2).Checksum()
+
+    vrtwarp_ds.SetDescription( 'tmp/warp_grid.vrt' )
+    vrtwarp_ds = None
+
+    f = open( 'tmp/warp_grid.vrt' )
+    content = f.read()
+    f.close()
+
+    if content.find( '<Grid>' ) < 0:
+        gdaltest.post_reason( 'did not find the interpolation grid' )
+        print(content)
+        return 'fail'
+
+    vrtwarp_ds = gdal.Open( 'tmp/warp_grid.vrt', gdal.GA_ReadOnly )
+    checksum = vrtwarp_ds.GetRasterBand(2).Checksum()
+    vrtwarp_ds = None
+
+    gdal.GetDriverByName('VRT').Delete( 'tmp/warp_grid.vrt' )
+
+    if checksum != expected:
+        gdaltest.post_reason( 'Got checksum of %d instead of expected %d.' \
+                              % (checksum, expected) )
+        return 'fail'
+
+    return 'success'
+
 gdaltest_list = [
     vrtwarp_1,
     vrtwarp_2,
-    vrtwarp_3 ]
+    vrtwarp_3,
+    vrtwarp_4 ]
 
 if __name__ == '__main__':
 
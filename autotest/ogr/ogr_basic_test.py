@@ -32,6 +32,7 @@ import sys
 sys.path.append( '../pymod' )
 
 import gdaltest
+import ogrtest
 from osgeo import ogr
 
 ###############################################################################
@@ -406,6 +407,48 @@ def ogr_basic_9():
 
     return 'success'
 
+###############################################################################
+# Test rectangular and polygonal spatial filters on multi-part geometries
+
+def ogr_basic_10():
+
+    ds = ogr.GetDriverByName('Memory').CreateDataSource('')
+    lyr = ds.CreateLayer('test')
+    for wkt in [ 'MULTIPOINT (0 0,5 5)',
+                 'MULTIPOINT (-1 -1,11 11)',
+                 'MULTILINESTRING ((20 20,21 21),(1 1,2 2))',
+                 'MULTIPOLYGON (((20 20,20 21,21 21,20 20)),((1 1,1 2,2 2,1 1)))',
+                 'MULTILINESTRING ((-1 5,5 11),(20 20,21 21))' ]:
+        feat = ogr.Feature(lyr.GetLayerDefn())
+        feat.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(feat)
+
+    lyr.SetSpatialFilterRect(0, 0, 10, 10)
+    if ogrtest.have_geos():
+        expected_count = 4
+    else:
+        expected_count = 5
+    if lyr.GetFeatureCount() != expected_count:
+        gdaltest.post_reason('fail')
+        print(lyr.GetFeatureCount())
+        return 'fail'
+
+    # Same filter, but not recognized as a rectangle
+    lyr.SetSpatialFilter(ogr.CreateGeometryFromWkt('POLYGON ((0 0,0 10,10 10,10 5,10 0,0 0))'))
+    if lyr.GetFeatureCount() != expected_count:
+        gdaltest.post_reason('fail')
+        print(lyr.GetFeatureCount())
+        return 'fail'
+
+    lyr.SetSpatialFilter(None)
+    if lyr.GetFeatureCount() != 5:
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    ds = None
+
+    return 'success'
+
 ###############################################################################
 # cleanup
 
@@ -426,6 +469,7 @@ gdaltest_list = [
     ogr_basic_7,
     ogr_basic_8,
     ogr_basic_9,
+    ogr_basic_10,
     ogr_basic_cleanup ]
 
 if __name__ == '__main__':
@@ -487,6 +487,68 @@ def ogr_index_11():
 
     return 'success'
 
+###############################################################################
+# Test range lookups (<, <=, >, >=, BETWEEN) on indexed fields
+
+def ogr_index_12_check(lyr, expected_fids):
+
+    ret = ogr_index_11_check(lyr, expected_fids)
+    if ret != 'success':
+        return ret
+    if lyr.GetNextFeature() is not None:
+        gdaltest.post_reason('got more features than expected')
+        return 'fail'
+
+    return 'success'
+
+def ogr_index_12():
+
+    ds = ogr.GetDriverByName( 'ESRI Shapefile' ).CreateDataSource('tmp/ogr_index_12.dbf')
+    lyr = ds.CreateLayer('ogr_index_12', geom_type = ogr.wkbNone)
+    lyr.CreateField(ogr.FieldDefn('intfield', ogr.OFTInteger))
+    fld_defn = ogr.FieldDefn('realfield', ogr.OFTReal)
+    fld_defn.SetWidth(20)
+    fld_defn.SetPrecision(5)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn('strfield', ogr.OFTString))
+
+    ogrtest.quick_create_feature(lyr, [1, -2.5, "foo"], None)
+    ogrtest.quick_create_feature(lyr, [255, 0, "bar"], None)
+    ogrtest.quick_create_feature(lyr, [-1, 1.5, "foo"], None)
+    ogrtest.quick_create_feature(lyr, [10, -0.5, "bar"], None)
+    ogrtest.quick_create_feature(lyr, [3, 100, "baz"], None)
+
+    ds.ExecuteSQL('CREATE INDEX ON ogr_index_12 USING intfield')
+    ds.ExecuteSQL('CREATE INDEX ON ogr_index_12 USING realfield')
+    ds.ExecuteSQL('CREATE INDEX ON ogr_index_12 USING strfield')
+
+    tests = [ ("intfield > 3", [ 1, 3 ]),
+              ("intfield >= 3", [ 1, 3, 4 ]),
+              ("3 > intfield", [ 0, 2 ]),
+              ("intfield BETWEEN 2 AND 10", [ 3, 4 ]),
+              ("intfield BETWEEN -1 AND 1", [ 0, 2 ]),
+              ("intfield < 2.5", [ 0, 2 ]),
+              ("realfield > 0", [ 2, 4 ]),
+              ("realfield >= 0", [ 1, 2, 4 ]),
+              ("realfield < 0", [ 0, 3 ]),
+              ("realfield BETWEEN -1 AND 2", [ 1, 2, 3 ]),
+              ("realfield BETWEEN -3 AND -1", [ 0 ]),
+              ("intfield > 2 AND realfield < 1", [ 1, 3 ]),
+              ("intfield > 200 OR realfield < -1", [ 0, 1 ]),
+              ("intfield >= 0 AND strfield = 'bar'", [ 1, 3 ]),
+              ("strfield > 'bar'", [ 0, 2, 4 ]) ]
+
+    for (filter, expected_fids) in tests:
+        lyr.SetAttributeFilter(filter)
+        ret = ogr_index_12_check(lyr, expected_fids)
+        if ret != 'success':
+            print(filter)
+            return ret
+
+    ds = None
+
+    return 'success'
+
 ###############################################################################
 
 def ogr_index_cleanup():
@@ -514,6 +576,7 @@ def ogr_index_cleanup():
 
     ogr.GetDriverByName( 'ESRI Shapefile' ).DeleteDataSource( 'tmp/ogr_index_10.shp' )
     ogr.GetDriverByName( 'ESRI Shapefile' ).DeleteDataSource( 'tmp/ogr_index_11.dbf' )
+    ogr.GetDriverByName( 'ESRI Shapefile' ).DeleteDataSource( 'tmp/ogr_index_12.dbf' )
 
     return 'success'
 
@@ -529,6 +592,7 @@ gdaltest_list = [
     ogr_index_9,
     ogr_index_10,
     ogr_index_11,
+    ogr_index_12,
     ogr_index_cleanup ]
 
 if __name__ == '__main__':
@@ -483,6 +483,42 @@ def ogr_join_21():
     else:
         return 'fail'
 
+###############################################################################
+# Test that the hash join and the attribute filter based join give the same
+# results (including when the hash exceeds OGR_SQL_JOIN_HASH_MAX_MEMORY)
+
+def ogr_join_22():
+
+    sql = 'SELECT poly.eas_id, idlink.name FROM poly ' \
+        + 'LEFT JOIN idlink ON poly.eas_id = idlink.eas_id'
+
+    results = []
+    for options in [ (None, None), ('NO', None), (None, '0') ]:
+        # The options are only read when the first feature is translated, so
+        # they must remain set until the result layer has been read.
+        gdal.SetConfigOption( 'OGR_SQL_JOIN_USE_HASH', options[0] )
+        gdal.SetConfigOption( 'OGR_SQL_JOIN_HASH_MAX_MEMORY', options[1] )
+        sql_lyr = gdaltest.ds.ExecuteSQL( sql )
+
+        values = []
+        feat = sql_lyr.GetNextFeature()
+        while feat is not None:
+            values.append( (feat.GetField('eas_id'), feat.GetField('name')) )
+            feat = sql_lyr.GetNextFeature()
+        gdaltest.ds.ReleaseResultSet( sql_lyr )
+
+        gdal.SetConfigOption( 'OGR_SQL_JOIN_USE_HASH', None )
+        gdal.SetConfigOption( 'OGR_SQL_JOIN_HASH_MAX_MEMORY', None )
+
+        results.append( values )
+
+    if len(results[0]) != 10 or results[0] != results[1] or results[0] != results[2]:
+        gdaltest.post_reason( 'fail' )
+        print(results)
+        return 'fail'
+
+    return 'success'
+
 ###############################################################################
 
 def ogr_join_cleanup():
@@ -514,6 +550,7 @@ gdaltest_list = [
     ogr_join_19,
     ogr_join_20,
     ogr_join_21,
+    ogr_join_22,
     ogr_join_cleanup ]
 
 if __name__ == '__main__':
@@ -29,6 +29,7 @@
 import os
 import sys
 import string
+import shutil
 
 sys.path.append( '../pymod' )
 
@@ -543,6 +544,78 @@ def ogr_mitab_16():
 
     return 'success'
 
+###############################################################################
+# Test the generic spatial index with a .mif file
+
+def ogr_mitab_17():
+
+    if gdaltest.mapinfo_drv is None:
+        return 'skip'
+
+    shutil.copy('data/small.mif', 'tmp/small_sidx.mif')
+    shutil.copy('data/small.mid', 'tmp/small_sidx.mid')
+
+    ds = ogr.Open('tmp/small_sidx.mif')
+    lyr = ds.GetLayer(0)
+    (minx, maxx, miny, maxy) = lyr.GetExtent()
+    midx = (minx + maxx) / 2
+    midy = (miny + maxy) / 2
+    rects = [ (minx, miny, maxx, maxy),
+              (minx, miny, midx, midy),
+              (midx, midy, maxx, maxy),
+              (midx, midy, midx, midy),
+              (maxx + 1, maxy + 1, maxx + 2, maxy + 2) ]
+
+    expected = []
+    for rect in rects:
+        lyr.SetSpatialFilterRect(rect[0], rect[1], rect[2], rect[3])
+        expected.append([feat.GetFID() for feat in lyr])
+
+    if lyr.TestCapability(ogr.OLCFastSpatialFilter):
+        gdaltest.post_reason('did not expect fast spatial filter')
+        return 'fail'
+
+    ds.ExecuteSQL('CREATE SPATIAL INDEX ON small_sidx')
+    ds = None
+
+    try:
+        os.stat('tmp/small_sidx.mif.ogrsidx')
+    except:
+        gdaltest.post_reason('spatial index file not created')
+        return 'fail'
+
+    ds = ogr.Open('tmp/small_sidx.mif')
+    lyr = ds.GetLayer(0)
+    if not lyr.TestCapability(ogr.OLCFastSpatialFilter):
+        gdaltest.post_reason('expected fast spatial filter')
+        return 'fail'
+
+    for i in range(len(rects)):
+        rect = rects[i]
+        lyr.SetSpatialFilterRect(rect[0], rect[1], rect[2], rect[3])
+        got = [feat.GetFID() for feat in lyr]
+        if got != expected[i]:
+            gdaltest.post_reason('fail')
+            print(rect)
+            print(got)
+            print(expected[i])
+            return 'fail'
+
+    ds.ExecuteSQL('DROP SPATIAL INDEX ON small_sidx')
+    ds = None
+
+    try:
+        os.stat('tmp/small_sidx.mif.ogrsidx')
+        gdaltest.post_reason('spatial index file not deleted')
+        return 'fail'
+    except:
+        pass
+
+    os.unlink('tmp/small_sidx.mif')
+    os.unlink('tmp/small_sidx.mid')
+
+    return 'success'
+
 ###############################################################################
 #
 
@@ -574,6 +647,7 @@ gdaltest_list = [
     ogr_mitab_14,
     ogr_mitab_15,
     ogr_mitab_16,
+    ogr_mitab_17,
     ogr_mitab_cleanup
     ]
 
@@ -1253,6 +1253,207 @@ def ogr_sql_41():
     else:
         return 'fail'
 
+###############################################################################
+# Test ORDER BY when the features don't fit in OGR_SQL_ORDER_BY_MAX_MEMORY, so
+# that they are sorted in runs spilled to temporary files, merged at once or,
+# with OGR_SQL_ORDER_BY_MAX_OPEN_RUNS=2, in several passes.  The source is a
+# CSV file, which doesn't support random read, so that the whole features are
+# sorted.
+
+def ogr_sql_42():
+
+    f = open('tmp/ogr_sql_42.csv', 'w')
+    f.write('id,val\n')
+    for i in range(50):
+        f.write('%d,%d\n' % (i, (i * 7) % 10))
+    f.close()
+
+    # The sort is stable: ties keep the order of the source features.
+    expect = sorted(range(50), key = lambda i: -((i * 7) % 10))
+    expect = [ str(i) for i in expect ]
+
+    ds = ogr.Open('tmp/ogr_sql_42.csv')
+
+    tr = 1
+    for max_open_runs in [ None, '2' ]:
+
+        # The options are only read when the first feature is fetched, so
+        # they must remain set until the result layer has been read.
+        gdal.SetConfigOption( 'OGR_SQL_ORDER_BY_MAX_MEMORY', '0' )
+        gdal.SetConfigOption( 'OGR_SQL_ORDER_BY_MAX_OPEN_RUNS', max_open_runs )
+        sql_lyr = ds.ExecuteSQL( "SELECT * FROM ogr_sql_42 ORDER BY val DESC" )
+
+        tr = ogrtest.check_features_against_list( sql_lyr, 'id', expect )
+
+        if tr:
+            sql_lyr.SetNextByIndex( 37 )
+            feat = sql_lyr.GetNextFeature()
+            if feat is None or feat.GetField('id') != expect[37]:
+                gdaltest.post_reason( 'fail' )
+                print(max_open_runs)
+                tr = 0
+
+        if tr:
+            feat = sql_lyr.GetFeature( 9 )
+            if feat is None or feat.GetField('id') != expect[9]:
+                gdaltest.post_reason( 'fail' )
+                print(max_open_runs)
+                tr = 0
+
+        ds.ReleaseResultSet( sql_lyr )
+
+        gdal.SetConfigOption( 'OGR_SQL_ORDER_BY_MAX_MEMORY', None )
+        gdal.SetConfigOption( 'OGR_SQL_ORDER_BY_MAX_OPEN_RUNS', None )
+
+        if not tr:
+            break
+
+    ds = None
+    os.unlink('tmp/ogr_sql_42.csv')
+
+    if not tr:
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Test GROUP BY, in memory and with the groups spilled to temporary files,
+# merged at once or, with OGR_SQL_ORDER_BY_MAX_OPEN_RUNS=2, in several passes.
+
+def ogr_sql_43():
+
+    mem_ds = ogr.GetDriverByName("Memory").CreateDataSource( "my_ds")
+    mem_lyr = mem_ds.CreateLayer( "my_layer")
+    mem_lyr.CreateField( ogr.FieldDefn("cat", ogr.OFTString) )
+    mem_lyr.CreateField( ogr.FieldDefn("sub", ogr.OFTInteger) )
+    mem_lyr.CreateField( ogr.FieldDefn("val", ogr.OFTReal) )
+
+    for (cat, sub, val) in [ ('a', 1, 1.5), ('b', 2, 10), ('a', 2, 2.5),
+                             ('b', 2, None), (None, 1, 3), ('a', 1, 4) ]:
+        feat = ogr.Feature(mem_lyr.GetLayerDefn() )
+        if cat is not None:
+            feat.SetField('cat', cat)
+        feat.SetField('sub', sub)
+        if val is not None:
+            feat.SetField('val', val)
+        mem_lyr.CreateFeature( feat )
+
+    sql = "SELECT cat, COUNT(*), COUNT(val), SUM(val), MIN(val), MAX(val), " \
+          "COUNT(DISTINCT sub) FROM my_layer GROUP BY cat ORDER BY cat DESC"
+    expect = [ [ 'b', 2, 1, 10, 10, 10, 1 ],
+               [ 'a', 3, 3, 8, 1.5, 4, 2 ],
+               [ None, 1, 1, 3, 3, 3, 1 ] ]
+
+    # The options are only read when the first feature is fetched, so they
+    # must remain set until the result layer has been read.
+    ref_result = None
+    for (max_memory, max_open_runs) in [ (None, None), ('0', None), ('0', '2') ]:
+        gdal.SetConfigOption( 'OGR_SQL_GROUP_BY_MAX_MEMORY', max_memory )
+        gdal.SetConfigOption( 'OGR_SQL_ORDER_BY_MAX_OPEN_RUNS', max_open_runs )
+        sql_lyr = mem_ds.ExecuteSQL( sql )
+
+        result = []
+        feat = sql_lyr.GetNextFeature()
+        while feat is not None:
+            result.append( [ feat.GetField(j) for j in range(7) ] )
+            feat = sql_lyr.GetNextFeature()
+
+        feat = sql_lyr.GetFeature( 1 )
+        count = sql_lyr.GetFeatureCount()
+        mem_ds.ReleaseResultSet( sql_lyr )
+
+        gdal.SetConfigOption( 'OGR_SQL_GROUP_BY_MAX_MEMORY', None )
+        gdal.SetConfigOption( 'OGR_SQL_ORDER_BY_MAX_OPEN_RUNS', None )
+
+        if ref_result is None:
+            ref_result = result
+
+        if result != expect or result != ref_result:
+            gdaltest.post_reason( 'fail' )
+            print(max_memory, max_open_runs)
+            print(result)
+            return 'fail'
+
+        if count != 3:
+            gdaltest.post_reason( 'fail' )
+            return 'fail'
+
+        if feat is None or feat.GetField('cat') != 'a':
+            gdaltest.post_reason( 'fail' )
+            return 'fail'
+
+    sql_lyr = mem_ds.ExecuteSQL( "SELECT sub, cat, AVG(val) FROM my_layer GROUP BY cat, sub" )
+    expect = [ [ 1, None, 3 ], [ 1, 'a', 2.75 ], [ 2, 'a', 2.5 ], [ 2, 'b', 10 ] ]
+    for i in range(4):
+        feat = sql_lyr.GetNextFeature()
+        for j in range(3):
+            if feat.GetField(j) != expect[i][j]:
+                gdaltest.post_reason( 'fail' )
+                feat.DumpReadable()
+                return 'fail'
+    mem_ds.ReleaseResultSet( sql_lyr )
+
+    gdal.PushErrorHandler( 'CPLQuietErrorHandler' )
+    sql_lyr = mem_ds.ExecuteSQL( "SELECT cat, sub FROM my_layer GROUP BY cat" )
+    gdal.PopErrorHandler()
+    if sql_lyr is not None:
+        gdaltest.post_reason( 'fail' )
+        return 'fail'
+
+    mem_ds = None
+
+    return 'success'
+
+###############################################################################
+# Test that the compiled evaluation of attribute filters gives the same
+# results as the evaluation of the expression tree.
+
+def ogr_sql_44():
+
+    mem_ds = ogr.GetDriverByName("Memory").CreateDataSource( "my_ds")
+    mem_lyr = mem_ds.CreateLayer( "my_layer")
+    mem_lyr.CreateField( ogr.FieldDefn("cat", ogr.OFTString) )
+    mem_lyr.CreateField( ogr.FieldDefn("sub", ogr.OFTInteger) )
+    mem_lyr.CreateField( ogr.FieldDefn("val", ogr.OFTReal) )
+
+    for (cat, sub, val) in [ ('a', 1, 1.5), ('b', 2, 10), ('a', 2, 2.5),
+                             ('b', 2, None), (None, 1, 3), ('a', 1, 4) ]:
+        feat = ogr.Feature(mem_lyr.GetLayerDefn() )
+        if cat is not None:
+            feat.SetField('cat', cat)
+        feat.SetField('sub', sub)
+        if val is not None:
+            feat.SetField('val', val)
+        mem_lyr.CreateFeature( feat )
+
+    tests = [ ( "sub = 2", 3 ),
+              ( "val > 2 AND cat = 'A'", 2 ),
+              ( "val IS NULL OR cat IS NULL", 2 ),
+              ( "sub IN (1, 3) AND NOT (val IS NULL)", 3 ),
+              ( "val BETWEEN 2 AND 4", 3 ),
+              ( "cat LIKE 'b%' OR sub + 1 = 3", 3 ),
+              ( "cat <> 'a'", 2 ) ]
+
+    for compile in [ None, 'NO' ]:
+        gdal.SetConfigOption( 'OGR_FEATURE_QUERY_COMPILE', compile )
+        for (where, expected_count) in tests:
+            mem_lyr.SetAttributeFilter( where )
+            count = 0
+            feat = mem_lyr.GetNextFeature()
+            while feat is not None:
+                count = count + 1
+                feat = mem_lyr.GetNextFeature()
+            if count != expected_count:
+                gdal.SetConfigOption( 'OGR_FEATURE_QUERY_COMPILE', None )
+                gdaltest.post_reason( 'fail' )
+                print(where, compile, count)
+                return 'fail'
+        gdal.SetConfigOption( 'OGR_FEATURE_QUERY_COMPILE', None )
+
+    mem_ds = None
+
+    return 'success'
+
 def ogr_sql_cleanup():
     gdaltest.lyr = None
     gdaltest.ds.Destroy()
@@ -1303,6 +1504,9 @@ gdaltest_list = [
     ogr_sql_39,
     ogr_sql_40,
     ogr_sql_41,
+    ogr_sql_42,
+    ogr_sql_43,
+    ogr_sql_44,
     ogr_sql_cleanup ]
 
 if __name__ == '__main__':
@@ -2456,6 +2456,51 @@ def ogr_sqlite_34():
 
     return 'success'
 
+###############################################################################
+# Test that WKB blobs copied without being decoded are written back in the
+# NDR form that exportToWkb() produces
+
+def ogr_sqlite_35():
+
+    if gdaltest.sl_ds is None:
+        return 'skip'
+
+    ds = ogr.GetDriverByName('SQLite').CreateDataSource('tmp/ogr_sqlite_35_src.sqlite')
+    lyr = ds.CreateLayer('test', geom_type = ogr.wkbPoint)
+    feat = ogr.Feature(lyr.GetLayerDefn())
+    feat.SetGeometry(ogr.CreateGeometryFromWkt('POINT (1 2)'))
+    lyr.CreateFeature(feat)
+    feat = None
+    # Same point, as XDR WKB
+    ds.ExecuteSQL("UPDATE test SET GEOMETRY = X'00000000013FF00000000000004000000000000000'")
+    ds = None
+
+    src_ds = ogr.Open('tmp/ogr_sqlite_35_src.sqlite')
+    ds = ogr.GetDriverByName('SQLite').CreateDataSource('tmp/ogr_sqlite_35.sqlite')
+    ds.CopyLayer(src_ds.GetLayer(0), 'test')
+    src_ds = None
+    ds = None
+
+    ds = ogr.Open('tmp/ogr_sqlite_35.sqlite')
+    sql_lyr = ds.ExecuteSQL('SELECT hex(GEOMETRY) FROM test')
+    feat = sql_lyr.GetNextFeature()
+    val = feat.GetField(0)
+    ds.ReleaseResultSet(sql_lyr)
+    if val != '0101000000000000000000F03F0000000000000040':
+        gdaltest.post_reason('failure')
+        print(val)
+        return 'fail'
+
+    feat = ds.GetLayer(0).GetNextFeature()
+    if feat.GetGeometryRef().ExportToWkt() != 'POINT (1 2)':
+        gdaltest.post_reason('failure')
+        feat.DumpReadable()
+        return 'fail'
+    feat = None
+    ds = None
+
+    return 'success'
+
 ###############################################################################
 # 
 
@@ -2544,6 +2589,16 @@ def ogr_sqlite_cleanup():
     except:
         pass
 
+    try:
+        os.remove( 'tmp/ogr_sqlite_35_src.sqlite' )
+    except:
+        pass
+
+    try:
+        os.remove( 'tmp/ogr_sqlite_35.sqlite' )
+    except:
+        pass
+
     return 'success'
 
 ###############################################################################
@@ -2607,6 +2662,7 @@ gdaltest_list = [
     ogr_sqlite_32,
     ogr_sqlite_33,
     ogr_sqlite_34,
+    ogr_sqlite_35,
     ogr_sqlite_cleanup,
     ogr_sqlite_without_spatialite,
 ]
@@ -2393,6 +2393,145 @@ def ogr_vrt_32():
     return ogr_vrt_31(' shared="1"')
 
 
+###############################################################################
+# Test reading a union layer with several threads
+
+def ogr_vrt_33_read(lyr):
+
+    feats = {}
+    lyr.ResetReading()
+    feat = lyr.GetNextFeature()
+    while feat is not None:
+        if feat.GetFID() in feats:
+            gdaltest.post_reason('duplicated FID %d' % feat.GetFID())
+            return None
+        feats[feat.GetFID()] = (feat.GetField('source_layer'), feat.GetField('id'),
+                                feat.GetGeometryRef().ExportToWkt())
+        feat = lyr.GetNextFeature()
+
+    return feats
+
+def ogr_vrt_33():
+
+    drv = ogr.GetDriverByName('ESRI Shapefile')
+    for i in range(10):
+        ds = drv.CreateDataSource('tmp/ogr_vrt_33_%d.shp' % i)
+        lyr = ds.CreateLayer('ogr_vrt_33_%d' % i, geom_type = ogr.wkbPoint)
+        lyr.CreateField(ogr.FieldDefn('id', ogr.OFTInteger))
+        for j in range(100 + 10 * i):
+            feat = ogr.Feature(lyr.GetLayerDefn())
+            feat.SetField(0, i * 1000 + j)
+            feat.SetGeometry(ogr.CreateGeometryFromWkt('POINT(%d %d)' % (i, j)))
+            lyr.CreateFeature(feat)
+            feat = None
+        ds = None
+
+    for (vrt_filename, extra) in [ ('tmp/ogr_vrt_33_seq.vrt', ''),
+                                   ('tmp/ogr_vrt_33_par.vrt', '<NumThreads>4</NumThreads>'),
+                                   ('tmp/ogr_vrt_33_par_preserve.vrt',
+                                    '<NumThreads>4</NumThreads><PreserveSrcFID>ON</PreserveSrcFID>') ]:
+        f = open(vrt_filename, 'wt')
+        f.write('<OGRVRTDataSource>\n')
+        f.write('<OGRVRTUnionLayer name="union_layer">\n')
+        f.write('<SourceLayerFieldName>source_layer</SourceLayerFieldName>%s\n' % extra)
+        for i in range(10):
+            f.write('<OGRVRTLayer name="ogr_vrt_33_%d"><SrcDataSource relativetoVRT="1">ogr_vrt_33_%d.shp</SrcDataSource></OGRVRTLayer>\n' % (i, i))
+        f.write('</OGRVRTUnionLayer>\n')
+        f.write('</OGRVRTDataSource>\n')
+        f.close()
+
+    # With OGR_VRT_MAX_OPENED lower than the number of source layers, the
+    # source layers are opened and closed on demand by a shared pool
+    for max_opened in [ None, '2' ]:
+        gdal.SetConfigOption('OGR_VRT_MAX_OPENED', max_opened)
+        ds_seq = ogr.Open('tmp/ogr_vrt_33_seq.vrt')
+        lyr_seq = ds_seq.GetLayer(0)
+        ds_par = ogr.Open('tmp/ogr_vrt_33_par.vrt')
+        lyr_par = ds_par.GetLayer(0)
+        gdal.SetConfigOption('OGR_VRT_MAX_OPENED', None)
+
+        # FIDs must be the same as in sequential mode, whatever the filters
+        for (attr_filter, spatial_filter) in [ (None, None),
+                                               ('id >= 5050', None),
+                                               ('source_layer = \'ogr_vrt_33_3\'', None),
+                                               (None, (2.5, 10, 7.5, 60)),
+                                               ('id < 6020', (2.5, 10, 7.5, 60)) ]:
+            for lyr in [ lyr_seq, lyr_par ]:
+                lyr.SetAttributeFilter(attr_filter)
+                if spatial_filter is None:
+                    lyr.SetSpatialFilter(None)
+                else:
+                    lyr.SetSpatialFilterRect(spatial_filter[0], spatial_filter[1],
+                                             spatial_filter[2], spatial_filter[3])
+
+            feats_seq = ogr_vrt_33_read(lyr_seq)
+            feats_par = ogr_vrt_33_read(lyr_par)
+            if feats_seq is None or feats_par is None:
+                return 'fail'
+            if feats_seq != feats_par or len(feats_seq) == 0:
+                gdaltest.post_reason('fail')
+                print(max_opened, attr_filter, spatial_filter, len(feats_seq), len(feats_par))
+                return 'fail'
+
+            if lyr_par.GetFeatureCount() != len(feats_seq):
+                gdaltest.post_reason('fail')
+                print(max_opened, attr_filter, spatial_filter, lyr_par.GetFeatureCount())
+                return 'fail'
+
+        # A second reading uses the feature counts learnt by the first one
+        feats_par2 = ogr_vrt_33_read(lyr_par)
+        if feats_par2 != feats_par:
+            gdaltest.post_reason('fail')
+            print(max_opened)
+            return 'fail'
+
+    # Interrupted reading
+    lyr_par.SetAttributeFilter(None)
+    lyr_par.SetSpatialFilter(None)
+    lyr_par.ResetReading()
+    for i in range(10):
+        lyr_par.GetNextFeature()
+    feats_par = ogr_vrt_33_read(lyr_par)
+    if feats_par is None or len(feats_par) != 1450:
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    if lyr_par.GetExtent() != (0.0, 9.0, 0.0, 189.0):
+        gdaltest.post_reason('fail')
+        print(lyr_par.GetExtent())
+        return 'fail'
+
+    lyr_par.ResetReading()
+    lyr_par.GetNextFeature()
+    ds_seq = None
+    ds_par = None
+
+    # With PreserveSrcFID
+    ds = ogr.Open('tmp/ogr_vrt_33_par_preserve.vrt')
+    lyr = ds.GetLayer(0)
+    keys = []
+    feat = lyr.GetNextFeature()
+    while feat is not None:
+        keys.append((feat.GetField('source_layer'), feat.GetFID(), feat.GetField('id')))
+        feat = lyr.GetNextFeature()
+    keys.sort()
+    expected_keys = []
+    for i in range(10):
+        for j in range(100 + 10 * i):
+            expected_keys.append(('ogr_vrt_33_%d' % i, j, i * 1000 + j))
+    if keys != expected_keys:
+        gdaltest.post_reason('fail')
+        return 'fail'
+    ds = None
+
+    for i in range(10):
+        drv.DeleteDataSource('tmp/ogr_vrt_33_%d.shp' % i)
+    os.unlink('tmp/ogr_vrt_33_seq.vrt')
+    os.unlink('tmp/ogr_vrt_33_par.vrt')
+    os.unlink('tmp/ogr_vrt_33_par_preserve.vrt')
+
+    return 'success'
+
 ###############################################################################
 # 
 
@@ -2443,6 +2582,7 @@ gdaltest_list = [
     ogr_vrt_30,
     ogr_vrt_31,
     ogr_vrt_32,
+    ogr_vrt_33,
     ogr_vrt_cleanup ]
 
 if __name__ == '__main__':
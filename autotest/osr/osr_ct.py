@@ -241,6 +241,43 @@ def osr_ct_6():
 
     return 'success'
 
+###############################################################################
+# Test that the multi-threaded transformation of large point arrays
+# (OGR_CT_NUM_THREADS) gives the same results as the mono-threaded one.
+
+def osr_ct_7():
+
+    if gdaltest.have_proj4 == 0:
+        return 'skip'
+
+    utm_srs = osr.SpatialReference()
+    utm_srs.SetUTM( 11 )
+    utm_srs.SetWellKnownGeogCS( 'WGS84' )
+
+    ll_srs = osr.SpatialReference()
+    ll_srs.SetWellKnownGeogCS( 'WGS84' )
+
+    points = [ (-117.5 + i * 1e-5, 32.0 + i * 1e-5, 0.0) for i in range(50000) ]
+
+    ct = osr.CoordinateTransformation( ll_srs, utm_srs )
+    expected = ct.TransformPoints( points )
+    ct = None
+
+    gdal.SetConfigOption( 'OGR_CT_NUM_THREADS', '4' )
+    ct = osr.CoordinateTransformation( ll_srs, utm_srs )
+    gdal.SetConfigOption( 'OGR_CT_NUM_THREADS', None )
+    result = ct.TransformPoints( points )
+
+    for i in range(len(points)):
+        if abs(result[i][0] - expected[i][0]) > 1e-8 \
+           or abs(result[i][1] - expected[i][1]) > 1e-8:
+            gdaltest.post_reason( 'Wrong result for point %d' % i )
+            print(result[i])
+            print(expected[i])
+            return 'fail'
+
+    return 'success'
+
 ###############################################################################
 # Cleanup
 
@@ -260,6 +297,7 @@ gdaltest_list = [
     osr_ct_4,
     osr_ct_5,
     osr_ct_6,
+    osr_ct_7,
     osr_ct_cleanup,
     None ]
 
@@ -172,6 +172,7 @@ void GDALCleanupTransformDeserializerMutex();
 /* Transformer cloning */
 
 void* GDALCloneTPSTransformer( void *pTransformArg );
+int GDALGetTPSTransformerGCPCount( void *pTransformArg );
 void* GDALCloneGenImgProjTransformer( void *pTransformArg );
 void* GDALCloneApproxTransformer( void *pTransformArg );
 /* TODO : GDALCloneGeoLocTransformer? , GDALCloneRPCTransformer? */ 
@@ -179,6 +180,39 @@ void* GDALCloneApproxTransformer( void *pTransformArg );
 
 void CPL_DLL * GDALCloneTransformer( void *pTranformerArg );
 
+int GDALTransformIsAxisAligned( GDALTransformerFunc pfnTransformer,
+                                void *pTransformArg );
+
+void GDALApproxTransformerBuildGrid( void *pCBData, int nXSize, int nYSize );
+
+/* Cutline masking with a cutline prepared once per warp operation */
+
+void *GDALWarpPrepareCutline( OGRGeometryH hCutline );
+void GDALWarpDestroyPreparedCutline( void *hPreparedCutline );
+
+CPLErr 
+GDALWarpCutlineMaskerEx( void *pMaskFuncArg, void *hPreparedCutline,
+                         int nBandCount, GDALDataType eType,
+                         int nXOff, int nYOff, int nXSize, int nYSize,
+                         GByte ** ppImageData,
+                         int bMaskIsFloat, void *pValidityMask );
+
+/* AVX2 warp kernels, compiled separately in gdalwarpkernelavx2.cpp */
+
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+typedef void (*GWKResampleNoMasks8Func)( int nBands,
+                                         GByte * const *papabySrcImage,
+                                         int nSrcXSize,
+                                         const int *panSrcOffset,
+                                         const double *padfWeightX,
+                                         const double *padfWeightY,
+                                         double *padfValue );
+
+int GWKHaveRuntimeAVX2();
+GWKResampleNoMasks8Func GWKGetResampleNoMasks8AVX2( GDALDataType eType,
+                                                    int bCubic );
+#endif
+
 /************************************************************************/
 /*      Float comparison function.                                      */
 /************************************************************************/
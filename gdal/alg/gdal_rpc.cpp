@@ -256,6 +256,13 @@ typedef struct {
 
     double      adfGeoTransform[6];
     double      adfReverseGeoTransform[6];
+
+    /* Window of the DEM cached in memory, see GDALRPCLoadDEMWindow() */
+    GInt32      *panDEMCache;
+    int         nDEMCacheXOff;
+    int         nDEMCacheYOff;
+    int         nDEMCacheXSize;
+    int         nDEMCacheYSize;
 } GDALRPCTransformInfo;
 
 /************************************************************************/
@@ -491,6 +498,7 @@ void GDALDestroyRPCTransformer( void *pTransformAlg )
 
     if(psTransform->poDS)
         GDALClose(psTransform->poDS);
+    VSIFree( psTransform->panDEMCache );
     if(psTransform->poCT)
         OCTDestroyCoordinateTransformation((OGRCoordinateTransformationH)psTransform->poCT);
 
@@ -586,6 +594,192 @@ double BiCubicKernel(double dfVal)
 	return ( 0.16666666666666666667 * ( a - ( 4.0 * b ) + ( 6.0 * c ) - ( 4.0 * d ) ) );
 }
 
+/************************************************************************/
+/*                        GDALRPCLoadDEMWindow()                        */
+/*                                                                      */
+/*      Make sure that the [nXMin,nXMax[ x [nYMin,nYMax[ window of      */
+/*      the DEM is cached in memory.  The cached window is grown        */
+/*      geometrically, so that a scene is usually covered after a few   */
+/*      reads, unless it gets larger than RPC_DEM_CACHE_MAX_PIXELS, in  */
+/*      which case only the requested area and a margin are read.      */
+/************************************************************************/
+
+/* Largest DEM window cached in memory (64 MB of Int32 values) */
+#define RPC_DEM_CACHE_MAX_PIXELS    (16 * 1024 * 1024)
+/* Minimum margin read around a requested DEM window */
+#define RPC_DEM_CACHE_MARGIN        256
+
+static int GDALRPCLoadDEMWindow( GDALRPCTransformInfo *psTransform,
+                                 int nXMin, int nYMin, int nXMax, int nYMax )
+
+{
+    if( psTransform->panDEMCache != NULL
+        && nXMin >= psTransform->nDEMCacheXOff
+        && nYMin >= psTransform->nDEMCacheYOff
+        && nXMax <= psTransform->nDEMCacheXOff + psTransform->nDEMCacheXSize
+        && nYMax <= psTransform->nDEMCacheYOff + psTransform->nDEMCacheYSize )
+        return TRUE;
+
+    int nRasterXSize = psTransform->poDS->GetRasterXSize();
+    int nRasterYSize = psTransform->poDS->GetRasterYSize();
+
+/* -------------------------------------------------------------------- */
+/*      Merge with the current window, and add a margin proportional    */
+/*      to the size of the result.                                      */
+/* -------------------------------------------------------------------- */
+    int nNewXMin = nXMin, nNewYMin = nYMin, nNewXMax = nXMax, nNewYMax = nYMax;
+
+    if( psTransform->panDEMCache != NULL )
+    {
+        nNewXMin = MIN( nNewXMin, psTransform->nDEMCacheXOff );
+        nNewYMin = MIN( nNewYMin, psTransform->nDEMCacheYOff );
+        nNewXMax = MAX( nNewXMax, psTransform->nDEMCacheXOff
+                                  + psTransform->nDEMCacheXSize );
+        nNewYMax = MAX( nNewYMax, psTransform->nDEMCacheYOff
+                                  + psTransform->nDEMCacheYSize );
+    }
+
+    int nMarginX = MAX( RPC_DEM_CACHE_MARGIN, (nNewXMax - nNewXMin) / 2 );
+    int nMarginY = MAX( RPC_DEM_CACHE_MARGIN, (nNewYMax - nNewYMin) / 2 );
+
+    nNewXMin = MAX( 0, nNewXMin - nMarginX );
+    nNewYMin = MAX( 0, nNewYMin - nMarginY );
+    nNewXMax = MIN( nRasterXSize, nNewXMax + nMarginX );
+    nNewYMax = MIN( nRasterYSize, nNewYMax + nMarginY );
+
+    if( (GIntBig)(nNewXMax - nNewXMin) * (nNewYMax - nNewYMin)
+                                                > RPC_DEM_CACHE_MAX_PIXELS )
+    {
+        nNewXMin = MAX( 0, nXMin - RPC_DEM_CACHE_MARGIN );
+        nNewYMin = MAX( 0, nYMin - RPC_DEM_CACHE_MARGIN );
+        nNewXMax = MIN( nRasterXSize, nXMax + RPC_DEM_CACHE_MARGIN );
+        nNewYMax = MIN( nRasterYSize, nYMax + RPC_DEM_CACHE_MARGIN );
+
+        if( (GIntBig)(nNewXMax - nNewXMin) * (nNewYMax - nNewYMin)
+                                                > RPC_DEM_CACHE_MAX_PIXELS )
+            return FALSE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Read it.                                                        */
+/* -------------------------------------------------------------------- */
+    int nNewXSize = nNewXMax - nNewXMin;
+    int nNewYSize = nNewYMax - nNewYMin;
+    GInt32 *panNewCache = (GInt32 *)
+        VSIMalloc3( nNewXSize, nNewYSize, sizeof(GInt32) );
+
+    if( panNewCache == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate %d x %d DEM cache.",
+                  nNewXSize, nNewYSize );
+        return FALSE;
+    }
+
+    if( psTransform->poDS->GetRasterBand(1)->RasterIO(
+            GF_Read, nNewXMin, nNewYMin, nNewXSize, nNewYSize,
+            panNewCache, nNewXSize, nNewYSize, GDT_Int32, 0, 0 ) != CE_None )
+    {
+        VSIFree( panNewCache );
+        return FALSE;
+    }
+
+    VSIFree( psTransform->panDEMCache );
+    psTransform->panDEMCache = panNewCache;
+    psTransform->nDEMCacheXOff = nNewXMin;
+    psTransform->nDEMCacheYOff = nNewYMin;
+    psTransform->nDEMCacheXSize = nNewXSize;
+    psTransform->nDEMCacheYSize = nNewYSize;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                        GDALRPCGetDEMHeight()                         */
+/*                                                                      */
+/*      Interpolate the DEM at a DEM pixel/line location, from the      */
+/*      cached DEM window.                                              */
+/************************************************************************/
+
+static int GDALRPCGetDEMHeight( GDALRPCTransformInfo *psTransform,
+                                double dfX, double dfY, double *pdfDEMH )
+
+{
+    int nRasterXSize = psTransform->poDS->GetRasterXSize();
+    int nRasterYSize = psTransform->poDS->GetRasterYSize();
+
+    if( !(dfX > -1.0 && dfY > -1.0 && dfX < nRasterXSize
+          && dfY < nRasterYSize) )
+        return FALSE;
+
+    int dX = int(dfX);
+    int dY = int(dfY);
+    double dfDeltaX = dfX - dX;
+    double dfDeltaY = dfY - dY;
+    int nKernelXOff = dX, nKernelYOff = dY, nKernelSize = 1;
+
+    if( psTransform->eResampleAlg == DRA_Cubic )
+    {
+        nKernelXOff = dX - 1;
+        nKernelYOff = dY - 1;
+        nKernelSize = 4;
+    }
+    else if( psTransform->eResampleAlg == DRA_Bilinear )
+        nKernelSize = 2;
+
+    if( !(nKernelXOff >= 0 && nKernelYOff >= 0
+          && nKernelXOff + nKernelSize <= nRasterXSize
+          && nKernelYOff + nKernelSize <= nRasterYSize) )
+        return FALSE;
+
+    if( !GDALRPCLoadDEMWindow( psTransform, nKernelXOff, nKernelYOff,
+                               nKernelXOff + nKernelSize,
+                               nKernelYOff + nKernelSize ) )
+        return FALSE;
+
+    const int nLineStride = psTransform->nDEMCacheXSize;
+    const GInt32 *panElevData = psTransform->panDEMCache
+        + (nKernelYOff - psTransform->nDEMCacheYOff) * nLineStride
+        + (nKernelXOff - psTransform->nDEMCacheXOff);
+
+    if( psTransform->eResampleAlg == DRA_Cubic )
+    {
+        // Weights of the bicubic b-spline kernel along each axis
+        double adfWeightX[4], adfWeightY[4];
+        int    i, j;
+
+        for( i = 0; i < 4; i++ )
+        {
+            adfWeightX[i] = BiCubicKernel( (i - 1) - dfDeltaX );
+            adfWeightY[i] = BiCubicKernel( (i - 1) - dfDeltaY );
+        }
+
+        double dfSumH(0);
+        for( i = 0; i < 4; i++ )
+        {
+            for( j = 0; j < 4; j++ )
+                dfSumH += panElevData[j + i * nLineStride]
+                                        * (adfWeightX[j] * adfWeightY[i]);
+        }
+        *pdfDEMH = dfSumH;
+    }
+    else if( psTransform->eResampleAlg == DRA_Bilinear )
+    {
+        double dfDeltaX1 = 1.0 - dfDeltaX;
+        double dfDeltaY1 = 1.0 - dfDeltaY;
+
+        double dfXZ1 = panElevData[0] * dfDeltaX1
+                     + panElevData[1] * dfDeltaX;
+        double dfXZ2 = panElevData[nLineStride] * dfDeltaX1
+                     + panElevData[nLineStride + 1] * dfDeltaX;
+        *pdfDEMH = dfXZ1 * dfDeltaY1 + dfXZ2 * dfDeltaY;
+    }
+    else
+        *pdfDEMH = panElevData[0];
+
+    return TRUE;
+}
+
 /************************************************************************/
 /*                          GDALRPCTransform()                          */
 /************************************************************************/
@@ -605,9 +799,6 @@ int GDALRPCTransform( void *pTransformArg, int bDstToSrc,
     if( psTransform->bReversed )
         bDstToSrc = !bDstToSrc;
 
-    int bands[1] = {1};
-    int nRasterXSize = 0, nRasterYSize = 0;
-
 /* -------------------------------------------------------------------- */
 /*      Lazy opening of the optionnal DEM file.                         */
 /* -------------------------------------------------------------------- */
@@ -649,150 +840,138 @@ int GDALRPCTransform( void *pTransformArg, int bDstToSrc,
             psTransform->poDS = NULL;
         }
     }
-    if (psTransform->poDS)
-    {
-        nRasterXSize = psTransform->poDS->GetRasterXSize();
-        nRasterYSize = psTransform->poDS->GetRasterYSize();
-    }
 
 /* -------------------------------------------------------------------- */
 /*      The simple case is transforming from lat/long to pixel/line.    */
 /*      Just apply the equations directly.                              */
 /* -------------------------------------------------------------------- */
-    if( bDstToSrc )
+    if( bDstToSrc && psTransform->poDS == NULL )
     {
         for( i = 0; i < nPointCount; i++ )
         {
-            if(psTransform->poDS)
+            RPCTransformPoint( psRPC, padfX[i], padfY[i], 
+                               padfZ[i] + psTransform->dfHeightOffset *
+                                          psTransform->dfHeightScale, 
+                               padfX + i, padfY + i );
+            panSuccess[i] = TRUE;
+        }
+
+        return TRUE;
+    }
+
+    if( bDstToSrc )
+    {
+/* -------------------------------------------------------------------- */
+/*      With a DEM, first compute the DEM pixel/line of all the         */
+/*      points, and load the DEM window covering them, so that the      */
+/*      heights are then interpolated from memory.                      */
+/* -------------------------------------------------------------------- */
+        double *padfDEMX = (double *)
+            VSIMalloc2( nPointCount, 2 * sizeof(double) );
+        if( padfDEMX == NULL )
+        {
+            CPLError( CE_Failure, CPLE_OutOfMemory,
+                      "Out of memory in GDALRPCTransform()." );
+            return FALSE;
+        }
+        double *padfDEMY = padfDEMX + nPointCount;
+
+        memcpy( padfDEMX, padfX, sizeof(double) * nPointCount );
+        memcpy( padfDEMY, padfY, sizeof(double) * nPointCount );
+
+        //check if dem is not in WGS84 and transform the points
+        if( psTransform->poCT )
+        {
+            double *padfDEMZ = (double *)
+                VSIMalloc2( nPointCount, sizeof(double) );
+            if( padfDEMZ == NULL )
             {
-                double dfX, dfY;
-                //check if dem is not in WGS84 and transform points padfX[i], padfY[i]
-                if(psTransform->poCT)
-                {
-                    double dfXOrig = padfX[i];
-                    double dfYOrig = padfY[i];
-                    double dfZOrig = padfZ[i];
-                    if (!psTransform->poCT->Transform(
-                                                1, &dfXOrig, &dfYOrig, &dfZOrig))
-                    {
-                        panSuccess[i] = FALSE;
-                        continue;
-                    }
-                    GDALApplyGeoTransform( psTransform->adfReverseGeoTransform,
-                                           dfXOrig, dfYOrig, &dfX, &dfY );
-                }
-                else
-                    GDALApplyGeoTransform( psTransform->adfReverseGeoTransform,
-                                           padfX[i], padfY[i], &dfX, &dfY );
-                int dX = int(dfX);
-                int dY = int(dfY);
-
-                if (!(dX >= 0 && dY >= 0 &&
-                      dX+2 <= nRasterXSize && dY+2 <= nRasterYSize))
-                {
-                    panSuccess[i] = FALSE;
-                    continue;
-                }
+                CPLError( CE_Failure, CPLE_OutOfMemory,
+                          "Out of memory in GDALRPCTransform()." );
+                VSIFree( padfDEMX );
+                return FALSE;
+            }
+            memcpy( padfDEMZ, padfZ, sizeof(double) * nPointCount );
 
-                double dfDEMH(0);
-                double dfDeltaX = dfX - dX;
-                double dfDeltaY = dfY - dY;
-                
-                if(psTransform->eResampleAlg == DRA_Cubic)
-                {
-                    int dXNew = dX - 1;
-                    int dYNew = dY - 1;
-                    if (!(dXNew >= 0 && dYNew >= 0 && dXNew + 4 <= nRasterXSize && dYNew + 4 <= nRasterYSize))
-                    {
-                        panSuccess[i] = FALSE;
-                        continue;
-                    }
-                    //cubic interpolation
-                    int anElevData[16] = {0};
-                    CPLErr eErr = psTransform->poDS->RasterIO(GF_Read, dXNew, dYNew, 4, 4,
-                                                              &anElevData, 4, 4,
-                                                              GDT_Int32, 1, bands, 0, 0, 0);
-                    if(eErr != CE_None)
-                    {
-                        panSuccess[i] = FALSE;
-                        continue;
-                    }
-
-                    double dfSumH(0);
-                    for ( int i = 0; i < 4; i++ )
-                    {
-                        // Loop across the X axis
-                        for ( int j = 0; j < 4; j++ )
-                        {
-                            // Calculate the weight for the specified pixel according
-                            // to the bicubic b-spline kernel we're using for
-                            // interpolation
-                            int dKernIndX = j - 1;
-                            int dKernIndY = i - 1;
-                            double dfPixelWeight = BiCubicKernel(dKernIndX - dfDeltaX) * BiCubicKernel(dKernIndY - dfDeltaY);
-
-                            // Create a sum of all values
-                            // adjusted for the pixel's calculated weight
-                            dfSumH += anElevData[j + i * 4] * dfPixelWeight;
-                        }
-                    }
-                    dfDEMH = dfSumH;
-                }
-                else if(psTransform->eResampleAlg == DRA_Bilinear)
+            if( !psTransform->poCT->TransformEx( nPointCount,
+                                                 padfDEMX, padfDEMY, padfDEMZ,
+                                                 panSuccess ) )
+            {
+                /* A single failing point can make the whole batch fail */
+                for( i = 0; i < nPointCount; i++ )
                 {
-                    if (!(dX >= 0 && dY >= 0 && dX + 2 <= nRasterXSize && dY + 2 <= nRasterYSize))
-                    {
-                        panSuccess[i] = FALSE;
-                        continue;
-                    }
-                    //bilinear interpolation
-                    int anElevData[4] = {0,0,0,0};
-                    CPLErr eErr = psTransform->poDS->RasterIO(GF_Read, dX, dY, 2, 2,
-                                                              &anElevData, 2, 2,
-                                                              GDT_Int32, 1, bands, 0, 0, 0);
-                    if(eErr != CE_None)
-                    {
-                        panSuccess[i] = FALSE;
-                        continue;
-                    }
-                    double dfDeltaX1 = 1.0 - dfDeltaX;                
-                    double dfDeltaY1 = 1.0 - dfDeltaY;
-
-                    double dfXZ1 = anElevData[0] * dfDeltaX1 + anElevData[1] * dfDeltaX;
-                    double dfXZ2 = anElevData[2] * dfDeltaX1 + anElevData[3] * dfDeltaX;
-                    double dfYZ = dfXZ1 * dfDeltaY1 + dfXZ2 * dfDeltaY;
-                    dfDEMH = dfYZ;
+                    padfDEMX[i] = padfX[i];
+                    padfDEMY[i] = padfY[i];
+                    padfDEMZ[i] = padfZ[i];
+                    panSuccess[i] = psTransform->poCT->Transform(
+                        1, padfDEMX + i, padfDEMY + i, padfDEMZ + i );
                 }
-                else
-                {
-                    if (!(dX >= 0 && dY >= 0 && dX <= nRasterXSize && dY <= nRasterYSize))
-                    {
-                        panSuccess[i] = FALSE;
-                        continue;
-                    }
-                    CPLErr eErr = psTransform->poDS->RasterIO(GF_Read, dX, dY, 1, 1,
-                                                              &dfDEMH, 1, 1,
-                                                              GDT_Int32, 1, bands, 0, 0, 0);
-                    if(eErr != CE_None)
-                    {
-                        panSuccess[i] = FALSE;
-                        continue;
-                    }              
-                }                
-
-                RPCTransformPoint( psRPC, padfX[i], padfY[i], 
-                                   padfZ[i] + (psTransform->dfHeightOffset + dfDEMH) *
-                                                psTransform->dfHeightScale, 
-                                   padfX + i, padfY + i );
             }
-            else
-                RPCTransformPoint( psRPC, padfX[i], padfY[i], 
-                                   padfZ[i] + psTransform->dfHeightOffset *
-                                              psTransform->dfHeightScale, 
-                                   padfX + i, padfY + i );
-            panSuccess[i] = TRUE;
+
+            VSIFree( padfDEMZ );
+        }
+        else
+        {
+            for( i = 0; i < nPointCount; i++ )
+                panSuccess[i] = TRUE;
+        }
+
+        int nXMin = INT_MAX, nYMin = INT_MAX, nXMax = 0, nYMax = 0;
+        int nRasterXSize = psTransform->poDS->GetRasterXSize();
+        int nRasterYSize = psTransform->poDS->GetRasterYSize();
+
+        for( i = 0; i < nPointCount; i++ )
+        {
+            if( !panSuccess[i] )
+                continue;
+
+            GDALApplyGeoTransform( psTransform->adfReverseGeoTransform,
+                                   padfDEMX[i], padfDEMY[i],
+                                   padfDEMX + i, padfDEMY + i );
+
+            if( padfDEMX[i] >= 0.0 && padfDEMY[i] >= 0.0
+                && padfDEMX[i] < nRasterXSize && padfDEMY[i] < nRasterYSize )
+            {
+                int dX = int(padfDEMX[i]);
+                int dY = int(padfDEMY[i]);
+
+                nXMin = MIN( nXMin, dX );
+                nYMin = MIN( nYMin, dY );
+                nXMax = MAX( nXMax, dX );
+                nYMax = MAX( nYMax, dY );
+            }
+        }
+
+        /* Enough for all the kernels.  If too large, the windows are */
+        /* loaded point by point by GDALRPCGetDEMHeight() */
+        if( nXMin <= nXMax )
+            GDALRPCLoadDEMWindow( psTransform, MAX( 0, nXMin - 1 ),
+                                  MAX( 0, nYMin - 1 ),
+                                  MIN( nRasterXSize, nXMax + 3 ),
+                                  MIN( nRasterYSize, nYMax + 3 ) );
+
+        for( i = 0; i < nPointCount; i++ )
+        {
+            double dfDEMH(0);
+
+            if( !panSuccess[i] )
+                continue;
+
+            if( !GDALRPCGetDEMHeight( psTransform, padfDEMX[i], padfDEMY[i],
+                                      &dfDEMH ) )
+            {
+                panSuccess[i] = FALSE;
+                continue;
+            }
+
+            RPCTransformPoint( psRPC, padfX[i], padfY[i], 
+                               padfZ[i] + (psTransform->dfHeightOffset + dfDEMH) *
+                                            psTransform->dfHeightScale, 
+                               padfX + i, padfY + i );
         }
 
+        VSIFree( padfDEMX );
+
         return TRUE;
     }
 
@@ -826,93 +1005,12 @@ int GDALRPCTransform( void *pTransformArg, int bDstToSrc,
 
             GDALApplyGeoTransform( psTransform->adfReverseGeoTransform,
                                     dfResultX, dfResultY, &dfX, &dfY );
-            int dX = int(dfX);
-            int dY = int(dfY);
 
             double dfDEMH(0);
-            double dfDeltaX = dfX - dX;
-            double dfDeltaY = dfY - dY;
-
-            if(psTransform->eResampleAlg == DRA_Cubic)
+            if( !GDALRPCGetDEMHeight( psTransform, dfX, dfY, &dfDEMH ) )
             {
-                int dXNew = dX - 1;
-                int dYNew = dY - 1;
-                if (!(dXNew >= 0 && dYNew >= 0 && dXNew + 4 <= nRasterXSize && dYNew + 4 <= nRasterYSize))
-                {
-                    panSuccess[i] = FALSE;
-                    continue;
-                }
-                //cubic interpolation
-                int anElevData[16] = {0};
-                CPLErr eErr = psTransform->poDS->RasterIO(GF_Read, dXNew, dYNew, 4, 4,
-                                                          &anElevData, 4, 4,
-                                                          GDT_Int32, 1, bands, 0, 0, 0);
-                if(eErr != CE_None)
-                {
-                    panSuccess[i] = FALSE;
-                    continue;
-                }
-
-                double dfSumH(0);
-                for ( int i = 0; i < 4; i++ )
-                {
-                    // Loop across the X axis
-                    for ( int j = 0; j < 4; j++ )
-                    {
-                        // Calculate the weight for the specified pixel according
-                        // to the bicubic b-spline kernel we're using for
-                        // interpolation
-                        int dKernIndX = j - 1;
-                        int dKernIndY = i - 1;
-                        double dfPixelWeight = BiCubicKernel(dKernIndX - dfDeltaX) * BiCubicKernel(dKernIndY - dfDeltaY);
-
-                        // Create a sum of all values
-                        // adjusted for the pixel's calculated weight
-                        dfSumH += anElevData[j + i * 4] * dfPixelWeight;
-                    }
-                }
-                dfDEMH = dfSumH;
-            }
-            else if(psTransform->eResampleAlg == DRA_Bilinear)
-            {
-                if (!(dX >= 0 && dY >= 0 && dX + 2 <= nRasterXSize && dY + 2 <= nRasterYSize))
-                {
-                    panSuccess[i] = FALSE;
-                    continue;
-                }
-                //bilinear interpolation
-                int anElevData[4] = {0,0,0,0};
-                CPLErr eErr = psTransform->poDS->RasterIO(GF_Read, dX, dY, 2, 2,
-                                                          &anElevData, 2, 2,
-                                                          GDT_Int32, 1, bands, 0, 0, 0);
-                if(eErr != CE_None)
-                {
-                    panSuccess[i] = FALSE;
-                    continue;
-                }
-                double dfDeltaX1 = 1.0 - dfDeltaX;                
-                double dfDeltaY1 = 1.0 - dfDeltaY;
-
-                double dfXZ1 = anElevData[0] * dfDeltaX1 + anElevData[1] * dfDeltaX;
-                double dfXZ2 = anElevData[2] * dfDeltaX1 + anElevData[3] * dfDeltaX;
-                double dfYZ = dfXZ1 * dfDeltaY1 + dfXZ2 * dfDeltaY;
-                dfDEMH = dfYZ;
-            }
-            else
-            {
-                if (!(dX >= 0 && dY >= 0 && dX <= nRasterXSize && dY <= nRasterYSize))
-                {
-                    panSuccess[i] = FALSE;
-                    continue;
-                }
-                CPLErr eErr = psTransform->poDS->RasterIO(GF_Read, dX, dY, 1, 1,
-                                                          &dfDEMH, 1, 1,
-                                                          GDT_Int32, 1, bands, 0, 0, 0);
-                if(eErr != CE_None)
-                {
-                    panSuccess[i] = FALSE;
-                    continue;
-                }           
+                panSuccess[i] = FALSE;
+                continue;
             }
 
             RPCInverseTransformPoint( psTransform, padfX[i], padfY[i], 
@@ -32,6 +32,8 @@
 #include "cpl_conv.h"
 #include "cpl_string.h"
 #include "cpl_atomic_ops.h"
+#include "cpl_multiproc.h"
+#include "gdal_alg_priv.h"
 
 CPL_CVSID("$Id$");
 
@@ -74,6 +76,24 @@ void* GDALCloneTPSTransformer( void *hTransformArg )
     return psInfo;
 }
 
+/************************************************************************/
+/*                   GDALGetTPSTransformerGCPCount()                    */
+/************************************************************************/
+
+int GDALGetTPSTransformerGCPCount( void *pTransformArg )
+{
+    return ((TPSTransformInfo *) pTransformArg)->nGCPCount;
+}
+
+/************************************************************************/
+/*                       GDALTPSSolveThread()                           */
+/************************************************************************/
+
+static void GDALTPSSolveThread( void *pData )
+{
+    ((VizGeorefSpline2D *) pData)->solve();
+}
+
 /************************************************************************/
 /*                      GDALCreateTPSTransformer()                      */
 /************************************************************************/
@@ -90,8 +110,9 @@ void* GDALCloneTPSTransformer( void *hTransformArg )
  * Creating the TPS transformer involves solving systems of linear equations
  * related to the number of control points involved.  This solution is
  * computed within this function call.  It can be quite an expensive operation
- * for large numbers of GCPs.  For instance, for reference, it takes on the 
- * order of 10s for 400 GCPs on a 2GHz Athlon processor. 
+ * for large numbers of GCPs, as its cost grows with the cube of the number
+ * of GCPs.  The forward and reverse systems are solved concurrently when
+ * several CPUs are available.
  *
  * TPS Transformers are serializable. 
  *
@@ -158,8 +179,22 @@ void *GDALCreateTPSTransformer( int nGCPCount, const GDAL_GCP *pasGCPList,
 
     psInfo->nRefCount = 1;
 
+/* -------------------------------------------------------------------- */
+/*      Solve the forward and reverse systems, in parallel if it is     */
+/*      worth it.                                                       */
+/* -------------------------------------------------------------------- */
+    void *hThread = NULL;
+
+    if( nGCPCount > 100 && CPLGetNumCPUs() > 1 )
+        hThread = CPLCreateJoinableThread( GDALTPSSolveThread,
+                                           psInfo->poReverse );
+
     psInfo->poForward->solve();
-    psInfo->poReverse->solve();
+
+    if( hThread != NULL )
+        CPLJoinThread( hThread );
+    else
+        psInfo->poReverse->solve();
 
     return psInfo;
 }
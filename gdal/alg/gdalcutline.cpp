@@ -29,134 +29,591 @@
 
 #include "gdalwarper.h"
 #include "gdal_alg.h"
+#include "gdal_alg_priv.h"
 #include "ogr_api.h"
-#include "ogr_geos.h"
 #include "ogr_geometry.h"
 #include "cpl_string.h"
 
+#include <algorithm>
+#include <vector>
+
 CPL_CVSID("$Id$");
 
+/* Height in rows of the bands of the edge index of a prepared cutline. */
+#define CUTLINE_INDEX_BAND_SIZE     16
+
 /************************************************************************/
-/*                         BlendMaskGenerator()                         */
+/* ==================================================================== */
+/*                        GDALPreparedCutline                           */
+/* ==================================================================== */
 /************************************************************************/
 
-static CPLErr
-BlendMaskGenerator( int nXOff, int nYOff, int nXSize, int nYSize, 
-                    GByte *pabyPolyMask, float *pafValidityMask,
-                    OGRGeometryH hPolygon, double dfBlendDist )
+/*
+ * The edges of the cutline rings, in source pixel coordinates, indexed
+ * by bands of CUTLINE_INDEX_BAND_SIZE rows.  A mask chunk only looks at
+ * the edges of the bands it covers, instead of rasterizing the whole
+ * cutline.
+ */
+
+typedef struct {
+    double      dfX1;           // in the order the rasterizer walks them.
+    double      dfY1;
+    double      dfX2;
+    double      dfY2;
+    int         nFirstBand;
+} CutlineEdge;
+
+typedef struct {
+    OGREnvelope sEnvelope;
+
+    int          nEdgeCount;
+    CutlineEdge *pasEdges;
+
+    // panBandEdges[panBandStart[i]...panBandStart[i+1]-1] are the edges
+    // that may cross a row of band i, the band of row nIndexYOff + i *
+    // CUTLINE_INDEX_BAND_SIZE.
+    int          nIndexYOff;
+    int          nBandCount;
+    int         *panBandStart;
+    int         *panBandEdges;
+} GDALPreparedCutline;
+
+/************************************************************************/
+/*                          CutlineAddRing()                            */
+/************************************************************************/
+
+static void CutlineAddRing( std::vector<CutlineEdge> &aoEdges, 
+                            OGRLinearRing *poRing )
+
+{
+    int nPoints = poRing->getNumPoints();
+
+    for( int i = 0; i < nPoints; i++ )
+    {
+        // The rasterizer walks the rings backward, and joins their last
+        // point to the first one, which is a null edge for closed rings.
+        // The direction matters to tell bottom horizontal edges.
+        int iNext = (i == 0) ? nPoints - 1 : i - 1;
+        CutlineEdge sEdge;
+
+        sEdge.dfX1 = poRing->getX(i);
+        sEdge.dfY1 = poRing->getY(i);
+        sEdge.dfX2 = poRing->getX(iNext);
+        sEdge.dfY2 = poRing->getY(iNext);
+        sEdge.nFirstBand = 0;
+
+        if( sEdge.dfX1 == sEdge.dfX2 && sEdge.dfY1 == sEdge.dfY2 )
+            continue;
+
+        aoEdges.push_back( sEdge );
+    }
+}
+
+/************************************************************************/
+/*                       GDALWarpPrepareCutline()                       */
+/*                                                                      */
+/*      Build the edge index of a polygon or multipolygon cutline in    */
+/*      source pixel coordinates.                                       */
+/************************************************************************/
+
+void *GDALWarpPrepareCutline( OGRGeometryH hCutline )
 
 {
-#ifndef HAVE_GEOS 
-    CPLError( CE_Failure, CPLE_AppDefined, 
-              "Blend distance support not available without the GEOS library.");
-    return CE_Failure;
+    OGRGeometry *poGeom = (OGRGeometry *) hCutline;
+    OGRwkbGeometryType eType = wkbFlatten(poGeom->getGeometryType());
+    std::vector<CutlineEdge> aoEdges;
+
+    if( eType == wkbPolygon )
+    {
+        OGRPolygon *poPoly = (OGRPolygon *) poGeom;
+
+        if( poPoly->getExteriorRing() != NULL )
+            CutlineAddRing( aoEdges, poPoly->getExteriorRing() );
+        for( int iRing = 0; iRing < poPoly->getNumInteriorRings(); iRing++ )
+            CutlineAddRing( aoEdges, poPoly->getInteriorRing(iRing) );
+    }
+    else if( eType == wkbMultiPolygon )
+    {
+        OGRMultiPolygon *poMPoly = (OGRMultiPolygon *) poGeom;
+
+        for( int iGeom = 0; iGeom < poMPoly->getNumGeometries(); iGeom++ )
+        {
+            OGRPolygon *poPoly = (OGRPolygon *) poMPoly->getGeometryRef(iGeom);
+
+            if( poPoly->getExteriorRing() != NULL )
+                CutlineAddRing( aoEdges, poPoly->getExteriorRing() );
+            for( int iRing = 0; iRing < poPoly->getNumInteriorRings(); iRing++ )
+                CutlineAddRing( aoEdges, poPoly->getInteriorRing(iRing) );
+        }
+    }
+    else
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Cutline is not a polygon or a multipolygon." );
+        return NULL;
+    }
+
+    GDALPreparedCutline *psPrep = (GDALPreparedCutline *)
+        CPLCalloc( sizeof(GDALPreparedCutline), 1 );
 
-#else /* HAVE_GEOS */
+    poGeom->getEnvelope( &(psPrep->sEnvelope) );
+
+    if( aoEdges.empty() )
+        return psPrep;
 
 /* -------------------------------------------------------------------- */
-/*      Convert the polygon into a collection of lines so that we       */
-/*      measure distance from the edge even on the inside.              */
+/*      Count the edges of each band.  Bands are widened by one row     */
+/*      on each side so that rounding of the chunk offsets cannot       */
+/*      make us miss an edge.                                           */
 /* -------------------------------------------------------------------- */
-    OGRGeometry *poLines
-        = OGRGeometryFactory::forceToMultiLineString( 
-            ((OGRGeometry *) hPolygon)->clone() );
+    int i, iBand;
+    int nEdgeCount = (int) aoEdges.size();
+
+    psPrep->nIndexYOff = (int) floor(psPrep->sEnvelope.MinY) - 1;
+    psPrep->nBandCount = 
+        (int) ((ceil(psPrep->sEnvelope.MaxY) + 1 - psPrep->nIndexYOff) 
+               / CUTLINE_INDEX_BAND_SIZE) + 1;
+    psPrep->panBandStart = (int *) 
+        CPLCalloc( sizeof(int), psPrep->nBandCount + 1 );
+
+    std::vector<int> anLastBand( nEdgeCount );
+    for( i = 0; i < nEdgeCount; i++ )
+    {
+        CutlineEdge *psEdge = &(aoEdges[i]);
+        double dfMinY = MIN(psEdge->dfY1, psEdge->dfY2);
+        double dfMaxY = MAX(psEdge->dfY1, psEdge->dfY2);
+
+        psEdge->nFirstBand = MAX(0, 
+            ((int) floor(dfMinY) - 1 - psPrep->nIndexYOff) 
+            / CUTLINE_INDEX_BAND_SIZE);
+        anLastBand[i] = MIN(psPrep->nBandCount - 1,
+            ((int) ceil(dfMaxY) + 1 - psPrep->nIndexYOff) 
+            / CUTLINE_INDEX_BAND_SIZE);
+
+        for( iBand = psEdge->nFirstBand; iBand <= anLastBand[i]; iBand++ )
+            psPrep->panBandStart[iBand+1]++;
+    }
+
+    for( iBand = 0; iBand < psPrep->nBandCount; iBand++ )
+        psPrep->panBandStart[iBand+1] += psPrep->panBandStart[iBand];
 
 /* -------------------------------------------------------------------- */
-/*      Prepare a clipping polygon a bit bigger than the area of        */
-/*      interest in the hopes of simplifying the cutline down to        */
-/*      stuff that will be relavent for this area of interest.          */
+/*      Fill the band lists.                                            */
 /* -------------------------------------------------------------------- */
-    CPLString osClipRectWKT;
-
-    osClipRectWKT.Printf( "POLYGON((%g %g,%g %g,%g %g,%g %g,%g %g))", 
-                          nXOff - (dfBlendDist+1), 
-                          nYOff - (dfBlendDist+1), 
-                          nXOff + nXSize + (dfBlendDist+1), 
-                          nYOff - (dfBlendDist+1), 
-                          nXOff + nXSize + (dfBlendDist+1), 
-                          nYOff + nYSize + (dfBlendDist+1), 
-                          nXOff - (dfBlendDist+1), 
-                          nYOff + nYSize + (dfBlendDist+1), 
-                          nXOff - (dfBlendDist+1), 
-                          nYOff - (dfBlendDist+1) );
-    
-    OGRPolygon *poClipRect = NULL;
-    char *pszWKT = (char *) osClipRectWKT.c_str();
-    
-    OGRGeometryFactory::createFromWkt( &pszWKT, NULL, 
-                                       (OGRGeometry**) (&poClipRect) );
+    std::vector<int> anBandFill( psPrep->panBandStart, 
+                                 psPrep->panBandStart + psPrep->nBandCount );
+
+    psPrep->panBandEdges = (int *) 
+        VSIMalloc2( sizeof(int), psPrep->panBandStart[psPrep->nBandCount] );
+    psPrep->pasEdges = (CutlineEdge *) 
+        VSIMalloc2( sizeof(CutlineEdge), nEdgeCount );
+    if( psPrep->panBandEdges == NULL || psPrep->pasEdges == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate the edge index of the cutline." );
+        GDALWarpDestroyPreparedCutline( psPrep );
+        return NULL;
+    }
+
+    for( i = 0; i < nEdgeCount; i++ )
+    {
+        for( iBand = aoEdges[i].nFirstBand; iBand <= anLastBand[i]; iBand++ )
+            psPrep->panBandEdges[anBandFill[iBand]++] = i;
+    }
+
+    memcpy( psPrep->pasEdges, &(aoEdges[0]), sizeof(CutlineEdge) * nEdgeCount );
+    psPrep->nEdgeCount = nEdgeCount;
+
+    return psPrep;
+}
+
+/************************************************************************/
+/*                   GDALWarpDestroyPreparedCutline()                   */
+/************************************************************************/
+
+void GDALWarpDestroyPreparedCutline( void *hPreparedCutline )
+
+{
+    GDALPreparedCutline *psPrep = (GDALPreparedCutline *) hPreparedCutline;
+
+    if( psPrep == NULL )
+        return;
+
+    CPLFree( psPrep->pasEdges );
+    CPLFree( psPrep->panBandStart );
+    CPLFree( psPrep->panBandEdges );
+    CPLFree( psPrep );
+}
+
+/************************************************************************/
+/*                        CutlineGetBandEdges()                         */
+/*                                                                      */
+/*      Return the edges of the band of an absolute source row.         */
+/************************************************************************/
+
+static const int *CutlineGetBandEdges( GDALPreparedCutline *psPrep, int nRow,
+                                       int *pnEdgeCount )
+
+{
+    int iBand = (nRow - psPrep->nIndexYOff) / CUTLINE_INDEX_BAND_SIZE;
+
+    if( psPrep->nEdgeCount == 0 || nRow < psPrep->nIndexYOff
+        || iBand >= psPrep->nBandCount )
+    {
+        *pnEdgeCount = 0;
+        return NULL;
+    }
+
+    *pnEdgeCount = psPrep->panBandStart[iBand+1] - psPrep->panBandStart[iBand];
+    return psPrep->panBandEdges + psPrep->panBandStart[iBand];
+}
+
+/************************************************************************/
+/*                         CutlineBurnPolygon()                         */
+/*                                                                      */
+/*      Fill the cutline in a chunk of the source image, with the       */
+/*      same rules as GDALdllImageFilledPolygon(): a pixel is inside    */
+/*      when its center is, crossings being rounded to the nearest      */
+/*      pixel edge, and bottom horizontal edges are filled too.         */
+/************************************************************************/
+
+static void CutlineBurnPolygon( GDALPreparedCutline *psPrep, 
+                                int nXOff, int nYOff, int nXSize, int nYSize,
+                                GByte *pabyPolyMask )
+
+{
+    std::vector<int> anInts;
+
+    for( int iY = 0; iY < nYSize; iY++ )
+    {
+        int nBandEdges = 0;
+        const int *panEdges = CutlineGetBandEdges( psPrep, nYOff + iY, 
+                                                   &nBandEdges );
+        GByte *pabyLine = pabyPolyMask + iY * nXSize;
+        double dy = iY + 0.5; /* center height of line */
+
+        anInts.resize( 0 );
+
+        for( int i = 0; i < nBandEdges; i++ )
+        {
+            const CutlineEdge *psEdge = psPrep->pasEdges + panEdges[i];
+            double dx1, dy1, dx2, dy2;
+
+            // Same chunk relative coordinates as the rasterizer was given.
+            dy1 = psEdge->dfY1 - nYOff;
+            dy2 = psEdge->dfY2 - nYOff;
+
+            if( (dy1 < dy && dy2 < dy) || (dy1 > dy && dy2 > dy) )
+                continue;
+
+            if( dy1 < dy2 )
+            {
+                dx1 = psEdge->dfX1 - nXOff;
+                dx2 = psEdge->dfX2 - nXOff;
+            }
+            else if( dy1 > dy2 )
+            {
+                dy2 = psEdge->dfY1 - nYOff;
+                dy1 = psEdge->dfY2 - nYOff;
+                dx2 = psEdge->dfX1 - nXOff;
+                dx1 = psEdge->dfX2 - nXOff;
+            }
+            else
+            {
+                // Fill bottom horizontal edges separately, top ones are
+                // filled by the regular crossings.
+                if( psEdge->dfX1 - nXOff > psEdge->dfX2 - nXOff )
+                {
+                    int nX1 = (int) floor(psEdge->dfX2 - nXOff + 0.5);
+                    int nX2 = (int) floor(psEdge->dfX1 - nXOff + 0.5);
+
+                    nX1 = MAX(nX1, 0);
+                    nX2 = MIN(nX2, nXSize);
+                    if( nX1 < nX2 )
+                        memset( pabyLine + nX1, 255, nX2 - nX1 );
+                }
+                continue;
+            }
+
+            if( dy < dy2 && dy >= dy1 )
+            {
+                double dfIntersect = (dy-dy1) * (dx2-dx1) / (dy2-dy1) + dx1;
+
+                anInts.push_back( (int) floor(dfIntersect+0.5) );
+            }
+        }
+
+        std::sort( anInts.begin(), anInts.end() );
+
+        for( int i = 0; i + 1 < (int) anInts.size(); i += 2 )
+        {
+            int nX1 = MAX(anInts[i], 0);
+            int nX2 = MIN(anInts[i+1], nXSize);
+
+            if( nX1 < nX2 )
+                memset( pabyLine + nX1, 255, nX2 - nX1 );
+        }
+    }
+}
+
+/************************************************************************/
+/*                         CutlineEdgeDistance()                        */
+/*                                                                      */
+/*      Distance from a point to an edge.                               */
+/************************************************************************/
+
+static double CutlineEdgeDistance( const CutlineEdge *psEdge, 
+                                   double dfX, double dfY )
+
+{
+    double dfDX = psEdge->dfX2 - psEdge->dfX1;
+    double dfDY = psEdge->dfY2 - psEdge->dfY1;
+    double dfLen2 = dfDX * dfDX + dfDY * dfDY;
+    double dfR = ((dfX - psEdge->dfX1) * dfDX + (dfY - psEdge->dfY1) * dfDY)
+        / dfLen2;
+
+    if( dfR <= 0.0 )
+        return sqrt( (dfX - psEdge->dfX1) * (dfX - psEdge->dfX1)
+                     + (dfY - psEdge->dfY1) * (dfY - psEdge->dfY1) );
+    if( dfR >= 1.0 )
+        return sqrt( (dfX - psEdge->dfX2) * (dfX - psEdge->dfX2)
+                     + (dfY - psEdge->dfY2) * (dfY - psEdge->dfY2) );
+
+    double dfS = ((psEdge->dfY1 - dfY) * dfDX - (psEdge->dfX1 - dfX) * dfDY)
+        / dfLen2;
+
+    return fabs(dfS) * sqrt(dfLen2);
+}
+
+/************************************************************************/
+/*                         BlendMaskGenerator()                         */
+/*                                                                      */
+/*      Scale the validity mask by the distance to the cutline edge.    */
+/*      The distance of each pixel to the nearest edge comes from a     */
+/*      vector distance transform: pixels near the edges are seeded     */
+/*      with the nearest of them, and two raster passes propagate to    */
+/*      each pixel the nearest edge among those of its neighbours.      */
+/************************************************************************/
+
+static CPLErr
+BlendMaskGenerator( int nXOff, int nYOff, int nXSize, int nYSize, 
+                    GByte *pabyPolyMask, float *pafValidityMask,
+                    GDALPreparedCutline *psPrep, double dfBlendDist )
 
-    if( poClipRect )
+{
+/* -------------------------------------------------------------------- */
+/*      Work on a window with a margin of the blend distance, so that   */
+/*      edges outside of the chunk are accounted for.                   */
+/* -------------------------------------------------------------------- */
+    int nMargin = (int) ceil(dfBlendDist) + 2;
+    int nWinXOff = nXOff - nMargin;
+    int nWinYOff = nYOff - nMargin;
+    int nWinXSize = nXSize + 2 * nMargin;
+    int nWinYSize = nYSize + 2 * nMargin;
+    double dfMaxDist = dfBlendDist + 2.0;
+    int i, iX, iY;
+
+    int    *panEdge = (int *) VSIMalloc3( nWinXSize, nWinYSize, sizeof(int) );
+    double *padfDist = (double *) 
+        VSIMalloc3( nWinXSize, nWinYSize, sizeof(double) );
+
+    if( panEdge == NULL || padfDist == NULL )
     {
-        OGRGeometry *poClippedLines = 
-            poLines->Intersection( poClipRect );
-        delete poLines;
-        poLines = poClippedLines;
-        delete poClipRect;
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate the cutline blend distance buffers." );
+        CPLFree( panEdge );
+        CPLFree( padfDist );
+        return CE_Failure;
+    }
+
+    for( i = nWinXSize * nWinYSize - 1; i >= 0; i-- )
+    {
+        panEdge[i] = -1;
+        padfDist[i] = dfMaxDist;
     }
 
 /* -------------------------------------------------------------------- */
-/*      Convert our polygon into GEOS format, and compute an            */
-/*      envelope to accelerate later distance operations.               */
+/*      Seed the pixels within one pixel of each edge crossing the      */
+/*      window.  Edges spanning several bands are only taken from the   */
+/*      first band of the window they appear in.                        */
 /* -------------------------------------------------------------------- */
-    OGREnvelope sEnvelope;
-    int iXMin, iYMin, iXMax, iYMax;
-    GEOSContextHandle_t hGEOSCtxt = OGRGeometry::createGEOSContext();
-    GEOSGeom poGEOSPoly;
+    int nFirstBand = -1;
 
-    poGEOSPoly = poLines->exportToGEOS(hGEOSCtxt);
-    OGR_G_GetEnvelope( hPolygon, &sEnvelope );
+    for( iY = 0; iY < nWinYSize; iY++ )
+    {
+        int nRow = nWinYOff + iY;
+        int nBandEdges = 0;
+        const int *panEdges = CutlineGetBandEdges( psPrep, nRow, &nBandEdges );
+        int iBand = (nRow - psPrep->nIndexYOff) / CUTLINE_INDEX_BAND_SIZE;
 
-    delete poLines;
+        if( panEdges == NULL 
+            || (iY > 0 && (nRow - psPrep->nIndexYOff) 
+                          % CUTLINE_INDEX_BAND_SIZE != 0) )
+            continue;
 
-    if( sEnvelope.MinY - dfBlendDist > nYOff+nYSize 
-        || sEnvelope.MaxY + dfBlendDist < nYOff 
-        || sEnvelope.MinX - dfBlendDist > nXOff+nXSize
-        || sEnvelope.MaxX + dfBlendDist < nXOff )
-        return CE_None;
-    
-    iXMin = MAX(0,(int) floor(sEnvelope.MinX - dfBlendDist - nXOff));
-    iXMax = MIN(nXSize, (int) ceil(sEnvelope.MaxX + dfBlendDist - nXOff));
-    iYMin = MAX(0,(int) floor(sEnvelope.MinY - dfBlendDist - nYOff));
-    iYMax = MIN(nYSize, (int) ceil(sEnvelope.MaxY + dfBlendDist - nYOff));
+        if( nFirstBand < 0 )
+            nFirstBand = iBand;
+
+        for( int iEdge = 0; iEdge < nBandEdges; iEdge++ )
+        {
+            const CutlineEdge *psEdge = psPrep->pasEdges + panEdges[iEdge];
+
+            if( MAX(psEdge->nFirstBand, nFirstBand) != iBand )
+                continue;
+
+            // Clip the edge to the window (Liang-Barsky).
+            double dfX1 = psEdge->dfX1 - nWinXOff;
+            double dfY1 = psEdge->dfY1 - nWinYOff;
+            double dfDX = psEdge->dfX2 - psEdge->dfX1;
+            double dfDY = psEdge->dfY2 - psEdge->dfY1;
+            double adfP[4] = { -dfDX, dfDX, -dfDY, dfDY };
+            double adfQ[4] = { dfX1 + 1, nWinXSize + 1 - dfX1,
+                               dfY1 + 1, nWinYSize + 1 - dfY1 };
+            double dfT0 = 0.0, dfT1 = 1.0;
+            int    bInside = TRUE;
+
+            for( int k = 0; k < 4 && bInside; k++ )
+            {
+                if( adfP[k] == 0.0 )
+                {
+                    if( adfQ[k] < 0.0 )
+                        bInside = FALSE;
+                }
+                else
+                {
+                    double dfT = adfQ[k] / adfP[k];
+                    if( adfP[k] < 0.0 )
+                        dfT0 = MAX(dfT0, dfT);
+                    else
+                        dfT1 = MIN(dfT1, dfT);
+                    if( dfT0 > dfT1 )
+                        bInside = FALSE;
+                }
+            }
+            if( !bInside )
+                continue;
+
+            // Walk the clipped edge by half pixel steps.
+            double dfLength = (dfT1 - dfT0) * sqrt(dfDX * dfDX + dfDY * dfDY);
+            int nSteps = (int) ceil(dfLength * 2) + 1;
+
+            for( int iStep = 0; iStep <= nSteps; iStep++ )
+            {
+                double dfT = dfT0 + (dfT1 - dfT0) * iStep / nSteps;
+                int nCX = (int) floor(dfX1 + dfT * dfDX);
+                int nCY = (int) floor(dfY1 + dfT * dfDY);
+
+                for( int iNY = MAX(0, nCY - 1); 
+                     iNY <= MIN(nWinYSize - 1, nCY + 1); iNY++ )
+                {
+                    for( int iNX = MAX(0, nCX - 1); 
+                         iNX <= MIN(nWinXSize - 1, nCX + 1); iNX++ )
+                    {
+                        int iWin = iNX + iNY * nWinXSize;
+
+                        if( panEdge[iWin] == panEdges[iEdge] )
+                            continue;
+
+                        double dfDist = CutlineEdgeDistance( 
+                            psEdge, nWinXOff + iNX + 0.5, nWinYOff + iNY + 0.5 );
+                        if( dfDist < padfDist[iWin] )
+                        {
+                            padfDist[iWin] = dfDist;
+                            panEdge[iWin] = panEdges[iEdge];
+                        }
+                    }
+                }
+            }
+        }
+    }
 
 /* -------------------------------------------------------------------- */
-/*      Loop over potential area within blend line distance,            */
-/*      processing each pixel.                                          */
+/*      Propagate the nearest edges, forward then backward.             */
 /* -------------------------------------------------------------------- */
-    int iY, iX;
-    double dfLastDist;
-    
-    for( iY = 0; iY < nYSize; iY++ )
+#define CUTLINE_PROPAGATE(iWin, iNeighbour)                             \
+    if( panEdge[iNeighbour] >= 0 && panEdge[iNeighbour] != panEdge[iWin] ) \
+    {                                                                   \
+        double dfDist = CutlineEdgeDistance(                            \
+            psPrep->pasEdges + panEdge[iNeighbour], dfPX, dfPY );       \
+        if( dfDist < padfDist[iWin] )                                   \
+        {                                                               \
+            padfDist[iWin] = dfDist;                                    \
+            panEdge[iWin] = panEdge[iNeighbour];                        \
+        }                                                               \
+    }
+
+    for( iY = 0; iY < nWinYSize; iY++ )
     {
-        dfLastDist = 0.0;
+        double dfPY = nWinYOff + iY + 0.5;
 
-        for( iX = 0; iX < nXSize; iX++ )
+        for( iX = 0; iX < nWinXSize; iX++ )
         {
-            if( iX < iXMin || iX >= iXMax
-                || iY < iYMin || iY > iYMax
-                || dfLastDist > dfBlendDist + 1.5 )
+            double dfPX = nWinXOff + iX + 0.5;
+            int iWin = iX + iY * nWinXSize;
+
+            if( iX > 0 )
+                CUTLINE_PROPAGATE( iWin, iWin - 1 );
+            if( iY > 0 )
             {
-                if( pabyPolyMask[iX + iY * nXSize] == 0 )
-                    pafValidityMask[iX + iY * nXSize] = 0.0;
+                if( iX > 0 )
+                    CUTLINE_PROPAGATE( iWin, iWin - nWinXSize - 1 );
+                CUTLINE_PROPAGATE( iWin, iWin - nWinXSize );
+                if( iX + 1 < nWinXSize )
+                    CUTLINE_PROPAGATE( iWin, iWin - nWinXSize + 1 );
+            }
+        }
+        for( iX = nWinXSize - 2; iX >= 0; iX-- )
+        {
+            double dfPX = nWinXOff + iX + 0.5;
+            int iWin = iX + iY * nWinXSize;
 
-                dfLastDist -= 1.0;
-                continue;
+            CUTLINE_PROPAGATE( iWin, iWin + 1 );
+        }
+    }
+
+    for( iY = nWinYSize - 1; iY >= 0; iY-- )
+    {
+        double dfPY = nWinYOff + iY + 0.5;
+
+        for( iX = nWinXSize - 1; iX >= 0; iX-- )
+        {
+            double dfPX = nWinXOff + iX + 0.5;
+            int iWin = iX + iY * nWinXSize;
+
+            if( iX + 1 < nWinXSize )
+                CUTLINE_PROPAGATE( iWin, iWin + 1 );
+            if( iY + 1 < nWinYSize )
+            {
+                if( iX + 1 < nWinXSize )
+                    CUTLINE_PROPAGATE( iWin, iWin + nWinXSize + 1 );
+                CUTLINE_PROPAGATE( iWin, iWin + nWinXSize );
+                if( iX > 0 )
+                    CUTLINE_PROPAGATE( iWin, iWin + nWinXSize - 1 );
             }
-            
-            double dfDist, dfRatio;
-            CPLString osPointWKT;
-            GEOSGeom poGEOSPoint;
+        }
+        for( iX = 1; iX < nWinXSize; iX++ )
+        {
+            double dfPX = nWinXOff + iX + 0.5;
+            int iWin = iX + iY * nWinXSize;
 
-            osPointWKT.Printf( "POINT(%d.5 %d.5)", iX + nXOff, iY + nYOff );
-            poGEOSPoint = GEOSGeomFromWKT_r( hGEOSCtxt, osPointWKT );
+            CUTLINE_PROPAGATE( iWin, iWin - 1 );
+        }
+    }
 
-            GEOSDistance_r( hGEOSCtxt, poGEOSPoly, poGEOSPoint, &dfDist );
-            GEOSGeom_destroy_r( hGEOSCtxt, poGEOSPoint );
+#undef CUTLINE_PROPAGATE
 
-            dfLastDist = dfDist;
+/* -------------------------------------------------------------------- */
+/*      Apply the blend ratio to the pixels of the chunk.               */
+/* -------------------------------------------------------------------- */
+    for( iY = 0; iY < nYSize; iY++ )
+    {
+        for( iX = 0; iX < nXSize; iX++ )
+        {
+            int iWin = (iX + nMargin) + (iY + nMargin) * nWinXSize;
+            double dfDist = padfDist[iWin];
+            double dfRatio;
 
-            if( dfDist > dfBlendDist )
+            if( panEdge[iWin] < 0 || dfDist > dfBlendDist )
             {
                 if( pabyPolyMask[iX + iY * nXSize] == 0 )
                     pafValidityMask[iX + iY * nXSize] = 0.0;
@@ -182,12 +639,10 @@ BlendMaskGenerator( int nXOff, int nYOff, int nXSize, int nYSize,
 /* -------------------------------------------------------------------- */
 /*      Cleanup                                                         */
 /* -------------------------------------------------------------------- */
-    GEOSGeom_destroy_r( hGEOSCtxt, poGEOSPoly );
-    OGRGeometry::freeGEOSContext( hGEOSCtxt );
+    CPLFree( panEdge );
+    CPLFree( padfDist );
 
     return CE_None;
-
-#endif /* HAVE_GEOS */
 }
 
 /************************************************************************/
@@ -233,14 +688,61 @@ static int CutlineTransformer( void *pTransformArg, int bDstToSrc,
 CPLErr 
 GDALWarpCutlineMasker( void *pMaskFuncArg, int nBandCount, GDALDataType eType,
                        int nXOff, int nYOff, int nXSize, int nYSize,
-                       GByte ** /*ppImageData */,
+                       GByte ** ppImageData,
                        int bMaskIsFloat, void *pValidityMask )
 
 {
     GDALWarpOptions *psWO = (GDALWarpOptions *) pMaskFuncArg;
+
+    if( nXSize < 1 || nYSize < 1 )
+        return CE_None;
+
+    if( psWO == NULL || psWO->hCutline == NULL )
+    {
+        CPLAssert( FALSE );
+        return CE_Failure;
+    }
+
+    void *hPreparedCutline = 
+        GDALWarpPrepareCutline( (OGRGeometryH) psWO->hCutline );
+    if( hPreparedCutline == NULL )
+    {
+        CPLAssert( FALSE );
+        return CE_Failure;
+    }
+
+    CPLErr eErr = 
+        GDALWarpCutlineMaskerEx( pMaskFuncArg, hPreparedCutline, 
+                                 nBandCount, eType, 
+                                 nXOff, nYOff, nXSize, nYSize, 
+                                 ppImageData, bMaskIsFloat, pValidityMask );
+
+    GDALWarpDestroyPreparedCutline( hPreparedCutline );
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                      GDALWarpCutlineMaskerEx()                       */
+/*                                                                      */
+/*      Same as GDALWarpCutlineMasker(), with a cutline prepared by     */
+/*      GDALWarpPrepareCutline() once for all the chunks.  The          */
+/*      prepared cutline is only read, so chunks may be masked          */
+/*      concurrently.                                                   */
+/************************************************************************/
+
+CPLErr 
+GDALWarpCutlineMaskerEx( void *pMaskFuncArg, void *hPreparedCutline,
+                         int /* nBandCount */, GDALDataType /* eType */,
+                         int nXOff, int nYOff, int nXSize, int nYSize,
+                         GByte ** /*ppImageData */,
+                         int bMaskIsFloat, void *pValidityMask )
+
+{
+    GDALWarpOptions *psWO = (GDALWarpOptions *) pMaskFuncArg;
+    GDALPreparedCutline *psPrep = (GDALPreparedCutline *) hPreparedCutline;
     float *pafMask = (float *) pValidityMask;
-    CPLErr eErr;
-    GDALDriverH hMemDriver;
+    CPLErr eErr = CE_None;
 
     if( nXSize < 1 || nYSize < 1 )
         return CE_None;
@@ -254,33 +756,18 @@ GDALWarpCutlineMasker( void *pMaskFuncArg, int nBandCount, GDALDataType eType,
         return CE_Failure;
     }
 
-    if( psWO == NULL || psWO->hCutline == NULL )
+    if( psWO == NULL || psWO->hCutline == NULL || psPrep == NULL )
     {
         CPLAssert( FALSE );
         return CE_Failure;
     }
 
-    hMemDriver = GDALGetDriverByName("MEM");
-    if (hMemDriver == NULL)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "GDALWarpCutlineMasker needs MEM driver");
-        return CE_Failure;
-    }
-
 /* -------------------------------------------------------------------- */
 /*      Check the polygon.                                              */
 /* -------------------------------------------------------------------- */
     OGRGeometryH hPolygon = (OGRGeometryH) psWO->hCutline;
-    OGREnvelope  sEnvelope;
+    const OGREnvelope &sEnvelope = psPrep->sEnvelope;
 
-    if( wkbFlatten(OGR_G_GetGeometryType(hPolygon)) != wkbPolygon
-        && wkbFlatten(OGR_G_GetGeometryType(hPolygon)) != wkbMultiPolygon )
-    {
-        CPLAssert( FALSE );
-        return CE_Failure;
-    }
-
-    OGR_G_GetEnvelope( hPolygon, &sEnvelope );
     if( sEnvelope.MaxX + psWO->dfCutlineBlendDist < nXOff
         || sEnvelope.MinX - psWO->dfCutlineBlendDist > nXOff + nXSize
         || sEnvelope.MaxY + psWO->dfCutlineBlendDist < nYOff
@@ -294,74 +781,105 @@ GDALWarpCutlineMasker( void *pMaskFuncArg, int nBandCount, GDALDataType eType,
     }
 
 /* -------------------------------------------------------------------- */
-/*      Create a byte buffer into which we can burn the                 */
-/*      mask polygon and wrap it up as a memory dataset.                */
+/*      Create a byte buffer into which we can burn the mask            */
+/*      polygon.                                                        */
 /* -------------------------------------------------------------------- */
-    GByte *pabyPolyMask = (GByte *) CPLCalloc( nXSize, nYSize );
-    GDALDatasetH hMemDS;
-    double adfGeoTransform[6] = { 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
-
-    char szDataPointer[100];
-    char *apszOptions[] = { szDataPointer, NULL };
+    GByte *pabyPolyMask = (GByte *) VSICalloc( nXSize, nYSize );
 
-    memset( szDataPointer, 0, sizeof(szDataPointer) );
-    sprintf( szDataPointer, "DATAPOINTER=" );
-    CPLPrintPointer( szDataPointer+strlen(szDataPointer), 
-                    pabyPolyMask, 
-                     sizeof(szDataPointer) - strlen(szDataPointer) );
-
-    hMemDS = GDALCreate( hMemDriver, "warp_temp", 
-                         nXSize, nYSize, 0, GDT_Byte, NULL );
-    GDALAddBand( hMemDS, GDT_Byte, apszOptions );
-    GDALSetGeoTransform( hMemDS, adfGeoTransform );
+    if( pabyPolyMask == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate the cutline mask of a %dx%d chunk.",
+                  nXSize, nYSize );
+        return CE_Failure;
+    }
 
 /* -------------------------------------------------------------------- */
-/*      Burn the polygon into the mask with 1.0 values.                 */
+/*      Burn the polygon into the mask with 255 values.  Only the       */
+/*      edges of the rows of the chunk are scanned, unless all the      */
+/*      touched pixels are requested in which case the rasterizer is    */
+/*      used through a memory dataset.                                  */
 /* -------------------------------------------------------------------- */
-    int nTargetBand = 1;
-    double dfBurnValue = 255.0;
-    int    anXYOff[2];
-    char   **papszRasterizeOptions = NULL;
-    
+    if( !CSLFetchBoolean( psWO->papszWarpOptions, "CUTLINE_ALL_TOUCHED", 
+                          FALSE ) )
+    {
+        CutlineBurnPolygon( psPrep, nXOff, nYOff, nXSize, nYSize, 
+                            pabyPolyMask );
+    }
+    else
+    {
+        GDALDriverH hMemDriver = GDALGetDriverByName("MEM");
+        if (hMemDriver == NULL)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "GDALWarpCutlineMasker needs MEM driver");
+            CPLFree( pabyPolyMask );
+            return CE_Failure;
+        }
+
+        GDALDatasetH hMemDS;
+        double adfGeoTransform[6] = { 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
+
+        char szDataPointer[100];
+        char *apszOptions[] = { szDataPointer, NULL };
+
+        memset( szDataPointer, 0, sizeof(szDataPointer) );
+        sprintf( szDataPointer, "DATAPOINTER=" );
+        CPLPrintPointer( szDataPointer+strlen(szDataPointer), 
+                         pabyPolyMask, 
+                         sizeof(szDataPointer) - strlen(szDataPointer) );
+
+        hMemDS = GDALCreate( hMemDriver, "warp_temp", 
+                             nXSize, nYSize, 0, GDT_Byte, NULL );
+        GDALAddBand( hMemDS, GDT_Byte, apszOptions );
+        GDALSetGeoTransform( hMemDS, adfGeoTransform );
+
+        int nTargetBand = 1;
+        double dfBurnValue = 255.0;
+        int    anXYOff[2];
+        char   **papszRasterizeOptions = NULL;
 
-    if( CSLFetchBoolean( psWO->papszWarpOptions, "CUTLINE_ALL_TOUCHED", FALSE ))
         papszRasterizeOptions = 
             CSLSetNameValue( papszRasterizeOptions, "ALL_TOUCHED", "TRUE" );
 
-    anXYOff[0] = nXOff;
-    anXYOff[1] = nYOff;
+        anXYOff[0] = nXOff;
+        anXYOff[1] = nYOff;
 
-    eErr = 
-        GDALRasterizeGeometries( hMemDS, 1, &nTargetBand, 
-                                 1, &hPolygon, 
-                                 CutlineTransformer, anXYOff, 
-                                 &dfBurnValue, papszRasterizeOptions, 
-                                 NULL, NULL );
+        eErr = 
+            GDALRasterizeGeometries( hMemDS, 1, &nTargetBand, 
+                                     1, &hPolygon, 
+                                     CutlineTransformer, anXYOff, 
+                                     &dfBurnValue, papszRasterizeOptions, 
+                                     NULL, NULL );
 
-    CSLDestroy( papszRasterizeOptions );
+        CSLDestroy( papszRasterizeOptions );
 
-    // Close and ensure data flushed to underlying array.
-    GDALClose( hMemDS );
+        // Close and ensure data flushed to underlying array.
+        GDALClose( hMemDS );
+    }
 
 /* -------------------------------------------------------------------- */
 /*      In the case with no blend distance, we just apply this as a     */
 /*      mask, zeroing out everything outside the polygon.               */
 /* -------------------------------------------------------------------- */
-    if( psWO->dfCutlineBlendDist == 0.0 )
+    if( eErr != CE_None )
+    {
+        /* the rasterizer has reported the error */
+    }
+    else if( psWO->dfCutlineBlendDist == 0.0 )
     {
         int i;
 
         for( i = nXSize * nYSize - 1; i >= 0; i-- )
         {
             if( pabyPolyMask[i] == 0 )
-                ((float *) pValidityMask)[i] = 0.0;
+                pafMask[i] = 0.0;
         }
     }
     else
     {
         eErr = BlendMaskGenerator( nXOff, nYOff, nXSize, nYSize, 
-                                   pabyPolyMask, (float *) pValidityMask,
-                                   hPolygon, psWO->dfCutlineBlendDist );
+                                   pabyPolyMask, pafMask,
+                                   psPrep, psWO->dfCutlineBlendDist );
     }
 
 /* -------------------------------------------------------------------- */
@@ -371,4 +889,3 @@ GDALWarpCutlineMasker( void *pMaskFuncArg, int nBandCount, GDALDataType eType,
 
     return eErr;
 }
-
@@ -29,6 +29,10 @@
 
 #include "gdal_priv.h"
 #include "gdal_alg.h"
+#include "cpl_multiproc.h"
+#include "cpl_quad_tree.h"
+
+#include <map>
 
 #ifdef SHAPE_DEBUG
 #include "/u/pkg/shapelib/shapefil.h"
@@ -44,33 +48,55 @@ CPLXMLNode *GDALSerializeGeoLocTransformer( void *pTransformArg );
 void *GDALDeserializeGeoLocTransformer( CPLXMLNode *psTree );
 CPL_C_END
 
+/* Size of the square tiles in which the backmap is computed and cached. */
+#define GEOLOC_BACKMAP_TILE_SIZE    256
+
+/* Size of the blocks of the geolocation arrays in the spatial index. */
+#define GEOLOC_INDEX_BLOCK_SIZE     64
+
+/* Number of hole filling passes on the backmap. This is also the margin */
+/* needed around a tile to compute it independently of its neighbours.  */
+#define GEOLOC_BACKMAP_MAX_ITER     3
+
 /************************************************************************/
 /* ==================================================================== */
-/*			   GDALGeoLocTransformer                        */
+/*                            GDALGeoLocData                            */
 /* ==================================================================== */
 /************************************************************************/
 
-typedef struct {
+/*
+ * The geolocation arrays and the backmap derived from them.  They are
+ * shared between all the transformers built on the same geolocation
+ * datasets, so that several warps of the same swath load and index it
+ * once.
+ *
+ * The backmap is computed lazily, by tiles of GEOLOC_BACKMAP_TILE_SIZE
+ * pixels, and at most GDAL_GEOLOC_BACKMAP_CACHE_MB megabytes of tiles
+ * (256 by default) are kept in memory.  Least recently used tiles are
+ * saved in a temporary file when evicted, or recomputed when needed again
+ * if GDAL_GEOLOC_BACKMAP_TEMP_FILE is set to NO.
+ */
 
-    GDALTransformerInfo sTI;
+typedef struct {
+    float       *pafBackMapX;   // NULL when not in memory.
+    float       *pafBackMapY;
+    GUIntBig     nLastUse;
+    int          bOnDisk;       // TRUE once saved in the temporary file.
+} GeoLocBackMapTile;
 
-    int         bReversed;
+typedef struct {
+    CPLRectObj   sBounds;       // extent of the valid pixels of the block.
+    int          nXOff;
+    int          nYOff;
+    int          nXSize;
+    int          nYSize;
+} GeoLocIndexBlock;
 
-    // Map from target georef coordinates back to geolocation array
-    // pixel line coordinates.  Built only if needed.
+typedef struct {
 
-    int         nBackMapWidth;
-    int         nBackMapHeight;
-    double      adfBackMapGeoTransform[6]; // maps georef to pixel/line.
-    float       *pafBackMapX;
-    float       *pafBackMapY;
-
-    // geolocation bands.
-    
-    GDALDatasetH     hDS_X;
-    GDALRasterBandH  hBand_X;
-    GDALDatasetH     hDS_Y;
-    GDALRasterBandH  hBand_Y;
+    char            *pszKey;    // NULL if not shared.
+    int              nRefCount;
+    void            *hMutex;    // protects the backmap tile cache.
 
     // Located geolocation data. 
     int              nGeoLocXSize;
@@ -87,6 +113,63 @@ typedef struct {
     double           dfLINE_OFFSET;
     double           dfLINE_STEP;
 
+    // Map from target georef coordinates back to geolocation array
+    // pixel line coordinates.  Tiles are computed only if needed.
+
+    int              nBackMapWidth;
+    int              nBackMapHeight;
+    double           adfBackMapGeoTransform[6]; // maps georef to pixel/line.
+
+    int              nTilesX;
+    int              nTilesY;
+    GeoLocBackMapTile *pasTiles;
+    int              nTilesInMemory;
+    int              nMaxTilesInMemory;
+    GUIntBig         nUseCounter;
+    int              iLastTile;     // last tile returned, always in memory.
+
+    int              bUseTempFile;
+    VSILFILE        *fpTemp;
+    char            *pszTempFilename;
+
+    // Spatial index of the blocks of the geolocation arrays, used to
+    // find the pixels falling in a backmap tile.
+    GeoLocIndexBlock *pasIndexBlocks;
+    CPLQuadTree     *hIndex;
+
+} GDALGeoLocData;
+
+static void *hGeoLocDataMutex = NULL;
+static std::map<CPLString, GDALGeoLocData*> *poGeoLocDataMap = NULL;
+
+/************************************************************************/
+/* ==================================================================== */
+/*			   GDALGeoLocTransformer                        */
+/* ==================================================================== */
+/************************************************************************/
+
+typedef struct {
+
+    GDALTransformerInfo sTI;
+
+    int         bReversed;
+
+    // geolocation bands.
+    
+    GDALDatasetH     hDS_X;
+    GDALRasterBandH  hBand_X;
+    GDALDatasetH     hDS_Y;
+    GDALRasterBandH  hBand_Y;
+
+    // geolocation <-> base image mapping.
+    double           dfPIXEL_OFFSET;
+    double           dfPIXEL_STEP;
+    double           dfLINE_OFFSET;
+    double           dfLINE_STEP;
+
+    // geolocation arrays and backmap, possibly shared.
+    GDALGeoLocData  *psData;
+
     char **          papszGeolocationInfo;
 
 } GDALGeoLocTransformInfo;
@@ -95,7 +178,8 @@ typedef struct {
 /*                         GeoLocLoadFullData()                         */
 /************************************************************************/
 
-static int GeoLocLoadFullData( GDALGeoLocTransformInfo *psTransform )
+static int GeoLocLoadFullData( GDALGeoLocData *psData,
+                               GDALGeoLocTransformInfo *psTransform )
 
 {
     int nXSize, nYSize;
@@ -115,16 +199,16 @@ static int GeoLocLoadFullData( GDALGeoLocTransformInfo *psTransform )
         nYSize = nYSize_XBand;
     }
 
-    psTransform->nGeoLocXSize = nXSize;
-    psTransform->nGeoLocYSize = nYSize;
+    psData->nGeoLocXSize = nXSize;
+    psData->nGeoLocYSize = nYSize;
     
-    psTransform->padfGeoLocY = (double *) 
+    psData->padfGeoLocY = (double *) 
         VSIMalloc3(sizeof(double), nXSize, nYSize);
-    psTransform->padfGeoLocX = (double *) 
+    psData->padfGeoLocX = (double *) 
         VSIMalloc3(sizeof(double), nXSize, nYSize);
     
-    if( psTransform->padfGeoLocX == NULL ||
-        psTransform->padfGeoLocY == NULL )
+    if( psData->padfGeoLocX == NULL ||
+        psData->padfGeoLocY == NULL )
     {
         CPLError(CE_Failure, CPLE_OutOfMemory,
                  "GeoLocLoadFullData : Out of memory");
@@ -158,7 +242,7 @@ static int GeoLocLoadFullData( GDALGeoLocTransformInfo *psTransform )
         int i,j;
         for(j=0;j<nYSize;j++)
         {
-            memcpy( psTransform->padfGeoLocX + j * nXSize,
+            memcpy( psData->padfGeoLocX + j * nXSize,
                     padfTempX,
                     nXSize * sizeof(double) );
         }
@@ -174,7 +258,7 @@ static int GeoLocLoadFullData( GDALGeoLocTransformInfo *psTransform )
             {
                 for(i=0;i<nXSize;i++)
                 {
-                    psTransform->padfGeoLocY[j * nXSize + i] = padfTempY[j];
+                    psData->padfGeoLocY[j * nXSize + i] = padfTempY[j];
                 }
             }
         }
@@ -189,33 +273,46 @@ static int GeoLocLoadFullData( GDALGeoLocTransformInfo *psTransform )
     {
         if( GDALRasterIO( psTransform->hBand_X, GF_Read, 
                         0, 0, nXSize, nYSize,
-                        psTransform->padfGeoLocX, nXSize, nYSize, 
+                        psData->padfGeoLocX, nXSize, nYSize, 
                         GDT_Float64, 0, 0 ) != CE_None 
             || GDALRasterIO( psTransform->hBand_Y, GF_Read, 
                             0, 0, nXSize, nYSize,
-                            psTransform->padfGeoLocY, nXSize, nYSize, 
+                            psData->padfGeoLocY, nXSize, nYSize, 
                             GDT_Float64, 0, 0 ) != CE_None )
             return FALSE;
     }
 
-    psTransform->dfNoDataX = GDALGetRasterNoDataValue( psTransform->hBand_X, 
-                                                       NULL );
-    psTransform->dfNoDataY = GDALGetRasterNoDataValue( psTransform->hBand_Y, 
-                                                       NULL );
+    psData->dfNoDataX = GDALGetRasterNoDataValue( psTransform->hBand_X, 
+                                                  NULL );
+    psData->dfNoDataY = GDALGetRasterNoDataValue( psTransform->hBand_Y, 
+                                                  NULL );
 
     return TRUE;
 }
 
 /************************************************************************/
-/*                       GeoLocGenerateBackMap()                        */
+/*                     GeoLocGetIndexBlockBounds()                      */
 /************************************************************************/
 
-static int GeoLocGenerateBackMap( GDALGeoLocTransformInfo *psTransform )
+static void GeoLocGetIndexBlockBounds( const void* hFeature,
+                                       CPLRectObj* pBounds )
+{
+    *pBounds = ((const GeoLocIndexBlock *) hFeature)->sBounds;
+}
+
+/************************************************************************/
+/*                         GeoLocInitBackMap()                          */
+/*                                                                      */
+/*      Establish the backmap extent and resolution, and index the      */
+/*      geolocation arrays.  The backmap itself is computed tile by     */
+/*      tile in GeoLocGetBackMapTile().                                 */
+/************************************************************************/
+
+static int GeoLocInitBackMap( GDALGeoLocData *psData )
 
 {
-    int nXSize = psTransform->nGeoLocXSize;
-    int nYSize = psTransform->nGeoLocYSize;
-    int nMaxIter = 3;
+    int nXSize = psData->nGeoLocXSize;
+    int nYSize = psData->nGeoLocYSize;
 
 /* -------------------------------------------------------------------- */
 /*      Scan forward map for lat/long extents.                          */
@@ -225,24 +322,31 @@ static int GeoLocGenerateBackMap( GDALGeoLocTransformInfo *psTransform )
 
     for( i = nXSize * nYSize - 1; i >= 0; i-- )
     {
-        if( psTransform->padfGeoLocX[i] != psTransform->dfNoDataX )
+        if( psData->padfGeoLocX[i] != psData->dfNoDataX )
         {
             if( bInit )
             {
-                dfMinX = MIN(dfMinX,psTransform->padfGeoLocX[i]);
-                dfMaxX = MAX(dfMaxX,psTransform->padfGeoLocX[i]);
-                dfMinY = MIN(dfMinY,psTransform->padfGeoLocY[i]);
-                dfMaxY = MAX(dfMaxY,psTransform->padfGeoLocY[i]);
+                dfMinX = MIN(dfMinX,psData->padfGeoLocX[i]);
+                dfMaxX = MAX(dfMaxX,psData->padfGeoLocX[i]);
+                dfMinY = MIN(dfMinY,psData->padfGeoLocY[i]);
+                dfMaxY = MAX(dfMaxY,psData->padfGeoLocY[i]);
             }
             else
             {
                 bInit = TRUE;
-                dfMinX = dfMaxX = psTransform->padfGeoLocX[i];
-                dfMinY = dfMaxY = psTransform->padfGeoLocY[i];
+                dfMinX = dfMaxX = psData->padfGeoLocX[i];
+                dfMinY = dfMaxY = psData->padfGeoLocY[i];
             }
         }
     }
 
+    if( !bInit || dfMinX == dfMaxX || dfMinY == dfMaxY )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Geolocation arrays have no valid extent." );
+        return FALSE;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Decide on resolution for backmap.  We aim for slightly          */
 /*      higher resolution than the source but we can't easily           */
@@ -254,9 +358,9 @@ static int GeoLocGenerateBackMap( GDALGeoLocTransformInfo *psTransform )
                               / dfTargetPixels);
     int nBMXSize, nBMYSize;
 
-    nBMYSize = psTransform->nBackMapHeight = 
+    nBMYSize = psData->nBackMapHeight = 
         (int) ((dfMaxY - dfMinY) / dfPixelSize + 1);
-    nBMXSize= psTransform->nBackMapWidth =  
+    nBMXSize= psData->nBackMapWidth =  
         (int) ((dfMaxX - dfMinX) / dfPixelSize + 1);
 
     if (nBMXSize > INT_MAX / nBMYSize)
@@ -266,97 +370,276 @@ static int GeoLocGenerateBackMap( GDALGeoLocTransformInfo *psTransform )
         return FALSE;
     }
 
-    dfMinX -= dfPixelSize/2.0;
-    dfMaxY += dfPixelSize/2.0;
+    psData->adfBackMapGeoTransform[0] = dfMinX - dfPixelSize/2.0;
+    psData->adfBackMapGeoTransform[1] = dfPixelSize;
+    psData->adfBackMapGeoTransform[2] = 0.0;
+    psData->adfBackMapGeoTransform[3] = dfMaxY + dfPixelSize/2.0;
+    psData->adfBackMapGeoTransform[4] = 0.0;
+    psData->adfBackMapGeoTransform[5] = -dfPixelSize;
 
-    psTransform->adfBackMapGeoTransform[0] = dfMinX;
-    psTransform->adfBackMapGeoTransform[1] = dfPixelSize;
-    psTransform->adfBackMapGeoTransform[2] = 0.0;
-    psTransform->adfBackMapGeoTransform[3] = dfMaxY;
-    psTransform->adfBackMapGeoTransform[4] = 0.0;
-    psTransform->adfBackMapGeoTransform[5] = -dfPixelSize;
+/* -------------------------------------------------------------------- */
+/*      Set up the tile cache.                                          */
+/* -------------------------------------------------------------------- */
+    psData->nTilesX = (nBMXSize + GEOLOC_BACKMAP_TILE_SIZE - 1)
+        / GEOLOC_BACKMAP_TILE_SIZE;
+    psData->nTilesY = (nBMYSize + GEOLOC_BACKMAP_TILE_SIZE - 1)
+        / GEOLOC_BACKMAP_TILE_SIZE;
+    psData->pasTiles = (GeoLocBackMapTile *)
+        VSICalloc( psData->nTilesX * psData->nTilesY,
+                   sizeof(GeoLocBackMapTile) );
+    if( psData->pasTiles == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Unable to allocate %dx%d back-map for geolocation array transformer.",
+                  nBMXSize, nBMYSize );
+        return FALSE;
+    }
+
+    double dfCacheMB = 
+        CPLAtof( CPLGetConfigOption( "GDAL_GEOLOC_BACKMAP_CACHE_MB", "256" ) );
+    double dfMaxTiles = dfCacheMB * 1024 * 1024 
+        / (2.0 * sizeof(float) * GEOLOC_BACKMAP_TILE_SIZE
+           * GEOLOC_BACKMAP_TILE_SIZE);
+    psData->nMaxTilesInMemory = (int) MAX(1.0, MIN(dfMaxTiles, 
+                                    psData->nTilesX * psData->nTilesY));
+    psData->bUseTempFile = CSLTestBoolean( 
+        CPLGetConfigOption( "GDAL_GEOLOC_BACKMAP_TEMP_FILE", "YES" ) );
+    psData->iLastTile = -1;
 
 /* -------------------------------------------------------------------- */
-/*      Allocate backmap, and initialize to nodata value (-1.0).        */
+/*      Index the extent of the valid pixels of each block of the       */
+/*      geolocation arrays.                                             */
 /* -------------------------------------------------------------------- */
-    GByte  *pabyValidFlag;
+    int nBlocksX = (nXSize + GEOLOC_INDEX_BLOCK_SIZE - 1) 
+        / GEOLOC_INDEX_BLOCK_SIZE;
+    int nBlocksY = (nYSize + GEOLOC_INDEX_BLOCK_SIZE - 1) 
+        / GEOLOC_INDEX_BLOCK_SIZE;
+    CPLRectObj sGlobalBounds;
+
+    psData->pasIndexBlocks = (GeoLocIndexBlock *)
+        VSIMalloc3( nBlocksX, nBlocksY, sizeof(GeoLocIndexBlock) );
+    if( psData->pasIndexBlocks == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "GeoLocInitBackMap : Out of memory" );
+        return FALSE;
+    }
 
-    pabyValidFlag = (GByte *) 
-        VSICalloc(nBMXSize, nBMYSize); 
+    sGlobalBounds.minx = dfMinX;
+    sGlobalBounds.miny = dfMinY;
+    sGlobalBounds.maxx = dfMaxX;
+    sGlobalBounds.maxy = dfMaxY;
+    psData->hIndex = CPLQuadTreeCreate( &sGlobalBounds,
+                                        GeoLocGetIndexBlockBounds );
+
+    for( int iBlock = 0; iBlock < nBlocksX * nBlocksY; iBlock++ )
+    {
+        GeoLocIndexBlock *psBlock = psData->pasIndexBlocks + iBlock;
+        int iX, iY;
 
-    psTransform->pafBackMapX = (float *) 
-        VSIMalloc3(nBMXSize, nBMYSize, sizeof(float)); 
-    psTransform->pafBackMapY = (float *) 
-        VSIMalloc3(nBMXSize, nBMYSize, sizeof(float)); 
+        psBlock->nXOff = (iBlock % nBlocksX) * GEOLOC_INDEX_BLOCK_SIZE;
+        psBlock->nYOff = (iBlock / nBlocksX) * GEOLOC_INDEX_BLOCK_SIZE;
+        psBlock->nXSize = MIN(GEOLOC_INDEX_BLOCK_SIZE, nXSize - psBlock->nXOff);
+        psBlock->nYSize = MIN(GEOLOC_INDEX_BLOCK_SIZE, nYSize - psBlock->nYOff);
 
-    if( pabyValidFlag == NULL ||
-        psTransform->pafBackMapX == NULL ||
-        psTransform->pafBackMapY == NULL )
+        bInit = FALSE;
+        for( iY = psBlock->nYOff; iY < psBlock->nYOff + psBlock->nYSize; iY++ )
+        {
+            for( iX = psBlock->nXOff; 
+                 iX < psBlock->nXOff + psBlock->nXSize; iX++ )
+            {
+                i = iX + iY * nXSize;
+                if( psData->padfGeoLocX[i] == psData->dfNoDataX )
+                    continue;
+
+                double dfX = psData->padfGeoLocX[i];
+                double dfY = psData->padfGeoLocY[i];
+                if( bInit )
+                {
+                    psBlock->sBounds.minx = MIN(psBlock->sBounds.minx,dfX);
+                    psBlock->sBounds.maxx = MAX(psBlock->sBounds.maxx,dfX);
+                    psBlock->sBounds.miny = MIN(psBlock->sBounds.miny,dfY);
+                    psBlock->sBounds.maxy = MAX(psBlock->sBounds.maxy,dfY);
+                }
+                else
+                {
+                    bInit = TRUE;
+                    psBlock->sBounds.minx = psBlock->sBounds.maxx = dfX;
+                    psBlock->sBounds.miny = psBlock->sBounds.maxy = dfY;
+                }
+            }
+        }
+
+        if( bInit )
+            CPLQuadTreeInsert( psData->hIndex, psBlock );
+    }
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                      GeoLocComputeBackMapTile()                      */
+/*                                                                      */
+/*      Compute one tile of the backmap.  The tile is computed on a     */
+/*      window with a margin of GEOLOC_BACKMAP_MAX_ITER pixels, so      */
+/*      that the hole filling gives the same values as if the whole     */
+/*      backmap was computed at once.                                   */
+/************************************************************************/
+
+static int GeoLocComputeBackMapTile( GDALGeoLocData *psData, int iTile,
+                                     float *pafBackMapX, float *pafBackMapY )
+
+{
+    const int nXSize = psData->nGeoLocXSize;
+    const int nBMXSize = psData->nBackMapWidth;
+    const int nBMYSize = psData->nBackMapHeight;
+    const int nMaxIter = GEOLOC_BACKMAP_MAX_ITER;
+    const double dfMinX = psData->adfBackMapGeoTransform[0];
+    const double dfMaxY = psData->adfBackMapGeoTransform[3];
+    const double dfPixelSize = psData->adfBackMapGeoTransform[1];
+
+    int nTileXOff = (iTile % psData->nTilesX) * GEOLOC_BACKMAP_TILE_SIZE;
+    int nTileYOff = (iTile / psData->nTilesX) * GEOLOC_BACKMAP_TILE_SIZE;
+    int nTileXSize = MIN(GEOLOC_BACKMAP_TILE_SIZE, nBMXSize - nTileXOff);
+    int nTileYSize = MIN(GEOLOC_BACKMAP_TILE_SIZE, nBMYSize - nTileYOff);
+
+    int nWinXOff = MAX(0, nTileXOff - nMaxIter);
+    int nWinYOff = MAX(0, nTileYOff - nMaxIter);
+    int nWinXSize = MIN(nBMXSize, nTileXOff + nTileXSize + nMaxIter) - nWinXOff;
+    int nWinYSize = MIN(nBMYSize, nTileYOff + nTileYSize + nMaxIter) - nWinYOff;
+    int nWinPixels = nWinXSize * nWinYSize;
+    int i;
+
+/* -------------------------------------------------------------------- */
+/*      Find the blocks of the geolocation arrays overlapping the       */
+/*      window.  If there are none, the tile is empty.                  */
+/* -------------------------------------------------------------------- */
+    CPLRectObj sAoi;
+    sAoi.minx = dfMinX + (nWinXOff - 1) * dfPixelSize;
+    sAoi.maxx = dfMinX + (nWinXOff + nWinXSize + 1) * dfPixelSize;
+    sAoi.miny = dfMaxY - (nWinYOff + nWinYSize + 1) * dfPixelSize;
+    sAoi.maxy = dfMaxY - (nWinYOff - 1) * dfPixelSize;
+
+    int nBlockCount = 0;
+    GeoLocIndexBlock **papsBlocks = (GeoLocIndexBlock **)
+        CPLQuadTreeSearch( psData->hIndex, &sAoi, &nBlockCount );
+
+    if( nBlockCount == 0 )
     {
-        CPLError( CE_Failure, CPLE_OutOfMemory, 
-                  "Unable to allocate %dx%d back-map for geolocation array transformer.",
-                  nBMXSize, nBMYSize );
+        CPLFree( papsBlocks );
+        for( i = GEOLOC_BACKMAP_TILE_SIZE * GEOLOC_BACKMAP_TILE_SIZE - 1;
+             i >= 0; i-- )
+        {
+            pafBackMapX[i] = -1.0;
+            pafBackMapY[i] = -1.0;
+        }
+        return TRUE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Allocate the window, and initialize to nodata value (-1.0).     */
+/*      panSource keeps the geolocation pixel pushed in each backmap    */
+/*      pixel.                                                          */
+/* -------------------------------------------------------------------- */
+    GByte *pabyValidFlag = (GByte *) VSICalloc(nWinXSize, nWinYSize);
+    float *pafX = (float *) VSIMalloc2(nWinPixels, sizeof(float));
+    float *pafY = (float *) VSIMalloc2(nWinPixels, sizeof(float));
+    int   *panSource = (int *) VSIMalloc2(nWinPixels, sizeof(int));
+
+    if( pabyValidFlag == NULL || pafX == NULL || pafY == NULL 
+        || panSource == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "GeoLocComputeBackMapTile : Out of memory" );
+        CPLFree( papsBlocks );
         CPLFree( pabyValidFlag );
+        CPLFree( pafX );
+        CPLFree( pafY );
+        CPLFree( panSource );
         return FALSE;
     }
 
-    for( i = nBMXSize * nBMYSize - 1; i >= 0; i-- )
+    for( i = nWinPixels - 1; i >= 0; i-- )
     {
-        psTransform->pafBackMapX[i] = -1.0;
-        psTransform->pafBackMapY[i] = -1.0;
+        pafX[i] = -1.0;
+        pafY[i] = -1.0;
+        panSource[i] = -1;
     }
 
 /* -------------------------------------------------------------------- */
-/*      Run through the whole geoloc array forward projecting and       */
-/*      pushing into the backmap.                                       */
+/*      Forward project the pixels of the geolocation blocks            */
+/*      overlapping the window and push them into the backmap.  When    */
+/*      several pixels fall in the same backmap pixel, the last one in  */
+/*      the geolocation arrays wins, whatever the order the blocks are  */
+/*      returned in.                                                    */
 /*      Initialise to the nMaxIter+1 value so we can spot genuinely     */
 /*      valid pixels in the hole-filling loop.                          */
 /* -------------------------------------------------------------------- */
     int iBMX, iBMY;
     int iX, iY;
 
-    for( iY = 0; iY < nYSize; iY++ )
+    for( int iBlock = 0; iBlock < nBlockCount; iBlock++ )
     {
-        for( iX = 0; iX < nXSize; iX++ )
+        GeoLocIndexBlock *psBlock = papsBlocks[iBlock];
+
+        for( iY = psBlock->nYOff; iY < psBlock->nYOff + psBlock->nYSize; iY++ )
         {
-            if( psTransform->padfGeoLocX[iX + iY * nXSize] 
-                == psTransform->dfNoDataX )
-                continue;
+            for( iX = psBlock->nXOff; 
+                 iX < psBlock->nXOff + psBlock->nXSize; iX++ )
+            {
+                i = iX + iY * nXSize;
 
-            i = iX + iY * nXSize;
+                if( psData->padfGeoLocX[i] == psData->dfNoDataX )
+                    continue;
 
-            iBMX = (int) ((psTransform->padfGeoLocX[i] - dfMinX) / dfPixelSize);
-            iBMY = (int) ((dfMaxY - psTransform->padfGeoLocY[i]) / dfPixelSize);
+                iBMX = (int) ((psData->padfGeoLocX[i] - dfMinX) / dfPixelSize);
+                iBMY = (int) ((dfMaxY - psData->padfGeoLocY[i]) / dfPixelSize);
 
-            if( iBMX < 0 || iBMY < 0 || iBMX >= nBMXSize || iBMY >= nBMYSize )
-                continue;
+                if( iBMX < 0 || iBMY < 0 
+                    || iBMX >= nBMXSize || iBMY >= nBMYSize )
+                    continue;
 
-            psTransform->pafBackMapX[iBMX + iBMY * nBMXSize] = 
-                (float)(iX * psTransform->dfPIXEL_STEP + psTransform->dfPIXEL_OFFSET);
-            psTransform->pafBackMapY[iBMX + iBMY * nBMXSize] = 
-                (float)(iY * psTransform->dfLINE_STEP + psTransform->dfLINE_OFFSET);
+                iBMX -= nWinXOff;
+                iBMY -= nWinYOff;
+                if( iBMX < 0 || iBMY < 0 
+                    || iBMX >= nWinXSize || iBMY >= nWinYSize )
+                    continue;
 
-            pabyValidFlag[iBMX + iBMY * nBMXSize] = (GByte) (nMaxIter+1);
+                int iWin = iBMX + iBMY * nWinXSize;
+                if( panSource[iWin] > i )
+                    continue;
 
+                panSource[iWin] = i;
+                pafX[iWin] = (float)(iX * psData->dfPIXEL_STEP
+                                     + psData->dfPIXEL_OFFSET);
+                pafY[iWin] = (float)(iY * psData->dfLINE_STEP
+                                     + psData->dfLINE_OFFSET);
+                pabyValidFlag[iWin] = (GByte) (nMaxIter+1);
+            }
         }
     }
 
+    CPLFree( papsBlocks );
+    CPLFree( panSource );
+
 /* -------------------------------------------------------------------- */
-/*      Now, loop over the backmap trying to fill in holes with         */
-/*      nearby values.                                                  */
+/*      Now, loop over the window trying to fill in holes with          */
+/*      nearby values (left, right, top, bottom, then the diagonals).   */
 /* -------------------------------------------------------------------- */
+    static const int anNeighbourDX[8] = { -1, 1, 0, 0, -1, 1, -1, 1 };
+    static const int anNeighbourDY[8] = { 0, 0, -1, 1, -1, -1, 1, 1 };
     int iIter;
     int nNumValid;
 
     for( iIter = 0; iIter < nMaxIter; iIter++ )
     {
         nNumValid = 0;
-        for( iBMY = 0; iBMY < nBMYSize; iBMY++ )
+        for( iBMY = 0; iBMY < nWinYSize; iBMY++ )
         {
-            for( iBMX = 0; iBMX < nBMXSize; iBMX++ )
+            for( iBMX = 0; iBMX < nWinXSize; iBMX++ )
             {
                 // if this point is already set, ignore it. 
-                if( pabyValidFlag[iBMX + iBMY*nBMXSize] )
+                if( pabyValidFlag[iBMX + iBMY*nWinXSize] )
                 {
                     nNumValid++;
                     continue;
@@ -366,108 +649,373 @@ static int GeoLocGenerateBackMap( GDALGeoLocTransformInfo *psTransform )
                 double dfXSum = 0.0, dfYSum = 0.0;
                 int nMarkedAsGood = nMaxIter - iIter;
 
-                // left?
-                if( iBMX > 0 &&
-                    pabyValidFlag[iBMX-1+iBMY*nBMXSize] > nMarkedAsGood )
-                {
-                    dfXSum += psTransform->pafBackMapX[iBMX-1+iBMY*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX-1+iBMY*nBMXSize];
-                    nCount++;
-                }
-                // right?
-                if( iBMX + 1 < nBMXSize &&
-                    pabyValidFlag[iBMX+1+iBMY*nBMXSize] > nMarkedAsGood )
-                {
-                    dfXSum += psTransform->pafBackMapX[iBMX+1+iBMY*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX+1+iBMY*nBMXSize];
-                    nCount++;
-                }
-                // top?
-                if( iBMY > 0 &&
-                    pabyValidFlag[iBMX+(iBMY-1)*nBMXSize] > nMarkedAsGood )
-                {
-                    dfXSum += psTransform->pafBackMapX[iBMX+(iBMY-1)*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX+(iBMY-1)*nBMXSize];
-                    nCount++;
-                }
-                // bottom?
-                if( iBMY + 1 < nBMYSize &&
-                    pabyValidFlag[iBMX+(iBMY+1)*nBMXSize] > nMarkedAsGood )
-                {
-                    dfXSum += psTransform->pafBackMapX[iBMX+(iBMY+1)*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX+(iBMY+1)*nBMXSize];
-                    nCount++;
-                }
-                // top-left?
-                if( iBMX > 0 && iBMY > 0 &&
-                    pabyValidFlag[iBMX-1+(iBMY-1)*nBMXSize] > nMarkedAsGood )
-                {
-                    dfXSum += psTransform->pafBackMapX[iBMX-1+(iBMY-1)*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX-1+(iBMY-1)*nBMXSize];
-                    nCount++;
-                }
-                // top-right?
-                if( iBMX + 1 < nBMXSize && iBMY > 0 &&
-                    pabyValidFlag[iBMX+1+(iBMY-1)*nBMXSize] > nMarkedAsGood )
-                {
-                    dfXSum += psTransform->pafBackMapX[iBMX+1+(iBMY-1)*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX+1+(iBMY-1)*nBMXSize];
-                    nCount++;
-                }
-                // bottom-left?
-                if( iBMX > 0 && iBMY + 1 < nBMYSize &&
-                    pabyValidFlag[iBMX-1+(iBMY+1)*nBMXSize] > nMarkedAsGood )
+                for( int iNeighbour = 0; iNeighbour < 8; iNeighbour++ )
                 {
-                    dfXSum += psTransform->pafBackMapX[iBMX-1+(iBMY+1)*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX-1+(iBMY+1)*nBMXSize];
-                    nCount++;
-                }
-                // bottom-right?
-                if( iBMX + 1 < nBMXSize && iBMY + 1 < nBMYSize &&
-                    pabyValidFlag[iBMX+1+(iBMY+1)*nBMXSize] > nMarkedAsGood )
-                {
-                    dfXSum += psTransform->pafBackMapX[iBMX+1+(iBMY+1)*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX+1+(iBMY+1)*nBMXSize];
+                    int iNX = iBMX + anNeighbourDX[iNeighbour];
+                    int iNY = iBMY + anNeighbourDY[iNeighbour];
+
+                    if( iNX < 0 || iNY < 0 
+                        || iNX >= nWinXSize || iNY >= nWinYSize
+                        || pabyValidFlag[iNX+iNY*nWinXSize] <= nMarkedAsGood )
+                        continue;
+
+                    dfXSum += pafX[iNX+iNY*nWinXSize];
+                    dfYSum += pafY[iNX+iNY*nWinXSize];
                     nCount++;
                 }
 
                 if( nCount > 0 )
                 {
-                    psTransform->pafBackMapX[iBMX + iBMY * nBMXSize] = (float)(dfXSum/nCount);
-                    psTransform->pafBackMapY[iBMX + iBMY * nBMXSize] = (float)(dfYSum/nCount);
+                    pafX[iBMX + iBMY * nWinXSize] = (float)(dfXSum/nCount);
+                    pafY[iBMX + iBMY * nWinXSize] = (float)(dfYSum/nCount);
                     // genuinely valid points will have value iMaxIter+1
                     // On each iteration mark newly valid points with a
                     // descending value so that it will not be used on the
                     // current iteration only on subsequent ones.
-                    pabyValidFlag[iBMX+iBMY*nBMXSize] = (GByte) (nMaxIter - iIter);
+                    pabyValidFlag[iBMX+iBMY*nWinXSize] = (GByte) (nMaxIter - iIter);
                 }
             }
         }
-        if (nNumValid == nBMXSize * nBMYSize)
+        if (nNumValid == nWinPixels)
             break;
     }
 
-#ifdef notdef
-    GDALDatasetH hBMDS = GDALCreate( GDALGetDriverByName( "GTiff" ),
-                                     "backmap.tif", nBMXSize, nBMYSize, 2, 
-                                     GDT_Float32, NULL );
-    GDALSetGeoTransform( hBMDS, psTransform->adfBackMapGeoTransform );
-    GDALRasterIO( GDALGetRasterBand(hBMDS,1), GF_Write, 
-                  0, 0, nBMXSize, nBMYSize, 
-                  psTransform->pafBackMapX, nBMXSize, nBMYSize, 
-                  GDT_Float32, 0, 0 );
-    GDALRasterIO( GDALGetRasterBand(hBMDS,2), GF_Write, 
-                  0, 0, nBMXSize, nBMYSize, 
-                  psTransform->pafBackMapY, nBMXSize, nBMYSize, 
-                  GDT_Float32, 0, 0 );
-    GDALClose( hBMDS );
-#endif
+/* -------------------------------------------------------------------- */
+/*      Copy the tile out of the window.                                */
+/* -------------------------------------------------------------------- */
+    for( iY = 0; iY < nTileYSize; iY++ )
+    {
+        int iWin = (nTileXOff - nWinXOff) 
+            + (iY + nTileYOff - nWinYOff) * nWinXSize;
+
+        memcpy( pafBackMapX + iY * GEOLOC_BACKMAP_TILE_SIZE, pafX + iWin,
+                nTileXSize * sizeof(float) );
+        memcpy( pafBackMapY + iY * GEOLOC_BACKMAP_TILE_SIZE, pafY + iWin,
+                nTileXSize * sizeof(float) );
+    }
 
     CPLFree( pabyValidFlag );
+    CPLFree( pafX );
+    CPLFree( pafY );
 
     return TRUE;
 }
 
+/************************************************************************/
+/*                        GeoLocGetBackMapTile()                        */
+/*                                                                      */
+/*      Return a tile of the backmap loaded in memory, evicting the     */
+/*      least recently used one if the cache is full.  Must be called   */
+/*      with psData->hMutex held.                                       */
+/************************************************************************/
+
+static GeoLocBackMapTile *GeoLocGetBackMapTile( GDALGeoLocData *psData,
+                                                int iTile )
+
+{
+    GeoLocBackMapTile *psTile = psData->pasTiles + iTile;
+    const int nTilePixels = GEOLOC_BACKMAP_TILE_SIZE * GEOLOC_BACKMAP_TILE_SIZE;
+
+    if( iTile == psData->iLastTile )
+        return psTile;
+
+    psTile->nLastUse = ++psData->nUseCounter;
+    if( psTile->pafBackMapX != NULL )
+    {
+        psData->iLastTile = iTile;
+        return psTile;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Take the buffers of the least recently used tile if we have     */
+/*      reached the cache size, saving it first if requested.           */
+/* -------------------------------------------------------------------- */
+    float *pafBackMapX = NULL, *pafBackMapY = NULL;
+
+    if( psData->nTilesInMemory >= psData->nMaxTilesInMemory )
+    {
+        GeoLocBackMapTile *psOldest = NULL;
+        int iOldest = -1;
+
+        for( int i = psData->nTilesX * psData->nTilesY - 1; i >= 0; i-- )
+        {
+            if( psData->pasTiles[i].pafBackMapX != NULL
+                && (psOldest == NULL 
+                    || psData->pasTiles[i].nLastUse < psOldest->nLastUse) )
+            {
+                psOldest = psData->pasTiles + i;
+                iOldest = i;
+            }
+        }
+
+        if( psData->bUseTempFile && psData->fpTemp == NULL )
+        {
+            psData->pszTempFilename = 
+                CPLStrdup( CPLGenerateTempFilename( "geoloc_backmap" ) );
+            psData->fpTemp = VSIFOpenL( psData->pszTempFilename, "w+b" );
+            if( psData->fpTemp == NULL )
+            {
+                CPLError( CE_Warning, CPLE_FileIO,
+                          "Cannot create %s, backmap tiles will be recomputed.",
+                          psData->pszTempFilename );
+                psData->bUseTempFile = FALSE;
+            }
+        }
+
+        if( psData->bUseTempFile && !psOldest->bOnDisk )
+        {
+            vsi_l_offset nOffset = (vsi_l_offset) iOldest 
+                * nTilePixels * 2 * sizeof(float);
+
+            psOldest->bOnDisk =
+                VSIFSeekL( psData->fpTemp, nOffset, SEEK_SET ) == 0
+                && (int) VSIFWriteL( psOldest->pafBackMapX, sizeof(float), 
+                                     nTilePixels, psData->fpTemp ) 
+                   == nTilePixels
+                && (int) VSIFWriteL( psOldest->pafBackMapY, sizeof(float), 
+                                     nTilePixels, psData->fpTemp ) 
+                   == nTilePixels;
+        }
+
+        pafBackMapX = psOldest->pafBackMapX;
+        pafBackMapY = psOldest->pafBackMapY;
+        psOldest->pafBackMapX = NULL;
+        psOldest->pafBackMapY = NULL;
+        psData->nTilesInMemory--;
+    }
+    else
+    {
+        pafBackMapX = (float *) VSIMalloc2(nTilePixels, sizeof(float));
+        pafBackMapY = (float *) VSIMalloc2(nTilePixels, sizeof(float));
+        if( pafBackMapX == NULL || pafBackMapY == NULL )
+        {
+            CPLError( CE_Failure, CPLE_OutOfMemory,
+                      "Unable to allocate back-map tile for geolocation array transformer." );
+            CPLFree( pafBackMapX );
+            CPLFree( pafBackMapY );
+            return NULL;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Reload the tile from the temporary file, or compute it.         */
+/* -------------------------------------------------------------------- */
+    int bOK;
+
+    if( psTile->bOnDisk )
+    {
+        vsi_l_offset nOffset = (vsi_l_offset) iTile 
+            * nTilePixels * 2 * sizeof(float);
+
+        bOK = VSIFSeekL( psData->fpTemp, nOffset, SEEK_SET ) == 0
+            && (int) VSIFReadL( pafBackMapX, sizeof(float), nTilePixels, 
+                                psData->fpTemp ) == nTilePixels
+            && (int) VSIFReadL( pafBackMapY, sizeof(float), nTilePixels, 
+                                psData->fpTemp ) == nTilePixels;
+        if( !bOK )
+        {
+            psTile->bOnDisk = FALSE;
+            bOK = GeoLocComputeBackMapTile( psData, iTile, 
+                                            pafBackMapX, pafBackMapY );
+        }
+    }
+    else
+        bOK = GeoLocComputeBackMapTile( psData, iTile, 
+                                        pafBackMapX, pafBackMapY );
+
+    if( !bOK )
+    {
+        CPLFree( pafBackMapX );
+        CPLFree( pafBackMapY );
+        return NULL;
+    }
+
+    psTile->pafBackMapX = pafBackMapX;
+    psTile->pafBackMapY = pafBackMapY;
+    psData->nTilesInMemory++;
+    psData->iLastTile = iTile;
+
+    return psTile;
+}
+
+/************************************************************************/
+/*                       GeoLocGetBackMapValue()                        */
+/*                                                                      */
+/*      Fetch a backmap pixel.  Returns FALSE if it is outside the      */
+/*      backmap.  The values are negative if the pixel is not set.      */
+/*      Must be called with psData->hMutex held.                        */
+/************************************************************************/
+
+static inline int GeoLocGetBackMapValue( GDALGeoLocData *psData, 
+                                         int iBMX, int iBMY,
+                                         float *pfX, float *pfY )
+
+{
+    if( iBMX < 0 || iBMY < 0 
+        || iBMX >= psData->nBackMapWidth
+        || iBMY >= psData->nBackMapHeight )
+        return FALSE;
+
+    const unsigned int nX = (unsigned int) iBMX;
+    const unsigned int nY = (unsigned int) iBMY;
+    const int iTile = (int) (nX / GEOLOC_BACKMAP_TILE_SIZE
+                             + nY / GEOLOC_BACKMAP_TILE_SIZE * psData->nTilesX);
+    GeoLocBackMapTile *psTile;
+
+    if( iTile == psData->iLastTile )
+        psTile = psData->pasTiles + iTile;
+    else
+    {
+        psTile = GeoLocGetBackMapTile( psData, iTile );
+        if( psTile == NULL )
+            return FALSE;
+    }
+
+    int iInTile = (int) (nX % GEOLOC_BACKMAP_TILE_SIZE
+                      + nY % GEOLOC_BACKMAP_TILE_SIZE * GEOLOC_BACKMAP_TILE_SIZE);
+
+    *pfX = psTile->pafBackMapX[iInTile];
+    *pfY = psTile->pafBackMapY[iInTile];
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                           GeoLocFreeData()                           */
+/************************************************************************/
+
+static void GeoLocFreeData( GDALGeoLocData *psData )
+
+{
+    if( psData->pasTiles != NULL )
+    {
+        for( int i = psData->nTilesX * psData->nTilesY - 1; i >= 0; i-- )
+        {
+            CPLFree( psData->pasTiles[i].pafBackMapX );
+            CPLFree( psData->pasTiles[i].pafBackMapY );
+        }
+        CPLFree( psData->pasTiles );
+    }
+
+    if( psData->fpTemp != NULL )
+    {
+        VSIFCloseL( psData->fpTemp );
+        VSIUnlink( psData->pszTempFilename );
+    }
+    CPLFree( psData->pszTempFilename );
+
+    if( psData->hIndex != NULL )
+        CPLQuadTreeDestroy( psData->hIndex );
+    CPLFree( psData->pasIndexBlocks );
+
+    CPLFree( psData->padfGeoLocX );
+    CPLFree( psData->padfGeoLocY );
+
+    if( psData->hMutex != NULL )
+        CPLDestroyMutex( psData->hMutex );
+    CPLFree( psData->pszKey );
+    CPLFree( psData );
+}
+
+/************************************************************************/
+/*                          GeoLocAcquireData()                         */
+/*                                                                      */
+/*      Return the geolocation data of the transformer, reusing the     */
+/*      one of another transformer built on the same geolocation        */
+/*      datasets if there is one.                                       */
+/************************************************************************/
+
+static GDALGeoLocData *GeoLocAcquireData( GDALGeoLocTransformInfo *psTransform )
+
+{
+/* -------------------------------------------------------------------- */
+/*      Data can only be shared if the geolocation datasets are         */
+/*      identified by a name.                                           */
+/* -------------------------------------------------------------------- */
+    CPLString osKey;
+    const char *pszXDS = CSLFetchNameValue( psTransform->papszGeolocationInfo,
+                                            "X_DATASET" );
+    const char *pszYDS = CSLFetchNameValue( psTransform->papszGeolocationInfo,
+                                            "Y_DATASET" );
+
+    if( pszXDS != NULL && pszXDS[0] != '\0' 
+        && pszYDS != NULL && pszYDS[0] != '\0' )
+    {
+        for( int i = 0; psTransform->papszGeolocationInfo[i] != NULL; i++ )
+        {
+            osKey += psTransform->papszGeolocationInfo[i];
+            osKey += "\n";
+        }
+    }
+
+    CPLMutexHolderD( &hGeoLocDataMutex );
+
+    if( !osKey.empty() && poGeoLocDataMap != NULL )
+    {
+        std::map<CPLString, GDALGeoLocData*>::iterator oIter = 
+            poGeoLocDataMap->find( osKey );
+        if( oIter != poGeoLocDataMap->end() )
+        {
+            oIter->second->nRefCount++;
+            return oIter->second;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Load the geolocation arrays.                                    */
+/* -------------------------------------------------------------------- */
+    GDALGeoLocData *psData = (GDALGeoLocData *)
+        CPLCalloc( sizeof(GDALGeoLocData), 1 );
+
+    psData->nRefCount = 1;
+    psData->dfPIXEL_OFFSET = psTransform->dfPIXEL_OFFSET;
+    psData->dfPIXEL_STEP = psTransform->dfPIXEL_STEP;
+    psData->dfLINE_OFFSET = psTransform->dfLINE_OFFSET;
+    psData->dfLINE_STEP = psTransform->dfLINE_STEP;
+
+    if( !GeoLocLoadFullData( psData, psTransform ) 
+        || !GeoLocInitBackMap( psData ) )
+    {
+        GeoLocFreeData( psData );
+        return NULL;
+    }
+
+    if( !osKey.empty() )
+    {
+        psData->pszKey = CPLStrdup( osKey );
+        if( poGeoLocDataMap == NULL )
+            poGeoLocDataMap = new std::map<CPLString, GDALGeoLocData*>();
+        (*poGeoLocDataMap)[osKey] = psData;
+    }
+
+    return psData;
+}
+
+/************************************************************************/
+/*                          GeoLocReleaseData()                         */
+/************************************************************************/
+
+static void GeoLocReleaseData( GDALGeoLocData *psData )
+
+{
+    CPLMutexHolderD( &hGeoLocDataMutex );
+
+    if( --psData->nRefCount > 0 )
+        return;
+
+    if( psData->pszKey != NULL && poGeoLocDataMap != NULL )
+    {
+        poGeoLocDataMap->erase( psData->pszKey );
+        if( poGeoLocDataMap->empty() )
+        {
+            delete poGeoLocDataMap;
+            poGeoLocDataMap = NULL;
+        }
+    }
+
+    GeoLocFreeData( psData );
+}
+
 /************************************************************************/
 /*                         FindGeoLocPosition()                         */
 /************************************************************************/
@@ -850,10 +1398,11 @@ void *GDALCreateGeoLocTransformer( GDALDatasetH hBaseDS,
     }
 
 /* -------------------------------------------------------------------- */
-/*      Load the geolocation array.                                     */
+/*      Load the geolocation array, or reuse it if another              */
+/*      transformer has already loaded it.                              */
 /* -------------------------------------------------------------------- */
-    if( !GeoLocLoadFullData( psTransform ) 
-        || !GeoLocGenerateBackMap( psTransform ) )
+    psTransform->psData = GeoLocAcquireData( psTransform );
+    if( psTransform->psData == NULL )
     {
         GDALDestroyGeoLocTransformer( psTransform );
         return NULL;
@@ -872,11 +1421,9 @@ void GDALDestroyGeoLocTransformer( void *pTransformAlg )
     GDALGeoLocTransformInfo *psTransform = 
         (GDALGeoLocTransformInfo *) pTransformAlg;
 
-    CPLFree( psTransform->pafBackMapX );
-    CPLFree( psTransform->pafBackMapY );
+    if( psTransform->psData != NULL )
+        GeoLocReleaseData( psTransform->psData );
     CSLDestroy( psTransform->papszGeolocationInfo );
-    CPLFree( psTransform->padfGeoLocX );
-    CPLFree( psTransform->padfGeoLocY );
              
     if( psTransform->hDS_X != NULL 
         && GDALDereferenceDataset( psTransform->hDS_X ) == 0 )
@@ -901,6 +1448,7 @@ int GDALGeoLocTransform( void *pTransformArg, int bDstToSrc,
 {
     GDALGeoLocTransformInfo *psTransform = 
         (GDALGeoLocTransformInfo *) pTransformArg;
+    GDALGeoLocData *psData = psTransform->psData;
 
     if( psTransform->bReversed )
         bDstToSrc = !bDstToSrc;
@@ -910,7 +1458,7 @@ int GDALGeoLocTransform( void *pTransformArg, int bDstToSrc,
 /* -------------------------------------------------------------------- */
     if( !bDstToSrc )
     {
-        int i, nXSize = psTransform->nGeoLocXSize;
+        int i, nXSize = psData->nGeoLocXSize;
 
         for( i = 0; i < nPointCount; i++ )
         {
@@ -928,18 +1476,18 @@ int GDALGeoLocTransform( void *pTransformArg, int bDstToSrc,
             int iX, iY;
 
             iX = MAX(0,(int) dfGeoLocPixel);
-            iX = MIN(iX,psTransform->nGeoLocXSize-1);
+            iX = MIN(iX,psData->nGeoLocXSize-1);
             iY = MAX(0,(int) dfGeoLocLine);
-            iY = MIN(iY,psTransform->nGeoLocYSize-1);
+            iY = MIN(iY,psData->nGeoLocYSize-1);
 
-            double *padfGLX = psTransform->padfGeoLocX + iX + iY * nXSize;
-            double *padfGLY = psTransform->padfGeoLocY + iX + iY * nXSize;
+            double *padfGLX = psData->padfGeoLocX + iX + iY * nXSize;
+            double *padfGLY = psData->padfGeoLocY + iX + iY * nXSize;
 
             // This assumes infinite extension beyond borders of available
             // data based on closest grid square.
 
-            if( iX + 1 < psTransform->nGeoLocXSize &&
-                iY + 1 < psTransform->nGeoLocYSize )
+            if( iX + 1 < psData->nGeoLocXSize &&
+                iY + 1 < psData->nGeoLocYSize )
             {
                 padfX[i] = padfGLX[0] 
                     + (dfGeoLocPixel-iX) * (padfGLX[1] - padfGLX[0])
@@ -948,14 +1496,14 @@ int GDALGeoLocTransform( void *pTransformArg, int bDstToSrc,
                     + (dfGeoLocPixel-iX) * (padfGLY[1] - padfGLY[0])
                     + (dfGeoLocLine -iY) * (padfGLY[nXSize] - padfGLY[0]);
             }
-            else if( iX + 1 < psTransform->nGeoLocXSize )
+            else if( iX + 1 < psData->nGeoLocXSize )
             {
                 padfX[i] = padfGLX[0] 
                     + (dfGeoLocPixel-iX) * (padfGLX[1] - padfGLX[0]);
                 padfY[i] = padfGLY[0] 
                     + (dfGeoLocPixel-iX) * (padfGLY[1] - padfGLY[0]);
             }
-            else if( iY + 1 < psTransform->nGeoLocYSize )
+            else if( iY + 1 < psData->nGeoLocYSize )
             {
                 padfX[i] = padfGLX[0] 
                     + (dfGeoLocLine -iY) * (padfGLX[nXSize] - padfGLX[0]);
@@ -979,6 +1527,8 @@ int GDALGeoLocTransform( void *pTransformArg, int bDstToSrc,
     {
         int i;
 
+        CPLMutexHolderD( &psData->hMutex );
+
         for( i = 0; i < nPointCount; i++ )
         {
             if( padfX[i] == HUGE_VAL || padfY[i] == HUGE_VAL )
@@ -990,20 +1540,20 @@ int GDALGeoLocTransform( void *pTransformArg, int bDstToSrc,
             double dfBMX, dfBMY;
             int iBMX, iBMY;
 
-            dfBMX = ((padfX[i] - psTransform->adfBackMapGeoTransform[0])
-                          / psTransform->adfBackMapGeoTransform[1]);
-            dfBMY = ((padfY[i] - psTransform->adfBackMapGeoTransform[3])
-                          / psTransform->adfBackMapGeoTransform[5]);
+            dfBMX = ((padfX[i] - psData->adfBackMapGeoTransform[0])
+                          / psData->adfBackMapGeoTransform[1]);
+            dfBMY = ((padfY[i] - psData->adfBackMapGeoTransform[3])
+                          / psData->adfBackMapGeoTransform[5]);
 
             iBMX = (int) dfBMX;
             iBMY = (int) dfBMY;
 
-            int iBM = iBMX + iBMY * psTransform->nBackMapWidth;
+            float fBMX = 0.0f, fBMY = 0.0f;
+            float fBMXRight = 0.0f, fBMYRight = 0.0f;
+            float fBMXDown = 0.0f, fBMYDown = 0.0f;
 
-            if( iBMX < 0 || iBMY < 0 
-                || iBMX >= psTransform->nBackMapWidth
-                || iBMY >= psTransform->nBackMapHeight 
-                || psTransform->pafBackMapX[iBM] < 0 )
+            if( !GeoLocGetBackMapValue( psData, iBMX, iBMY, &fBMX, &fBMY )
+                || fBMX < 0 )
             {
                 panSuccess[i] = FALSE;
                 padfX[i] = HUGE_VAL;
@@ -1011,39 +1561,40 @@ int GDALGeoLocTransform( void *pTransformArg, int bDstToSrc,
                 continue;
             }
 
-            float* pafBMX = psTransform->pafBackMapX + iBM;
-            float* pafBMY = psTransform->pafBackMapY + iBM;
-            if( iBMX + 1 < psTransform->nBackMapWidth &&
-                iBMY + 1 < psTransform->nBackMapHeight &&
-                pafBMX[1] >=0 && pafBMX[psTransform->nBackMapWidth] >= 0 )
+            int bRight = GeoLocGetBackMapValue( psData, iBMX + 1, iBMY, 
+                                                &fBMXRight, &fBMYRight )
+                && fBMXRight >= 0;
+            int bDown = GeoLocGetBackMapValue( psData, iBMX, iBMY + 1, 
+                                               &fBMXDown, &fBMYDown )
+                && fBMXDown >= 0;
+
+            if( bRight && bDown )
             {
-                padfX[i] = pafBMX[0] +
-                            (dfBMX - iBMX) * (pafBMX[1] - pafBMX[0]) +
-                            (dfBMY - iBMY) * (pafBMX[psTransform->nBackMapWidth] - pafBMX[0]);
-                padfY[i] = pafBMY[0] +
-                            (dfBMX - iBMX) * (pafBMY[1] - pafBMY[0]) +
-                            (dfBMY - iBMY) * (pafBMY[psTransform->nBackMapWidth] - pafBMY[0]);
+                padfX[i] = fBMX +
+                            (dfBMX - iBMX) * (fBMXRight - fBMX) +
+                            (dfBMY - iBMY) * (fBMXDown - fBMX);
+                padfY[i] = fBMY +
+                            (dfBMX - iBMX) * (fBMYRight - fBMY) +
+                            (dfBMY - iBMY) * (fBMYDown - fBMY);
             }
-            else if( iBMX + 1 < psTransform->nBackMapWidth &&
-                     pafBMX[1] >=0)
+            else if( bRight )
             {
-                padfX[i] = pafBMX[0] +
-                            (dfBMX - iBMX) * (pafBMX[1] - pafBMX[0]);
-                padfY[i] = pafBMY[0] +
-                            (dfBMX - iBMX) * (pafBMY[1] - pafBMY[0]);
+                padfX[i] = fBMX +
+                            (dfBMX - iBMX) * (fBMXRight - fBMX);
+                padfY[i] = fBMY +
+                            (dfBMX - iBMX) * (fBMYRight - fBMY);
             }
-            else if( iBMY + 1 < psTransform->nBackMapHeight &&
-                     pafBMX[psTransform->nBackMapWidth] >= 0 )
+            else if( bDown )
             {
-                padfX[i] = pafBMX[0] +
-                            (dfBMY - iBMY) * (pafBMX[psTransform->nBackMapWidth] - pafBMX[0]);
-                padfY[i] = pafBMY[0] +
-                            (dfBMY - iBMY) * (pafBMY[psTransform->nBackMapWidth] - pafBMY[0]);
+                padfX[i] = fBMX +
+                            (dfBMY - iBMY) * (fBMXDown - fBMX);
+                padfY[i] = fBMY +
+                            (dfBMY - iBMY) * (fBMYDown - fBMY);
             }
             else
             {
-                padfX[i] = pafBMX[0];
-                padfY[i] = pafBMY[0];
+                padfX[i] = fBMX;
+                padfY[i] = fBMY;
             }
             panSuccess[i] = TRUE;
         }
@@ -36,6 +36,8 @@
 #include "gdal_alg_priv.h"
 #include "cpl_list.h"
 #include "cpl_multiproc.h"
+#include <map>
+#include <vector>
 
 CPL_CVSID("$Id$");
 CPL_C_START
@@ -2444,6 +2446,473 @@ GDALDeserializeReprojectionTransformer( CPLXMLNode *psTree )
 /* ==================================================================== */
 /************************************************************************/
 
+/* -------------------------------------------------------------------- */
+/*      Optional interpolation grid of the destination to source        */
+/*      transformation, shared by the clones of an approximate          */
+/*      transformer.  The destination pixel/line space is divided       */
+/*      into square cells, recursively split in four until the          */
+/*      bilinear interpolation of the transformed corners of a cell     */
+/*      matches the exact transformation of its edge middles and        */
+/*      center within the max error.  The exact transformations are     */
+/*      cached at integer positions, so the tree can be rebuilt from    */
+/*      the cache without calling the base transformer : this is what   */
+/*      gets serialized.                                                */
+/* -------------------------------------------------------------------- */
+
+#define APPROX_GRID_CELL_SIZE      256
+#define APPROX_GRID_MIN_CELL_SIZE  2
+/* Keep the integer positions of the cells far from overflowing */
+#define APPROX_GRID_MAX_COORD      1e9
+
+typedef struct
+{
+    double      dfX;
+    double      dfY;
+    double      dfZ;
+    int         bSuccess;
+} ApproxGridPoint;
+
+typedef enum
+{
+    AGN_PENDING,    /* not evaluated yet */
+    AGN_LINEAR,     /* bilinear interpolation of the corners is accurate */
+    AGN_EXACT,      /* the base transformer must be used */
+    AGN_SPLIT       /* see the children */
+} ApproxGridNodeState;
+
+typedef struct _ApproxGridNode ApproxGridNode;
+struct _ApproxGridNode
+{
+    ApproxGridNodeState eState;
+    /* upper left, upper right, lower left and lower right */
+    ApproxGridPoint     asCorner[4];
+    /* 4 children in the same order, for AGN_SPLIT */
+    ApproxGridNode     *pasChildren;
+};
+
+typedef std::pair<int,int> ApproxGridKey;
+
+class ApproxTransformGrid
+{
+    double              dfMaxError;
+    std::map<ApproxGridKey, ApproxGridPoint> oMapPoints;
+    std::map<ApproxGridKey, ApproxGridNode*> oMapCells;
+
+    void                FetchPoints( int nCount, const int *panX,
+                                     const int *panY,
+                                     ApproxGridPoint *pasPoints,
+                                     GDALTransformerFunc pfnTransformer,
+                                     void *pTransformArg );
+    void                EvaluateNode( ApproxGridNode *psNode,
+                                      int nX, int nY, int nSize,
+                                      GDALTransformerFunc pfnTransformer,
+                                      void *pTransformArg );
+    void                EvaluateTree( ApproxGridNode *psNode,
+                                      int nX, int nY, int nSize,
+                                      GDALTransformerFunc pfnTransformer,
+                                      void *pTransformArg );
+    ApproxGridNode     *GetCell( int nCellX, int nCellY );
+
+  public:
+    void               *hMutex;
+    int                 nRefCount;
+
+                        ApproxTransformGrid( double dfMaxError );
+                       ~ApproxTransformGrid();
+
+    ApproxGridNode     *GetLeaf( double dfX, double dfY,
+                                 int *pnX, int *pnY, int *pnSize,
+                                 GDALTransformerFunc pfnTransformer,
+                                 void *pTransformArg );
+    void                Build( int nXSize, int nYSize,
+                               GDALTransformerFunc pfnTransformer,
+                               void *pTransformArg );
+
+    CPLString           Serialize();
+    void                Deserialize( const char *pszPoints );
+};
+
+/************************************************************************/
+/*                        ApproxTransformGrid()                         */
+/************************************************************************/
+
+ApproxTransformGrid::ApproxTransformGrid( double dfMaxErrorIn )
+
+{
+    dfMaxError = dfMaxErrorIn;
+    nRefCount = 1;
+    hMutex = CPLCreateMutex();
+    CPLReleaseMutex( hMutex );
+}
+
+/************************************************************************/
+/*                        ~ApproxTransformGrid()                        */
+/************************************************************************/
+
+static void GDALApproxGridFreeNode( ApproxGridNode *psNode )
+
+{
+    if( psNode->pasChildren != NULL )
+    {
+        for( int i = 0; i < 4; i++ )
+            GDALApproxGridFreeNode( psNode->pasChildren + i );
+        CPLFree( psNode->pasChildren );
+    }
+}
+
+ApproxTransformGrid::~ApproxTransformGrid()
+
+{
+    std::map<ApproxGridKey, ApproxGridNode*>::iterator oIter;
+
+    for( oIter = oMapCells.begin(); oIter != oMapCells.end(); ++oIter )
+    {
+        GDALApproxGridFreeNode( oIter->second );
+        CPLFree( oIter->second );
+    }
+
+    CPLDestroyMutex( hMutex );
+}
+
+/************************************************************************/
+/*                            FetchPoints()                             */
+/*                                                                      */
+/*      Return the exact transformation of integer positions, from      */
+/*      the cache, or from a single call to the base transformer for    */
+/*      the ones not yet cached.                                        */
+/************************************************************************/
+
+void ApproxTransformGrid::FetchPoints( int nCount, const int *panX,
+                                       const int *panY,
+                                       ApproxGridPoint *pasPoints,
+                                       GDALTransformerFunc pfnTransformer,
+                                       void *pTransformArg )
+
+{
+    double adfX[9], adfY[9], adfZ[9];
+    int    anSuccess[9], anMissing[9];
+    int    nMissing = 0, i;
+
+    CPLAssert( nCount <= 9 );
+
+    for( i = 0; i < nCount; i++ )
+    {
+        std::map<ApproxGridKey, ApproxGridPoint>::iterator oIter =
+            oMapPoints.find( ApproxGridKey( panX[i], panY[i] ) );
+
+        if( oIter != oMapPoints.end() )
+        {
+            pasPoints[i] = oIter->second;
+            continue;
+        }
+
+        adfX[nMissing] = panX[i];
+        adfY[nMissing] = panY[i];
+        adfZ[nMissing] = 0.0;
+        anMissing[nMissing++] = i;
+    }
+
+    if( nMissing == 0 )
+        return;
+
+    if( !pfnTransformer( pTransformArg, TRUE, nMissing,
+                         adfX, adfY, adfZ, anSuccess ) )
+    {
+        for( i = 0; i < nMissing; i++ )
+            anSuccess[i] = FALSE;
+    }
+
+    for( i = 0; i < nMissing; i++ )
+    {
+        ApproxGridPoint *psPoint = pasPoints + anMissing[i];
+
+        psPoint->dfX = adfX[i];
+        psPoint->dfY = adfY[i];
+        psPoint->dfZ = adfZ[i];
+        psPoint->bSuccess = anSuccess[i];
+
+        oMapPoints[ApproxGridKey( panX[anMissing[i]],
+                                  panY[anMissing[i]] )] = *psPoint;
+    }
+}
+
+/************************************************************************/
+/*                            EvaluateNode()                            */
+/************************************************************************/
+
+void ApproxTransformGrid::EvaluateNode( ApproxGridNode *psNode,
+                                        int nX, int nY, int nSize,
+                                        GDALTransformerFunc pfnTransformer,
+                                        void *pTransformArg )
+
+{
+/* -------------------------------------------------------------------- */
+/*      Fetch the corners, then the middle of the top, left, right      */
+/*      and bottom edges, and the center.                               */
+/* -------------------------------------------------------------------- */
+    static const int anHalfX[9] = { 0, 2, 0, 2, 1, 0, 2, 1, 1 };
+    static const int anHalfY[9] = { 0, 0, 2, 2, 0, 1, 1, 2, 1 };
+    int              anX[9], anY[9], i;
+    ApproxGridPoint  asPoints[9];
+    int              nHalf = nSize / 2;
+
+    for( i = 0; i < 9; i++ )
+    {
+        anX[i] = nX + anHalfX[i] * nHalf;
+        anY[i] = nY + anHalfY[i] * nHalf;
+    }
+
+    FetchPoints( 9, anX, anY, asPoints, pfnTransformer, pTransformArg );
+
+    memcpy( psNode->asCorner, asPoints, sizeof(psNode->asCorner) );
+
+/* -------------------------------------------------------------------- */
+/*      Compare the exact points with their interpolation.              */
+/* -------------------------------------------------------------------- */
+    int bAccurate = TRUE;
+
+    for( i = 0; i < 9 && bAccurate; i++ )
+    {
+        if( !asPoints[i].bSuccess )
+            bAccurate = FALSE;
+    }
+
+    for( i = 4; i < 9 && bAccurate; i++ )
+    {
+        double dfWX = anHalfX[i] * 0.5, dfWY = anHalfY[i] * 0.5;
+        double dfInterpX, dfInterpY;
+
+        dfInterpX = (asPoints[0].dfX * (1 - dfWX) + asPoints[1].dfX * dfWX)
+                        * (1 - dfWY)
+                  + (asPoints[2].dfX * (1 - dfWX) + asPoints[3].dfX * dfWX)
+                        * dfWY;
+        dfInterpY = (asPoints[0].dfY * (1 - dfWX) + asPoints[1].dfY * dfWX)
+                        * (1 - dfWY)
+                  + (asPoints[2].dfY * (1 - dfWX) + asPoints[3].dfY * dfWX)
+                        * dfWY;
+
+        if( fabs(dfInterpX - asPoints[i].dfX)
+            + fabs(dfInterpY - asPoints[i].dfY) > dfMaxError )
+            bAccurate = FALSE;
+    }
+
+    if( bAccurate )
+        psNode->eState = AGN_LINEAR;
+    else if( nSize > APPROX_GRID_MIN_CELL_SIZE )
+    {
+        psNode->eState = AGN_SPLIT;
+        psNode->pasChildren = (ApproxGridNode *)
+            CPLCalloc( 4, sizeof(ApproxGridNode) );
+        for( i = 0; i < 4; i++ )
+            psNode->pasChildren[i].eState = AGN_PENDING;
+    }
+    else
+        psNode->eState = AGN_EXACT;
+}
+
+/************************************************************************/
+/*                              GetCell()                               */
+/************************************************************************/
+
+ApproxGridNode *ApproxTransformGrid::GetCell( int nCellX, int nCellY )
+
+{
+    ApproxGridNode *&psCell = oMapCells[ApproxGridKey( nCellX, nCellY )];
+
+    if( psCell == NULL )
+    {
+        psCell = (ApproxGridNode *) CPLCalloc( 1, sizeof(ApproxGridNode) );
+        psCell->eState = AGN_PENDING;
+    }
+
+    return psCell;
+}
+
+/************************************************************************/
+/*                              GetLeaf()                               */
+/*                                                                      */
+/*      Return the leaf containing a destination position, and its      */
+/*      extent.  The caller must hold the mutex.                        */
+/************************************************************************/
+
+ApproxGridNode *ApproxTransformGrid::GetLeaf( double dfX, double dfY,
+                                              int *pnX, int *pnY,
+                                              int *pnSize,
+                                              GDALTransformerFunc pfnTransformer,
+                                              void *pTransformArg )
+
+{
+    int nCellX = (int) floor( dfX / APPROX_GRID_CELL_SIZE );
+    int nCellY = (int) floor( dfY / APPROX_GRID_CELL_SIZE );
+    int nX = nCellX * APPROX_GRID_CELL_SIZE;
+    int nY = nCellY * APPROX_GRID_CELL_SIZE;
+    int nSize = APPROX_GRID_CELL_SIZE;
+    ApproxGridNode *psNode = GetCell( nCellX, nCellY );
+
+    while( TRUE )
+    {
+        if( psNode->eState == AGN_PENDING )
+            EvaluateNode( psNode, nX, nY, nSize,
+                          pfnTransformer, pTransformArg );
+
+        if( psNode->eState != AGN_SPLIT )
+            break;
+
+        int iChild = 0;
+
+        nSize /= 2;
+        if( dfX >= nX + nSize )
+        {
+            nX += nSize;
+            iChild += 1;
+        }
+        if( dfY >= nY + nSize )
+        {
+            nY += nSize;
+            iChild += 2;
+        }
+        psNode = psNode->pasChildren + iChild;
+    }
+
+    *pnX = nX;
+    *pnY = nY;
+    *pnSize = nSize;
+
+    return psNode;
+}
+
+/************************************************************************/
+/*                            EvaluateTree()                            */
+/************************************************************************/
+
+void ApproxTransformGrid::EvaluateTree( ApproxGridNode *psNode,
+                                        int nX, int nY, int nSize,
+                                        GDALTransformerFunc pfnTransformer,
+                                        void *pTransformArg )
+
+{
+    if( psNode->eState == AGN_PENDING )
+        EvaluateNode( psNode, nX, nY, nSize, pfnTransformer, pTransformArg );
+
+    if( psNode->eState == AGN_SPLIT )
+    {
+        int nHalf = nSize / 2;
+
+        for( int i = 0; i < 4; i++ )
+            EvaluateTree( psNode->pasChildren + i,
+                          nX + (i % 2) * nHalf, nY + (i / 2) * nHalf, nHalf,
+                          pfnTransformer, pTransformArg );
+    }
+}
+
+/************************************************************************/
+/*                               Build()                                */
+/*                                                                      */
+/*      Fully evaluate the cells covering a destination raster.  The    */
+/*      caller must hold the mutex.                                     */
+/************************************************************************/
+
+void ApproxTransformGrid::Build( int nXSize, int nYSize,
+                                 GDALTransformerFunc pfnTransformer,
+                                 void *pTransformArg )
+
+{
+    int nCellsX = (nXSize + APPROX_GRID_CELL_SIZE - 1) / APPROX_GRID_CELL_SIZE;
+    int nCellsY = (nYSize + APPROX_GRID_CELL_SIZE - 1) / APPROX_GRID_CELL_SIZE;
+
+    for( int nCellY = 0; nCellY < nCellsY; nCellY++ )
+    {
+        for( int nCellX = 0; nCellX < nCellsX; nCellX++ )
+        {
+            EvaluateTree( GetCell( nCellX, nCellY ),
+                          nCellX * APPROX_GRID_CELL_SIZE,
+                          nCellY * APPROX_GRID_CELL_SIZE,
+                          APPROX_GRID_CELL_SIZE,
+                          pfnTransformer, pTransformArg );
+        }
+    }
+}
+
+/************************************************************************/
+/*                             Serialize()                              */
+/*                                                                      */
+/*      Space separated list of "x,y,srcx,srcy,srcz" for the cached     */
+/*      positions, and of "x,y" for the ones that failed to             */
+/*      transform.  The caller must hold the mutex.                     */
+/************************************************************************/
+
+CPLString ApproxTransformGrid::Serialize()
+
+{
+    CPLString osPoints;
+    std::map<ApproxGridKey, ApproxGridPoint>::iterator oIter;
+
+    for( oIter = oMapPoints.begin(); oIter != oMapPoints.end(); ++oIter )
+    {
+        const ApproxGridPoint &sPoint = oIter->second;
+
+        if( !osPoints.empty() )
+            osPoints += " ";
+
+        if( sPoint.bSuccess )
+            osPoints += CPLSPrintf( "%d,%d,%.17g,%.17g,%.17g",
+                                    oIter->first.first, oIter->first.second,
+                                    sPoint.dfX, sPoint.dfY, sPoint.dfZ );
+        else
+            osPoints += CPLSPrintf( "%d,%d",
+                                    oIter->first.first, oIter->first.second );
+    }
+
+    return osPoints;
+}
+
+/************************************************************************/
+/*                            Deserialize()                             */
+/************************************************************************/
+
+void ApproxTransformGrid::Deserialize( const char *pszPoints )
+
+{
+    char *pszIter = (char *) pszPoints;
+
+    while( TRUE )
+    {
+        ApproxGridPoint sPoint;
+        int             nX, nY;
+
+        while( *pszIter == ' ' || *pszIter == '\n' || *pszIter == '\r'
+               || *pszIter == '\t' )
+            pszIter++;
+        if( *pszIter == '\0' )
+            break;
+
+        nX = (int) strtol( pszIter, &pszIter, 10 );
+        if( *pszIter != ',' )
+            break;
+        nY = (int) strtol( pszIter + 1, &pszIter, 10 );
+
+        sPoint.dfX = sPoint.dfY = sPoint.dfZ = 0.0;
+        sPoint.bSuccess = (*pszIter == ',');
+        if( sPoint.bSuccess )
+        {
+            sPoint.dfX = CPLStrtod( pszIter + 1, &pszIter );
+            if( *pszIter != ',' )
+                break;
+            sPoint.dfY = CPLStrtod( pszIter + 1, &pszIter );
+            if( *pszIter != ',' )
+                break;
+            sPoint.dfZ = CPLStrtod( pszIter + 1, &pszIter );
+        }
+
+        oMapPoints[ApproxGridKey( nX, nY )] = sPoint;
+    }
+
+    if( *pszIter != '\0' )
+        CPLError( CE_Warning, CPLE_AppDefined,
+                  "Corrupted approximate transformer grid, ignoring "
+                  "its end." );
+}
+
 typedef struct 
 {
     GDALTransformerInfo sTI;
@@ -2453,6 +2922,9 @@ typedef struct
     double	      dfMaxError;
 
     int               bOwnSubtransformer;
+
+    /* NULL if the interpolation grid is not used */
+    ApproxTransformGrid *poGrid;
 } ApproxTransformInfo;
 
 /************************************************************************/
@@ -2481,6 +2953,12 @@ void* GDALCloneApproxTransformer( void *hTransformArg )
     }
     psClonedInfo->bOwnSubtransformer = TRUE;
 
+    if( psClonedInfo->poGrid != NULL )
+    {
+        CPLMutexHolderD( &psClonedInfo->poGrid->hMutex );
+        psClonedInfo->poGrid->nRefCount ++;
+    }
+
     return psClonedInfo;
 }
 
@@ -2503,6 +2981,16 @@ GDALSerializeApproxTransformer( void *pTransformArg )
     CPLCreateXMLElementAndValue( psTree, "MaxError", 
                                  CPLString().Printf("%g",psInfo->dfMaxError) );
 
+/* -------------------------------------------------------------------- */
+/*      Attach the cached points of the interpolation grid.             */
+/* -------------------------------------------------------------------- */
+    if( psInfo->poGrid != NULL )
+    {
+        CPLMutexHolderD( &psInfo->poGrid->hMutex );
+        CPLCreateXMLElementAndValue( psTree, "Grid",
+                                     psInfo->poGrid->Serialize() );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Capture underlying transformer.                                 */
 /* -------------------------------------------------------------------- */
@@ -2520,6 +3008,43 @@ GDALSerializeApproxTransformer( void *pTransformArg )
     return psTree;
 }
 
+/************************************************************************/
+/*                    GDALApproxTransformerUseGrid()                    */
+/*                                                                      */
+/*      Whether the interpolation grid should be used to                */
+/*      approximate a base transformer.  The grid is expressed in       */
+/*      destination pixel/line coordinates, so it is only enabled       */
+/*      automatically for GenImgProj transformers.                      */
+/************************************************************************/
+
+/* Number of GCPs of a TPS transformer from which the grid is used */
+#define APPROX_GRID_MIN_TPS_GCP_COUNT   1000
+
+static int GDALApproxTransformerUseGrid( GDALTransformerFunc pfnBaseTransformer,
+                                         void *pBaseTransformArg )
+
+{
+    const char *pszUseGrid =
+        CPLGetConfigOption( "GDAL_APPROX_TRANSFORMER_USE_GRID", "AUTO" );
+
+    if( !EQUAL(pszUseGrid, "AUTO") )
+        return CSLTestBoolean( pszUseGrid );
+
+    if( pfnBaseTransformer != GDALGenImgProjTransform
+        || pBaseTransformArg == NULL )
+        return FALSE;
+
+    GDALGenImgProjTransformInfo *psInfo =
+        (GDALGenImgProjTransformInfo *) pBaseTransformArg;
+
+    return (psInfo->pSrcTPSTransformArg != NULL
+            && GDALGetTPSTransformerGCPCount( psInfo->pSrcTPSTransformArg )
+                                        >= APPROX_GRID_MIN_TPS_GCP_COUNT)
+        || (psInfo->pDstTPSTransformArg != NULL
+            && GDALGetTPSTransformerGCPCount( psInfo->pDstTPSTransformArg )
+                                        >= APPROX_GRID_MIN_TPS_GCP_COUNT);
+}
+
 /************************************************************************/
 /*                    GDALCreateApproxTransformer()                     */
 /************************************************************************/
@@ -2551,6 +3076,21 @@ GDALSerializeApproxTransformer( void *pTransformArg )
  * circumstances as little internal validation is done, in order to keep things
  * fast. 
  *
+ * Destination to source transformations may instead be interpolated in a
+ * grid of cells of the destination pixel/line space, recursively split until
+ * the bilinear interpolation of their corners is within the maximum error.
+ * The grid is built lazily, is shared by the clones of the transformer (for
+ * instance by the threads of a multithreaded warp) so that the base
+ * transformer is called only once for each position, and its cache is
+ * serialized with the transformer, so that a VRTWarpedDataset reopened from
+ * disk does not need to call it again.  Its use is controlled by the
+ * GDAL_APPROX_TRANSFORMER_USE_GRID configuration option: YES always uses it,
+ * NO never does, and AUTO, the default, uses it only for GenImgProj
+ * transformers with a source or destination thin plate spline of at least
+ * 1000 GCPs, whose evaluation is costly.  Results of such transformations
+ * therefore differ slightly, within the maximum error, from those of the
+ * linear approximation used otherwise.
+ *
  * @param pfnBaseTransformer the high precision transformer which should be
  * approximated. 
  * @param pBaseTransformArg the callback argument for the high precision 
@@ -2573,6 +3113,11 @@ void *GDALCreateApproxTransformer( GDALTransformerFunc pfnBaseTransformer,
     psATInfo->pBaseCBData = pBaseTransformArg;
     psATInfo->dfMaxError = dfMaxError;
     psATInfo->bOwnSubtransformer = FALSE;
+    psATInfo->poGrid = NULL;
+
+    if( dfMaxError > 0.0 &&
+        GDALApproxTransformerUseGrid( pfnBaseTransformer, pBaseTransformArg ) )
+        psATInfo->poGrid = new ApproxTransformGrid( dfMaxError );
 
     strcpy( psATInfo->sTI.szSignature, "GTI" );
     psATInfo->sTI.pszClassName = "GDALApproxTransformer";
@@ -2618,9 +3163,167 @@ void GDALDestroyApproxTransformer( void * pCBData )
     if( psATInfo->bOwnSubtransformer ) 
         GDALDestroyTransformer( psATInfo->pBaseCBData );
 
+    if( psATInfo->poGrid != NULL )
+    {
+        int nRefCount;
+
+        {
+            CPLMutexHolderD( &psATInfo->poGrid->hMutex );
+            nRefCount = --psATInfo->poGrid->nRefCount;
+        }
+
+        if( nRefCount == 0 )
+            delete psATInfo->poGrid;
+    }
+
     CPLFree( pCBData );
 }
 
+/************************************************************************/
+/*                   GDALApproxTransformerBuildGrid()                   */
+/*                                                                      */
+/*      Fully build the interpolation grid of an approximate            */
+/*      transformer, if it uses one, over a destination raster of       */
+/*      the passed size, typically before serializing it.               */
+/************************************************************************/
+
+void GDALApproxTransformerBuildGrid( void *pCBData, int nXSize, int nYSize )
+
+{
+    ApproxTransformInfo *psATInfo = (ApproxTransformInfo *) pCBData;
+
+    if( psATInfo->poGrid == NULL )
+        return;
+
+    CPLMutexHolderD( &psATInfo->poGrid->hMutex );
+    psATInfo->poGrid->Build( nXSize, nYSize, psATInfo->pfnBaseTransformer,
+                             psATInfo->pBaseCBData );
+}
+
+/************************************************************************/
+/*                     GDALApproxTransformWithGrid()                    */
+/************************************************************************/
+
+static int GDALApproxTransformWithGrid( ApproxTransformInfo *psATInfo,
+                                        int nPoints,
+                                        double *x, double *y, double *z,
+                                        int *panSuccess )
+
+{
+    ApproxTransformGrid *poGrid = psATInfo->poGrid;
+    std::vector<int>     anExact;
+    int                  i;
+
+/* -------------------------------------------------------------------- */
+/*      Interpolate the points in the leaf containing them.  Points     */
+/*      are usually along a scanline, so the last leaf is tried         */
+/*      first.                                                          */
+/* -------------------------------------------------------------------- */
+    {
+        CPLMutexHolderD( &poGrid->hMutex );
+
+        ApproxGridNode *psLeaf = NULL;
+        int nLeafX = 0, nLeafY = 0, nLeafSize = 0;
+        double dfLeafY = 0.0, dfInvLeafSize = 0.0;
+        double adfLeft[3] = { 0.0, 0.0, 0.0 };
+        double adfRight[3] = { 0.0, 0.0, 0.0 };
+
+        for( i = 0; i < nPoints; i++ )
+        {
+            /* The grid is built for z = 0 */
+            if( z[i] != 0.0
+                || !(fabs(x[i]) < APPROX_GRID_MAX_COORD)
+                || !(fabs(y[i]) < APPROX_GRID_MAX_COORD) )
+            {
+                anExact.push_back( i );
+                continue;
+            }
+
+            if( psLeaf == NULL
+                || x[i] < nLeafX || x[i] > nLeafX + nLeafSize
+                || y[i] < nLeafY || y[i] > nLeafY + nLeafSize )
+            {
+                psLeaf = poGrid->GetLeaf( x[i], y[i],
+                                          &nLeafX, &nLeafY, &nLeafSize,
+                                          psATInfo->pfnBaseTransformer,
+                                          psATInfo->pBaseCBData );
+                dfInvLeafSize = 1.0 / nLeafSize;
+                /* force the computation of the edges below */
+                dfLeafY = y[i] + 1.0;
+            }
+
+            if( psLeaf->eState == AGN_EXACT )
+            {
+                anExact.push_back( i );
+                continue;
+            }
+
+/* -------------------------------------------------------------------- */
+/*      Interpolate along the left and right edges of the leaf at       */
+/*      this line, then between them.                                   */
+/* -------------------------------------------------------------------- */
+            if( y[i] != dfLeafY )
+            {
+                const ApproxGridPoint *pasCorner = psLeaf->asCorner;
+                double dfWY = (y[i] - nLeafY) * dfInvLeafSize;
+
+                dfLeafY = y[i];
+                adfLeft[0] = pasCorner[0].dfX
+                           + (pasCorner[2].dfX - pasCorner[0].dfX) * dfWY;
+                adfLeft[1] = pasCorner[0].dfY
+                           + (pasCorner[2].dfY - pasCorner[0].dfY) * dfWY;
+                adfLeft[2] = pasCorner[0].dfZ
+                           + (pasCorner[2].dfZ - pasCorner[0].dfZ) * dfWY;
+                adfRight[0] = pasCorner[1].dfX
+                            + (pasCorner[3].dfX - pasCorner[1].dfX) * dfWY;
+                adfRight[1] = pasCorner[1].dfY
+                            + (pasCorner[3].dfY - pasCorner[1].dfY) * dfWY;
+                adfRight[2] = pasCorner[1].dfZ
+                            + (pasCorner[3].dfZ - pasCorner[1].dfZ) * dfWY;
+            }
+
+            double dfWX = (x[i] - nLeafX) * dfInvLeafSize;
+
+            x[i] = adfLeft[0] + (adfRight[0] - adfLeft[0]) * dfWX;
+            y[i] = adfLeft[1] + (adfRight[1] - adfLeft[1]) * dfWX;
+            z[i] = adfLeft[2] + (adfRight[2] - adfLeft[2]) * dfWX;
+            panSuccess[i] = TRUE;
+        }
+    }
+
+    if( anExact.empty() )
+        return TRUE;
+
+/* -------------------------------------------------------------------- */
+/*      Transform the other points exactly, in a single call.           */
+/* -------------------------------------------------------------------- */
+    int nExact = (int) anExact.size();
+    std::vector<double> adfX( nExact ), adfY( nExact ), adfZ( nExact );
+    std::vector<int> anSuccess( nExact );
+
+    for( i = 0; i < nExact; i++ )
+    {
+        adfX[i] = x[anExact[i]];
+        adfY[i] = y[anExact[i]];
+        adfZ[i] = z[anExact[i]];
+    }
+
+    int bSuccess =
+        psATInfo->pfnBaseTransformer( psATInfo->pBaseCBData, TRUE, nExact,
+                                      &adfX[0], &adfY[0], &adfZ[0],
+                                      &anSuccess[0] );
+
+    for( i = 0; i < nExact; i++ )
+    {
+        x[anExact[i]] = adfX[i];
+        y[anExact[i]] = adfY[i];
+        z[anExact[i]] = adfZ[i];
+        panSuccess[anExact[i]] = anSuccess[i];
+    }
+
+    return bSuccess;
+}
+
 /************************************************************************/
 /*                        GDALApproxTransform()                         */
 /************************************************************************/
@@ -2642,6 +3345,10 @@ int GDALApproxTransform( void *pCBData, int bDstToSrc, int nPoints,
     double x2[3], y2[3], z2[3], dfDeltaX, dfDeltaY, dfError, dfDist, dfDeltaZ;
     int nMiddle, anSuccess2[3], i, bSuccess;
 
+    if( psATInfo->poGrid != NULL && bDstToSrc && nPoints > 0 )
+        return GDALApproxTransformWithGrid( psATInfo, nPoints, x, y, z,
+                                            panSuccess );
+
     nMiddle = (nPoints-1)/2;
 
 /* -------------------------------------------------------------------- */
@@ -2768,6 +3475,21 @@ GDALDeserializeApproxTransformer( CPLXMLNode *psTree )
                                                            dfMaxError );
         GDALApproxTransformerOwnsSubtransformer( pApproxCBData, TRUE );
 
+/* -------------------------------------------------------------------- */
+/*      Restore the cache of the interpolation grid, which enables      */
+/*      it whatever GDAL_APPROX_TRANSFORMER_USE_GRID is.                */
+/* -------------------------------------------------------------------- */
+        CPLXMLNode *psGrid = CPLGetXMLNode( psTree, "Grid" );
+        ApproxTransformInfo *psATInfo = (ApproxTransformInfo *) pApproxCBData;
+
+        if( psGrid != NULL && dfMaxError > 0.0 )
+        {
+            if( psATInfo->poGrid == NULL )
+                psATInfo->poGrid = new ApproxTransformGrid( dfMaxError );
+            psATInfo->poGrid->Deserialize( CPLGetXMLValue( psGrid, NULL,
+                                                           "" ) );
+        }
+
         return pApproxCBData;
     }
 }
@@ -3099,6 +3821,57 @@ int GDALUseTransformer( void *pTransformArg,
                                      x, y, z, panSuccess );
 }
 
+/************************************************************************/
+/*                     GDALTransformIsAxisAligned()                     */
+/*                                                                      */
+/*      Returns TRUE if the transformer is known to map destination     */
+/*      pixel/line coordinates to source ones with only a scaling      */
+/*      and an offset along each axis, that is if the source X only    */
+/*      depends on the destination X, and the source Y only on the     */
+/*      destination Y.  This is the case of a GenImgProj transformer    */
+/*      between two north-up geotransforms without reprojection,        */
+/*      possibly wrapped by an approximate transformer.                 */
+/************************************************************************/
+
+int GDALTransformIsAxisAligned( GDALTransformerFunc pfnTransformer,
+                                void *pTransformArg )
+
+{
+    if( pTransformArg == NULL )
+        return FALSE;
+
+    if( pfnTransformer == GDALApproxTransform )
+    {
+        ApproxTransformInfo *psATInfo = (ApproxTransformInfo *) pTransformArg;
+
+        pfnTransformer = psATInfo->pfnBaseTransformer;
+        pTransformArg = psATInfo->pBaseCBData;
+        if( pTransformArg == NULL )
+            return FALSE;
+    }
+
+    if( pfnTransformer != GDALGenImgProjTransform )
+        return FALSE;
+
+    GDALGenImgProjTransformInfo *psInfo = 
+        (GDALGenImgProjTransformInfo *) pTransformArg;
+
+    if( psInfo->pSrcGCPTransformArg != NULL
+        || psInfo->pSrcRPCTransformArg != NULL
+        || psInfo->pSrcTPSTransformArg != NULL
+        || psInfo->pSrcGeoLocTransformArg != NULL
+        || psInfo->pReprojectArg != NULL
+        || psInfo->pDstGCPTransformArg != NULL
+        || psInfo->pDstRPCTransformArg != NULL
+        || psInfo->pDstTPSTransformArg != NULL )
+        return FALSE;
+
+    return psInfo->adfDstGeoTransform[2] == 0.0
+        && psInfo->adfDstGeoTransform[4] == 0.0
+        && psInfo->adfSrcInvGeoTransform[2] == 0.0
+        && psInfo->adfSrcInvGeoTransform[4] == 0.0;
+}
+
 /************************************************************************/
 /*                        GDALCloneTransformer()                        */
 /************************************************************************/
@@ -841,6 +841,9 @@ GDALWarpDstAlphaMasker( void *pMaskFuncArg, int nBandCount, GDALDataType eType,
  * - NUM_THREADS: (GDAL >= 1.10) Can be set to a numeric value or ALL_CPUS to
  * set the number of threads to use to parallelize the computation part of the
  * warping. If not set, computation will be done in a single thread.
+ * With GDALWarpOperation::ChunkAndWarpMulti(), this is the total number of
+ * threads (2 if not set), shared between the chunk threads and the warp
+ * kernels.
  */
 
 /************************************************************************/
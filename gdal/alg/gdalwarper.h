@@ -337,7 +337,7 @@ private:
     CPLErr          CreateKernelMask( GDALWarpKernel *, int iBand, 
                                       const char *pszType );
 
-    void            *unused1;
+    void            *hPreparedCutline;
     void            *unused2;
     void            *hIOMutex;
     void            *hWarpMutex;
@@ -353,6 +353,25 @@ private:
     CPLErr          CollectChunkList( int nDstXOff, int nDstYOff, 
                                       int nDstXSize, int nDstYSize );
     void            ReportTiming( const char * );
+
+    static void     ChunkThreadMain( void * );
+
+    CPLErr          WarpRegionInternal( int nDstXOff, int nDstYOff,
+                                        int nDstXSize, int nDstYSize,
+                                        int nSrcXOff, int nSrcYOff,
+                                        int nSrcXSize, int nSrcYSize,
+                                        double dfProgressBase,
+                                        double dfProgressScale,
+                                        void *pChunkThreadData );
+    CPLErr          WarpRegionToBufferInternal( int nDstXOff, int nDstYOff,
+                                                int nDstXSize, int nDstYSize,
+                                                void *pDataBuf,
+                                                GDALDataType eBufDataType,
+                                                int nSrcXOff, int nSrcYOff,
+                                                int nSrcXSize, int nSrcYSize,
+                                                double dfProgressBase,
+                                                double dfProgressScale,
+                                                void *pChunkThreadData );
     
 public:
                     GDALWarpOperation();
@@ -35,6 +35,14 @@
 #include "gdalwarpkernel_opencl.h"
 #include "cpl_atomic_ops.h"
 #include "cpl_multiproc.h"
+#include <algorithm>
+#include <limits>
+
+/* SSE2 is part of the x86-64 baseline, so no runtime check is needed */
+#if defined(HAVE_SSE_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+#define GWK_USE_SSE2
+#include <emmintrin.h>
+#endif
 
 CPL_CVSID("$Id$");
 
@@ -60,19 +68,11 @@ static CPLErr GWKOpenCLCase( GDALWarpKernel * );
 #endif
 
 static CPLErr GWKGeneralCase( GDALWarpKernel * );
-static CPLErr GWKNearestNoMasksByte( GDALWarpKernel *poWK );
-static CPLErr GWKBilinearNoMasksByte( GDALWarpKernel *poWK );
-static CPLErr GWKCubicNoMasksByte( GDALWarpKernel *poWK );
-static CPLErr GWKCubicSplineNoMasksByte( GDALWarpKernel *poWK );
-static CPLErr GWKNearestByte( GDALWarpKernel *poWK );
-static CPLErr GWKNearestNoMasksShort( GDALWarpKernel *poWK );
-static CPLErr GWKBilinearNoMasksShort( GDALWarpKernel *poWK );
-static CPLErr GWKCubicNoMasksShort( GDALWarpKernel *poWK );
-static CPLErr GWKCubicSplineNoMasksShort( GDALWarpKernel *poWK );
-static CPLErr GWKNearestShort( GDALWarpKernel *poWK );
-static CPLErr GWKNearestNoMasksFloat( GDALWarpKernel *poWK );
-static CPLErr GWKNearestFloat( GDALWarpKernel *poWK );
+template<class T>
+static CPLErr GWKOptimizedCase( GDALWarpKernel *poWK, int bNoSrcMasks );
 static CPLErr GWKAverageOrMode( GDALWarpKernel * );
+static CPLErr GWKSeparableCase( GDALWarpKernel * );
+static int GWKCubicSplineMirrorsEdges( const GDALWarpKernel * );
 
 /************************************************************************/
 /*                           GWKJobStruct                               */
@@ -846,98 +846,57 @@ CPLErr GDALWarpKernel::PerformWarp()
     }
 #endif /* defined HAVE_OPENCL */
 
-    if( eWorkingDataType == GDT_Byte
-        && eResample == GRA_NearestNeighbour
-        && papanBandSrcValid == NULL
-        && panUnifiedSrcValid == NULL
-        && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
-        && pafDstDensity == NULL )
-        return GWKNearestNoMasksByte( this );
-
-    if( eWorkingDataType == GDT_Byte
-        && eResample == GRA_Bilinear
-        && papanBandSrcValid == NULL
-        && panUnifiedSrcValid == NULL
-        && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
-        && pafDstDensity == NULL )
-        return GWKBilinearNoMasksByte( this );
-
-    if( eWorkingDataType == GDT_Byte
-        && eResample == GRA_Cubic
-        && papanBandSrcValid == NULL
-        && panUnifiedSrcValid == NULL
-        && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
-        && pafDstDensity == NULL )
-        return GWKCubicNoMasksByte( this );
-
-    if( eWorkingDataType == GDT_Byte
-        && eResample == GRA_CubicSpline
-        && papanBandSrcValid == NULL
-        && panUnifiedSrcValid == NULL
-        && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
-        && pafDstDensity == NULL )
-        return GWKCubicSplineNoMasksByte( this );
-
-    if( eWorkingDataType == GDT_Byte
-        && eResample == GRA_NearestNeighbour )
-        return GWKNearestByte( this );
-
-    if( (eWorkingDataType == GDT_Int16 || eWorkingDataType == GDT_UInt16)
-        && eResample == GRA_NearestNeighbour
-        && papanBandSrcValid == NULL
-        && panUnifiedSrcValid == NULL
-        && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
-        && pafDstDensity == NULL )
-        return GWKNearestNoMasksShort( this );
-
-    if( (eWorkingDataType == GDT_Int16 )
-        && eResample == GRA_Cubic
-        && papanBandSrcValid == NULL
-        && panUnifiedSrcValid == NULL
-        && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
-        && pafDstDensity == NULL )
-        return GWKCubicNoMasksShort( this );
-
-    if( (eWorkingDataType == GDT_Int16 )
-        && eResample == GRA_CubicSpline
-        && papanBandSrcValid == NULL
-        && panUnifiedSrcValid == NULL
-        && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
-        && pafDstDensity == NULL )
-        return GWKCubicSplineNoMasksShort( this );
-
-    if( (eWorkingDataType == GDT_Int16 )
-        && eResample == GRA_Bilinear
-        && papanBandSrcValid == NULL
-        && panUnifiedSrcValid == NULL
-        && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
-        && pafDstDensity == NULL )
-        return GWKBilinearNoMasksShort( this );
-
-    if( (eWorkingDataType == GDT_Int16 || eWorkingDataType == GDT_UInt16)
-        && eResample == GRA_NearestNeighbour )
-        return GWKNearestShort( this );
-
-    if( eWorkingDataType == GDT_Float32
-        && eResample == GRA_NearestNeighbour
-        && papanBandSrcValid == NULL
+    /* Images smaller than the kernel are resampled as bilinear by the */
+    /* kernels flipping the sampling over the edges */
+    if( (eResample == GRA_CubicSpline
+         || (eResample == GRA_Lanczos && dfXFilter == 3.0 && dfYFilter == 3.0))
+        && nSrcXSize > 1 && nSrcYSize > 1
+        && !(GWKCubicSplineMirrorsEdges( this )
+             && (nXRadius > nSrcXSize || nYRadius > nSrcYSize))
+        && GDALTransformIsAxisAligned( pfnTransformer, pTransformerArg ) )
+        return GWKSeparableCase( this );
+
+/* -------------------------------------------------------------------- */
+/*      Optimized kernels for the non complex working data types.       */
+/*      Nearest neighbour copes with any mask; the interpolating        */
+/*      kernels only with destination masks.                            */
+/* -------------------------------------------------------------------- */
+    int bNoSrcMasks = papanBandSrcValid == NULL
         && panUnifiedSrcValid == NULL
-        && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
-        && pafDstDensity == NULL )
-        return GWKNearestNoMasksFloat( this );
+        && pafUnifiedSrcDensity == NULL;
+
+    if( eResample == GRA_NearestNeighbour
+        || (bNoSrcMasks && (eResample == GRA_Bilinear
+                            || eResample == GRA_Cubic
+                            || eResample == GRA_CubicSpline)) )
+    {
+        switch( eWorkingDataType )
+        {
+          case GDT_Byte:
+            return GWKOptimizedCase<GByte>( this, bNoSrcMasks );
+
+          case GDT_Int16:
+            return GWKOptimizedCase<GInt16>( this, bNoSrcMasks );
+
+          case GDT_UInt16:
+            return GWKOptimizedCase<GUInt16>( this, bNoSrcMasks );
+
+          case GDT_Int32:
+            return GWKOptimizedCase<GInt32>( this, bNoSrcMasks );
+
+          case GDT_UInt32:
+            return GWKOptimizedCase<GUInt32>( this, bNoSrcMasks );
+
+          case GDT_Float32:
+            return GWKOptimizedCase<float>( this, bNoSrcMasks );
+
+          case GDT_Float64:
+            return GWKOptimizedCase<double>( this, bNoSrcMasks );
 
-    if( eWorkingDataType == GDT_Float32
-        && eResample == GRA_NearestNeighbour )
-        return GWKNearestFloat( this );
+          default:
+            break;
+        }
+    }
 
     if( eResample == GRA_Average )
         return GWKAverageOrMode( this );
@@ -1588,15 +1547,16 @@ static int GWKGetPixelRow( GDALWarpKernel *poWK, int iBand,
 }
 
 /************************************************************************/
-/*                          GWKGetPixelByte()                           */
+/*                            GWKGetPixelT()                            */
 /************************************************************************/
 
-static int GWKGetPixelByte( GDALWarpKernel *poWK, int iBand, 
-                            int iSrcOffset, double *pdfDensity, 
-                            GByte *pbValue )
+template<class T>
+static int GWKGetPixelT( GDALWarpKernel *poWK, int iBand, 
+                         int iSrcOffset, double *pdfDensity, 
+                         T *pValue )
 
 {
-    GByte *pabySrc = poWK->papabySrcImage[iBand];
+    T *pSrc = (T *)poWK->papabySrcImage[iBand];
 
     if ( ( poWK->panUnifiedSrcValid != NULL
            && !((poWK->panUnifiedSrcValid[iSrcOffset>>5]
@@ -1610,7 +1570,7 @@ static int GWKGetPixelByte( GDALWarpKernel *poWK, int iBand,
         return FALSE;
     }
 
-    *pbValue = pabySrc[iSrcOffset];
+    *pValue = pSrc[iSrcOffset];
 
     if ( poWK->pafUnifiedSrcDensity == NULL )
         *pdfDensity = 1.0;
@@ -1621,69 +1581,67 @@ static int GWKGetPixelByte( GDALWarpKernel *poWK, int iBand,
 }
 
 /************************************************************************/
-/*                          GWKGetPixelShort()                          */
+/*                           GWKClampValueT()                           */
+/*                                                                      */
+/*      Convert a resampled value to the working data type, clamping    */
+/*      and rounding as GWKSetPixelValue() does.                        */
 /************************************************************************/
 
-static int GWKGetPixelShort( GDALWarpKernel *poWK, int iBand, 
-                             int iSrcOffset, double *pdfDensity, 
-                             GInt16 *piValue )
+template<class T>
+static CPL_INLINE T GWKClampValueT( double dfValue )
 
 {
-    GInt16 *pabySrc = (GInt16 *)poWK->papabySrcImage[iBand];
-
-    if ( ( poWK->panUnifiedSrcValid != NULL
-           && !((poWK->panUnifiedSrcValid[iSrcOffset>>5]
-                 & (0x01 << (iSrcOffset & 0x1f))) ) )
-         || ( poWK->papanBandSrcValid != NULL
-              && poWK->papanBandSrcValid[iBand] != NULL
-              && !((poWK->papanBandSrcValid[iBand][iSrcOffset>>5]
-                    & (0x01 << (iSrcOffset & 0x1f)))) ) )
-    {
-        *pdfDensity = 0.0;
-        return FALSE;
-    }
-
-    *piValue = pabySrc[iSrcOffset];
-
-    if ( poWK->pafUnifiedSrcDensity == NULL )
-        *pdfDensity = 1.0;
+    if( dfValue < (double) std::numeric_limits<T>::min() )
+        return std::numeric_limits<T>::min();
+    else if( dfValue > (double) std::numeric_limits<T>::max() )
+        return std::numeric_limits<T>::max();
+    else if( std::numeric_limits<T>::is_signed )
+        return (T) floor( dfValue + 0.5 );
     else
-        *pdfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
+        return (T) ( dfValue + 0.5 );
+}
 
-    return *pdfDensity != 0.0;
+template<>
+CPL_INLINE float GWKClampValueT<float>( double dfValue )
+{
+    return (float) dfValue;
+}
+
+template<>
+CPL_INLINE double GWKClampValueT<double>( double dfValue )
+{
+    return dfValue;
 }
 
 /************************************************************************/
-/*                          GWKGetPixelFloat()                          */
+/*                          GWKAvoidNoDataT()                           */
+/*                                                                      */
+/*      Nudge an integer value that happens to be equal to the          */
+/*      destination nodata value, as GWKSetPixelValue() does.           */
 /************************************************************************/
 
-static int GWKGetPixelFloat( GDALWarpKernel *poWK, int iBand, 
-                             int iSrcOffset, double *pdfDensity, 
-                             float *pfValue )
+template<class T>
+static CPL_INLINE void GWKAvoidNoDataT( GDALWarpKernel *poWK, int iBand,
+                                        T *pValue )
 
 {
-    float *pabySrc = (float *)poWK->papabySrcImage[iBand];
-
-    if ( ( poWK->panUnifiedSrcValid != NULL
-           && !((poWK->panUnifiedSrcValid[iSrcOffset>>5]
-                 & (0x01 << (iSrcOffset & 0x1f))) ) )
-         || ( poWK->papanBandSrcValid != NULL
-              && poWK->papanBandSrcValid[iBand] != NULL
-              && !((poWK->papanBandSrcValid[iBand][iSrcOffset>>5]
-                    & (0x01 << (iSrcOffset & 0x1f)))) ) )
+    if( poWK->padfDstNoDataReal[iBand] == (double) *pValue )
     {
-        *pdfDensity = 0.0;
-        return FALSE;
+        if( *pValue == std::numeric_limits<T>::min() )
+            *pValue = (T) (*pValue + 1);
+        else
+            *pValue = (T) (*pValue - 1);
     }
+}
 
-    *pfValue = pabySrc[iSrcOffset];
-
-    if ( poWK->pafUnifiedSrcDensity == NULL )
-        *pdfDensity = 1.0;
-    else
-        *pdfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
+template<>
+CPL_INLINE void GWKAvoidNoDataT<float>( GDALWarpKernel *, int, float * )
+{
+}
 
-    return *pdfDensity != 0.0;
+template<>
+CPL_INLINE void GWKAvoidNoDataT<double>( GDALWarpKernel *, int, double * )
+{
 }
 
 /************************************************************************/
@@ -1839,9 +1797,10 @@ static int GWKBilinearResample( GDALWarpKernel *poWK, int iBand,
     }
 }
 
-static int GWKBilinearResampleNoMasksByte( GDALWarpKernel *poWK, int iBand, 
-                                           double dfSrcX, double dfSrcY,
-                                           GByte *pbValue )
+template<class T>
+static int GWKBilinearResampleNoMasksT( GDALWarpKernel *poWK, int iBand, 
+                                        double dfSrcX, double dfSrcY,
+                                        T *pValue )
 
 {
     double  dfAccumulator = 0.0;
@@ -1852,6 +1811,7 @@ static int GWKBilinearResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
     int     iSrcOffset = iSrcX + iSrcY * poWK->nSrcXSize;
     double  dfRatioX = 1.5 - (dfSrcX - iSrcX);
     double  dfRatioY = 1.5 - (dfSrcY - iSrcY);
+    T      *pSrcBand = (T *) poWK->papabySrcImage[iBand];
 
     // Upper Left Pixel
     if( iSrcX >= 0 && iSrcX < poWK->nSrcXSize
@@ -1861,8 +1821,7 @@ static int GWKBilinearResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
 
         dfAccumulatorDivisor += dfMult;
 
-        dfAccumulator +=
-            (double)poWK->papabySrcImage[iBand][iSrcOffset] * dfMult;
+        dfAccumulator += (double)pSrcBand[iSrcOffset] * dfMult;
     }
         
     // Upper Right Pixel
@@ -1873,8 +1832,7 @@ static int GWKBilinearResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
 
         dfAccumulatorDivisor += dfMult;
 
-        dfAccumulator +=
-            (double)poWK->papabySrcImage[iBand][iSrcOffset+1] * dfMult;
+        dfAccumulator += (double)pSrcBand[iSrcOffset+1] * dfMult;
     }
         
     // Lower Right Pixel
@@ -1886,8 +1844,7 @@ static int GWKBilinearResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
         dfAccumulatorDivisor += dfMult;
 
         dfAccumulator +=
-            (double)poWK->papabySrcImage[iBand][iSrcOffset+1+poWK->nSrcXSize]
-            * dfMult;
+            (double)pSrcBand[iSrcOffset+1+poWK->nSrcXSize] * dfMult;
     }
         
     // Lower Left Pixel
@@ -1899,8 +1856,7 @@ static int GWKBilinearResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
         dfAccumulatorDivisor += dfMult;
 
         dfAccumulator +=
-            (double)poWK->papabySrcImage[iBand][iSrcOffset+poWK->nSrcXSize]
-            * dfMult;
+            (double)pSrcBand[iSrcOffset+poWK->nSrcXSize] * dfMult;
     }
 
 /* -------------------------------------------------------------------- */
@@ -1910,7 +1866,7 @@ static int GWKBilinearResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
 
     if( dfAccumulatorDivisor < 0.00001 )
     {
-        *pbValue = 0;
+        *pValue = 0;
         return FALSE;
     }
     else if( dfAccumulatorDivisor == 1.0 )
@@ -1922,101 +1878,11 @@ static int GWKBilinearResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
         dfValue = dfAccumulator / dfAccumulatorDivisor;
     }
 
-    if ( dfValue < 0.0 )
-        *pbValue = 0;
-    else if ( dfValue > 255.0 )
-        *pbValue = 255;
-    else
-        *pbValue = (GByte)(0.5 + dfValue);
+    *pValue = GWKClampValueT<T>( dfValue );
     
     return TRUE;
 }
 
-static int GWKBilinearResampleNoMasksShort( GDALWarpKernel *poWK, int iBand, 
-                                            double dfSrcX, double dfSrcY,
-                                            GInt16 *piValue )
-
-{
-    double  dfAccumulator = 0.0;
-    double  dfAccumulatorDivisor = 0.0;
-
-    int     iSrcX = (int) floor(dfSrcX - 0.5);
-    int     iSrcY = (int) floor(dfSrcY - 0.5);
-    int     iSrcOffset = iSrcX + iSrcY * poWK->nSrcXSize;
-    double  dfRatioX = 1.5 - (dfSrcX - iSrcX);
-    double  dfRatioY = 1.5 - (dfSrcY - iSrcY);
-
-    // Upper Left Pixel
-    if( iSrcX >= 0 && iSrcX < poWK->nSrcXSize
-        && iSrcY >= 0 && iSrcY < poWK->nSrcYSize )
-    {
-        double dfMult = dfRatioX * dfRatioY;
-
-        dfAccumulatorDivisor += dfMult;
-
-        dfAccumulator +=
-            (double)((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset]
-            * dfMult;
-    }
-        
-    // Upper Right Pixel
-    if( iSrcX+1 >= 0 && iSrcX+1 < poWK->nSrcXSize
-        && iSrcY >= 0 && iSrcY < poWK->nSrcYSize )
-    {
-        double dfMult = (1.0-dfRatioX) * dfRatioY;
-
-        dfAccumulatorDivisor += dfMult;
-
-        dfAccumulator +=
-            (double)((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset+1] * dfMult;
-    }
-        
-    // Lower Right Pixel
-    if( iSrcX+1 >= 0 && iSrcX+1 < poWK->nSrcXSize
-        && iSrcY+1 >= 0 && iSrcY+1 < poWK->nSrcYSize )
-    {
-        double dfMult = (1.0-dfRatioX) * (1.0-dfRatioY);
-
-        dfAccumulatorDivisor += dfMult;
-
-        dfAccumulator +=
-            (double)((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset+1+poWK->nSrcXSize]
-            * dfMult;
-    }
-        
-    // Lower Left Pixel
-    if( iSrcX >= 0 && iSrcX < poWK->nSrcXSize
-        && iSrcY+1 >= 0 && iSrcY+1 < poWK->nSrcYSize )
-    {
-        double dfMult = dfRatioX * (1.0-dfRatioY);
-
-        dfAccumulatorDivisor += dfMult;
-
-        dfAccumulator +=
-            (double)((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset+poWK->nSrcXSize]
-            * dfMult;
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Return result.                                                  */
-/* -------------------------------------------------------------------- */
-    if( dfAccumulatorDivisor == 1.0 )
-    {
-        *piValue = (GInt16)(0.5 + dfAccumulator);
-        return TRUE;
-    }
-    else if( dfAccumulatorDivisor < 0.00001 )
-    {
-        *piValue = 0;
-        return FALSE;
-    }
-    else
-    {
-        *piValue = (GInt16)(0.5 + dfAccumulator / dfAccumulatorDivisor);
-        return TRUE;
-    }
-}
-
 /************************************************************************/
 /*                        GWKCubicResample()                            */
 /*     Set of bicubic interpolators using cubic convolution.            */
@@ -2093,9 +1959,10 @@ static int GWKCubicResample( GDALWarpKernel *poWK, int iBand,
     return TRUE;
 }
 
-static int GWKCubicResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
-                                        double dfSrcX, double dfSrcY,
-                                        GByte *pbValue )
+template<class T>
+static int GWKCubicResampleNoMasksT( GDALWarpKernel *poWK, int iBand,
+                                     double dfSrcX, double dfSrcY,
+                                     T *pValue )
 
 {
     int     iSrcX = (int) (dfSrcX - 0.5);
@@ -2109,81 +1976,29 @@ static int GWKCubicResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
     double  dfDeltaY3 = dfDeltaY2 * dfDeltaY;
     double  adfValue[4];
     int     i;
+    T      *pSrcBand = (T *) poWK->papabySrcImage[iBand];
 
     // Get the bilinear interpolation at the image borders
     if ( iSrcX - 1 < 0 || iSrcX + 2 >= poWK->nSrcXSize
          || iSrcY - 1 < 0 || iSrcY + 2 >= poWK->nSrcYSize )
-        return GWKBilinearResampleNoMasksByte( poWK, iBand, dfSrcX, dfSrcY,
-                                               pbValue);
+        return GWKBilinearResampleNoMasksT( poWK, iBand, dfSrcX, dfSrcY,
+                                            pValue );
 
     for ( i = -1; i < 3; i++ )
     {
         int     iOffset = iSrcOffset + i * poWK->nSrcXSize;
 
         adfValue[i + 1] = CubicConvolution(dfDeltaX, dfDeltaX2, dfDeltaX3,
-                            (double)poWK->papabySrcImage[iBand][iOffset - 1],
-                            (double)poWK->papabySrcImage[iBand][iOffset],
-                            (double)poWK->papabySrcImage[iBand][iOffset + 1],
-                            (double)poWK->papabySrcImage[iBand][iOffset + 2]);
+                                           (double)pSrcBand[iOffset - 1],
+                                           (double)pSrcBand[iOffset],
+                                           (double)pSrcBand[iOffset + 1],
+                                           (double)pSrcBand[iOffset + 2]);
     }
 
     double dfValue = CubicConvolution(dfDeltaY, dfDeltaY2, dfDeltaY3,
                         adfValue[0], adfValue[1], adfValue[2], adfValue[3]);
 
-    if ( dfValue < 0.0 )
-        *pbValue = 0;
-    else if ( dfValue > 255.0 )
-        *pbValue = 255;
-    else
-        *pbValue = (GByte)(0.5 + dfValue);
-    
-    return TRUE;
-}
-
-static int GWKCubicResampleNoMasksShort( GDALWarpKernel *poWK, int iBand,
-                                         double dfSrcX, double dfSrcY,
-                                         GInt16 *piValue )
-
-{
-    int     iSrcX = (int) (dfSrcX - 0.5);
-    int     iSrcY = (int) (dfSrcY - 0.5);
-    int     iSrcOffset = iSrcX + iSrcY * poWK->nSrcXSize;
-    double  dfDeltaX = dfSrcX - 0.5 - iSrcX;
-    double  dfDeltaY = dfSrcY - 0.5 - iSrcY;
-    double  dfDeltaX2 = dfDeltaX * dfDeltaX;
-    double  dfDeltaY2 = dfDeltaY * dfDeltaY;
-    double  dfDeltaX3 = dfDeltaX2 * dfDeltaX;
-    double  dfDeltaY3 = dfDeltaY2 * dfDeltaY;
-    double  adfValue[4];
-    int     i;
-
-    // Get the bilinear interpolation at the image borders
-    if ( iSrcX - 1 < 0 || iSrcX + 2 >= poWK->nSrcXSize
-         || iSrcY - 1 < 0 || iSrcY + 2 >= poWK->nSrcYSize )
-        return GWKBilinearResampleNoMasksShort( poWK, iBand, dfSrcX, dfSrcY,
-                                                piValue);
-
-    for ( i = -1; i < 3; i++ )
-    {
-        int     iOffset = iSrcOffset + i * poWK->nSrcXSize;
-
-        adfValue[i + 1] =CubicConvolution(dfDeltaX, dfDeltaX2, dfDeltaX3,
-                (double)((GInt16 *)poWK->papabySrcImage[iBand])[iOffset - 1],
-                (double)((GInt16 *)poWK->papabySrcImage[iBand])[iOffset],
-                (double)((GInt16 *)poWK->papabySrcImage[iBand])[iOffset + 1],
-                (double)((GInt16 *)poWK->papabySrcImage[iBand])[iOffset + 2]);
-    }
-
-    double dfValue = CubicConvolution(
-        dfDeltaY, dfDeltaY2, dfDeltaY3,
-        adfValue[0], adfValue[1], adfValue[2], adfValue[3]);
-    
-    if ( dfValue < -32768.0 )
-        *piValue = -32768;
-    else if ( dfValue > 32767.0 )
-        *piValue = 32767;
-    else
-        *piValue = (GInt16)floor(0.5 + dfValue);
+    *pValue = GWKClampValueT<T>( dfValue );
     
     return TRUE;
 }
@@ -2841,9 +2656,10 @@ static int GWKResampleOptimizedLanczos( GDALWarpKernel *poWK, int iBand,
     return TRUE;
 }
 
-static int GWKCubicSplineResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
-                                              double dfSrcX, double dfSrcY,
-                                              GByte *pbValue, double *padfBSpline )
+template<class T>
+static int GWKCubicSplineResampleNoMasksT( GDALWarpKernel *poWK, int iBand,
+                                           double dfSrcX, double dfSrcY,
+                                           T *pValue, double *padfBSpline )
 
 {
     // Commonly used; save locally
@@ -2851,6 +2667,7 @@ static int GWKCubicSplineResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
     int     nSrcYSize = poWK->nSrcYSize;
     
     double  dfAccumulator = 0.0;
+    double  dfAccumulatorWeight = 0.0;
     int     iSrcX = (int) floor( dfSrcX - 0.5 );
     int     iSrcY = (int) floor( dfSrcY - 0.5 );
     int     iSrcOffset = iSrcX + iSrcY * nSrcXSize;
@@ -2862,79 +2679,105 @@ static int GWKCubicSplineResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
     int     nXRadius = poWK->nXRadius;
     int     nYRadius = poWK->nYRadius;
 
-    GByte*  pabySrcBand = poWK->papabySrcImage[iBand];
-    
-    // Politely refusing to process invalid coordinates or obscenely small image
-    if ( iSrcX >= nSrcXSize || iSrcY >= nSrcYSize
-         || nXRadius > nSrcXSize || nYRadius > nSrcYSize )
-        return GWKBilinearResampleNoMasksByte( poWK, iBand, dfSrcX, dfSrcY, pbValue);
+    T      *pSrcBand = (T *) poWK->papabySrcImage[iBand];
+
+    // Skip sampling over edge of image, as GWKResample() does
+    int     i, j;
+    int     jMin = 1 - nYRadius, jMax = nYRadius;
+    int     iMin = 1 - nXRadius, iMax = nXRadius;
+
+    if( iSrcY + jMin < 0 )
+        jMin = -iSrcY;
+    if( iSrcY + jMax >= nSrcYSize )
+        jMax = nSrcYSize - iSrcY - 1;
+    if( iSrcX + iMin < 0 )
+        iMin = -iSrcX;
+    if( iSrcX + iMax >= nSrcXSize )
+        iMax = nSrcXSize - iSrcX - 1;
+
+    // Make a cached set of GWKBSpline values for the columns
+    for ( i = iMin; i <= iMax; ++i )
+    {
+        padfBSpline[i-iMin] = ( dfXScale < 1.0 ) ?
+            GWKBSpline((double)i * dfXScale) * dfXScale :
+            GWKBSpline(dfDeltaX - (double)i);
+    }
 
     // Loop over all rows in the kernel
-    int     j, jC;
-    for ( jC = 0, j = 1 - nYRadius; j <= nYRadius; ++j, ++jC )
+    for ( j = jMin; j <= jMax; ++j )
     {
-        int     iSampJ;
         // Calculate the Y weight
         double  dfWeight1 = ( dfYScale < 1.0 ) ?
             GWKBSpline((double)j * dfYScale) * dfYScale :
             GWKBSpline((double)j - dfDeltaY);
 
-        // Flip sampling over edge of image
-        if ( iSrcY + j < 0 )
-            iSampJ = iSrcOffset - (iSrcY + j) * nSrcXSize;
-        else if ( iSrcY + j >= nSrcYSize )
-            iSampJ = iSrcOffset + (2*nSrcYSize - 2*iSrcY - j - 1) * nSrcXSize;
-        else
-            iSampJ = iSrcOffset + j * nSrcXSize;
-        
+        T      *pSrcRow = pSrcBand + iSrcOffset + j * nSrcXSize;
+
         // Loop over all pixels in the row
-        int     i, iC;
-        for ( iC = 0, i = 1 - nXRadius; i <= nXRadius; ++i, ++iC )
+        for ( i = iMin; i <= iMax; ++i )
         {
-            int     iSampI;
-            double  dfWeight2;
-            
-            // Flip sampling over edge of image
-            if ( iSrcX + i < 0 )
-                iSampI = -iSrcX - i;
-            else if ( iSrcX + i >= nSrcXSize )
-                iSampI = 2*nSrcXSize - 2*iSrcX - i - 1;
-            else
-                iSampI = i;
-            
-            // Make a cached set of GWKBSpline values
-            if( jC == 0 )
-            {
-                // Calculate & save the X weight
-                dfWeight2 = padfBSpline[iC] = ((dfXScale < 1.0 ) ?
-                    GWKBSpline((double)i * dfXScale) * dfXScale :
-                    GWKBSpline(dfDeltaX - (double)i));
-                dfWeight2 *= dfWeight1;
-            }
-            else
-                dfWeight2 = dfWeight1 * padfBSpline[iC];
+            double  dfWeight2 = dfWeight1 * padfBSpline[i-iMin];
 
             // Retrieve the pixel & accumulate
-            dfAccumulator += (double)pabySrcBand[iSampI+iSampJ] * dfWeight2;
+            dfAccumulator += (double)pSrcRow[i] * dfWeight2;
+            dfAccumulatorWeight += dfWeight2;
         }
     }
 
-    if ( dfAccumulator < 0.0 )
-        *pbValue = 0;
-    else if ( dfAccumulator > 255.0 )
-        *pbValue = 255;
-    else
-        *pbValue = (GByte)(0.5 + dfAccumulator);
+    if ( dfAccumulatorWeight < 0.000001 )
+    {
+        *pValue = 0;
+        return FALSE;
+    }
+
+    // Calculate the output taking into account weighting
+    if ( dfAccumulatorWeight < 0.99999 || dfAccumulatorWeight > 1.00001 )
+        dfAccumulator /= dfAccumulatorWeight;
+
+    *pValue = GWKClampValueT<T>( dfAccumulator );
      
     return TRUE;
 }
 
-static int GWKCubicSplineResampleNoMasksShort( GDALWarpKernel *poWK, int iBand,
-                                               double dfSrcX, double dfSrcY,
-                                               GInt16 *piValue, double *padfBSpline )
-
-{
-    //Save src size to local var
+/************************************************************************/
+/*                     GWKCubicSplineMirrorsEdges()                     */
+/*                                                                      */
+/*      The Byte and Int16 cubic spline kernels without any mask have   */
+/*      always flipped the sampling over the edges of the source       */
+/*      image, instead of skipping it and renormalizing the weights     */
+/*      like GWKResample().  Keep doing so, so that their results do    */
+/*      not change.                                                     */
+/************************************************************************/
+
+static int GWKCubicSplineMirrorsEdges( const GDALWarpKernel *poWK )
+
+{
+    return poWK->eResample == GRA_CubicSpline
+        && (poWK->eWorkingDataType == GDT_Byte
+            || poWK->eWorkingDataType == GDT_Int16)
+        && poWK->papanBandSrcValid == NULL
+        && poWK->panUnifiedSrcValid == NULL
+        && poWK->pafUnifiedSrcDensity == NULL
+        && poWK->panDstValid == NULL
+        && poWK->pafDstDensity == NULL;
+}
+
+/************************************************************************/
+/*                GWKCubicSplineResampleNoMasksMirrorT()                */
+/*                                                                      */
+/*      Cubic spline resampling flipping the sampling over the edges,   */
+/*      for the cases selected by GWKCubicSplineMirrorsEdges().         */
+/************************************************************************/
+
+template<class T>
+static int GWKCubicSplineResampleNoMasksMirrorT( GDALWarpKernel *poWK,
+                                                 int iBand,
+                                                 double dfSrcX, double dfSrcY,
+                                                 T *pValue,
+                                                 double *padfBSpline )
+
+{
+    // Commonly used; save locally
     int     nSrcXSize = poWK->nSrcXSize;
     int     nSrcYSize = poWK->nSrcYSize;
     
@@ -2950,20 +2793,19 @@ static int GWKCubicSplineResampleNoMasksShort( GDALWarpKernel *poWK, int iBand,
     int     nXRadius = poWK->nXRadius;
     int     nYRadius = poWK->nYRadius;
 
-    // Save band array pointer to local var; cast here instead of later
-    GInt16* pabySrcBand = ((GInt16 *)poWK->papabySrcImage[iBand]);
-
+    T      *pSrcBand = (T *) poWK->papabySrcImage[iBand];
+    
     // Politely refusing to process invalid coordinates or obscenely small image
     if ( iSrcX >= nSrcXSize || iSrcY >= nSrcYSize
          || nXRadius > nSrcXSize || nYRadius > nSrcYSize )
-        return GWKBilinearResampleNoMasksShort( poWK, iBand, dfSrcX, dfSrcY, piValue);
+        return GWKBilinearResampleNoMasksT( poWK, iBand, dfSrcX, dfSrcY,
+                                            pValue );
 
-    // Loop over all pixels in the kernel
+    // Loop over all rows in the kernel
     int     j, jC;
     for ( jC = 0, j = 1 - nYRadius; j <= nYRadius; ++j, ++jC )
     {
         int     iSampJ;
-        
         // Calculate the Y weight
         double  dfWeight1 = ( dfYScale < 1.0 ) ?
             GWKBSpline((double)j * dfYScale) * dfYScale :
@@ -2977,38 +2819,40 @@ static int GWKCubicSplineResampleNoMasksShort( GDALWarpKernel *poWK, int iBand,
         else
             iSampJ = iSrcOffset + j * nSrcXSize;
         
-        // Loop over all pixels in row
+        // Loop over all pixels in the row
         int     i, iC;
         for ( iC = 0, i = 1 - nXRadius; i <= nXRadius; ++i, ++iC )
         {
-        int     iSampI;
+            int     iSampI;
             double  dfWeight2;
             
             // Flip sampling over edge of image
             if ( iSrcX + i < 0 )
                 iSampI = -iSrcX - i;
-            else if(iSrcX + i >= nSrcXSize)
+            else if ( iSrcX + i >= nSrcXSize )
                 iSampI = 2*nSrcXSize - 2*iSrcX - i - 1;
             else
                 iSampI = i;
             
             // Make a cached set of GWKBSpline values
-            if ( jC == 0 )
+            if( jC == 0 )
             {
                 // Calculate & save the X weight
                 dfWeight2 = padfBSpline[iC] = ((dfXScale < 1.0 ) ?
                     GWKBSpline((double)i * dfXScale) * dfXScale :
                     GWKBSpline(dfDeltaX - (double)i));
                 dfWeight2 *= dfWeight1;
-            } else
+            }
+            else
                 dfWeight2 = dfWeight1 * padfBSpline[iC];
 
-            dfAccumulator += (double)pabySrcBand[iSampI + iSampJ] * dfWeight2;
+            // Retrieve the pixel & accumulate
+            dfAccumulator += (double)pSrcBand[iSampI+iSampJ] * dfWeight2;
         }
     }
 
-    *piValue = (GInt16)(0.5 + dfAccumulator);
-    
+    *pValue = GWKClampValueT<T>( dfAccumulator );
+     
     return TRUE;
 }
 
@@ -3556,88 +3400,523 @@ static void GWKGeneralCaseThread( void* pData)
 }
 
 /************************************************************************/
-/*                       GWKNearestNoMasksByte()                        */
+/*                         GWKSeparableCase()                           */
+/*                                                                      */
+/*      Cubic spline and lanczos resampling when the transformation    */
+/*      is a scaling and offset along each axis.  The 2D kernel is      */
+/*      then applied as a horizontal pass over the source rows,         */
+/*      followed by a vertical pass, with weights computed once per     */
+/*      destination column and row instead of once per pixel.  The      */
+/*      result is the one of GWKResample() and                          */
+/*      GWKResampleOptimizedLanczos(), up to rounding errors, or of     */
+/*      GWKCubicSplineResampleNoMasksMirrorT() in the cases selected    */
+/*      by GWKCubicSplineMirrorsEdges().                                */
+/************************************************************************/
+
+typedef struct
+{
+    int      nTaps;       /* number of source pixels in the kernel */
+    int      nMaxTaps;
+    int     *panCenter;   /* source pixel of the destination pixel, or -1 */
+    int     *panFirst;    /* first source pixel of the kernel */
+    int     *panTaps;
+    double  *padfWeights; /* nMaxTaps weights per destination pixel */
+    double  *padfWeightSum;
+} GWKSeparableAxis;
+
+/************************************************************************/
+/*                        GWKSeparableMirrorTap()                       */
+/*                                                                      */
+/*      Source pixel sampled by the tap k of a kernel starting from    */
+/*      iSrc, flipped over the edges of the image as                    */
+/*      GWKCubicSplineResampleNoMasksMirrorT() does.                    */
+/************************************************************************/
+
+static int GWKSeparableMirrorTap( int iSrc, int k, int nSrcSize )
+
+{
+    if( iSrc + k < 0 )
+        return -k;
+    else if( iSrc + k >= nSrcSize )
+        return 2 * nSrcSize - iSrc - k - 1;
+    else
+        return iSrc + k;
+}
+
+/************************************************************************/
+/*                      GWKSeparableComputeAxis()                       */
 /*                                                                      */
-/*      Case for 8bit input data with nearest neighbour resampling      */
-/*      without concerning about masking. Should be as fast as          */
-/*      possible for this particular transformation type.               */
+/*      With bMirrorEdges, the taps flipped over the edges of the       */
+/*      source image have their weight added to the tap they are       */
+/*      flipped onto, and the weights are not renormalized.             */
+/************************************************************************/
+
+static void GWKSeparableComputeAxis( GDALWarpKernel *poWK,
+                                     GWKSeparableAxis *psAxis, int nCount,
+                                     const double *padfSrc, const int *pabSuccess,
+                                     int nSrcOff, int nSrcSize,
+                                     double dfScale, int nFiltInit, int nRadius,
+                                     double dfFilter, int bMirrorEdges )
+
+{
+    int i, k;
+
+    psAxis->nMaxTaps = nRadius - nFiltInit + 1;
+    psAxis->panCenter = (int *) CPLMalloc(sizeof(int) * nCount);
+    psAxis->panFirst = (int *) CPLMalloc(sizeof(int) * nCount);
+    psAxis->panTaps = (int *) CPLMalloc(sizeof(int) * nCount);
+    psAxis->padfWeights = (double *)
+        CPLMalloc(sizeof(double) * nCount * psAxis->nMaxTaps);
+    psAxis->padfWeightSum = (double *) CPLMalloc(sizeof(double) * nCount);
+
+    for( i = 0; i < nCount; i++ )
+    {
+        psAxis->panCenter[i] = -1;
+        psAxis->panTaps[i] = 0;
+        psAxis->padfWeightSum[i] = 0.0;
+
+/* -------------------------------------------------------------------- */
+/*      Same tests as COMPUTE_iSrcOffset.                               */
+/* -------------------------------------------------------------------- */
+        if( !pabSuccess[i] || padfSrc[i] < nSrcOff )
+            continue;
+
+        int iCenter = ((int) (padfSrc[i] + 1e-10)) - nSrcOff;
+        if( iCenter < 0 || iCenter >= nSrcSize )
+            continue;
+
+/* -------------------------------------------------------------------- */
+/*      Kernel extent, as in GWKResample().                             */
+/* -------------------------------------------------------------------- */
+        const double dfSrc = padfSrc[i] - nSrcOff;
+        const int    iSrc = (int) floor( dfSrc - 0.5 );
+        const double dfDelta = dfSrc - 0.5 - iSrc;
+        int iMin = nFiltInit, iMax = nRadius;
+
+        if( bMirrorEdges )
+        {
+            /* As in GWKCubicSplineResampleNoMasksMirrorT() */
+            int iFirst = nSrcSize, iLast = -1;
+            for( k = nFiltInit; k <= nRadius; k++ )
+            {
+                int iTap = GWKSeparableMirrorTap( iSrc, k, nSrcSize );
+                iFirst = MIN( iFirst, iTap );
+                iLast = MAX( iLast, iTap );
+            }
+
+            double *padfWeights = psAxis->padfWeights + i * psAxis->nMaxTaps;
+            for( k = 0; k < iLast - iFirst + 1; k++ )
+                padfWeights[k] = 0.0;
+
+            for( k = nFiltInit; k <= nRadius; k++ )
+            {
+                padfWeights[GWKSeparableMirrorTap( iSrc, k, nSrcSize ) - iFirst]
+                    += ( dfScale < 1.0 ) ?
+                        GWKBSpline(((double)k) * dfScale) * dfScale :
+                        GWKBSpline(dfDelta - (double)k);
+            }
+
+            psAxis->panCenter[i] = iCenter;
+            psAxis->panFirst[i] = iFirst;
+            psAxis->panTaps[i] = iLast - iFirst + 1;
+            psAxis->padfWeightSum[i] = 1.0;
+            continue;
+        }
+
+        if( iSrc + iMin < 0 )
+            iMin = -iSrc;
+        if( iSrc + iMax >= nSrcSize )
+            iMax = nSrcSize - iSrc - 1;
+
+        if( poWK->eResample == GRA_Lanczos )
+        {
+            /* As in GWKResampleOptimizedLanczos() */
+            if( dfScale < 1.0 )
+            {
+                while( iMin * dfScale < -3.0 )
+                    iMin ++;
+                while( iMax * dfScale > 3.0 )
+                    iMax --;
+            }
+            else
+            {
+                while( iMin - dfDelta < -3.0 )
+                    iMin ++;
+                while( iMax - dfDelta > 3.0 )
+                    iMax --;
+            }
+        }
+
+        psAxis->panCenter[i] = iCenter;
+        psAxis->panFirst[i] = iSrc + iMin;
+        psAxis->panTaps[i] = MAX(0, iMax - iMin + 1);
+
+        double *padfWeights = psAxis->padfWeights + i * psAxis->nMaxTaps;
+        double  dfWeightSum = 0.0;
+        for( k = iMin; k <= iMax; k++ )
+        {
+            double dfWeight;
+
+            if( poWK->eResample == GRA_CubicSpline )
+                dfWeight = ( dfScale < 1.0 ) ?
+                    GWKBSpline(((double)k) * dfScale) * dfScale :
+                    GWKBSpline(dfDelta - (double)k);
+            else if( dfScale < 1.0 )
+                dfWeight = GWKLanczosSinc(k * dfScale, dfFilter) * dfScale;
+            else
+                dfWeight = GWKLanczosSinc(k - dfDelta, dfFilter);
+
+            padfWeights[k - iMin] = dfWeight;
+            dfWeightSum += dfWeight;
+        }
+        psAxis->padfWeightSum[i] = dfWeightSum;
+    }
+}
+
 /************************************************************************/
+/*                        GWKSeparableFreeAxis()                        */
+/************************************************************************/
+
+static void GWKSeparableFreeAxis( GWKSeparableAxis *psAxis )
+
+{
+    CPLFree( psAxis->panCenter );
+    CPLFree( psAxis->panFirst );
+    CPLFree( psAxis->panTaps );
+    CPLFree( psAxis->padfWeights );
+    CPLFree( psAxis->padfWeightSum );
+}
 
-static void GWKNearestNoMasksByteThread(void* pData);
+static void GWKSeparableCaseThread(void* pData);
 
-static CPLErr GWKNearestNoMasksByte( GDALWarpKernel *poWK )
+static CPLErr GWKSeparableCase( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKNearestNoMasksByte", GWKNearestNoMasksByteThread );
+    return GWKRun( poWK, "GWKSeparableCase", GWKSeparableCaseThread );
 }
 
-static void GWKNearestNoMasksByteThread(void* pData)
+static void GWKSeparableCaseThread( void* pData )
+
 {
     GWKJobStruct* psJob = (GWKJobStruct*) pData;
     GDALWarpKernel *poWK = psJob->poWK;
     int iYMin = psJob->iYMin;
     int iYMax = psJob->iYMax;
-
-    int iDstY;
     int nDstXSize = poWK->nDstXSize;
+    int nDstYCount = iYMax - iYMin;
     int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
+    int nBands = poWK->nBands;
+    int iDstX, iDstY, iBand, i, k;
+
+    if( nDstYCount <= 0 )
+        return;
 
 /* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
+/*      Source column of each destination column, from the              */
+/*      transformation of the first destination line.                   */
 /* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
+    int     nMaxPoints = MAX(nDstXSize, 1);
+    double *padfX = (double *) CPLMalloc(sizeof(double) * nMaxPoints);
+    double *padfY = (double *) CPLMalloc(sizeof(double) * nMaxPoints);
+    double *padfZ = (double *) CPLMalloc(sizeof(double) * nMaxPoints);
+    int    *pabSuccess = (int *) CPLMalloc(sizeof(int) * nMaxPoints);
 
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+    for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+    {
+        padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
+        padfY[iDstX] = iYMin + 0.5 + poWK->nDstYOff;
+        padfZ[iDstX] = 0.0;
+    }
+    poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
+                          padfX, padfY, padfZ, pabSuccess );
+
+    GWKSeparableAxis sCols;
+    const int bMirrorEdges = GWKCubicSplineMirrorsEdges( poWK );
+
+    GWKSeparableComputeAxis( poWK, &sCols, nDstXSize, padfX, pabSuccess,
+                             poWK->nSrcXOff, nSrcXSize, poWK->dfXScale,
+                             poWK->nFiltInitX, poWK->nXRadius,
+                             poWK->dfXFilter, bMirrorEdges );
+
+/* -------------------------------------------------------------------- */
+/*      Source line of each destination line.  The points are           */
+/*      transformed one at a time, as the first point of each line      */
+/*      would be by the general case.                                   */
+/* -------------------------------------------------------------------- */
+    double *padfSrcY = (double *) CPLMalloc(sizeof(double) * nDstYCount);
+    int    *pabSuccessY = (int *) CPLMalloc(sizeof(int) * nDstYCount);
+
+    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
+    {
+        double dfX = 0.5 + poWK->nDstXOff;
+        double dfY = iDstY + 0.5 + poWK->nDstYOff;
+        double dfZ = 0.0;
+
+        pabSuccessY[iDstY - iYMin] = FALSE;
+        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, 1,
+                              &dfX, &dfY, &dfZ, pabSuccessY + iDstY - iYMin );
+        padfSrcY[iDstY - iYMin] = dfY;
+    }
+
+    GWKSeparableAxis sRows;
+    GWKSeparableComputeAxis( poWK, &sRows, nDstYCount, padfSrcY, pabSuccessY,
+                             poWK->nSrcYOff, nSrcYSize, poWK->dfYScale,
+                             poWK->nFiltInitY, poWK->nYRadius,
+                             poWK->dfYFilter, bMirrorEdges );
+
+    CPLFree( padfX );
+    CPLFree( padfY );
+    CPLFree( padfZ );
+    CPLFree( pabSuccess );
+    CPLFree( padfSrcY );
+    CPLFree( pabSuccessY );
+
+/* -------------------------------------------------------------------- */
+/*      Setup the cache of horizontally filtered source lines.  The     */
+/*      lines needed by a destination line are consecutive, so a ring   */
+/*      of nMaxTaps lines per band is enough to hold them.  With        */
+/*      validity masks, the sum of the weights of the valid pixels is   */
+/*      also kept.                                                      */
+/* -------------------------------------------------------------------- */
+    const int bComplex = GDALDataTypeIsComplex( poWK->eWorkingDataType );
+    const int bHasValidity = poWK->panUnifiedSrcValid != NULL
+        || poWK->papanBandSrcValid != NULL;
+    const int bHasRowDensity = bHasValidity
+        || poWK->pafUnifiedSrcDensity != NULL;
+    const int nRing = sRows.nMaxTaps;
+    const int nWordSize = GDALGetDataTypeSize(poWK->eWorkingDataType) / 8;
+
+    int    *panRingLine = (int *) CPLMalloc(sizeof(int) * nRing * nBands);
+    double *padfRingReal = (double *)
+        CPLMalloc(sizeof(double) * nRing * nBands * nDstXSize);
+    double *padfRingImag = bComplex ? (double *)
+        CPLMalloc(sizeof(double) * nRing * nBands * nDstXSize) : NULL;
+    double *padfRingWeight = bHasValidity ? (double *)
+        CPLMalloc(sizeof(double) * nRing * nBands * nDstXSize) : NULL;
+
+    double *padfLineReal = (double *) CPLMalloc(sizeof(double) * nSrcXSize);
+    double *padfLineImag = bComplex ? (double *)
+        CPLMalloc(sizeof(double) * nSrcXSize * 2) : NULL;
+    GByte  *pabyLineValid = bHasValidity ? (GByte *)
+        CPLMalloc(nSrcXSize) : NULL;
+
+    for( i = 0; i < nRing * nBands; i++ )
+        panRingLine[i] = -1;
 
 /* ==================================================================== */
 /*      Loop over output lines.                                         */
 /* ==================================================================== */
     for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
     {
-        int iDstX;
+        const int iRow = iDstY - iYMin;
 
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+        if( sRows.panCenter[iRow] < 0 )
         {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
+            if (psJob->pfnProgress(psJob))
+                break;
+            continue;
         }
 
+        const int iFirstLine = sRows.panFirst[iRow];
+        const int nLines = sRows.panTaps[iRow];
+        const double *padfWeightsY = sRows.padfWeights + iRow * sRows.nMaxTaps;
+
 /* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
+/*      Horizontal pass on the source lines not yet in the cache.       */
 /* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
+        for( iBand = 0; iBand < nBands; iBand++ )
+        {
+            for( k = 0; k < nLines; k++ )
+            {
+                const int iLine = iFirstLine + k;
+                const int iSlot = iBand * nRing + iLine % nRing;
+
+                if( panRingLine[iSlot] == iLine )
+                    continue;
+                panRingLine[iSlot] = iLine;
+
+                const GByte *pabySrc = poWK->papabySrcImage[iBand]
+                    + iLine * (GIntBig) nSrcXSize * nWordSize;
+
+                if( bComplex )
+                {
+                    GDALCopyWords( (void *) pabySrc, poWK->eWorkingDataType,
+                                   nWordSize, padfLineImag, GDT_CFloat64, 16,
+                                   nSrcXSize );
+                    for( i = 0; i < nSrcXSize; i++ )
+                    {
+                        padfLineReal[i] = padfLineImag[2 * i];
+                        padfLineImag[i] = padfLineImag[2 * i + 1];
+                    }
+                }
+                else
+                    GDALCopyWords( (void *) pabySrc, poWK->eWorkingDataType,
+                                   nWordSize, padfLineReal, GDT_Float64, 8,
+                                   nSrcXSize );
+
+                if( bHasValidity )
+                {
+                    GUInt32 *panBandValid = poWK->papanBandSrcValid != NULL ?
+                        poWK->papanBandSrcValid[iBand] : NULL;
+                    const int iLineOffset = iLine * nSrcXSize;
+
+                    for( i = 0; i < nSrcXSize; i++ )
+                    {
+                        const int iOffset = iLineOffset + i;
+                        pabyLineValid[i] =
+                            (poWK->panUnifiedSrcValid == NULL
+                             || (poWK->panUnifiedSrcValid[iOffset>>5]
+                                 & (0x01 << (iOffset & 0x1f))))
+                            && (panBandValid == NULL
+                                || (panBandValid[iOffset>>5]
+                                    & (0x01 << (iOffset & 0x1f))));
+                    }
+                }
+
+                double *padfReal = padfRingReal + iSlot * nDstXSize;
+                double *padfImag = bComplex ?
+                    padfRingImag + iSlot * nDstXSize : NULL;
+                double *padfWeight = bHasValidity ?
+                    padfRingWeight + iSlot * nDstXSize : NULL;
+
+                for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+                {
+                    if( sCols.panCenter[iDstX] < 0 )
+                        continue;
+
+                    const int     iFirst = sCols.panFirst[iDstX];
+                    const int     nTaps = sCols.panTaps[iDstX];
+                    const double *padfW =
+                        sCols.padfWeights + iDstX * sCols.nMaxTaps;
+                    const double *padfV = padfLineReal + iFirst;
+                    double dfReal = 0.0, dfImag = 0.0, dfWeight = 0.0;
+
+                    if( bHasValidity )
+                    {
+                        const GByte *pabyValid = pabyLineValid + iFirst;
+                        for( i = 0; i < nTaps; i++ )
+                        {
+                            if( !pabyValid[i] )
+                                continue;
+                            dfReal += padfV[i] * padfW[i];
+                            if( bComplex )
+                                dfImag += padfLineImag[iFirst + i] * padfW[i];
+                            dfWeight += padfW[i];
+                        }
+                        padfWeight[iDstX] = dfWeight;
+                    }
+                    else
+                    {
+                        /* Contiguous weights and values: vectorizable */
+                        for( i = 0; i < nTaps; i++ )
+                            dfReal += padfV[i] * padfW[i];
+                        if( bComplex )
+                        {
+                            const double *padfVI = padfLineImag + iFirst;
+                            for( i = 0; i < nTaps; i++ )
+                                dfImag += padfVI[i] * padfW[i];
+                        }
+                    }
+
+                    padfReal[iDstX] = dfReal;
+                    if( bComplex )
+                        padfImag[iDstX] = dfImag;
+                }
+            }
+        }
 
 /* ==================================================================== */
 /*      Loop over pixels in output scanline.                            */
 /* ==================================================================== */
         for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
+            if( sCols.panCenter[iDstX] < 0 )
+                continue;
 
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            int iDstOffset;
+            const int iSrcOffset = sCols.panCenter[iDstX]
+                + sRows.panCenter[iRow] * nSrcXSize;
 
-            iDstOffset = iDstX + iDstY * nDstXSize;
+/* -------------------------------------------------------------------- */
+/*      Do not try to apply transparent/invalid source pixels to the    */
+/*      destination, as in the general case.                            */
+/* -------------------------------------------------------------------- */
+            double  dfDensity = 1.0;
 
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
+            if( poWK->pafUnifiedSrcDensity != NULL )
             {
-                poWK->papabyDstImage[iBand][iDstOffset] = 
-                    poWK->papabySrcImage[iBand][iSrcOffset];
+                dfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
+                if( dfDensity < 0.00001 )
+                    continue;
             }
-        }
+
+            if( poWK->panUnifiedSrcValid != NULL
+                && !(poWK->panUnifiedSrcValid[iSrcOffset>>5]
+                     & (0x01 << (iSrcOffset & 0x1f))) )
+                continue;
+
+/* -------------------------------------------------------------------- */
+/*      Vertical pass, and weighting as in GWKResample().               */
+/* -------------------------------------------------------------------- */
+            int bHasFoundDensity = FALSE;
+            const int iDstOffset = iDstX + iDstY * nDstXSize;
+
+            for( iBand = 0; iBand < nBands; iBand++ )
+            {
+                double dfReal = 0.0, dfImag = 0.0, dfWeight = 0.0;
+                double dfBandDensity;
+
+                for( k = 0; k < nLines; k++ )
+                {
+                    const int iSlot =
+                        iBand * nRing + (iFirstLine + k) % nRing;
+                    const int iIndex = iSlot * nDstXSize + iDstX;
+
+                    dfReal += padfRingReal[iIndex] * padfWeightsY[k];
+                    if( bComplex )
+                        dfImag += padfRingImag[iIndex] * padfWeightsY[k];
+                    if( bHasValidity )
+                        dfWeight += padfRingWeight[iIndex] * padfWeightsY[k];
+                }
+
+                if( !bHasValidity )
+                    dfWeight = sCols.padfWeightSum[iDstX]
+                        * sRows.padfWeightSum[iRow];
+
+                /* Densities of the valid pixels are all 1 */
+                if( dfWeight < 0.000001 )
+                    continue;
+
+                if( dfWeight < 0.99999 || dfWeight > 1.00001 )
+                {
+                    dfReal /= dfWeight;
+                    dfImag /= dfWeight;
+                    dfBandDensity = 1.0;
+                }
+                else
+                    dfBandDensity = bHasRowDensity ? dfWeight : 1.0;
+
+                if ( dfBandDensity < 0.0000000001 )
+                    continue;
+
+                bHasFoundDensity = TRUE;
+
+                GWKSetPixelValue( poWK, iBand, iDstOffset,
+                                  dfBandDensity, dfReal, dfImag );
+            }
+
+            if (!bHasFoundDensity)
+              continue;
+
+/* -------------------------------------------------------------------- */
+/*      Update destination density/validity masks.                      */
+/* -------------------------------------------------------------------- */
+            GWKOverlayDensity( poWK, iDstOffset, dfDensity );
+
+            if( poWK->panDstValid != NULL )
+            {
+                poWK->panDstValid[iDstOffset>>5] |= 
+                    0x01 << (iDstOffset & 0x1f);
+            }
+        } /* Next iDstX */
 
 /* -------------------------------------------------------------------- */
 /*      Report progress to the user, and optionally cancel out.         */
@@ -3649,28 +3928,30 @@ static void GWKNearestNoMasksByteThread(void* pData)
 /* -------------------------------------------------------------------- */
 /*      Cleanup and return.                                             */
 /* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
+    GWKSeparableFreeAxis( &sCols );
+    GWKSeparableFreeAxis( &sRows );
+    CPLFree( panRingLine );
+    CPLFree( padfRingReal );
+    CPLFree( padfRingImag );
+    CPLFree( padfRingWeight );
+    CPLFree( padfLineReal );
+    CPLFree( padfLineImag );
+    CPLFree( pabyLineValid );
 }
 
 /************************************************************************/
-/*                       GWKBilinearNoMasksByte()                       */
+/*                       GWKNearestNoMasksThread()                      */
 /*                                                                      */
-/*      Case for 8bit input data with bilinear resampling without       */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
+/*      Case for nearest neighbour resampling of any non complex        */
+/*      working data type without source validity or density masks.     */
+/*      Destination masks, if any, are simply marked as valid/opaque.   */
+/*      Should be as fast as possible for this particular               */
+/*      transformation type.                                            */
 /************************************************************************/
 
-static void GWKBilinearNoMasksByteThread(void* pData);
-
-static CPLErr GWKBilinearNoMasksByte( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKBilinearNoMasksByte", GWKBilinearNoMasksByteThread );
-}
+template<class T>
+static void GWKNearestNoMasksThread( void* pData )
 
-static void GWKBilinearNoMasksByteThread(void* pData)
 {
     GWKJobStruct* psJob = (GWKJobStruct*) pData;
     GDALWarpKernel *poWK = psJob->poWK;
@@ -3734,10 +4015,20 @@ static void GWKBilinearNoMasksByteThread(void* pData)
 
             for( iBand = 0; iBand < poWK->nBands; iBand++ )
             {
-                GWKBilinearResampleNoMasksByte( poWK, iBand,
-                                                padfX[iDstX]-poWK->nSrcXOff,
-                                                padfY[iDstX]-poWK->nSrcYOff,
-                                                &poWK->papabyDstImage[iBand][iDstOffset] );
+                ((T *) poWK->papabyDstImage[iBand])[iDstOffset] = 
+                    ((T *) poWK->papabySrcImage[iBand])[iSrcOffset];
+            }
+
+/* -------------------------------------------------------------------- */
+/*      Mark this pixel valid/opaque in the output.                     */
+/* -------------------------------------------------------------------- */
+            if( poWK->pafDstDensity != NULL )
+                poWK->pafDstDensity[iDstOffset] = 1.0f;
+
+            if( poWK->panDstValid != NULL )
+            {
+                poWK->panDstValid[iDstOffset>>5] |= 
+                    0x01 << (iDstOffset & 0x1f);
             }
         }
 
@@ -3757,125 +4048,340 @@ static void GWKBilinearNoMasksByteThread(void* pData)
     CPLFree( pabSuccess );
 }
 
+#if defined(GWK_USE_SSE2) || defined(HAVE_AVX2_AT_COMPILE_TIME)
+
 /************************************************************************/
-/*                       GWKCubicNoMasksByte()                          */
+/*                    GWKResampleNoMasksPrepare()                       */
 /*                                                                      */
-/*      Case for 8bit input data with cubic resampling without          */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
+/*      Check that the whole bilinear or cubic kernel of nPixels        */
+/*      consecutive destination pixels is inside the source window,     */
+/*      and compute their source offsets and fractional positions as    */
+/*      GWKBilinearResampleNoMasksT() and GWKCubicResampleNoMasksT()    */
+/*      do.  Returns FALSE if one of them needs the border handling     */
+/*      of the scalar code.                                             */
 /************************************************************************/
 
-static void GWKCubicNoMasksByteThread(void* pData);
+template<GDALResampleAlg eResample>
+static CPL_INLINE int GWKResampleNoMasksPrepare( GDALWarpKernel *poWK,
+                                                 int nPixels,
+                                                 const double *padfX,
+                                                 const double *padfY,
+                                                 const int *pabSuccess,
+                                                 int *panSrcOffset,
+                                                 double *padfWeightX,
+                                                 double *padfWeightY )
 
-static CPLErr GWKCubicNoMasksByte( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKCubicNoMasksByte", GWKCubicNoMasksByteThread );
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+    int     k;
+
+    for( k = 0; k < nPixels; k++ )
+    {
+        double dfSrcX = padfX[k] - poWK->nSrcXOff;
+        double dfSrcY = padfY[k] - poWK->nSrcYOff;
+        int    iSrcX, iSrcY;
+
+        if( !pabSuccess[k]
+            || !(dfSrcX >= 0.0 && dfSrcX < nSrcXSize
+                 && dfSrcY >= 0.0 && dfSrcY < nSrcYSize) )
+            return FALSE;
+
+        if( eResample == GRA_Bilinear )
+        {
+            iSrcX = (int) floor(dfSrcX - 0.5);
+            iSrcY = (int) floor(dfSrcY - 0.5);
+            if( iSrcX < 0 || iSrcX + 1 >= nSrcXSize
+                || iSrcY < 0 || iSrcY + 1 >= nSrcYSize )
+                return FALSE;
+            padfWeightX[k] = 1.5 - (dfSrcX - iSrcX);
+            padfWeightY[k] = 1.5 - (dfSrcY - iSrcY);
+        }
+        else
+        {
+            iSrcX = (int) (dfSrcX - 0.5);
+            iSrcY = (int) (dfSrcY - 0.5);
+            if( iSrcX - 1 < 0 || iSrcX + 2 >= nSrcXSize
+                || iSrcY - 1 < 0 || iSrcY + 2 >= nSrcYSize )
+                return FALSE;
+            padfWeightX[k] = dfSrcX - 0.5 - iSrcX;
+            padfWeightY[k] = dfSrcY - 0.5 - iSrcY;
+        }
+        panSrcOffset[k] = iSrcX + iSrcY * nSrcXSize;
+    }
+
+    return TRUE;
 }
 
-static void GWKCubicNoMasksByteThread( void* pData )
+/************************************************************************/
+/*                   GWKResampleNoMasksMarkValid()                      */
+/*                                                                      */
+/*      Mark nPixels consecutive pixels valid/opaque in the output.     */
+/************************************************************************/
+
+static CPL_INLINE void GWKResampleNoMasksMarkValid( GDALWarpKernel *poWK,
+                                                    int iDstOffset,
+                                                    int nPixels )
 
 {
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
+    int     k;
 
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
+    for( k = 0; k < nPixels; k++ )
+    {
+        if( poWK->pafDstDensity != NULL )
+            poWK->pafDstDensity[iDstOffset + k] = 1.0f;
 
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
+        if( poWK->panDstValid != NULL )
+        {
+            poWK->panDstValid[(iDstOffset + k)>>5] |= 
+                0x01 << ((iDstOffset + k) & 0x1f);
+        }
+    }
+}
 
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+#endif /* defined(GWK_USE_SSE2) || defined(HAVE_AVX2_AT_COMPILE_TIME) */
 
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+
+/************************************************************************/
+/*                     GWKResampleNoMasks8AVX2()                        */
+/*                                                                      */
+/*      Bilinear or cubic resampling of 8 consecutive destination       */
+/*      pixels.  The interpolation is done by pfnAVX2, compiled with    */
+/*      AVX2 code generation in gdalwarpkernelavx2.cpp, into            */
+/*      padfValue (8 values per band).  Returns FALSE, without writing  */
+/*      anything, if one of the pixels needs the border handling of     */
+/*      the scalar code.                                                */
+/************************************************************************/
+
+template<class T, GDALResampleAlg eResample>
+static int GWKResampleNoMasks8AVX2( GDALWarpKernel *poWK,
+                                    GWKResampleNoMasks8Func pfnAVX2,
+                                    double *padfValue,
+                                    const double *padfX, const double *padfY,
+                                    const int *pabSuccess, int iDstOffset )
+
+{
+    int     anSrcOffset[8];
+    double  adfWeightX[8], adfWeightY[8];
+
+    if( !GWKResampleNoMasksPrepare<eResample>( poWK, 8, padfX, padfY,
+                                               pabSuccess, anSrcOffset,
+                                               adfWeightX, adfWeightY ) )
+        return FALSE;
+
+    pfnAVX2( poWK->nBands, poWK->papabySrcImage, poWK->nSrcXSize,
+             anSrcOffset, adfWeightX, adfWeightY, padfValue );
+
+    int     iBand, k;
+
+    for( iBand = 0; iBand < poWK->nBands; iBand++ )
     {
-        int iDstX;
+        T       *pDst = ((T *) poWK->papabyDstImage[iBand]) + iDstOffset;
+
+        for( k = 0; k < 8; k++ )
+        {
+            T value = GWKClampValueT<T>( padfValue[iBand * 8 + k] );
+
+            if( poWK->padfDstNoDataReal != NULL )
+                GWKAvoidNoDataT( poWK, iBand, &value );
+
+            pDst[k] = value;
+        }
+    }
+
+    GWKResampleNoMasksMarkValid( poWK, iDstOffset, 8 );
+
+    return TRUE;
+}
+
+#endif /* def HAVE_AVX2_AT_COMPILE_TIME */
+
+#ifdef GWK_USE_SSE2
+
+/************************************************************************/
+/*                      GWKCubicConvolutionSSE2()                       */
+/*                                                                      */
+/*      Two lanes version of the CubicConvolution() macro, evaluated    */
+/*      in the same order so that the result is bit identical.          */
+/************************************************************************/
+
+static CPL_INLINE __m128d GWKCubicConvolutionSSE2( __m128d d1, __m128d d2,
+                                                   __m128d d3,
+                                                   __m128d f0, __m128d f1,
+                                                   __m128d f2, __m128d f3 )
+{
+    const __m128d half = _mm_set1_pd( 0.5 );
+    __m128d a, b, c;
+
+    a = _mm_mul_pd( _mm_mul_pd( d1, half ), _mm_sub_pd( f2, f0 ) );
+    b = _mm_sub_pd( _mm_add_pd( _mm_sub_pd( _mm_mul_pd( _mm_set1_pd( 2.0 ), f0 ),
+                                            _mm_mul_pd( _mm_set1_pd( 5.0 ), f1 ) ),
+                                _mm_mul_pd( _mm_set1_pd( 4.0 ), f2 ) ),
+                    f3 );
+    b = _mm_mul_pd( _mm_mul_pd( d2, half ), b );
+    c = _mm_sub_pd( _mm_add_pd( _mm_mul_pd( _mm_set1_pd( 3.0 ),
+                                            _mm_sub_pd( f1, f2 ) ),
+                                f3 ),
+                    f0 );
+    c = _mm_mul_pd( _mm_mul_pd( d3, half ), c );
+
+    return _mm_add_pd( _mm_add_pd( _mm_add_pd( f1, a ), b ), c );
+}
+
+/************************************************************************/
+/*                     GWKResampleNoMasks4SSE2()                        */
+/*                                                                      */
+/*      Bilinear or cubic resampling of 4 consecutive destination       */
+/*      pixels, 2 per SSE2 register.  The weights are computed once     */
+/*      for all the bands.  Returns FALSE, without writing anything,    */
+/*      if one of the pixels needs the border handling of the scalar    */
+/*      code.  Operations are done in double precision and in the      */
+/*      same order as GWKBilinearResampleNoMasksT() and                 */
+/*      GWKCubicResampleNoMasksT(), so that results are identical.      */
+/************************************************************************/
+
+template<class T, GDALResampleAlg eResample>
+static int GWKResampleNoMasks4SSE2( GDALWarpKernel *poWK,
+                                    const double *padfX, const double *padfY,
+                                    const int *pabSuccess, int iDstOffset )
+
+{
+    const int nSrcXSize = poWK->nSrcXSize;
+    int     anSrcOffset[4];
+    double  adfWeightX[4], adfWeightY[4];
+    int     k;
+
+    if( !GWKResampleNoMasksPrepare<eResample>( poWK, 4, padfX, padfY,
+                                               pabSuccess, anSrcOffset,
+                                               adfWeightX, adfWeightY ) )
+        return FALSE;
 
 /* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
+/*      Compute the weights shared by all bands.                        */
 /* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+    __m128d aW1[2], aW2[2], aW3[2], aW4[2], aW5[2], aW6[2];
+    const __m128d one = _mm_set1_pd( 1.0 );
+    int     h;
+
+    for( h = 0; h < 2; h++ )
+    {
+        __m128d wx = _mm_loadu_pd( adfWeightX + 2 * h );
+        __m128d wy = _mm_loadu_pd( adfWeightY + 2 * h );
+
+        if( eResample == GRA_Bilinear )
         {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
+            __m128d omwx = _mm_sub_pd( one, wx );
+            __m128d omwy = _mm_sub_pd( one, wy );
+
+            aW1[h] = _mm_mul_pd( wx, wy );      // upper left
+            aW2[h] = _mm_mul_pd( omwx, wy );    // upper right
+            aW3[h] = _mm_mul_pd( omwx, omwy );  // lower right
+            aW4[h] = _mm_mul_pd( wx, omwy );    // lower left
+            aW5[h] = _mm_add_pd( _mm_add_pd( _mm_add_pd( _mm_add_pd(
+                _mm_setzero_pd(), aW1[h] ), aW2[h] ), aW3[h] ), aW4[h] );
+        }
+        else
+        {
+            aW1[h] = wx;
+            aW2[h] = _mm_mul_pd( wx, wx );
+            aW3[h] = _mm_mul_pd( aW2[h], wx );
+            aW4[h] = wy;
+            aW5[h] = _mm_mul_pd( wy, wy );
+            aW6[h] = _mm_mul_pd( aW5[h], wy );
         }
+    }
 
 /* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
+/*      Interpolate each band.                                          */
 /* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
+    int     iBand;
 
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+    for( iBand = 0; iBand < poWK->nBands; iBand++ )
+    {
+        const T *pSrc = (const T *) poWK->papabySrcImage[iBand];
+        T       *pDst = ((T *) poWK->papabyDstImage[iBand]) + iDstOffset;
+        double   adfValue[4];
+
+        for( h = 0; h < 2; h++ )
         {
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
+            const int o0 = anSrcOffset[2 * h];
+            const int o1 = anSrcOffset[2 * h + 1];
 
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            int iDstOffset;
+            if( eResample == GRA_Bilinear )
+            {
+                __m128d acc = _mm_setzero_pd();
+
+                acc = _mm_add_pd( acc, _mm_mul_pd( aW1[h],
+                    _mm_set_pd( (double) pSrc[o1], (double) pSrc[o0] ) ) );
+                acc = _mm_add_pd( acc, _mm_mul_pd( aW2[h],
+                    _mm_set_pd( (double) pSrc[o1 + 1],
+                                (double) pSrc[o0 + 1] ) ) );
+                acc = _mm_add_pd( acc, _mm_mul_pd( aW3[h],
+                    _mm_set_pd( (double) pSrc[o1 + 1 + nSrcXSize],
+                                (double) pSrc[o0 + 1 + nSrcXSize] ) ) );
+                acc = _mm_add_pd( acc, _mm_mul_pd( aW4[h],
+                    _mm_set_pd( (double) pSrc[o1 + nSrcXSize],
+                                (double) pSrc[o0 + nSrcXSize] ) ) );
+
+                _mm_storeu_pd( adfValue + 2 * h, _mm_div_pd( acc, aW5[h] ) );
+            }
+            else
+            {
+                __m128d aRow[4];
+                int     i;
 
-            iDstOffset = iDstX + iDstY * nDstXSize;
+                for( i = 0; i < 4; i++ )
+                {
+                    const T *p0 = pSrc + o0 + (i - 1) * nSrcXSize;
+                    const T *p1 = pSrc + o1 + (i - 1) * nSrcXSize;
+
+                    aRow[i] = GWKCubicConvolutionSSE2(
+                        aW1[h], aW2[h], aW3[h],
+                        _mm_set_pd( (double) p1[-1], (double) p0[-1] ),
+                        _mm_set_pd( (double) p1[0], (double) p0[0] ),
+                        _mm_set_pd( (double) p1[1], (double) p0[1] ),
+                        _mm_set_pd( (double) p1[2], (double) p0[2] ) );
+                }
 
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                GWKCubicResampleNoMasksByte( poWK, iBand,
-                                             padfX[iDstX]-poWK->nSrcXOff,
-                                             padfY[iDstX]-poWK->nSrcYOff,
-                                             &poWK->papabyDstImage[iBand][iDstOffset] );
+                _mm_storeu_pd( adfValue + 2 * h,
+                               GWKCubicConvolutionSSE2( aW4[h], aW5[h], aW6[h],
+                                                        aRow[0], aRow[1],
+                                                        aRow[2], aRow[3] ) );
             }
         }
 
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
+        for( k = 0; k < 4; k++ )
+        {
+            T value = GWKClampValueT<T>( adfValue[k] );
+
+            if( poWK->padfDstNoDataReal != NULL )
+                GWKAvoidNoDataT( poWK, iBand, &value );
+
+            pDst[k] = value;
+        }
     }
 
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
+    GWKResampleNoMasksMarkValid( poWK, iDstOffset, 4 );
+
+    return TRUE;
 }
 
+#endif /* def GWK_USE_SSE2 */
+
 /************************************************************************/
-/*                   GWKCubicSplineNoMasksByte()                        */
+/*                      GWKResampleNoMasksThread()                      */
 /*                                                                      */
-/*      Case for 8bit input data with cubic spline resampling without   */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
+/*      Case for bilinear, cubic and cubic spline resampling of any     */
+/*      non complex working data type without source validity or       */
+/*      density masks.  Destination masks, if any, are simply marked    */
+/*      as valid/opaque.  The resampling algorithm is a template        */
+/*      parameter so that the per pixel dispatch is resolved at         */
+/*      compile time.                                                   */
 /************************************************************************/
 
-static void GWKCubicSplineNoMasksByteThread(void* pData);
-
-static CPLErr GWKCubicSplineNoMasksByte( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKCubicSplineNoMasksByte", GWKCubicSplineNoMasksByteThread );
-}
-
-static void GWKCubicSplineNoMasksByteThread( void* pData )
+template<class T, GDALResampleAlg eResample>
+static void GWKResampleNoMasksThread( void* pData )
 
 {
     GWKJobStruct* psJob = (GWKJobStruct*) pData;
@@ -3899,8 +4405,30 @@ static void GWKCubicSplineNoMasksByteThread( void* pData )
     padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
 
-    int     nXRadius = poWK->nXRadius;
-    double  *padfBSpline = (double *)CPLCalloc( nXRadius * 2, sizeof(double) );
+    double  *padfBSpline = NULL;
+    if( eResample == GRA_CubicSpline )
+        padfBSpline = (double *)CPLCalloc( poWK->nXRadius * 2, sizeof(double) );
+    const int bMirrorEdges = GWKCubicSplineMirrorsEdges( poWK );
+
+/* GDAL_USE_SSE2=NO forces the scalar code, GDAL_USE_AVX2=NO the SSE2 one */
+#if defined(GWK_USE_SSE2) || defined(HAVE_AVX2_AT_COMPILE_TIME)
+    const int bUseSSE2 = (eResample == GRA_Bilinear || eResample == GRA_Cubic)
+        && CSLTestBoolean( CPLGetConfigOption( "GDAL_USE_SSE2", "YES" ) );
+#endif
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+    GWKResampleNoMasks8Func pfnAVX2 = NULL;
+    double  *padfAVX2Value = NULL;
+    if( bUseSSE2
+        && CSLTestBoolean( CPLGetConfigOption( "GDAL_USE_AVX2", "YES" ) )
+        && GWKHaveRuntimeAVX2() )
+    {
+        pfnAVX2 = GWKGetResampleNoMasks8AVX2( poWK->eWorkingDataType,
+                                              eResample == GRA_Cubic );
+        if( pfnAVX2 != NULL )
+            padfAVX2Value = (double *)
+                CPLMalloc( sizeof(double) * 8 * poWK->nBands );
+    }
+#endif
 
 /* ==================================================================== */
 /*      Loop over output lines.                                         */
@@ -3931,6 +4459,28 @@ static void GWKCubicSplineNoMasksByteThread( void* pData )
 /* ==================================================================== */
         for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+            if( pfnAVX2 != NULL && iDstX + 8 <= nDstXSize
+                && GWKResampleNoMasks8AVX2<T, eResample>(
+                       poWK, pfnAVX2, padfAVX2Value,
+                       padfX + iDstX, padfY + iDstX, pabSuccess + iDstX,
+                       iDstX + iDstY * nDstXSize ) )
+            {
+                iDstX += 7;
+                continue;
+            }
+#endif
+#ifdef GWK_USE_SSE2
+            if( bUseSSE2 && iDstX + 4 <= nDstXSize
+                && GWKResampleNoMasks4SSE2<T, eResample>(
+                       poWK, padfX + iDstX, padfY + iDstX, pabSuccess + iDstX,
+                       iDstX + iDstY * nDstXSize ) )
+            {
+                iDstX += 3;
+                continue;
+            }
+#endif
+
             COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
 
 /* ==================================================================== */
@@ -3938,16 +4488,59 @@ static void GWKCubicSplineNoMasksByteThread( void* pData )
 /* ==================================================================== */
             int iBand;
             int iDstOffset;
+            int bHasFoundValue = FALSE;
+            double dfSrcX = padfX[iDstX] - poWK->nSrcXOff;
+            double dfSrcY = padfY[iDstX] - poWK->nSrcYOff;
 
             iDstOffset = iDstX + iDstY * nDstXSize;
 
             for( iBand = 0; iBand < poWK->nBands; iBand++ )
             {
-                GWKCubicSplineResampleNoMasksByte( poWK, iBand,
-                                                   padfX[iDstX]-poWK->nSrcXOff,
-                                                   padfY[iDstX]-poWK->nSrcYOff,
-                                                   &poWK->papabyDstImage[iBand][iDstOffset],
-                                                   padfBSpline);
+                T   value = 0;
+                int bSuccess;
+
+                if( eResample == GRA_Bilinear )
+                    bSuccess = GWKBilinearResampleNoMasksT( poWK, iBand,
+                                                            dfSrcX, dfSrcY,
+                                                            &value );
+                else if( eResample == GRA_Cubic )
+                    bSuccess = GWKCubicResampleNoMasksT( poWK, iBand,
+                                                         dfSrcX, dfSrcY,
+                                                         &value );
+                else if( bMirrorEdges )
+                    bSuccess = GWKCubicSplineResampleNoMasksMirrorT( poWK,
+                                                               iBand,
+                                                               dfSrcX, dfSrcY,
+                                                               &value,
+                                                               padfBSpline );
+                else
+                    bSuccess = GWKCubicSplineResampleNoMasksT( poWK, iBand,
+                                                               dfSrcX, dfSrcY,
+                                                               &value,
+                                                               padfBSpline );
+                if( !bSuccess )
+                    continue;
+
+                if( poWK->padfDstNoDataReal != NULL )
+                    GWKAvoidNoDataT( poWK, iBand, &value );
+
+                ((T *) poWK->papabyDstImage[iBand])[iDstOffset] = value;
+                bHasFoundValue = TRUE;
+            }
+
+            if( !bHasFoundValue )
+                continue;
+
+/* -------------------------------------------------------------------- */
+/*      Mark this pixel valid/opaque in the output.                     */
+/* -------------------------------------------------------------------- */
+            if( poWK->pafDstDensity != NULL )
+                poWK->pafDstDensity[iDstOffset] = 1.0f;
+
+            if( poWK->panDstValid != NULL )
+            {
+                poWK->panDstValid[iDstOffset>>5] |= 
+                    0x01 << (iDstOffset & 0x1f);
             }
         }
 
@@ -3966,24 +4559,22 @@ static void GWKCubicSplineNoMasksByteThread( void* pData )
     CPLFree( padfZ );
     CPLFree( pabSuccess );
     CPLFree( padfBSpline );
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+    CPLFree( padfAVX2Value );
+#endif
 }
 
 /************************************************************************/
-/*                          GWKNearestByte()                            */
+/*                          GWKNearestThread()                          */
 /*                                                                      */
-/*      Case for 8bit input data with nearest neighbour resampling      */
-/*      using valid flags. Should be as fast as possible for this       */
-/*      particular transformation type.                                 */
+/*      Case for nearest neighbour resampling of any non complex        */
+/*      working data type using valid flags and density masks.         */
+/*      Should be as fast as possible for this particular               */
+/*      transformation type.                                            */
 /************************************************************************/
 
-static void GWKNearestByteThread(void* pData);
-
-static CPLErr GWKNearestByte( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKNearestByte", GWKNearestByteThread );
-}
-
-static void GWKNearestByteThread( void* pData )
+template<class T>
+static void GWKNearestThread( void* pData )
 
 {
     GWKJobStruct* psJob = (GWKJobStruct*) pData;
@@ -4069,14 +4660,14 @@ static void GWKNearestByteThread( void* pData )
 
             for( iBand = 0; iBand < poWK->nBands; iBand++ )
             {
-                GByte   bValue = 0;
-                double dfBandDensity = 0.0;
+                T       value = 0;
+                double  dfBandDensity = 0.0;
 
 /* -------------------------------------------------------------------- */
 /*      Collect the source value.                                       */
 /* -------------------------------------------------------------------- */
-                if ( GWKGetPixelByte( poWK, iBand, iSrcOffset, &dfBandDensity,
-                                      &bValue ) )
+                if ( GWKGetPixelT( poWK, iBand, iSrcOffset, &dfBandDensity,
+                                   &value ) )
                 {
                     if( dfBandDensity < 1.0 )
                     {
@@ -4086,13 +4677,14 @@ static void GWKNearestByteThread( void* pData )
                         {
                             /* let the general code take care of mixing */
                             GWKSetPixelValue( poWK, iBand, iDstOffset, 
-                                              dfBandDensity, (double) bValue, 
+                                              dfBandDensity, (double) value, 
                                               0.0 );
                         }
                     }
                     else
                     {
-                        poWK->papabyDstImage[iBand][iDstOffset] = bValue;
+                        ((T *) poWK->papabyDstImage[iBand])[iDstOffset] =
+                            value;
                     }
                 }
             }
@@ -4126,703 +4718,208 @@ static void GWKNearestByteThread( void* pData )
 }
 
 /************************************************************************/
-/*                    GWKNearestNoMasksShort()                          */
+/*                          GWKOptimizedCase()                          */
 /*                                                                      */
-/*      Case for 16bit signed and unsigned integer input data with      */
-/*      nearest neighbour resampling without concerning about masking.  */
-/*      Should be as fast as possible for this particular               */
-/*      transformation type.                                            */
+/*      Pick the kernel instantiation matching the working data type    */
+/*      T, the resampling algorithm and the mask configuration.         */
 /************************************************************************/
 
-static void GWKNearestNoMasksShortThread(void* pData);
+template<class T>
+static CPLErr GWKOptimizedCase( GDALWarpKernel *poWK, int bNoSrcMasks )
 
-static CPLErr GWKNearestNoMasksShort( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKNearestNoMasksShort", GWKNearestNoMasksShortThread );
+    const char *pszType = GDALGetDataTypeName( poWK->eWorkingDataType );
+
+    switch( poWK->eResample )
+    {
+      case GRA_NearestNeighbour:
+        if( bNoSrcMasks )
+            return GWKRun( poWK, CPLSPrintf( "GWKNearestNoMasks%s", pszType ),
+                           GWKNearestNoMasksThread<T> );
+        return GWKRun( poWK, CPLSPrintf( "GWKNearest%s", pszType ),
+                       GWKNearestThread<T> );
+
+      case GRA_Bilinear:
+        return GWKRun( poWK, CPLSPrintf( "GWKBilinearNoMasks%s", pszType ),
+                       GWKResampleNoMasksThread<T, GRA_Bilinear> );
+
+      case GRA_Cubic:
+        return GWKRun( poWK, CPLSPrintf( "GWKCubicNoMasks%s", pszType ),
+                       GWKResampleNoMasksThread<T, GRA_Cubic> );
+
+      case GRA_CubicSpline:
+        return GWKRun( poWK, CPLSPrintf( "GWKCubicSplineNoMasks%s", pszType ),
+                       GWKResampleNoMasksThread<T, GRA_CubicSpline> );
+
+      default:
+        CPLAssert( FALSE );
+        return GWKGeneralCase( poWK );
+    }
 }
 
-static void GWKNearestNoMasksShortThread( void* pData )
+/************************************************************************/
+/*                           GWKModeOfValues()                          */
+/*                                                                      */
+/*      Return the index in padfVals of the most frequent value.  On    */
+/*      ties, the value that reached that count first in the order of   */
+/*      padfVals wins, as with the histograms of GWKAverageOrModeT().   */
+/*      NaN values are all different.  panOrder is a work array of      */
+/*      nCount entries.                                                 */
+/************************************************************************/
 
+struct GWKModeCompare
 {
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
+    const double *padfVals;
 
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
+    bool operator()( int i, int j ) const
+    {
+        return padfVals[i] < padfVals[j] 
+            || (padfVals[i] == padfVals[j] && i < j);
+    }
+};
 
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
+static int GWKModeOfValues( const double *padfVals, int nCount, 
+                            int *panOrder )
 
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+{
+    int i, nOrderCount = 0;
+    int iBest = -1, nBestCount = 0;
 
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
+    for( i = 0; i < nCount; i++ )
     {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+        if( CPLIsNan(padfVals[i]) )
         {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
+            if( iBest < 0 )
+            {
+                iBest = i;
+                nBestCount = 1;
+            }
         }
+        else
+            panOrder[nOrderCount++] = i;
+    }
+
+    GWKModeCompare oCompare;
+    oCompare.padfVals = padfVals;
+    std::sort( panOrder, panOrder + nOrderCount, oCompare );
 
 /* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
+/*      Each run of equal values reached its count at its last          */
+/*      position.                                                       */
 /* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
+    for( i = 0; i < nOrderCount; )
+    {
+        int iEnd = i + 1;
+        int iLast = panOrder[i];
 
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+        while( iEnd < nOrderCount 
+               && padfVals[panOrder[iEnd]] == padfVals[panOrder[i]] )
+            iLast = panOrder[iEnd++];
+
+        if( iEnd - i > nBestCount 
+            || (iEnd - i == nBestCount && iLast < iBest) )
         {
-            int iDstOffset;
+            iBest = iLast;
+            nBestCount = iEnd - i;
+        }
 
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
+        i = iEnd;
+    }
 
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                ((GInt16 *)poWK->papabyDstImage[iBand])[iDstOffset] = 
-                    ((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset];
-            }
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
-}
-
-/************************************************************************/
-/*                       GWKBilinearNoMasksShort()                      */
-/*                                                                      */
-/*      Case for 16bit input data with cubic resampling without         */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
-/************************************************************************/
-
-static void GWKBilinearNoMasksShortThread(void* pData);
-
-static CPLErr GWKBilinearNoMasksShort( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKBilinearNoMasksShort", GWKBilinearNoMasksShortThread );
-}
-
-static void GWKBilinearNoMasksShortThread( void* pData )
-
-{
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
-
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
-
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            int iDstOffset;
-
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                GInt16  iValue = 0;
-                GWKBilinearResampleNoMasksShort( poWK, iBand,
-                                                 padfX[iDstX]-poWK->nSrcXOff,
-                                                 padfY[iDstX]-poWK->nSrcYOff,
-                                                 &iValue );
-                ((GInt16 *)poWK->papabyDstImage[iBand])[iDstOffset] = iValue;
-            }
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
-}
-
-/************************************************************************/
-/*                       GWKCubicNoMasksShort()                         */
-/*                                                                      */
-/*      Case for 16bit input data with cubic resampling without         */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
-/************************************************************************/
-
-static void GWKCubicNoMasksShortThread(void* pData);
-
-static CPLErr GWKCubicNoMasksShort( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKCubicNoMasksShort", GWKCubicNoMasksShortThread );
-}
-
-static void GWKCubicNoMasksShortThread( void* pData )
-
-{
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
-
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
-
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            int iDstOffset;
-
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                GInt16  iValue = 0;
-                GWKCubicResampleNoMasksShort( poWK, iBand,
-                                              padfX[iDstX]-poWK->nSrcXOff,
-                                              padfY[iDstX]-poWK->nSrcYOff,
-                                              &iValue );
-                ((GInt16 *)poWK->papabyDstImage[iBand])[iDstOffset] = iValue;
-            }
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
+    return iBest;
 }
 
 /************************************************************************/
-/*                    GWKCubicSplineNoMasksShort()                      */
+/*                        GWKAverageOrModeBuffer                        */
 /*                                                                      */
-/*      Case for 16bit input data with cubic resampling without         */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
+/*      Work arrays of a thread, grown as needed.                       */
 /************************************************************************/
 
-static void GWKCubicSplineNoMasksShortThread(void* pData);
-
-static CPLErr GWKCubicSplineNoMasksShort( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKCubicSplineNoMasksShort", GWKCubicSplineNoMasksShortThread );
-}
-
-static void GWKCubicSplineNoMasksShortThread( void* pData )
-
+typedef struct
 {
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-    int     nXRadius = poWK->nXRadius;
-    // Make space to save weights
-    double  *padfBSpline = (double *)CPLCalloc( nXRadius * 2, sizeof(double) );
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
-
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
-
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            int iDstOffset;
-
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                GInt16  iValue = 0;
-                GWKCubicSplineResampleNoMasksShort( poWK, iBand,
-                                                    padfX[iDstX]-poWK->nSrcXOff,
-                                                    padfY[iDstX]-poWK->nSrcYOff,
-                                                    &iValue,
-                                                    padfBSpline);
-                ((GInt16 *)poWK->papabyDstImage[iBand])[iDstOffset] = iValue;
-            }
-        }
+    int     nMax;
+    double *padfVals;
+    int    *panInts;
+} GWKAverageOrModeBuffer;
 
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    }
+static void GWKAverageOrModeReserve( GWKAverageOrModeBuffer *psBuf, int nCount )
 
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
-    CPLFree( padfBSpline );
-}
-
-/************************************************************************/
-/*                          GWKNearestShort()                           */
-/*                                                                      */
-/*      Case for 32bit float input data with nearest neighbour          */
-/*      resampling using valid flags. Should be as fast as possible     */
-/*      for this particular transformation type.                        */
-/************************************************************************/
-
-static void GWKNearestShortThread(void* pData);
-
-static CPLErr GWKNearestShort( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKNearestShort", GWKNearestShortThread );
-}
-
-static void GWKNearestShortThread(void* pData)
-{
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
-
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            int iDstOffset;
-
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
-
-/* -------------------------------------------------------------------- */
-/*      Don't generate output pixels for which the source valid         */
-/*      mask exists and is invalid.                                     */
-/* -------------------------------------------------------------------- */
-            if( poWK->panUnifiedSrcValid != NULL
-                && !(poWK->panUnifiedSrcValid[iSrcOffset>>5]
-                     & (0x01 << (iSrcOffset & 0x1f))) )
-                continue;
-
-/* -------------------------------------------------------------------- */
-/*      Do not try to apply transparent source pixels to the destination.*/
-/* -------------------------------------------------------------------- */
-            double  dfDensity = 1.0;
-
-            if( poWK->pafUnifiedSrcDensity != NULL )
-            {
-                dfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
-                if( dfDensity < 0.00001 )
-                    continue;
-            }
-
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                GInt16  iValue = 0;
-                double dfBandDensity = 0.0;
-
-/* -------------------------------------------------------------------- */
-/*      Collect the source value.                                       */
-/* -------------------------------------------------------------------- */
-                if ( GWKGetPixelShort( poWK, iBand, iSrcOffset, &dfBandDensity,
-                                       &iValue ) )
-                {
-                    if( dfBandDensity < 1.0 )
-                    {
-                        if( dfBandDensity == 0.0 )
-                            /* do nothing */;
-                        else
-                        {
-                            /* let the general code take care of mixing */
-                            GWKSetPixelValue( poWK, iBand, iDstOffset, 
-                                              dfBandDensity, (double) iValue, 
-                                              0.0 );
-                        }
-                    }
-                    else
-                    {
-                        ((GInt16 *)poWK->papabyDstImage[iBand])[iDstOffset] = iValue;
-                    }
-                }
-            }
-
-/* -------------------------------------------------------------------- */
-/*      Mark this pixel valid/opaque in the output.                     */
-/* -------------------------------------------------------------------- */
-            GWKOverlayDensity( poWK, iDstOffset, dfDensity );
-
-            if( poWK->panDstValid != NULL )
-            {
-                poWK->panDstValid[iDstOffset>>5] |= 
-                    0x01 << (iDstOffset & 0x1f);
-            }
-        } /* Next iDstX */
-
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    } /* Next iDstY */
+    if( nCount <= psBuf->nMax )
+        return;
 
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
+    psBuf->nMax = MAX(nCount, 2 * psBuf->nMax);
+    psBuf->padfVals = (double *) 
+        CPLRealloc( psBuf->padfVals, sizeof(double) * psBuf->nMax );
+    psBuf->panInts = (int *) 
+        CPLRealloc( psBuf->panInts, sizeof(int) * psBuf->nMax );
 }
 
 /************************************************************************/
-/*                    GWKNearestNoMasksFloat()                          */
+/*                           GWKAverageOrMode()                         */
 /*                                                                      */
-/*      Case for 32bit float input data with nearest neighbour          */
-/*      resampling without concerning about masking. Should be as fast  */
-/*      as possible for this particular transformation type.            */
+/*      The non complex working data types have their own kernel,       */
+/*      which reads the source pixels directly.                         */
 /************************************************************************/
 
-static void GWKNearestNoMasksFloatThread(void* pData);
-
-static CPLErr GWKNearestNoMasksFloat( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKNearestNoMasksFloat", GWKNearestNoMasksFloatThread );
-}
-
-static void GWKNearestNoMasksFloatThread( void* pData )
+static void GWKAverageOrModeThread(void* pData);
+template<class T> static void GWKAverageOrModeThreadT(void* pData);
 
+static CPLErr GWKAverageOrMode( GDALWarpKernel *poWK )
 {
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
+    switch( poWK->eWorkingDataType )
     {
-        int iDstX;
+      case GDT_Byte:
+        return GWKRun( poWK, "GWKAverageOrModeByte",
+                       GWKAverageOrModeThreadT<GByte> );
 
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
+      case GDT_Int16:
+        return GWKRun( poWK, "GWKAverageOrModeInt16",
+                       GWKAverageOrModeThreadT<GInt16> );
 
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
+      case GDT_UInt16:
+        return GWKRun( poWK, "GWKAverageOrModeUInt16",
+                       GWKAverageOrModeThreadT<GUInt16> );
 
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            int iDstOffset;
+      case GDT_Int32:
+        return GWKRun( poWK, "GWKAverageOrModeInt32",
+                       GWKAverageOrModeThreadT<GInt32> );
 
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
+      case GDT_UInt32:
+        return GWKRun( poWK, "GWKAverageOrModeUInt32",
+                       GWKAverageOrModeThreadT<GUInt32> );
 
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            
-            iDstOffset = iDstX + iDstY * nDstXSize;
+      case GDT_Float32:
+        return GWKRun( poWK, "GWKAverageOrModeFloat32",
+                       GWKAverageOrModeThreadT<float> );
 
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                ((float *)poWK->papabyDstImage[iBand])[iDstOffset] = 
-                    ((float *)poWK->papabySrcImage[iBand])[iSrcOffset];
-            }
-        }
+      case GDT_Float64:
+        return GWKRun( poWK, "GWKAverageOrModeFloat64",
+                       GWKAverageOrModeThreadT<double> );
 
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
+      default:
+        return GWKRun( poWK, "GWKAverageOrMode", GWKAverageOrModeThread );
     }
-
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
 }
 
 /************************************************************************/
-/*                          GWKNearestFloat()                           */
+/*                      GWKAverageOrModeThreadT()                       */
 /*                                                                      */
-/*      Case for 32bit float input data with nearest neighbour          */
-/*      resampling using valid flags. Should be as fast as possible     */
-/*      for this particular transformation type.                        */
+/*      The footprint of a destination pixel is the source rectangle    */
+/*      between the transformed top left and bottom right corners of    */
+/*      the pixel.  Average is the mean of its valid pixels.  Mode      */
+/*      is their most frequent value, counted with a histogram for      */
+/*      Byte, Int16 and UInt16.                                         */
+/*                                                                      */
+/*      When the transformation is axis aligned, the footprint columns  */
+/*      are computed once, and the footprint rows once per line.  The   */
+/*      average of Byte, Int16 and UInt16 then sums each line of        */
+/*      destination pixels through running sums of the source columns,  */
+/*      which gives exactly the same sums as a pixel per pixel loop.    */
 /************************************************************************/
 
-static void GWKNearestFloatThread(void* pData);
-
-static CPLErr GWKNearestFloat( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKNearestFloat", GWKNearestFloatThread );
-}
-
-static void GWKNearestFloatThread( void* pData )
+template<class T>
+static void GWKAverageOrModeThreadT( void* pData )
 
 {
     GWKJobStruct* psJob = (GWKJobStruct*) pData;
@@ -4830,115 +4927,393 @@ static void GWKNearestFloatThread( void* pData )
     int iYMin = psJob->iYMin;
     int iYMax = psJob->iYMax;
 
-    int iDstY;
+    int iDstY, iDstX, iSrcX, iSrcY, iBand, iDstOffset;
     int nDstXSize = poWK->nDstXSize;
     int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
+    int nBands = poWK->nBands;
+
+    const int bAverage = poWK->eResample == GRA_Average;
+    const int bSmallInt = poWK->eWorkingDataType == GDT_Byte
+        || poWK->eWorkingDataType == GDT_Int16
+        || poWK->eWorkingDataType == GDT_UInt16;
+    const int bHasValidity = poWK->panUnifiedSrcValid != NULL
+        || poWK->papanBandSrcValid != NULL
+        || poWK->pafUnifiedSrcDensity != NULL;
+    const int bAxisAligned = 
+        GDALTransformIsAxisAligned( poWK->pfnTransformer, 
+                                    psJob->pTransformerArg );
+    const int bColumnSums = bAverage && bSmallInt && bAxisAligned;
+
+    if( iYMax <= iYMin )
+        return;
 
 /* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
+/*      Histogram for the mode of small integer types.                  */
+/* -------------------------------------------------------------------- */
+    int *panHistogram = NULL;
+    int  nBinsOffset = 0;
+
+    if( !bAverage && bSmallInt )
+    {
+        if( poWK->eWorkingDataType == GDT_Byte )
+            panHistogram = (int *) CPLCalloc( 256, sizeof(int) );
+        else
+            panHistogram = (int *) CPLCalloc( 65536, sizeof(int) );
+
+        if( poWK->eWorkingDataType == GDT_Int16 )
+            nBinsOffset = 32768;
+    }
+
+    GWKAverageOrModeBuffer sBuf;
+    sBuf.nMax = 0;
+    sBuf.padfVals = NULL;
+    sBuf.panInts = NULL;
+
+/* -------------------------------------------------------------------- */
+/*      Allocate x,y,z coordinate arrays for transformation ... two     */
+/*      scanlines worth of positions, and the footprint of each         */
+/*      pixel of a line.                                                */
 /* -------------------------------------------------------------------- */
     double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
+    double *padfX2, *padfY2, *padfZ2;
+    int    *pabSuccess, *pabSuccess2;
 
     padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
+    padfX2 = (double *) CPLMalloc(sizeof(double) * nDstXSize);
+    padfY2 = (double *) CPLMalloc(sizeof(double) * nDstXSize);
+    padfZ2 = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+    pabSuccess2 = (int *) CPLMalloc(sizeof(int) * nDstXSize);
 
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
+    int *panSrcXMin = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+    int *panSrcXMax = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+    int *panSrcYMin = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+    int *panSrcYMax = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+    int *pabXSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
 
 /* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
+/*      With an axis aligned transformation, the source columns         */
+/*      come from the transformation of the first line.  The other      */
+/*      lines would give the same ones.                                 */
 /* -------------------------------------------------------------------- */
+    if( bAxisAligned )
+    {
         for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
+            padfX[iDstX] = iDstX + poWK->nDstXOff;
+            padfY[iDstX] = iYMin + poWK->nDstYOff;
             padfZ[iDstX] = 0.0;
+            padfX2[iDstX] = iDstX + 1.0 + poWK->nDstXOff;
+            padfY2[iDstX] = iYMin + 1.0 + poWK->nDstYOff;
+            padfZ2[iDstX] = 0.0;
         }
 
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
         poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
                               padfX, padfY, padfZ, pabSuccess );
+        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
+                              padfX2, padfY2, padfZ2, pabSuccess2 );
 
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
         for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
-            int iDstOffset;
-
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
+            pabXSuccess[iDstX] = pabSuccess[iDstX] && pabSuccess2[iDstX];
+            panSrcXMin[iDstX] = MAX( ((int) floor((padfX[iDstX] + 1e-10))) - poWK->nSrcXOff, 0 );
+            panSrcXMax[iDstX] = MIN( ((int) ceil((padfX2[iDstX] + 1e-10))) - poWK->nSrcXOff, nSrcXSize );
+        }
+    }
 
 /* -------------------------------------------------------------------- */
-/*      Do not try to apply invalid source pixels to the dest.          */
+/*      Running sums of the source columns, per band, for the average   */
+/*      of axis aligned transformations.                                */
 /* -------------------------------------------------------------------- */
-            if( poWK->panUnifiedSrcValid != NULL
-                && !(poWK->panUnifiedSrcValid[iSrcOffset>>5]
-                     & (0x01 << (iSrcOffset & 0x1f))) )
+    int     nColMin = 0, nColCount = 0;
+    double *padfColSum = NULL;
+    int    *panColCount = NULL;
+
+    if( bColumnSums )
+    {
+        int nColMax = 0;
+
+        nColMin = nSrcXSize;
+        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+        {
+            if( !pabXSuccess[iDstX] 
+                || panSrcXMin[iDstX] >= panSrcXMax[iDstX] )
                 continue;
+            nColMin = MIN(nColMin, panSrcXMin[iDstX]);
+            nColMax = MAX(nColMax, panSrcXMax[iDstX]);
+        }
+        nColCount = MAX(0, nColMax - nColMin);
+
+        padfColSum = (double *) 
+            CPLMalloc(sizeof(double) * (nColCount + 1) * nBands);
+        panColCount = (int *) 
+            CPLMalloc(sizeof(int) * (nColCount + 1) * nBands);
+    }
+
+    CPLDebug( "GDAL", "GDALWarpKernel():GWKAverageOrModeThreadT() %s%s%s",
+              bAverage ? "average" : "mode",
+              panHistogram != NULL ? " with histogram" : "",
+              bColumnSums ? " with column sums" : 
+              bAxisAligned ? " axis aligned" : "" );
+
+/* ==================================================================== */
+/*      Loop over output lines.                                         */
+/* ==================================================================== */
+    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
+    {
 
 /* -------------------------------------------------------------------- */
-/*      Do not try to apply transparent source pixels to the destination.*/
+/*      Footprint of the pixels of the line.  For an axis aligned       */
+/*      transformation, the source rows are given by the first          */
+/*      pixel, transformed alone as it would be first of its line.      */
 /* -------------------------------------------------------------------- */
-            double  dfDensity = 1.0;
+        if( bAxisAligned )
+        {
+            double dfX = poWK->nDstXOff, dfY = iDstY + poWK->nDstYOff;
+            double dfZ = 0.0;
+            double dfX2 = 1.0 + poWK->nDstXOff;
+            double dfY2 = iDstY + 1.0 + poWK->nDstYOff;
+            double dfZ2 = 0.0;
+            int    bSuccess = FALSE, bSuccess2 = FALSE;
+
+            poWK->pfnTransformer( psJob->pTransformerArg, TRUE, 1,
+                                  &dfX, &dfY, &dfZ, &bSuccess );
+            poWK->pfnTransformer( psJob->pTransformerArg, TRUE, 1,
+                                  &dfX2, &dfY2, &dfZ2, &bSuccess2 );
+
+            int nRowYMin = MAX( ((int) floor((dfY + 1e-10))) - poWK->nSrcYOff, 0 );
+            int nRowYMax = MIN( ((int) ceil((dfY2 + 1e-10))) - poWK->nSrcYOff, nSrcYSize );
+
+            for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+            {
+                pabSuccess[iDstX] = 
+                    pabXSuccess[iDstX] && bSuccess && bSuccess2;
+                panSrcYMin[iDstX] = nRowYMin;
+                panSrcYMax[iDstX] = nRowYMax;
+            }
+        }
+        else
+        {
+            for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+            {
+                padfX[iDstX] = iDstX + poWK->nDstXOff;
+                padfY[iDstX] = iDstY + poWK->nDstYOff;
+                padfZ[iDstX] = 0.0;
+                padfX2[iDstX] = iDstX + 1.0 + poWK->nDstXOff;
+                padfY2[iDstX] = iDstY + 1.0 + poWK->nDstYOff;
+                padfZ2[iDstX] = 0.0;
+            }
 
-            if( poWK->pafUnifiedSrcDensity != NULL )
+            poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
+                                  padfX, padfY, padfZ, pabSuccess );
+            poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
+                                  padfX2, padfY2, padfZ2, pabSuccess2 );
+
+            for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
             {
-                dfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
-                if( dfDensity < 0.00001 )
-                    continue;
+                pabSuccess[iDstX] = pabSuccess[iDstX] && pabSuccess2[iDstX];
+                panSrcXMin[iDstX] = MAX( ((int) floor((padfX[iDstX] + 1e-10))) - poWK->nSrcXOff, 0 );
+                panSrcXMax[iDstX] = MIN( ((int) ceil((padfX2[iDstX] + 1e-10))) - poWK->nSrcXOff, nSrcXSize );
+                panSrcYMin[iDstX] = MAX( ((int) floor((padfY[iDstX] + 1e-10))) - poWK->nSrcYOff, 0 );
+                panSrcYMax[iDstX] = MIN( ((int) ceil((padfY2[iDstX] + 1e-10))) - poWK->nSrcYOff, nSrcYSize );
+            }
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Running sums of the source columns over the rows of the line.   */
+/* -------------------------------------------------------------------- */
+        if( bColumnSums && nColCount > 0 )
+        {
+            int nRowYMin = panSrcYMin[0], nRowYMax = panSrcYMax[0];
+
+            for( iBand = 0; iBand < nBands; iBand++ )
+            {
+                const T *pSrc = (const T *) poWK->papabySrcImage[iBand];
+                double  *padfSum = padfColSum + iBand * (nColCount + 1);
+                int     *panCount = panColCount + iBand * (nColCount + 1);
+                int      i;
+
+                for( i = 0; i <= nColCount; i++ )
+                {
+                    padfSum[i] = 0.0;
+                    panCount[i] = 0;
+                }
+
+                // Column i is accumulated into entry i+1.
+                for( iSrcY = nRowYMin; iSrcY < nRowYMax; iSrcY++ )
+                {
+                    int iSrcOffset = nColMin + iSrcY * nSrcXSize;
+
+                    if( !bHasValidity )
+                    {
+                        const T *pLine = pSrc + iSrcOffset;
+                        for( i = 0; i < nColCount; i++ )
+                            padfSum[i+1] += pLine[i];
+                        continue;
+                    }
+
+                    for( i = 0; i < nColCount; i++, iSrcOffset++ )
+                    {
+                        double dfBandDensity = 0.0;
+                        T      value = 0;
+
+                        if( GWKGetPixelT( poWK, iBand, iSrcOffset,
+                                          &dfBandDensity, &value )
+                            && dfBandDensity > 0.0000000001 )
+                        {
+                            padfSum[i+1] += value;
+                            panCount[i+1]++;
+                        }
+                    }
+                }
+
+                if( !bHasValidity )
+                {
+                    for( i = 1; i <= nColCount; i++ )
+                        panCount[i] = MAX(0, nRowYMax - nRowYMin);
+                }
+
+                for( i = 1; i <= nColCount; i++ )
+                {
+                    padfSum[i] += padfSum[i-1];
+                    panCount[i] += panCount[i-1];
+                }
             }
+        }
 
 /* ==================================================================== */
-/*      Loop processing each band.                                      */
+/*      Loop over pixels in output scanline.                            */
 /* ==================================================================== */
-            int iBand;
+        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
+        {
+            double  dfDensity = 1.0;
+            int bHasFoundDensity = FALSE;
 
+            if( !pabSuccess[iDstX] )
+                continue;
             iDstOffset = iDstX + iDstY * nDstXSize;
 
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
+            int iSrcXMin = panSrcXMin[iDstX];
+            int iSrcXMax = panSrcXMax[iDstX];
+            int iSrcYMin = panSrcYMin[iDstX];
+            int iSrcYMax = panSrcYMax[iDstX];
+
+            if( iSrcXMin < iSrcXMax && iSrcYMin < iSrcYMax )
+                GWKAverageOrModeReserve( &sBuf, 
+                    (iSrcXMax - iSrcXMin) * (iSrcYMax - iSrcYMin) );
+
+/* ==================================================================== */
+/*      Loop processing each band.                                      */
+/* ==================================================================== */
+            for( iBand = 0; iBand < nBands; iBand++ )
             {
-                float   fValue = 0;
-                double dfBandDensity = 0.0;
+                const T *pSrc = (const T *) poWK->papabySrcImage[iBand];
+                double dfValueReal = 0.0;
+                int    nCount = 0;  // count of pixels used to compute average/mode
+
+                if( bColumnSums )
+                {
+                    if( iSrcXMin >= iSrcXMax )
+                        continue;
+
+                    const double *padfSum = 
+                        padfColSum + iBand * (nColCount + 1);
+                    const int *panCount = 
+                        panColCount + iBand * (nColCount + 1);
+                    const int i1 = iSrcXMin - nColMin;
+                    const int i2 = iSrcXMax - nColMin;
+
+                    nCount = panCount[i2] - panCount[i1];
+                    if( nCount > 0 )
+                        dfValueReal = (padfSum[i2] - padfSum[i1]) / nCount;
+                }
+                else
+                {
+                    double dfTotal = 0.0;
+                    int    nMaxCount = 0, nMaxValue = 0;
 
 /* -------------------------------------------------------------------- */
-/*      Collect the source value.                                       */
+/*      Collect the valid source values of the footprint.               */
 /* -------------------------------------------------------------------- */
-                if ( GWKGetPixelFloat( poWK, iBand, iSrcOffset, &dfBandDensity,
-                                       &fValue ) )
-                {
-                    if( dfBandDensity < 1.0 )
+                    for( iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++ )
                     {
-                        if( dfBandDensity == 0.0 )
-                            /* do nothing */;
-                        else
+                        int iSrcOffset = iSrcXMin + iSrcY * nSrcXSize;
+
+                        for( iSrcX = iSrcXMin; iSrcX < iSrcXMax; 
+                             iSrcX++, iSrcOffset++ )
                         {
-                            /* let the general code take care of mixing */
-                            GWKSetPixelValue( poWK, iBand, iDstOffset, 
-                                              dfBandDensity, (double) fValue, 
-                                              0.0 );
+                            T value;
+
+                            if( bHasValidity )
+                            {
+                                double dfBandDensity = 0.0;
+
+                                if( !GWKGetPixelT( poWK, iBand, iSrcOffset,
+                                                   &dfBandDensity, &value )
+                                    || dfBandDensity <= 0.0000000001 )
+                                    continue;
+                            }
+                            else
+                                value = pSrc[iSrcOffset];
+
+                            if( bAverage )
+                                dfTotal += value;
+                            else if( panHistogram != NULL )
+                            {
+                                // The first value to reach the highest
+                                // count wins.
+                                int nBin = (int) value + nBinsOffset;
+
+                                sBuf.panInts[nCount] = nBin;
+                                if( ++panHistogram[nBin] > nMaxCount )
+                                {
+                                    nMaxCount = panHistogram[nBin];
+                                    nMaxValue = (int) value;
+                                }
+                            }
+                            else
+                                sBuf.padfVals[nCount] = value;
+
+                            nCount++;
                         }
                     }
-                    else
+
+                    if( nCount == 0 )
+                        continue;
+
+                    if( bAverage )
+                        dfValueReal = dfTotal / nCount;
+                    else if( panHistogram != NULL )
                     {
-                        ((float *)poWK->papabyDstImage[iBand])[iDstOffset] 
-                            = fValue;
+                        dfValueReal = nMaxValue;
+                        for( int i = 0; i < nCount; i++ )
+                            panHistogram[sBuf.panInts[i]] = 0;
                     }
+                    else
+                        dfValueReal = sBuf.padfVals[
+                            GWKModeOfValues( sBuf.padfVals, nCount, 
+                                             sBuf.panInts )];
                 }
+
+                if( nCount == 0 )
+                    continue;
+
+/* -------------------------------------------------------------------- */
+/*      We have a computed value from the source.  Now apply it to      */
+/*      the destination pixel.                                          */
+/* -------------------------------------------------------------------- */
+                bHasFoundDensity = TRUE;
+                GWKSetPixelValue( poWK, iBand, iDstOffset,
+                                  1.0, dfValueReal, 0.0 );
             }
 
+            if (!bHasFoundDensity)
+                continue;
+
 /* -------------------------------------------------------------------- */
-/*      Mark this pixel valid/opaque in the output.                     */
+/*      Update destination density/validity masks.                      */
 /* -------------------------------------------------------------------- */
             GWKOverlayDensity( poWK, iDstOffset, dfDensity );
 
@@ -4947,7 +5322,8 @@ static void GWKNearestFloatThread( void* pData )
                 poWK->panDstValid[iDstOffset>>5] |= 
                     0x01 << (iDstOffset & 0x1f);
             }
-        }
+
+        } /* Next iDstX */
 
 /* -------------------------------------------------------------------- */
 /*      Report progress to the user, and optionally cancel out.         */
@@ -4962,21 +5338,30 @@ static void GWKNearestFloatThread( void* pData )
     CPLFree( padfX );
     CPLFree( padfY );
     CPLFree( padfZ );
+    CPLFree( padfX2 );
+    CPLFree( padfY2 );
+    CPLFree( padfZ2 );
     CPLFree( pabSuccess );
+    CPLFree( pabSuccess2 );
+    CPLFree( panSrcXMin );
+    CPLFree( panSrcXMax );
+    CPLFree( panSrcYMin );
+    CPLFree( panSrcYMax );
+    CPLFree( pabXSuccess );
+    CPLFree( padfColSum );
+    CPLFree( panColCount );
+    CPLFree( panHistogram );
+    CPLFree( sBuf.padfVals );
+    CPLFree( sBuf.panInts );
 }
 
 /************************************************************************/
-/*                           GWKAverageOrMode()                         */
+/*                       GWKAverageOrModeThread()                       */
 /*                                                                      */
+/*      Complex working data types, of which only the real part is      */
+/*      used.                                                           */
 /************************************************************************/
 
-static void GWKAverageOrModeThread(void* pData);
-
-static CPLErr GWKAverageOrMode( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKAverageOrMode", GWKAverageOrModeThread );
-}
-
 // overall logic based on GWKGeneralCaseThread()
 static void GWKAverageOrModeThread( void* pData)
 {
@@ -4990,50 +5375,17 @@ static void GWKAverageOrModeThread( void* pData)
     int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
 
 /* -------------------------------------------------------------------- */
-/*      Find out which algorithm to use (small optim.)                  */
+/*      Find out which algorithm to use.                                */
 /* -------------------------------------------------------------------- */
     int nAlgo = 0;
 
-    // these vars only used with nAlgo == 3
-    int *panVals = NULL;
-    int nBins = 0, nBinsOffset = 0;
-
     if ( poWK->eResample == GRA_Average ) 
     {
         nAlgo = 1;
     }
     else if( poWK->eResample == GRA_Mode )
     {
-        // TODO check color table count > 256
-        if ( poWK->eWorkingDataType == GDT_Byte ||
-             poWK->eWorkingDataType == GDT_UInt16 ||
-             poWK->eWorkingDataType == GDT_Int16 )
-        {
-            nAlgo = 3;
-
-            /* In the case of a paletted or non-paletted byte band, */
-            /* input values are between 0 and 255 */
-            if ( poWK->eWorkingDataType == GDT_Byte )
-            {
-                nBins = 256;
-            }
-            /* In the case of Int16, input values are between -32768 and 32767 */
-            else if ( poWK->eWorkingDataType == GDT_Int16 )
-            {
-                nBins = 65536;
-                nBinsOffset = 32768;
-            }
-            /* In the case of UInt16, input values are between 0 and 65537 */
-            else if ( poWK->eWorkingDataType == GDT_UInt16 )
-            {
-                nBins = 65536;
-            }
-            panVals = (int*) CPLMalloc(nBins * sizeof(int));            
-        }
-        else
-        {
-            nAlgo = 2;
-        }
+        nAlgo = 2;
     }
     else
     {
@@ -5043,6 +5395,11 @@ static void GWKAverageOrModeThread( void* pData)
     }
     CPLDebug( "GDAL", "GDALWarpKernel():GWKAverageOrModeThread() using algo %d", nAlgo );
 
+    GWKAverageOrModeBuffer sBuf;
+    sBuf.nMax = 0;
+    sBuf.padfVals = NULL;
+    sBuf.panInts = NULL;
+
 /* -------------------------------------------------------------------- */
 /*      Allocate x,y,z coordinate arrays for transformation ... two     */
 /*      scanlines worth of positions.                                   */
@@ -5165,122 +5522,43 @@ static void GWKAverageOrModeThread( void* pData)
                                        
                 } // GRA_Average
                 
-                else if ( nAlgo == 2 || nAlgo == 3 ) // poWK->eResample == GRA_Mode
+                else if ( nAlgo == 2 ) // poWK->eResample == GRA_Mode
                 {
-                    // this code adapted from GDALDownsampleChunk32R_Mode() in gcore/overview.cpp
+                    /* I'm not sure how much sense it makes to run a majority
+                       filter on floating point data, but here it is for the sake
+                       of compatability. It won't look right on RGB images by the
+                       nature of the filter. */
+                    if( iSrcXMin < iSrcXMax && iSrcYMin < iSrcYMax )
+                        GWKAverageOrModeReserve( &sBuf,
+                            (iSrcXMax - iSrcXMin) * (iSrcYMax - iSrcYMin) );
 
-                    if ( nAlgo == 2 ) // int32 or float
+                    for( iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++ )
                     {
-                        /* I'm not sure how much sense it makes to run a majority
-                           filter on floating point data, but here it is for the sake
-                           of compatability. It won't look right on RGB images by the
-                           nature of the filter. */
-                        int     iMaxInd = 0, iMaxVal = -1, i = 0;
-                        int     nNumPx = nSrcXSize * nSrcYSize;
-
-                        if ( nNumPx == 0 )
-                            continue;
-
-                        /* putting alloc outside of loop (and CPLRealloc here) saves time 
-                           but takes much more memory (why?), so just doing malloc here */
-                        float*   pafVals = (float*) CPLMalloc(nNumPx * sizeof(float));
-                        int*     panSums = (int*) CPLMalloc(nNumPx * sizeof(int));
-                        
-                        for( iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++ )
+                        for( iSrcX = iSrcXMin; iSrcX < iSrcXMax; iSrcX++ )
                         {
-                            for( iSrcX = iSrcXMin; iSrcX < iSrcXMax; iSrcX++ )
+                            iSrcOffset = iSrcX + iSrcY * nSrcXSize;
+                            
+                            if( poWK->panUnifiedSrcValid != NULL
+                                && !(poWK->panUnifiedSrcValid[iSrcOffset>>5]
+                                     & (0x01 << (iSrcOffset & 0x1f))) )
+                                continue;
+                            
+                            nCount2++;
+                            if ( GWKGetPixelValue( poWK, iBand, iSrcOffset,
+                                                   &dfBandDensity, &dfValueRealTmp, &dfValueImagTmp ) && dfBandDensity > 0.0000000001 ) 
                             {
-                                iSrcOffset = iSrcX + iSrcY * nSrcXSize;
-                                
-                                if( poWK->panUnifiedSrcValid != NULL
-                                    && !(poWK->panUnifiedSrcValid[iSrcOffset>>5]
-                                         & (0x01 << (iSrcOffset & 0x1f))) )
-                                    continue;
-                                
-                                nCount2++;
-                                if ( GWKGetPixelValue( poWK, iBand, iSrcOffset,
-                                                       &dfBandDensity, &dfValueRealTmp, &dfValueImagTmp ) && dfBandDensity > 0.0000000001 ) 
-                                {
-                                    nCount++;
-
-                                    float fVal = dfValueRealTmp;
-                                    
-                                    //Check array for existing entry
-                                    for( i = 0; i < iMaxInd; ++i )
-                                        if( pafVals[i] == fVal
-                                            && ++panSums[i] > panSums[iMaxVal] )
-                                        {
-                                            iMaxVal = i;
-                                            break;
-                                        }
-                                    
-                                    //Add to arr if entry not already there
-                                    if( i == iMaxInd )
-                                    {
-                                        pafVals[iMaxInd] = fVal;
-                                        panSums[iMaxInd] = 1;
-                                        
-                                        if( iMaxVal < 0 )
-                                            iMaxVal = iMaxInd;
-                                        
-                                        ++iMaxInd;
-                                    }
-                                }
+                                sBuf.padfVals[nCount++] = dfValueRealTmp;
                             }
                         }
-
-                        if( iMaxVal != -1 )
-                        {
-                            dfValueReal = pafVals[iMaxVal];
-                            dfBandDensity = 1;                
-                            bHasFoundDensity = TRUE;
-                        }
-
-                        CPLFree( pafVals );
-                        CPLFree( panSums );
                     }
-                    
-                    else // byte or int16
-                    {
-                        int nMaxVal = 0, iMaxInd = -1;
 
-                        memset(panVals, 0, nBins*sizeof(int));
-                        
-                        for( iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++ )
-                        {
-                            for( iSrcX = iSrcXMin; iSrcX < iSrcXMax; iSrcX++ )
-                            {
-                                iSrcOffset = iSrcX + iSrcY * nSrcXSize;
-                                
-                                if( poWK->panUnifiedSrcValid != NULL
-                                    && !(poWK->panUnifiedSrcValid[iSrcOffset>>5]
-                                         & (0x01 << (iSrcOffset & 0x1f))) )
-                                    continue;
-                                
-                                nCount2++;
-                                if ( GWKGetPixelValue( poWK, iBand, iSrcOffset,
-                                                       &dfBandDensity, &dfValueRealTmp, &dfValueImagTmp ) && dfBandDensity > 0.0000000001 ) 
-                                {
-                                    nCount++;
-
-                                    int nVal = (int) dfValueRealTmp;
-                                    if ( ++panVals[nVal+nBinsOffset] > nMaxVal)
-                                    {
-                                        //Sum the density
-                                        //Is it the most common value so far?
-                                        iMaxInd = nVal;
-                                        nMaxVal = panVals[nVal+nBinsOffset];
-                                    }
-                                }
-                            }
-                        }
-                        
-                        if( iMaxInd != -1 )
-                        {
-                            dfValueReal = (float)iMaxInd;
-                            dfBandDensity = 1;                
-                            bHasFoundDensity = TRUE;                  
-                        }
+                    if( nCount > 0 )
+                    {
+                        dfValueReal = sBuf.padfVals[
+                            GWKModeOfValues( sBuf.padfVals, nCount, 
+                                             sBuf.panInts )];
+                        dfBandDensity = 1;                
+                        bHasFoundDensity = TRUE;
                     }
                     
                 } // GRA_Mode
@@ -5336,6 +5614,7 @@ static void GWKAverageOrModeThread( void* pData)
     CPLFree( padfZ2 );
     CPLFree( pabSuccess );
     CPLFree( pabSuccess2 );
-    if ( panVals ) CPLFree( panVals );
+    CPLFree( sBuf.padfVals );
+    CPLFree( sBuf.panInts );
 }
 
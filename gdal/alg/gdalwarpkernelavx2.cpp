@@ -0,0 +1,318 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  AVX2 versions of the bilinear and cubic warp kernels.
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal_alg_priv.h"
+
+/* This file is compiled with $(AVX2FLAGS), so nothing in it may be called */
+/* before GWKHaveRuntimeAVX2() has returned TRUE. */
+
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+#include <immintrin.h>
+#include <cpuid.h>
+
+CPL_CVSID("$Id$");
+
+/************************************************************************/
+/*                         GWKHaveRuntimeAVX2()                         */
+/************************************************************************/
+
+#define CPUID_OSXSAVE_ECX_BIT   27
+#define CPUID_AVX_ECX_BIT       28
+#define CPUID_AVX2_EBX_BIT      5
+
+#define BIT_XMM_STATE           (1 << 1)
+#define BIT_YMM_STATE           (2 << 1)
+
+static int GWKDetectRuntimeAVX2()
+{
+    unsigned int nEAX, nEBX, nECX, nEDX;
+
+    if( !__get_cpuid( 1, &nEAX, &nEBX, &nECX, &nEDX ) )
+        return FALSE;
+
+    /* Check OSXSAVE and AVX features */
+    if( (nECX & (1 << CPUID_OSXSAVE_ECX_BIT)) == 0
+        || (nECX & (1 << CPUID_AVX_ECX_BIT)) == 0 )
+        return FALSE;
+
+    /* Issue XGETBV and check the XMM and YMM state bit */
+    unsigned int nXCRLow;
+    unsigned int nXCRHigh;
+    __asm__ ("xgetbv" : "=a" (nXCRLow), "=d" (nXCRHigh) : "c" (0));
+    if( (nXCRLow & ( BIT_XMM_STATE | BIT_YMM_STATE )) !=
+                   ( BIT_XMM_STATE | BIT_YMM_STATE ) )
+        return FALSE;
+
+    /* Check AVX2 feature in the extended features leaf */
+    if( __get_cpuid_max( 0, NULL ) < 7 )
+        return FALSE;
+    __cpuid_count( 7, 0, nEAX, nEBX, nECX, nEDX );
+
+    return (nEBX & (1 << CPUID_AVX2_EBX_BIT)) != 0;
+}
+
+int GWKHaveRuntimeAVX2()
+{
+    static int nHaveAVX2 = -1;
+
+    if( nHaveAVX2 < 0 )
+        nHaveAVX2 = GWKDetectRuntimeAVX2();
+
+    return nHaveAVX2;
+}
+
+/************************************************************************/
+/*                           GWKLoad4AVX2()                             */
+/*                                                                      */
+/*      Load pSrc[panSrcOffset[0..3]] as 4 doubles.  Types that have    */
+/*      a 32 or 64 bit gather use it, the others are loaded one by      */
+/*      one (a 32 bit gather could read past the end of the buffer).    */
+/************************************************************************/
+
+template<class T>
+static CPL_INLINE __m256d GWKLoad4AVX2( const T *pSrc,
+                                        const int *panSrcOffset )
+{
+    return _mm256_set_pd( (double) pSrc[panSrcOffset[3]],
+                          (double) pSrc[panSrcOffset[2]],
+                          (double) pSrc[panSrcOffset[1]],
+                          (double) pSrc[panSrcOffset[0]] );
+}
+
+template<>
+CPL_INLINE __m256d GWKLoad4AVX2<GInt32>( const GInt32 *pSrc,
+                                         const int *panSrcOffset )
+{
+    return _mm256_cvtepi32_pd(
+        _mm_i32gather_epi32( (const int *) pSrc,
+                             _mm_loadu_si128( (const __m128i *) panSrcOffset ),
+                             4 ) );
+}
+
+template<>
+CPL_INLINE __m256d GWKLoad4AVX2<float>( const float *pSrc,
+                                        const int *panSrcOffset )
+{
+    return _mm256_cvtps_pd(
+        _mm_i32gather_ps( pSrc,
+                          _mm_loadu_si128( (const __m128i *) panSrcOffset ),
+                          4 ) );
+}
+
+template<>
+CPL_INLINE __m256d GWKLoad4AVX2<double>( const double *pSrc,
+                                         const int *panSrcOffset )
+{
+    /* The masked form avoids a -Wmaybe-uninitialized false positive */
+    /* in the _mm256_i32gather_pd() of some GCC versions */
+    return _mm256_mask_i32gather_pd(
+        _mm256_setzero_pd(), pSrc,
+        _mm_loadu_si128( (const __m128i *) panSrcOffset ),
+        _mm256_castsi256_pd( _mm256_set1_epi32( -1 ) ), 8 );
+}
+
+/************************************************************************/
+/*                      GWKCubicConvolutionAVX2()                       */
+/*                                                                      */
+/*      Four lanes version of the CubicConvolution() macro, evaluated   */
+/*      in the same order so that the result is bit identical.          */
+/************************************************************************/
+
+static CPL_INLINE __m256d GWKCubicConvolutionAVX2( __m256d d1, __m256d d2,
+                                                   __m256d d3,
+                                                   __m256d f0, __m256d f1,
+                                                   __m256d f2, __m256d f3 )
+{
+    const __m256d half = _mm256_set1_pd( 0.5 );
+    __m256d a, b, c;
+
+    a = _mm256_mul_pd( _mm256_mul_pd( d1, half ), _mm256_sub_pd( f2, f0 ) );
+    b = _mm256_sub_pd(
+            _mm256_add_pd(
+                _mm256_sub_pd( _mm256_mul_pd( _mm256_set1_pd( 2.0 ), f0 ),
+                               _mm256_mul_pd( _mm256_set1_pd( 5.0 ), f1 ) ),
+                _mm256_mul_pd( _mm256_set1_pd( 4.0 ), f2 ) ),
+            f3 );
+    b = _mm256_mul_pd( _mm256_mul_pd( d2, half ), b );
+    c = _mm256_sub_pd( _mm256_add_pd( _mm256_mul_pd( _mm256_set1_pd( 3.0 ),
+                                                     _mm256_sub_pd( f1, f2 ) ),
+                                      f3 ),
+                       f0 );
+    c = _mm256_mul_pd( _mm256_mul_pd( d3, half ), c );
+
+    return _mm256_add_pd( _mm256_add_pd( _mm256_add_pd( f1, a ), b ), c );
+}
+
+/************************************************************************/
+/*                    GWKResampleNoMasks8AVX2T()                        */
+/*                                                                      */
+/*      Bilinear or cubic interpolation of 8 destination pixels whose   */
+/*      whole kernel is inside the source window, 4 per AVX register.   */
+/*      Same operations, in the same order, as the SSE2 and scalar      */
+/*      versions in gdalwarpkernel.cpp.  padfValue receives the 8       */
+/*      unclamped values of band iBand at padfValue[iBand * 8].         */
+/************************************************************************/
+
+template<class T, int bCubic>
+static void GWKResampleNoMasks8AVX2T( int nBands, GByte * const *papabySrcImage,
+                                      int nSrcXSize,
+                                      const int *panSrcOffset,
+                                      const double *padfWeightX,
+                                      const double *padfWeightY,
+                                      double *padfValue )
+
+{
+    __m256d aW1[2], aW2[2], aW3[2], aW4[2], aW5[2], aW6[2];
+    const __m256d one = _mm256_set1_pd( 1.0 );
+    int     h;
+
+/* -------------------------------------------------------------------- */
+/*      Compute the weights shared by all bands.                        */
+/* -------------------------------------------------------------------- */
+    for( h = 0; h < 2; h++ )
+    {
+        __m256d wx = _mm256_loadu_pd( padfWeightX + 4 * h );
+        __m256d wy = _mm256_loadu_pd( padfWeightY + 4 * h );
+
+        if( !bCubic )
+        {
+            __m256d omwx = _mm256_sub_pd( one, wx );
+            __m256d omwy = _mm256_sub_pd( one, wy );
+
+            aW1[h] = _mm256_mul_pd( wx, wy );      // upper left
+            aW2[h] = _mm256_mul_pd( omwx, wy );    // upper right
+            aW3[h] = _mm256_mul_pd( omwx, omwy );  // lower right
+            aW4[h] = _mm256_mul_pd( wx, omwy );    // lower left
+            aW5[h] = _mm256_add_pd( _mm256_add_pd( _mm256_add_pd(
+                _mm256_add_pd( _mm256_setzero_pd(), aW1[h] ), aW2[h] ),
+                aW3[h] ), aW4[h] );
+        }
+        else
+        {
+            aW1[h] = wx;
+            aW2[h] = _mm256_mul_pd( wx, wx );
+            aW3[h] = _mm256_mul_pd( aW2[h], wx );
+            aW4[h] = wy;
+            aW5[h] = _mm256_mul_pd( wy, wy );
+            aW6[h] = _mm256_mul_pd( aW5[h], wy );
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Interpolate each band.                                          */
+/* -------------------------------------------------------------------- */
+    int     iBand;
+
+    for( iBand = 0; iBand < nBands; iBand++ )
+    {
+        const T *pSrc = (const T *) papabySrcImage[iBand];
+
+        for( h = 0; h < 2; h++ )
+        {
+            const int *panOff = panSrcOffset + 4 * h;
+
+            if( !bCubic )
+            {
+                __m256d acc = _mm256_setzero_pd();
+
+                acc = _mm256_add_pd( acc, _mm256_mul_pd( aW1[h],
+                    GWKLoad4AVX2( pSrc, panOff ) ) );
+                acc = _mm256_add_pd( acc, _mm256_mul_pd( aW2[h],
+                    GWKLoad4AVX2( pSrc + 1, panOff ) ) );
+                acc = _mm256_add_pd( acc, _mm256_mul_pd( aW3[h],
+                    GWKLoad4AVX2( pSrc + 1 + nSrcXSize, panOff ) ) );
+                acc = _mm256_add_pd( acc, _mm256_mul_pd( aW4[h],
+                    GWKLoad4AVX2( pSrc + nSrcXSize, panOff ) ) );
+
+                _mm256_storeu_pd( padfValue + iBand * 8 + 4 * h,
+                                  _mm256_div_pd( acc, aW5[h] ) );
+            }
+            else
+            {
+                __m256d aRow[4];
+                int     i;
+
+                for( i = 0; i < 4; i++ )
+                {
+                    const T *pRow = pSrc + (i - 1) * nSrcXSize;
+
+                    aRow[i] = GWKCubicConvolutionAVX2(
+                        aW1[h], aW2[h], aW3[h],
+                        GWKLoad4AVX2( pRow - 1, panOff ),
+                        GWKLoad4AVX2( pRow, panOff ),
+                        GWKLoad4AVX2( pRow + 1, panOff ),
+                        GWKLoad4AVX2( pRow + 2, panOff ) );
+                }
+
+                _mm256_storeu_pd( padfValue + iBand * 8 + 4 * h,
+                                  GWKCubicConvolutionAVX2( aW4[h], aW5[h],
+                                                           aW6[h],
+                                                           aRow[0], aRow[1],
+                                                           aRow[2], aRow[3] ) );
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                    GWKGetResampleNoMasks8AVX2()                      */
+/************************************************************************/
+
+template<int bCubic>
+static GWKResampleNoMasks8Func GWKGetResampleNoMasks8AVX2T( GDALDataType eType )
+{
+    switch( eType )
+    {
+      case GDT_Byte:
+        return GWKResampleNoMasks8AVX2T<GByte, bCubic>;
+      case GDT_Int16:
+        return GWKResampleNoMasks8AVX2T<GInt16, bCubic>;
+      case GDT_UInt16:
+        return GWKResampleNoMasks8AVX2T<GUInt16, bCubic>;
+      case GDT_Int32:
+        return GWKResampleNoMasks8AVX2T<GInt32, bCubic>;
+      case GDT_UInt32:
+        return GWKResampleNoMasks8AVX2T<GUInt32, bCubic>;
+      case GDT_Float32:
+        return GWKResampleNoMasks8AVX2T<float, bCubic>;
+      case GDT_Float64:
+        return GWKResampleNoMasks8AVX2T<double, bCubic>;
+      default:
+        return NULL;
+    }
+}
+
+GWKResampleNoMasks8Func GWKGetResampleNoMasks8AVX2( GDALDataType eType,
+                                                    int bCubic )
+{
+    if( bCubic )
+        return GWKGetResampleNoMasks8AVX2T<TRUE>( eType );
+    else
+        return GWKGetResampleNoMasks8AVX2T<FALSE>( eType );
+}
+
+#endif /* HAVE_AVX2_AT_COMPILE_TIME */
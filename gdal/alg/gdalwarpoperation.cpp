@@ -31,6 +31,7 @@
 #include "cpl_string.h"
 #include "cpl_multiproc.h"
 #include "ogr_api.h"
+#include "gdal_alg_priv.h"
 
 CPL_CVSID("$Id$");
 
@@ -121,6 +122,8 @@ GDALWarpOperation::GDALWarpOperation()
 {
     psOptions = NULL;
 
+    hPreparedCutline = NULL;
+
     hIOMutex = NULL;
     hWarpMutex = NULL;
 
@@ -142,10 +145,9 @@ GDALWarpOperation::~GDALWarpOperation()
     WipeOptions();
 
     if( hIOMutex != NULL )
-    {
         CPLDestroyMutex( hIOMutex );
+    if( hWarpMutex != NULL )
         CPLDestroyMutex( hWarpMutex );
-    }
 
     WipeChunkList();
 }
@@ -172,6 +174,12 @@ void GDALWarpOperation::WipeOptions()
         GDALDestroyWarpOptions( psOptions );
         psOptions = NULL;
     }
+
+    if( hPreparedCutline != NULL )
+    {
+        GDALWarpDestroyPreparedCutline( hPreparedCutline );
+        hPreparedCutline = NULL;
+    }
 }
 
 /************************************************************************/
@@ -565,6 +573,18 @@ CPLErr GDALWarpOperation::Initialize( const GDALWarpOptions *psNewOptions )
     if( !ValidateOptions() )
         eErr = CE_Failure;
 
+/* -------------------------------------------------------------------- */
+/*      Prepare the cutline once, rather than rasterizing it again      */
+/*      for each chunk.                                                 */
+/* -------------------------------------------------------------------- */
+    if( eErr == CE_None && psOptions->hCutline != NULL )
+    {
+        hPreparedCutline = 
+            GDALWarpPrepareCutline( (OGRGeometryH) psOptions->hCutline );
+        if( hPreparedCutline == NULL )
+            eErr = CE_Failure;
+    }
+
     if( eErr != CE_None )
         WipeOptions();
 
@@ -738,60 +758,183 @@ CPLErr GDALChunkAndWarpImage( GDALWarpOperationH hOperation,
 /*                          ChunkThreadMain()                           */
 /************************************************************************/
 
+struct ChunkThreadData;
+
+/* State shared by the chunk threads of ChunkAndWarpMulti() */
 typedef struct
 {
     GDALWarpOperation *poOperation;
-    int               *panChunkInfo;
-    void              *hThreadHandle;
-    CPLErr             eErr;
-    double             dfProgressBase;
-    double             dfProgressScale;
+    int               *panChunkList;
+    int                nChunkListCount;
     void              *hIOMutex;
 
+    /* Protects all the following members, and the progress members */
+    /* of the thread data */
     void              *hCondMutex;
-    int                bIOMutexTaken;
     void              *hCond;
-} ChunkThreadData;
+    int                nNextChunk;
+    int                nNextChunkToWrite;
+    int                bStop;
+    CPLErr             eErr;
+
+    GDALProgressFunc   pfnProgress;
+    void              *pProgressArg;
+    double             dfTotalPixels;
+    double             dfPixelsDone;
+    int                nThreads;
+    ChunkThreadData   *pasThreadData;
+} ChunkSchedulerData;
 
+struct ChunkThreadData
+{
+    ChunkSchedulerData *psScheduler;
+    void              *hThreadHandle;
+    void              *pTransformerArg;
+    char             **papszWarpOptions;
+    int                iChunk;
+    double             dfChunkPixels;
+    double             dfChunkProgress;
+};
+
+/************************************************************************/
+/*                          ChunkProgress()                             */
+/*                                                                      */
+/*      Progress function given to the warp kernels of the chunk        */
+/*      threads.  It reports the pixels of the finished chunks plus     */
+/*      the completed part of the chunks being warped.                  */
+/************************************************************************/
 
-static void ChunkThreadMain( void *pThreadData )
+static int CPL_STDCALL ChunkProgress( double dfComplete, const char *pszMessage,
+                                      void *pProgressArg )
 
 {
-    volatile ChunkThreadData* psData = (volatile ChunkThreadData*) pThreadData;
+    ChunkThreadData* psThread = (ChunkThreadData*) pProgressArg;
+    ChunkSchedulerData* psScheduler = psThread->psScheduler;
+    int i;
 
-    int *panChunkInfo = psData->panChunkInfo;
+    CPLAcquireMutex( psScheduler->hCondMutex, 1000.0 );
 
-/* -------------------------------------------------------------------- */
-/*      Acquire IO mutex.                                               */
-/* -------------------------------------------------------------------- */
-    if( !CPLAcquireMutex( psData->hIOMutex, 600.0 ) )
+    psThread->dfChunkProgress = MIN(1.0, MAX(0.0, dfComplete));
+
+    double dfPixelsDone = psScheduler->dfPixelsDone;
+    for( i = 0; i < psScheduler->nThreads; i++ )
+        dfPixelsDone += psScheduler->pasThreadData[i].dfChunkPixels
+            * psScheduler->pasThreadData[i].dfChunkProgress;
+
+    if( !psScheduler->bStop &&
+        !psScheduler->pfnProgress( dfPixelsDone / psScheduler->dfTotalPixels,
+                                   pszMessage, psScheduler->pProgressArg ) )
     {
-        CPLError( CE_Failure, CPLE_AppDefined,
-                    "Failed to acquire IOMutex in WarpRegion()." );
-        psData->eErr = CE_Failure;
+        psScheduler->bStop = TRUE;
+        CPLCondBroadcast( psScheduler->hCond );
     }
-    else
+
+    int bContinue = !psScheduler->bStop;
+
+    CPLReleaseMutex( psScheduler->hCondMutex );
+
+    return bContinue;
+}
+
+/************************************************************************/
+/*                        WaitForChunkWriteTurn()                       */
+/*                                                                      */
+/*      Chunks are written to the destination in the order of the      */
+/*      chunk list, so that tiles and strips are completed one after    */
+/*      the other.  Returns FALSE if the operation was interrupted.     */
+/************************************************************************/
+
+static int WaitForChunkWriteTurn( ChunkThreadData *psThread )
+
+{
+    ChunkSchedulerData* psScheduler = psThread->psScheduler;
+
+    CPLAcquireMutex( psScheduler->hCondMutex, 1000.0 );
+    while( psScheduler->nNextChunkToWrite != psThread->iChunk &&
+           !psScheduler->bStop )
+        CPLCondWait( psScheduler->hCond, psScheduler->hCondMutex );
+    int bContinue = !psScheduler->bStop;
+    CPLReleaseMutex( psScheduler->hCondMutex );
+
+    return bContinue;
+}
+
+void GDALWarpOperation::ChunkThreadMain( void *pThreadData )
+
+{
+    ChunkThreadData* psThread = (ChunkThreadData*) pThreadData;
+    ChunkSchedulerData* psScheduler = psThread->psScheduler;
+
+    while( TRUE )
     {
-        if (psData->hCond != NULL)
+/* -------------------------------------------------------------------- */
+/*      Pick the next chunk to process.                                 */
+/* -------------------------------------------------------------------- */
+        CPLAcquireMutex( psScheduler->hCondMutex, 1000.0 );
+        if( psScheduler->bStop ||
+            psScheduler->nNextChunk == psScheduler->nChunkListCount )
         {
-            CPLAcquireMutex( psData->hCondMutex, 1.0 );
-            psData->bIOMutexTaken = TRUE;
-            CPLCondSignal(psData->hCond);
-            CPLReleaseMutex( psData->hCondMutex );
+            CPLReleaseMutex( psScheduler->hCondMutex );
+            break;
         }
+        int iChunk = psScheduler->nNextChunk ++;
+        int *panChunkInfo = psScheduler->panChunkList + iChunk*8;
+        psThread->iChunk = iChunk;
+        psThread->dfChunkPixels = panChunkInfo[2] * (double) panChunkInfo[3];
+        psThread->dfChunkProgress = 0.0;
+        CPLReleaseMutex( psScheduler->hCondMutex );
+
+        CPLDebug( "GDAL", "Start chunk %d.", iChunk );
+
+/* -------------------------------------------------------------------- */
+/*      Warp it.  All dataset accesses are done while holding the IO    */
+/*      mutex, which WarpRegionToBufferInternal() releases during the   */
+/*      warp kernel.                                                    */
+/* -------------------------------------------------------------------- */
+        CPLErr eErr;
 
-        psData->eErr = psData->poOperation->WarpRegion(
+        if( !CPLAcquireMutex( psScheduler->hIOMutex, 600.0 ) )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "Failed to acquire IOMutex in WarpRegion()." );
+            eErr = CE_Failure;
+        }
+        else
+        {
+            eErr = psScheduler->poOperation->WarpRegionInternal(
                                     panChunkInfo[0], panChunkInfo[1],
                                     panChunkInfo[2], panChunkInfo[3],
                                     panChunkInfo[4], panChunkInfo[5],
                                     panChunkInfo[6], panChunkInfo[7],
-                                    psData->dfProgressBase,
-                                    psData->dfProgressScale);
+                                    0.0, 1.0, psThread );
+
+            CPLReleaseMutex( psScheduler->hIOMutex );
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Let the next chunk be written, or stop everything on error.     */
+/* -------------------------------------------------------------------- */
+        CPLAcquireMutex( psScheduler->hCondMutex, 1000.0 );
+        if( eErr != CE_None )
+        {
+            if( psScheduler->eErr == CE_None )
+                psScheduler->eErr = eErr;
+            psScheduler->bStop = TRUE;
+        }
+        else
+        {
+            psScheduler->nNextChunkToWrite = iChunk + 1;
+            psScheduler->dfPixelsDone += psThread->dfChunkPixels;
+        }
+        psThread->dfChunkPixels = 0.0;
+        psThread->dfChunkProgress = 0.0;
+        CPLCondBroadcast( psScheduler->hCond );
+        CPLReleaseMutex( psScheduler->hCondMutex );
 
-    /* -------------------------------------------------------------------- */
-    /*      Release the IO mutex.                                           */
-    /* -------------------------------------------------------------------- */
-        CPLReleaseMutex( psData->hIOMutex );
+        CPLDebug( "GDAL", "Finished chunk %d.", iChunk );
+
+        if( eErr != CE_None )
+            break;
     }
 }
 
@@ -809,7 +952,16 @@ static void ChunkThreadMain( void *pThreadData )
  *
  * Externally this method operates the same as ChunkAndWarpImage(), but
  * internally this method uses multiple threads to interleave input/output
- * for one region while the processing is being done for another.
+ * for some regions while the processing is being done for others.
+ *
+ * The number of threads is given by the NUM_THREADS warp option (or the
+ * GDAL_NUM_THREADS configuration option), with a minimum and a default of 2.
+ * Each thread takes the next chunk to process, reads it, warps it and
+ * writes it, dataset accesses being serialized between threads.  Chunks are
+ * written in top to bottom, left to right order.  When there are fewer
+ * chunks than threads, the remaining threads are used inside the warp
+ * kernel.  The memory limit is shared between the threads beyond the
+ * second one.
  *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
@@ -823,129 +975,182 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(
     int nDstXOff, int nDstYOff,  int nDstXSize, int nDstYSize )
 
 {
-    hIOMutex = CPLCreateMutex();
-    hWarpMutex = CPLCreateMutex();
+    int i;
 
-    CPLReleaseMutex( hIOMutex );
-    CPLReleaseMutex( hWarpMutex );
+/* -------------------------------------------------------------------- */
+/*      How many threads ?                                              */
+/* -------------------------------------------------------------------- */
+    const char* pszWarpThreads =
+        CSLFetchNameValue( psOptions->papszWarpOptions, "NUM_THREADS" );
+    if( pszWarpThreads == NULL )
+        pszWarpThreads = CPLGetConfigOption( "GDAL_NUM_THREADS", "2" );
 
-    void* hCond = CPLCreateCond();
-    void* hCondMutex = CPLCreateMutex();
-    CPLReleaseMutex(hCondMutex);
+    int nThreads;
+    if( EQUAL(pszWarpThreads, "ALL_CPUS") )
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszWarpThreads);
+    nThreads = MAX(2, MIN(128, nThreads));
 
 /* -------------------------------------------------------------------- */
-/*      Collect the list of chunks to operate on.                       */
+/*      Collect the list of chunks to operate on.  Each thread holds    */
+/*      its own chunk buffers, so share the memory limit between        */
+/*      threads beyond the two that the previous implementation used.   */
 /* -------------------------------------------------------------------- */
+    double dfWarpMemoryLimit = psOptions->dfWarpMemoryLimit;
+    psOptions->dfWarpMemoryLimit = dfWarpMemoryLimit / (nThreads / 2);
+
     WipeChunkList();
     CollectChunkList( nDstXOff, nDstYOff, nDstXSize, nDstYSize );
 
+    psOptions->dfWarpMemoryLimit = dfWarpMemoryLimit;
+
     /* Sort chucks from top to bottom, and for equal y, from left to right */
     qsort(panChunkList, nChunkListCount, sizeof(WarpChunk), OrderWarpChunk); 
 
-/* -------------------------------------------------------------------- */
-/*      Process them one at a time, updating the progress               */
-/*      information for each region.                                    */
-/* -------------------------------------------------------------------- */
-    ChunkThreadData volatile asThreadData[2];
-    memset((void*)&asThreadData, 0, sizeof(asThreadData));
-    asThreadData[0].poOperation = this;
-    asThreadData[0].hIOMutex = hIOMutex;
-    asThreadData[1].poOperation = this;
-    asThreadData[1].hIOMutex = hIOMutex;
-
-    int iChunk;
-    double dfPixelsProcessed=0.0, dfTotalPixels = nDstXSize*(double)nDstYSize;
-
-    CPLErr eErr = CE_None;
-    for( iChunk = 0; iChunk < nChunkListCount+1; iChunk++ )
+    if( nChunkListCount == 0 )
     {
-        int    iThread = iChunk % 2;
+        WipeChunkList();
+        return CE_None;
+    }
+
+    int nChunkThreads = MIN(nThreads, nChunkListCount);
+    int nKernelThreads = MAX(1, nThreads / nChunkThreads);
 
 /* -------------------------------------------------------------------- */
-/*      Launch thread for this chunk.                                   */
+/*      Give its own transformer to each thread so that the warp        */
+/*      kernels can run concurrently.  If the transformer cannot be     */
+/*      cloned, or if user chunk processors are installed, the warp     */
+/*      kernels are serialized by the warp mutex.                       */
 /* -------------------------------------------------------------------- */
-        if( iChunk < nChunkListCount )
-        {
-            int *panThisChunk = panChunkList + iChunk*8;
-            double dfChunkPixels = panThisChunk[2] * (double) panThisChunk[3];
-
-            asThreadData[iThread].dfProgressBase = dfPixelsProcessed / dfTotalPixels;
-            asThreadData[iThread].dfProgressScale = dfChunkPixels / dfTotalPixels;
-
-            dfPixelsProcessed += dfChunkPixels;
-
-            asThreadData[iThread].panChunkInfo = panThisChunk;
-
-            if ( iChunk == 0 )
-            {
-                asThreadData[iThread].hCond = hCond;
-                asThreadData[iThread].hCondMutex = hCondMutex;
-            }
-            else
-            {
-                asThreadData[iThread].hCond = NULL;
-                asThreadData[iThread].hCondMutex = NULL;
-            }
-            asThreadData[iThread].bIOMutexTaken = FALSE;
+    ChunkThreadData* pasThreadData = (ChunkThreadData*)
+        CPLCalloc( nChunkThreads, sizeof(ChunkThreadData) );
 
-            CPLDebug( "GDAL", "Start chunk %d.", iChunk );
-            asThreadData[iThread].hThreadHandle =
-                CPLCreateJoinableThread( ChunkThreadMain, (void*) &asThreadData[iThread] );
-            if( asThreadData[iThread].hThreadHandle == NULL )
+    int bConcurrentKernels = psOptions->pfnPreWarpChunkProcessor == NULL &&
+                             psOptions->pfnPostWarpChunkProcessor == NULL;
+    if( !bConcurrentKernels )
+        nKernelThreads = nThreads;
+    else
+    {
+        CPLPushErrorHandler( CPLQuietErrorHandler );
+        for( i = 0; i < nChunkThreads && bConcurrentKernels; i++ )
+        {
+            pasThreadData[i].pTransformerArg =
+                GDALCloneTransformer( psOptions->pTransformerArg );
+            if( pasThreadData[i].pTransformerArg == NULL )
             {
-                CPLError( CE_Failure, CPLE_AppDefined, 
-                          "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()" );
-                eErr = CE_Failure;
-                break;
+                CPLDebug( "WARP", "Cannot duplicate transformer function. "
+                          "Warp kernels of the chunks will be serialized" );
+                bConcurrentKernels = FALSE;
+                /* The warp kernel cannot clone it either */
+                nKernelThreads = 1;
             }
+        }
+        CPLPopErrorHandler();
+    }
 
-            /* Wait that the first thread has acquired the IO mutex before proceeding. */
-            /* (This will ensure that the first thread will run before the second one). */
-            if( iChunk == 0 )
-            {
-                CPLAcquireMutex(hCondMutex, 1.0);
-                while (asThreadData[iThread].bIOMutexTaken == FALSE)
-                    CPLCondWait(hCond, hCondMutex);
-                CPLReleaseMutex(hCondMutex);
-            }
+    if( !bConcurrentKernels )
+    {
+        for( i = 0; i < nChunkThreads; i++ )
+        {
+            if( pasThreadData[i].pTransformerArg != NULL )
+                GDALDestroyTransformer( pasThreadData[i].pTransformerArg );
+            pasThreadData[i].pTransformerArg = psOptions->pTransformerArg;
         }
+    }
+
+    hIOMutex = CPLCreateMutex();
+    CPLReleaseMutex( hIOMutex );
+    if( !bConcurrentKernels )
+    {
+        hWarpMutex = CPLCreateMutex();
+        CPLReleaseMutex( hWarpMutex );
+    }
+
+    ChunkSchedulerData sScheduler;
+    memset( &sScheduler, 0, sizeof(sScheduler) );
+    sScheduler.poOperation = this;
+    sScheduler.panChunkList = panChunkList;
+    sScheduler.nChunkListCount = nChunkListCount;
+    sScheduler.hIOMutex = hIOMutex;
+    sScheduler.hCond = CPLCreateCond();
+    sScheduler.hCondMutex = CPLCreateMutex();
+    CPLReleaseMutex( sScheduler.hCondMutex );
+    sScheduler.eErr = CE_None;
+    sScheduler.pfnProgress = psOptions->pfnProgress;
+    sScheduler.pProgressArg = psOptions->pProgressArg;
+    sScheduler.dfTotalPixels = nDstXSize * (double) nDstYSize;
+    sScheduler.nThreads = nChunkThreads;
+    sScheduler.pasThreadData = pasThreadData;
+
+    CPLDebug( "WARP", "Using %d chunk threads, and %d threads per warp kernel",
+              nChunkThreads, nKernelThreads );
 
-        
 /* -------------------------------------------------------------------- */
-/*      Wait for previous chunks thread to complete.                    */
+/*      Launch the threads and wait for them to complete.               */
 /* -------------------------------------------------------------------- */
-        if( iChunk > 0 )
+    CPLErr eErr = CE_None;
+    int nLaunched = 0;
+
+    for( i = 0; i < nChunkThreads; i++ )
+    {
+        pasThreadData[i].psScheduler = &sScheduler;
+        pasThreadData[i].papszWarpOptions =
+            CSLSetNameValue( CSLDuplicate( psOptions->papszWarpOptions ),
+                             "NUM_THREADS",
+                             CPLSPrintf( "%d", nKernelThreads ) );
+        pasThreadData[i].hThreadHandle =
+            CPLCreateJoinableThread( ChunkThreadMain, &pasThreadData[i] );
+        if( pasThreadData[i].hThreadHandle == NULL )
         {
-            iThread = (iChunk-1) % 2;
-            
-            /* Wait for thread to finish. */
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
-            asThreadData[iThread].hThreadHandle = NULL;
-
-            CPLDebug( "GDAL", "Finished chunk %d.", iChunk-1 );
-
-            eErr = asThreadData[iThread].eErr;
+            CPLError( CE_Failure, CPLE_AppDefined, 
+                      "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()" );
+            eErr = CE_Failure;
 
-            if( eErr != CE_None )
-                break;
+            CPLAcquireMutex( sScheduler.hCondMutex, 1000.0 );
+            sScheduler.bStop = TRUE;
+            CPLCondBroadcast( sScheduler.hCond );
+            CPLReleaseMutex( sScheduler.hCondMutex );
+            break;
         }
+        nLaunched ++;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Wait for all threads to complete.                               */
-    /* -------------------------------------------------------------------- */
-    int iThread;
-    for(iThread = 0; iThread < 2; iThread ++)
+    for( i = 0; i < nLaunched; i++ )
+        CPLJoinThread( pasThreadData[i].hThreadHandle );
+
+    if( eErr == CE_None )
+        eErr = sScheduler.eErr;
+    if( eErr == CE_None && sScheduler.bStop )
+        eErr = CE_Failure;
+
+/* -------------------------------------------------------------------- */
+/*      Cleanup.                                                        */
+/* -------------------------------------------------------------------- */
+    for( i = 0; i < nChunkThreads; i++ )
     {
-        if (asThreadData[iThread].hThreadHandle)
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
+        if( bConcurrentKernels )
+            GDALDestroyTransformer( pasThreadData[i].pTransformerArg );
+        CSLDestroy( pasThreadData[i].papszWarpOptions );
     }
+    CPLFree( pasThreadData );
 
-    CPLDestroyCond(hCond);
-    CPLDestroyMutex(hCondMutex);
+    CPLDestroyCond( sScheduler.hCond );
+    CPLDestroyMutex( sScheduler.hCondMutex );
+
+    CPLDestroyMutex( hIOMutex );
+    hIOMutex = NULL;
+    if( hWarpMutex != NULL )
+    {
+        CPLDestroyMutex( hWarpMutex );
+        hWarpMutex = NULL;
+    }
 
     WipeChunkList();
 
+    if( eErr == CE_None )
+        psOptions->pfnProgress( 1.00001, "", psOptions->pProgressArg );
+
     return eErr;
 }
 
@@ -1206,6 +1411,27 @@ CPLErr GDALWarpOperation::WarpRegion( int nDstXOff, int nDstYOff,
                                       double dfProgressBase,
                                       double dfProgressScale)
 
+{
+    return WarpRegionInternal( nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                               nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
+                               dfProgressBase, dfProgressScale, NULL );
+}
+
+/************************************************************************/
+/*                         WarpRegionInternal()                         */
+/*                                                                      */
+/*      pChunkThreadData is the ChunkThreadData of the calling thread   */
+/*      when called from ChunkAndWarpMulti(), or NULL.                  */
+/************************************************************************/
+
+CPLErr GDALWarpOperation::WarpRegionInternal( int nDstXOff, int nDstYOff,
+                                              int nDstXSize, int nDstYSize,
+                                              int nSrcXOff, int nSrcYOff,
+                                              int nSrcXSize, int nSrcYSize,
+                                              double dfProgressBase,
+                                              double dfProgressScale,
+                                              void *pChunkThreadData )
+
 {
     CPLErr eErr;
     int   iBand;
@@ -1327,10 +1553,12 @@ CPLErr GDALWarpOperation::WarpRegion( int nDstXOff, int nDstYOff,
 /* -------------------------------------------------------------------- */
 /*      Perform the warp.                                               */
 /* -------------------------------------------------------------------- */
-    eErr = WarpRegionToBuffer( nDstXOff, nDstYOff, nDstXSize, nDstYSize, 
-                               pDstBuffer, psOptions->eWorkingDataType, 
-                               nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
-                               dfProgressBase, dfProgressScale);
+    eErr = WarpRegionToBufferInternal( nDstXOff, nDstYOff,
+                                       nDstXSize, nDstYSize,
+                                       pDstBuffer, psOptions->eWorkingDataType,
+                                       nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
+                                       dfProgressBase, dfProgressScale,
+                                       pChunkThreadData );
 
 /* -------------------------------------------------------------------- */
 /*      Write the output data back to disk if all went well.            */
@@ -1436,9 +1664,27 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     int nSrcXOff, int nSrcYOff, int nSrcXSize, int nSrcYSize,
     double dfProgressBase, double dfProgressScale)
 
+{
+    return WarpRegionToBufferInternal( nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                                       pDataBuf, eBufDataType,
+                                       nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
+                                       dfProgressBase, dfProgressScale, NULL );
+}
+
+/************************************************************************/
+/*                     WarpRegionToBufferInternal()                     */
+/************************************************************************/
+
+CPLErr GDALWarpOperation::WarpRegionToBufferInternal( 
+    int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, 
+    void *pDataBuf, GDALDataType eBufDataType,
+    int nSrcXOff, int nSrcYOff, int nSrcXSize, int nSrcYSize,
+    double dfProgressBase, double dfProgressScale, void *pChunkThreadData )
+
 {
     CPLErr eErr = CE_None;
     int    i;
+    ChunkThreadData *psThread = (ChunkThreadData *) pChunkThreadData;
     int    nWordSize = GDALGetDataTypeSize(psOptions->eWorkingDataType)/8;
 
     (void) eBufDataType;
@@ -1475,6 +1721,16 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     oWK.dfProgressScale = dfProgressScale;
 
     oWK.papszWarpOptions = psOptions->papszWarpOptions;
+
+    /* In ChunkAndWarpMulti(), each thread has its own transformer, */
+    /* options and progress state */
+    if( psThread != NULL )
+    {
+        oWK.pTransformerArg = psThread->pTransformerArg;
+        oWK.pfnProgress = ChunkProgress;
+        oWK.pProgress = psThread;
+        oWK.papszWarpOptions = psThread->papszWarpOptions;
+    }
     
     oWK.padfDstNoDataReal = psOptions->padfDstNoDataReal;
 
@@ -1593,13 +1849,13 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
         
         if( eErr == CE_None )
             eErr = 
-                GDALWarpCutlineMasker( psOptions, 
-                                       psOptions->nBandCount, 
-                                       psOptions->eWorkingDataType,
-                                       oWK.nSrcXOff, oWK.nSrcYOff, 
-                                       oWK.nSrcXSize, oWK.nSrcYSize,
-                                       oWK.papabySrcImage,
-                                       TRUE, oWK.pafUnifiedSrcDensity );
+                GDALWarpCutlineMaskerEx( psOptions, hPreparedCutline,
+                                         psOptions->nBandCount, 
+                                         psOptions->eWorkingDataType,
+                                         oWK.nSrcXOff, oWK.nSrcYOff, 
+                                         oWK.nSrcXSize, oWK.nSrcYSize,
+                                         oWK.papabySrcImage,
+                                         TRUE, oWK.pafUnifiedSrcDensity );
     }
     
 /* -------------------------------------------------------------------- */
@@ -1767,14 +2023,19 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 /* -------------------------------------------------------------------- */
 /*      Release IO Mutex, and acquire warper mutex.                     */
 /* -------------------------------------------------------------------- */
-    if( hIOMutex != NULL )
+    int bWarpMutexHeld = FALSE;
+    if( psThread != NULL )
     {
         CPLReleaseMutex( hIOMutex );
-        if( !CPLAcquireMutex( hWarpMutex, 600.0 ) )
+        if( hWarpMutex != NULL )
         {
-            CPLError( CE_Failure, CPLE_AppDefined, 
-                      "Failed to acquire WarpMutex in WarpRegion()." );
-            return CE_Failure;
+            bWarpMutexHeld = CPLAcquireMutex( hWarpMutex, 600.0 );
+            if( !bWarpMutexHeld )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined, 
+                          "Failed to acquire WarpMutex in WarpRegion()." );
+                eErr = CE_Failure;
+            }
         }
     }
 
@@ -1802,11 +2063,15 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
             (void *) &oWK, psOptions->pPostWarpProcessorArg );
 
 /* -------------------------------------------------------------------- */
-/*      Release Warp Mutex, and acquire io mutex.                       */
+/*      Release Warp Mutex, wait for the previous chunks to be          */
+/*      written, and acquire io mutex.                                  */
 /* -------------------------------------------------------------------- */
-    if( hIOMutex != NULL )
+    if( psThread != NULL )
     {
-        CPLReleaseMutex( hWarpMutex );
+        if( bWarpMutexHeld )
+            CPLReleaseMutex( hWarpMutex );
+        if( !WaitForChunkWriteTurn( psThread ) )
+            eErr = CE_Failure;
         if( !CPLAcquireMutex( hIOMutex, 600.0 ) )
         {
             CPLError( CE_Failure, CPLE_AppDefined, 
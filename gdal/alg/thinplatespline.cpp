@@ -56,12 +56,12 @@ VizGeorefSpline2D* viz_llz2xy;
 /////////////////////////////////////////////////////////////////////////////////////
 
 #define A(r,c) _AA[ _nof_eqs * (r) + (c) ]
-#define Ainv(r,c) _Ainv[ _nof_eqs * (r) + (c) ]
 
 
 #define VIZ_GEOREF_SPLINE_DEBUG 0
 
-static int matrixInvert( int N, double input[], double output[] );
+static int matrixSolve( int N, int nRHS, double A[], double *rhs[],
+                        double *coef[] );
 
 void VizGeorefSpline2D::grow_points()
 
@@ -175,7 +175,7 @@ int VizGeorefSpline2D::delete_point(const double Px, const double Py )
 
 int VizGeorefSpline2D::solve(void)
 {
-    int r, c, v;
+    int r, c;
     int p;
 	
     //	No points at all
@@ -282,8 +282,6 @@ int VizGeorefSpline2D::solve(void)
     // Make the necessary memory allocations
     if ( _AA )
         CPLFree(_AA);
-    if ( _Ainv )
-        CPLFree(_Ainv);
 	
     _nof_eqs = _nof_points + 3;
     
@@ -294,9 +292,8 @@ int VizGeorefSpline2D::solve(void)
     }
 	
     _AA = ( double * )VSICalloc( _nof_eqs * _nof_eqs, sizeof( double ) );
-    _Ainv = ( double * )VSICalloc( _nof_eqs * _nof_eqs, sizeof( double ) );
     
-    if( _AA == NULL || _Ainv == NULL )
+    if( _AA == NULL )
     {
         fprintf(stderr, "Out-of-memory while allocating temporary arrays. Computation aborted.\n");
         return 0;
@@ -337,23 +334,18 @@ int VizGeorefSpline2D::solve(void)
 			
 #endif
 			
-    // Invert the matrix
-    int status = matrixInvert( _nof_eqs, _AA, _Ainv );
+    // Solve for the coefs.  This overwrites the matrix, which is not
+    // needed afterwards.
+    int status = matrixSolve( _nof_eqs, _nof_vars, _AA, rhs, coef );
+
+    CPLFree( _AA );
+    _AA = NULL;
 			
     if ( !status )
     {
         fprintf(stderr, " There is a problem to invert the interpolation matrix\n");
         return 0;
     }
-			
-    // calc the coefs
-    for ( v = 0; v < _nof_vars; v++ )
-        for ( r = 0; r < _nof_eqs; r++ )
-        {
-            coef[v][r] = 0.0;
-            for ( c = 0; c < _nof_eqs; c++ )
-                coef[v][r] += Ainv(r,c) * rhs[v][c];
-        }
 				
     return(4);
 }
@@ -412,6 +404,34 @@ int VizGeorefSpline2D::get_point( const double Px, const double Py, double *vars
 		for ( v = 0; v < _nof_vars; v++ )
 			vars[v] = coef[v][0] + coef[v][1] * Px + coef[v][2] * Py;
 		
+		if ( _nof_vars == 2 )
+		{
+			// Same computation as below, with base_func() inlined
+			// and the accumulators kept in registers.
+			double dfVar0 = vars[0], dfVar1 = vars[1];
+			const double *padfCoef0 = coef[0] + 3;
+			const double *padfCoef1 = coef[1] + 3;
+			
+			for ( r = 0; r < _nof_points; r++ )
+			{
+				double dfDX = x[r] - Px;
+				double dfDY = y[r] - Py;
+				
+				if ( dfDX == 0.0 && dfDY == 0.0 )
+					tmp = 0.0;
+				else
+				{
+					double dist = dfDX * dfDX + dfDY * dfDY;
+					tmp = dist * log( dist );
+				}
+				dfVar0 += padfCoef0[r] * tmp;
+				dfVar1 += padfCoef1[r] * tmp;
+			}
+			vars[0] = dfVar0;
+			vars[1] = dfVar1;
+			break;
+		}
+		
 		for ( r = 0; r < _nof_points; r++ )
 		{
 			tmp = base_func( Px, Py, x[r], y[r] );
@@ -453,163 +473,189 @@ double VizGeorefSpline2D::base_func( const double x1, const double y1,
 
 #ifdef HAVE_ARMADILLO
 
-static int matrixInvert( int N, double input[], double output[] )
+static int matrixSolve( int N, int nRHS, double A[], double *rhs[],
+                        double *coef[] )
 {
     try
     {
-        arma::mat matInput(input,N,N,false);
-        const arma::mat& matInv = arma::inv(matInput);
-        int row, col;
-        for(row = 0; row < N; row++)
-            for(col = 0; col < N; col++)
-                output[row * N + col] = matInv.at(row, col);
+        // A is row major, but symmetric, so it can be used as a column
+        // major armadillo matrix.
+        arma::mat matA(A,N,N,false);
+        arma::mat matRHS(N,nRHS);
+        arma::mat matCoef;
+        int row, v;
+        for(v = 0; v < nRHS; v++)
+            for(row = 0; row < N; row++)
+                matRHS.at(row, v) = rhs[v][row];
+        if( !arma::solve(matCoef, matA, matRHS) )
+            return false;
+        for(v = 0; v < nRHS; v++)
+            for(row = 0; row < N; row++)
+                coef[v][row] = matCoef.at(row, v);
         return true;
-        //arma::mat matInv(output,N,N,false);
-        //return arma::inv(matInv, matInput);
     }
     catch(...)
     {
-        fprintf(stderr, "matrixInvert(): error occured.\n");
+        fprintf(stderr, "matrixSolve(): error occured.\n");
         return false;
     }
 }
 
 #else
 
-static int matrixInvert( int N, double input[], double output[] )
+/* Number of columns of the panels of the blocked LU decomposition */
+#define LU_BLOCK_SIZE 64
+
+static int matrixSolve( int N, int nRHS, double A[], double *rhs[],
+                        double *coef[] )
 {
-    // Receives an array of dimension NxN as input.  This is passed as a one-
-    // dimensional array of N-squared size.  It produces the inverse of the
-    // input matrix, returned as output, also of size N-squared.  The Gauss-
-    // Jordan Elimination method is used.  (Adapted from a BASIC routine in
-    // "Basic Scientific Subroutines Vol. 1", courtesy of Scott Edwards.)
-	
-    // Array elements 0...N-1 are for the first row, N...2N-1 are for the
-    // second row, etc.
-	
-    // We need to have a temporary array of size N x 2N.  We'll refer to the
-    // "left" and "right" halves of this array.
-	
-    int row, col;
-	
-#if 0
-    fprintf(stderr, "Matrix Inversion input matrix (N=%d)\n", N);
-    for ( row=0; row<N; row++ )
+    // Solves A * coef[v] = rhs[v] for the nRHS right hand sides, by
+    // an in place LU decomposition of the NxN row major matrix A, with
+    // partial pivoting.  The decomposition is done by panels of
+    // LU_BLOCK_SIZE columns, so that the update of the trailing matrix by
+    // a panel reuses the same LU_BLOCK_SIZE rows of U, which stay in cache,
+    // instead of streaming the whole matrix for each column.
+
+    int *panPivot = (int *) VSIMalloc2( N, sizeof(int) );
+    int i, j, k, kb;
+
+    if( panPivot == NULL )
     {
-        for ( col=0; col<N; col++ )
-        {
-            fprintf(stderr, "%5.2f ", input[row*N + col ]  );
-        }
-        fprintf(stderr, "\n");
-    }
-#endif
-	
-    int tempSize = 2 * N * N;
-    double* temp = (double*) new double[ tempSize ];
-    double ftemp;
-	
-    if (temp == 0) {
-		
-        fprintf(stderr, "matrixInvert(): ERROR - memory allocation failed.\n");
+        fprintf(stderr, "matrixSolve(): ERROR - memory allocation failed.\n");
         return false;
     }
-	
-    // First create a double-width matrix with the input array on the left
-    // and the identity matrix on the right.
-	
-    for ( row=0; row<N; row++ )
+
+    for( kb = 0; kb < N; kb += LU_BLOCK_SIZE )
     {
-        for ( col=0; col<N; col++ )
+        int ke = MIN( N, kb + LU_BLOCK_SIZE );
+
+        // Decompose the panel of columns [kb,ke[
+        for( k = kb; k < ke; k++ )
         {
-            // Our index into the temp array is X2 because it's twice as wide
-            // as the input matrix.
-			
-            temp[ 2*row*N + col ] = input[ row*N+col ];	// left = input matrix
-            temp[ 2*row*N + col + N ] = 0.0f;			// right = 0
-        }
-        temp[ 2*row*N + row + N ] = 1.0f;		// 1 on the diagonal of RHS
-    }
-	
-    // Now perform row-oriented operations to convert the left hand side
-    // of temp to the identity matrix.  The inverse of input will then be
-    // on the right.
-	
-    int max;
-    int k=0;
-    for (k = 0; k < N; k++)
-    {
-        if (k+1 < N)	// if not on the last row
-        {              
-            max = k;
-            for (row = k+1; row < N; row++) // find the maximum element
-            {  
-                if (fabs( temp[row*2*N + k] ) > fabs( temp[max*2*N + k] ))
+            double *padfRowK = A + (size_t)k * N;
+            int nMax = k;
+            double dfMax = fabs( padfRowK[k] );
+
+            for( i = k + 1; i < N; i++ )
+            {
+                if( fabs( A[(size_t)i * N + k] ) > dfMax )
                 {
-                    max = row;
+                    nMax = i;
+                    dfMax = fabs( A[(size_t)i * N + k] );
                 }
             }
-			
-            if (max != k)	// swap all the elements in the two rows
-            {        
-                for (col=k; col<2*N; col++)
+
+            if( dfMax == 0.0 ) // matrix cannot be inverted
+            {
+                CPLFree( panPivot );
+                return false;
+            }
+
+            panPivot[k] = nMax;
+            if( nMax != k ) // swap the whole rows
+            {
+                double *padfRowMax = A + (size_t)nMax * N;
+                for( j = 0; j < N; j++ )
                 {
-                    ftemp = temp[k*2*N + col];
-                    temp[k*2*N + col] = temp[max*2*N + col];
-                    temp[max*2*N + col] = ftemp;
+                    double dfTemp = padfRowK[j];
+                    padfRowK[j] = padfRowMax[j];
+                    padfRowMax[j] = dfTemp;
+                }
+            }
+
+            for( i = k + 1; i < N; i++ )
+            {
+                double *padfRowI = A + (size_t)i * N;
+                double dfL = (padfRowI[k] /= padfRowK[k]);
+
+                if( dfL != 0.0 )
+                {
+                    for( j = k + 1; j < ke; j++ )
+                        padfRowI[j] -= dfL * padfRowK[j];
                 }
             }
         }
-		
-        ftemp = temp[ k*2*N + k ];
-        if ( ftemp == 0.0f ) // matrix cannot be inverted
-        {
-            delete[] temp;
-            return false;
-        }
-		
-        for ( col=k; col<2*N; col++ )
+
+        if( ke == N )
+            break;
+
+        // Rows [kb,ke[ of U, right of the panel
+        for( k = kb; k < ke; k++ )
         {
-            temp[ k*2*N + col ] /= ftemp;
+            const double *padfRowK = A + (size_t)k * N;
+
+            for( i = k + 1; i < ke; i++ )
+            {
+                double *padfRowI = A + (size_t)i * N;
+                double dfL = padfRowI[k];
+
+                if( dfL != 0.0 )
+                {
+                    for( j = ke; j < N; j++ )
+                        padfRowI[j] -= dfL * padfRowK[j];
+                }
+            }
         }
-		
-        int i2 = k*2*N ;
-        for ( row=0; row<N; row++ )
+
+        // Trailing matrix
+        for( i = ke; i < N; i++ )
         {
-            if ( row != k )
+            double *padfRowI = A + (size_t)i * N;
+
+            for( k = kb; k < ke; k++ )
             {
-                int i1 = row*2*N;
-                ftemp = temp[ i1 + k ];
-                for ( col=k; col<2*N; col++ ) 
+                const double *padfRowK = A + (size_t)k * N;
+                double dfL = padfRowI[k];
+
+                if( dfL != 0.0 )
                 {
-                    temp[ i1 + col ] -= ftemp * temp[ i2 + col ];
+                    for( j = ke; j < N; j++ )
+                        padfRowI[j] -= dfL * padfRowK[j];
                 }
             }
         }
     }
-	
-    // Retrieve inverse from the right side of temp
-	
-    for (row = 0; row < N; row++)
+
+    // Forward and back substitutions for each right hand side
+    for( int v = 0; v < nRHS; v++ )
     {
-        for (col = 0; col < N; col++)
+        double *b = coef[v];
+
+        memcpy( b, rhs[v], sizeof(double) * N );
+
+        for( k = 0; k < N; k++ )
         {
-            output[row*N + col] = temp[row*2*N + col + N ];
+            if( panPivot[k] != k )
+            {
+                double dfTemp = b[k];
+                b[k] = b[panPivot[k]];
+                b[panPivot[k]] = dfTemp;
+            }
         }
-    }
-	
-#if 0
-    fprintf(stderr, "Matrix Inversion result matrix:\n");
-    for ( row=0; row<N; row++ )
-    {
-        for ( col=0; col<N; col++ )
+
+        for( i = 1; i < N; i++ )
         {
-            fprintf(stderr, "%5.2f ", output[row*N + col ]  );
+            const double *padfRowI = A + (size_t)i * N;
+            double dfSum = b[i];
+
+            for( k = 0; k < i; k++ )
+                dfSum -= padfRowI[k] * b[k];
+            b[i] = dfSum;
+        }
+
+        for( i = N - 1; i >= 0; i-- )
+        {
+            const double *padfRowI = A + (size_t)i * N;
+            double dfSum = b[i];
+
+            for( k = i + 1; k < N; k++ )
+                dfSum -= padfRowI[k] * b[k];
+            b[i] = dfSum / padfRowI[i];
         }
-        fprintf(stderr, "\n");
     }
-#endif
-	
-    delete [] temp;       // free memory
+
+    CPLFree( panPivot );
+
     return true;
 }
 #endif
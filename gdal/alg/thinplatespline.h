@@ -68,7 +68,6 @@ class VizGeorefSpline2D
         _nof_vars = nof_vars;
         _max_nof_points = 0;
         _AA = NULL;
-        _Ainv = NULL;
         grow_points();
         type = VIZ_GEOREF_SPLINE_ZERO_POINTS;
     }
@@ -76,8 +75,6 @@ class VizGeorefSpline2D
     ~VizGeorefSpline2D(){
         if ( _AA )
             CPLFree(_AA);
-        if ( _Ainv )
-            CPLFree(_Ainv);
 
         CPLFree( x );
         CPLFree( y );
@@ -128,11 +125,6 @@ class VizGeorefSpline2D
                 CPLFree(_AA);
                 _AA = NULL;
             }
-            if ( _Ainv )
-            {
-                CPLFree(_Ainv);
-                _Ainv = NULL;
-            }
             return _nof_points;
 	}
 
@@ -172,7 +164,7 @@ class VizGeorefSpline2D
     int *unused; // [VIZ_GEOREF_SPLINE_MAX_POINTS];
     int *index; // [VIZ_GEOREF_SPLINE_MAX_POINTS];
 	
-    double *_AA, *_Ainv;
+    double *_AA;
 };
 
 
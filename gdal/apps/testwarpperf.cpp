@@ -0,0 +1,295 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL
+ * Purpose:  Benchmark of the optimized warp kernels
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include <time.h>
+
+#include "gdalwarper.h"
+#include "cpl_string.h"
+
+CPL_CVSID("$Id$");
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf( "Usage: testwarpperf [-ot Byte|UInt16|Float32|...]* [-r bilinear|cubic|...]*\n"
+            "                    [-b bands] [-srcsize n] [-dstsize n] [-iter n]\n"
+            "\n"
+            "Warps an in-memory rotated image with each data type and resampling\n"
+            "method with the scalar, SSE2 and AVX2 code paths (GDAL_USE_SSE2,\n"
+            "GDAL_USE_AVX2), and reports the CPU time per warp and whether all\n"
+            "outputs are identical.  The AVX2 run uses the SSE2 code on CPUs\n"
+            "without AVX2.\n"
+            "Defaults: -ot Byte -ot UInt16 -ot Float32 -r bilinear -r cubic -b 3\n"
+            "          -srcsize 2000 -dstsize 2500 -iter 3\n" );
+    exit( 1 );
+}
+
+/************************************************************************/
+/*                              WarpOnce()                              */
+/*                                                                      */
+/*      Warp hSrcDS into hDstDS and return the CPU time in seconds.     */
+/************************************************************************/
+
+static double WarpOnce( GDALDatasetH hSrcDS, GDALDatasetH hDstDS,
+                        GDALResampleAlg eResampleAlg )
+{
+    GDALWarpOptions *psWO = GDALCreateWarpOptions();
+    int              i;
+
+    psWO->hSrcDS = hSrcDS;
+    psWO->hDstDS = hDstDS;
+    psWO->eResampleAlg = eResampleAlg;
+    psWO->nBandCount = GDALGetRasterCount( hSrcDS );
+    psWO->panSrcBands = (int *) CPLMalloc( sizeof(int) * psWO->nBandCount );
+    psWO->panDstBands = (int *) CPLMalloc( sizeof(int) * psWO->nBandCount );
+    for( i = 0; i < psWO->nBandCount; i++ )
+    {
+        psWO->panSrcBands[i] = i + 1;
+        psWO->panDstBands[i] = i + 1;
+    }
+    psWO->dfWarpMemoryLimit = 256 * 1024 * 1024;
+
+    /* Same setup as gdalwarp: approximated GenImgProj transformer */
+    void *hGenImgProjArg =
+        GDALCreateGenImgProjTransformer2( hSrcDS, hDstDS, NULL );
+    psWO->pTransformerArg =
+        GDALCreateApproxTransformer( GDALGenImgProjTransform,
+                                     hGenImgProjArg, 0.125 );
+    GDALApproxTransformerOwnsSubtransformer( psWO->pTransformerArg, TRUE );
+    psWO->pfnTransformer = GDALApproxTransform;
+
+    GDALWarpOperation oWO;
+    clock_t nStart = clock();
+
+    if( oWO.Initialize( psWO ) == CE_None )
+        oWO.ChunkAndWarpImage( 0, 0, GDALGetRasterXSize( hDstDS ),
+                               GDALGetRasterYSize( hDstDS ) );
+
+    double dfElapsed = (clock() - nStart) / (double) CLOCKS_PER_SEC;
+
+    GDALDestroyApproxTransformer( psWO->pTransformerArg );
+    GDALDestroyWarpOptions( psWO );
+
+    return dfElapsed;
+}
+
+/************************************************************************/
+/*                              Checksum()                              */
+/************************************************************************/
+
+static int Checksum( GDALDatasetH hDS )
+{
+    int nChecksum = 0;
+    for( int iBand = 1; iBand <= GDALGetRasterCount( hDS ); iBand++ )
+    {
+        GDALRasterBandH hBand = GDALGetRasterBand( hDS, iBand );
+        nChecksum += GDALChecksumImage( hBand, 0, 0,
+                                        GDALGetRasterXSize( hDS ),
+                                        GDALGetRasterYSize( hDS ) );
+    }
+    return nChecksum;
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char* argv[] )
+{
+    char  **papszTypes = NULL;
+    char  **papszResampling = NULL;
+    int     nBands = 3, nSrcSize = 2000, nDstSize = 2500, nIter = 3;
+    int     i;
+
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+    for( i = 1; i < argc; i++ )
+    {
+        if( EQUAL(argv[i], "-ot") && i+1 < argc )
+            papszTypes = CSLAddString( papszTypes, argv[++i] );
+        else if( EQUAL(argv[i], "-r") && i+1 < argc )
+            papszResampling = CSLAddString( papszResampling, argv[++i] );
+        else if( EQUAL(argv[i], "-b") && i+1 < argc )
+            nBands = atoi( argv[++i] );
+        else if( EQUAL(argv[i], "-srcsize") && i+1 < argc )
+            nSrcSize = atoi( argv[++i] );
+        else if( EQUAL(argv[i], "-dstsize") && i+1 < argc )
+            nDstSize = atoi( argv[++i] );
+        else if( EQUAL(argv[i], "-iter") && i+1 < argc )
+            nIter = atoi( argv[++i] );
+        else
+            Usage();
+    }
+
+    if( nBands < 1 || nSrcSize < 1 || nDstSize < 1 || nIter < 1 )
+        Usage();
+
+    if( papszTypes == NULL )
+    {
+        papszTypes = CSLAddString( papszTypes, "Byte" );
+        papszTypes = CSLAddString( papszTypes, "UInt16" );
+        papszTypes = CSLAddString( papszTypes, "Float32" );
+    }
+    if( papszResampling == NULL )
+    {
+        papszResampling = CSLAddString( papszResampling, "bilinear" );
+        papszResampling = CSLAddString( papszResampling, "cubic" );
+    }
+
+    GDALAllRegister();
+
+    GDALDriverH hMemDriver = GDALGetDriverByName( "MEM" );
+    if( hMemDriver == NULL )
+    {
+        fprintf( stderr, "MEM driver not available.\n" );
+        exit( 1 );
+    }
+
+    int bFailure = FALSE;
+
+    for( int iType = 0; papszTypes[iType] != NULL; iType++ )
+    {
+        GDALDataType eType = GDT_Unknown;
+        for( int iDT = 1; iDT < GDT_TypeCount; iDT++ )
+        {
+            if( GDALGetDataTypeName( (GDALDataType) iDT ) != NULL
+                && EQUAL( GDALGetDataTypeName( (GDALDataType) iDT ),
+                          papszTypes[iType] ) )
+                eType = (GDALDataType) iDT;
+        }
+        if( eType == GDT_Unknown )
+        {
+            fprintf( stderr, "Unknown data type %s.\n", papszTypes[iType] );
+            exit( 1 );
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Create a source with a smooth pattern and a rotated             */
+/*      geotransform, so that the warp is not a simple rescaling.       */
+/* -------------------------------------------------------------------- */
+        GDALDatasetH hSrcDS = GDALCreate( hMemDriver, "", nSrcSize, nSrcSize,
+                                          nBands, eType, NULL );
+        double adfSrcGT[6] = { 0.0, 0.866, 0.5, 0.0, 0.5, -0.866 };
+        GDALSetGeoTransform( hSrcDS, adfSrcGT );
+
+        float *pafLine = (float *) CPLMalloc( sizeof(float) * nSrcSize );
+        for( int iBand = 1; iBand <= nBands; iBand++ )
+        {
+            GDALRasterBandH hBand = GDALGetRasterBand( hSrcDS, iBand );
+            for( int iY = 0; iY < nSrcSize; iY++ )
+            {
+                for( int iX = 0; iX < nSrcSize; iX++ )
+                    pafLine[iX] = (float)
+                        ((iX * 7 + iY * 13 + iBand * 50 + (iX * iY) % 31) % 251);
+                GDALRasterIO( hBand, GF_Write, 0, iY, nSrcSize, 1,
+                              pafLine, nSrcSize, 1, GDT_Float32, 0, 0 );
+            }
+        }
+        CPLFree( pafLine );
+
+        /* Destination covering the rotated source extent */
+        double dfExtent = nSrcSize * (0.866 + 0.5);
+        double adfDstGT[6] = { 0.0, dfExtent / nDstSize, 0.0,
+                               nSrcSize * 0.5, 0.0, -dfExtent / nDstSize };
+
+        for( int iResampling = 0; papszResampling[iResampling] != NULL;
+             iResampling++ )
+        {
+            const char *pszResampling = papszResampling[iResampling];
+            GDALResampleAlg eResampleAlg;
+
+            if( EQUAL(pszResampling, "near") )
+                eResampleAlg = GRA_NearestNeighbour;
+            else if( EQUAL(pszResampling, "bilinear") )
+                eResampleAlg = GRA_Bilinear;
+            else if( EQUAL(pszResampling, "cubic") )
+                eResampleAlg = GRA_Cubic;
+            else if( EQUAL(pszResampling, "cubicspline") )
+                eResampleAlg = GRA_CubicSpline;
+            else if( EQUAL(pszResampling, "lanczos") )
+                eResampleAlg = GRA_Lanczos;
+            else
+            {
+                fprintf( stderr, "Unknown resampling %s.\n", pszResampling );
+                exit( 1 );
+            }
+
+            /* 0: scalar code, 1: SSE2 code, 2: AVX2 code if available */
+            static const char * const apszMode[3] = { "scalar", "sse2", "avx2" };
+            double adfTime[3];
+            int    anChecksum[3];
+            int    iMode;
+
+            for( iMode = 0; iMode < 3; iMode++ )
+            {
+                CPLSetConfigOption( "GDAL_USE_SSE2", iMode >= 1 ? "YES" : "NO" );
+                CPLSetConfigOption( "GDAL_USE_AVX2", iMode == 2 ? "YES" : "NO" );
+
+                GDALDatasetH hDstDS = GDALCreate( hMemDriver, "",
+                                                  nDstSize, nDstSize,
+                                                  nBands, eType, NULL );
+                GDALSetGeoTransform( hDstDS, adfDstGT );
+
+                adfTime[iMode] = 0.0;
+                for( int iIter = 0; iIter < nIter; iIter++ )
+                    adfTime[iMode] += WarpOnce( hSrcDS, hDstDS, eResampleAlg );
+                adfTime[iMode] /= nIter;
+
+                anChecksum[iMode] = Checksum( hDstDS );
+                GDALClose( hDstDS );
+            }
+            CPLSetConfigOption( "GDAL_USE_SSE2", NULL );
+            CPLSetConfigOption( "GDAL_USE_AVX2", NULL );
+
+            printf( "%-8s %-12s", GDALGetDataTypeName( eType ), pszResampling );
+            for( iMode = 0; iMode < 3; iMode++ )
+                printf( " %s: %7.3f s", apszMode[iMode], adfTime[iMode] );
+            printf( "  %s\n",
+                    anChecksum[0] == anChecksum[1]
+                    && anChecksum[0] == anChecksum[2] ? "identical" : "DIFFERENT" );
+
+            if( anChecksum[0] != anChecksum[1]
+                || anChecksum[0] != anChecksum[2] )
+                bFailure = TRUE;
+        }
+
+        GDALClose( hSrcDS );
+    }
+
+    CSLDestroy( papszTypes );
+    CSLDestroy( papszResampling );
+    CSLDestroy( argv );
+
+    GDALDestroyDriverManager();
+
+    return bFailure ? 1 : 0;
+}
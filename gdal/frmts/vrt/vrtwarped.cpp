@@ -1026,7 +1026,18 @@ CPLXMLNode *VRTWarpedDataset::SerializeToXML( const char *pszVRTPath )
         char *pszSavedName = CPLStrdup(GetDescription());
         SetDescription("");
 
-        psWOTree = GDALSerializeWarpOptions( poWarper->GetOptions() );
+/* -------------------------------------------------------------------- */
+/*      If the approximate transformer uses an interpolation grid,      */
+/*      complete it over the whole raster so that it is saved, and      */
+/*      the base transformer no longer needed when reading.             */
+/* -------------------------------------------------------------------- */
+        const GDALWarpOptions *psWO = poWarper->GetOptions();
+        if( psWO->pfnTransformer == GDALApproxTransform
+            && psWO->pTransformerArg != NULL )
+            GDALApproxTransformerBuildGrid( psWO->pTransformerArg,
+                                            nRasterXSize, nRasterYSize );
+
+        psWOTree = GDALSerializeWarpOptions( psWO );
         CPLAddXMLChild( psTree, psWOTree );
 
         SetDescription( pszSavedName );
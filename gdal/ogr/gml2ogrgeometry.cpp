@@ -456,6 +456,19 @@ static int ParseGMLCoordinates( const CPLXMLNode *psGeomNode, OGRGeometry *poGeo
             return TRUE;
         }
 
+        /* The optional count attribute gives the number of positions */
+        /* so that the points can be allocated in one go */
+        const char* pszCount = CPLGetXMLValue( (CPLXMLNode*) psPosList, "count", NULL);
+        if (pszCount != NULL &&
+            wkbFlatten(poGeometry->getGeometryType()) == wkbLineString)
+        {
+            int nCount = atoi(pszCount);
+            /* Do not trust absurd values more than the text itself */
+            if (nCount > 0 && nCount <= (int)(strlen(pszPosList) / 2))
+                ((OGRLineString *) poGeometry)->reservePoints(
+                    ((OGRLineString *) poGeometry)->getNumPoints() + nCount );
+        }
+
         const char* pszCur = pszPosList;
         while (TRUE)
         {
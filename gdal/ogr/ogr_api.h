@@ -231,6 +231,7 @@ typedef void *OGRFeatureH;
 typedef void *OGRStyleTableH;
 #endif
 typedef struct OGRGeomFieldDefnHS *OGRGeomFieldDefnH;
+typedef struct OGRFeatureBatchHS *OGRFeatureBatchH;
 
 /* OGRFieldDefn */
 
@@ -361,6 +362,16 @@ OGRErr            CPL_DLL OGR_F_SetGeomFieldDirectly( OGRFeatureH hFeat,
                                                       OGRGeometryH hGeom );
 OGRErr            CPL_DLL OGR_F_SetGeomField( OGRFeatureH hFeat,
                                               int iField, OGRGeometryH hGeom );
+OGRErr            CPL_DLL OGR_F_SetGeomFieldWkbDirectly( OGRFeatureH hFeat,
+                                                         int iField,
+                                                         GByte *pabyWKB,
+                                                         int nWKBSize );
+const GByte       CPL_DLL *OGR_F_GetGeomFieldWkbRef( OGRFeatureH hFeat,
+                                                     int iField,
+                                                     int *pnWKBSize );
+OGRErr            CPL_DLL OGR_F_GetGeomFieldEnvelope( OGRFeatureH hFeat,
+                                                      int iField,
+                                                      OGREnvelope *psEnvelope );
 
 long   CPL_DLL OGR_F_GetFID( OGRFeatureH );
 OGRErr CPL_DLL OGR_F_SetFID( OGRFeatureH, long );
@@ -375,6 +386,24 @@ OGRStyleTableH CPL_DLL OGR_F_GetStyleTable( OGRFeatureH );
 void   CPL_DLL OGR_F_SetStyleTableDirectly( OGRFeatureH, OGRStyleTableH );
 void   CPL_DLL OGR_F_SetStyleTable( OGRFeatureH, OGRStyleTableH );
 
+/* OGRFeatureBatch */
+
+OGRFeatureBatchH CPL_DLL OGR_FB_Create( int nMaxFeatures ) CPL_WARN_UNUSED_RESULT;
+void   CPL_DLL OGR_FB_Destroy( OGRFeatureBatchH );
+int    CPL_DLL OGR_FB_GetFeatureCount( OGRFeatureBatchH );
+int    CPL_DLL OGR_FB_GetColumnCount( OGRFeatureBatchH );
+int    CPL_DLL OGR_FB_GetColumnFieldIndex( OGRFeatureBatchH, int );
+OGRFieldType CPL_DLL OGR_FB_GetColumnType( OGRFeatureBatchH, int );
+const GByte CPL_DLL *OGR_FB_GetColumnValidity( OGRFeatureBatchH, int );
+const int CPL_DLL *OGR_FB_GetColumnAsIntegers( OGRFeatureBatchH, int );
+const double CPL_DLL *OGR_FB_GetColumnAsDoubles( OGRFeatureBatchH, int );
+const int CPL_DLL *OGR_FB_GetColumnStringOffsets( OGRFeatureBatchH, int );
+const char CPL_DLL *OGR_FB_GetColumnStringData( OGRFeatureBatchH, int );
+const long CPL_DLL *OGR_FB_GetFIDs( OGRFeatureBatchH );
+int    CPL_DLL OGR_FB_HasGeometry( OGRFeatureBatchH );
+const int CPL_DLL *OGR_FB_GetGeometryOffsets( OGRFeatureBatchH );
+const GByte CPL_DLL *OGR_FB_GetGeometryData( OGRFeatureBatchH );
+
 /* -------------------------------------------------------------------- */
 /*      ogrsf_frmts.h                                                   */
 /* -------------------------------------------------------------------- */
@@ -405,6 +434,8 @@ void     CPL_DLL OGR_L_SetSpatialFilterRectEx( OGRLayerH, int iGeomField,
 OGRErr CPL_DLL OGR_L_SetAttributeFilter( OGRLayerH, const char * );
 void   CPL_DLL OGR_L_ResetReading( OGRLayerH );
 OGRFeatureH CPL_DLL OGR_L_GetNextFeature( OGRLayerH );
+int    CPL_DLL OGR_L_GetNextFeatureInto( OGRLayerH, OGRFeatureH );
+int    CPL_DLL OGR_L_GetNextBatch( OGRLayerH, OGRFeatureBatchH );
 OGRErr CPL_DLL OGR_L_SetNextByIndex( OGRLayerH, long );
 OGRFeatureH CPL_DLL OGR_L_GetFeature( OGRLayerH, long );
 OGRErr CPL_DLL OGR_L_SetFeature( OGRLayerH, OGRFeatureH );
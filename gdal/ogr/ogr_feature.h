@@ -237,6 +237,16 @@ class CPL_DLL OGRFeature
     OGRGeometry        **papoGeometries;
     OGRField            *pauFields;
 
+    /* Pending WKB of geometry fields not decoded yet (lazily allocated) */
+    GByte              **papabyGeometryWkb;
+    int                 *panGeometryWkbSize;
+
+    void                DecodeGeometryWkb( int iField );
+    void                DiscardGeometryWkb( int iField );
+    void                CopyGeomFieldFrom( int iField,
+                                           OGRFeature *poSrcFeature,
+                                           int iSrcField );
+
   protected: 
     char *              m_pszStyleString;
     OGRStyleTable       *m_poStyleTable;
@@ -266,6 +276,12 @@ class CPL_DLL OGRFeature
     OGRErr              SetGeomFieldDirectly( int iField, OGRGeometry * );
     OGRErr              SetGeomField( int iField, OGRGeometry * );
 
+    OGRErr              SetGeomFieldWkbDirectly( int iField, GByte *pabyWKB,
+                                                 int nWKBSize );
+    const GByte        *GetGeomFieldWkbRef( int iField, int *pnWKBSize );
+    OGRErr              GetGeomFieldEnvelope( int iField,
+                                              OGREnvelope *psEnvelope );
+
     OGRFeature         *Clone();
     virtual OGRBoolean  Equal( OGRFeature * poFeature );
 
@@ -278,6 +294,7 @@ class CPL_DLL OGRFeature
     int                 IsFieldSet( int iField );
     
     void                UnsetField( int iField );
+    void                Reset();
     
     OGRField           *GetRawFieldRef( int i ) { return pauFields + i; }
 
@@ -373,6 +390,82 @@ class CPL_DLL OGRFeature
     static void         DestroyFeature( OGRFeature * );
 };
 
+/************************************************************************/
+/*                           OGRFeatureBatch                            */
+/************************************************************************/
+
+struct OGRFeatureBatchColumn;
+
+/**
+ * A batch of features stored column by column.
+ *
+ * Integer fields are stored as int arrays, real fields as double arrays,
+ * and all other fields as string offsets into a character buffer.  Each
+ * column has a validity bitmap, and the geometry of the first geometry
+ * field is stored as contiguous WKB.
+ */
+
+class CPL_DLL OGRFeatureBatch
+{
+  private:
+    int                 nMaxFeatures;
+    int                 nFeatures;
+
+    OGRFeatureDefn     *poDefn;
+    OGRFeature         *poScratchFeature;
+
+    int                 nColumns;
+    OGRFeatureBatchColumn *pasColumns;
+
+    long               *panFIDs;
+
+    int                 bHasGeometry;
+    int                *panWKBOffsets;
+    GByte              *pabyWKB;
+    int                 nWKBSize;
+    int                 nWKBAlloc;
+
+    void                FreeColumns();
+    char               *ReserveString( int iColumn, int nLen );
+
+  public:
+                        OGRFeatureBatch( int nMaxFeatures );
+                        ~OGRFeatureBatch();
+
+    void                Prepare( OGRFeatureDefn *poDefn );
+
+    int                 GetMaxFeatureCount() { return nMaxFeatures; }
+    int                 GetFeatureCount() { return nFeatures; }
+    int                 IsFull() { return nFeatures >= nMaxFeatures; }
+
+    int                 GetColumnCount() { return nColumns; }
+    int                 GetColumnFieldIndex( int iColumn );
+    OGRFieldType        GetColumnType( int iColumn );
+    const GByte        *GetColumnValidity( int iColumn );
+    const int          *GetColumnAsIntegers( int iColumn );
+    const double       *GetColumnAsDoubles( int iColumn );
+    const int          *GetColumnStringOffsets( int iColumn );
+    const char         *GetColumnStringData( int iColumn );
+
+    const long         *GetFIDs() { return panFIDs; }
+
+    int                 HasGeometry() { return bHasGeometry; }
+    const int          *GetGeometryOffsets() { return panWKBOffsets; }
+    const GByte        *GetGeometryData() { return pabyWKB; }
+
+    OGRFeature         *GetScratchFeature() { return poScratchFeature; }
+
+    void                AddFeature( OGRFeature *poFeature );
+
+    void                BeginFeature( long nFID );
+    void                SetInteger( int iColumn, int nValue );
+    void                SetDouble( int iColumn, double dfValue );
+    void                SetString( int iColumn, const char *pszValue,
+                                   int nLen = -1 );
+    void                SetGeometry( OGRGeometry *poGeom );
+    void                EndFeature();
+};
+
 /************************************************************************/
 /*                           OGRFeatureQuery                            */
 /************************************************************************/
@@ -385,6 +478,7 @@ class CPL_DLL OGRFeatureQuery
   private:
     OGRFeatureDefn *poTargetDefn;
     void           *pSWQExpr;
+    void           *pCompiledExpr;
 
     char          **FieldCollector( void *, char ** );
 
@@ -263,6 +263,7 @@ class CPL_DLL OGRLineString : public OGRCurve
 {
   protected:
     int         nPointCount;
+    int         nPointCapacity;
     OGRRawPoint *paoPoints;
     double      *padfZ;
 
@@ -306,13 +307,21 @@ class CPL_DLL OGRLineString : public OGRCurve
     
     // non standard.
     virtual void setCoordinateDimension( int nDimension ); 
-    void        setNumPoints( int );
+    void        setNumPoints( int nNewPointCount,
+                              int bZeroizeNewContent = TRUE );
+    OGRErr      reservePoints( int nNewCapacity );
     void        setPoint( int, OGRPoint * );
     void        setPoint( int, double, double );
     void        setPoint( int, double, double, double );
     void        setPoints( int, OGRRawPoint *, double * = NULL );
     void        setPoints( int, double * padfX, double * padfY,
                            double *padfZ = NULL );
+    void        setPoints( int nPointsIn,
+                           const void* pabyX, int nXStride,
+                           const void* pabyY, int nYStride,
+                           const void* pabyZ = NULL, int nZStride = 0 );
+    void        setPointsDirectly( int nPointsIn, OGRRawPoint * paoPointsIn,
+                                   double * padfZIn = NULL );
     void        addPoint( OGRPoint * );
     void        addPoint( double, double );
     void        addPoint( double, double, double );
@@ -637,6 +646,82 @@ class CPL_DLL OGRMultiLineString : public OGRGeometryCollection
 /*                          OGRGeometryFactory                          */
 /************************************************************************/
 
+/************************************************************************/
+/*                          OGRWKBGeometryView                          */
+/************************************************************************/
+
+/**
+ * Read-only view over a well known binary buffer.
+ *
+ * The buffer is walked once by Init() to validate its structure and to
+ * locate the point sequences it contains, but coordinates are never
+ * copied: getX(), getY(), getZ() and getEnvelope() read them straight from
+ * the buffer (byte swapping as needed).  The buffer must remain valid and
+ * unchanged for the lifetime of the view.
+ */
+
+class CPL_DLL OGRWKBGeometryView
+{
+    typedef struct
+    {
+        int             nOffset;        /* of the first coordinate */
+        int             nPoints;
+        int             nFirstPoint;    /* index in the whole geometry */
+        int             bNeedSwap;
+        int             bHasZ;
+    } OGRWKBPointSequence;
+
+    const GByte        *pabyData;
+    int                 nSize;
+    OGRwkbGeometryType  eGeometryType;
+    int                 nCoordDimension;
+    int                 nTotalPoints;
+    int                 bCanonicalNDR;
+
+    int                 nSequences;
+    int                 nMaxSequences;
+    OGRWKBPointSequence sInlineSequence;
+    OGRWKBPointSequence *pasSequences;
+
+    OGRErr              Walk( int nOffset, int nRecLevel,
+                              int *pnBytesConsumed );
+    OGRErr              AddSequence( int nOffset, int nPoints,
+                                     int bNeedSwap, int bHasZ );
+    const OGRWKBPointSequence *FindSequence( int iPoint ) const;
+    double              ReadCoord( int iPoint, int iCoord ) const;
+
+    /* Not copyable: pasSequences may point into the object itself. */
+                        OGRWKBGeometryView( const OGRWKBGeometryView& );
+    OGRWKBGeometryView &operator=( const OGRWKBGeometryView& );
+
+  public:
+                        OGRWKBGeometryView();
+                        OGRWKBGeometryView( const GByte *pabyData,
+                                            int nSize );
+                        ~OGRWKBGeometryView();
+
+    OGRErr              Init( const GByte *pabyData, int nSize );
+    int                 IsValid() const { return pabyData != NULL; }
+    int                 IsCanonicalNDR() const { return bCanonicalNDR; }
+
+    const GByte        *getData() const { return pabyData; }
+    int                 getWkbSize() const { return nSize; }
+
+    OGRwkbGeometryType  getGeometryType() const { return eGeometryType; }
+    int                 getCoordinateDimension() const
+                                { return nCoordDimension; }
+    int                 getNumPoints() const { return nTotalPoints; }
+    double              getX( int iPoint ) const
+                                { return ReadCoord( iPoint, 0 ); }
+    double              getY( int iPoint ) const
+                                { return ReadCoord( iPoint, 1 ); }
+    double              getZ( int iPoint ) const;
+    void                getEnvelope( OGREnvelope *psEnvelope ) const;
+
+    OGRErr              createGeometry( OGRSpatialReference *poSRS,
+                                        OGRGeometry **ppoReturn ) const;
+};
+
 /**
  * Create geometry objects from well known text/binary.
  */
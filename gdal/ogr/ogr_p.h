@@ -68,6 +68,8 @@ void CPL_DLL OGRMakeWktCoordinate( char *, double, double, double, int );
 #endif
 
 void OGRFormatDouble( char *pszBuffer, int nBufferLen, double dfVal, char chDecimalSep, int nPrecision = 15 );
+int CPL_DLL OGRFormatDoubleRoundTrip( char *pszBuffer, int nBufferLen, double dfVal );
+int CPL_DLL OGRUseDoubleRoundTripFormat();
 
 /* -------------------------------------------------------------------- */
 /*      Date-time parsing and processing functions                      */
@@ -117,7 +119,7 @@ extern const swq_field_type SpecialFieldTypes[SPECIAL_FIELD_COUNT];
 OGRErr CPL_DLL OSRGetEllipsoidInfo( int, char **, double *, double *);
 
 /* Fast atof function */
-double OGRFastAtof(const char* pszStr);
+double CPL_DLL OGRFastAtof(const char* pszStr);
 
 OGRErr CPL_DLL OGRCheckPermutation(int* panPermutation, int nSize);
 
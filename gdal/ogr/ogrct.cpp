@@ -107,6 +107,160 @@ void OCTCleanupProjMutex()
     }
 }
 
+/************************************************************************/
+/*                          OGRProj4CTScratch                           */
+/*                                                                      */
+/*      Working buffers used by the CHECK_WITH_INVERT_PROJ logic.       */
+/************************************************************************/
+
+typedef struct
+{
+    int         nMaxCount;
+    double     *padfOriX;
+    double     *padfOriY;
+    double     *padfOriZ;
+    double     *padfTargetX;
+    double     *padfTargetY;
+    double     *padfTargetZ;
+} OGRProj4CTScratch;
+
+/************************************************************************/
+/*                        OGRProj4CTThreadData                          */
+/*                                                                      */
+/*      State of one worker thread of the multi-threaded batch          */
+/*      transformation.  Each worker has its own PROJ context and       */
+/*      its own source and target handles, so that pj_transform()      */
+/*      can run concurrently without taking hPROJMutex.                 */
+/************************************************************************/
+
+typedef struct
+{
+    projCtx     pjctx;
+    projPJ      psPJSource;
+    projPJ      psPJTarget;
+    OGRProj4CTScratch sScratch;
+
+    int         bCheckWithInvertProj;
+    double      dfThreshold;
+
+    int         nCount;
+    double     *x;
+    double     *y;
+    double     *z;
+    int         err;
+
+    void       *hThread;
+} OGRProj4CTThreadData;
+
+/* Minimum number of points a worker thread must have to process to */
+/* make it worth launching it. */
+#define OGR_CT_MIN_POINTS_PER_THREAD    10000
+
+/************************************************************************/
+/*                         OGRProj4CTPJTransform()                      */
+/*                                                                      */
+/*      Run pj_transform() on a set of points, optionally checking      */
+/*      the result with the inverse transformation.                     */
+/************************************************************************/
+
+static int OGRProj4CTPJTransform( projPJ psPJSource, projPJ psPJTarget,
+                                  int bCheckWithInvertProj,
+                                  double dfThreshold,
+                                  OGRProj4CTScratch *psScratch,
+                                  int nCount,
+                                  double *x, double *y, double *z )
+
+{
+    int err, i;
+
+    if( !bCheckWithInvertProj )
+        return pfn_pj_transform( psPJSource, psPJTarget, nCount, 1, x, y, z );
+
+    /* For some projections, we cannot detect if we are trying to reproject */
+    /* coordinates outside the validity area of the projection. So let's do */
+    /* the reverse reprojection and compare with the source coordinates */
+    if (nCount > psScratch->nMaxCount)
+    {
+        psScratch->nMaxCount = nCount;
+        psScratch->padfOriX = (double*) CPLRealloc(psScratch->padfOriX, sizeof(double)*nCount);
+        psScratch->padfOriY = (double*) CPLRealloc(psScratch->padfOriY, sizeof(double)*nCount);
+        psScratch->padfOriZ = (double*) CPLRealloc(psScratch->padfOriZ, sizeof(double)*nCount);
+        psScratch->padfTargetX = (double*) CPLRealloc(psScratch->padfTargetX, sizeof(double)*nCount);
+        psScratch->padfTargetY = (double*) CPLRealloc(psScratch->padfTargetY, sizeof(double)*nCount);
+        psScratch->padfTargetZ = (double*) CPLRealloc(psScratch->padfTargetZ, sizeof(double)*nCount);
+    }
+    memcpy(psScratch->padfOriX, x, sizeof(double)*nCount);
+    memcpy(psScratch->padfOriY, y, sizeof(double)*nCount);
+    if (z)
+    {
+        memcpy(psScratch->padfOriZ, z, sizeof(double)*nCount);
+    }
+    err = pfn_pj_transform( psPJSource, psPJTarget, nCount, 1, x, y, z );
+    if (err == 0)
+    {
+        memcpy(psScratch->padfTargetX, x, sizeof(double)*nCount);
+        memcpy(psScratch->padfTargetY, y, sizeof(double)*nCount);
+        if (z)
+        {
+            memcpy(psScratch->padfTargetZ, z, sizeof(double)*nCount);
+        }
+
+        err = pfn_pj_transform( psPJTarget, psPJSource , nCount, 1,
+                                psScratch->padfTargetX,
+                                psScratch->padfTargetY,
+                                (z) ? psScratch->padfTargetZ : NULL);
+        if (err == 0)
+        {
+            for( i = 0; i < nCount; i++ )
+            {
+                if ( x[i] != HUGE_VAL && y[i] != HUGE_VAL &&
+                    (fabs(psScratch->padfTargetX[i] - psScratch->padfOriX[i]) > dfThreshold ||
+                     fabs(psScratch->padfTargetY[i] - psScratch->padfOriY[i]) > dfThreshold) )
+                {
+                    x[i] = HUGE_VAL;
+                    y[i] = HUGE_VAL;
+                }
+            }
+        }
+    }
+
+    return err;
+}
+
+/************************************************************************/
+/*                      OGRProj4CTFreeScratch()                         */
+/************************************************************************/
+
+static void OGRProj4CTFreeScratch( OGRProj4CTScratch *psScratch )
+
+{
+    CPLFree(psScratch->padfOriX);
+    CPLFree(psScratch->padfOriY);
+    CPLFree(psScratch->padfOriZ);
+    CPLFree(psScratch->padfTargetX);
+    CPLFree(psScratch->padfTargetY);
+    CPLFree(psScratch->padfTargetZ);
+    memset(psScratch, 0, sizeof(OGRProj4CTScratch));
+}
+
+/************************************************************************/
+/*                       OGRProj4CTWorkerThread()                       */
+/************************************************************************/
+
+static void OGRProj4CTWorkerThread( void* pData )
+
+{
+    OGRProj4CTThreadData* psData = (OGRProj4CTThreadData*) pData;
+
+    psData->err = OGRProj4CTPJTransform( psData->psPJSource,
+                                         psData->psPJTarget,
+                                         psData->bCheckWithInvertProj,
+                                         psData->dfThreshold,
+                                         &(psData->sScratch),
+                                         psData->nCount,
+                                         psData->x, psData->y, psData->z );
+}
+
 /************************************************************************/
 /*                              OGRProj4CT                              */
 /************************************************************************/
@@ -140,13 +294,18 @@ class OGRProj4CT : public OGRCoordinateTransformation
     int         InitializeNoLock( OGRSpatialReference *poSource, 
                                   OGRSpatialReference *poTarget );
 
-    int         nMaxCount;
-    double     *padfOriX;
-    double     *padfOriY;
-    double     *padfOriZ;
-    double     *padfTargetX;
-    double     *padfTargetY;
-    double     *padfTargetZ;
+    OGRProj4CTScratch sScratch;
+
+    /* Multi-threaded batch transformation (requires PROJ >= 4.8.0) */
+    char       *pszSourceProj4Defn;
+    char       *pszTargetProj4Defn;
+    int         nThreads;
+    int         bThreadContextsInitialized;
+    OGRProj4CTThreadData *pasThreadData;
+
+    int         InitializeThreadContexts();
+    int         TransformMultiThread( int nCount,
+                                      double *x, double *y, double *z );
 
 public:
                 OGRProj4CT();
@@ -384,6 +543,12 @@ void OGRCoordinateTransformation::DestroyCT(OGRCoordinateTransformation* poCT)
  *
  * The PROJ.4 library must be available at run-time.
  *
+ * Starting with GDAL 1.11, when PROJ.4 >= 4.8.0 is used, the
+ * OGR_CT_NUM_THREADS configuration option can be set to a number of threads,
+ * or ALL_CPUS, so that large point arrays passed to TransformEx() are split
+ * into slices transformed concurrently, each thread using its own PROJ.4
+ * context. It defaults to 1.
+ *
  * @param poSource source spatial reference system. 
  * @param poTarget target spatial reference system. 
  * @return NULL on failure or a ready to use transformation object.
@@ -469,13 +634,13 @@ OGRProj4CT::OGRProj4CT()
     bCheckWithInvertProj = FALSE;
     dfThreshold = 0;
 
-    nMaxCount = 0;
-    padfOriX = NULL;
-    padfOriY = NULL;
-    padfOriZ = NULL;
-    padfTargetX = NULL;
-    padfTargetY = NULL;
-    padfTargetZ = NULL;
+    memset(&sScratch, 0, sizeof(sScratch));
+
+    pszSourceProj4Defn = NULL;
+    pszTargetProj4Defn = NULL;
+    nThreads = 1;
+    bThreadContextsInitialized = FALSE;
+    pasThreadData = NULL;
 
     if (pfn_pj_ctx_alloc != NULL)
         pjctx = pfn_pj_ctx_alloc();
@@ -523,12 +688,25 @@ OGRProj4CT::~OGRProj4CT()
             pfn_pj_free( psPJTarget );
     }
 
-    CPLFree(padfOriX);
-    CPLFree(padfOriY);
-    CPLFree(padfOriZ);
-    CPLFree(padfTargetX);
-    CPLFree(padfTargetY);
-    CPLFree(padfTargetZ);
+    if( pasThreadData != NULL )
+    {
+        for( int i = 0; i < nThreads; i++ )
+        {
+            if( pasThreadData[i].psPJSource != NULL )
+                pfn_pj_free( pasThreadData[i].psPJSource );
+            if( pasThreadData[i].psPJTarget != NULL )
+                pfn_pj_free( pasThreadData[i].psPJTarget );
+            if( pasThreadData[i].pjctx != NULL )
+                pfn_pj_ctx_free( pasThreadData[i].pjctx );
+            OGRProj4CTFreeScratch( &(pasThreadData[i].sScratch) );
+        }
+        CPLFree( pasThreadData );
+    }
+
+    OGRProj4CTFreeScratch( &sScratch );
+
+    CPLFree(pszSourceProj4Defn);
+    CPLFree(pszTargetProj4Defn);
 }
 
 /************************************************************************/
@@ -638,6 +816,23 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
         /* a tolerance of 10000 */
         dfThreshold = atof(CPLGetConfigOption( "THRESHOLD", "10000" ));
 
+/* -------------------------------------------------------------------- */
+/*      Number of threads used to transform large point arrays.         */
+/*      This is only possible with PROJ >= 4.8.0 contexts.              */
+/* -------------------------------------------------------------------- */
+    if( pjctx != NULL )
+    {
+        const char* pszThreads = CPLGetConfigOption("OGR_CT_NUM_THREADS", "1");
+        if (EQUAL(pszThreads, "ALL_CPUS"))
+            nThreads = CPLGetNumCPUs();
+        else
+            nThreads = atoi(pszThreads);
+        if (nThreads > 128)
+            nThreads = 128;
+        if (nThreads < 1)
+            nThreads = 1;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Establish PROJ.4 handle for source if projection.               */
 /* -------------------------------------------------------------------- */
@@ -755,6 +950,13 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
     /* Determine if we really have a transformation to do */
     bIdentityTransform = (strcmp(pszSrcProj4Defn, pszDstProj4Defn) == 0);
 
+    /* Keep the definitions for the per-thread PROJ.4 handles */
+    if( nThreads > 1 && !bIdentityTransform )
+    {
+        pszSourceProj4Defn = CPLStrdup(pszSrcProj4Defn);
+        pszTargetProj4Defn = CPLStrdup(pszDstProj4Defn);
+    }
+
     /* In case of identity transform, under the following conditions, */
     /* we can also avoid transforming from deegrees <--> radians. */
     if( bIdentityTransform && bSourceLatLong && !bSourceWrap &&
@@ -884,58 +1086,14 @@ int OGRProj4CT::TransformEx( int nCount, double *x, double *y, double *z,
 
     if( bIdentityTransform )
         err = 0;
-    else if (bCheckWithInvertProj)
-    {
-        /* For some projections, we cannot detect if we are trying to reproject */
-        /* coordinates outside the validity area of the projection. So let's do */
-        /* the reverse reprojection and compare with the source coordinates */
-        if (nCount > nMaxCount)
-        {
-            nMaxCount = nCount;
-            padfOriX = (double*) CPLRealloc(padfOriX, sizeof(double)*nCount);
-            padfOriY = (double*) CPLRealloc(padfOriY, sizeof(double)*nCount);
-            padfOriZ = (double*) CPLRealloc(padfOriZ, sizeof(double)*nCount);
-            padfTargetX = (double*) CPLRealloc(padfTargetX, sizeof(double)*nCount);
-            padfTargetY = (double*) CPLRealloc(padfTargetY, sizeof(double)*nCount);
-            padfTargetZ = (double*) CPLRealloc(padfTargetZ, sizeof(double)*nCount);
-        }
-        memcpy(padfOriX, x, sizeof(double)*nCount);
-        memcpy(padfOriY, y, sizeof(double)*nCount);
-        if (z)
-        {
-            memcpy(padfOriZ, z, sizeof(double)*nCount);
-        }
-        err = pfn_pj_transform( psPJSource, psPJTarget, nCount, 1, x, y, z );
-        if (err == 0)
-        {
-            memcpy(padfTargetX, x, sizeof(double)*nCount);
-            memcpy(padfTargetY, y, sizeof(double)*nCount);
-            if (z)
-            {
-                memcpy(padfTargetZ, z, sizeof(double)*nCount);
-            }
-            
-            err = pfn_pj_transform( psPJTarget, psPJSource , nCount, 1,
-                                    padfTargetX, padfTargetY, (z) ? padfTargetZ : NULL);
-            if (err == 0)
-            {
-                for( i = 0; i < nCount; i++ )
-                {
-                    if ( x[i] != HUGE_VAL && y[i] != HUGE_VAL &&
-                        (fabs(padfTargetX[i] - padfOriX[i]) > dfThreshold ||
-                         fabs(padfTargetY[i] - padfOriY[i]) > dfThreshold) )
-                    {
-                        x[i] = HUGE_VAL;
-                        y[i] = HUGE_VAL;
-                    }
-                }
-            }
-        }
-    }
+    else if( nThreads > 1 &&
+             nCount >= 2 * OGR_CT_MIN_POINTS_PER_THREAD &&
+             InitializeThreadContexts() )
+        err = TransformMultiThread( nCount, x, y, z );
     else
-    {
-        err = pfn_pj_transform( psPJSource, psPJTarget, nCount, 1, x, y, z );
-    }
+        err = OGRProj4CTPJTransform( psPJSource, psPJTarget,
+                                     bCheckWithInvertProj, dfThreshold,
+                                     &sScratch, nCount, x, y, z );
 
 /* -------------------------------------------------------------------- */
 /*      Try to report an error through CPL.  Get proj.4 error string    */
@@ -1030,6 +1188,141 @@ int OGRProj4CT::TransformEx( int nCount, double *x, double *y, double *z,
     return TRUE;
 }
 
+/************************************************************************/
+/*                      InitializeThreadContexts()                      */
+/*                                                                      */
+/*      Create the PROJ.4 context and handles of each worker thread.    */
+/*      The first slot is served by the calling thread with the main    */
+/*      context and handles of the object.                              */
+/************************************************************************/
+
+int OGRProj4CT::InitializeThreadContexts()
+
+{
+    if( bThreadContextsInitialized )
+        return pasThreadData != NULL;
+
+    bThreadContextsInitialized = TRUE;
+
+    if( pjctx == NULL || pszSourceProj4Defn == NULL ||
+        pszTargetProj4Defn == NULL )
+        return FALSE;
+
+    pasThreadData = (OGRProj4CTThreadData*)
+        CPLCalloc(sizeof(OGRProj4CTThreadData), nThreads);
+
+    for( int i = 1; i < nThreads; i++ )
+    {
+        OGRProj4CTThreadData* psData = pasThreadData + i;
+
+        psData->pjctx = pfn_pj_ctx_alloc();
+        if( psData->pjctx != NULL )
+        {
+            psData->psPJSource =
+                pfn_pj_init_plus_ctx( psData->pjctx, pszSourceProj4Defn );
+            psData->psPJTarget =
+                pfn_pj_init_plus_ctx( psData->pjctx, pszTargetProj4Defn );
+        }
+
+        if( psData->psPJSource == NULL || psData->psPJTarget == NULL )
+        {
+            CPLDebug( "OGRCT",
+                      "Cannot create PROJ.4 handles for worker thread. "
+                      "Falling back to mono-thread transformation." );
+
+            for( int j = 1; j <= i; j++ )
+            {
+                if( pasThreadData[j].psPJSource != NULL )
+                    pfn_pj_free( pasThreadData[j].psPJSource );
+                if( pasThreadData[j].psPJTarget != NULL )
+                    pfn_pj_free( pasThreadData[j].psPJTarget );
+                if( pasThreadData[j].pjctx != NULL )
+                    pfn_pj_ctx_free( pasThreadData[j].pjctx );
+            }
+            CPLFree( pasThreadData );
+            pasThreadData = NULL;
+            return FALSE;
+        }
+    }
+
+    CPLDebug( "OGRCT", "Using up to %d threads for large transformations",
+              nThreads );
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                        TransformMultiThread()                        */
+/*                                                                      */
+/*      Split the point array in contiguous slices, and transform       */
+/*      each one in its own thread with its own PROJ.4 context.         */
+/************************************************************************/
+
+int OGRProj4CT::TransformMultiThread( int nCount,
+                                      double *x, double *y, double *z )
+
+{
+    int i;
+    int nJobs = MIN( nThreads, nCount / OGR_CT_MIN_POINTS_PER_THREAD );
+
+    for( i = 0; i < nJobs; i++ )
+    {
+        OGRProj4CTThreadData* psData = pasThreadData + i;
+        int iStart = (int)(((GIntBig)i) * nCount / nJobs);
+        int iEnd = (int)(((GIntBig)(i + 1)) * nCount / nJobs);
+
+        if( i == 0 )
+        {
+            psData->pjctx = pjctx;
+            psData->psPJSource = psPJSource;
+            psData->psPJTarget = psPJTarget;
+        }
+        psData->bCheckWithInvertProj = bCheckWithInvertProj;
+        psData->dfThreshold = dfThreshold;
+        psData->nCount = iEnd - iStart;
+        psData->x = x + iStart;
+        psData->y = y + iStart;
+        psData->z = (z) ? z + iStart : NULL;
+        psData->err = 0;
+        psData->hThread = NULL;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Launch worker threads, and process the first slice in the       */
+/*      calling thread.                                                 */
+/* -------------------------------------------------------------------- */
+    for( i = 1; i < nJobs; i++ )
+    {
+        pasThreadData[i].hThread =
+            CPLCreateJoinableThread( OGRProj4CTWorkerThread,
+                                     pasThreadData + i );
+        if( pasThreadData[i].hThread == NULL )
+            OGRProj4CTWorkerThread( pasThreadData + i );
+    }
+
+    OGRProj4CTWorkerThread( pasThreadData );
+
+/* -------------------------------------------------------------------- */
+/*      Wait for all threads to complete.                               */
+/* -------------------------------------------------------------------- */
+    int err = pasThreadData[0].err;
+
+    for( i = 1; i < nJobs; i++ )
+    {
+        if( pasThreadData[i].hThread != NULL )
+            CPLJoinThread( pasThreadData[i].hThread );
+        if( err == 0 )
+            err = pasThreadData[i].err;
+    }
+
+    /* The first slot does not own its handles */
+    pasThreadData[0].pjctx = NULL;
+    pasThreadData[0].psPJSource = NULL;
+    pasThreadData[0].psPJTarget = NULL;
+
+    return err;
+}
+
 /************************************************************************/
 /*                           OCTTransformEx()                           */
 /************************************************************************/
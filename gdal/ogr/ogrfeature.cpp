@@ -70,6 +70,9 @@ OGRFeature::OGRFeature( OGRFeatureDefn * poDefnIn )
     papoGeometries = (OGRGeometry **) CPLCalloc( poDefn->GetGeomFieldCount(),
                                         sizeof(OGRGeometry*) );
 
+    papabyGeometryWkb = NULL;
+    panGeometryWkbSize = NULL;
+
     for( int i = 0; i < poDefn->GetFieldCount(); i++ )
     {
         pauFields[i].Set.nMarker1 = OGRUnsetMarker;
@@ -153,12 +156,16 @@ OGRFeature::~OGRFeature()
     for( i = 0; i < nGeomFieldCount; i++ )
     {
         delete papoGeometries[i];
+        if( papabyGeometryWkb != NULL )
+            CPLFree( papabyGeometryWkb[i] );
     }
     
     poDefn->Release();
 
     CPLFree( pauFields );
     CPLFree( papoGeometries );
+    CPLFree( papabyGeometryWkb );
+    CPLFree( panGeometryWkbSize );
     CPLFree(m_pszStyleString);
     CPLFree(m_pszTmpFieldValue);
 }
@@ -415,6 +422,8 @@ OGRGeometry *OGRFeature::StealGeometry()
 {
     if( GetGeomFieldCount() > 0 )
     {
+        DecodeGeometryWkb( 0 );
+
         OGRGeometry *poReturn = papoGeometries[0];
         papoGeometries[0] = NULL;
         return poReturn;
@@ -428,6 +437,8 @@ OGRGeometry *OGRFeature::StealGeometry(int iGeomField)
 {
     if( iGeomField >= 0 && iGeomField < GetGeomFieldCount() )
     {
+        DecodeGeometryWkb( iGeomField );
+
         OGRGeometry *poReturn = papoGeometries[iGeomField];
         papoGeometries[iGeomField] = NULL;
         return poReturn;
@@ -531,8 +542,10 @@ OGRGeometry *OGRFeature::GetGeomFieldRef(int iField)
 {
     if( iField < 0 || iField >= GetGeomFieldCount() )
         return NULL;
-    else
-        return papoGeometries[iField];
+
+    DecodeGeometryWkb( iField );
+
+    return papoGeometries[iField];
 }
 
 /************************************************************************/
@@ -555,8 +568,10 @@ OGRGeometry *OGRFeature::GetGeomFieldRef(const char* pszFName)
     int iField = GetGeomFieldIndex(pszFName);
     if( iField < 0 )
         return NULL;
-    else
-        return papoGeometries[iField];
+
+    DecodeGeometryWkb( iField );
+
+    return papoGeometries[iField];
 }
 
 /************************************************************************/
@@ -615,6 +630,8 @@ OGRErr OGRFeature::SetGeomFieldDirectly( int iField, OGRGeometry * poGeomIn )
     if( iField < 0 || iField >= GetGeomFieldCount() )
         return OGRERR_FAILURE;
 
+    DiscardGeometryWkb( iField );
+
     delete papoGeometries[iField];
     papoGeometries[iField] = poGeomIn;
 
@@ -689,6 +706,8 @@ OGRErr OGRFeature::SetGeomField( int iField, OGRGeometry * poGeomIn )
     if( iField < 0 || iField >= GetGeomFieldCount() )
         return OGRERR_FAILURE;
 
+    DiscardGeometryWkb( iField );
+
     delete papoGeometries[iField];
 
     if( poGeomIn != NULL )
@@ -731,6 +750,319 @@ OGRErr OGR_F_SetGeomField( OGRFeatureH hFeat, int iField, OGRGeometryH hGeom )
     return ((OGRFeature *) hFeat)->SetGeomField(iField, (OGRGeometry *) hGeom);
 }
 
+/************************************************************************/
+/*                      SetGeomFieldWkbDirectly()                       */
+/************************************************************************/
+
+/**
+ * \brief Set feature geometry of a specified geometry field from WKB.
+ *
+ * The WKB is kept as is in the feature and is only decoded into an
+ * OGRGeometry when the geometry is requested, by GetGeomFieldRef() or any
+ * other method needing it.  Drivers that read geometries as WKB can use
+ * this to avoid decoding geometries that the application never looks at,
+ * or that are just written back as WKB (see GetGeomFieldWkbRef()).
+ *
+ * The buffer is assumed to hold a valid geometry, for instance as checked
+ * by OGRWKBGeometryView::Init().  If it cannot be decoded later, the
+ * geometry field will appear as NULL.
+ *
+ * This method is the same as the C function OGR_F_SetGeomFieldWkbDirectly().
+ *
+ * @param iField geometry field to set.
+ * @param pabyWKB WKB buffer allocated with CPLMalloc(), of which the
+ * feature takes ownership.  Passing NULL clears the geometry field.
+ * @param nWKBSize size of the buffer in bytes.
+ *
+ * @return OGRERR_NONE if successful, or OGRERR_FAILURE if the index is
+ * invalid (in which case the buffer is freed).
+ *
+ * @since GDAL 1.11
+ */
+
+OGRErr OGRFeature::SetGeomFieldWkbDirectly( int iField, GByte *pabyWKB,
+                                            int nWKBSize )
+
+{
+    if( iField < 0 || iField >= GetGeomFieldCount() )
+    {
+        CPLFree( pabyWKB );
+        return OGRERR_FAILURE;
+    }
+
+    DiscardGeometryWkb( iField );
+
+    delete papoGeometries[iField];
+    papoGeometries[iField] = NULL;
+
+    if( pabyWKB == NULL )
+        return OGRERR_NONE;
+
+    if( papabyGeometryWkb == NULL )
+    {
+        papabyGeometryWkb = (GByte **)
+            CPLCalloc( GetGeomFieldCount(), sizeof(GByte*) );
+        panGeometryWkbSize = (int *)
+            CPLCalloc( GetGeomFieldCount(), sizeof(int) );
+    }
+
+    papabyGeometryWkb[iField] = pabyWKB;
+    panGeometryWkbSize[iField] = nWKBSize;
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                         CopyGeomFieldFrom()                          */
+/*                                                                      */
+/*      Set geometry field iField to a copy of geometry field           */
+/*      iSrcField of poSrcFeature.  Pending WKB is copied as is, so     */
+/*      that the copy stays lazy and the source is not decoded.         */
+/************************************************************************/
+
+void OGRFeature::CopyGeomFieldFrom( int iField, OGRFeature *poSrcFeature,
+                                    int iSrcField )
+
+{
+    int          nWKBSize;
+    const GByte *pabySrcWKB = poSrcFeature->GetGeomFieldWkbRef( iSrcField,
+                                                                &nWKBSize );
+
+    if( pabySrcWKB != NULL )
+    {
+        GByte *pabyWKB = (GByte *) CPLMalloc( nWKBSize );
+        memcpy( pabyWKB, pabySrcWKB, nWKBSize );
+        SetGeomFieldWkbDirectly( iField, pabyWKB, nWKBSize );
+    }
+    else
+        SetGeomField( iField, poSrcFeature->GetGeomFieldRef( iSrcField ) );
+}
+
+/************************************************************************/
+/*                   OGR_F_SetGeomFieldWkbDirectly()                    */
+/************************************************************************/
+
+/**
+ * \brief Set feature geometry of a specified geometry field from WKB.
+ *
+ * This function is the same as the C++ method
+ * OGRFeature::SetGeomFieldWkbDirectly().
+ *
+ * @param hFeat handle to the feature on which to apply the geometry.
+ * @param iField geometry field to set.
+ * @param pabyWKB WKB buffer allocated with CPLMalloc(), of which the
+ * feature takes ownership.
+ * @param nWKBSize size of the buffer in bytes.
+ *
+ * @return OGRERR_NONE if successful, or OGRERR_FAILURE if the index is
+ * invalid.
+ *
+ * @since GDAL 1.11
+ */
+
+OGRErr OGR_F_SetGeomFieldWkbDirectly( OGRFeatureH hFeat, int iField,
+                                      GByte *pabyWKB, int nWKBSize )
+
+{
+    VALIDATE_POINTER1( hFeat, "OGR_F_SetGeomFieldWkbDirectly", CE_Failure );
+
+    return ((OGRFeature *) hFeat)->SetGeomFieldWkbDirectly( iField, pabyWKB,
+                                                            nWKBSize );
+}
+
+/************************************************************************/
+/*                         GetGeomFieldWkbRef()                         */
+/************************************************************************/
+
+/**
+ * \brief Fetch the pending WKB of a geometry field.
+ *
+ * If the geometry field was set with SetGeomFieldWkbDirectly() and has not
+ * been decoded yet, the WKB buffer is returned so that it can be used
+ * (written out, or inspected with OGRWKBGeometryView) without decoding.
+ * Otherwise NULL is returned, and GetGeomFieldRef() should be used.
+ *
+ * This method is the same as the C function OGR_F_GetGeomFieldWkbRef().
+ *
+ * @param iField geometry field to get.
+ * @param pnWKBSize location in which the size of the buffer is returned
+ * (may be NULL).
+ *
+ * @return the internal WKB buffer, which should not be modified, or NULL.
+ *
+ * @since GDAL 1.11
+ */
+
+const GByte *OGRFeature::GetGeomFieldWkbRef( int iField, int *pnWKBSize )
+
+{
+    if( pnWKBSize != NULL )
+        *pnWKBSize = 0;
+
+    if( papabyGeometryWkb == NULL
+        || iField < 0 || iField >= GetGeomFieldCount()
+        || papabyGeometryWkb[iField] == NULL )
+        return NULL;
+
+    if( pnWKBSize != NULL )
+        *pnWKBSize = panGeometryWkbSize[iField];
+
+    return papabyGeometryWkb[iField];
+}
+
+/************************************************************************/
+/*                      OGR_F_GetGeomFieldWkbRef()                      */
+/************************************************************************/
+
+/**
+ * \brief Fetch the pending WKB of a geometry field.
+ *
+ * This function is the same as the C++ method
+ * OGRFeature::GetGeomFieldWkbRef().
+ *
+ * @param hFeat handle to the feature.
+ * @param iField geometry field to get.
+ * @param pnWKBSize location in which the size of the buffer is returned
+ * (may be NULL).
+ *
+ * @return the internal WKB buffer, which should not be modified, or NULL.
+ *
+ * @since GDAL 1.11
+ */
+
+const GByte *OGR_F_GetGeomFieldWkbRef( OGRFeatureH hFeat, int iField,
+                                       int *pnWKBSize )
+
+{
+    VALIDATE_POINTER1( hFeat, "OGR_F_GetGeomFieldWkbRef", NULL );
+
+    return ((OGRFeature *) hFeat)->GetGeomFieldWkbRef( iField, pnWKBSize );
+}
+
+/************************************************************************/
+/*                        GetGeomFieldEnvelope()                        */
+/************************************************************************/
+
+/**
+ * \brief Compute the envelope of a geometry field.
+ *
+ * When the geometry is still pending as WKB, the envelope is computed
+ * from the buffer with OGRWKBGeometryView, without decoding the geometry.
+ *
+ * This method is the same as the C function OGR_F_GetGeomFieldEnvelope().
+ *
+ * @param iField geometry field.
+ * @param psEnvelope the structure in which to place the results.
+ *
+ * @return OGRERR_NONE on success, or OGRERR_FAILURE if the index is invalid
+ * or the geometry field is NULL.
+ *
+ * @since GDAL 1.11
+ */
+
+OGRErr OGRFeature::GetGeomFieldEnvelope( int iField, OGREnvelope *psEnvelope )
+
+{
+    if( iField < 0 || iField >= GetGeomFieldCount() )
+        return OGRERR_FAILURE;
+
+    if( papabyGeometryWkb != NULL && papabyGeometryWkb[iField] != NULL )
+    {
+        OGRWKBGeometryView oView;
+
+        if( oView.Init( papabyGeometryWkb[iField],
+                        panGeometryWkbSize[iField] ) == OGRERR_NONE )
+        {
+            oView.getEnvelope( psEnvelope );
+            return OGRERR_NONE;
+        }
+    }
+
+    OGRGeometry *poGeom = GetGeomFieldRef( iField );
+    if( poGeom == NULL )
+        return OGRERR_FAILURE;
+
+    poGeom->getEnvelope( psEnvelope );
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                     OGR_F_GetGeomFieldEnvelope()                     */
+/************************************************************************/
+
+/**
+ * \brief Compute the envelope of a geometry field.
+ *
+ * This function is the same as the C++ method
+ * OGRFeature::GetGeomFieldEnvelope().
+ *
+ * @param hFeat handle to the feature.
+ * @param iField geometry field.
+ * @param psEnvelope the structure in which to place the results.
+ *
+ * @return OGRERR_NONE on success, or OGRERR_FAILURE if the index is invalid
+ * or the geometry field is NULL.
+ *
+ * @since GDAL 1.11
+ */
+
+OGRErr OGR_F_GetGeomFieldEnvelope( OGRFeatureH hFeat, int iField,
+                                   OGREnvelope *psEnvelope )
+
+{
+    VALIDATE_POINTER1( hFeat, "OGR_F_GetGeomFieldEnvelope", CE_Failure );
+
+    return ((OGRFeature *) hFeat)->GetGeomFieldEnvelope( iField, psEnvelope );
+}
+
+/************************************************************************/
+/*                         DecodeGeometryWkb()                          */
+/*                                                                      */
+/*      Turn the pending WKB of a geometry field, if any, into an       */
+/*      OGRGeometry.                                                    */
+/************************************************************************/
+
+void OGRFeature::DecodeGeometryWkb( int iField )
+
+{
+    if( papabyGeometryWkb == NULL || papabyGeometryWkb[iField] == NULL )
+        return;
+
+    OGRGeometry *poGeom = NULL;
+    OGRSpatialReference *poSRS =
+        poDefn->GetGeomFieldDefn(iField)->GetSpatialRef();
+
+    if( OGRGeometryFactory::createFromWkb( papabyGeometryWkb[iField], poSRS,
+                                           &poGeom,
+                                           panGeometryWkbSize[iField] )
+        != OGRERR_NONE )
+    {
+        CPLDebug( "OGR", "Cannot decode WKB geometry of feature %ld.", nFID );
+        poGeom = NULL;
+    }
+
+    CPLFree( papabyGeometryWkb[iField] );
+    papabyGeometryWkb[iField] = NULL;
+
+    delete papoGeometries[iField];
+    papoGeometries[iField] = poGeom;
+}
+
+/************************************************************************/
+/*                         DiscardGeometryWkb()                         */
+/************************************************************************/
+
+void OGRFeature::DiscardGeometryWkb( int iField )
+
+{
+    if( papabyGeometryWkb == NULL )
+        return;
+
+    CPLFree( papabyGeometryWkb[iField] );
+    papabyGeometryWkb[iField] = NULL;
+}
+
 /************************************************************************/
 /*                               Clone()                                */
 /************************************************************************/
@@ -758,7 +1090,7 @@ OGRFeature *OGRFeature::Clone()
     }
     for( i = 0; i < poDefn->GetGeomFieldCount(); i++ )
     {
-        poNew->SetGeomField( i, papoGeometries[i] );
+        poNew->CopyGeomFieldFrom( i, this, i );
     }
 
     if( GetStyleString() != NULL )
@@ -1075,6 +1407,10 @@ int OGRFeature::IsFieldSet( int iField )
     int iSpecialField = iField - poDefn->GetFieldCount();
     if (iSpecialField >= 0)
     {
+        // the geometry based special fields need the decoded geometry
+        if( iSpecialField != SPF_FID && GetGeomFieldCount() > 0 )
+            DecodeGeometryWkb( 0 );
+
         // special field value accessors
         switch (iSpecialField)
         {
@@ -1204,6 +1540,44 @@ void OGR_F_UnsetField( OGRFeatureH hFeat, int iField )
     ((OGRFeature *) hFeat)->UnsetField( iField );
 }
 
+/************************************************************************/
+/*                               Reset()                                */
+/************************************************************************/
+
+/**
+ * \brief Clear all the content of the feature.
+ *
+ * All the fields are unset, the geometries are destroyed, and the FID
+ * and the style string are cleared.  The feature keeps its field and
+ * geometry arrays, so that it can be filled again, for instance by
+ * OGRLayer::GetNextFeatureInto(), without reallocating them.
+ *
+ * @since GDAL 1.11
+ */
+
+void OGRFeature::Reset()
+
+{
+    int i;
+
+    int nFieldCount = poDefn->GetFieldCount();
+    for( i = 0; i < nFieldCount; i++ )
+        UnsetField( i );
+
+    int nGeomFieldCount = poDefn->GetGeomFieldCount();
+    for( i = 0; i < nGeomFieldCount; i++ )
+    {
+        delete papoGeometries[i];
+        papoGeometries[i] = NULL;
+        DiscardGeometryWkb( i );
+    }
+
+    nFID = OGRNullFID;
+
+    CPLFree( m_pszStyleString );
+    m_pszStyleString = NULL;
+}
+
 /************************************************************************/
 /*                           GetRawFieldRef()                           */
 /************************************************************************/
@@ -1269,6 +1643,10 @@ int OGRFeature::GetFieldAsInteger( int iField )
     int iSpecialField = iField - poDefn->GetFieldCount();
     if (iSpecialField >= 0)
     {
+        // the geometry based special fields need the decoded geometry
+        if( iSpecialField != SPF_FID && GetGeomFieldCount() > 0 )
+            DecodeGeometryWkb( 0 );
+
     // special field value accessors
         switch (iSpecialField)
         {
@@ -1359,6 +1737,10 @@ double OGRFeature::GetFieldAsDouble( int iField )
     int iSpecialField = iField - poDefn->GetFieldCount();
     if (iSpecialField >= 0)
     {
+        // the geometry based special fields need the decoded geometry
+        if( iSpecialField != SPF_FID && GetGeomFieldCount() > 0 )
+            DecodeGeometryWkb( 0 );
+
     // special field value accessors
         switch (iSpecialField)
         {
@@ -1456,6 +1838,10 @@ const char *OGRFeature::GetFieldAsString( int iField )
     int iSpecialField = iField - poDefn->GetFieldCount();
     if (iSpecialField >= 0)
     {
+        // the geometry based special fields need the decoded geometry
+        if( iSpecialField != SPF_FID && GetGeomFieldCount() > 0 )
+            DecodeGeometryWkb( 0 );
+
         // special field value accessors
         switch (iSpecialField)
         {
@@ -3033,6 +3419,8 @@ void OGRFeature::DumpReadable( FILE * fpOut, char** papszOptions )
             {
                 OGRGeomFieldDefn    *poFDefn = poDefn->GetGeomFieldDefn(iField);
 
+                DecodeGeometryWkb( iField );
+
                 if( papoGeometries[iField] != NULL )
                 {
                     fprintf( fpOut, "  " );
@@ -3515,10 +3903,10 @@ OGRErr OGRFeature::SetFrom( OGRFeature * poSrcFeature, int *panMap ,
         int iSrc = poSrcFeature->GetGeomFieldIndex(
                                     poGFieldDefn->GetNameRef());
         if( iSrc >= 0 )
-            SetGeomField( 0, poSrcFeature->GetGeomFieldRef(iSrc) );
+            CopyGeomFieldFrom( 0, poSrcFeature, iSrc );
         else
             /* whatever the geometry field names are. For backward compatibility */
-            SetGeomField( 0, poSrcFeature->GetGeomFieldRef(0) );
+            CopyGeomFieldFrom( 0, poSrcFeature, 0 );
     }
     else
     {
@@ -3530,7 +3918,7 @@ OGRErr OGRFeature::SetFrom( OGRFeature * poSrcFeature, int *panMap ,
             int iSrc = poSrcFeature->GetGeomFieldIndex(
                                         poGFieldDefn->GetNameRef());
             if( iSrc >= 0 )
-                SetGeomField( i, poSrcFeature->GetGeomFieldRef(iSrc) );
+                CopyGeomFieldFrom( i, poSrcFeature, iSrc );
             else
                 SetGeomField( i, NULL );
         }
@@ -3961,6 +4349,22 @@ OGRErr OGRFeature::RemapGeomFields( OGRFeatureDefn *poNewDefn,
     if( poNewDefn == NULL )
         poNewDefn = poDefn;
 
+/* -------------------------------------------------------------------- */
+/*      Pending WKB geometries are decoded, since their arrays are      */
+/*      sized after the old definition.                                 */
+/* -------------------------------------------------------------------- */
+    if( papabyGeometryWkb != NULL )
+    {
+        for( iDstField = 0; iDstField < poDefn->GetGeomFieldCount();
+             iDstField++ )
+            DecodeGeometryWkb( iDstField );
+
+        CPLFree( papabyGeometryWkb );
+        papabyGeometryWkb = NULL;
+        CPLFree( panGeometryWkbSize );
+        panGeometryWkbSize = NULL;
+    }
+
     papoNewGeomFields = (OGRGeometry **) CPLCalloc( poNewDefn->GetGeomFieldCount(), 
                                            sizeof(OGRGeometry*) );
 
@@ -0,0 +1,1010 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  The OGRFeatureBatch class implementation, a column oriented
+ *           container for a batch of features.
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_feature.h"
+#include "ogr_api.h"
+#include "ogr_p.h"
+
+CPL_CVSID("$Id$");
+
+/************************************************************************/
+/*                        OGRFeatureBatchColumn                         */
+/************************************************************************/
+
+struct OGRFeatureBatchColumn
+{
+    int           iField;
+    OGRFieldType  eType;        /* OFTInteger, OFTReal or OFTString */
+
+    GByte        *pabyValidity;
+
+    int          *panValues;
+    double       *padfValues;
+
+    int          *panOffsets;
+    char         *pachData;
+    int           nDataSize;
+    int           nDataAlloc;
+};
+
+/************************************************************************/
+/*                          OGRFeatureBatch()                           */
+/************************************************************************/
+
+/**
+ * \brief Constructor.
+ *
+ * The batch is not usable before Prepare() has been called, which is
+ * normally done by OGRLayer::GetNextBatch().
+ *
+ * This method is the same as the C function OGR_FB_Create().
+ *
+ * @param nMaxFeaturesIn maximum number of features held by the batch.
+ *
+ * @since GDAL 1.11
+ */
+
+OGRFeatureBatch::OGRFeatureBatch( int nMaxFeaturesIn )
+
+{
+    nMaxFeatures = MAX(1, nMaxFeaturesIn);
+    nFeatures = 0;
+
+    poDefn = NULL;
+    poScratchFeature = NULL;
+
+    nColumns = 0;
+    pasColumns = NULL;
+
+    panFIDs = (long *) CPLMalloc( sizeof(long) * nMaxFeatures );
+
+    bHasGeometry = FALSE;
+    panWKBOffsets = (int *) CPLMalloc( sizeof(int) * (nMaxFeatures + 1) );
+    panWKBOffsets[0] = 0;
+    pabyWKB = NULL;
+    nWKBSize = 0;
+    nWKBAlloc = 0;
+}
+
+/************************************************************************/
+/*                          ~OGRFeatureBatch()                          */
+/************************************************************************/
+
+OGRFeatureBatch::~OGRFeatureBatch()
+
+{
+    FreeColumns();
+
+    delete poScratchFeature;
+    if( poDefn != NULL )
+        poDefn->Release();
+
+    CPLFree( panFIDs );
+    CPLFree( panWKBOffsets );
+    CPLFree( pabyWKB );
+}
+
+/************************************************************************/
+/*                            FreeColumns()                             */
+/************************************************************************/
+
+void OGRFeatureBatch::FreeColumns()
+
+{
+    for( int iColumn = 0; iColumn < nColumns; iColumn++ )
+    {
+        CPLFree( pasColumns[iColumn].pabyValidity );
+        CPLFree( pasColumns[iColumn].panValues );
+        CPLFree( pasColumns[iColumn].padfValues );
+        CPLFree( pasColumns[iColumn].panOffsets );
+        CPLFree( pasColumns[iColumn].pachData );
+    }
+    CPLFree( pasColumns );
+
+    pasColumns = NULL;
+    nColumns = 0;
+}
+
+/************************************************************************/
+/*                              Prepare()                               */
+/************************************************************************/
+
+/**
+ * \brief Empty the batch and set it up for a feature definition.
+ *
+ * One column is created for each field of poDefnIn that is not ignored,
+ * and the geometry of the first geometry field is collected unless it is
+ * ignored.  The buffers are kept from one batch to the next as long as
+ * the set of columns does not change.
+ *
+ * @param poDefnIn the feature definition of the layer being read.
+ */
+
+void OGRFeatureBatch::Prepare( OGRFeatureDefn *poDefnIn )
+
+{
+    int iField, iColumn;
+
+/* -------------------------------------------------------------------- */
+/*      Keep a feature around for the generic implementation of        */
+/*      OGRLayer::GetNextBatch().                                       */
+/* -------------------------------------------------------------------- */
+    if( poDefnIn != poDefn )
+    {
+        delete poScratchFeature;
+        if( poDefn != NULL )
+            poDefn->Release();
+
+        poDefn = poDefnIn;
+        poDefn->Reference();
+        poScratchFeature = new OGRFeature( poDefn );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Check if the selected columns are still the same.               */
+/* -------------------------------------------------------------------- */
+    int nFieldCount = poDefn->GetFieldCount();
+    int bSameColumns = TRUE;
+
+    iColumn = 0;
+    for( iField = 0; iField < nFieldCount && bSameColumns; iField++ )
+    {
+        OGRFieldDefn *poFieldDefn = poDefn->GetFieldDefn( iField );
+        if( poFieldDefn->IsIgnored() )
+            continue;
+
+        if( iColumn >= nColumns
+            || pasColumns[iColumn].iField != iField
+            || pasColumns[iColumn].eType != poFieldDefn->GetType() )
+            bSameColumns = FALSE;
+        iColumn++;
+    }
+    if( iColumn != nColumns )
+        bSameColumns = FALSE;
+
+/* -------------------------------------------------------------------- */
+/*      Otherwise rebuild them.                                         */
+/* -------------------------------------------------------------------- */
+    if( !bSameColumns )
+    {
+        FreeColumns();
+
+        pasColumns = (OGRFeatureBatchColumn *)
+            CPLCalloc( sizeof(OGRFeatureBatchColumn), nFieldCount + 1 );
+
+        for( iField = 0; iField < nFieldCount; iField++ )
+        {
+            OGRFieldDefn *poFieldDefn = poDefn->GetFieldDefn( iField );
+            if( poFieldDefn->IsIgnored() )
+                continue;
+
+            OGRFeatureBatchColumn *psColumn = pasColumns + nColumns;
+
+            psColumn->iField = iField;
+            psColumn->eType = poFieldDefn->GetType();
+            psColumn->pabyValidity = (GByte *) CPLMalloc( (nMaxFeatures+7) / 8 );
+
+            if( psColumn->eType == OFTInteger )
+                psColumn->panValues = (int *)
+                    CPLMalloc( sizeof(int) * nMaxFeatures );
+            else if( psColumn->eType == OFTReal )
+                psColumn->padfValues = (double *)
+                    CPLMalloc( sizeof(double) * nMaxFeatures );
+            else
+                psColumn->panOffsets = (int *)
+                    CPLMalloc( sizeof(int) * (nMaxFeatures + 1) );
+
+            nColumns++;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Empty the batch.                                                */
+/* -------------------------------------------------------------------- */
+    nFeatures = 0;
+
+    for( iColumn = 0; iColumn < nColumns; iColumn++ )
+    {
+        OGRFeatureBatchColumn *psColumn = pasColumns + iColumn;
+
+        memset( psColumn->pabyValidity, 0, (nMaxFeatures+7) / 8 );
+        psColumn->nDataSize = 0;
+        if( psColumn->panOffsets != NULL )
+            psColumn->panOffsets[0] = 0;
+    }
+
+    bHasGeometry = poDefn->GetGeomFieldCount() > 0
+        && !poDefn->GetGeomFieldDefn(0)->IsIgnored();
+    nWKBSize = 0;
+    panWKBOffsets[0] = 0;
+}
+
+/************************************************************************/
+/*                        GetColumnFieldIndex()                         */
+/************************************************************************/
+
+/**
+ * \brief Fetch the index, in the layer definition, of the field of a column.
+ *
+ * This method is the same as the C function OGR_FB_GetColumnFieldIndex().
+ *
+ * @param iColumn the column, between 0 and GetColumnCount()-1.
+ *
+ * @return the field index, or -1 if iColumn is invalid.
+ */
+
+int OGRFeatureBatch::GetColumnFieldIndex( int iColumn )
+
+{
+    if( iColumn < 0 || iColumn >= nColumns )
+        return -1;
+
+    return pasColumns[iColumn].iField;
+}
+
+/************************************************************************/
+/*                           GetColumnType()                            */
+/************************************************************************/
+
+/**
+ * \brief Fetch how the values of a column are stored.
+ *
+ * This method is the same as the C function OGR_FB_GetColumnType().
+ *
+ * @param iColumn the column, between 0 and GetColumnCount()-1.
+ *
+ * @return OFTInteger, OFTReal, or OFTString for all the other field types,
+ * which are stored as strings formatted like OGRFeature::GetFieldAsString().
+ */
+
+OGRFieldType OGRFeatureBatch::GetColumnType( int iColumn )
+
+{
+    if( iColumn < 0 || iColumn >= nColumns )
+        return OFTString;
+
+    if( pasColumns[iColumn].eType == OFTInteger
+        || pasColumns[iColumn].eType == OFTReal )
+        return pasColumns[iColumn].eType;
+
+    return OFTString;
+}
+
+/************************************************************************/
+/*                         GetColumnValidity()                          */
+/************************************************************************/
+
+/**
+ * \brief Fetch the validity bitmap of a column.
+ *
+ * Bit (i % 8) of byte (i / 8) is set when the field of the i-th feature of
+ * the batch is set.
+ *
+ * This method is the same as the C function OGR_FB_GetColumnValidity().
+ *
+ * @param iColumn the column, between 0 and GetColumnCount()-1.
+ *
+ * @return the bitmap, owned by the batch, or NULL if iColumn is invalid.
+ */
+
+const GByte *OGRFeatureBatch::GetColumnValidity( int iColumn )
+
+{
+    if( iColumn < 0 || iColumn >= nColumns )
+        return NULL;
+
+    return pasColumns[iColumn].pabyValidity;
+}
+
+/************************************************************************/
+/*                        GetColumnAsIntegers()                         */
+/************************************************************************/
+
+/**
+ * \brief Fetch the values of an OFTInteger column.
+ *
+ * The values of unset fields are 0.
+ *
+ * This method is the same as the C function OGR_FB_GetColumnAsIntegers().
+ *
+ * @param iColumn the column, between 0 and GetColumnCount()-1.
+ *
+ * @return an array of GetFeatureCount() values owned by the batch, or NULL
+ * if the column is not of type OFTInteger.
+ */
+
+const int *OGRFeatureBatch::GetColumnAsIntegers( int iColumn )
+
+{
+    if( iColumn < 0 || iColumn >= nColumns )
+        return NULL;
+
+    return pasColumns[iColumn].panValues;
+}
+
+/************************************************************************/
+/*                         GetColumnAsDoubles()                         */
+/************************************************************************/
+
+/**
+ * \brief Fetch the values of an OFTReal column.
+ *
+ * The values of unset fields are 0.
+ *
+ * This method is the same as the C function OGR_FB_GetColumnAsDoubles().
+ *
+ * @param iColumn the column, between 0 and GetColumnCount()-1.
+ *
+ * @return an array of GetFeatureCount() values owned by the batch, or NULL
+ * if the column is not of type OFTReal.
+ */
+
+const double *OGRFeatureBatch::GetColumnAsDoubles( int iColumn )
+
+{
+    if( iColumn < 0 || iColumn >= nColumns )
+        return NULL;
+
+    return pasColumns[iColumn].padfValues;
+}
+
+/************************************************************************/
+/*                       GetColumnStringOffsets()                       */
+/************************************************************************/
+
+/**
+ * \brief Fetch the offsets of the values of an OFTString column.
+ *
+ * The value of the i-th feature is made of the bytes between offsets i
+ * and i+1 of GetColumnStringData().  It is not nul terminated.  Unset
+ * fields have an empty value.
+ *
+ * This method is the same as the C function OGR_FB_GetColumnStringOffsets().
+ *
+ * @param iColumn the column, between 0 and GetColumnCount()-1.
+ *
+ * @return an array of GetFeatureCount()+1 offsets owned by the batch, or
+ * NULL if the column is not of type OFTString.
+ */
+
+const int *OGRFeatureBatch::GetColumnStringOffsets( int iColumn )
+
+{
+    if( iColumn < 0 || iColumn >= nColumns )
+        return NULL;
+
+    return pasColumns[iColumn].panOffsets;
+}
+
+/************************************************************************/
+/*                        GetColumnStringData()                         */
+/************************************************************************/
+
+/**
+ * \brief Fetch the character buffer of an OFTString column.
+ *
+ * This method is the same as the C function OGR_FB_GetColumnStringData().
+ *
+ * @param iColumn the column, between 0 and GetColumnCount()-1.
+ *
+ * @return the buffer owned by the batch, or NULL if the column is not of
+ * type OFTString or if all its values are empty.
+ */
+
+const char *OGRFeatureBatch::GetColumnStringData( int iColumn )
+
+{
+    if( iColumn < 0 || iColumn >= nColumns )
+        return NULL;
+
+    return pasColumns[iColumn].pachData;
+}
+
+/************************************************************************/
+/*                             AddFeature()                             */
+/************************************************************************/
+
+/**
+ * \brief Append a copy of the fields and geometry of a feature.
+ *
+ * The feature must be of the definition the batch has been prepared for,
+ * and the batch must not be full.
+ *
+ * @param poFeature the feature to append.
+ */
+
+void OGRFeatureBatch::AddFeature( OGRFeature *poFeature )
+
+{
+    BeginFeature( poFeature->GetFID() );
+
+    for( int iColumn = 0; iColumn < nColumns; iColumn++ )
+    {
+        int iField = pasColumns[iColumn].iField;
+
+        if( !poFeature->IsFieldSet( iField ) )
+            continue;
+
+        switch( pasColumns[iColumn].eType )
+        {
+          case OFTInteger:
+            SetInteger( iColumn, poFeature->GetFieldAsInteger( iField ) );
+            break;
+
+          case OFTReal:
+            SetDouble( iColumn, poFeature->GetFieldAsDouble( iField ) );
+            break;
+
+          default:
+            SetString( iColumn, poFeature->GetFieldAsString( iField ) );
+            break;
+        }
+    }
+
+    if( bHasGeometry )
+        SetGeometry( poFeature->GetGeomFieldRef( 0 ) );
+
+    EndFeature();
+}
+
+/************************************************************************/
+/*                            BeginFeature()                            */
+/*                                                                      */
+/*      Start a new row.  Drivers that fill the batch directly call     */
+/*      BeginFeature(), then the setters for the columns and geometry   */
+/*      that are set, at most once each, and then EndFeature().         */
+/************************************************************************/
+
+void OGRFeatureBatch::BeginFeature( long nFID )
+
+{
+    CPLAssert( nFeatures < nMaxFeatures );
+
+    panFIDs[nFeatures] = nFID;
+
+    for( int iColumn = 0; iColumn < nColumns; iColumn++ )
+    {
+        if( pasColumns[iColumn].panValues != NULL )
+            pasColumns[iColumn].panValues[nFeatures] = 0;
+        else if( pasColumns[iColumn].padfValues != NULL )
+            pasColumns[iColumn].padfValues[nFeatures] = 0.0;
+    }
+}
+
+/************************************************************************/
+/*                             SetInteger()                             */
+/************************************************************************/
+
+void OGRFeatureBatch::SetInteger( int iColumn, int nValue )
+
+{
+    OGRFeatureBatchColumn *psColumn = pasColumns + iColumn;
+
+    if( psColumn->panValues != NULL )
+        psColumn->panValues[nFeatures] = nValue;
+    else if( psColumn->padfValues != NULL )
+        psColumn->padfValues[nFeatures] = nValue;
+    else
+    {
+        SetString( iColumn, CPLSPrintf( "%d", nValue ) );
+        return;
+    }
+
+    psColumn->pabyValidity[nFeatures >> 3] |= (GByte) (1 << (nFeatures & 7));
+}
+
+/************************************************************************/
+/*                             SetDouble()                              */
+/************************************************************************/
+
+void OGRFeatureBatch::SetDouble( int iColumn, double dfValue )
+
+{
+    OGRFeatureBatchColumn *psColumn = pasColumns + iColumn;
+
+    if( psColumn->padfValues != NULL )
+        psColumn->padfValues[nFeatures] = dfValue;
+    else if( psColumn->panValues != NULL )
+        psColumn->panValues[nFeatures] = (int) dfValue;
+    else
+    {
+        SetString( iColumn, CPLSPrintf( "%.15g", dfValue ) );
+        return;
+    }
+
+    psColumn->pabyValidity[nFeatures >> 3] |= (GByte) (1 << (nFeatures & 7));
+}
+
+/************************************************************************/
+/*                           ReserveString()                            */
+/************************************************************************/
+
+char *OGRFeatureBatch::ReserveString( int iColumn, int nLen )
+
+{
+    OGRFeatureBatchColumn *psColumn = pasColumns + iColumn;
+
+    if( psColumn->nDataSize + nLen > psColumn->nDataAlloc )
+    {
+        psColumn->nDataAlloc = MAX( psColumn->nDataSize + nLen,
+                                    psColumn->nDataAlloc * 2 + 256 );
+        psColumn->pachData = (char *)
+            CPLRealloc( psColumn->pachData, psColumn->nDataAlloc );
+    }
+
+    char *pachTarget = psColumn->pachData + psColumn->nDataSize;
+    psColumn->nDataSize += nLen;
+
+    return pachTarget;
+}
+
+/************************************************************************/
+/*                             SetString()                              */
+/************************************************************************/
+
+void OGRFeatureBatch::SetString( int iColumn, const char *pszValue, int nLen )
+
+{
+    OGRFeatureBatchColumn *psColumn = pasColumns + iColumn;
+
+    if( psColumn->panOffsets == NULL )
+    {
+        if( psColumn->panValues != NULL )
+            SetInteger( iColumn, atoi( pszValue ) );
+        else
+            SetDouble( iColumn, CPLAtof( pszValue ) );
+        return;
+    }
+
+    if( nLen < 0 )
+        nLen = (int) strlen( pszValue );
+
+    memcpy( ReserveString( iColumn, nLen ), pszValue, nLen );
+
+    psColumn->pabyValidity[nFeatures >> 3] |= (GByte) (1 << (nFeatures & 7));
+}
+
+/************************************************************************/
+/*                            SetGeometry()                             */
+/************************************************************************/
+
+void OGRFeatureBatch::SetGeometry( OGRGeometry *poGeom )
+
+{
+    if( poGeom == NULL || !bHasGeometry )
+        return;
+
+    int nSize = poGeom->WkbSize();
+
+    if( nWKBSize + nSize > nWKBAlloc )
+    {
+        nWKBAlloc = MAX( nWKBSize + nSize, nWKBAlloc * 2 + 1024 );
+        pabyWKB = (GByte *) CPLRealloc( pabyWKB, nWKBAlloc );
+    }
+
+    poGeom->exportToWkb( wkbNDR, pabyWKB + nWKBSize );
+    nWKBSize += nSize;
+}
+
+/************************************************************************/
+/*                             EndFeature()                             */
+/************************************************************************/
+
+void OGRFeatureBatch::EndFeature()
+
+{
+    for( int iColumn = 0; iColumn < nColumns; iColumn++ )
+    {
+        if( pasColumns[iColumn].panOffsets != NULL )
+            pasColumns[iColumn].panOffsets[nFeatures + 1] =
+                pasColumns[iColumn].nDataSize;
+    }
+
+    panWKBOffsets[nFeatures + 1] = nWKBSize;
+
+    nFeatures++;
+}
+
+/************************************************************************/
+/*                           OGR_FB_Create()                            */
+/************************************************************************/
+
+/**
+ * \brief Create a feature batch.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::OGRFeatureBatch().
+ *
+ * @param nMaxFeatures maximum number of features held by the batch.
+ *
+ * @return a handle to the new batch, to be destroyed with OGR_FB_Destroy().
+ *
+ * @since GDAL 1.11
+ */
+
+OGRFeatureBatchH OGR_FB_Create( int nMaxFeatures )
+
+{
+    return (OGRFeatureBatchH) new OGRFeatureBatch( nMaxFeatures );
+}
+
+/************************************************************************/
+/*                           OGR_FB_Destroy()                           */
+/************************************************************************/
+
+/**
+ * \brief Destroy a feature batch.
+ *
+ * @param hBatch handle to the batch to destroy.
+ *
+ * @since GDAL 1.11
+ */
+
+void OGR_FB_Destroy( OGRFeatureBatchH hBatch )
+
+{
+    delete (OGRFeatureBatch *) hBatch;
+}
+
+/************************************************************************/
+/*                       OGR_FB_GetFeatureCount()                       */
+/************************************************************************/
+
+/**
+ * \brief Fetch the number of features in the batch.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetFeatureCount().
+ *
+ * @param hBatch handle to the batch.
+ *
+ * @return the number of features read by the last OGR_L_GetNextBatch().
+ *
+ * @since GDAL 1.11
+ */
+
+int OGR_FB_GetFeatureCount( OGRFeatureBatchH hBatch )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetFeatureCount", 0 );
+
+    return ((OGRFeatureBatch *) hBatch)->GetFeatureCount();
+}
+
+/************************************************************************/
+/*                       OGR_FB_GetColumnCount()                        */
+/************************************************************************/
+
+/**
+ * \brief Fetch the number of columns in the batch.
+ *
+ * There is one column for each field of the layer that is not ignored.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetColumnCount().
+ *
+ * @param hBatch handle to the batch.
+ *
+ * @return the number of columns.
+ *
+ * @since GDAL 1.11
+ */
+
+int OGR_FB_GetColumnCount( OGRFeatureBatchH hBatch )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetColumnCount", 0 );
+
+    return ((OGRFeatureBatch *) hBatch)->GetColumnCount();
+}
+
+/************************************************************************/
+/*                     OGR_FB_GetColumnFieldIndex()                     */
+/************************************************************************/
+
+/**
+ * \brief Fetch the index, in the layer definition, of the field of a column.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetColumnFieldIndex().
+ *
+ * @param hBatch handle to the batch.
+ * @param iColumn the column, between 0 and OGR_FB_GetColumnCount()-1.
+ *
+ * @return the field index, or -1 if iColumn is invalid.
+ *
+ * @since GDAL 1.11
+ */
+
+int OGR_FB_GetColumnFieldIndex( OGRFeatureBatchH hBatch, int iColumn )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetColumnFieldIndex", -1 );
+
+    return ((OGRFeatureBatch *) hBatch)->GetColumnFieldIndex( iColumn );
+}
+
+/************************************************************************/
+/*                        OGR_FB_GetColumnType()                        */
+/************************************************************************/
+
+/**
+ * \brief Fetch how the values of a column are stored.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetColumnType().
+ *
+ * @param hBatch handle to the batch.
+ * @param iColumn the column, between 0 and OGR_FB_GetColumnCount()-1.
+ *
+ * @return OFTInteger, OFTReal, or OFTString for all the other field types.
+ *
+ * @since GDAL 1.11
+ */
+
+OGRFieldType OGR_FB_GetColumnType( OGRFeatureBatchH hBatch, int iColumn )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetColumnType", OFTString );
+
+    return ((OGRFeatureBatch *) hBatch)->GetColumnType( iColumn );
+}
+
+/************************************************************************/
+/*                      OGR_FB_GetColumnValidity()                      */
+/************************************************************************/
+
+/**
+ * \brief Fetch the validity bitmap of a column.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetColumnValidity().
+ *
+ * @param hBatch handle to the batch.
+ * @param iColumn the column, between 0 and OGR_FB_GetColumnCount()-1.
+ *
+ * @return the bitmap, owned by the batch.
+ *
+ * @since GDAL 1.11
+ */
+
+const GByte *OGR_FB_GetColumnValidity( OGRFeatureBatchH hBatch, int iColumn )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetColumnValidity", NULL );
+
+    return ((OGRFeatureBatch *) hBatch)->GetColumnValidity( iColumn );
+}
+
+/************************************************************************/
+/*                     OGR_FB_GetColumnAsIntegers()                     */
+/************************************************************************/
+
+/**
+ * \brief Fetch the values of an OFTInteger column.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetColumnAsIntegers().
+ *
+ * @param hBatch handle to the batch.
+ * @param iColumn the column, between 0 and OGR_FB_GetColumnCount()-1.
+ *
+ * @return the values, owned by the batch, or NULL.
+ *
+ * @since GDAL 1.11
+ */
+
+const int *OGR_FB_GetColumnAsIntegers( OGRFeatureBatchH hBatch, int iColumn )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetColumnAsIntegers", NULL );
+
+    return ((OGRFeatureBatch *) hBatch)->GetColumnAsIntegers( iColumn );
+}
+
+/************************************************************************/
+/*                     OGR_FB_GetColumnAsDoubles()                      */
+/************************************************************************/
+
+/**
+ * \brief Fetch the values of an OFTReal column.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetColumnAsDoubles().
+ *
+ * @param hBatch handle to the batch.
+ * @param iColumn the column, between 0 and OGR_FB_GetColumnCount()-1.
+ *
+ * @return the values, owned by the batch, or NULL.
+ *
+ * @since GDAL 1.11
+ */
+
+const double *OGR_FB_GetColumnAsDoubles( OGRFeatureBatchH hBatch, int iColumn )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetColumnAsDoubles", NULL );
+
+    return ((OGRFeatureBatch *) hBatch)->GetColumnAsDoubles( iColumn );
+}
+
+/************************************************************************/
+/*                   OGR_FB_GetColumnStringOffsets()                    */
+/************************************************************************/
+
+/**
+ * \brief Fetch the offsets of the values of an OFTString column.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetColumnStringOffsets().
+ *
+ * @param hBatch handle to the batch.
+ * @param iColumn the column, between 0 and OGR_FB_GetColumnCount()-1.
+ *
+ * @return OGR_FB_GetFeatureCount()+1 offsets, owned by the batch, or NULL.
+ *
+ * @since GDAL 1.11
+ */
+
+const int *OGR_FB_GetColumnStringOffsets( OGRFeatureBatchH hBatch,
+                                          int iColumn )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetColumnStringOffsets", NULL );
+
+    return ((OGRFeatureBatch *) hBatch)->GetColumnStringOffsets( iColumn );
+}
+
+/************************************************************************/
+/*                     OGR_FB_GetColumnStringData()                     */
+/************************************************************************/
+
+/**
+ * \brief Fetch the character buffer of an OFTString column.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetColumnStringData().
+ *
+ * @param hBatch handle to the batch.
+ * @param iColumn the column, between 0 and OGR_FB_GetColumnCount()-1.
+ *
+ * @return the buffer, owned by the batch, or NULL.
+ *
+ * @since GDAL 1.11
+ */
+
+const char *OGR_FB_GetColumnStringData( OGRFeatureBatchH hBatch, int iColumn )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetColumnStringData", NULL );
+
+    return ((OGRFeatureBatch *) hBatch)->GetColumnStringData( iColumn );
+}
+
+/************************************************************************/
+/*                           OGR_FB_GetFIDs()                           */
+/************************************************************************/
+
+/**
+ * \brief Fetch the feature ids of the features of the batch.
+ *
+ * This function is the same as the C++ method OGRFeatureBatch::GetFIDs().
+ *
+ * @param hBatch handle to the batch.
+ *
+ * @return OGR_FB_GetFeatureCount() ids, owned by the batch.
+ *
+ * @since GDAL 1.11
+ */
+
+const long *OGR_FB_GetFIDs( OGRFeatureBatchH hBatch )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetFIDs", NULL );
+
+    return ((OGRFeatureBatch *) hBatch)->GetFIDs();
+}
+
+/************************************************************************/
+/*                         OGR_FB_HasGeometry()                         */
+/************************************************************************/
+
+/**
+ * \brief Test if the batch holds the geometries of its features.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::HasGeometry().
+ *
+ * @param hBatch handle to the batch.
+ *
+ * @return TRUE if the layer has a geometry field that is not ignored.
+ *
+ * @since GDAL 1.11
+ */
+
+int OGR_FB_HasGeometry( OGRFeatureBatchH hBatch )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_HasGeometry", FALSE );
+
+    return ((OGRFeatureBatch *) hBatch)->HasGeometry();
+}
+
+/************************************************************************/
+/*                     OGR_FB_GetGeometryOffsets()                      */
+/************************************************************************/
+
+/**
+ * \brief Fetch the offsets of the geometries of the batch.
+ *
+ * The WKB geometry of the i-th feature is made of the bytes between
+ * offsets i and i+1 of OGR_FB_GetGeometryData().  It is empty if the
+ * feature has no geometry.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetGeometryOffsets().
+ *
+ * @param hBatch handle to the batch.
+ *
+ * @return OGR_FB_GetFeatureCount()+1 offsets, owned by the batch.
+ *
+ * @since GDAL 1.11
+ */
+
+const int *OGR_FB_GetGeometryOffsets( OGRFeatureBatchH hBatch )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetGeometryOffsets", NULL );
+
+    return ((OGRFeatureBatch *) hBatch)->GetGeometryOffsets();
+}
+
+/************************************************************************/
+/*                       OGR_FB_GetGeometryData()                       */
+/************************************************************************/
+
+/**
+ * \brief Fetch the little endian WKB buffer of the geometries of the batch.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::GetGeometryData().
+ *
+ * @param hBatch handle to the batch.
+ *
+ * @return the buffer, owned by the batch, or NULL.
+ *
+ * @since GDAL 1.11
+ */
+
+const GByte *OGR_FB_GetGeometryData( OGRFeatureBatchH hBatch )
+
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetGeometryData", NULL );
+
+    return ((OGRFeatureBatch *) hBatch)->GetGeometryData();
+}
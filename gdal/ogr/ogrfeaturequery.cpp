@@ -45,6 +45,465 @@ const char* SpecialFieldNames[SPECIAL_FIELD_COUNT]
 const swq_field_type SpecialFieldTypes[SPECIAL_FIELD_COUNT] 
 = {SWQ_INTEGER, SWQ_STRING, SWQ_STRING, SWQ_STRING, SWQ_FLOAT};
 
+/************************************************************************/
+/*                      Compiled expression program                     */
+/*                                                                      */
+/*      The swq_expr_node tree is flattened, in prefix order, into an   */
+/*      array of instructions.  Each instruction records the index of   */
+/*      the instruction following its subtree, so that AND and OR can   */
+/*      skip their second operand.  Comparisons of a column against     */
+/*      constants are evaluated directly on the feature with constants  */
+/*      converted at compile time, and without allocating any node.     */
+/*      Other subexpressions are handed to swq_expr_node::Evaluate().   */
+/************************************************************************/
+
+#define OGRFQ_TREE          -1
+
+#define OGRFQ_MODE_INTEGER  0
+#define OGRFQ_MODE_FLOAT    1
+#define OGRFQ_MODE_STRING   2
+
+typedef struct
+{
+    int            nValue;
+    double         dfValue;
+    const char    *pszValue;    /* points into the swq_expr_node tree */
+} OGRFQConstant;
+
+typedef struct
+{
+    int            nOperation;  /* swq_op, or OGRFQ_TREE */
+    int            nNext;       /* instruction following this subtree */
+
+    int            iField;
+    int            eMode;
+    int            bIntegerField; /* fetch as integer in float mode */
+    int            iFirstConst;
+    int            nConstCount;
+    char           chEscape;
+
+    swq_expr_node *poNode;      /* for OGRFQ_TREE */
+} OGRFQInstruction;
+
+typedef struct
+{
+    int               nInstrCount;
+    OGRFQInstruction *pasInstr;
+
+    int               nConstCount;
+    OGRFQConstant    *pasConst;
+} OGRFQProgram;
+
+static swq_expr_node *OGRFeatureFetcher( swq_expr_node *op, void *pFeatureIn );
+
+/************************************************************************/
+/*                          OGRFQFreeProgram()                          */
+/************************************************************************/
+
+static void OGRFQFreeProgram( OGRFQProgram *psProg )
+
+{
+    if( psProg == NULL )
+        return;
+
+    CPLFree( psProg->pasInstr );
+    CPLFree( psProg->pasConst );
+    CPLFree( psProg );
+}
+
+/************************************************************************/
+/*                         OGRFQAddConstant()                           */
+/************************************************************************/
+
+static OGRFQConstant *OGRFQAddConstant( OGRFQProgram *psProg )
+
+{
+    psProg->pasConst = (OGRFQConstant *)
+        CPLRealloc( psProg->pasConst,
+                    sizeof(OGRFQConstant) * (psProg->nConstCount + 1) );
+
+    OGRFQConstant *psConst = psProg->pasConst + psProg->nConstCount++;
+    psConst->nValue = 0;
+    psConst->dfValue = 0.0;
+    psConst->pszValue = NULL;
+
+    return psConst;
+}
+
+/************************************************************************/
+/*                       OGRFQCompileComparison()                       */
+/*                                                                      */
+/*      Try to compile a comparison of a column (first operand)        */
+/*      with constants.  The evaluation mode mirrors the choice made   */
+/*      by SWQGeneralEvaluator() from the operand types, so results     */
+/*      are identical to the tree evaluation.  Returns FALSE if the     */
+/*      node cannot be compiled.                                        */
+/************************************************************************/
+
+static int OGRFQCompileComparison( OGRFQProgram *psProg, int iInstr,
+                                   swq_expr_node *poNode )
+
+{
+    if( poNode->eNodeType != SNT_OPERATION )
+        return FALSE;
+
+    switch( (swq_op) poNode->nOperation )
+    {
+      case SWQ_EQ:
+      case SWQ_NE:
+      case SWQ_GT:
+      case SWQ_LT:
+      case SWQ_GE:
+      case SWQ_LE:
+        if( poNode->nSubExprCount != 2 )
+            return FALSE;
+        break;
+
+      case SWQ_BETWEEN:
+        if( poNode->nSubExprCount != 3 )
+            return FALSE;
+        break;
+
+      case SWQ_IN:
+        if( poNode->nSubExprCount < 2 )
+            return FALSE;
+        break;
+
+      case SWQ_LIKE:
+        if( poNode->nSubExprCount != 2 && poNode->nSubExprCount != 3 )
+            return FALSE;
+        break;
+
+      case SWQ_ISNULL:
+        if( poNode->nSubExprCount != 1 )
+            return FALSE;
+        break;
+
+      default:
+        return FALSE;
+    }
+
+    swq_expr_node *poColumn = poNode->papoSubExpr[0];
+
+    if( poColumn->eNodeType != SNT_COLUMN
+        || poColumn->field_type == SWQ_GEOMETRY
+        || poColumn->field_index < 0 )
+        return FALSE;
+
+/* -------------------------------------------------------------------- */
+/*      Select the evaluation mode as SWQGeneralEvaluator() does.       */
+/* -------------------------------------------------------------------- */
+    swq_field_type eColType = poColumn->field_type;
+    int eMode;
+
+    if( eColType == SWQ_FLOAT
+        || (poNode->nSubExprCount > 1
+            && poNode->papoSubExpr[1]->field_type == SWQ_FLOAT) )
+        eMode = OGRFQ_MODE_FLOAT;
+    else if( eColType == SWQ_INTEGER || eColType == SWQ_BOOLEAN )
+        eMode = OGRFQ_MODE_INTEGER;
+    else
+        eMode = OGRFQ_MODE_STRING;
+
+    if( eMode == OGRFQ_MODE_FLOAT
+        && eColType != SWQ_FLOAT && eColType != SWQ_INTEGER
+        && eColType != SWQ_BOOLEAN )
+        return FALSE;
+
+    if( poNode->nOperation == SWQ_LIKE && eMode != OGRFQ_MODE_STRING )
+        return FALSE;
+
+/* -------------------------------------------------------------------- */
+/*      Convert the constant operands.                                  */
+/* -------------------------------------------------------------------- */
+    int nConstCountBefore = psProg->nConstCount;
+    int nLastConst = poNode->nSubExprCount;
+    char chEscape = '\0';
+    int i;
+
+    if( poNode->nOperation == SWQ_LIKE && poNode->nSubExprCount == 3 )
+    {
+        swq_expr_node *poEscape = poNode->papoSubExpr[2];
+        if( poEscape->eNodeType != SNT_CONSTANT || poEscape->is_null
+            || poEscape->string_value == NULL )
+            return FALSE;
+        chEscape = poEscape->string_value[0];
+        nLastConst = 2;
+    }
+
+    for( i = 1; i < nLastConst; i++ )
+    {
+        swq_expr_node *poValue = poNode->papoSubExpr[i];
+        swq_field_type eType = poValue->field_type;
+
+        if( poValue->eNodeType != SNT_CONSTANT || poValue->is_null )
+            break;
+
+        OGRFQConstant *psConst = OGRFQAddConstant( psProg );
+
+        if( eMode == OGRFQ_MODE_FLOAT )
+        {
+            if( eType == SWQ_INTEGER || eType == SWQ_BOOLEAN )
+                psConst->dfValue = poValue->int_value;
+            else if( eType == SWQ_FLOAT )
+                psConst->dfValue = poValue->float_value;
+            else
+                break;
+        }
+        else if( eMode == OGRFQ_MODE_INTEGER )
+        {
+            if( eType == SWQ_INTEGER || eType == SWQ_BOOLEAN )
+                psConst->nValue = poValue->int_value;
+            else
+                break;
+        }
+        else
+        {
+            if( eType == SWQ_INTEGER || eType == SWQ_BOOLEAN
+                || eType == SWQ_FLOAT || poValue->string_value == NULL )
+                break;
+            psConst->pszValue = poValue->string_value;
+        }
+    }
+
+    if( i < nLastConst )
+    {
+        psProg->nConstCount = nConstCountBefore;
+        return FALSE;
+    }
+
+    OGRFQInstruction *psInstr = psProg->pasInstr + iInstr;
+
+    psInstr->nOperation = poNode->nOperation;
+    psInstr->iField = poColumn->field_index;
+    psInstr->eMode = eMode;
+    psInstr->bIntegerField = (eColType != SWQ_FLOAT);
+    psInstr->iFirstConst = nConstCountBefore;
+    psInstr->nConstCount = psProg->nConstCount - nConstCountBefore;
+    psInstr->chEscape = chEscape;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                          OGRFQCompileNode()                          */
+/************************************************************************/
+
+static int OGRFQIsLogicalOperand( swq_expr_node *poNode )
+
+{
+    return poNode->eNodeType == SNT_OPERATION
+        && poNode->field_type == SWQ_BOOLEAN;
+}
+
+static void OGRFQCompileNode( OGRFQProgram *psProg, swq_expr_node *poNode )
+
+{
+    int iInstr = psProg->nInstrCount;
+
+    psProg->pasInstr = (OGRFQInstruction *)
+        CPLRealloc( psProg->pasInstr,
+                    sizeof(OGRFQInstruction) * (psProg->nInstrCount + 1) );
+    memset( psProg->pasInstr + iInstr, 0, sizeof(OGRFQInstruction) );
+    psProg->nInstrCount++;
+
+    if( poNode->eNodeType == SNT_OPERATION
+        && (poNode->nOperation == SWQ_AND || poNode->nOperation == SWQ_OR)
+        && poNode->nSubExprCount == 2
+        && OGRFQIsLogicalOperand( poNode->papoSubExpr[0] )
+        && OGRFQIsLogicalOperand( poNode->papoSubExpr[1] ) )
+    {
+        psProg->pasInstr[iInstr].nOperation = poNode->nOperation;
+        OGRFQCompileNode( psProg, poNode->papoSubExpr[0] );
+        OGRFQCompileNode( psProg, poNode->papoSubExpr[1] );
+    }
+    else if( poNode->eNodeType == SNT_OPERATION
+             && poNode->nOperation == SWQ_NOT
+             && poNode->nSubExprCount == 1
+             && OGRFQIsLogicalOperand( poNode->papoSubExpr[0] ) )
+    {
+        psProg->pasInstr[iInstr].nOperation = SWQ_NOT;
+        OGRFQCompileNode( psProg, poNode->papoSubExpr[0] );
+    }
+    else if( !OGRFQCompileComparison( psProg, iInstr, poNode ) )
+    {
+        psProg->pasInstr[iInstr].nOperation = OGRFQ_TREE;
+        psProg->pasInstr[iInstr].poNode = poNode;
+    }
+
+    psProg->pasInstr[iInstr].nNext = psProg->nInstrCount;
+}
+
+/************************************************************************/
+/*                          OGRFQCompileExpr()                          */
+/*                                                                      */
+/*      Returns NULL if nothing would be gained over the tree           */
+/*      evaluation.                                                     */
+/************************************************************************/
+
+static OGRFQProgram *OGRFQCompileExpr( swq_expr_node *poExpr )
+
+{
+    if( poExpr == NULL
+        || !CSLTestBoolean(
+            CPLGetConfigOption( "OGR_FEATURE_QUERY_COMPILE", "YES" ) ) )
+        return NULL;
+
+    OGRFQProgram *psProg = (OGRFQProgram *) CPLCalloc(1, sizeof(OGRFQProgram));
+
+    OGRFQCompileNode( psProg, poExpr );
+
+    if( psProg->pasInstr[0].nOperation == OGRFQ_TREE )
+    {
+        OGRFQFreeProgram( psProg );
+        return NULL;
+    }
+
+    return psProg;
+}
+
+/************************************************************************/
+/*                           OGRFQEvaluate()                            */
+/************************************************************************/
+
+static int OGRFQEvaluate( const OGRFQProgram *psProg, int iInstr,
+                          OGRFeature *poFeature )
+
+{
+    const OGRFQInstruction *psInstr = psProg->pasInstr + iInstr;
+    int i;
+
+    switch( psInstr->nOperation )
+    {
+      case SWQ_AND:
+        return OGRFQEvaluate( psProg, iInstr + 1, poFeature )
+            && OGRFQEvaluate( psProg, psProg->pasInstr[iInstr+1].nNext,
+                              poFeature );
+
+      case SWQ_OR:
+        return OGRFQEvaluate( psProg, iInstr + 1, poFeature )
+            || OGRFQEvaluate( psProg, psProg->pasInstr[iInstr+1].nNext,
+                              poFeature );
+
+      case SWQ_NOT:
+        return !OGRFQEvaluate( psProg, iInstr + 1, poFeature );
+
+      case OGRFQ_TREE:
+      {
+          swq_expr_node *poResult =
+              psInstr->poNode->Evaluate( OGRFeatureFetcher,
+                                         (void *) poFeature );
+          if( poResult == NULL )
+              return FALSE;
+
+          int bResult = poResult->int_value;
+          delete poResult;
+          return bResult;
+      }
+
+      case SWQ_ISNULL:
+        return !poFeature->IsFieldSet( psInstr->iField );
+
+      default:
+        break;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Comparisons.  A null column never matches.                      */
+/* -------------------------------------------------------------------- */
+    if( !poFeature->IsFieldSet( psInstr->iField ) )
+        return FALSE;
+
+    const OGRFQConstant *pasConst = psProg->pasConst + psInstr->iFirstConst;
+
+    if( psInstr->eMode == OGRFQ_MODE_FLOAT )
+    {
+        double dfValue;
+
+        if( psInstr->bIntegerField )
+            dfValue = poFeature->GetFieldAsInteger( psInstr->iField );
+        else
+            dfValue = poFeature->GetFieldAsDouble( psInstr->iField );
+
+        switch( psInstr->nOperation )
+        {
+          case SWQ_EQ: return dfValue == pasConst[0].dfValue;
+          case SWQ_NE: return dfValue != pasConst[0].dfValue;
+          case SWQ_GT: return dfValue > pasConst[0].dfValue;
+          case SWQ_LT: return dfValue < pasConst[0].dfValue;
+          case SWQ_GE: return dfValue >= pasConst[0].dfValue;
+          case SWQ_LE: return dfValue <= pasConst[0].dfValue;
+          case SWQ_BETWEEN:
+            return dfValue >= pasConst[0].dfValue
+                && dfValue <= pasConst[1].dfValue;
+          case SWQ_IN:
+            for( i = 0; i < psInstr->nConstCount; i++ )
+            {
+                if( dfValue == pasConst[i].dfValue )
+                    return TRUE;
+            }
+            return FALSE;
+          default:
+            return FALSE;
+        }
+    }
+    else if( psInstr->eMode == OGRFQ_MODE_INTEGER )
+    {
+        int nValue = poFeature->GetFieldAsInteger( psInstr->iField );
+
+        switch( psInstr->nOperation )
+        {
+          case SWQ_EQ: return nValue == pasConst[0].nValue;
+          case SWQ_NE: return nValue != pasConst[0].nValue;
+          case SWQ_GT: return nValue > pasConst[0].nValue;
+          case SWQ_LT: return nValue < pasConst[0].nValue;
+          case SWQ_GE: return nValue >= pasConst[0].nValue;
+          case SWQ_LE: return nValue <= pasConst[0].nValue;
+          case SWQ_BETWEEN:
+            return nValue >= pasConst[0].nValue
+                && nValue <= pasConst[1].nValue;
+          case SWQ_IN:
+            for( i = 0; i < psInstr->nConstCount; i++ )
+            {
+                if( nValue == pasConst[i].nValue )
+                    return TRUE;
+            }
+            return FALSE;
+          default:
+            return FALSE;
+        }
+    }
+    else
+    {
+        const char *pszValue = poFeature->GetFieldAsString( psInstr->iField );
+
+        switch( psInstr->nOperation )
+        {
+          case SWQ_EQ: return strcasecmp(pszValue, pasConst[0].pszValue) == 0;
+          case SWQ_NE: return strcasecmp(pszValue, pasConst[0].pszValue) != 0;
+          case SWQ_GT: return strcasecmp(pszValue, pasConst[0].pszValue) > 0;
+          case SWQ_LT: return strcasecmp(pszValue, pasConst[0].pszValue) < 0;
+          case SWQ_GE: return strcasecmp(pszValue, pasConst[0].pszValue) >= 0;
+          case SWQ_LE: return strcasecmp(pszValue, pasConst[0].pszValue) <= 0;
+          case SWQ_BETWEEN:
+            return strcasecmp(pszValue, pasConst[0].pszValue) >= 0
+                && strcasecmp(pszValue, pasConst[1].pszValue) <= 0;
+          case SWQ_IN:
+            for( i = 0; i < psInstr->nConstCount; i++ )
+            {
+                if( strcasecmp(pszValue, pasConst[i].pszValue) == 0 )
+                    return TRUE;
+            }
+            return FALSE;
+          case SWQ_LIKE:
+            return swq_test_like( pszValue, pasConst[0].pszValue,
+                                  psInstr->chEscape );
+          default:
+            return FALSE;
+        }
+    }
+}
+
 /************************************************************************/
 /*                          OGRFeatureQuery()                           */
 /************************************************************************/
@@ -54,6 +513,7 @@ OGRFeatureQuery::OGRFeatureQuery()
 {
     poTargetDefn = NULL;
     pSWQExpr = NULL;
+    pCompiledExpr = NULL;
 }
 
 /************************************************************************/
@@ -63,6 +523,7 @@ OGRFeatureQuery::OGRFeatureQuery()
 OGRFeatureQuery::~OGRFeatureQuery()
 
 {
+    OGRFQFreeProgram( (OGRFQProgram *) pCompiledExpr );
     delete (swq_expr_node *) pSWQExpr;
 }
 
@@ -77,6 +538,9 @@ OGRErr OGRFeatureQuery::Compile( OGRFeatureDefn *poDefn,
 /* -------------------------------------------------------------------- */
 /*      Clear any existing expression.                                  */
 /* -------------------------------------------------------------------- */
+    OGRFQFreeProgram( (OGRFQProgram *) pCompiledExpr );
+    pCompiledExpr = NULL;
+
     if( pSWQExpr != NULL )
     {
         delete (swq_expr_node *) pSWQExpr;
@@ -161,6 +625,8 @@ OGRErr OGRFeatureQuery::Compile( OGRFeatureDefn *poDefn,
         eErr = OGRERR_CORRUPT_DATA;
         pSWQExpr = NULL;
     }
+    else
+        pCompiledExpr = OGRFQCompileExpr( (swq_expr_node *) pSWQExpr );
 
     CPLFree( papszFieldNames );
     CPLFree( paeFieldTypes );
@@ -220,6 +686,9 @@ int OGRFeatureQuery::Evaluate( OGRFeature *poFeature )
     if( pSWQExpr == NULL )
         return FALSE;
 
+    if( pCompiledExpr != NULL )
+        return OGRFQEvaluate( (OGRFQProgram *) pCompiledExpr, 0, poFeature );
+
     swq_expr_node *poResult;
 
     poResult = ((swq_expr_node *) pSWQExpr)->Evaluate( OGRFeatureFetcher,
@@ -300,17 +769,21 @@ int OGRFeatureQuery::CanUseIndex( swq_expr_node *psExpr,
 /*      Attempt to return a list of FIDs matching the given             */
 /*      attribute query conditions utilizing attribute indices.         */
 /*      Returns NULL if the result cannot be computed from the          */
-/*      available indices, or an "OGRNullFID" terminated list of        */
-/*      FIDs if it can.                                                 */
+/*      available indices, or an "OGRNullFID" terminated sorted list    */
+/*      of FIDs if it can.                                              */
 /*                                                                      */
-/*      For now we only support equality tests on a single indexed      */
-/*      attribute field.  Eventually we should make this support        */
-/*      multi-part queries with ranges.                                 */
+/*      Equality, IN, range comparisons and BETWEEN on indexed fields   */
+/*      are supported, as well as AND and OR combinations of them.      */
+/*      The list may contain FIDs of features that do not match (for    */
+/*      instance when only one side of an AND can use an index), so     */
+/*      callers must still evaluate the query on the features.          */
 /************************************************************************/
 
 static int CompareLong(const void *a, const void *b)
 {
-	return (*(const long *)a) - (*(const long *)b);
+    long nA = *(const long *)a;
+    long nB = *(const long *)b;
+    return (nA < nB) ? -1 : (nA > nB) ? 1 : 0;
 }
 
 long *OGRFeatureQuery::EvaluateAgainstIndices( OGRLayer *poLayer, 
@@ -455,6 +928,78 @@ long* OGRANDLongArray(long panFIDList1[], int nFIDCount1,
     return panFIDList;
 }
 
+/************************************************************************/
+/*                        OGRFeatureQueryGetKey()                       */
+/*                                                                      */
+/*      Fill an index key for the given field from a constant node.     */
+/*      When the key is a bound of a range on an integer field, float   */
+/*      constants are rounded outwards (down for the lower bound, up    */
+/*      for the upper bound), so that no matching feature is missed.    */
+/************************************************************************/
+
+typedef enum
+{
+    OGR_KEY_EXACT,
+    OGR_KEY_LOWER_BOUND,
+    OGR_KEY_UPPER_BOUND
+} OGRKeyUsage;
+
+static int OGRFeatureQueryGetKey( OGRFieldDefn *poFieldDefn,
+                                  swq_expr_node *poValue,
+                                  OGRKeyUsage eUsage,
+                                  OGRField *psKey )
+{
+    if( poValue->eNodeType != SNT_CONSTANT || poValue->is_null )
+        return FALSE;
+
+    switch( poFieldDefn->GetType() )
+    {
+      case OFTInteger:
+        if (poValue->field_type == SWQ_FLOAT)
+        {
+            double dfValue = poValue->float_value;
+            if( eUsage == OGR_KEY_LOWER_BOUND )
+                dfValue = floor(dfValue);
+            else if( eUsage == OGR_KEY_UPPER_BOUND )
+                dfValue = ceil(dfValue);
+            if( CPLIsNan(dfValue) )
+                return FALSE;
+            if( dfValue < INT_MIN )
+                dfValue = INT_MIN;
+            else if( dfValue > INT_MAX )
+                dfValue = INT_MAX;
+            psKey->Integer = (int) dfValue;
+        }
+        else if (poValue->field_type == SWQ_INTEGER)
+            psKey->Integer = poValue->int_value;
+        else if (eUsage == OGR_KEY_EXACT)
+            psKey->Integer = poValue->int_value;
+        else
+            return FALSE;
+        break;
+
+      case OFTReal:
+        if (poValue->field_type == SWQ_INTEGER && eUsage != OGR_KEY_EXACT)
+            psKey->Real = poValue->int_value;
+        else if (poValue->field_type == SWQ_FLOAT || eUsage == OGR_KEY_EXACT)
+            psKey->Real = poValue->float_value;
+        else
+            return FALSE;
+        break;
+
+      case OFTString:
+        if (eUsage != OGR_KEY_EXACT)
+            return FALSE;
+        psKey->String = poValue->string_value;
+        break;
+
+      default:
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
                                                OGRLayer *poLayer,
                                                int& nFIDCount )
@@ -473,7 +1018,7 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
     {
         int nFIDCount1 = 0, nFIDCount2 = 0;
         long* panFIDList1 = EvaluateAgainstIndices( psExpr->papoSubExpr[0], poLayer, nFIDCount1 );
-        long* panFIDList2 = panFIDList1 == NULL ? NULL :
+        long* panFIDList2 = (panFIDList1 == NULL && psExpr->nOperation == SWQ_OR) ? NULL :
                             EvaluateAgainstIndices( psExpr->papoSubExpr[1], poLayer, nFIDCount2 );
         long* panFIDList = NULL;
         if (panFIDList1 != NULL && panFIDList2 != NULL)
@@ -486,22 +1031,68 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
                                             panFIDList2, nFIDCount2, nFIDCount);
 
         }
+        else if (psExpr->nOperation == SWQ_AND)
+        {
+            /* Only one side can use an index : the features matching */
+            /* it are candidates for the whole expression */
+            if (panFIDList1 != NULL)
+            {
+                nFIDCount = nFIDCount1;
+                return panFIDList1;
+            }
+            if (panFIDList2 != NULL)
+            {
+                nFIDCount = nFIDCount2;
+                return panFIDList2;
+            }
+        }
         CPLFree(panFIDList1);
         CPLFree(panFIDList2);
         return panFIDList;
     }
 
-    if( !(psExpr->nOperation == SWQ_EQ || psExpr->nOperation == SWQ_IN)
+    int nOperation = psExpr->nOperation;
+
+    if( !(nOperation == SWQ_EQ || nOperation == SWQ_IN ||
+          nOperation == SWQ_LT || nOperation == SWQ_LE ||
+          nOperation == SWQ_GT || nOperation == SWQ_GE ||
+          nOperation == SWQ_BETWEEN)
         || psExpr->nSubExprCount < 2 )
         return NULL;
 
     swq_expr_node *poColumn = psExpr->papoSubExpr[0];
     swq_expr_node *poValue = psExpr->papoSubExpr[1];
-    
+
+/* -------------------------------------------------------------------- */
+/*      Accept "constant op column" for the binary comparisons.         */
+/* -------------------------------------------------------------------- */
+    if( nOperation != SWQ_IN && nOperation != SWQ_BETWEEN &&
+        poColumn->eNodeType == SNT_CONSTANT &&
+        poValue->eNodeType == SNT_COLUMN )
+    {
+        swq_expr_node *poTmp = poColumn;
+        poColumn = poValue;
+        poValue = poTmp;
+
+        if( nOperation == SWQ_LT )
+            nOperation = SWQ_GT;
+        else if( nOperation == SWQ_LE )
+            nOperation = SWQ_GE;
+        else if( nOperation == SWQ_GT )
+            nOperation = SWQ_LT;
+        else if( nOperation == SWQ_GE )
+            nOperation = SWQ_LE;
+    }
+
     if( poColumn->eNodeType != SNT_COLUMN
         || poValue->eNodeType != SNT_CONSTANT )
         return NULL;
 
+    if( nOperation == SWQ_BETWEEN &&
+        (psExpr->nSubExprCount != 3 ||
+         psExpr->papoSubExpr[2]->eNodeType != SNT_CONSTANT) )
+        return NULL;
+
     poIndex = poLayer->GetIndex()->GetFieldIndex( poColumn->field_index );
     if( poIndex == NULL )
         return NULL;
@@ -517,7 +1108,7 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
 /* -------------------------------------------------------------------- */
 /*      Handle the case of an IN operation.                             */
 /* -------------------------------------------------------------------- */
-    if (psExpr->nOperation == SWQ_IN)
+    if (nOperation == SWQ_IN)
     {
         int nLength;
         long *panFIDs = NULL;
@@ -525,25 +1116,10 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
 
         for( iIN = 1; iIN < psExpr->nSubExprCount; iIN++ )
         {
-            switch( poFieldDefn->GetType() )
+            if( !OGRFeatureQueryGetKey( poFieldDefn, psExpr->papoSubExpr[iIN],
+                                        OGR_KEY_EXACT, &sValue ) )
             {
-              case OFTInteger:
-                if (psExpr->papoSubExpr[iIN]->field_type == SWQ_FLOAT)
-                    sValue.Integer = (int) psExpr->papoSubExpr[iIN]->float_value;
-                else
-                    sValue.Integer = psExpr->papoSubExpr[iIN]->int_value;
-                break;
-
-              case OFTReal:
-                sValue.Real = psExpr->papoSubExpr[iIN]->float_value;
-                break;
-
-              case OFTString:
-                sValue.String = psExpr->papoSubExpr[iIN]->string_value;
-                break;
-
-              default:
-                CPLAssert( FALSE );
+                CPLFree( panFIDs );
                 return NULL;
             }
 
@@ -559,30 +1135,53 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
     }
 
 /* -------------------------------------------------------------------- */
-/*      Handle equality test.                                           */
+/*      Handle range tests.                                             */
 /* -------------------------------------------------------------------- */
-    switch( poFieldDefn->GetType() )
+    if (nOperation != SWQ_EQ)
     {
-      case OFTInteger:
-        if (poValue->field_type == SWQ_FLOAT)
-            sValue.Integer = (int) poValue->float_value;
-        else
-            sValue.Integer = poValue->int_value;
-        break;
-        
-      case OFTReal:
-        sValue.Real = poValue->float_value;
-        break;
-        
-      case OFTString:
-        sValue.String = poValue->string_value;
-        break;
+        OGRField sMinValue, sMaxValue;
+        OGRField *psMinValue = NULL, *psMaxValue = NULL;
 
-      default:
-        CPLAssert( FALSE );
-        return NULL;
+        if( nOperation == SWQ_GT || nOperation == SWQ_GE ||
+            nOperation == SWQ_BETWEEN )
+        {
+            if( !OGRFeatureQueryGetKey( poFieldDefn, poValue,
+                                        OGR_KEY_LOWER_BOUND, &sMinValue ) )
+                return NULL;
+            psMinValue = &sMinValue;
+        }
+
+        if( nOperation == SWQ_LT || nOperation == SWQ_LE ||
+            nOperation == SWQ_BETWEEN )
+        {
+            if( !OGRFeatureQueryGetKey( poFieldDefn,
+                                        nOperation == SWQ_BETWEEN ?
+                                            psExpr->papoSubExpr[2] : poValue,
+                                        OGR_KEY_UPPER_BOUND, &sMaxValue ) )
+                return NULL;
+            psMaxValue = &sMaxValue;
+        }
+
+        /* The bounds are inclusive : features equal to the bound of a */
+        /* strict comparison are filtered out by the query evaluation */
+        int nLength = 0;
+        nFIDCount = 0;
+        long *panFIDs = poIndex->GetRangeMatches( psMinValue, psMaxValue,
+                                                  NULL, &nFIDCount, &nLength );
+        if (panFIDs != NULL && nFIDCount > 1)
+        {
+            /* the returned FIDs are expected to be in sorted order */
+            qsort(panFIDs, nFIDCount, sizeof(long), CompareLong);
+        }
+        return panFIDs;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Handle equality test.                                           */
+/* -------------------------------------------------------------------- */
+    if( !OGRFeatureQueryGetKey( poFieldDefn, poValue, OGR_KEY_EXACT, &sValue ) )
+        return NULL;
+
     int nLength = 0;
     long *panFIDs = poIndex->GetAllMatches( &sValue, NULL, &nFIDCount, &nLength );
     if (nFIDCount > 1)
@@ -32,6 +32,7 @@
 #include "ogr_api.h"
 #include "ogr_p.h"
 #include "ogr_geos.h"
+#include "cpl_quad_tree.h"
 
 CPL_CVSID("$Id$");
 
@@ -989,6 +990,28 @@ static int OGRGeometryFactoryCompareByIndex(const void* p1, const void* p2)
         return 0;
 }
 
+static int OGRGeometryFactoryCompareIntDesc(const void* p1, const void* p2)
+{
+    int n1 = *(const int*) p1;
+    int n2 = *(const int*) p2;
+    if (n1 > n2)
+        return -1;
+    else if (n1 < n2)
+        return 1;
+    else
+        return 0;
+}
+
+static void OGRGeometryFactoryGetPolyBounds(const void* hFeature,
+                                            CPLRectObj* pBounds)
+{
+    const sPolyExtended* psPoly = (const sPolyExtended*) hFeature;
+    pBounds->minx = psPoly->sEnvelope.MinX;
+    pBounds->miny = psPoly->sEnvelope.MinY;
+    pBounds->maxx = psPoly->sEnvelope.MaxX;
+    pBounds->maxy = psPoly->sEnvelope.MaxY;
+}
+
 #define N_CRITICAL_PART_NUMBER   100
 
 typedef enum
@@ -1215,7 +1238,11 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
        4) For each non toplevel polygon (= inner ring), add it to its outer ring
        5) Add the toplevel polygons to the multipolygon
 
-       Complexity : O(nPolygonCount^2)
+       Complexity : O(nPolygonCount^2) in the worst case. When there are
+       more than N_CRITICAL_PART_NUMBER polygons, the candidates of step 2
+       are fetched from a quad tree of the envelopes, so that only the
+       polygons whose envelope intersects the one of polygon i are
+       considered, in the same order as the exhaustive search.
     */
 
     /* Compute how each polygon relate to the other ones
@@ -1241,6 +1268,37 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
     }
     papoPolygons = NULL; /* just to use to avoid it afterwards */
 
+/* -------------------------------------------------------------------- */
+/*      Index the envelopes if there are many polygons.  Polygons whose */
+/*      envelope does not intersect the envelope of polygon i can       */
+/*      neither contain nor overlap it, so they can be skipped.         */
+/* -------------------------------------------------------------------- */
+    CPLQuadTree* hQuadTree = NULL;
+    int* panCandidates = NULL;
+
+    if (!bMixedUpGeometries && nPolygonCount > N_CRITICAL_PART_NUMBER)
+    {
+        OGREnvelope sGlobalEnvelope;
+        CPLRectObj sGlobalBounds;
+
+        for(i=0; i<nPolygonCount; i++)
+            sGlobalEnvelope.Merge(asPolyEx[i].sEnvelope);
+
+        sGlobalBounds.minx = sGlobalEnvelope.MinX;
+        sGlobalBounds.miny = sGlobalEnvelope.MinY;
+        sGlobalBounds.maxx = sGlobalEnvelope.MaxX;
+        sGlobalBounds.maxy = sGlobalEnvelope.MaxY;
+
+        hQuadTree = CPLQuadTreeCreate(&sGlobalBounds,
+                                      OGRGeometryFactoryGetPolyBounds);
+        CPLQuadTreeSetMaxDepth(hQuadTree,
+                               CPLQuadTreeGetAdvisedMaxDepth(nPolygonCount));
+        for(i=0; i<nPolygonCount; i++)
+            CPLQuadTreeInsert(hQuadTree, asPolyEx + i);
+
+        panCandidates = (int*) CPLMalloc(sizeof(int) * nPolygonCount);
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Compute relationships, if things seem well structured.          */
 /* -------------------------------------------------------------------- */
@@ -1262,10 +1320,39 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
             continue;
         }
 
-        for(j=i-1; go_on && j>=0;j--)
+        /* Without index, the candidates are all the polygons before i, */
+        /* the closest first */
+        int nCandidates = i;
+        int iCandidate;
+
+        if (hQuadTree != NULL)
+        {
+            CPLRectObj sAoi;
+            int nFound = 0;
+
+            OGRGeometryFactoryGetPolyBounds(asPolyEx + i, &sAoi);
+            sPolyExtended** papsFound = (sPolyExtended**)
+                CPLQuadTreeSearch(hQuadTree, &sAoi, &nFound);
+
+            nCandidates = 0;
+            for(iCandidate=0; iCandidate<nFound; iCandidate++)
+            {
+                int iFound = (int)(papsFound[iCandidate] - asPolyEx);
+                if (iFound < i)
+                    panCandidates[nCandidates++] = iFound;
+            }
+            CPLFree(papsFound);
+
+            qsort(panCandidates, nCandidates, sizeof(int),
+                  OGRGeometryFactoryCompareIntDesc);
+        }
+
+        for(iCandidate=0; go_on && iCandidate<nCandidates; iCandidate++)
         {
             int b_i_inside_j = FALSE;
 
+            j = (hQuadTree != NULL) ? panCandidates[iCandidate] : i - 1 - iCandidate;
+
             if (method == METHOD_ONLY_CCW && asPolyEx[j].bIsCW == FALSE)
             {
                 /* In that mode, i which is CCW if we reach here can only be */
@@ -1363,7 +1450,7 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
             }
         }
 
-        if (j < 0)
+        if (iCandidate == nCandidates)
         {
             /* We come here because we are not included in anything */
             /* We are toplevel */
@@ -1373,6 +1460,10 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
         }
     }
 
+    if (hQuadTree != NULL)
+        CPLQuadTreeDestroy(hQuadTree);
+    CPLFree(panCandidates);
+
     if (pbIsValidGeometry)
         *pbIsValidGeometry = go_on && !bMixedUpGeometries;
 
@@ -45,6 +45,7 @@ OGRLineString::OGRLineString()
 
 {
     nPointCount = 0;
+    nPointCapacity = 0;
     paoPoints = NULL;
     padfZ = NULL;
 }
@@ -184,10 +185,10 @@ void OGRLineString::Make3D()
 {
     if( padfZ == NULL )
     {
-        if( nPointCount == 0 )
+        if( nPointCapacity == 0 )
             padfZ = (double *) OGRCalloc(sizeof(double),1);
         else
-            padfZ = (double *) OGRCalloc(sizeof(double),nPointCount);
+            padfZ = (double *) OGRCalloc(sizeof(double),nPointCapacity);
     }
     nCoordDimension = 3;
 }
@@ -281,6 +282,69 @@ double OGRLineString::getZ( int iVertex ) const
         return 0.0;
 }
 
+/************************************************************************/
+/*                           reservePoints()                            */
+/************************************************************************/
+
+/**
+ * \brief Reserve room for a number of points.
+ *
+ * Makes sure that the point array (and the Z array for 3D geometries) can
+ * hold at least nNewCapacity points without being reallocated. The number
+ * of points of the geometry is not changed, so this can be used before a
+ * sequence of addPoint() calls when the final number of points is known or
+ * can be estimated. The capacity is never decreased by this method.
+ *
+ * This method has no SFCOM analog.
+ *
+ * @param nNewCapacity the number of points to reserve room for.
+ *
+ * @return OGRERR_NONE on success, or OGRERR_NOT_ENOUGH_MEMORY.
+ *
+ * @since GDAL 1.11
+ */
+
+OGRErr OGRLineString::reservePoints( int nNewCapacity )
+
+{
+    if( nNewCapacity <= nPointCapacity )
+        return OGRERR_NONE;
+
+    if( (size_t)nNewCapacity > ((size_t)-1) / sizeof(OGRRawPoint) )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Could not allocate array for %d points", nNewCapacity);
+        return OGRERR_NOT_ENOUGH_MEMORY;
+    }
+
+    OGRRawPoint* paoNewPoints = (OGRRawPoint *)
+        VSIRealloc(paoPoints, sizeof(OGRRawPoint) * nNewCapacity);
+    if (paoNewPoints == NULL)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Could not allocate array for %d points", nNewCapacity);
+        return OGRERR_NOT_ENOUGH_MEMORY;
+    }
+    paoPoints = paoNewPoints;
+
+    if( padfZ != NULL )
+    {
+        double* padfNewZ = (double *)
+            VSIRealloc( padfZ, sizeof(double) * nNewCapacity );
+        if (padfNewZ == NULL)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Could not allocate array for %d points", nNewCapacity);
+            return OGRERR_NOT_ENOUGH_MEMORY;
+        }
+        padfZ = padfNewZ;
+    }
+
+    nPointCapacity = nNewCapacity;
+
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                            setNumPoints()                            */
 /************************************************************************/
@@ -292,12 +356,19 @@ double OGRLineString::getZ( int iVertex ) const
  * geometry before setPoint() is used to assign them to avoid reallocating
  * the array larger with each call to addPoint(). 
  *
+ * When the point array must grow beyond its current capacity, the capacity
+ * is at least doubled, so that growing a line string one point at a time
+ * (as addPoint() does) only reallocates a logarithmic number of times.
+ *
  * This method has no SFCOM analog.
  *
  * @param nNewPointCount the new number of points for geometry.
+ * @param bZeroizeNewContent whether the added points should be set to zero
+ * (the default). May be set to FALSE (GDAL >= 1.11) when the caller
+ * assigns all the new points itself right after.
  */
 
-void OGRLineString::setNumPoints( int nNewPointCount )
+void OGRLineString::setNumPoints( int nNewPointCount, int bZeroizeNewContent )
 
 {
     if( nNewPointCount == 0 )
@@ -309,38 +380,38 @@ void OGRLineString::setNumPoints( int nNewPointCount )
         padfZ = NULL;
         
         nPointCount = 0;
+        nPointCapacity = 0;
         return;
     }
 
-    if( nNewPointCount > nPointCount )
+    if( nNewPointCount > nPointCapacity )
     {
-        OGRRawPoint* paoNewPoints = (OGRRawPoint *)
-            VSIRealloc(paoPoints, sizeof(OGRRawPoint) * nNewPointCount);
-        if (paoNewPoints == NULL)
-        {
-            CPLError(CE_Failure, CPLE_OutOfMemory,
-                     "Could not allocate array for %d points", nNewPointCount);
+        int nNewCapacity = nNewPointCount;
+        if( nPointCapacity > 0 && nPointCapacity < INT_MAX / 2 &&
+            nPointCapacity * 2 > nNewCapacity )
+            nNewCapacity = nPointCapacity * 2;
+
+        if( reservePoints( nNewCapacity ) != OGRERR_NONE &&
+            (nNewCapacity == nNewPointCount ||
+             reservePoints( nNewPointCount ) != OGRERR_NONE) )
             return;
-        }
-        paoPoints = paoNewPoints;
-        
+    }
+
+    if( getCoordinateDimension() == 3 && padfZ == NULL )
+    {
+        Make3D();
+        if( padfZ == NULL )
+            return;
+    }
+
+    if( nNewPointCount > nPointCount && bZeroizeNewContent )
+    {
         memset( paoPoints + nPointCount,
                 0, sizeof(OGRRawPoint) * (nNewPointCount - nPointCount) );
         
         if( getCoordinateDimension() == 3 )
-        {
-            double* padfNewZ = (double *)
-                VSIRealloc( padfZ, sizeof(double)*nNewPointCount );
-            if (padfNewZ == NULL)
-            {
-                CPLError(CE_Failure, CPLE_OutOfMemory,
-                     "Could not allocate array for %d points", nNewPointCount);
-                return;
-            }
-            padfZ = padfNewZ;
             memset( padfZ + nPointCount, 0,
                     sizeof(double) * (nNewPointCount - nPointCount) );
-        }
     }
 
     nPointCount = nNewPointCount;
@@ -507,7 +578,7 @@ void OGRLineString::setPoints( int nPointsIn, OGRRawPoint * paoPointsIn,
                                double * padfZ )
 
 {
-    setNumPoints( nPointsIn );
+    setNumPoints( nPointsIn, FALSE );
     if (nPointCount < nPointsIn)
         return;
 
@@ -563,7 +634,7 @@ void OGRLineString::setPoints( int nPointsIn, double * padfX, double * padfY,
 /* -------------------------------------------------------------------- */
 /*      Assign values.                                                  */
 /* -------------------------------------------------------------------- */
-    setNumPoints( nPointsIn );
+    setNumPoints( nPointsIn, FALSE );
     if (nPointCount < nPointsIn)
         return;
 
@@ -577,6 +648,133 @@ void OGRLineString::setPoints( int nPointsIn, double * padfX, double * padfY,
         memcpy( this->padfZ, padfZ, sizeof(double) * nPointsIn );
 }
 
+/************************************************************************/
+/*                             setPoints()                              */
+/************************************************************************/
+
+/**
+ * \brief Assign all points in a line string.
+ *
+ * This method clears any existing points assigned to this line string,
+ * and assigns a whole new set read from strided buffers, which is
+ * convenient for interleaved XY or XYZ coordinates. When the X and Y
+ * values are interleaved with the same layout as OGRRawPoint, they are
+ * copied with a single memcpy().
+ *
+ * There is no SFCOM analog to this method.
+ *
+ * @param nPointsIn number of points to assign.
+ * @param pabyX pointer to the first X value.
+ * @param nXStride stride in bytes between two consecutive X values.
+ * @param pabyY pointer to the first Y value.
+ * @param nYStride stride in bytes between two consecutive Y values.
+ * @param pabyZ pointer to the first Z value, or NULL for 2D objects.
+ * @param nZStride stride in bytes between two consecutive Z values.
+ *
+ * @since GDAL 1.11
+ */
+
+void OGRLineString::setPoints( int nPointsIn,
+                               const void* pabyX, int nXStride,
+                               const void* pabyY, int nYStride,
+                               const void* pabyZ, int nZStride )
+
+{
+    int         i;
+
+    if( pabyZ == NULL )
+        Make2D();
+    else
+        Make3D();
+
+    setNumPoints( nPointsIn, FALSE );
+    if (nPointCount < nPointsIn)
+        return;
+
+    const GByte* pabyXIter = (const GByte*) pabyX;
+    const GByte* pabyYIter = (const GByte*) pabyY;
+
+    if( nXStride == (int)sizeof(OGRRawPoint) &&
+        nYStride == (int)sizeof(OGRRawPoint) &&
+        pabyYIter == pabyXIter + sizeof(double) )
+    {
+        memcpy( paoPoints, pabyX, sizeof(OGRRawPoint) * nPointsIn );
+    }
+    else
+    {
+        for( i = 0; i < nPointsIn; i++ )
+        {
+            memcpy( &(paoPoints[i].x), pabyXIter, sizeof(double) );
+            memcpy( &(paoPoints[i].y), pabyYIter, sizeof(double) );
+            pabyXIter += nXStride;
+            pabyYIter += nYStride;
+        }
+    }
+
+    if( pabyZ != NULL )
+    {
+        const GByte* pabyZIter = (const GByte*) pabyZ;
+
+        if( nZStride == (int)sizeof(double) )
+            memcpy( padfZ, pabyZ, sizeof(double) * nPointsIn );
+        else
+        {
+            for( i = 0; i < nPointsIn; i++ )
+            {
+                memcpy( padfZ + i, pabyZIter, sizeof(double) );
+                pabyZIter += nZStride;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                         setPointsDirectly()                          */
+/************************************************************************/
+
+/**
+ * \brief Assign all points in a line string, taking ownership of the arrays.
+ *
+ * This method clears any existing points assigned to this line string,
+ * and adopts the passed arrays without copying them. They must have been
+ * allocated with CPLMalloc() or VSIMalloc() (or their realloc/calloc
+ * variants), will be freed by the line string, and must not be used
+ * by the caller afterwards.
+ *
+ * There is no SFCOM analog to this method.
+ *
+ * @param nPointsIn number of points in paoPointsIn.
+ * @param paoPointsIn array of nPointsIn points to adopt.
+ * @param padfZIn array of nPointsIn Z values to adopt, or NULL for 2D
+ * objects.
+ *
+ * @since GDAL 1.11
+ */
+
+void OGRLineString::setPointsDirectly( int nPointsIn,
+                                       OGRRawPoint * paoPointsIn,
+                                       double * padfZIn )
+
+{
+    OGRFree( paoPoints );
+    OGRFree( padfZ );
+
+    if( nPointsIn <= 0 || paoPointsIn == NULL )
+    {
+        OGRFree( paoPointsIn );
+        OGRFree( padfZIn );
+        paoPointsIn = NULL;
+        padfZIn = NULL;
+        nPointsIn = 0;
+    }
+
+    paoPoints = paoPointsIn;
+    padfZ = padfZIn;
+    nPointCount = nPointsIn;
+    nPointCapacity = nPointsIn;
+    nCoordDimension = (padfZ != NULL) ? 3 : 2;
+}
+
 /************************************************************************/
 /*                          getPoints()                                 */
 /************************************************************************/
@@ -1084,6 +1282,7 @@ OGRErr OGRLineString::importFromWkt( char ** ppszInput )
 
     pszInput = OGRWktReadPoints( pszInput, &paoPoints, &padfZ, &nMaxPoint,
                                  &nPointCount );
+    nPointCapacity = nMaxPoint;
     if( pszInput == NULL )
         return OGRERR_CORRUPT_DATA;
 
@@ -1524,18 +1723,52 @@ void OGRLineString::segmentize( double dfMaxLength )
     double dfSquareMaxLength = dfMaxLength * dfMaxLength;
     const int nCoordinateDimension = getCoordinateDimension();
 
+    if( nPointCount == 0 )
+        return;
+
+/* -------------------------------------------------------------------- */
+/*      Count the points of the result first, so that the new arrays    */
+/*      are allocated only once.                                        */
+/* -------------------------------------------------------------------- */
+    int nTotalPointCount = nPointCount;
+    for( i = 0; i < nPointCount - 1; i++ )
+    {
+        double dfX = paoPoints[i+1].x - paoPoints[i].x;
+        double dfY = paoPoints[i+1].y - paoPoints[i].y;
+        double dfSquareDist = dfX * dfX + dfY * dfY;
+        if (dfSquareDist > dfSquareMaxLength)
+        {
+            double dfIntermediatePoints = floor(sqrt(dfSquareDist / dfSquareMaxLength));
+            if( dfIntermediatePoints > INT_MAX - 1 - nTotalPointCount )
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Too many points after segmentization");
+                return;
+            }
+            nTotalPointCount += (int)dfIntermediatePoints;
+        }
+    }
+
+    paoNewPoints = (OGRRawPoint *)
+        VSIMalloc2(sizeof(OGRRawPoint), nTotalPointCount);
+    if( nCoordinateDimension == 3 )
+        padfNewZ = (double *) VSIMalloc2(sizeof(double), nTotalPointCount);
+    if( paoNewPoints == NULL ||
+        (nCoordinateDimension == 3 && padfNewZ == NULL) )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Could not allocate array for %d points", nTotalPointCount);
+        VSIFree(paoNewPoints);
+        VSIFree(padfNewZ);
+        return;
+    }
+
     for( i = 0; i < nPointCount; i++ )
     {
-        paoNewPoints = (OGRRawPoint *)
-            OGRRealloc(paoNewPoints, sizeof(OGRRawPoint) * (nNewPointCount + 1));
         paoNewPoints[nNewPointCount] = paoPoints[i];
 
         if( nCoordinateDimension == 3 )
-        {
-            padfNewZ = (double *)
-                OGRRealloc(padfNewZ, sizeof(double) * (nNewPointCount + 1));
             padfNewZ[nNewPointCount] = padfZ[i];
-        }
 
         nNewPointCount++;
 
@@ -1550,14 +1783,6 @@ void OGRLineString::segmentize( double dfMaxLength )
             int nIntermediatePoints = (int)floor(sqrt(dfSquareDist / dfSquareMaxLength));
             int j;
 
-            paoNewPoints = (OGRRawPoint *)
-                OGRRealloc(paoNewPoints, sizeof(OGRRawPoint) * (nNewPointCount + nIntermediatePoints));
-            if( nCoordinateDimension == 3 )
-            {
-                padfNewZ = (double *)
-                    OGRRealloc(padfNewZ, sizeof(double) * (nNewPointCount + nIntermediatePoints));
-            }
-
             for(j=1;j<=nIntermediatePoints;j++)
             {
                 paoNewPoints[nNewPointCount + j - 1].x = paoPoints[i].x + j * dfX / (nIntermediatePoints + 1);
@@ -1573,15 +1798,9 @@ void OGRLineString::segmentize( double dfMaxLength )
         }
     }
 
-    OGRFree(paoPoints);
-    paoPoints = paoNewPoints;
-    nPointCount = nNewPointCount;
+    CPLAssert( nNewPointCount == nTotalPointCount );
 
-    if( nCoordinateDimension == 3 )
-    {
-        OGRFree(padfZ);
-        padfZ = padfNewZ;
-    }
+    setPointsDirectly( nNewPointCount, paoNewPoints, padfNewZ );
 }
 
 /************************************************************************/
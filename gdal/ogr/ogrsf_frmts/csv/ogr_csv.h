@@ -59,7 +59,8 @@ class OGRCSVLayer : public OGRLayer
 
     int                 bHasFieldNames;
 
-    OGRFeature *        GetNextUnfilteredFeature();
+    OGRFeature *        GetNextUnfilteredFeature( OGRFeature *poFeatureToFill = NULL );
+    OGRFeature *        GetNextFeatureInternal( OGRFeature *poFeatureToFill );
 
     int                 bNew;
     int                 bInWriteMode;
@@ -97,6 +98,8 @@ class OGRCSVLayer : public OGRLayer
 
     void                ResetReading();
     OGRFeature *        GetNextFeature();
+    int                 GetNextFeatureInto( OGRFeature *poFeature );
+    int                 GetNextBatch( OGRFeatureBatch *poBatch );
 
     OGRFeatureDefn *    GetLayerDefn() { return poFeatureDefn; }
 
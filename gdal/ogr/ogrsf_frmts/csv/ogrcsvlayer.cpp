@@ -662,9 +662,12 @@ void OGRCSVLayer::ResetReading()
 
 /************************************************************************/
 /*                      GetNextUnfilteredFeature()                      */
+/*                                                                      */
+/*      If poFeatureToFill is not NULL, it is reset and filled rather   */
+/*      than a new feature being created.                               */
 /************************************************************************/
 
-OGRFeature * OGRCSVLayer::GetNextUnfilteredFeature()
+OGRFeature * OGRCSVLayer::GetNextUnfilteredFeature( OGRFeature *poFeatureToFill )
 
 {
     if (fpCSV == NULL)
@@ -688,11 +691,17 @@ OGRFeature * OGRCSVLayer::GetNextUnfilteredFeature()
     }
 
 /* -------------------------------------------------------------------- */
-/*      Create the OGR feature.                                         */
+/*      Create the OGR feature, or recycle the one we were given.       */
 /* -------------------------------------------------------------------- */
     OGRFeature *poFeature;
 
-    poFeature = new OGRFeature( poFeatureDefn );
+    if( poFeatureToFill != NULL )
+    {
+        poFeature = poFeatureToFill;
+        poFeature->Reset();
+    }
+    else
+        poFeature = new OGRFeature( poFeatureDefn );
 
 /* -------------------------------------------------------------------- */
 /*      Set attributes for any indicated attribute records.             */
@@ -845,8 +854,152 @@ OGRFeature * OGRCSVLayer::GetNextUnfilteredFeature()
 
 OGRFeature *OGRCSVLayer::GetNextFeature()
 
+{
+    return GetNextFeatureInternal( NULL );
+}
+
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/************************************************************************/
+
+int OGRCSVLayer::GetNextFeatureInto( OGRFeature *poFeature )
+
+{
+    if( poFeature->GetDefnRef() != poFeatureDefn )
+        return OGRLayer::GetNextFeatureInto( poFeature );
+
+    return GetNextFeatureInternal( poFeature ) != NULL;
+}
+
+/************************************************************************/
+/*                            GetNextBatch()                            */
+/*                                                                      */
+/*      When there are no filters, fill the columns directly from the   */
+/*      parsed records, without going through OGRFeature.               */
+/************************************************************************/
+
+int OGRCSVLayer::GetNextBatch( OGRFeatureBatch *poBatch )
+
+{
+    if( m_poAttrQuery != NULL || m_poFilterGeom != NULL
+        || bIsEurostatTSV || iNfdcLatitudeS != -1 || iLatitudeField != -1 )
+        return OGRLayer::GetNextBatch( poBatch );
+
+    if( bNeedRewindBeforeRead )
+        ResetReading();
+
+    poBatch->Prepare( poFeatureDefn );
+
+    int iColumn, nColumns = poBatch->GetColumnCount();
+
+    /* Other field types are formatted by OGRFeature */
+    for( iColumn = 0; iColumn < nColumns; iColumn++ )
+    {
+        OGRFieldType eType = poFeatureDefn->GetFieldDefn(
+            poBatch->GetColumnFieldIndex( iColumn ) )->GetType();
+        if( eType != OFTInteger && eType != OFTReal && eType != OFTString )
+            return OGRLayer::GetNextBatch( poBatch );
+    }
+
+    if( fpCSV == NULL )
+        return 0;
+
+    while( !poBatch->IsFull() )
+    {
+        char **papszTokens =
+            OGRCSVReadParseLineL( fpCSV, chDelimiter, bDontHonourStrings );
+        if( papszTokens == NULL )
+            break;
+
+        if( papszTokens[0] == NULL )
+        {
+            CSLDestroy( papszTokens );
+            continue;
+        }
+
+        int nAttrCount = CSLCount( papszTokens );
+
+        poBatch->BeginFeature( nNextFID++ );
+
+        for( iColumn = 0; iColumn < nColumns; iColumn++ )
+        {
+            int iAttr = poBatch->GetColumnFieldIndex( iColumn );
+            if( iAttr >= nAttrCount )
+                continue;
+
+            char *pszToken = papszTokens[iAttr];
+            OGRFieldType eType = poBatch->GetColumnType( iColumn );
+
+            if( eType == OFTString )
+            {
+                poBatch->SetString( iColumn, pszToken );
+                continue;
+            }
+
+            if( chDelimiter == ';' && eType == OFTReal )
+            {
+                char* chComma = strchr(pszToken, ',');
+                if (chComma)
+                    *chComma = '.';
+            }
+
+            CPLValueType eValueType = CPLGetValueType( pszToken );
+            if( pszToken[0] == '\0'
+                || (eValueType != CPL_VALUE_INTEGER
+                    && eValueType != CPL_VALUE_REAL) )
+                continue;
+
+            if( eType == OFTInteger )
+                poBatch->SetInteger( iColumn, atoi(pszToken) );
+            else
+                poBatch->SetDouble( iColumn, CPLAtof(pszToken) );
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Geometry of the first geometry field, from a WKT column.        */
+/* -------------------------------------------------------------------- */
+        for( int iAttr = 0; poBatch->HasGeometry() && iAttr < nAttrCount
+                 && iAttr < poFeatureDefn->GetFieldCount(); iAttr++ )
+        {
+            if( panGeomFieldIndex[iAttr] != 0 )
+                continue;
+
+            char *pszWKT = papszTokens[iAttr];
+            OGRGeometry *poGeom = NULL;
+
+            if( pszWKT[0] != '\0'
+                && OGRGeometryFactory::createFromWkt( &pszWKT, NULL, &poGeom )
+                == OGRERR_NONE )
+            {
+                poBatch->SetGeometry( poGeom );
+                delete poGeom;
+            }
+            break;
+        }
+
+        poBatch->EndFeature();
+
+        CSLDestroy( papszTokens );
+
+        m_nFeaturesRead++;
+    }
+
+    return poBatch->GetFeatureCount();
+}
+
+/************************************************************************/
+/*                       GetNextFeatureInternal()                       */
+/*                                                                      */
+/*      Features rejected by the filters are filled again with the      */
+/*      next record, rather than destroyed.  If poFeatureToFill is not  */
+/*      NULL, it is the only feature used.                              */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::GetNextFeatureInternal( OGRFeature *poFeatureToFill )
+
 {
     OGRFeature  *poFeature = NULL;
+    OGRFeature  *poRecycledFeature = poFeatureToFill;
 
     if( bNeedRewindBeforeRead )
         ResetReading();
@@ -857,9 +1010,13 @@ OGRFeature *OGRCSVLayer::GetNextFeature()
 /* -------------------------------------------------------------------- */
     while( TRUE )
     {
-        poFeature = GetNextUnfilteredFeature();
+        poFeature = GetNextUnfilteredFeature( poRecycledFeature );
         if( poFeature == NULL )
+        {
+            if( poRecycledFeature != poFeatureToFill )
+                delete poRecycledFeature;
             break;
+        }
 
         if( (m_poFilterGeom == NULL
             || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) )
@@ -867,7 +1024,7 @@ OGRFeature *OGRCSVLayer::GetNextFeature()
                 || m_poAttrQuery->Evaluate( poFeature )) )
             break;
 
-        delete poFeature;
+        poRecycledFeature = poFeature;
     }
 
     return poFeature;
@@ -82,3 +82,27 @@ OGRAttrIndex::OGRAttrIndex()
 OGRAttrIndex::~OGRAttrIndex()
 {
 }
+
+/************************************************************************/
+/*                          GetRangeMatches()                           */
+/*                                                                      */
+/*      Append to panFIDList the FIDs of the features whose key is      */
+/*      between psMinKey and psMaxKey (inclusive, NULL meaning          */
+/*      unbounded), in the same way as GetAllMatches().  Returns NULL   */
+/*      when range lookups are not supported for this index, leaving    */
+/*      panFIDList untouched, which is what the default                 */
+/*      implementation does, or on error, after freeing panFIDList.     */
+/************************************************************************/
+
+long *OGRAttrIndex::GetRangeMatches( OGRField *psMinKey, OGRField *psMaxKey,
+                                     long* panFIDList, int* nFIDCount,
+                                     int* nLength )
+{
+    (void) psMinKey;
+    (void) psMaxKey;
+    (void) panFIDList;
+    (void) nFIDCount;
+    (void) nLength;
+
+    return NULL;
+}
@@ -33,6 +33,7 @@
 #include "cpl_string.h"
 #include "ogr_api.h"
 #include <vector>
+#include <algorithm>
 
 CPL_CVSID("$Id$");
 
@@ -98,10 +99,15 @@ OGRGenSQLResultsLayer::OGRGenSQLResultsLayer( OGRDataSource *poSrcDS,
     panFIDIndex = NULL;
     bOrderByValid = FALSE;
     nIndexSize = 0;
+    papoSortedFeatures = NULL;
+    nSortRuns = 0;
+    pasSortRuns = NULL;
     nNextIndexFID = 0;
     nExtraDSCount = 0;
     papoExtraDS = NULL;
     panGeomFieldToSrcGeomField = NULL;
+    papsJoinHash = NULL;
+    psGroupBy = NULL;
 
 /* -------------------------------------------------------------------- */
 /*      Identify all the layers involved in the SELECT.                 */
@@ -454,13 +460,18 @@ OGRGenSQLResultsLayer::~OGRGenSQLResultsLayer()
 
     ClearFilters();
 
+    FreeJoinHashes();
+
+    FreeGroupBy();
+
 /* -------------------------------------------------------------------- */
 /*      Free various datastructures.                                    */
 /* -------------------------------------------------------------------- */
+    InvalidateOrderByIndex();
+
     CPLFree( papoTableLayers );
     papoTableLayers = NULL;
              
-    CPLFree( panFIDIndex );
     CPLFree( panGeomFieldToSrcGeomField );
 
     delete poSummaryFeature;
@@ -584,6 +595,9 @@ void OGRGenSQLResultsLayer::ResetReading()
         ApplyFiltersToSource();
     }
 
+    if( nSortRuns > 0 )
+        ResetSortMerge();
+
     nNextIndexFID = 0;
 }
 
@@ -603,8 +617,16 @@ OGRErr OGRGenSQLResultsLayer::SetNextByIndex( long nIndex )
 
     if( psSelectInfo->query_mode == SWQM_SUMMARY_RECORD 
         || psSelectInfo->query_mode == SWQM_DISTINCT_LIST 
-        || panFIDIndex != NULL )
+        || psSelectInfo->query_mode == SWQM_GROUP_BY 
+        || panFIDIndex != NULL
+        || papoSortedFeatures != NULL )
+    {
+        nNextIndexFID = nIndex;
+        return OGRERR_NONE;
+    }
+    else if( nSortRuns > 0 )
     {
+        SeekSortMerge( nIndex );
         nNextIndexFID = nIndex;
         return OGRERR_NONE;
     }
@@ -673,6 +695,8 @@ int OGRGenSQLResultsLayer::GetFeatureCount( int bForce )
 
         return psSummary->count;
     }
+    else if( psSelectInfo->query_mode == SWQM_GROUP_BY )
+        return (int) GetGroupCount();
     else if( psSelectInfo->query_mode != SWQM_RECORDSET )
         return 1;
     else if( m_poAttrQuery == NULL && !MustEvaluateSpatialFilterOnGenSQL() )
@@ -694,7 +718,9 @@ int OGRGenSQLResultsLayer::TestCapability( const char *pszCap )
     {
         if( psSelectInfo->query_mode == SWQM_SUMMARY_RECORD 
             || psSelectInfo->query_mode == SWQM_DISTINCT_LIST 
-            || panFIDIndex != NULL )
+            || psSelectInfo->query_mode == SWQM_GROUP_BY 
+            || panFIDIndex != NULL
+            || papoSortedFeatures != NULL )
             return TRUE;
         else 
             return poSrcLayer->TestCapability( pszCap );
@@ -807,10 +833,35 @@ int OGRGenSQLResultsLayer::PrepareSummary()
                 break;
             }
         }
+        for( int iGroup = 0; iGroup < psSelectInfo->group_by_count; iGroup++ )
+        {
+            int nSpecialFieldIdx = psSelectInfo->group_by_defs[iGroup].field_index -
+                            poSrcLayer->GetLayerDefn()->GetFieldCount();
+            if (nSpecialFieldIdx == SPF_OGR_GEOMETRY ||
+                nSpecialFieldIdx == SPF_OGR_GEOM_WKT ||
+                nSpecialFieldIdx == SPF_OGR_GEOM_AREA)
+                bFoundGeomExpr = TRUE;
+        }
         if (!bFoundGeomExpr)
             poSrcLayer->GetLayerDefn()->SetGeometryIgnored(TRUE);
     }
 
+/* -------------------------------------------------------------------- */
+/*      GROUP BY queries are aggregated in a hash set of groups.        */
+/* -------------------------------------------------------------------- */
+    if( psSelectInfo->query_mode == SWQM_GROUP_BY )
+    {
+        int bRet = PrepareGroupBy();
+
+        poSrcLayer->GetLayerDefn()->SetGeometryIgnored(bSaveIsGeomIgnored);
+        if( !bRet )
+        {
+            delete poSummaryFeature;
+            poSummaryFeature = NULL;
+        }
+        return bRet;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      We treat COUNT(*) as a special case, and fill with              */
 /*      GetFeatureCount().                                              */
@@ -1026,6 +1077,388 @@ static swq_expr_node *OGRMultiFeatureFetcher( swq_expr_node *op,
     return poRetNode;
 }
 
+/************************************************************************/
+/*                          OGRGenSQLJoinHash                           */
+/*                                                                      */
+/*      In-memory hash of the join key of a secondary layer, built      */
+/*      by a single scan of that layer, and probed for each primary     */
+/*      feature.  This avoids installing an attribute filter and        */
+/*      rescanning the secondary layer for each primary feature.        */
+/************************************************************************/
+
+typedef struct
+{
+    double      dfKey;
+    const char *pszKey;
+    OGRFeature *poFeature;
+    long        nFID;
+} OGRGenSQLJoinHashEntry;
+
+struct _OGRGenSQLJoinHash
+{
+    int         bNumericKey;
+    int         bFIDMode;
+    CPLHashSet *hSet;        /* NULL if the hash join cannot be used */
+};
+
+/************************************************************************/
+/*                     OGRGenSQLJoinHashNumeric()                       */
+/************************************************************************/
+
+static unsigned long OGRGenSQLJoinHashNumeric( const void *elt )
+
+{
+    double dfKey = ((const OGRGenSQLJoinHashEntry *) elt)->dfKey;
+    GUInt32 anWords[2];
+
+    if( dfKey == 0.0 ) /* -0.0 == 0.0 */
+        dfKey = 0.0;
+    memcpy( anWords, &dfKey, sizeof(double) );
+
+    return (unsigned long) (anWords[0] ^ (anWords[1] * 31));
+}
+
+/************************************************************************/
+/*                      OGRGenSQLJoinEqualNumeric()                     */
+/************************************************************************/
+
+static int OGRGenSQLJoinEqualNumeric( const void *elt1, const void *elt2 )
+
+{
+    return ((const OGRGenSQLJoinHashEntry *) elt1)->dfKey ==
+           ((const OGRGenSQLJoinHashEntry *) elt2)->dfKey;
+}
+
+/************************************************************************/
+/*                      OGRGenSQLJoinHashString()                       */
+/*                                                                      */
+/*      String keys are compared case insensitively, as the '='         */
+/*      operator of OGR SQL does.                                       */
+/************************************************************************/
+
+static unsigned long OGRGenSQLJoinHashString( const void *elt )
+
+{
+    const unsigned char* pszStr = (const unsigned char *)
+        ((const OGRGenSQLJoinHashEntry *) elt)->pszKey;
+    unsigned long hash = 0;
+    int c;
+
+    while ((c = *pszStr++) != '\0')
+        hash = tolower(c) + (hash << 6) + (hash << 16) - hash;
+
+    return hash;
+}
+
+/************************************************************************/
+/*                       OGRGenSQLJoinEqualString()                     */
+/************************************************************************/
+
+static int OGRGenSQLJoinEqualString( const void *elt1, const void *elt2 )
+
+{
+    return EQUAL( ((const OGRGenSQLJoinHashEntry *) elt1)->pszKey,
+                  ((const OGRGenSQLJoinHashEntry *) elt2)->pszKey );
+}
+
+/************************************************************************/
+/*                       OGRGenSQLJoinFreeEntry()                       */
+/************************************************************************/
+
+static void OGRGenSQLJoinFreeEntry( void *elt )
+
+{
+    OGRGenSQLJoinHashEntry *psEntry = (OGRGenSQLJoinHashEntry *) elt;
+
+    delete psEntry->poFeature;
+    CPLFree( (char *) psEntry->pszKey );
+    CPLFree( psEntry );
+}
+
+/************************************************************************/
+/*                   OGRGenSQLJoinEntrySwitchToFID()                    */
+/*                                                                      */
+/*      Replace the cached secondary feature by its FID.                */
+/************************************************************************/
+
+static int OGRGenSQLJoinEntrySwitchToFID( void *elt, void * /* user_data */ )
+
+{
+    OGRGenSQLJoinHashEntry *psEntry = (OGRGenSQLJoinHashEntry *) elt;
+
+    psEntry->nFID = psEntry->poFeature->GetFID();
+    delete psEntry->poFeature;
+    psEntry->poFeature = NULL;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                   OGRGenSQLEstimateFeatureMemory()                   */
+/************************************************************************/
+
+static GIntBig OGRGenSQLEstimateFeatureMemory( OGRFeature *poFeature )
+
+{
+    OGRFeatureDefn *poFDefn = poFeature->GetDefnRef();
+    GIntBig nSize = sizeof(OGRFeature) + sizeof(OGRGenSQLJoinHashEntry)
+        + poFDefn->GetFieldCount() * sizeof(OGRField);
+    int iField;
+
+    for( iField = 0; iField < poFDefn->GetFieldCount(); iField++ )
+    {
+        if( poFDefn->GetFieldDefn(iField)->GetType() == OFTString &&
+            poFeature->IsFieldSet(iField) )
+            nSize += strlen(poFeature->GetRawFieldRef(iField)->String) + 1;
+    }
+
+    for( iField = 0; iField < poFDefn->GetGeomFieldCount(); iField++ )
+    {
+        OGRGeometry *poGeom = poFeature->GetGeomFieldRef(iField);
+        if( poGeom != NULL )
+            nSize += poGeom->WkbSize();
+    }
+
+    return nSize;
+}
+
+/************************************************************************/
+/*                           BuildJoinHash()                            */
+/*                                                                      */
+/*      Scan the secondary layer of a join once, and index its          */
+/*      features by join key.  As with the attribute filter based       */
+/*      lookup, only the first feature matching a key is retained.      */
+/*      If the hash grows beyond OGR_SQL_JOIN_HASH_MAX_MEMORY (in MB)   */
+/*      the features are released and only their FIDs are kept, to     */
+/*      be refetched with GetFeature(), provided the layer has fast     */
+/*      random read.  Otherwise we fallback to the filter based join.   */
+/************************************************************************/
+
+OGRGenSQLJoinHash *OGRGenSQLResultsLayer::BuildJoinHash( int iJoin )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    swq_join_def *psJoinInfo = psSelectInfo->join_defs + iJoin;
+    OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
+
+    if( papsJoinHash == NULL )
+        papsJoinHash = (OGRGenSQLJoinHash **)
+            CPLCalloc( sizeof(OGRGenSQLJoinHash *), psSelectInfo->join_count );
+
+    OGRGenSQLJoinHash *psHash = (OGRGenSQLJoinHash *)
+        CPLCalloc( sizeof(OGRGenSQLJoinHash), 1 );
+    papsJoinHash[iJoin] = psHash;
+
+    if( !CSLTestBoolean(CPLGetConfigOption("OGR_SQL_JOIN_USE_HASH", "YES")) )
+        return psHash;
+
+    /* Scanning the secondary layer would disturb the reading of the */
+    /* primary one if they are the same object. */
+    if( poJoinLayer == poSrcLayer )
+        return psHash;
+
+    OGRFieldType ePrimaryFieldType = poSrcLayer->GetLayerDefn()->
+        GetFieldDefn( psJoinInfo->primary_field )->GetType();
+    OGRFieldType eSecondaryFieldType = poJoinLayer->GetLayerDefn()->
+        GetFieldDefn( psJoinInfo->secondary_field )->GetType();
+
+    if( (ePrimaryFieldType != OFTInteger && ePrimaryFieldType != OFTReal &&
+         ePrimaryFieldType != OFTString) ||
+        (eSecondaryFieldType != OFTInteger && eSecondaryFieldType != OFTReal &&
+         eSecondaryFieldType != OFTString) )
+        return psHash;
+
+    /* Mixed numeric and string keys are compared as numbers (#4259, #4321) */
+    psHash->bNumericKey = !( ePrimaryFieldType == OFTString &&
+                             eSecondaryFieldType == OFTString );
+
+    GIntBig nMaxMemory = ((GIntBig)
+        atoi(CPLGetConfigOption("OGR_SQL_JOIN_HASH_MAX_MEMORY", "100")))
+        * 1024 * 1024;
+    int bCanUseFIDs = poJoinLayer->TestCapability( OLCRandomRead );
+    GIntBig nMemory = 0;
+
+    CPLHashSet *hSet;
+    if( psHash->bNumericKey )
+        hSet = CPLHashSetNew( OGRGenSQLJoinHashNumeric,
+                              OGRGenSQLJoinEqualNumeric,
+                              OGRGenSQLJoinFreeEntry );
+    else
+        hSet = CPLHashSetNew( OGRGenSQLJoinHashString,
+                              OGRGenSQLJoinEqualString,
+                              OGRGenSQLJoinFreeEntry );
+
+    poJoinLayer->SetAttributeFilter( NULL );
+    poJoinLayer->ResetReading();
+
+    OGRFeature *poFeature;
+    int iKeyField = psJoinInfo->secondary_field;
+
+    while( (poFeature = poJoinLayer->GetNextFeature()) != NULL )
+    {
+        OGRGenSQLJoinHashEntry sEntry;
+
+        if( !poFeature->IsFieldSet( iKeyField ) )
+        {
+            delete poFeature;
+            continue;
+        }
+
+        memset( &sEntry, 0, sizeof(sEntry) );
+        if( psHash->bNumericKey )
+            sEntry.dfKey = poFeature->GetFieldAsDouble( iKeyField );
+        else
+            sEntry.pszKey = poFeature->GetFieldAsString( iKeyField );
+
+        if( CPLHashSetLookup( hSet, &sEntry ) != NULL )
+        {
+            delete poFeature;
+            continue;
+        }
+
+        if( psHash->bFIDMode && poFeature->GetFID() == OGRNullFID )
+        {
+            delete poFeature;
+            CPLHashSetDestroy( hSet );
+            hSet = NULL;
+            break;
+        }
+
+        OGRGenSQLJoinHashEntry *psEntry = (OGRGenSQLJoinHashEntry *)
+            CPLMalloc( sizeof(OGRGenSQLJoinHashEntry) );
+        *psEntry = sEntry;
+        if( !psHash->bNumericKey )
+        {
+            psEntry->pszKey = CPLStrdup( sEntry.pszKey );
+            nMemory += strlen(sEntry.pszKey) + 1;
+        }
+
+        if( psHash->bFIDMode )
+        {
+            psEntry->nFID = poFeature->GetFID();
+            nMemory += sizeof(OGRGenSQLJoinHashEntry);
+            delete poFeature;
+        }
+        else
+        {
+            psEntry->poFeature = poFeature;
+            nMemory += OGRGenSQLEstimateFeatureMemory( poFeature );
+        }
+
+        CPLHashSetInsert( hSet, psEntry );
+
+        if( nMemory > nMaxMemory && !psHash->bFIDMode && bCanUseFIDs )
+        {
+            CPLDebug( "GenSQL",
+                      "Join hash on layer %s exceeds %d MB. "
+                      "Keeping only FIDs.",
+                      poJoinLayer->GetName(),
+                      (int) (nMaxMemory / (1024 * 1024)) );
+            CPLHashSetForeach( hSet, OGRGenSQLJoinEntrySwitchToFID, NULL );
+            psHash->bFIDMode = TRUE;
+            nMemory = (GIntBig) CPLHashSetSize( hSet ) *
+                sizeof(OGRGenSQLJoinHashEntry);
+        }
+
+        if( nMemory > nMaxMemory )
+        {
+            CPLDebug( "GenSQL",
+                      "Join hash on layer %s exceeds %d MB. "
+                      "Falling back to attribute filter based join.",
+                      poJoinLayer->GetName(),
+                      (int) (nMaxMemory / (1024 * 1024)) );
+            CPLHashSetDestroy( hSet );
+            hSet = NULL;
+            break;
+        }
+    }
+
+    poJoinLayer->ResetReading();
+
+    psHash->hSet = hSet;
+
+    return psHash;
+}
+
+/************************************************************************/
+/*                      FetchJoinFeatureFromHash()                      */
+/*                                                                      */
+/*      Returns FALSE if no hash is available for this join, in         */
+/*      which case the caller must use the attribute filter lookup.     */
+/*      *pbOwned is set to TRUE if the returned feature must be         */
+/*      deleted by the caller.                                          */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::FetchJoinFeatureFromHash( int iJoin,
+                                                     OGRFeature *poSrcFeat,
+                                                     OGRFeature **ppoJoinFeature,
+                                                     int *pbOwned )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    swq_join_def *psJoinInfo = psSelectInfo->join_defs + iJoin;
+    OGRGenSQLJoinHash *psHash = NULL;
+
+    *ppoJoinFeature = NULL;
+    *pbOwned = FALSE;
+
+    if( papsJoinHash != NULL )
+        psHash = papsJoinHash[iJoin];
+    if( psHash == NULL )
+        psHash = BuildJoinHash( iJoin );
+    if( psHash->hSet == NULL )
+        return FALSE;
+
+    OGRGenSQLJoinHashEntry sEntry;
+    memset( &sEntry, 0, sizeof(sEntry) );
+    if( psHash->bNumericKey )
+        sEntry.dfKey = poSrcFeat->GetFieldAsDouble( psJoinInfo->primary_field );
+    else
+        sEntry.pszKey = poSrcFeat->GetFieldAsString( psJoinInfo->primary_field );
+
+    OGRGenSQLJoinHashEntry *psEntry = (OGRGenSQLJoinHashEntry *)
+        CPLHashSetLookup( psHash->hSet, &sEntry );
+    if( psEntry == NULL )
+        return TRUE;
+
+    if( psHash->bFIDMode )
+    {
+        OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
+        *ppoJoinFeature = poJoinLayer->GetFeature( psEntry->nFID );
+        *pbOwned = TRUE;
+    }
+    else
+        *ppoJoinFeature = psEntry->poFeature;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                           FreeJoinHashes()                           */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::FreeJoinHashes()
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+
+    if( papsJoinHash == NULL )
+        return;
+
+    for( int iJoin = 0; iJoin < psSelectInfo->join_count; iJoin++ )
+    {
+        if( papsJoinHash[iJoin] != NULL )
+        {
+            if( papsJoinHash[iJoin]->hSet != NULL )
+                CPLHashSetDestroy( papsJoinHash[iJoin]->hSet );
+            CPLFree( papsJoinHash[iJoin] );
+        }
+    }
+
+    CPLFree( papsJoinHash );
+    papsJoinHash = NULL;
+}
+
 /************************************************************************/
 /*                          TranslateFeature()                          */
 /************************************************************************/
@@ -1036,6 +1469,7 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
     swq_select *psSelectInfo = (swq_select *) pSelectInfo;
     OGRFeature *poDstFeat;
     std::vector<OGRFeature*> apoFeatures;
+    std::vector<int> abJoinFeatureOwned;
 
     if( poSrcFeat == NULL )
         return NULL;
@@ -1066,6 +1500,19 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
         if( !poSrcFeat->IsFieldSet( psJoinInfo->primary_field ) )
         {
             apoFeatures.push_back( NULL );
+            abJoinFeatureOwned.push_back( FALSE );
+            continue;
+        }
+
+        // Use the hash of the secondary layer if we could build it.
+        OGRFeature *poJoinFeature = NULL;
+        int bOwned = FALSE;
+
+        if( FetchJoinFeatureFromHash( iJoin, poSrcFeat,
+                                      &poJoinFeature, &bOwned ) )
+        {
+            apoFeatures.push_back( poJoinFeature );
+            abJoinFeatureOwned.push_back( bOwned );
             continue;
         }
         
@@ -1119,13 +1566,12 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
             continue;
         }
 
-        OGRFeature *poJoinFeature = NULL;
-
         poJoinLayer->ResetReading();
         if( poJoinLayer->SetAttributeFilter( osFilter.c_str() ) == OGRERR_NONE )
             poJoinFeature = poJoinLayer->GetNextFeature();
 
         apoFeatures.push_back( poJoinFeature );
+        abJoinFeatureOwned.push_back( TRUE );
     }
 
 /* -------------------------------------------------------------------- */
@@ -1336,7 +1782,8 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
             iRegularField ++;
         }
 
-        delete poJoinFeature;
+        if( abJoinFeatureOwned[iJoin] )
+            delete poJoinFeature;
     }
 
     return poDstFeat;
@@ -1357,7 +1804,8 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
 /*      Handle summary sets.                                            */
 /* -------------------------------------------------------------------- */
     if( psSelectInfo->query_mode == SWQM_SUMMARY_RECORD 
-        || psSelectInfo->query_mode == SWQM_DISTINCT_LIST )
+        || psSelectInfo->query_mode == SWQM_DISTINCT_LIST
+        || psSelectInfo->query_mode == SWQM_GROUP_BY )
         return GetFeature( nNextIndexFID++ );
 
     int bEvaluateSpatialFilter = MustEvaluateSpatialFilterOnGenSQL();
@@ -1371,6 +1819,25 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
 
         if( panFIDIndex != NULL )
             poFeature =  GetFeature( nNextIndexFID++ );
+        else if( papoSortedFeatures != NULL )
+        {
+            if( nNextIndexFID < 0 || nNextIndexFID >= nIndexSize )
+                return NULL;
+
+            poFeature = TranslateFeature( papoSortedFeatures[nNextIndexFID++] );
+        }
+        else if( nSortRuns > 0 )
+        {
+            OGRFeature *poSrcFeat =
+                GetNextSortedFeature( pasSortRuns, nSortRuns );
+
+            if( poSrcFeat == NULL )
+                return NULL;
+
+            nNextIndexFID++;
+            poFeature = TranslateFeature( poSrcFeat );
+            delete poSrcFeat;
+        }
         else
         {
             OGRFeature *poSrcFeat = poSrcLayer->GetNextFeature();
@@ -1444,6 +1911,12 @@ OGRFeature *OGRGenSQLResultsLayer::GetFeature( long nFID )
         return poSummaryFeature->Clone();
     }
 
+/* -------------------------------------------------------------------- */
+/*      Handle request for group record.                                */
+/* -------------------------------------------------------------------- */
+    if( psSelectInfo->query_mode == SWQM_GROUP_BY )
+        return GetGroupFeature( nFID );
+
 /* -------------------------------------------------------------------- */
 /*      Are we running in sorted mode?  If so, run the fid through      */
 /*      the index.                                                      */
@@ -1455,6 +1928,31 @@ OGRFeature *OGRGenSQLResultsLayer::GetFeature( long nFID )
         else
             nFID = panFIDIndex[nFID];
     }
+    else if( papoSortedFeatures != NULL )
+    {
+        if( nFID < 0 || nFID >= nIndexSize )
+            return NULL;
+        else
+            return TranslateFeature( papoSortedFeatures[nFID] );
+    }
+    else if( nSortRuns > 0 )
+    {
+        /* This requires reading the sorted runs up to the requested */
+        /* position, and then restoring the position of GetNextFeature() */
+        if( nFID < 0 )
+            return NULL;
+
+        SeekSortMerge( nFID );
+        OGRFeature *poSrcFeat = GetNextSortedFeature( pasSortRuns, nSortRuns );
+        SeekSortMerge( nNextIndexFID );
+
+        if( poSrcFeat == NULL )
+            return NULL;
+
+        OGRFeature *poResult = TranslateFeature( poSrcFeat );
+        delete poSrcFeat;
+        return poResult;
+    }
 
 /* -------------------------------------------------------------------- */
 /*      Handle request for random record.                               */
@@ -1494,385 +1992,2356 @@ OGRFeatureDefn *OGRGenSQLResultsLayer::GetLayerDefn()
 }
 
 /************************************************************************/
-/*                         CreateOrderByIndex()                         */
-/*                                                                      */
-/*      This method is responsible for creating an index providing      */
-/*      ordered access to the features according to the supplied        */
-/*      ORDER BY clauses.                                               */
+/*                           OGRGenSQLSortRun                           */
 /*                                                                      */
-/*      This is accomplished by making one pass through all the         */
-/*      eligible source features, and capturing the order by fields     */
-/*      of all records in memory.  A quick sort is then applied to      */
-/*      this in memory copy of the order-by fields to create the        */
-/*      required index.                                                 */
+/*      A sorted batch of source features spilled to a temporary file   */
+/*      by the ORDER BY logic, and its current head during the merge.   */
+/*      The file is only open while the run is being merged.            */
+/************************************************************************/
+
+struct _OGRGenSQLSortRun
+{
+    char       *pszFilename;
+    VSILFILE   *fp;
+    int         nFeatures;
+    int         nRead;
+    int         nLevel;      /* number of merges the run results from */
+    OGRFeature *poHead;
+    OGRField   *pasHeadKeys;
+};
+
+/************************************************************************/
+/*                       OGRGenSQLGetMaxOpenRuns()                      */
 /*                                                                      */
-/*      Keeping all the key values in memory will *not* scale up to     */
-/*      very large input datasets.                                      */
+/*      Maximum number of ORDER BY or GROUP BY runs opened at once      */
+/*      during a merge.                                                 */
 /************************************************************************/
 
-void OGRGenSQLResultsLayer::CreateOrderByIndex()
+static int OGRGenSQLGetMaxOpenRuns()
 
 {
-    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
-    OGRField *pasIndexFields;
-    int      i, nOrderItems = psSelectInfo->order_specs;
-    long     *panFIDList;
+    return MAX( 2,
+        atoi(CPLGetConfigOption("OGR_SQL_ORDER_BY_MAX_OPEN_RUNS", "64")) );
+}
 
-    if( ! (psSelectInfo->order_specs > 0
-           && psSelectInfo->query_mode == SWQM_RECORDSET
-           && nOrderItems != 0 ) )
-        return;
+/************************************************************************/
+/*                        OGRGenSQLWriteString()                        */
+/************************************************************************/
 
-    if( bOrderByValid )
-        return;
+static int OGRGenSQLWriteString( VSILFILE *fp, const char *pszStr )
 
-    bOrderByValid = TRUE;
+{
+    GInt32 nLen = (pszStr != NULL) ? (GInt32) strlen(pszStr) : -1;
 
-    ResetReading();
+    if( VSIFWriteL( &nLen, sizeof(nLen), 1, fp ) != 1 )
+        return FALSE;
 
-/* -------------------------------------------------------------------- */
+    return nLen <= 0 || (GInt32) VSIFWriteL( pszStr, 1, nLen, fp ) == nLen;
+}
+
+/************************************************************************/
+/*                        OGRGenSQLReadString()                         */
+/*                                                                      */
+/*      Returns a string to free with CPLFree(), or NULL.  *pbOK is     */
+/*      set to FALSE on I/O error.                                      */
+/************************************************************************/
+
+static char *OGRGenSQLReadString( VSILFILE *fp, int *pbOK )
+
+{
+    GInt32 nLen;
+
+    if( VSIFReadL( &nLen, sizeof(nLen), 1, fp ) != 1 )
+    {
+        *pbOK = FALSE;
+        return NULL;
+    }
+
+    if( nLen < 0 )
+        return NULL;
+
+    char *pszStr = (char *) CPLMalloc( nLen + 1 );
+    if( (GInt32) VSIFReadL( pszStr, 1, nLen, fp ) != nLen )
+        *pbOK = FALSE;
+    pszStr[nLen] = '\0';
+
+    return pszStr;
+}
+
+/************************************************************************/
+/*                        OGRGenSQLWriteFeature()                       */
+/*                                                                      */
+/*      Serialize a source feature in a temporary file, in native       */
+/*      byte order.                                                     */
+/************************************************************************/
+
+static int OGRGenSQLWriteFeature( VSILFILE *fp, OGRFeature *poFeature )
+
+{
+    OGRFeatureDefn *poFDefn = poFeature->GetDefnRef();
+    GIntBig nFID = poFeature->GetFID();
+    int iField, bOK = TRUE;
+
+    bOK &= VSIFWriteL( &nFID, sizeof(nFID), 1, fp ) == 1;
+    bOK &= OGRGenSQLWriteString( fp, poFeature->GetStyleString() );
+
+    for( iField = 0; bOK && iField < poFDefn->GetFieldCount(); iField++ )
+    {
+        GByte bSet = (GByte) poFeature->IsFieldSet( iField );
+
+        bOK &= VSIFWriteL( &bSet, 1, 1, fp ) == 1;
+        if( !bSet )
+            continue;
+
+        OGRField *psField = poFeature->GetRawFieldRef( iField );
+
+        switch( poFDefn->GetFieldDefn(iField)->GetType() )
+        {
+          case OFTInteger:
+            bOK &= VSIFWriteL( &psField->Integer, sizeof(int), 1, fp ) == 1;
+            break;
+
+          case OFTReal:
+            bOK &= VSIFWriteL( &psField->Real, sizeof(double), 1, fp ) == 1;
+            break;
+
+          case OFTString:
+            bOK &= OGRGenSQLWriteString( fp, psField->String );
+            break;
+
+          case OFTIntegerList:
+            bOK &= VSIFWriteL( &psField->IntegerList.nCount,
+                               sizeof(int), 1, fp ) == 1;
+            bOK &= (int) VSIFWriteL( psField->IntegerList.paList, sizeof(int),
+                                     psField->IntegerList.nCount, fp )
+                == psField->IntegerList.nCount;
+            break;
+
+          case OFTRealList:
+            bOK &= VSIFWriteL( &psField->RealList.nCount,
+                               sizeof(int), 1, fp ) == 1;
+            bOK &= (int) VSIFWriteL( psField->RealList.paList, sizeof(double),
+                                     psField->RealList.nCount, fp )
+                == psField->RealList.nCount;
+            break;
+
+          case OFTStringList:
+          {
+            bOK &= VSIFWriteL( &psField->StringList.nCount,
+                               sizeof(int), 1, fp ) == 1;
+            for( int i = 0; i < psField->StringList.nCount; i++ )
+                bOK &= OGRGenSQLWriteString( fp, psField->StringList.paList[i] );
+            break;
+          }
+
+          case OFTBinary:
+            bOK &= VSIFWriteL( &psField->Binary.nCount,
+                               sizeof(int), 1, fp ) == 1;
+            bOK &= (int) VSIFWriteL( psField->Binary.paData, 1,
+                                     psField->Binary.nCount, fp )
+                == psField->Binary.nCount;
+            break;
+
+          case OFTDate:
+          case OFTTime:
+          case OFTDateTime:
+            bOK &= VSIFWriteL( &psField->Date, sizeof(psField->Date),
+                               1, fp ) == 1;
+            break;
+
+          default:
+            break;
+        }
+    }
+
+    for( iField = 0; bOK && iField < poFDefn->GetGeomFieldCount(); iField++ )
+    {
+        OGRGeometry *poGeom = poFeature->GetGeomFieldRef( iField );
+        GInt32 nSize = (poGeom != NULL) ? poGeom->WkbSize() : -1;
+
+        bOK &= VSIFWriteL( &nSize, sizeof(nSize), 1, fp ) == 1;
+        if( poGeom == NULL )
+            continue;
+
+        GByte *pabyWKB = (GByte *) CPLMalloc( nSize );
+        poGeom->exportToWkb( wkbNDR, pabyWKB );
+        bOK &= (GInt32) VSIFWriteL( pabyWKB, 1, nSize, fp ) == nSize;
+        CPLFree( pabyWKB );
+    }
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                        OGRGenSQLReadFeature()                        */
+/************************************************************************/
+
+static OGRFeature *OGRGenSQLReadFeature( VSILFILE *fp,
+                                         OGRFeatureDefn *poFDefn )
+
+{
+    OGRFeature *poFeature = new OGRFeature( poFDefn );
+    GIntBig nFID;
+    int iField, bOK = TRUE;
+
+    bOK &= VSIFReadL( &nFID, sizeof(nFID), 1, fp ) == 1;
+    poFeature->SetFID( (long) nFID );
+
+    char *pszStyle = OGRGenSQLReadString( fp, &bOK );
+    if( pszStyle != NULL )
+        poFeature->SetStyleStringDirectly( pszStyle );
+
+    for( iField = 0; bOK && iField < poFDefn->GetFieldCount(); iField++ )
+    {
+        GByte bSet = FALSE;
+
+        bOK &= VSIFReadL( &bSet, 1, 1, fp ) == 1;
+        if( !bOK || !bSet )
+            continue;
+
+        switch( poFDefn->GetFieldDefn(iField)->GetType() )
+        {
+          case OFTInteger:
+          {
+            int nValue = 0;
+            bOK &= VSIFReadL( &nValue, sizeof(int), 1, fp ) == 1;
+            poFeature->SetField( iField, nValue );
+            break;
+          }
+
+          case OFTReal:
+          {
+            double dfValue = 0.0;
+            bOK &= VSIFReadL( &dfValue, sizeof(double), 1, fp ) == 1;
+            poFeature->SetField( iField, dfValue );
+            break;
+          }
+
+          case OFTString:
+          {
+            char *pszValue = OGRGenSQLReadString( fp, &bOK );
+            if( pszValue != NULL )
+                poFeature->SetField( iField, pszValue );
+            CPLFree( pszValue );
+            break;
+          }
+
+          case OFTIntegerList:
+          {
+            int nCount = 0;
+            bOK &= VSIFReadL( &nCount, sizeof(int), 1, fp ) == 1;
+            if( !bOK || nCount < 0 )
+            {
+                bOK = FALSE;
+                break;
+            }
+            int *panList = (int *) CPLMalloc( sizeof(int) * MAX(1,nCount) );
+            bOK &= (int) VSIFReadL( panList, sizeof(int), nCount, fp ) == nCount;
+            poFeature->SetField( iField, nCount, panList );
+            CPLFree( panList );
+            break;
+          }
+
+          case OFTRealList:
+          {
+            int nCount = 0;
+            bOK &= VSIFReadL( &nCount, sizeof(int), 1, fp ) == 1;
+            if( !bOK || nCount < 0 )
+            {
+                bOK = FALSE;
+                break;
+            }
+            double *padfList = (double *)
+                CPLMalloc( sizeof(double) * MAX(1,nCount) );
+            bOK &= (int) VSIFReadL( padfList, sizeof(double), nCount, fp ) == nCount;
+            poFeature->SetField( iField, nCount, padfList );
+            CPLFree( padfList );
+            break;
+          }
+
+          case OFTStringList:
+          {
+            int nCount = 0;
+            bOK &= VSIFReadL( &nCount, sizeof(int), 1, fp ) == 1;
+            if( !bOK || nCount < 0 )
+            {
+                bOK = FALSE;
+                break;
+            }
+            char **papszList = NULL;
+            for( int i = 0; bOK && i < nCount; i++ )
+            {
+                char *pszValue = OGRGenSQLReadString( fp, &bOK );
+                papszList = CSLAddString( papszList,
+                                          pszValue ? pszValue : "" );
+                CPLFree( pszValue );
+            }
+            poFeature->SetField( iField, papszList );
+            CSLDestroy( papszList );
+            break;
+          }
+
+          case OFTBinary:
+          {
+            int nCount = 0;
+            bOK &= VSIFReadL( &nCount, sizeof(int), 1, fp ) == 1;
+            if( !bOK || nCount < 0 )
+            {
+                bOK = FALSE;
+                break;
+            }
+            GByte *pabyData = (GByte *) CPLMalloc( MAX(1,nCount) );
+            bOK &= (int) VSIFReadL( pabyData, 1, nCount, fp ) == nCount;
+            poFeature->SetField( iField, nCount, pabyData );
+            CPLFree( pabyData );
+            break;
+          }
+
+          case OFTDate:
+          case OFTTime:
+          case OFTDateTime:
+          {
+            OGRField sField;
+            bOK &= VSIFReadL( &sField.Date, sizeof(sField.Date), 1, fp ) == 1;
+            poFeature->SetField( iField, &sField );
+            break;
+          }
+
+          default:
+            break;
+        }
+    }
+
+    for( iField = 0; bOK && iField < poFDefn->GetGeomFieldCount(); iField++ )
+    {
+        GInt32 nSize = -1;
+
+        bOK &= VSIFReadL( &nSize, sizeof(nSize), 1, fp ) == 1;
+        if( !bOK || nSize < 0 )
+            continue;
+
+        GByte *pabyWKB = (GByte *) CPLMalloc( MAX(1,nSize) );
+        bOK &= (GInt32) VSIFReadL( pabyWKB, 1, nSize, fp ) == nSize;
+
+        OGRGeometry *poGeom = NULL;
+        if( bOK &&
+            OGRGeometryFactory::createFromWkb(
+                pabyWKB,
+                poFDefn->GetGeomFieldDefn(iField)->GetSpatialRef(),
+                &poGeom, nSize ) == OGRERR_NONE )
+            poFeature->SetGeomFieldDirectly( iField, poGeom );
+        CPLFree( pabyWKB );
+    }
+
+    if( !bOK )
+    {
+        delete poFeature;
+        return NULL;
+    }
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                           GetOrderByKeys()                           */
+/*                                                                      */
+/*      Capture the ORDER BY key values of a source feature.  Returns   */
+/*      the number of bytes allocated for string keys.                  */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::GetOrderByKeys( OGRFeature *poSrcFeat,
+                                           OGRField *pasKeys )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int      iKey, nOrderItems = psSelectInfo->order_specs;
+    int      nStringSize = 0;
+
+    memset( pasKeys, 0, sizeof(OGRField) * nOrderItems );
+
+    for( iKey = 0; iKey < nOrderItems; iKey++ )
+    {
+        swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
+        OGRFieldDefn *poFDefn;
+        OGRField *psSrcField, *psDstField;
+
+        psDstField = pasKeys + iKey;
+
+        if ( psKeyDef->field_index >= iFIDFieldIndex)
+        {
+            if ( psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT )
+            {
+                switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
+                {
+                  case SWQ_INTEGER:
+                    psDstField->Integer = poSrcFeat->GetFieldAsInteger(psKeyDef->field_index);
+                    break;
+
+                  case SWQ_FLOAT:
+                    psDstField->Real = poSrcFeat->GetFieldAsDouble(psKeyDef->field_index);
+                    break;
+
+                  default:
+                    psDstField->String = CPLStrdup( poSrcFeat->GetFieldAsString(psKeyDef->field_index) );
+                    nStringSize += strlen(psDstField->String) + 1;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
+            psKeyDef->field_index );
+
+        psSrcField = poSrcFeat->GetRawFieldRef( psKeyDef->field_index );
+
+        if( poFDefn->GetType() == OFTInteger 
+            || poFDefn->GetType() == OFTReal
+            || poFDefn->GetType() == OFTDate
+            || poFDefn->GetType() == OFTTime
+            || poFDefn->GetType() == OFTDateTime)
+            memcpy( psDstField, psSrcField, sizeof(OGRField) );
+        else if( poFDefn->GetType() == OFTString )
+        {
+            if( poSrcFeat->IsFieldSet( psKeyDef->field_index ) )
+            {
+                psDstField->String = CPLStrdup( psSrcField->String );
+                nStringSize += strlen(psDstField->String) + 1;
+            }
+            else
+                memcpy( psDstField, psSrcField, sizeof(OGRField) );
+        }
+    }
+
+    return nStringSize;
+}
+
+/************************************************************************/
+/*                          FreeOrderByKeys()                           */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::FreeOrderByKeys( OGRField *pasKeys,
+                                             int nEntries )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int      i, nOrderItems = psSelectInfo->order_specs;
+
+    for( int iKey = 0; iKey < nOrderItems; iKey++ )
+    {
+        swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
+        OGRFieldDefn *poFDefn;
+
+        if ( psKeyDef->field_index >= iFIDFieldIndex &&
+            psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT )
+        {
+            /* warning: only special fields of type string should be deallocated */
+            if (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex] == SWQ_STRING)
+            {
+                for( i = 0; i < nEntries; i++ )
+                {
+                    OGRField *psField = pasKeys + iKey + i * nOrderItems;
+                    CPLFree( psField->String );
+                }
+            }
+            continue;
+        }
+
+        poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
+            psKeyDef->field_index );
+
+        if( poFDefn->GetType() == OFTString )
+        {
+            for( i = 0; i < nEntries; i++ )
+            {
+                OGRField *psField = pasKeys + iKey + i * nOrderItems;
+                
+                if( psField->Set.nMarker1 != OGRUnsetMarker 
+                    || psField->Set.nMarker2 != OGRUnsetMarker )
+                    CPLFree( psField->String );
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                         CreateOrderByIndex()                         */
+/*                                                                      */
+/*      This method is responsible for creating an index providing      */
+/*      ordered access to the features according to the supplied        */
+/*      ORDER BY clauses.                                               */
+/*                                                                      */
+/*      If the source layer has fast random reading, we first try to    */
+/*      capture the order by fields of all records in memory, and       */
+/*      sort them to build an index of FIDs that are later fetched      */
+/*      with GetFeature().                                              */
+/*                                                                      */
+/*      If the source layer has no fast random reading, or if the       */
+/*      keys don't fit in OGR_SQL_ORDER_BY_MAX_MEMORY (in MB), the      */
+/*      whole source features are sorted instead, in memory when        */
+/*      possible, or otherwise as sorted runs spilled to temporary      */
+/*      files that are merged while reading.                            */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::CreateOrderByIndex()
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int      nOrderItems = psSelectInfo->order_specs;
+
+    if( ! (psSelectInfo->order_specs > 0
+           && psSelectInfo->query_mode == SWQM_RECORDSET
+           && nOrderItems != 0 ) )
+        return;
+
+    if( bOrderByValid )
+        return;
+
+    bOrderByValid = TRUE;
+
+    GIntBig nMaxMemory = ((GIntBig)
+        atoi(CPLGetConfigOption("OGR_SQL_ORDER_BY_MAX_MEMORY", "100")))
+        * 1024 * 1024;
+
+    if( !poSrcLayer->TestCapability( OLCRandomRead ) ||
+        !CreateFIDOrderByIndex( nMaxMemory ) )
+    {
+        CreateSortedFeatures( nMaxMemory );
+    }
+
+    ResetReading();
+}
+
+/************************************************************************/
+/*                       CreateFIDOrderByIndex()                        */
+/*                                                                      */
+/*      Returns FALSE if the keys don't fit in nMaxMemory.              */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::CreateFIDOrderByIndex( GIntBig nMaxMemory )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    OGRField *pasIndexFields;
+    int      i, nOrderItems = psSelectInfo->order_specs;
+    long     *panFIDList;
+    GIntBig  nMemory = 0;
+
+    ResetReading();
+
+/* -------------------------------------------------------------------- */
 /*      Allocate set of key values, and the output index.               */
 /* -------------------------------------------------------------------- */
-    int nFeaturesAlloc = 100;
+    int nFeaturesAlloc = 100;
+
+    panFIDIndex = NULL;
+    pasIndexFields = (OGRField *) 
+        CPLCalloc(sizeof(OGRField), nOrderItems * nFeaturesAlloc);
+    panFIDList = (long *) CPLMalloc(sizeof(long) * nFeaturesAlloc);
+
+/* -------------------------------------------------------------------- */
+/*      Read in all the key values.                                     */
+/* -------------------------------------------------------------------- */
+    OGRFeature *poSrcFeat;
+    nIndexSize = 0;
+
+    while( (poSrcFeat = poSrcLayer->GetNextFeature()) != NULL )
+    {
+        if (nIndexSize == nFeaturesAlloc)
+        {
+            int nNewFeaturesAlloc = (nFeaturesAlloc * 4) / 3;
+            OGRField* pasNewIndexFields = (OGRField *)
+                VSIRealloc(pasIndexFields,
+                           sizeof(OGRField) * nOrderItems * nNewFeaturesAlloc);
+            if (pasNewIndexFields == NULL)
+            {
+                delete poSrcFeat;
+                FreeOrderByKeys( pasIndexFields, nIndexSize );
+                VSIFree(pasIndexFields);
+                VSIFree(panFIDList);
+                nIndexSize = 0;
+                return FALSE;
+            }
+            pasIndexFields = pasNewIndexFields;
+
+            long* panNewFIDList = (long *)
+                VSIRealloc(panFIDList, sizeof(long) *  nNewFeaturesAlloc);
+            if (panNewFIDList == NULL)
+            {
+                delete poSrcFeat;
+                FreeOrderByKeys( pasIndexFields, nIndexSize );
+                VSIFree(pasIndexFields);
+                VSIFree(panFIDList);
+                nIndexSize = 0;
+                return FALSE;
+            }
+            panFIDList = panNewFIDList;
+
+            memset(pasIndexFields + nFeaturesAlloc, 0,
+                   sizeof(OGRField) * nOrderItems * (nNewFeaturesAlloc - nFeaturesAlloc));
+
+            nFeaturesAlloc = nNewFeaturesAlloc;
+        }
+
+        nMemory += GetOrderByKeys( poSrcFeat,
+                                   pasIndexFields + nIndexSize * nOrderItems );
+        nMemory += sizeof(OGRField) * nOrderItems + 2 * sizeof(long);
+
+        panFIDList[nIndexSize] = poSrcFeat->GetFID();
+        delete poSrcFeat;
+
+        nIndexSize++;
+
+        if( nMemory > nMaxMemory )
+        {
+            CPLDebug( "GenSQL",
+                      "ORDER BY keys exceed %d MB. Sorting whole features.",
+                      (int) (nMaxMemory / (1024 * 1024)) );
+            FreeOrderByKeys( pasIndexFields, nIndexSize );
+            CPLFree( pasIndexFields );
+            CPLFree( panFIDList );
+            nIndexSize = 0;
+            return FALSE;
+        }
+    }
+
+    //CPLDebug("GenSQL", "CreateOrderByIndex() = %d features", nIndexSize);
+
+/* -------------------------------------------------------------------- */
+/*      Initialize panFIDIndex                                          */
+/* -------------------------------------------------------------------- */
+    panFIDIndex = (long *) CPLMalloc(sizeof(long) * nIndexSize);
+    for( i = 0; i < nIndexSize; i++ )
+        panFIDIndex[i] = i;
+
+/* -------------------------------------------------------------------- */
+/*      Quick sort the records.                                         */
+/* -------------------------------------------------------------------- */
+    SortIndexSection( pasIndexFields, panFIDIndex, 0, nIndexSize );
+
+/* -------------------------------------------------------------------- */
+/*      Rework the FID map to map to real FIDs.                         */
+/* -------------------------------------------------------------------- */
+    int bAlreadySorted = TRUE;
+    for( i = 0; i < nIndexSize; i++ )
+    {
+        if (panFIDIndex[i] != i)
+            bAlreadySorted = FALSE;
+        panFIDIndex[i] = panFIDList[panFIDIndex[i]];
+    }
+
+    CPLFree( panFIDList );
+
+/* -------------------------------------------------------------------- */
+/*      Free the key field values.                                      */
+/* -------------------------------------------------------------------- */
+    FreeOrderByKeys( pasIndexFields, nIndexSize );
+
+    CPLFree( pasIndexFields );
+
+    /* If it is already sorted, then free than panFIDIndex array */
+    /* so that GetNextFeature() can call a sequential GetNextFeature() */
+    /* on the source array. Very usefull for layers where random access */
+    /* is slow. */
+    /* Use case: the GML result of a WFS GetFeature with a SORTBY */
+    if (bAlreadySorted)
+    {
+        CPLFree( panFIDIndex );
+        panFIDIndex = NULL;
+
+        nIndexSize = 0;
+    }
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                        CreateSortedFeatures()                        */
+/*                                                                      */
+/*      Read the source features, and sort them by batches fitting in   */
+/*      nMaxMemory.  If all the features fit in a single batch, they    */
+/*      are kept in memory in papoSortedFeatures.  Otherwise each       */
+/*      sorted batch is written in a temporary file, and the runs are   */
+/*      merged by GetNextSortedFeature().                               */
+/*                                                                      */
+/*      No more than OGR_SQL_ORDER_BY_MAX_OPEN_RUNS runs are merged at  */
+/*      once.  Whenever that many runs resulting from the same number   */
+/*      of merges are written, they are merged into a single run, and   */
+/*      the last runs are merged again at the end if there are still    */
+/*      too many of them.  Only consecutive runs are merged, so that    */
+/*      the sort remains stable.                                        */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::CreateSortedFeatures( GIntBig nMaxMemory )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int      nOrderItems = psSelectInfo->order_specs;
+    int      nFeaturesAlloc = 100, nEntries = 0;
+    int      nMerges = 0;
+    GIntBig  nMemory = 0;
+    int      nMaxOpenRuns = OGRGenSQLGetMaxOpenRuns();
+
+    ResetReading();
+
+    OGRFeature **papoFeatures = (OGRFeature **)
+        CPLMalloc(sizeof(OGRFeature *) * nFeaturesAlloc);
+    OGRField *pasKeys = (OGRField *)
+        CPLMalloc(sizeof(OGRField) * nOrderItems * nFeaturesAlloc);
+
+    OGRFeature *poSrcFeat;
+
+    while( (poSrcFeat = poSrcLayer->GetNextFeature()) != NULL )
+    {
+        if( nEntries == nFeaturesAlloc )
+        {
+            nFeaturesAlloc = (nFeaturesAlloc * 4) / 3;
+            papoFeatures = (OGRFeature **)
+                CPLRealloc(papoFeatures, sizeof(OGRFeature *) * nFeaturesAlloc);
+            pasKeys = (OGRField *)
+                CPLRealloc(pasKeys, sizeof(OGRField) * nOrderItems * nFeaturesAlloc);
+        }
+
+        nMemory += GetOrderByKeys( poSrcFeat, pasKeys + nEntries * nOrderItems );
+        nMemory += sizeof(OGRField) * nOrderItems + 2 * sizeof(OGRFeature *)
+            + OGRGenSQLEstimateFeatureMemory( poSrcFeat );
+        papoFeatures[nEntries++] = poSrcFeat;
+
+        if( nMemory > nMaxMemory )
+        {
+            int bOK = WriteSortRun( papoFeatures, pasKeys, nEntries );
+            nEntries = 0;
+            nMemory = 0;
+
+            while( bOK && nSortRuns >= nMaxOpenRuns
+                   && pasSortRuns[nSortRuns - nMaxOpenRuns].nLevel
+                      == pasSortRuns[nSortRuns - 1].nLevel )
+            {
+                bOK = MergeLastSortRuns( nMaxOpenRuns );
+                nMerges++;
+            }
+
+            if( !bOK )
+                break;
+        }
+    }
+
+    if( nSortRuns == 0 )
+    {
+/* -------------------------------------------------------------------- */
+/*      Everything fits in memory.                                      */
+/* -------------------------------------------------------------------- */
+        long *panIndex = (long *) CPLMalloc(sizeof(long) * MAX(1,nEntries));
+        int i;
+
+        for( i = 0; i < nEntries; i++ )
+            panIndex[i] = i;
+
+        SortIndexSection( pasKeys, panIndex, 0, nEntries );
+
+        papoSortedFeatures = (OGRFeature **)
+            CPLMalloc(sizeof(OGRFeature *) * MAX(1,nEntries));
+        for( i = 0; i < nEntries; i++ )
+            papoSortedFeatures[i] = papoFeatures[panIndex[i]];
+        nIndexSize = nEntries;
+
+        FreeOrderByKeys( pasKeys, nEntries );
+        CPLFree( panIndex );
+    }
+    else if( nEntries > 0 )
+    {
+        WriteSortRun( papoFeatures, pasKeys, nEntries );
+    }
+
+    CPLFree( papoFeatures );
+    CPLFree( pasKeys );
+
+/* -------------------------------------------------------------------- */
+/*      Merge the last, and smallest, runs until few enough are left.   */
+/* -------------------------------------------------------------------- */
+    while( nSortRuns > nMaxOpenRuns )
+    {
+        MergeLastSortRuns( MIN(nMaxOpenRuns, nSortRuns - nMaxOpenRuns + 1) );
+        nMerges++;
+    }
+
+    if( nSortRuns > 0 )
+        CPLDebug( "GenSQL",
+                  "ORDER BY: merging %d sorted runs, after %d intermediate merges",
+                  nSortRuns, nMerges );
+}
+
+/************************************************************************/
+/*                            WriteSortRun()                            */
+/*                                                                      */
+/*      Sort a batch of features, and write them in a temporary file.   */
+/*      The features and their keys are released.                       */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::WriteSortRun( OGRFeature **papoFeatures,
+                                         OGRField *pasKeys, int nEntries )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int      i, bOK = TRUE;
+    long    *panIndex = (long *) CPLMalloc(sizeof(long) * nEntries);
+
+    for( i = 0; i < nEntries; i++ )
+        panIndex[i] = i;
+
+    SortIndexSection( pasKeys, panIndex, 0, nEntries );
+
+    CPLString osFilename = CPLGenerateTempFilename( "ogr_sql_sort" );
+    VSILFILE *fp = VSIFOpenL( osFilename, "w+b" );
+    if( fp == NULL )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot create temporary file %s for ORDER BY.",
+                  osFilename.c_str() );
+        bOK = FALSE;
+    }
+
+    for( i = 0; i < nEntries; i++ )
+    {
+        if( bOK && !OGRGenSQLWriteFeature( fp, papoFeatures[panIndex[i]] ) )
+        {
+            CPLError( CE_Failure, CPLE_FileIO,
+                      "Cannot write temporary file %s for ORDER BY.",
+                      osFilename.c_str() );
+            bOK = FALSE;
+        }
+        delete papoFeatures[panIndex[i]];
+    }
+
+    FreeOrderByKeys( pasKeys, nEntries );
+    CPLFree( panIndex );
+
+    if( fp == NULL )
+        return FALSE;
+
+    VSIFCloseL( fp );
+
+    pasSortRuns = (OGRGenSQLSortRun *)
+        CPLRealloc( pasSortRuns, sizeof(OGRGenSQLSortRun) * (nSortRuns + 1) );
+    OGRGenSQLSortRun *psRun = pasSortRuns + nSortRuns;
+    nSortRuns++;
+
+    psRun->pszFilename = CPLStrdup( osFilename );
+    psRun->fp = NULL;
+    psRun->nFeatures = bOK ? nEntries : 0;
+    psRun->nRead = 0;
+    psRun->nLevel = 0;
+    psRun->poHead = NULL;
+    psRun->pasHeadKeys = (OGRField *)
+        CPLCalloc( sizeof(OGRField), psSelectInfo->order_specs );
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                         MergeLastSortRuns()                          */
+/*                                                                      */
+/*      Merge the last nRuns sorted runs into a single one, written     */
+/*      in a new temporary file.                                        */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::MergeLastSortRuns( int nRuns )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    OGRGenSQLSortRun *pasRuns = pasSortRuns + nSortRuns - nRuns;
+    int      iRun, nLevel = 0, nFeatures = 0, bOK = TRUE;
+
+    CPLString osFilename = CPLGenerateTempFilename( "ogr_sql_sort" );
+    VSILFILE *fp = VSIFOpenL( osFilename, "wb" );
+    if( fp == NULL )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot create temporary file %s for ORDER BY.",
+                  osFilename.c_str() );
+        bOK = FALSE;
+    }
+
+    for( iRun = 0; iRun < nRuns; iRun++ )
+    {
+        nLevel = MAX( nLevel, pasRuns[iRun].nLevel );
+        if( !OpenSortRun( pasRuns + iRun ) )
+            bOK = FALSE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Write the merged features, then release the merged runs.        */
+/* -------------------------------------------------------------------- */
+    OGRFeature *poFeature;
+
+    while( (poFeature = GetNextSortedFeature( pasRuns, nRuns )) != NULL )
+    {
+        if( fp != NULL && bOK )
+        {
+            if( OGRGenSQLWriteFeature( fp, poFeature ) )
+                nFeatures++;
+            else
+            {
+                CPLError( CE_Failure, CPLE_FileIO,
+                          "Cannot write temporary file %s for ORDER BY.",
+                          osFilename.c_str() );
+                bOK = FALSE;
+            }
+        }
+        delete poFeature;
+    }
+
+    for( iRun = 0; iRun < nRuns; iRun++ )
+        FreeSortRun( pasRuns + iRun );
+
+    if( fp != NULL )
+        VSIFCloseL( fp );
+
+    nSortRuns -= nRuns - 1;
+
+    OGRGenSQLSortRun *psRun = pasSortRuns + nSortRuns - 1;
+
+    psRun->pszFilename = CPLStrdup( osFilename );
+    psRun->fp = NULL;
+    psRun->nFeatures = nFeatures;
+    psRun->nRead = 0;
+    psRun->nLevel = nLevel + 1;
+    psRun->poHead = NULL;
+    psRun->pasHeadKeys = (OGRField *)
+        CPLCalloc( sizeof(OGRField), psSelectInfo->order_specs );
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                            OpenSortRun()                             */
+/*                                                                      */
+/*      Open a sorted run if needed, or rewind it, and read its first   */
+/*      feature.                                                        */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::OpenSortRun( OGRGenSQLSortRun *psRun )
+
+{
+    if( psRun->poHead != NULL )
+    {
+        FreeOrderByKeys( psRun->pasHeadKeys, 1 );
+        delete psRun->poHead;
+        psRun->poHead = NULL;
+    }
+
+    psRun->nRead = 0;
+
+    if( psRun->nFeatures == 0 )
+        return TRUE;
+
+    if( psRun->fp == NULL )
+    {
+        psRun->fp = VSIFOpenL( psRun->pszFilename, "rb" );
+        if( psRun->fp == NULL )
+        {
+            CPLError( CE_Failure, CPLE_FileIO,
+                      "Cannot open temporary file %s for ORDER BY.",
+                      psRun->pszFilename );
+            psRun->nRead = psRun->nFeatures;
+            return FALSE;
+        }
+    }
+    else
+        VSIFSeekL( psRun->fp, 0, SEEK_SET );
+
+    ReadSortRunHead( psRun );
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                           ReadSortRunHead()                          */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::ReadSortRunHead( OGRGenSQLSortRun *psRun )
+
+{
+    psRun->poHead = NULL;
+
+    if( psRun->nRead >= psRun->nFeatures )
+        return;
+
+    psRun->poHead = OGRGenSQLReadFeature( psRun->fp,
+                                          poSrcLayer->GetLayerDefn() );
+    psRun->nRead ++;
+
+    if( psRun->poHead == NULL )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot read temporary file %s for ORDER BY.",
+                  psRun->pszFilename );
+        psRun->nRead = psRun->nFeatures;
+        return;
+    }
+
+    GetOrderByKeys( psRun->poHead, psRun->pasHeadKeys );
+}
+
+/************************************************************************/
+/*                            FreeSortRun()                             */
+/*                                                                      */
+/*      Release a sorted run, and remove its temporary file.            */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::FreeSortRun( OGRGenSQLSortRun *psRun )
+
+{
+    if( psRun->poHead != NULL )
+    {
+        FreeOrderByKeys( psRun->pasHeadKeys, 1 );
+        delete psRun->poHead;
+    }
+    CPLFree( psRun->pasHeadKeys );
+    if( psRun->fp != NULL )
+        VSIFCloseL( psRun->fp );
+    VSIUnlink( psRun->pszFilename );
+    CPLFree( psRun->pszFilename );
+}
+
+/************************************************************************/
+/*                           ResetSortMerge()                           */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::ResetSortMerge()
+
+{
+    for( int iRun = 0; iRun < nSortRuns; iRun++ )
+        OpenSortRun( pasSortRuns + iRun );
+}
+
+/************************************************************************/
+/*                         GetNextSortedFeature()                       */
+/*                                                                      */
+/*      Return the next source feature in ORDER BY order, from the      */
+/*      merge of the nRuns sorted runs starting at pasRuns.  Ties are   */
+/*      resolved in favor of the earliest run, so that the sort         */
+/*      remains stable.                                                 */
+/************************************************************************/
+
+OGRFeature *
+OGRGenSQLResultsLayer::GetNextSortedFeature( OGRGenSQLSortRun *pasRuns,
+                                             int nRuns )
+
+{
+    OGRGenSQLSortRun *psBest = NULL;
+
+    for( int iRun = 0; iRun < nRuns; iRun++ )
+    {
+        OGRGenSQLSortRun *psRun = pasRuns + iRun;
+
+        if( psRun->poHead == NULL )
+            continue;
+
+        if( psBest == NULL ||
+            Compare( psBest->pasHeadKeys, psRun->pasHeadKeys ) < 0 )
+            psBest = psRun;
+    }
+
+    if( psBest == NULL )
+        return NULL;
+
+    OGRFeature *poFeature = psBest->poHead;
+
+    FreeOrderByKeys( psBest->pasHeadKeys, 1 );
+    ReadSortRunHead( psBest );
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                           SeekSortMerge()                            */
+/*                                                                      */
+/*      Position the merge of the sorted runs so that the next          */
+/*      feature returned is the nIndex-th one.                          */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::SeekSortMerge( long nIndex )
+
+{
+    ResetSortMerge();
+
+    for( long i = 0; i < nIndex; i++ )
+    {
+        OGRFeature *poFeature = GetNextSortedFeature( pasSortRuns, nSortRuns );
+        if( poFeature == NULL )
+            break;
+        delete poFeature;
+    }
+}
+
+/************************************************************************/
+/*                          SortIndexSection()                          */
+/*                                                                      */
+/*      Sort the records in a section of the index.                     */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::SortIndexSection( OGRField *pasIndexFields, 
+                                              long *panIndex,
+                                              int nStart, int nEntries )
+
+{
+    if( nEntries < 2 )
+        return;
+
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int      nOrderItems = psSelectInfo->order_specs;
+
+    int nFirstGroup = nEntries / 2;
+    int nFirstStart = nStart;
+    int nSecondGroup = nEntries - nFirstGroup;
+    int nSecondStart = nStart + nFirstGroup;
+    int iMerge = 0;
+    long *panMerged;
+
+    SortIndexSection( pasIndexFields, panIndex, nFirstStart, nFirstGroup );
+    SortIndexSection( pasIndexFields, panIndex, nSecondStart, nSecondGroup );
+
+    panMerged = (long *) CPLMalloc( sizeof(long) * nEntries );
+        
+    while( iMerge < nEntries )
+    {
+        int  nResult;
+
+        if( nFirstGroup == 0 )
+            nResult = -1;
+        else if( nSecondGroup == 0 )
+            nResult = 1;
+        else
+            nResult = Compare( pasIndexFields 
+                               + panIndex[nFirstStart] * nOrderItems, 
+                               pasIndexFields 
+                               + panIndex[nSecondStart] * nOrderItems );
+
+        if( nResult < 0 )
+        {
+            panMerged[iMerge++] = panIndex[nSecondStart++];
+            nSecondGroup--;
+        }
+        else
+        {
+            panMerged[iMerge++] = panIndex[nFirstStart++];
+            nFirstGroup--;
+        }
+    }
+
+    /* Copy the merge list back into the main index */
+
+    memcpy( panIndex + nStart, panMerged, sizeof(long) * nEntries );
+    CPLFree( panMerged );
+}
+
+/************************************************************************/
+/*                              Compare()                               */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::Compare( OGRField *pasFirstTuple,
+                                    OGRField *pasSecondTuple )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int  nResult = 0, iKey;
+
+    for( iKey = 0; nResult == 0 && iKey < psSelectInfo->order_specs; iKey++ )
+    {
+        swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
+        OGRFieldDefn *poFDefn;
+
+        if( psKeyDef->field_index >= iFIDFieldIndex + SPECIAL_FIELD_COUNT )
+        {
+            CPLAssert( FALSE );
+            return 0;
+        }
+        else if( psKeyDef->field_index >= iFIDFieldIndex )
+            poFDefn = NULL;
+        else
+            poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
+                psKeyDef->field_index );
+        
+        if( (pasFirstTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
+             && pasFirstTuple[iKey].Set.nMarker2 == OGRUnsetMarker)
+            || (pasSecondTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
+                && pasSecondTuple[iKey].Set.nMarker2 == OGRUnsetMarker) )
+            nResult = 0;
+        else if ( poFDefn == NULL )
+        {
+            switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
+            {
+              case SWQ_INTEGER:
+                if( pasFirstTuple[iKey].Integer < pasSecondTuple[iKey].Integer )
+                    nResult = -1;
+                else if( pasFirstTuple[iKey].Integer > pasSecondTuple[iKey].Integer )
+                    nResult = 1;
+                break;
+              case SWQ_FLOAT:
+                if( pasFirstTuple[iKey].Real < pasSecondTuple[iKey].Real )
+                    nResult = -1;
+                else if( pasFirstTuple[iKey].Real > pasSecondTuple[iKey].Real )
+                    nResult = 1;
+                break;
+              case SWQ_STRING:
+                nResult = strcmp(pasFirstTuple[iKey].String,
+                                 pasSecondTuple[iKey].String);
+                break;
+
+              default:
+                CPLAssert( FALSE );
+                nResult = 0;
+            }
+        }
+        else if( poFDefn->GetType() == OFTInteger )
+        {
+            if( pasFirstTuple[iKey].Integer < pasSecondTuple[iKey].Integer )
+                nResult = -1;
+            else if( pasFirstTuple[iKey].Integer 
+                     > pasSecondTuple[iKey].Integer )
+                nResult = 1;
+        }
+        else if( poFDefn->GetType() == OFTString )
+            nResult = strcmp(pasFirstTuple[iKey].String,
+                             pasSecondTuple[iKey].String);
+        else if( poFDefn->GetType() == OFTReal )
+        {
+            if( pasFirstTuple[iKey].Real < pasSecondTuple[iKey].Real )
+                nResult = -1;
+            else if( pasFirstTuple[iKey].Real > pasSecondTuple[iKey].Real )
+                nResult = 1;
+        }
+        else if( poFDefn->GetType() == OFTDate ||
+                 poFDefn->GetType() == OFTTime ||
+                 poFDefn->GetType() == OFTDateTime)
+        {
+            nResult = OGRCompareDate(&pasFirstTuple[iKey],
+                                     &pasSecondTuple[iKey]);
+        }
+
+        if( psKeyDef->ascending_flag )
+            nResult *= -1;
+    }
+
+    return nResult;
+}
+
+
+/************************************************************************/
+/*                          OGRGenSQLGroupAgg                           */
+/*                                                                      */
+/*      Partial state of a column function for one group.  nCount is   */
+/*      the number of non null values met.                              */
+/************************************************************************/
+
+typedef struct
+{
+    int         nCount;
+    double      dfSum;
+    double      dfMin;
+    double      dfMax;
+    CPLHashSet *hDistinct;      /* values met, for COUNT(DISTINCT field) */
+} OGRGenSQLGroupAgg;
+
+/************************************************************************/
+/*                            OGRGenSQLGroup                            */
+/************************************************************************/
+
+typedef struct
+{
+    int         nKeys;
+    char      **papszKeys;      /* GROUP BY field values, NULL if unset */
+    OGRGenSQLGroupAgg *pasAggs; /* one per result column */
+} OGRGenSQLGroup;
+
+/************************************************************************/
+/*                          OGRGenSQLGroupRun                           */
+/*                                                                      */
+/*      A batch of groups, sorted by keys, spilled to a temporary       */
+/*      file when the hash table exceeds the allowed memory, and its    */
+/*      current head during the merge.  As for the ORDER BY runs, the   */
+/*      file is only open while the run is being merged.                */
+/************************************************************************/
+
+typedef struct
+{
+    char       *pszFilename;
+    VSILFILE   *fp;
+    int         nGroups;
+    int         nRead;
+    int         nLevel;      /* number of merges the run results from */
+    OGRGenSQLGroup *psHead;
+} OGRGenSQLGroupRun;
+
+/************************************************************************/
+/*                          _OGRGenSQLGroupBy                           */
+/************************************************************************/
+
+struct _OGRGenSQLGroupBy
+{
+    int         nKeys;
+    int         nAggs;
+    swq_col_def *pasColDefs;
+    swq_field_type *paeKeyTypes;
+    int        *panKeyOrder;    /* GROUP BY fields, by sort priority */
+    int        *pabKeyAscending;
+    int        *panColumnKey;   /* GROUP BY field of each plain column */
+
+    OGRGenSQLGroup **papsGroups; /* sorted groups, if they fit in memory */
+    int         nGroups;
+
+    int         nRuns;           /* otherwise, sorted runs to merge */
+    OGRGenSQLGroupRun *pasRuns;
+    long        nMergeIndex;
+    long        nGroupCount;
+};
+
+/************************************************************************/
+/*                          OGRGenSQLNewGroup()                         */
+/************************************************************************/
+
+static OGRGenSQLGroup *OGRGenSQLNewGroup( int nKeys, int nAggs )
+
+{
+    OGRGenSQLGroup *psGroup = (OGRGenSQLGroup *)
+        CPLMalloc( sizeof(OGRGenSQLGroup) );
+
+    psGroup->nKeys = nKeys;
+    psGroup->papszKeys = (char **) CPLCalloc( sizeof(char *), MAX(1,nKeys) );
+    psGroup->pasAggs = (OGRGenSQLGroupAgg *)
+        CPLCalloc( sizeof(OGRGenSQLGroupAgg), MAX(1,nAggs) );
+
+    for( int i = 0; i < nAggs; i++ )
+    {
+        psGroup->pasAggs[i].dfMin = 1e20;
+        psGroup->pasAggs[i].dfMax = -1e20;
+    }
+
+    return psGroup;
+}
+
+/************************************************************************/
+/*                         OGRGenSQLFreeGroup()                         */
+/************************************************************************/
+
+static void OGRGenSQLFreeGroup( OGRGenSQLGroup *psGroup, int nAggs )
+
+{
+    if( psGroup == NULL )
+        return;
+
+    for( int i = 0; i < psGroup->nKeys; i++ )
+        CPLFree( psGroup->papszKeys[i] );
+    CPLFree( psGroup->papszKeys );
+
+    for( int i = 0; i < nAggs; i++ )
+    {
+        if( psGroup->pasAggs[i].hDistinct != NULL )
+            CPLHashSetDestroy( psGroup->pasAggs[i].hDistinct );
+    }
+    CPLFree( psGroup->pasAggs );
+
+    CPLFree( psGroup );
+}
+
+/************************************************************************/
+/*                     Group hash set callbacks.                        */
+/************************************************************************/
+
+static unsigned long OGRGenSQLGroupHash( const void *elt )
+
+{
+    const OGRGenSQLGroup *psGroup = (const OGRGenSQLGroup *) elt;
+    unsigned long nHash = 0;
+
+    for( int i = 0; i < psGroup->nKeys; i++ )
+    {
+        nHash = nHash * 31;
+        if( psGroup->papszKeys[i] != NULL )
+            nHash += CPLHashSetHashStr( psGroup->papszKeys[i] ) + 1;
+    }
+
+    return nHash;
+}
+
+static int OGRGenSQLGroupEqual( const void *elt1, const void *elt2 )
+
+{
+    const OGRGenSQLGroup *psGroup1 = (const OGRGenSQLGroup *) elt1;
+    const OGRGenSQLGroup *psGroup2 = (const OGRGenSQLGroup *) elt2;
+
+    for( int i = 0; i < psGroup1->nKeys; i++ )
+    {
+        const char *pszKey1 = psGroup1->papszKeys[i];
+        const char *pszKey2 = psGroup2->papszKeys[i];
+
+        if( pszKey1 == NULL || pszKey2 == NULL )
+        {
+            if( pszKey1 != pszKey2 )
+                return FALSE;
+        }
+        else if( strcmp( pszKey1, pszKey2 ) != 0 )
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+static int OGRGenSQLCollectGroup( void *elt, void *user_data )
+
+{
+    std::vector<OGRGenSQLGroup*> *papsGroups =
+        (std::vector<OGRGenSQLGroup*> *) user_data;
+
+    papsGroups->push_back( (OGRGenSQLGroup *) elt );
+    return TRUE;
+}
+
+static int OGRGenSQLAddDistinctValue( void *elt, void *user_data )
+
+{
+    CPLHashSet *hDistinct = (CPLHashSet *) user_data;
+
+    if( CPLHashSetLookup( hDistinct, elt ) == NULL )
+        CPLHashSetInsert( hDistinct, CPLStrdup( (const char *) elt ) );
+    return TRUE;
+}
+
+static int OGRGenSQLWriteDistinctValue( void *elt, void *user_data )
+
+{
+    return OGRGenSQLWriteString( (VSILFILE *) user_data, (const char *) elt );
+}
+
+/************************************************************************/
+/*                       OGRGenSQLCompareGroups()                       */
+/*                                                                      */
+/*      Order groups by their keys.  NULL keys come first, and ties of  */
+/*      numeric comparisons are broken by the string values, so that   */
+/*      0 is only returned for groups that are equal in the hash set.   */
+/************************************************************************/
+
+static int OGRGenSQLCompareGroups( const OGRGenSQLGroupBy *psGroupBy,
+                                   const OGRGenSQLGroup *psGroup1,
+                                   const OGRGenSQLGroup *psGroup2 )
+
+{
+    int nResult = 0;
+
+    for( int i = 0; nResult == 0 && i < psGroupBy->nKeys; i++ )
+    {
+        int iKey = psGroupBy->panKeyOrder[i];
+        const char *pszKey1 = psGroup1->papszKeys[iKey];
+        const char *pszKey2 = psGroup2->papszKeys[iKey];
+
+        if( pszKey1 == NULL || pszKey2 == NULL )
+        {
+            if( pszKey1 != NULL )
+                nResult = 1;
+            else if( pszKey2 != NULL )
+                nResult = -1;
+        }
+        else
+        {
+            if( psGroupBy->paeKeyTypes[iKey] == SWQ_INTEGER )
+            {
+                int nVal1 = atoi(pszKey1), nVal2 = atoi(pszKey2);
+                if( nVal1 < nVal2 )
+                    nResult = -1;
+                else if( nVal1 > nVal2 )
+                    nResult = 1;
+            }
+            else if( psGroupBy->paeKeyTypes[iKey] == SWQ_FLOAT )
+            {
+                double dfVal1 = CPLAtof(pszKey1), dfVal2 = CPLAtof(pszKey2);
+                if( dfVal1 < dfVal2 )
+                    nResult = -1;
+                else if( dfVal1 > dfVal2 )
+                    nResult = 1;
+            }
+
+            if( nResult == 0 )
+                nResult = strcmp( pszKey1, pszKey2 );
+        }
+
+        if( !psGroupBy->pabKeyAscending[i] )
+            nResult = -nResult;
+    }
+
+    return nResult;
+}
+
+class OGRGenSQLGroupSorter
+{
+    const OGRGenSQLGroupBy *psGroupBy;
+
+  public:
+    OGRGenSQLGroupSorter( const OGRGenSQLGroupBy *psGroupByIn ) :
+        psGroupBy(psGroupByIn) {}
+
+    bool operator()( const OGRGenSQLGroup *psGroup1,
+                     const OGRGenSQLGroup *psGroup2 ) const
+    {
+        return OGRGenSQLCompareGroups( psGroupBy, psGroup1, psGroup2 ) < 0;
+    }
+};
+
+/************************************************************************/
+/*                        OGRGenSQLMergeGroup()                         */
+/*                                                                      */
+/*      Accumulate the partial column function states of psSrc, a      */
+/*      group of same keys read from another run, into psDst.          */
+/************************************************************************/
+
+static void OGRGenSQLMergeGroup( OGRGenSQLGroupBy *psGroupBy,
+                                 OGRGenSQLGroup *psDst,
+                                 OGRGenSQLGroup *psSrc )
+
+{
+    for( int i = 0; i < psGroupBy->nAggs; i++ )
+    {
+        OGRGenSQLGroupAgg *psDstAgg = psDst->pasAggs + i;
+        OGRGenSQLGroupAgg *psSrcAgg = psSrc->pasAggs + i;
+
+        psDstAgg->nCount += psSrcAgg->nCount;
+        psDstAgg->dfSum += psSrcAgg->dfSum;
+        psDstAgg->dfMin = MIN(psDstAgg->dfMin, psSrcAgg->dfMin);
+        psDstAgg->dfMax = MAX(psDstAgg->dfMax, psSrcAgg->dfMax);
+
+        if( psSrcAgg->hDistinct != NULL )
+        {
+            if( psDstAgg->hDistinct == NULL )
+            {
+                psDstAgg->hDistinct = psSrcAgg->hDistinct;
+                psSrcAgg->hDistinct = NULL;
+            }
+            else
+                CPLHashSetForeach( psSrcAgg->hDistinct,
+                                   OGRGenSQLAddDistinctValue,
+                                   psDstAgg->hDistinct );
+        }
+    }
+}
+
+/************************************************************************/
+/*                        OGRGenSQLWriteGroup()                         */
+/************************************************************************/
+
+static int OGRGenSQLWriteGroup( VSILFILE *fp, OGRGenSQLGroup *psGroup,
+                                int nAggs )
+
+{
+    int bOK = TRUE;
+
+    for( int i = 0; bOK && i < psGroup->nKeys; i++ )
+        bOK &= OGRGenSQLWriteString( fp, psGroup->papszKeys[i] );
+
+    for( int i = 0; bOK && i < nAggs; i++ )
+    {
+        OGRGenSQLGroupAgg *psAgg = psGroup->pasAggs + i;
+        GInt32 nDistinct = (psAgg->hDistinct != NULL) ?
+            CPLHashSetSize( psAgg->hDistinct ) : -1;
+
+        bOK &= VSIFWriteL( &(psAgg->nCount), sizeof(int), 1, fp ) == 1;
+        bOK &= VSIFWriteL( &(psAgg->dfSum), sizeof(double), 1, fp ) == 1;
+        bOK &= VSIFWriteL( &(psAgg->dfMin), sizeof(double), 1, fp ) == 1;
+        bOK &= VSIFWriteL( &(psAgg->dfMax), sizeof(double), 1, fp ) == 1;
+        bOK &= VSIFWriteL( &nDistinct, sizeof(nDistinct), 1, fp ) == 1;
+        if( bOK && nDistinct > 0 )
+            CPLHashSetForeach( psAgg->hDistinct,
+                               OGRGenSQLWriteDistinctValue, fp );
+    }
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                         OGRGenSQLReadGroup()                         */
+/************************************************************************/
+
+static OGRGenSQLGroup *OGRGenSQLReadGroup( VSILFILE *fp, int nKeys,
+                                           int nAggs )
+
+{
+    int bOK = TRUE;
+    OGRGenSQLGroup *psGroup = OGRGenSQLNewGroup( nKeys, nAggs );
+
+    for( int i = 0; bOK && i < nKeys; i++ )
+        psGroup->papszKeys[i] = OGRGenSQLReadString( fp, &bOK );
+
+    for( int i = 0; bOK && i < nAggs; i++ )
+    {
+        OGRGenSQLGroupAgg *psAgg = psGroup->pasAggs + i;
+        GInt32 nDistinct = -1;
+
+        bOK &= VSIFReadL( &(psAgg->nCount), sizeof(int), 1, fp ) == 1;
+        bOK &= VSIFReadL( &(psAgg->dfSum), sizeof(double), 1, fp ) == 1;
+        bOK &= VSIFReadL( &(psAgg->dfMin), sizeof(double), 1, fp ) == 1;
+        bOK &= VSIFReadL( &(psAgg->dfMax), sizeof(double), 1, fp ) == 1;
+        bOK &= VSIFReadL( &nDistinct, sizeof(nDistinct), 1, fp ) == 1;
+        if( bOK && nDistinct >= 0 )
+        {
+            psAgg->hDistinct = CPLHashSetNew( CPLHashSetHashStr,
+                                              CPLHashSetEqualStr, CPLFree );
+            for( int j = 0; bOK && j < nDistinct; j++ )
+            {
+                char *pszValue = OGRGenSQLReadString( fp, &bOK );
+                if( pszValue != NULL )
+                    CPLHashSetInsert( psAgg->hDistinct, pszValue );
+            }
+        }
+    }
+
+    if( !bOK )
+    {
+        OGRGenSQLFreeGroup( psGroup, nAggs );
+        return NULL;
+    }
+
+    return psGroup;
+}
+
+/************************************************************************/
+/*                       OGRGenSQLWriteGroupRun()                       */
+/*                                                                      */
+/*      Sort the groups of the hash set, write them in a temporary     */
+/*      file, and release them.                                         */
+/************************************************************************/
+
+static int OGRGenSQLWriteGroupRun( OGRGenSQLGroupBy *psGroupBy,
+                                   CPLHashSet *hGroups )
+
+{
+    std::vector<OGRGenSQLGroup*> apsGroups;
+    int bOK = TRUE;
+
+    CPLHashSetForeach( hGroups, OGRGenSQLCollectGroup, &apsGroups );
+    std::sort( apsGroups.begin(), apsGroups.end(),
+               OGRGenSQLGroupSorter( psGroupBy ) );
+
+    CPLString osFilename = CPLGenerateTempFilename( "ogr_sql_group" );
+    VSILFILE *fp = VSIFOpenL( osFilename, "w+b" );
+    if( fp == NULL )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot create temporary file %s for GROUP BY.",
+                  osFilename.c_str() );
+        bOK = FALSE;
+    }
+
+    for( size_t i = 0; i < apsGroups.size(); i++ )
+    {
+        if( bOK && !OGRGenSQLWriteGroup( fp, apsGroups[i], psGroupBy->nAggs ) )
+        {
+            CPLError( CE_Failure, CPLE_FileIO,
+                      "Cannot write temporary file %s for GROUP BY.",
+                      osFilename.c_str() );
+            bOK = FALSE;
+        }
+        OGRGenSQLFreeGroup( apsGroups[i], psGroupBy->nAggs );
+    }
+
+    if( fp == NULL )
+        return FALSE;
+
+    VSIFCloseL( fp );
+
+    psGroupBy->pasRuns = (OGRGenSQLGroupRun *)
+        CPLRealloc( psGroupBy->pasRuns,
+                    sizeof(OGRGenSQLGroupRun) * (psGroupBy->nRuns + 1) );
+    OGRGenSQLGroupRun *psRun = psGroupBy->pasRuns + psGroupBy->nRuns;
+    psGroupBy->nRuns++;
+
+    psRun->pszFilename = CPLStrdup( osFilename );
+    psRun->fp = NULL;
+    psRun->nGroups = bOK ? (int) apsGroups.size() : 0;
+    psRun->nRead = 0;
+    psRun->nLevel = 0;
+    psRun->psHead = NULL;
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                     OGRGenSQLReadGroupRunHead()                      */
+/************************************************************************/
+
+static void OGRGenSQLReadGroupRunHead( OGRGenSQLGroupBy *psGroupBy,
+                                       OGRGenSQLGroupRun *psRun )
+
+{
+    psRun->psHead = NULL;
+
+    if( psRun->nRead >= psRun->nGroups )
+        return;
+
+    psRun->psHead = OGRGenSQLReadGroup( psRun->fp, psGroupBy->nKeys,
+                                        psGroupBy->nAggs );
+    psRun->nRead ++;
+
+    if( psRun->psHead == NULL )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot read temporary file %s for GROUP BY.",
+                  psRun->pszFilename );
+        psRun->nRead = psRun->nGroups;
+    }
+}
+
+/************************************************************************/
+/*                       OGRGenSQLOpenGroupRun()                        */
+/*                                                                      */
+/*      Open a sorted run if needed, or rewind it, and read its first   */
+/*      group.                                                          */
+/************************************************************************/
+
+static int OGRGenSQLOpenGroupRun( OGRGenSQLGroupBy *psGroupBy,
+                                  OGRGenSQLGroupRun *psRun )
+
+{
+    OGRGenSQLFreeGroup( psRun->psHead, psGroupBy->nAggs );
+    psRun->psHead = NULL;
+    psRun->nRead = 0;
+
+    if( psRun->nGroups == 0 )
+        return TRUE;
+
+    if( psRun->fp == NULL )
+    {
+        psRun->fp = VSIFOpenL( psRun->pszFilename, "rb" );
+        if( psRun->fp == NULL )
+        {
+            CPLError( CE_Failure, CPLE_FileIO,
+                      "Cannot open temporary file %s for GROUP BY.",
+                      psRun->pszFilename );
+            psRun->nRead = psRun->nGroups;
+            return FALSE;
+        }
+    }
+    else
+        VSIFSeekL( psRun->fp, 0, SEEK_SET );
+
+    OGRGenSQLReadGroupRunHead( psGroupBy, psRun );
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                       OGRGenSQLFreeGroupRun()                        */
+/*                                                                      */
+/*      Release a sorted run, and remove its temporary file.            */
+/************************************************************************/
+
+static void OGRGenSQLFreeGroupRun( OGRGenSQLGroupBy *psGroupBy,
+                                   OGRGenSQLGroupRun *psRun )
+
+{
+    OGRGenSQLFreeGroup( psRun->psHead, psGroupBy->nAggs );
+    if( psRun->fp != NULL )
+        VSIFCloseL( psRun->fp );
+    VSIUnlink( psRun->pszFilename );
+    CPLFree( psRun->pszFilename );
+}
+
+/************************************************************************/
+/*                      OGRGenSQLResetGroupMerge()                      */
+/************************************************************************/
+
+static void OGRGenSQLResetGroupMerge( OGRGenSQLGroupBy *psGroupBy )
+
+{
+    for( int iRun = 0; iRun < psGroupBy->nRuns; iRun++ )
+        OGRGenSQLOpenGroupRun( psGroupBy, psGroupBy->pasRuns + iRun );
+
+    psGroupBy->nMergeIndex = 0;
+}
+
+/************************************************************************/
+/*                      OGRGenSQLMergeNextGroup()                       */
+/*                                                                      */
+/*      Return the next group from the merge of the nRuns sorted runs   */
+/*      starting at pasRuns, with the partial states of all the runs    */
+/*      accumulated.                                                    */
+/************************************************************************/
+
+static OGRGenSQLGroup *OGRGenSQLMergeNextGroup( OGRGenSQLGroupBy *psGroupBy,
+                                                OGRGenSQLGroupRun *pasRuns,
+                                                int nRuns )
+
+{
+    OGRGenSQLGroupRun *psBest = NULL;
+    int iRun;
+
+    for( iRun = 0; iRun < nRuns; iRun++ )
+    {
+        OGRGenSQLGroupRun *psRun = pasRuns + iRun;
+
+        if( psRun->psHead == NULL )
+            continue;
+
+        if( psBest == NULL ||
+            OGRGenSQLCompareGroups( psGroupBy, psRun->psHead,
+                                    psBest->psHead ) < 0 )
+            psBest = psRun;
+    }
+
+    if( psBest == NULL )
+        return NULL;
+
+    OGRGenSQLGroup *psGroup = psBest->psHead;
+    OGRGenSQLReadGroupRunHead( psGroupBy, psBest );
+
+    for( iRun = 0; iRun < nRuns; iRun++ )
+    {
+        OGRGenSQLGroupRun *psRun = pasRuns + iRun;
+
+        if( psRun->psHead != NULL &&
+            OGRGenSQLCompareGroups( psGroupBy, psRun->psHead, psGroup ) == 0 )
+        {
+            OGRGenSQLMergeGroup( psGroupBy, psGroup, psRun->psHead );
+            OGRGenSQLFreeGroup( psRun->psHead, psGroupBy->nAggs );
+            OGRGenSQLReadGroupRunHead( psGroupBy, psRun );
+        }
+    }
+
+    return psGroup;
+}
+
+/************************************************************************/
+/*                       OGRGenSQLGetNextGroup()                        */
+/************************************************************************/
+
+static OGRGenSQLGroup *OGRGenSQLGetNextGroup( OGRGenSQLGroupBy *psGroupBy )
+
+{
+    OGRGenSQLGroup *psGroup =
+        OGRGenSQLMergeNextGroup( psGroupBy, psGroupBy->pasRuns,
+                                 psGroupBy->nRuns );
+
+    if( psGroup != NULL )
+        psGroupBy->nMergeIndex++;
+
+    return psGroup;
+}
+
+/************************************************************************/
+/*                    OGRGenSQLMergeLastGroupRuns()                     */
+/*                                                                      */
+/*      Merge the last nRuns sorted runs into a single one, written     */
+/*      in a new temporary file.                                        */
+/************************************************************************/
+
+static int OGRGenSQLMergeLastGroupRuns( OGRGenSQLGroupBy *psGroupBy,
+                                        int nRuns )
+
+{
+    OGRGenSQLGroupRun *pasRuns =
+        psGroupBy->pasRuns + psGroupBy->nRuns - nRuns;
+    int      iRun, nLevel = 0, nGroups = 0, bOK = TRUE;
+
+    CPLString osFilename = CPLGenerateTempFilename( "ogr_sql_group" );
+    VSILFILE *fp = VSIFOpenL( osFilename, "wb" );
+    if( fp == NULL )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot create temporary file %s for GROUP BY.",
+                  osFilename.c_str() );
+        bOK = FALSE;
+    }
+
+    for( iRun = 0; iRun < nRuns; iRun++ )
+    {
+        nLevel = MAX( nLevel, pasRuns[iRun].nLevel );
+        if( !OGRGenSQLOpenGroupRun( psGroupBy, pasRuns + iRun ) )
+            bOK = FALSE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Write the merged groups, then release the merged runs.          */
+/* -------------------------------------------------------------------- */
+    OGRGenSQLGroup *psGroup;
 
-    panFIDIndex = NULL;
-    pasIndexFields = (OGRField *) 
-        CPLCalloc(sizeof(OGRField), nOrderItems * nFeaturesAlloc);
-    panFIDList = (long *) CPLMalloc(sizeof(long) * nFeaturesAlloc);
+    while( (psGroup = OGRGenSQLMergeNextGroup( psGroupBy, pasRuns,
+                                               nRuns )) != NULL )
+    {
+        if( fp != NULL && bOK )
+        {
+            if( OGRGenSQLWriteGroup( fp, psGroup, psGroupBy->nAggs ) )
+                nGroups++;
+            else
+            {
+                CPLError( CE_Failure, CPLE_FileIO,
+                          "Cannot write temporary file %s for GROUP BY.",
+                          osFilename.c_str() );
+                bOK = FALSE;
+            }
+        }
+        OGRGenSQLFreeGroup( psGroup, psGroupBy->nAggs );
+    }
+
+    for( iRun = 0; iRun < nRuns; iRun++ )
+        OGRGenSQLFreeGroupRun( psGroupBy, pasRuns + iRun );
+
+    if( fp != NULL )
+        VSIFCloseL( fp );
+
+    psGroupBy->nRuns -= nRuns - 1;
+
+    OGRGenSQLGroupRun *psRun = psGroupBy->pasRuns + psGroupBy->nRuns - 1;
+
+    psRun->pszFilename = CPLStrdup( osFilename );
+    psRun->fp = NULL;
+    psRun->nGroups = nGroups;
+    psRun->nRead = 0;
+    psRun->nLevel = nLevel + 1;
+    psRun->psHead = NULL;
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                           PrepareGroupBy()                           */
+/*                                                                      */
+/*      Read the source features once, and accumulate the column        */
+/*      functions of each group in a hash set keyed on the GROUP BY     */
+/*      field values.  If the groups don't fit in                       */
+/*      OGR_SQL_GROUP_BY_MAX_MEMORY (in MB), the hash set is spilled   */
+/*      as a sorted run to a temporary file, and the runs are merged    */
+/*      while reading.  As for ORDER BY, no more than                   */
+/*      OGR_SQL_ORDER_BY_MAX_OPEN_RUNS runs are merged at once.         */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::PrepareGroupBy()
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int nKeys = psSelectInfo->group_by_count;
+    int nAggs = psSelectInfo->result_columns;
+    int i, iKey;
+
+    GIntBig nMaxMemory = ((GIntBig)
+        atoi(CPLGetConfigOption("OGR_SQL_GROUP_BY_MAX_MEMORY", "100")))
+        * 1024 * 1024;
+    int nMaxOpenRuns = OGRGenSQLGetMaxOpenRuns();
+    int nMerges = 0;
+
+    FreeGroupBy();
+
+    psGroupBy = (OGRGenSQLGroupBy *) CPLCalloc( sizeof(OGRGenSQLGroupBy), 1 );
+    psGroupBy->nKeys = nKeys;
+    psGroupBy->nAggs = nAggs;
+    psGroupBy->pasColDefs = psSelectInfo->column_defs;
+    psGroupBy->paeKeyTypes = (swq_field_type *)
+        CPLMalloc( sizeof(swq_field_type) * nKeys );
+    psGroupBy->panKeyOrder = (int *) CPLMalloc( sizeof(int) * nKeys );
+    psGroupBy->pabKeyAscending = (int *) CPLMalloc( sizeof(int) * nKeys );
+    psGroupBy->panColumnKey = (int *) CPLMalloc( sizeof(int) * MAX(1,nAggs) );
+    psGroupBy->nGroupCount = -1;
 
 /* -------------------------------------------------------------------- */
-/*      Read in all the key values.                                     */
+/*      The groups are returned sorted on the ORDER BY fields, and      */
+/*      then on the remaining GROUP BY fields.                          */
 /* -------------------------------------------------------------------- */
-    OGRFeature *poSrcFeat;
-    nIndexSize = 0;
+    int nOrderKeys = 0;
 
-    while( (poSrcFeat = poSrcLayer->GetNextFeature()) != NULL )
+    for( iKey = 0; iKey < nKeys; iKey++ )
+        psGroupBy->paeKeyTypes[iKey] = psSelectInfo->group_by_defs[iKey].field_type;
+
+    for( i = 0; i < psSelectInfo->order_specs; i++ )
     {
-        int iKey;
+        swq_order_def *psOrderDef = psSelectInfo->order_defs + i;
 
-        if (nIndexSize == nFeaturesAlloc)
+        for( iKey = 0; iKey < nKeys; iKey++ )
         {
-            int nNewFeaturesAlloc = (nFeaturesAlloc * 4) / 3;
-            OGRField* pasNewIndexFields = (OGRField *)
-                VSIRealloc(pasIndexFields,
-                           sizeof(OGRField) * nOrderItems * nNewFeaturesAlloc);
-            if (pasNewIndexFields == NULL)
+            if( psSelectInfo->group_by_defs[iKey].field_index
+                == psOrderDef->field_index )
+                break;
+        }
+
+        int j;
+        for( j = 0; j < nOrderKeys; j++ )
+        {
+            if( psGroupBy->panKeyOrder[j] == iKey )
+                break;
+        }
+
+        if( iKey < nKeys && j == nOrderKeys )
+        {
+            psGroupBy->panKeyOrder[nOrderKeys] = iKey;
+            psGroupBy->pabKeyAscending[nOrderKeys] = psOrderDef->ascending_flag;
+            nOrderKeys++;
+        }
+    }
+
+    for( iKey = 0; iKey < nKeys; iKey++ )
+    {
+        int j;
+        for( j = 0; j < nOrderKeys; j++ )
+        {
+            if( psGroupBy->panKeyOrder[j] == iKey )
+                break;
+        }
+
+        if( j == nOrderKeys )
+        {
+            psGroupBy->panKeyOrder[nOrderKeys] = iKey;
+            psGroupBy->pabKeyAscending[nOrderKeys] = TRUE;
+            nOrderKeys++;
+        }
+    }
+
+    for( i = 0; i < nAggs; i++ )
+    {
+        swq_col_def *psColDef = psSelectInfo->column_defs + i;
+
+        psGroupBy->panColumnKey[i] = -1;
+        for( iKey = 0;
+             psColDef->col_func == SWQCF_NONE && iKey < nKeys;
+             iKey++ )
+        {
+            if( psSelectInfo->group_by_defs[iKey].field_index
+                == psColDef->field_index )
             {
-                VSIFree(pasIndexFields);
-                VSIFree(panFIDList);
-                nIndexSize = 0;
-                return;
+                psGroupBy->panColumnKey[i] = iKey;
+                break;
             }
-            pasIndexFields = pasNewIndexFields;
+        }
+    }
 
-            long* panNewFIDList = (long *)
-                VSIRealloc(panFIDList, sizeof(long) *  nNewFeaturesAlloc);
-            if (panNewFIDList == NULL)
+/* -------------------------------------------------------------------- */
+/*      Accumulate the source features in the groups.                   */
+/* -------------------------------------------------------------------- */
+    CPLHashSet *hGroups = CPLHashSetNew( OGRGenSQLGroupHash,
+                                         OGRGenSQLGroupEqual, NULL );
+    OGRGenSQLGroup *psLookup = OGRGenSQLNewGroup( nKeys, 0 );
+    OGRFeatureDefn *poSrcDefn = poSrcLayer->GetLayerDefn();
+    OGRFeature *poSrcFeature;
+    GIntBig nMemory = 0;
+    int bOK = TRUE;
+
+    while( bOK && (poSrcFeature = poSrcLayer->GetNextFeature()) != NULL )
+    {
+        for( iKey = 0; iKey < nKeys; iKey++ )
+        {
+            int iSrcField = psSelectInfo->group_by_defs[iKey].field_index;
+
+            if( poSrcFeature->IsFieldSet( iSrcField ) )
+                psLookup->papszKeys[iKey] =
+                    CPLStrdup( poSrcFeature->GetFieldAsString( iSrcField ) );
+        }
+
+        OGRGenSQLGroup *psGroup = (OGRGenSQLGroup *)
+            CPLHashSetLookup( hGroups, psLookup );
+
+        if( psGroup == NULL )
+        {
+            psGroup = OGRGenSQLNewGroup( nKeys, nAggs );
+            nMemory += sizeof(OGRGenSQLGroup) + 4 * sizeof(void *)
+                + nKeys * sizeof(char *) + nAggs * sizeof(OGRGenSQLGroupAgg);
+
+            for( iKey = 0; iKey < nKeys; iKey++ )
             {
-                VSIFree(pasIndexFields);
-                VSIFree(panFIDList);
-                nIndexSize = 0;
-                return;
+                psGroup->papszKeys[iKey] = psLookup->papszKeys[iKey];
+                psLookup->papszKeys[iKey] = NULL;
+                if( psGroup->papszKeys[iKey] != NULL )
+                    nMemory += strlen(psGroup->papszKeys[iKey]) + 1;
             }
-            panFIDList = panNewFIDList;
-
-            memset(pasIndexFields + nFeaturesAlloc, 0,
-                   sizeof(OGRField) * nOrderItems * (nNewFeaturesAlloc - nFeaturesAlloc));
 
-            nFeaturesAlloc = nNewFeaturesAlloc;
+            CPLHashSetInsert( hGroups, psGroup );
+        }
+        else
+        {
+            for( iKey = 0; iKey < nKeys; iKey++ )
+            {
+                CPLFree( psLookup->papszKeys[iKey] );
+                psLookup->papszKeys[iKey] = NULL;
+            }
         }
 
-        for( iKey = 0; iKey < nOrderItems; iKey++ )
+        for( i = 0; i < nAggs; i++ )
         {
-            swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
-            OGRFieldDefn *poFDefn;
-            OGRField *psSrcField, *psDstField;
+            swq_col_def *psColDef = psSelectInfo->column_defs + i;
+            OGRGenSQLGroupAgg *psAgg = psGroup->pasAggs + i;
 
-            psDstField = pasIndexFields + nIndexSize * nOrderItems + iKey;
+            if( psColDef->col_func == SWQCF_NONE )
+                continue;
 
-            if ( psKeyDef->field_index >= iFIDFieldIndex)
+            if( psColDef->col_func == SWQCF_COUNT )
             {
-                if ( psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT )
+                /* psColDef->field_index can be -1 in the case of a COUNT(*) */
+                if( psColDef->field_index < 0 )
+                    psAgg->nCount++;
+                else if( IS_GEOM_FIELD_INDEX(poSrcDefn, psColDef->field_index) )
+                {
+                    int iSrcGeomField = ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(
+                            poSrcDefn, psColDef->field_index);
+                    if( poSrcFeature->GetGeomFieldRef(iSrcGeomField) != NULL )
+                        psAgg->nCount++;
+                }
+                else if( !poSrcFeature->IsFieldSet(psColDef->field_index) )
+                    /* nothing */;
+                else if( psColDef->distinct_flag )
                 {
-                    switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
+                    const char *pszVal =
+                        poSrcFeature->GetFieldAsString( psColDef->field_index );
+
+                    if( psAgg->hDistinct == NULL )
+                        psAgg->hDistinct = CPLHashSetNew( CPLHashSetHashStr,
+                                                          CPLHashSetEqualStr,
+                                                          CPLFree );
+                    if( CPLHashSetLookup( psAgg->hDistinct, pszVal ) == NULL )
                     {
-                      case SWQ_INTEGER:
-                        psDstField->Integer = poSrcFeat->GetFieldAsInteger(psKeyDef->field_index);
-                        break;
-
-                      case SWQ_FLOAT:
-                        psDstField->Real = poSrcFeat->GetFieldAsDouble(psKeyDef->field_index);
-                        break;
-
-                      default:
-                        psDstField->String = CPLStrdup( poSrcFeat->GetFieldAsString(psKeyDef->field_index) );
-                        break;
+                        CPLHashSetInsert( psAgg->hDistinct, CPLStrdup(pszVal) );
+                        nMemory += strlen(pszVal) + 1 + 4 * sizeof(void *);
                     }
                 }
-                continue;
+                else
+                    psAgg->nCount++;
             }
-            
-            poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
-                psKeyDef->field_index );
-
-            psSrcField = poSrcFeat->GetRawFieldRef( psKeyDef->field_index );
-
-            if( poFDefn->GetType() == OFTInteger 
-                || poFDefn->GetType() == OFTReal
-                || poFDefn->GetType() == OFTDate
-                || poFDefn->GetType() == OFTTime
-                || poFDefn->GetType() == OFTDateTime)
-                memcpy( psDstField, psSrcField, sizeof(OGRField) );
-            else if( poFDefn->GetType() == OFTString )
+            else if( poSrcFeature->IsFieldSet(psColDef->field_index) )
             {
-                if( poSrcFeat->IsFieldSet( psKeyDef->field_index ) )
-                    psDstField->String = CPLStrdup( psSrcField->String );
-                else
-                    memcpy( psDstField, psSrcField, sizeof(OGRField) );
+                const char *pszVal =
+                    poSrcFeature->GetFieldAsString( psColDef->field_index );
+
+                if( pszVal[0] != '\0' )
+                {
+                    double dfVal = CPLAtof(pszVal);
+
+                    psAgg->nCount++;
+                    psAgg->dfSum += dfVal;
+                    if( dfVal < psAgg->dfMin )
+                        psAgg->dfMin = dfVal;
+                    if( dfVal > psAgg->dfMax )
+                        psAgg->dfMax = dfVal;
+                }
             }
         }
 
-        panFIDList[nIndexSize] = poSrcFeat->GetFID();
-        delete poSrcFeat;
+        delete poSrcFeature;
 
-        nIndexSize++;
+        if( nMemory > nMaxMemory )
+        {
+            bOK = OGRGenSQLWriteGroupRun( psGroupBy, hGroups );
+            CPLHashSetDestroy( hGroups );
+            hGroups = CPLHashSetNew( OGRGenSQLGroupHash,
+                                     OGRGenSQLGroupEqual, NULL );
+            nMemory = 0;
+
+            OGRGenSQLGroupRun *pasRuns = psGroupBy->pasRuns;
+            while( bOK && psGroupBy->nRuns >= nMaxOpenRuns
+                   && pasRuns[psGroupBy->nRuns - nMaxOpenRuns].nLevel
+                      == pasRuns[psGroupBy->nRuns - 1].nLevel )
+            {
+                bOK = OGRGenSQLMergeLastGroupRuns( psGroupBy, nMaxOpenRuns );
+                nMerges++;
+            }
+        }
     }
 
-    //CPLDebug("GenSQL", "CreateOrderByIndex() = %d features", nIndexSize);
-
-/* -------------------------------------------------------------------- */
-/*      Initialize panFIDIndex                                          */
-/* -------------------------------------------------------------------- */
-    panFIDIndex = (long *) CPLMalloc(sizeof(long) * nIndexSize);
-    for( i = 0; i < nIndexSize; i++ )
-        panFIDIndex[i] = i;
-
-/* -------------------------------------------------------------------- */
-/*      Quick sort the records.                                         */
-/* -------------------------------------------------------------------- */
-    SortIndexSection( pasIndexFields, 0, nIndexSize );
+    OGRGenSQLFreeGroup( psLookup, 0 );
 
-/* -------------------------------------------------------------------- */
-/*      Rework the FID map to map to real FIDs.                         */
-/* -------------------------------------------------------------------- */
-    int bAlreadySorted = TRUE;
-    for( i = 0; i < nIndexSize; i++ )
+    if( !bOK )
     {
-        if (panFIDIndex[i] != i)
-            bAlreadySorted = FALSE;
-        panFIDIndex[i] = panFIDList[panFIDIndex[i]];
+        std::vector<OGRGenSQLGroup*> apsGroups;
+        CPLHashSetForeach( hGroups, OGRGenSQLCollectGroup, &apsGroups );
+        for( size_t j = 0; j < apsGroups.size(); j++ )
+            OGRGenSQLFreeGroup( apsGroups[j], nAggs );
+        CPLHashSetDestroy( hGroups );
+        FreeGroupBy();
+        return FALSE;
     }
 
-    CPLFree( panFIDList );
+    ClearFilters();
 
 /* -------------------------------------------------------------------- */
-/*      Free the key field values.                                      */
+/*      Everything fits in memory: sort the groups.                     */
 /* -------------------------------------------------------------------- */
-    for( int iKey = 0; iKey < nOrderItems; iKey++ )
+    if( psGroupBy->nRuns == 0 )
     {
-        swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
-        OGRFieldDefn *poFDefn;
+        std::vector<OGRGenSQLGroup*> apsGroups;
 
-        if ( psKeyDef->field_index >= iFIDFieldIndex &&
-            psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT )
-        {
-            /* warning: only special fields of type string should be deallocated */
-            if (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex] == SWQ_STRING)
-            {
-                for( i = 0; i < nIndexSize; i++ )
-                {
-                    OGRField *psField = pasIndexFields + iKey + i * nOrderItems;
-                    CPLFree( psField->String );
-                }
-            }
-            continue;
-        }
+        CPLHashSetForeach( hGroups, OGRGenSQLCollectGroup, &apsGroups );
+        std::sort( apsGroups.begin(), apsGroups.end(),
+                   OGRGenSQLGroupSorter( psGroupBy ) );
 
-        poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
-            psKeyDef->field_index );
+        psGroupBy->nGroups = (int) apsGroups.size();
+        psGroupBy->papsGroups = (OGRGenSQLGroup **)
+            CPLMalloc( sizeof(OGRGenSQLGroup *) * MAX(1,psGroupBy->nGroups) );
+        for( i = 0; i < psGroupBy->nGroups; i++ )
+            psGroupBy->papsGroups[i] = apsGroups[i];
+        psGroupBy->nGroupCount = psGroupBy->nGroups;
 
-        if( poFDefn->GetType() == OFTString )
-        {
-            for( i = 0; i < nIndexSize; i++ )
-            {
-                OGRField *psField = pasIndexFields + iKey + i * nOrderItems;
-                
-                if( psField->Set.nMarker1 != OGRUnsetMarker 
-                    || psField->Set.nMarker2 != OGRUnsetMarker )
-                    CPLFree( psField->String );
-            }
-        }
+        CPLHashSetDestroy( hGroups );
+        return TRUE;
     }
 
-    CPLFree( pasIndexFields );
+/* -------------------------------------------------------------------- */
+/*      Otherwise write the last run, and prepare the merge.            */
+/* -------------------------------------------------------------------- */
+    if( CPLHashSetSize( hGroups ) > 0 )
+        bOK = OGRGenSQLWriteGroupRun( psGroupBy, hGroups );
+    CPLHashSetDestroy( hGroups );
 
-    /* If it is already sorted, then free than panFIDIndex array */
-    /* so that GetNextFeature() can call a sequential GetNextFeature() */
-    /* on the source array. Very usefull for layers where random access */
-    /* is slow. */
-    /* Use case: the GML result of a WFS GetFeature with a SORTBY */
-    if (bAlreadySorted)
+    while( bOK && psGroupBy->nRuns > nMaxOpenRuns )
     {
-        CPLFree( panFIDIndex );
-        panFIDIndex = NULL;
+        bOK = OGRGenSQLMergeLastGroupRuns( psGroupBy,
+                    MIN(nMaxOpenRuns, psGroupBy->nRuns - nMaxOpenRuns + 1) );
+        nMerges++;
+    }
 
-        nIndexSize = 0;
+    if( !bOK )
+    {
+        FreeGroupBy();
+        return FALSE;
     }
 
-    ResetReading();
+    CPLDebug( "GenSQL",
+              "GROUP BY: merging %d sorted runs, after %d intermediate merges",
+              psGroupBy->nRuns, nMerges );
+
+    OGRGenSQLResetGroupMerge( psGroupBy );
+
+    return TRUE;
 }
 
 /************************************************************************/
-/*                          SortIndexSection()                          */
-/*                                                                      */
-/*      Sort the records in a section of the index.                     */
+/*                          GetGroupFeature()                           */
 /************************************************************************/
 
-void OGRGenSQLResultsLayer::SortIndexSection( OGRField *pasIndexFields, 
-                                              int nStart, int nEntries )
+OGRFeature *OGRGenSQLResultsLayer::GetGroupFeature( long nFID )
 
 {
-    if( nEntries < 2 )
-        return;
+    if( !PrepareSummary() || psGroupBy == NULL || nFID < 0 )
+        return NULL;
 
-    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
-    int      nOrderItems = psSelectInfo->order_specs;
+/* -------------------------------------------------------------------- */
+/*      Fetch the group, from memory or from the merge of the runs.     */
+/* -------------------------------------------------------------------- */
+    OGRGenSQLGroup *psGroup;
 
-    int nFirstGroup = nEntries / 2;
-    int nFirstStart = nStart;
-    int nSecondGroup = nEntries - nFirstGroup;
-    int nSecondStart = nStart + nFirstGroup;
-    int iMerge = 0;
-    long *panMerged;
+    if( psGroupBy->nRuns == 0 )
+    {
+        if( nFID >= psGroupBy->nGroups )
+            return NULL;
+        psGroup = psGroupBy->papsGroups[nFID];
+    }
+    else
+    {
+        if( nFID != psGroupBy->nMergeIndex )
+        {
+            OGRGenSQLResetGroupMerge( psGroupBy );
+            while( psGroupBy->nMergeIndex < nFID )
+            {
+                psGroup = OGRGenSQLGetNextGroup( psGroupBy );
+                if( psGroup == NULL )
+                    return NULL;
+                OGRGenSQLFreeGroup( psGroup, psGroupBy->nAggs );
+            }
+        }
 
-    SortIndexSection( pasIndexFields, nFirstStart, nFirstGroup );
-    SortIndexSection( pasIndexFields, nSecondStart, nSecondGroup );
+        psGroup = OGRGenSQLGetNextGroup( psGroupBy );
+        if( psGroup == NULL )
+            return NULL;
+    }
 
-    panMerged = (long *) CPLMalloc( sizeof(long) * nEntries );
-        
-    while( iMerge < nEntries )
+/* -------------------------------------------------------------------- */
+/*      Apply the keys and the column function results.                 */
+/* -------------------------------------------------------------------- */
+    for( int iField = 0; iField < psGroupBy->nAggs; iField++ )
     {
-        int  nResult;
+        swq_col_def *psColDef = psGroupBy->pasColDefs + iField;
+        OGRGenSQLGroupAgg *psAgg = psGroup->pasAggs + iField;
 
-        if( nFirstGroup == 0 )
-            nResult = -1;
-        else if( nSecondGroup == 0 )
-            nResult = 1;
-        else
-            nResult = Compare( pasIndexFields 
-                               + panFIDIndex[nFirstStart] * nOrderItems, 
-                               pasIndexFields 
-                               + panFIDIndex[nSecondStart] * nOrderItems );
+        poSummaryFeature->UnsetField( iField );
 
-        if( nResult < 0 )
+        if( psColDef->col_func == SWQCF_NONE )
         {
-            panMerged[iMerge++] = panFIDIndex[nSecondStart++];
-            nSecondGroup--;
+            int iKey = psGroupBy->panColumnKey[iField];
+            if( iKey >= 0 && psGroup->papszKeys[iKey] != NULL )
+                poSummaryFeature->SetField( iField, psGroup->papszKeys[iKey] );
         }
-        else
+        else if( psColDef->col_func == SWQCF_COUNT )
         {
-            panMerged[iMerge++] = panFIDIndex[nFirstStart++];
-            nFirstGroup--;
+            if( psAgg->hDistinct != NULL )
+                poSummaryFeature->SetField( iField,
+                                        CPLHashSetSize( psAgg->hDistinct ) );
+            else
+                poSummaryFeature->SetField( iField, psAgg->nCount );
         }
+        else if( psColDef->col_func == SWQCF_SUM )
+            poSummaryFeature->SetField( iField, psAgg->dfSum );
+        else if( psAgg->nCount == 0 )
+            /* leave unset */;
+        else if( psColDef->col_func == SWQCF_AVG )
+            poSummaryFeature->SetField( iField,
+                                        psAgg->dfSum / psAgg->nCount );
+        else if( psColDef->col_func == SWQCF_MIN )
+            poSummaryFeature->SetField( iField, psAgg->dfMin );
+        else if( psColDef->col_func == SWQCF_MAX )
+            poSummaryFeature->SetField( iField, psAgg->dfMax );
     }
 
-    /* Copy the merge list back into the main index */
+    poSummaryFeature->SetFID( nFID );
 
-    memcpy( panFIDIndex + nStart, panMerged, sizeof(long) * nEntries );
-    CPLFree( panMerged );
+    if( psGroupBy->nRuns > 0 )
+        OGRGenSQLFreeGroup( psGroup, psGroupBy->nAggs );
+
+    return poSummaryFeature->Clone();
 }
 
 /************************************************************************/
-/*                              Compare()                               */
+/*                           GetGroupCount()                            */
 /************************************************************************/
 
-int OGRGenSQLResultsLayer::Compare( OGRField *pasFirstTuple,
-                                    OGRField *pasSecondTuple )
+long OGRGenSQLResultsLayer::GetGroupCount()
 
 {
-    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
-    int  nResult = 0, iKey;
+    if( !PrepareSummary() || psGroupBy == NULL )
+        return 0;
 
-    for( iKey = 0; nResult == 0 && iKey < psSelectInfo->order_specs; iKey++ )
+    if( psGroupBy->nGroupCount < 0 )
     {
-        swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
-        OGRFieldDefn *poFDefn;
-
-        if( psKeyDef->field_index >= iFIDFieldIndex + SPECIAL_FIELD_COUNT )
-        {
-            CPLAssert( FALSE );
-            return 0;
-        }
-        else if( psKeyDef->field_index >= iFIDFieldIndex )
-            poFDefn = NULL;
-        else
-            poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
-                psKeyDef->field_index );
-        
-        if( (pasFirstTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
-             && pasFirstTuple[iKey].Set.nMarker2 == OGRUnsetMarker)
-            || (pasSecondTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
-                && pasSecondTuple[iKey].Set.nMarker2 == OGRUnsetMarker) )
-            nResult = 0;
-        else if ( poFDefn == NULL )
-        {
-            switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
-            {
-              case SWQ_INTEGER:
-                if( pasFirstTuple[iKey].Integer < pasSecondTuple[iKey].Integer )
-                    nResult = -1;
-                else if( pasFirstTuple[iKey].Integer > pasSecondTuple[iKey].Integer )
-                    nResult = 1;
-                break;
-              case SWQ_FLOAT:
-                if( pasFirstTuple[iKey].Real < pasSecondTuple[iKey].Real )
-                    nResult = -1;
-                else if( pasFirstTuple[iKey].Real > pasSecondTuple[iKey].Real )
-                    nResult = 1;
-                break;
-              case SWQ_STRING:
-                nResult = strcmp(pasFirstTuple[iKey].String,
-                                 pasSecondTuple[iKey].String);
-                break;
+        OGRGenSQLGroup *psGroup;
+        long nCount = 0;
 
-              default:
-                CPLAssert( FALSE );
-                nResult = 0;
-            }
-        }
-        else if( poFDefn->GetType() == OFTInteger )
-        {
-            if( pasFirstTuple[iKey].Integer < pasSecondTuple[iKey].Integer )
-                nResult = -1;
-            else if( pasFirstTuple[iKey].Integer 
-                     > pasSecondTuple[iKey].Integer )
-                nResult = 1;
-        }
-        else if( poFDefn->GetType() == OFTString )
-            nResult = strcmp(pasFirstTuple[iKey].String,
-                             pasSecondTuple[iKey].String);
-        else if( poFDefn->GetType() == OFTReal )
+        OGRGenSQLResetGroupMerge( psGroupBy );
+        while( (psGroup = OGRGenSQLGetNextGroup( psGroupBy )) != NULL )
         {
-            if( pasFirstTuple[iKey].Real < pasSecondTuple[iKey].Real )
-                nResult = -1;
-            else if( pasFirstTuple[iKey].Real > pasSecondTuple[iKey].Real )
-                nResult = 1;
-        }
-        else if( poFDefn->GetType() == OFTDate ||
-                 poFDefn->GetType() == OFTTime ||
-                 poFDefn->GetType() == OFTDateTime)
-        {
-            nResult = OGRCompareDate(&pasFirstTuple[iKey],
-                                     &pasSecondTuple[iKey]);
+            OGRGenSQLFreeGroup( psGroup, psGroupBy->nAggs );
+            nCount++;
         }
-
-        if( psKeyDef->ascending_flag )
-            nResult *= -1;
+        psGroupBy->nGroupCount = nCount;
     }
 
-    return nResult;
+    return psGroupBy->nGroupCount;
 }
 
+/************************************************************************/
+/*                            FreeGroupBy()                             */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::FreeGroupBy()
+
+{
+    if( psGroupBy == NULL )
+        return;
+
+    for( int i = 0; i < psGroupBy->nGroups; i++ )
+        OGRGenSQLFreeGroup( psGroupBy->papsGroups[i], psGroupBy->nAggs );
+    CPLFree( psGroupBy->papsGroups );
+
+    for( int iRun = 0; iRun < psGroupBy->nRuns; iRun++ )
+        OGRGenSQLFreeGroupRun( psGroupBy, psGroupBy->pasRuns + iRun );
+    CPLFree( psGroupBy->pasRuns );
+
+    CPLFree( psGroupBy->paeKeyTypes );
+    CPLFree( psGroupBy->panKeyOrder );
+    CPLFree( psGroupBy->pabKeyAscending );
+    CPLFree( psGroupBy->panColumnKey );
+    CPLFree( psGroupBy );
+    psGroupBy = NULL;
+}
 
 /************************************************************************/
 /*                         AddFieldDefnToSet()                          */
@@ -1950,6 +4419,12 @@ void OGRGenSQLResultsLayer::FindAndSetIgnoredFields()
         AddFieldDefnToSet(psOrderDef->table_index, psOrderDef->field_index, hSet);
     }
 
+    for( int iGroup = 0; iGroup < psSelectInfo->group_by_count; iGroup++ )
+    {
+        swq_group_def *psGroupDef = psSelectInfo->group_by_defs + iGroup;
+        AddFieldDefnToSet(psGroupDef->table_index, psGroupDef->field_index, hSet);
+    }
+
 /* -------------------------------------------------------------------- */
 /*      2nd phase : now, we can exclude the unused fields               */
 /* -------------------------------------------------------------------- */
@@ -1985,6 +4460,20 @@ void OGRGenSQLResultsLayer::InvalidateOrderByIndex()
     CPLFree( panFIDIndex );
     panFIDIndex = NULL;
 
+    if( papoSortedFeatures != NULL )
+    {
+        for( int i = 0; i < nIndexSize; i++ )
+            delete papoSortedFeatures[i];
+        CPLFree( papoSortedFeatures );
+        papoSortedFeatures = NULL;
+    }
+
+    for( int iRun = 0; iRun < nSortRuns; iRun++ )
+        FreeSortRun( pasSortRuns + iRun );
+    CPLFree( pasSortRuns );
+    pasSortRuns = NULL;
+    nSortRuns = 0;
+
     nIndexSize = 0;
     bOrderByValid = FALSE;
 }
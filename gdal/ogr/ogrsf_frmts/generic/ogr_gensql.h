@@ -44,6 +44,10 @@
 #define ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(poFDefn, idx) \
     ((idx) - ((poFDefn)->GetFieldCount() + SPECIAL_FIELD_COUNT))
 
+typedef struct _OGRGenSQLJoinHash OGRGenSQLJoinHash;
+typedef struct _OGRGenSQLSortRun OGRGenSQLSortRun;
+typedef struct _OGRGenSQLGroupBy OGRGenSQLGroupBy;
+
 /************************************************************************/
 /*                        OGRGenSQLResultsLayer                         */
 /************************************************************************/
@@ -77,9 +81,26 @@ class CPL_DLL OGRGenSQLResultsLayer : public OGRLayer
     int         nExtraDSCount;
     OGRDataSource **papoExtraDS;
 
+    OGRFeature **papoSortedFeatures;
+    int         nSortRuns;
+    OGRGenSQLSortRun *pasSortRuns;
+
     OGRFeature *TranslateFeature( OGRFeature * );
     void        CreateOrderByIndex();
-    void        SortIndexSection( OGRField *pasIndexFields, 
+    int         CreateFIDOrderByIndex( GIntBig nMaxMemory );
+    void        CreateSortedFeatures( GIntBig nMaxMemory );
+    int         WriteSortRun( OGRFeature **papoFeatures,
+                              OGRField *pasKeys, int nEntries );
+    int         MergeLastSortRuns( int nRuns );
+    int         OpenSortRun( OGRGenSQLSortRun *psRun );
+    void        ReadSortRunHead( OGRGenSQLSortRun *psRun );
+    void        FreeSortRun( OGRGenSQLSortRun *psRun );
+    void        ResetSortMerge();
+    void        SeekSortMerge( long nIndex );
+    OGRFeature *GetNextSortedFeature( OGRGenSQLSortRun *pasRuns, int nRuns );
+    int         GetOrderByKeys( OGRFeature *poSrcFeat, OGRField *pasKeys );
+    void        FreeOrderByKeys( OGRField *pasKeys, int nEntries );
+    void        SortIndexSection( OGRField *pasIndexFields, long *panIndex,
                                   int nStart, int nEntries );
     int         Compare( OGRField *pasFirst, OGRField *pasSecond );
 
@@ -96,6 +117,19 @@ class CPL_DLL OGRGenSQLResultsLayer : public OGRLayer
     
     int         MustEvaluateSpatialFilterOnGenSQL();
 
+    OGRGenSQLJoinHash **papsJoinHash;
+    OGRGenSQLJoinHash *BuildJoinHash( int iJoin );
+    int         FetchJoinFeatureFromHash( int iJoin, OGRFeature *poSrcFeat,
+                                          OGRFeature **ppoJoinFeature,
+                                          int *pbOwned );
+    void        FreeJoinHashes();
+
+    OGRGenSQLGroupBy *psGroupBy;
+    int         PrepareGroupBy();
+    OGRFeature *GetGroupFeature( long nFID );
+    long        GetGroupCount();
+    void        FreeGroupBy();
+
   public:
                 OGRGenSQLResultsLayer( OGRDataSource *poSrcDS, 
                                        void *pSelectInfo,
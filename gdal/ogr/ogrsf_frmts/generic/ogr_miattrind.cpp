@@ -60,6 +60,8 @@ public:
     long        GetFirstMatch( OGRField *psKey );
     long       *GetAllMatches( OGRField *psKey );
     long       *GetAllMatches( OGRField *psKey, long* panFIDList, int* nFIDCount, int* nLength );
+    long       *GetRangeMatches( OGRField *psMinKey, OGRField *psMaxKey,
+                                 long* panFIDList, int* nFIDCount, int* nLength );
 
     OGRErr      AddEntry( OGRField *psKey, long nFID );
     OGRErr      RemoveEntry( OGRField *psKey, long nFID );
@@ -810,6 +812,125 @@ long *OGRMIAttrIndex::GetAllMatches( OGRField *psKey )
     return GetAllMatches( psKey, NULL, &nFIDCount, &nLength );
 }
 
+/************************************************************************/
+/*                          GetRangeMatches()                           */
+/*                                                                      */
+/*      The .ind keys are compared byte by byte.                        */
+/*                                                                      */
+/*      Integer keys of non negative values sort like the values.       */
+/*      TABINDFile::BuildKey() encodes negative values byte per byte    */
+/*      with truncating divisions, so that their keys are scattered    */
+/*      among the ones of small positive values (-1 and 255 share the   */
+/*      same key): ranges including negative values are not supported,  */
+/*      and the other ones may return a few negative values too, which  */
+/*      the query evaluation filters out.                               */
+/*                                                                      */
+/*      Real keys are built from the negated value, so negative values  */
+/*      sort in reverse order before the positive ones, and a range     */
+/*      crossing zero maps to two ranges of keys.                       */
+/*                                                                      */
+/*      String keys are upper-cased, which does not preserve the        */
+/*      ordering, so ranges are not supported on them.                  */
+/************************************************************************/
+
+long *OGRMIAttrIndex::GetRangeMatches( OGRField *psMinKey, OGRField *psMaxKey,
+                                       long* panFIDList, int* nFIDCount,
+                                       int* nLength )
+{
+    GByte abyMinKeys[2][8], abyMaxKeys[2][8];
+    int   nRanges = 0;
+
+    switch( poFldDefn->GetType() )
+    {
+      case OFTInteger:
+      {
+          GInt32 nMin = psMinKey ? psMinKey->Integer : INT_MIN;
+          GInt32 nMax = psMaxKey ? psMaxKey->Integer : INT_MAX;
+
+          if( nMin > nMax )
+              break;
+          if( nMin < 0 )
+              return NULL;
+
+          memcpy( abyMinKeys[0], poINDFile->BuildKey( iIndex, nMin ), 4 );
+          memcpy( abyMaxKeys[0], poINDFile->BuildKey( iIndex, nMax ), 4 );
+          nRanges = 1;
+          break;
+      }
+
+      case OFTReal:
+      {
+          double dfMin = psMinKey ? psMinKey->Real : -HUGE_VAL;
+          double dfMax = psMaxKey ? psMaxKey->Real : HUGE_VAL;
+
+          if( CPLIsNan(dfMin) || CPLIsNan(dfMax) || dfMin > dfMax )
+              break;
+
+          /* Positive values and +0.0, in increasing key order */
+          if( dfMax >= 0.0 )
+          {
+              double dfPosMin = (dfMin > 0.0) ? dfMin : 0.0;
+              double dfPosMax = (dfMax == 0.0) ? 0.0 : dfMax;
+              memcpy( abyMinKeys[nRanges],
+                      poINDFile->BuildKey( iIndex, dfPosMin ), 8 );
+              memcpy( abyMaxKeys[nRanges],
+                      poINDFile->BuildKey( iIndex, dfPosMax ), 8 );
+              nRanges ++;
+          }
+
+          /* Negative values and -0.0, in decreasing key order */
+          if( dfMin <= 0.0 )
+          {
+              double dfNegMin = (dfMin == 0.0) ? -0.0 : dfMin;
+              double dfNegMax = (dfMax < 0.0) ? dfMax : -0.0;
+              memcpy( abyMinKeys[nRanges],
+                      poINDFile->BuildKey( iIndex, dfNegMax ), 8 );
+              memcpy( abyMaxKeys[nRanges],
+                      poINDFile->BuildKey( iIndex, dfNegMin ), 8 );
+              nRanges ++;
+          }
+          break;
+      }
+
+      default:
+        return NULL;
+    }
+
+    if (panFIDList == NULL)
+    {
+        panFIDList = (long *) CPLMalloc(sizeof(long) * 2);
+        *nFIDCount = 0;
+        *nLength = 2;
+    }
+
+    for( int iRange = 0; iRange < nRanges; iRange++ )
+    {
+        long nFID = poINDFile->FindFirstInRange( iIndex, abyMinKeys[iRange],
+                                                 abyMaxKeys[iRange] );
+        while( nFID > 0 )
+        {
+            if( *nFIDCount >= *nLength-1 )
+            {
+                *nLength = (*nLength) * 2 + 10;
+                panFIDList = (long *) CPLRealloc(panFIDList, sizeof(long)* (*nLength));
+            }
+            panFIDList[(*nFIDCount)++] = nFID - 1;
+
+            nFID = poINDFile->FindNextInRange( iIndex, abyMaxKeys[iRange] );
+        }
+
+        if( nFID < 0 )
+        {
+            CPLFree( panFIDList );
+            return NULL;
+        }
+    }
+
+    panFIDList[*nFIDCount] = OGRNullFID;
+
+    return panFIDList;
+}
+
 /************************************************************************/
 /*                               Clear()                                */
 /************************************************************************/
@@ -0,0 +1,669 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Implementation of OGRLayerSpatialIndex, a packed Hilbert R-tree
+ *           persisted as a sidecar file.
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_spatialind.h"
+#include "cpl_conv.h"
+#include "cpl_vsi.h"
+
+#include <vector>
+#include <algorithm>
+
+CPL_CVSID("$Id$");
+
+/*
+ * Sidecar file layout, all values little endian:
+ *
+ *   8 bytes    signature "OGRSIDX1"
+ *   int32      node size (maximum number of children of a node)
+ *   int32      number of indexed features
+ *   int64      size of the data file when the index was built
+ *   int64      modification time of the data file when the index was built
+ *   double[4]  MinX, MinY, MaxX, MaxY of every node, leaves first in
+ *              Hilbert order, then each upper level, the root last.
+ *   int64      FID of every leaf, in the same order as the leaves.
+ */
+
+#define OGRSIDX_SIGNATURE   "OGRSIDX1"
+#define OGRSIDX_HEADER_SIZE 32
+
+/************************************************************************/
+/*                          OGRHilbertCode()                            */
+/*                                                                      */
+/*      Position of (nX, nY) along the Hilbert curve filling a          */
+/*      65536x65536 grid.                                               */
+/************************************************************************/
+
+static GUInt32 OGRHilbertCode( GUInt32 nX, GUInt32 nY )
+
+{
+    const GUInt32 nGridSize = 65536;
+    GUInt32 nCode = 0;
+
+    for( GUInt32 nStep = nGridSize / 2; nStep > 0; nStep /= 2 )
+    {
+        GUInt32 nRX = (nX & nStep) ? 1 : 0;
+        GUInt32 nRY = (nY & nStep) ? 1 : 0;
+
+        nCode += nStep * nStep * ((3 * nRX) ^ nRY);
+
+        /* Rotate the quadrant so that the sub-curve has the right */
+        /* orientation. */
+        if( nRY == 0 )
+        {
+            if( nRX == 1 )
+            {
+                nX = nGridSize - 1 - nX;
+                nY = nGridSize - 1 - nY;
+            }
+            GUInt32 nTmp = nX;
+            nX = nY;
+            nY = nTmp;
+        }
+    }
+
+    return nCode;
+}
+
+/************************************************************************/
+/*                        OGRLayerSpatialIndex()                        */
+/************************************************************************/
+
+OGRLayerSpatialIndex::OGRLayerSpatialIndex()
+
+{
+    poLayer = NULL;
+    pszDataFilename = NULL;
+    pszIndexFilename = NULL;
+
+    nNodeSize = 0;
+    nItemCount = 0;
+    nLevelCount = 0;
+    panLevelStart = NULL;
+    padfBoxes = NULL;
+    panItemFIDs = NULL;
+}
+
+/************************************************************************/
+/*                       ~OGRLayerSpatialIndex()                        */
+/************************************************************************/
+
+OGRLayerSpatialIndex::~OGRLayerSpatialIndex()
+
+{
+    Clear();
+    CPLFree( pszDataFilename );
+    CPLFree( pszIndexFilename );
+}
+
+/************************************************************************/
+/*                               Clear()                                */
+/************************************************************************/
+
+void OGRLayerSpatialIndex::Clear()
+
+{
+    CPLFree( panLevelStart );
+    panLevelStart = NULL;
+    CPLFree( padfBoxes );
+    padfBoxes = NULL;
+    CPLFree( panItemFIDs );
+    panItemFIDs = NULL;
+
+    nNodeSize = 0;
+    nItemCount = 0;
+    nLevelCount = 0;
+}
+
+/************************************************************************/
+/*                           ComputeLevels()                            */
+/*                                                                      */
+/*      Compute the offset of each level of the tree in padfBoxes       */
+/*      from nItemCount and nNodeSize.  panLevelStart[nLevelCount]      */
+/*      is the total number of nodes.                                   */
+/************************************************************************/
+
+void OGRLayerSpatialIndex::ComputeLevels()
+
+{
+    std::vector<int> anLevelStart;
+    int nCount = nItemCount;
+    int nOffset = 0;
+
+    anLevelStart.push_back( 0 );
+    do
+    {
+        nOffset += nCount;
+        anLevelStart.push_back( nOffset );
+        nCount = (nCount + nNodeSize - 1) / nNodeSize;
+    } while( anLevelStart.size() < 2
+             || anLevelStart[anLevelStart.size()-1]
+                - anLevelStart[anLevelStart.size()-2] > 1 );
+
+    nLevelCount = (int) anLevelStart.size() - 1;
+    CPLFree( panLevelStart );
+    panLevelStart = (int *) CPLMalloc( sizeof(int) * anLevelStart.size() );
+    for( size_t i = 0; i < anLevelStart.size(); i++ )
+        panLevelStart[i] = anLevelStart[i];
+}
+
+/************************************************************************/
+/*                             Initialize()                             */
+/*                                                                      */
+/*      Remember the layer and the name of its data file, and load      */
+/*      the sidecar index if there is an up to date one.                */
+/************************************************************************/
+
+OGRErr OGRLayerSpatialIndex::Initialize( const char *pszDataFilenameIn,
+                                         OGRLayer *poLayerIn )
+
+{
+    if( poLayerIn == poLayer )
+        return OGRERR_NONE;
+
+    poLayer = poLayerIn;
+
+    CPLFree( pszDataFilename );
+    pszDataFilename = CPLStrdup( pszDataFilenameIn );
+    CPLFree( pszIndexFilename );
+    pszIndexFilename = CPLStrdup( CPLSPrintf( "%s.ogrsidx",
+                                              pszDataFilenameIn ) );
+
+    VSIStatBufL sStat;
+
+    /* A damaged index is reported but does not prevent using the layer. */
+    if( VSIStatL( pszIndexFilename, &sStat ) == 0 )
+        Load();
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                                Load()                                */
+/************************************************************************/
+
+OGRErr OGRLayerSpatialIndex::Load()
+
+{
+    Clear();
+
+    VSILFILE *fp = VSIFOpenL( pszIndexFilename, "rb" );
+    if( fp == NULL )
+        return OGRERR_NONE;
+
+/* -------------------------------------------------------------------- */
+/*      Read and check the header.                                      */
+/* -------------------------------------------------------------------- */
+    GByte abyHeader[OGRSIDX_HEADER_SIZE];
+    GInt32 nNodeSizeIn, nItemCountIn;
+    GIntBig nDataSize, nDataMTime;
+
+    if( VSIFReadL( abyHeader, OGRSIDX_HEADER_SIZE, 1, fp ) != 1
+        || memcmp( abyHeader, OGRSIDX_SIGNATURE, 8 ) != 0 )
+    {
+        VSIFCloseL( fp );
+        CPLError( CE_Warning, CPLE_AppDefined,
+                  "%s is not a valid spatial index file.",
+                  pszIndexFilename );
+        return OGRERR_CORRUPT_DATA;
+    }
+
+    memcpy( &nNodeSizeIn, abyHeader + 8, 4 );
+    CPL_LSBPTR32( &nNodeSizeIn );
+    memcpy( &nItemCountIn, abyHeader + 12, 4 );
+    CPL_LSBPTR32( &nItemCountIn );
+    memcpy( &nDataSize, abyHeader + 16, 8 );
+    CPL_LSBPTR64( &nDataSize );
+    memcpy( &nDataMTime, abyHeader + 24, 8 );
+    CPL_LSBPTR64( &nDataMTime );
+
+    if( nNodeSizeIn < 2 || nNodeSizeIn > 65535 || nItemCountIn < 0 )
+    {
+        VSIFCloseL( fp );
+        CPLError( CE_Warning, CPLE_AppDefined,
+                  "%s is not a valid spatial index file.",
+                  pszIndexFilename );
+        return OGRERR_CORRUPT_DATA;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      An index built against another version of the data file         */
+/*      would return wrong FIDs, so just ignore it.                     */
+/* -------------------------------------------------------------------- */
+    VSIStatBufL sStat;
+
+    if( VSIStatL( pszDataFilename, &sStat ) != 0
+        || (GIntBig) sStat.st_size != nDataSize
+        || (GIntBig) sStat.st_mtime != nDataMTime )
+    {
+        VSIFCloseL( fp );
+        CPLDebug( "OGR", "%s is out of date, ignoring it.",
+                  pszIndexFilename );
+        return OGRERR_NONE;
+    }
+
+    if( nItemCountIn == 0 )
+    {
+        VSIFCloseL( fp );
+        return OGRERR_NONE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Read the nodes and FIDs.                                        */
+/* -------------------------------------------------------------------- */
+    nNodeSize = nNodeSizeIn;
+    nItemCount = nItemCountIn;
+    ComputeLevels();
+
+    int nNodeCount = panLevelStart[nLevelCount];
+    padfBoxes = (double *)
+        VSIMalloc2( nNodeCount, 4 * sizeof(double) );
+    panItemFIDs = (GIntBig *) VSIMalloc2( nItemCount, sizeof(GIntBig) );
+
+    if( padfBoxes == NULL || panItemFIDs == NULL
+        || (int) VSIFReadL( padfBoxes, 4 * sizeof(double), nNodeCount, fp )
+                                                            != nNodeCount
+        || (int) VSIFReadL( panItemFIDs, sizeof(GIntBig), nItemCount, fp )
+                                                            != nItemCount )
+    {
+        VSIFCloseL( fp );
+        Clear();
+        CPLError( CE_Warning, CPLE_AppDefined,
+                  "Failed to read spatial index %s.", pszIndexFilename );
+        return OGRERR_CORRUPT_DATA;
+    }
+
+    VSIFCloseL( fp );
+
+#ifdef CPL_MSB
+    for( int i = 0; i < 4 * nNodeCount; i++ )
+        CPL_SWAPDOUBLE( padfBoxes + i );
+    for( int i = 0; i < nItemCount; i++ )
+        CPL_SWAP64PTR( panItemFIDs + i );
+#endif
+
+    CPLDebug( "OGR", "Loaded spatial index %s (%d features).",
+              pszIndexFilename, nItemCount );
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                                Save()                                */
+/************************************************************************/
+
+OGRErr OGRLayerSpatialIndex::Save( GIntBig nDataSize, GIntBig nDataMTime )
+
+{
+    VSILFILE *fp = VSIFOpenL( pszIndexFilename, "wb" );
+    if( fp == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OpenFailed,
+                  "Failed to create %s.", pszIndexFilename );
+        return OGRERR_FAILURE;
+    }
+
+    GByte abyHeader[OGRSIDX_HEADER_SIZE];
+    GInt32 nTmp32;
+
+    memcpy( abyHeader, OGRSIDX_SIGNATURE, 8 );
+    nTmp32 = nNodeSize;
+    CPL_LSBPTR32( &nTmp32 );
+    memcpy( abyHeader + 8, &nTmp32, 4 );
+    nTmp32 = nItemCount;
+    CPL_LSBPTR32( &nTmp32 );
+    memcpy( abyHeader + 12, &nTmp32, 4 );
+    CPL_LSBPTR64( &nDataSize );
+    memcpy( abyHeader + 16, &nDataSize, 8 );
+    CPL_LSBPTR64( &nDataMTime );
+    memcpy( abyHeader + 24, &nDataMTime, 8 );
+
+    int bOK = VSIFWriteL( abyHeader, OGRSIDX_HEADER_SIZE, 1, fp ) == 1;
+
+    int nNodeCount = (nItemCount > 0) ? panLevelStart[nLevelCount] : 0;
+
+#ifdef CPL_MSB
+    for( int i = 0; i < 4 * nNodeCount; i++ )
+        CPL_SWAPDOUBLE( padfBoxes + i );
+    for( int i = 0; i < nItemCount; i++ )
+        CPL_SWAP64PTR( panItemFIDs + i );
+#endif
+
+    if( nItemCount > 0 )
+    {
+        bOK &= (int) VSIFWriteL( padfBoxes, 4 * sizeof(double), nNodeCount,
+                                 fp ) == nNodeCount;
+        bOK &= (int) VSIFWriteL( panItemFIDs, sizeof(GIntBig), nItemCount,
+                                 fp ) == nItemCount;
+    }
+
+#ifdef CPL_MSB
+    for( int i = 0; i < 4 * nNodeCount; i++ )
+        CPL_SWAPDOUBLE( padfBoxes + i );
+    for( int i = 0; i < nItemCount; i++ )
+        CPL_SWAP64PTR( panItemFIDs + i );
+#endif
+
+    if( VSIFCloseL( fp ) != 0 )
+        bOK = FALSE;
+
+    if( !bOK )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Failed to write %s.", pszIndexFilename );
+        VSIUnlink( pszIndexFilename );
+        return OGRERR_FAILURE;
+    }
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                          IndexAllFeatures()                          */
+/*                                                                      */
+/*      Read the whole layer, with its filters suspended, sort the      */
+/*      feature envelopes along the Hilbert curve, pack them in         */
+/*      nodes of nNodeSizeIn entries and write the tree.                */
+/************************************************************************/
+
+OGRErr OGRLayerSpatialIndex::IndexAllFeatures( int nNodeSizeIn )
+
+{
+    if( poLayer == NULL )
+        return OGRERR_FAILURE;
+
+    if( nNodeSizeIn < 2 || nNodeSizeIn > 65535 )
+    {
+        CPLError( CE_Failure, CPLE_IllegalArg,
+                  "Invalid spatial index node size : %d", nNodeSizeIn );
+        return OGRERR_FAILURE;
+    }
+
+    Clear();
+
+    VSIStatBufL sStat;
+    if( VSIStatL( pszDataFilename, &sStat ) != 0 )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot stat %s.", pszDataFilename );
+        return OGRERR_FAILURE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Suspend the filters of the layer while reading it.              */
+/* -------------------------------------------------------------------- */
+    OGRGeometry *poSavedFilterGeom = NULL;
+    int iSavedGeomFieldFilter = poLayer->m_iGeomFieldFilter;
+    OGRFeatureQuery *poSavedAttrQuery = poLayer->m_poAttrQuery;
+
+    if( poLayer->GetSpatialFilter() != NULL )
+    {
+        poSavedFilterGeom = poLayer->GetSpatialFilter()->clone();
+        poLayer->SetSpatialFilter( NULL );
+    }
+    poLayer->m_poAttrQuery = NULL;
+
+/* -------------------------------------------------------------------- */
+/*      Collect the envelope and FID of each feature.                   */
+/* -------------------------------------------------------------------- */
+    std::vector<OGREnvelope> asEnvelopes;
+    std::vector<GIntBig> anFIDs;
+    OGREnvelope sExtent;
+    OGRFeature *poFeature;
+    OGRErr eErr = OGRERR_NONE;
+
+    poLayer->ResetReading();
+    while( (poFeature = poLayer->GetNextFeature()) != NULL )
+    {
+        OGREnvelope sEnvelope;
+
+        if( poFeature->GetGeomFieldEnvelope( 0, &sEnvelope ) == OGRERR_NONE )
+        {
+            if( poFeature->GetFID() == OGRNullFID )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined,
+                          "Layer %s does not have feature ids, "
+                          "cannot build a spatial index.",
+                          poLayer->GetName() );
+                eErr = OGRERR_FAILURE;
+                delete poFeature;
+                break;
+            }
+
+            asEnvelopes.push_back( sEnvelope );
+            anFIDs.push_back( poFeature->GetFID() );
+            sExtent.Merge( sEnvelope );
+        }
+
+        delete poFeature;
+    }
+
+    poLayer->m_poAttrQuery = poSavedAttrQuery;
+    if( poSavedFilterGeom != NULL )
+    {
+        poLayer->SetSpatialFilter( iSavedGeomFieldFilter, poSavedFilterGeom );
+        delete poSavedFilterGeom;
+    }
+    poLayer->ResetReading();
+
+    if( eErr != OGRERR_NONE )
+        return eErr;
+
+    if( asEnvelopes.size() > (size_t) INT_MAX )
+    {
+        CPLError( CE_Failure, CPLE_NotSupported,
+                  "Too many features to build a spatial index." );
+        return OGRERR_FAILURE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Sort the items by the Hilbert code of their center.             */
+/* -------------------------------------------------------------------- */
+    nNodeSize = nNodeSizeIn;
+    nItemCount = (int) asEnvelopes.size();
+
+    if( nItemCount > 0 )
+    {
+        std::vector< std::pair<GUInt32, int> > aoSorted( nItemCount );
+        double dfWidth = sExtent.MaxX - sExtent.MinX;
+        double dfHeight = sExtent.MaxY - sExtent.MinY;
+        int i;
+
+        for( i = 0; i < nItemCount; i++ )
+        {
+            const OGREnvelope &sEnv = asEnvelopes[i];
+            GUInt32 nX = 0, nY = 0;
+
+            if( dfWidth > 0 )
+                nX = (GUInt32) (65535 * ((sEnv.MinX + sEnv.MaxX) / 2
+                                         - sExtent.MinX) / dfWidth);
+            if( dfHeight > 0 )
+                nY = (GUInt32) (65535 * ((sEnv.MinY + sEnv.MaxY) / 2
+                                         - sExtent.MinY) / dfHeight);
+
+            aoSorted[i].first = OGRHilbertCode( nX, nY );
+            aoSorted[i].second = i;
+        }
+
+        std::sort( aoSorted.begin(), aoSorted.end() );
+
+/* -------------------------------------------------------------------- */
+/*      Fill the leaves, then each upper level from the one below.      */
+/* -------------------------------------------------------------------- */
+        ComputeLevels();
+
+        padfBoxes = (double *)
+            VSIMalloc2( panLevelStart[nLevelCount], 4 * sizeof(double) );
+        panItemFIDs = (GIntBig *) VSIMalloc2( nItemCount, sizeof(GIntBig) );
+        if( padfBoxes == NULL || panItemFIDs == NULL )
+        {
+            Clear();
+            CPLError( CE_Failure, CPLE_OutOfMemory,
+                      "Cannot allocate spatial index." );
+            return OGRERR_NOT_ENOUGH_MEMORY;
+        }
+
+        for( i = 0; i < nItemCount; i++ )
+        {
+            const OGREnvelope &sEnv = asEnvelopes[aoSorted[i].second];
+
+            padfBoxes[4*i+0] = sEnv.MinX;
+            padfBoxes[4*i+1] = sEnv.MinY;
+            padfBoxes[4*i+2] = sEnv.MaxX;
+            padfBoxes[4*i+3] = sEnv.MaxY;
+            panItemFIDs[i] = anFIDs[aoSorted[i].second];
+        }
+
+        for( int iLevel = 1; iLevel < nLevelCount; iLevel++ )
+        {
+            int nChildStart = panLevelStart[iLevel-1];
+            int nChildEnd = panLevelStart[iLevel];
+
+            for( int iNode = panLevelStart[iLevel];
+                 iNode < panLevelStart[iLevel+1]; iNode++ )
+            {
+                int iChild = nChildStart
+                    + (iNode - panLevelStart[iLevel]) * nNodeSize;
+                int iChildEnd = MIN(iChild + nNodeSize, nChildEnd);
+                double *padfNode = padfBoxes + 4 * iNode;
+
+                memcpy( padfNode, padfBoxes + 4 * iChild,
+                        4 * sizeof(double) );
+                for( iChild++; iChild < iChildEnd; iChild++ )
+                {
+                    const double *padfChild = padfBoxes + 4 * iChild;
+
+                    padfNode[0] = MIN(padfNode[0], padfChild[0]);
+                    padfNode[1] = MIN(padfNode[1], padfChild[1]);
+                    padfNode[2] = MAX(padfNode[2], padfChild[2]);
+                    padfNode[3] = MAX(padfNode[3], padfChild[3]);
+                }
+            }
+        }
+    }
+
+    eErr = Save( (GIntBig) sStat.st_size, (GIntBig) sStat.st_mtime );
+    if( eErr != OGRERR_NONE )
+        Clear();
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                             DropIndex()                              */
+/************************************************************************/
+
+OGRErr OGRLayerSpatialIndex::DropIndex()
+
+{
+    VSIStatBufL sStat;
+
+    Clear();
+
+    if( VSIStatL( pszIndexFilename, &sStat ) != 0 )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Layer %s has no spatial index.", poLayer->GetName() );
+        return OGRERR_FAILURE;
+    }
+
+    if( VSIUnlink( pszIndexFilename ) != 0 )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Failed to delete %s.", pszIndexFilename );
+        return OGRERR_FAILURE;
+    }
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                             GetMatches()                             */
+/*                                                                      */
+/*      Return the FIDs of the features whose envelope intersects       */
+/*      psEnvelope, in increasing order and terminated by               */
+/*      OGRNullFID, or NULL if the index is not built.  The list        */
+/*      should be freed with CPLFree().                                 */
+/************************************************************************/
+
+long *OGRLayerSpatialIndex::GetMatches( const OGREnvelope *psEnvelope,
+                                        int *pnFIDCount )
+
+{
+    if( !IsBuilt() )
+        return NULL;
+
+    std::vector<GIntBig> anMatches;
+    std::vector< std::pair<int,int> > aoStack;   /* (level, node) */
+
+    aoStack.push_back( std::pair<int,int>( nLevelCount - 1,
+                                           panLevelStart[nLevelCount-1] ) );
+
+    while( !aoStack.empty() )
+    {
+        int iLevel = aoStack.back().first;
+        int iNode = aoStack.back().second;
+        const double *padfNode = padfBoxes + 4 * iNode;
+
+        aoStack.pop_back();
+
+        if( padfNode[2] < psEnvelope->MinX
+            || padfNode[3] < psEnvelope->MinY
+            || padfNode[0] > psEnvelope->MaxX
+            || padfNode[1] > psEnvelope->MaxY )
+            continue;
+
+        if( iLevel == 0 )
+        {
+            anMatches.push_back( panItemFIDs[iNode] );
+            continue;
+        }
+
+        int iChild = panLevelStart[iLevel-1]
+            + (iNode - panLevelStart[iLevel]) * nNodeSize;
+        int iChildEnd = MIN(iChild + nNodeSize, panLevelStart[iLevel]);
+
+        for( ; iChild < iChildEnd; iChild++ )
+            aoStack.push_back( std::pair<int,int>( iLevel - 1, iChild ) );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Sorted FIDs let sequential drivers move forward only.           */
+/* -------------------------------------------------------------------- */
+    std::sort( anMatches.begin(), anMatches.end() );
+
+    long *panFIDs = (long *)
+        CPLMalloc( sizeof(long) * (anMatches.size() + 1) );
+    for( size_t i = 0; i < anMatches.size(); i++ )
+        panFIDs[i] = (long) anMatches[i];
+    panFIDs[anMatches.size()] = OGRNullFID;
+
+    if( pnFIDCount != NULL )
+        *pnFIDCount = (int) anMatches.size();
+
+    return panFIDs;
+}
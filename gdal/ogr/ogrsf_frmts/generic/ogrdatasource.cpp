@@ -33,6 +33,7 @@
 #include "ogr_p.h"
 #include "ogr_gensql.h"
 #include "ogr_attrind.h"
+#include "ogr_spatialind.h"
 #include "cpl_multiproc.h"
 #include "ogrunionlayer.h"
 
@@ -799,6 +800,116 @@ OGRErr OGRDataSource::ProcessSQLDropIndex( const char *pszSQLCommand )
     return eErr;
 }
 
+/************************************************************************/
+/*                    ProcessSQLCreateSpatialIndex()                    */
+/*                                                                      */
+/*      The correct syntax for creating a spatial index for drivers     */
+/*      relying on the generic spatial index is:                        */
+/*                                                                      */
+/*        CREATE SPATIAL INDEX ON <layername>                           */
+/************************************************************************/
+
+OGRErr OGRDataSource::ProcessSQLCreateSpatialIndex( const char *pszSQLCommand )
+
+{
+    char **papszTokens = CSLTokenizeString( pszSQLCommand );
+
+/* -------------------------------------------------------------------- */
+/*      Do some general syntax checking.                                */
+/* -------------------------------------------------------------------- */
+    if( CSLCount(papszTokens) != 5
+        || !EQUAL(papszTokens[0],"CREATE")
+        || !EQUAL(papszTokens[1],"SPATIAL")
+        || !EQUAL(papszTokens[2],"INDEX")
+        || !EQUAL(papszTokens[3],"ON") )
+    {
+        CSLDestroy( papszTokens );
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Syntax error in CREATE SPATIAL INDEX command.\n"
+                  "Was '%s'\n"
+                  "Should be of form 'CREATE SPATIAL INDEX ON <table>'",
+                  pszSQLCommand );
+        return OGRERR_FAILURE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Find the named layer.                                           */
+/* -------------------------------------------------------------------- */
+    OGRLayer *poLayer = GetLayerByName( papszTokens[4] );
+
+    if( poLayer == NULL )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "CREATE SPATIAL INDEX ON failed, no such layer as `%s'.",
+                  papszTokens[4] );
+        CSLDestroy( papszTokens );
+        return OGRERR_FAILURE;
+    }
+
+    CSLDestroy( papszTokens );
+
+/* -------------------------------------------------------------------- */
+/*      Does this layer even support the generic spatial index?         */
+/* -------------------------------------------------------------------- */
+    if( poLayer->GetSpatialIndex() == NULL )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "CREATE SPATIAL INDEX ON not supported by this driver." );
+        return OGRERR_FAILURE;
+    }
+
+    return poLayer->GetSpatialIndex()->IndexAllFeatures();
+}
+
+/************************************************************************/
+/*                     ProcessSQLDropSpatialIndex()                     */
+/*                                                                      */
+/*          DROP SPATIAL INDEX ON <layername>                           */
+/************************************************************************/
+
+OGRErr OGRDataSource::ProcessSQLDropSpatialIndex( const char *pszSQLCommand )
+
+{
+    char **papszTokens = CSLTokenizeString( pszSQLCommand );
+
+    if( CSLCount(papszTokens) != 5
+        || !EQUAL(papszTokens[0],"DROP")
+        || !EQUAL(papszTokens[1],"SPATIAL")
+        || !EQUAL(papszTokens[2],"INDEX")
+        || !EQUAL(papszTokens[3],"ON") )
+    {
+        CSLDestroy( papszTokens );
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Syntax error in DROP SPATIAL INDEX command.\n"
+                  "Was '%s'\n"
+                  "Should be of form 'DROP SPATIAL INDEX ON <table>'",
+                  pszSQLCommand );
+        return OGRERR_FAILURE;
+    }
+
+    OGRLayer *poLayer = GetLayerByName( papszTokens[4] );
+
+    if( poLayer == NULL )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "DROP SPATIAL INDEX ON failed, no such layer as `%s'.",
+                  papszTokens[4] );
+        CSLDestroy( papszTokens );
+        return OGRERR_FAILURE;
+    }
+
+    CSLDestroy( papszTokens );
+
+    if( poLayer->GetSpatialIndex() == NULL )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "DROP SPATIAL INDEX ON not supported by this driver." );
+        return OGRERR_FAILURE;
+    }
+
+    return poLayer->GetSpatialIndex()->DropIndex();
+}
+
 /************************************************************************/
 /*                        ProcessSQLDropTable()                         */
 /*                                                                      */
@@ -1356,7 +1467,23 @@ OGRLayer * OGRDataSource::ExecuteSQL( const char *pszStatement,
         ProcessSQLDropIndex( pszStatement );
         return NULL;
     }
-    
+
+/* -------------------------------------------------------------------- */
+/*      Handle CREATE SPATIAL INDEX and DROP SPATIAL INDEX statements   */
+/*      for drivers relying on the generic spatial index.               */
+/* -------------------------------------------------------------------- */
+    if( EQUALN(pszStatement,"CREATE SPATIAL INDEX",20) )
+    {
+        ProcessSQLCreateSpatialIndex( pszStatement );
+        return NULL;
+    }
+
+    if( EQUALN(pszStatement,"DROP SPATIAL INDEX",18) )
+    {
+        ProcessSQLDropSpatialIndex( pszStatement );
+        return NULL;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Handle DROP TABLE statements specially.                         */
 /* -------------------------------------------------------------------- */
@@ -31,6 +31,7 @@
 #include "ogr_api.h"
 #include "ogr_p.h"
 #include "ogr_attrind.h"
+#include "ogr_spatialind.h"
 #include "swq.h"
 
 CPL_CVSID("$Id$");
@@ -45,6 +46,7 @@ OGRLayer::OGRLayer()
     m_poStyleTable = NULL;
     m_poAttrQuery = NULL;
     m_poAttrIndex = NULL;
+    m_poSpatialIndex = NULL;
     m_nRefCount = 0;
 
     m_nFeaturesRead = 0;
@@ -52,6 +54,7 @@ OGRLayer::OGRLayer()
     m_poFilterGeom = NULL;
     m_bFilterIsEnvelope = FALSE;
     m_pPreparedFilterGeom = NULL;
+    m_bPreparedFilterGeomTried = FALSE;
     m_iGeomFieldFilter = 0;
 }
 
@@ -74,6 +77,12 @@ OGRLayer::~OGRLayer()
         m_poAttrIndex = NULL;
     }
 
+    if( m_poSpatialIndex != NULL )
+    {
+        delete m_poSpatialIndex;
+        m_poSpatialIndex = NULL;
+    }
+
     if( m_poAttrQuery != NULL )
     {
         delete m_poAttrQuery;
@@ -489,6 +498,106 @@ OGRFeatureH OGR_L_GetNextFeature( OGRLayerH hLayer )
     return (OGRFeatureH) ((OGRLayer *)hLayer)->GetNextFeature();
 }
 
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/*                                                                      */
+/*      Default implementation : move the content of the feature        */
+/*      returned by GetNextFeature() into poFeature.                    */
+/************************************************************************/
+
+int OGRLayer::GetNextFeatureInto( OGRFeature *poFeature )
+
+{
+    OGRFeature *poSrcFeature = GetNextFeature();
+
+    if( poSrcFeature == NULL )
+        return FALSE;
+
+    if( poSrcFeature->GetDefnRef() != poFeature->GetDefnRef() )
+    {
+        poFeature->Reset();
+        poFeature->SetFrom( poSrcFeature );
+        poFeature->SetFID( poSrcFeature->GetFID() );
+        delete poSrcFeature;
+        return TRUE;
+    }
+
+    poFeature->Reset();
+
+/* -------------------------------------------------------------------- */
+/*      Take the field values.  The source fields are marked as unset   */
+/*      so that their content is not freed with the source feature.     */
+/* -------------------------------------------------------------------- */
+    int i;
+    for( i = 0; i < poSrcFeature->GetFieldCount(); i++ )
+    {
+        if( !poSrcFeature->IsFieldSet( i ) )
+            continue;
+
+        OGRField *psSrcField = poSrcFeature->GetRawFieldRef( i );
+        memcpy( poFeature->GetRawFieldRef( i ), psSrcField, sizeof(OGRField) );
+        psSrcField->Set.nMarker1 = OGRUnsetMarker;
+        psSrcField->Set.nMarker2 = OGRUnsetMarker;
+    }
+
+    for( i = 0; i < poSrcFeature->GetGeomFieldCount(); i++ )
+        poFeature->SetGeomFieldDirectly( i, poSrcFeature->StealGeometry( i ) );
+
+    poFeature->SetFID( poSrcFeature->GetFID() );
+    if( poSrcFeature->GetStyleString() != NULL )
+        poFeature->SetStyleString( poSrcFeature->GetStyleString() );
+
+    delete poSrcFeature;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                      OGR_L_GetNextFeatureInto()                      */
+/************************************************************************/
+
+int OGR_L_GetNextFeatureInto( OGRLayerH hLayer, OGRFeatureH hFeat )
+
+{
+    VALIDATE_POINTER1( hLayer, "OGR_L_GetNextFeatureInto", FALSE );
+    VALIDATE_POINTER1( hFeat, "OGR_L_GetNextFeatureInto", FALSE );
+
+    return ((OGRLayer *)hLayer)->GetNextFeatureInto( (OGRFeature *) hFeat );
+}
+
+/************************************************************************/
+/*                            GetNextBatch()                            */
+/*                                                                      */
+/*      Default implementation : fill the batch with GetNextFeatureInto */
+/*      and a feature kept by the batch.                                */
+/************************************************************************/
+
+int OGRLayer::GetNextBatch( OGRFeatureBatch *poBatch )
+
+{
+    poBatch->Prepare( GetLayerDefn() );
+
+    OGRFeature *poFeature = poBatch->GetScratchFeature();
+
+    while( !poBatch->IsFull() && GetNextFeatureInto( poFeature ) )
+        poBatch->AddFeature( poFeature );
+
+    return poBatch->GetFeatureCount();
+}
+
+/************************************************************************/
+/*                         OGR_L_GetNextBatch()                         */
+/************************************************************************/
+
+int OGR_L_GetNextBatch( OGRLayerH hLayer, OGRFeatureBatchH hBatch )
+
+{
+    VALIDATE_POINTER1( hLayer, "OGR_L_GetNextBatch", 0 );
+    VALIDATE_POINTER1( hBatch, "OGR_L_GetNextBatch", 0 );
+
+    return ((OGRLayer *)hLayer)->GetNextBatch( (OGRFeatureBatch *) hBatch );
+}
+
 /************************************************************************/
 /*                             SetFeature()                             */
 /************************************************************************/
@@ -1083,6 +1192,7 @@ int OGRLayer::InstallFilter( OGRGeometry * poFilter )
         OGRDestroyPreparedGeometry(m_pPreparedFilterGeom);
         m_pPreparedFilterGeom = NULL;
     }
+    m_bPreparedFilterGeomTried = FALSE;
 
     if( poFilter != NULL )
         m_poFilterGeom = poFilter->clone();
@@ -1095,8 +1205,8 @@ int OGRLayer::InstallFilter( OGRGeometry * poFilter )
     if( m_poFilterGeom != NULL )
         m_poFilterGeom->getEnvelope( &m_sFilterEnvelope );
 
-    /* Compile geometry filter as a prepared geometry */
-    m_pPreparedFilterGeom = OGRCreatePreparedGeometry(m_poFilterGeom);
+    /* The prepared geometry is only built by GetPreparedFilterGeom(), */
+    /* the first time a feature cannot be decided from its envelope. */
 
 /* -------------------------------------------------------------------- */
 /*      Now try to determine if the filter is really a rectangle.       */
@@ -1139,6 +1249,30 @@ int OGRLayer::InstallFilter( OGRGeometry * poFilter )
     return TRUE;
 }
 
+/************************************************************************/
+/*                       GetPreparedFilterGeom()                        */
+/*                                                                      */
+/*      Return the filter geometry compiled as a GEOS prepared          */
+/*      geometry, building it on first use.  Exporting a large filter   */
+/*      to GEOS is costly, so it is not done when all features can be  */
+/*      accepted or rejected by the envelope tests, or when the driver  */
+/*      forwards the filter to its backend.  The prepared geometry      */
+/*      owns its own GEOS context.  Returns NULL if GEOS is not         */
+/*      available or the preparation failed.                            */
+/************************************************************************/
+
+OGRPreparedGeometry *OGRLayer::GetPreparedFilterGeom()
+
+{
+    if( !m_bPreparedFilterGeomTried && m_poFilterGeom != NULL )
+    {
+        m_bPreparedFilterGeomTried = TRUE;
+        m_pPreparedFilterGeom = OGRCreatePreparedGeometry(m_poFilterGeom);
+    }
+
+    return m_pPreparedFilterGeom;
+}
+
 /************************************************************************/
 /*                           FilterGeometry()                           */
 /*                                                                      */
@@ -1196,46 +1330,82 @@ int OGRLayer::FilterGeometry( OGRGeometry *poGeometry )
 /*      If the filter geometry is its own envelope and if the           */
 /*      the geometry (line, or polygon without hole) h has at least one */
 /*      point inside the filter geometry, the geometry itself is inside */
-/*      the filter geometry.                                            */
+/*      the filter geometry.  For multi-points, multi-lines and         */
+/*      multi-polygons, this is checked on each part.                   */
 /* -------------------------------------------------------------------- */
         if( m_bFilterIsEnvelope )
         {
-            OGRLineString* poLS = NULL;
+            OGRGeometryCollection* poColl = NULL;
+            int nParts = 1;
 
             switch( wkbFlatten(poGeometry->getGeometryType()) )
             {
-                case wkbPolygon:
-                {
-                    OGRPolygon* poPoly = (OGRPolygon* )poGeometry;
-                    OGRLinearRing* poRing = poPoly->getExteriorRing();
-                    if (poRing != NULL && poPoly->getNumInteriorRings() == 0)
-                    {
-                        poLS = poRing;
-                    }
-                    break;
-                }
-
-                case wkbLineString:
-                    poLS = (OGRLineString* )poGeometry;
+                case wkbMultiPoint:
+                case wkbMultiPolygon:
+                case wkbMultiLineString:
+                    poColl = (OGRGeometryCollection* )poGeometry;
+                    nParts = poColl->getNumGeometries();
                     break;
 
                 default:
                     break;
             }
 
-            if( poLS != NULL )
+            for(int iPart = 0; iPart < nParts; iPart++)
             {
-                int nNumPoints = poLS->getNumPoints();
-                for(int i = 0; i < nNumPoints; i++)
+                OGRGeometry* poPart = (poColl != NULL) ?
+                    poColl->getGeometryRef(iPart) : poGeometry;
+                OGRLineString* poLS = NULL;
+
+                switch( wkbFlatten(poPart->getGeometryType()) )
+                {
+                    case wkbPolygon:
+                    {
+                        OGRPolygon* poPoly = (OGRPolygon* )poPart;
+                        OGRLinearRing* poRing = poPoly->getExteriorRing();
+                        if (poRing != NULL && poPoly->getNumInteriorRings() == 0)
+                        {
+                            poLS = poRing;
+                        }
+                        break;
+                    }
+
+                    case wkbLineString:
+                        poLS = (OGRLineString* )poPart;
+                        break;
+
+                    case wkbPoint:
+                    {
+                        OGRPoint* poPoint = (OGRPoint* )poPart;
+                        if (poColl != NULL && !poPoint->IsEmpty() &&
+                            poPoint->getX() >= m_sFilterEnvelope.MinX &&
+                            poPoint->getY() >= m_sFilterEnvelope.MinY &&
+                            poPoint->getX() <= m_sFilterEnvelope.MaxX &&
+                            poPoint->getY() <= m_sFilterEnvelope.MaxY)
+                        {
+                            return TRUE;
+                        }
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+
+                if( poLS != NULL )
                 {
-                    double x = poLS->getX(i);
-                    double y = poLS->getY(i);
-                    if (x >= m_sFilterEnvelope.MinX &&
-                        y >= m_sFilterEnvelope.MinY &&
-                        x <= m_sFilterEnvelope.MaxX &&
-                        y <= m_sFilterEnvelope.MaxY)
+                    int nNumPoints = poLS->getNumPoints();
+                    for(int i = 0; i < nNumPoints; i++)
                     {
-                        return TRUE;
+                        double x = poLS->getX(i);
+                        double y = poLS->getY(i);
+                        if (x >= m_sFilterEnvelope.MinX &&
+                            y >= m_sFilterEnvelope.MinY &&
+                            x <= m_sFilterEnvelope.MaxX &&
+                            y <= m_sFilterEnvelope.MaxY)
+                        {
+                            return TRUE;
+                        }
                     }
                 }
             }
@@ -1248,8 +1418,9 @@ int OGRLayer::FilterGeometry( OGRGeometry *poGeometry )
         if( OGRGeometryFactory::haveGEOS() )
         {
             //CPLDebug("OGRLayer", "GEOS intersection");
-            if( m_pPreparedFilterGeom != NULL )
-                return OGRPreparedGeometryIntersects(m_pPreparedFilterGeom,
+            OGRPreparedGeometry *poPreparedFilterGeom = GetPreparedFilterGeom();
+            if( poPreparedFilterGeom != NULL )
+                return OGRPreparedGeometryIntersects(poPreparedFilterGeom,
                                                      poGeometry);
             else
                 return m_poFilterGeom->Intersects( poGeometry );
@@ -1299,6 +1470,37 @@ OGRErr OGRLayer::InitializeIndexSupport( const char *pszFilename )
     return eErr;
 }
 
+/************************************************************************/
+/*                   InitializeSpatialIndexSupport()                    */
+/*                                                                      */
+/*      Like InitializeIndexSupport(), this is intended to be called    */
+/*      by drivers whose layers are backed by a single data file,       */
+/*      that have no native spatial index, and that can take            */
+/*      advantage of a list of candidate FIDs, typically through        */
+/*      fast random or forward only access.  pszFilename is the data    */
+/*      file, the index is stored next to it.                           */
+/************************************************************************/
+
+OGRErr OGRLayer::InitializeSpatialIndexSupport( const char *pszFilename )
+
+{
+    OGRErr eErr;
+
+    if (m_poSpatialIndex != NULL)
+        return OGRERR_NONE;
+
+    m_poSpatialIndex = new OGRLayerSpatialIndex();
+
+    eErr = m_poSpatialIndex->Initialize( pszFilename, this );
+    if( eErr != OGRERR_NONE )
+    {
+        delete m_poSpatialIndex;
+        m_poSpatialIndex = NULL;
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                             SyncToDisk()                             */
 /************************************************************************/
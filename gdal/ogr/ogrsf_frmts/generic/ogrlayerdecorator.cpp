@@ -88,6 +88,16 @@ OGRFeature *OGRLayerDecorator::GetNextFeature()
     return m_poDecoratedLayer->GetNextFeature();
 }
 
+int         OGRLayerDecorator::GetNextFeatureInto( OGRFeature *poFeature )
+{
+    return m_poDecoratedLayer->GetNextFeatureInto(poFeature);
+}
+
+int         OGRLayerDecorator::GetNextBatch( OGRFeatureBatch *poBatch )
+{
+    return m_poDecoratedLayer->GetNextBatch(poBatch);
+}
+
 OGRErr      OGRLayerDecorator::SetNextByIndex( long nIndex )
 {
     return m_poDecoratedLayer->SetNextByIndex(nIndex);
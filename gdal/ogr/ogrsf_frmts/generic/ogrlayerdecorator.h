@@ -56,6 +56,8 @@ class OGRLayerDecorator : public OGRLayer
 
     virtual void        ResetReading();
     virtual OGRFeature *GetNextFeature();
+    virtual int         GetNextFeatureInto( OGRFeature *poFeature );
+    virtual int         GetNextBatch( OGRFeatureBatch *poBatch );
     virtual OGRErr      SetNextByIndex( long nIndex );
     virtual OGRFeature *GetFeature( long nFID );
     virtual OGRErr      SetFeature( OGRFeature *poFeature );
@@ -28,6 +28,7 @@
  ****************************************************************************/
 
 #include "ogrlayerpool.h"
+#include "cpl_multiproc.h"
 
 CPL_CVSID("$Id$");
 
@@ -39,6 +40,7 @@ OGRAbstractProxiedLayer::OGRAbstractProxiedLayer(OGRLayerPool* poPool)
 {
     CPLAssert(poPool != NULL);
     this->poPool = poPool;
+    nUseCount = 0;
     poPrevLayer = NULL;
     poNextLayer = NULL;
 }
@@ -65,6 +67,7 @@ OGRLayerPool::OGRLayerPool(int nMaxSimultaneouslyOpened)
     poLRULayer = NULL;
     nMRUListSize = 0;
     this->nMaxSimultaneouslyOpened = nMaxSimultaneouslyOpened;
+    hMutex = NULL;
 }
 
 /************************************************************************/
@@ -76,6 +79,9 @@ OGRLayerPool::~OGRLayerPool()
     CPLAssert( poMRULayer == NULL );
     CPLAssert( poLRULayer == NULL );
     CPLAssert( nMRUListSize == 0 );
+
+    if( hMutex != NULL )
+        CPLDestroyMutex( hMutex );
 }
 
 /************************************************************************/
@@ -84,6 +90,8 @@ OGRLayerPool::~OGRLayerPool()
 
 void OGRLayerPool::SetLastUsedLayer(OGRAbstractProxiedLayer* poLayer)
 {
+    CPLMutexHolderD( &hMutex );
+
     /* If we are already the MRU layer, nothing to do */
     if (poLayer == poMRULayer)
         return;
@@ -95,15 +103,21 @@ void OGRLayerPool::SetLastUsedLayer(OGRAbstractProxiedLayer* poLayer)
         /* Remove current layer from its current place in the list */
         UnchainLayer(poLayer);
     }
-    else if (nMRUListSize == nMaxSimultaneouslyOpened)
+    else if (nMRUListSize >= nMaxSimultaneouslyOpened)
     {
         /* If we have reached the maximum allowed number of layers */
         /* simultaneously opened, then close the LRU one that */
-        /* was still active until now */
-        CPLAssert(poLRULayer != NULL);
-
-        poLRULayer->CloseUnderlyingLayer();
-        UnchainLayer(poLRULayer);
+        /* was still active until now and that is not in use. If they */
+        /* are all in use, the limit is exceeded until one is released */
+        OGRAbstractProxiedLayer* poVictim = poLRULayer;
+        while( poVictim != NULL && poVictim->nUseCount > 0 )
+            poVictim = poVictim->poPrevLayer;
+
+        if( poVictim != NULL )
+        {
+            poVictim->CloseUnderlyingLayer();
+            UnchainLayer(poVictim);
+        }
     }
 
     /* Put current layer on top of MRU list */
@@ -127,6 +141,8 @@ void OGRLayerPool::SetLastUsedLayer(OGRAbstractProxiedLayer* poLayer)
 
 void OGRLayerPool::UnchainLayer(OGRAbstractProxiedLayer* poLayer)
 {
+    CPLMutexHolderD( &hMutex );
+
     OGRAbstractProxiedLayer* poPrevLayer = poLayer->poPrevLayer;
     OGRAbstractProxiedLayer* poNextLayer = poLayer->poNextLayer;
 
@@ -150,6 +166,33 @@ void OGRLayerPool::UnchainLayer(OGRAbstractProxiedLayer* poLayer)
 
 
 
+/************************************************************************/
+/*                          OGRProxiedLayerUse                          */
+/*                                                                      */
+/*      Keeps the underlying layer of a proxied layer opened for the    */
+/*      duration of a call.                                             */
+/************************************************************************/
+
+class OGRProxiedLayerUse
+{
+    OGRProxiedLayer    *poLayer;
+    int                 bAcquired;
+
+  public:
+    OGRProxiedLayerUse(OGRProxiedLayer* poLayerIn) : poLayer(poLayerIn)
+    {
+        bAcquired = poLayer->AcquireUnderlyingLayer();
+    }
+
+    ~OGRProxiedLayerUse()
+    {
+        if( bAcquired )
+            poLayer->ReleaseUnderlyingLayer();
+    }
+
+    int IsAcquired() const { return bAcquired; }
+};
+
 /************************************************************************/
 /*                          OGRProxiedLayer()                           */
 /************************************************************************/
@@ -167,6 +210,11 @@ OGRProxiedLayer::OGRProxiedLayer(OGRLayerPool* poPool,
     poUnderlyingLayer = NULL;
     poFeatureDefn = NULL;
     poSRS = NULL;
+    pszAttributeFilter = NULL;
+    iSpatialFilterGeomField = 0;
+    poSpatialFilter = NULL;
+    papszIgnoredFields = NULL;
+    bReadingInProgress = FALSE;
 }
 
 /************************************************************************/
@@ -183,6 +231,10 @@ OGRProxiedLayer::~OGRProxiedLayer()
     if( poFeatureDefn )
         poFeatureDefn->Release();
 
+    CPLFree(pszAttributeFilter);
+    delete poSpatialFilter;
+    CSLDestroy(papszIgnoredFields);
+
     if( pfnFreeUserData != NULL )
         pfnFreeUserData(pUserData);
 }
@@ -201,8 +253,81 @@ int OGRProxiedLayer::OpenUnderlyingLayer()
     {
         CPLError(CE_Failure, CPLE_FileIO,
                  "Cannot open underlying layer");
+        return FALSE;
     }
-    return poUnderlyingLayer != NULL;
+
+/* -------------------------------------------------------------------- */
+/*      Finish the lazy initialization of the layer while the pool is   */
+/*      locked, and restore its state if it has been closed by the      */
+/*      pool after having been configured.                              */
+/* -------------------------------------------------------------------- */
+    poUnderlyingLayer->GetLayerDefn();
+    if( pszAttributeFilter != NULL )
+        poUnderlyingLayer->SetAttributeFilter(pszAttributeFilter);
+    if( poSpatialFilter != NULL )
+    {
+        if( iSpatialFilterGeomField == 0 )
+            poUnderlyingLayer->SetSpatialFilter(poSpatialFilter);
+        else
+            poUnderlyingLayer->SetSpatialFilter(iSpatialFilterGeomField,
+                                                poSpatialFilter);
+    }
+    if( papszIgnoredFields != NULL )
+        poUnderlyingLayer->SetIgnoredFields((const char**)papszIgnoredFields);
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                       AcquireUnderlyingLayer()                       */
+/*                                                                      */
+/*      Open the underlying layer if needed, and prevent the pool from  */
+/*      closing it until ReleaseUnderlyingLayer() is called, so that    */
+/*      proxied layers of a same pool can be used by several threads.   */
+/************************************************************************/
+
+int OGRProxiedLayer::AcquireUnderlyingLayer()
+{
+    CPLMutexHolderD( poPool->GetMutex() );
+
+    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() )
+        return FALSE;
+    nUseCount ++;
+    return TRUE;
+}
+
+/************************************************************************/
+/*                       ReleaseUnderlyingLayer()                       */
+/************************************************************************/
+
+void OGRProxiedLayer::ReleaseUnderlyingLayer()
+{
+    CPLMutexHolderD( poPool->GetMutex() );
+
+    CPLAssert(nUseCount > 0);
+    nUseCount --;
+}
+
+/************************************************************************/
+/*                        SetReadingInProgress()                        */
+/*                                                                      */
+/*      The read position cannot be restored when the underlying layer  */
+/*      is reopened, so the layer is kept opened between the first      */
+/*      feature read and the end of the reading or the next rewind.     */
+/************************************************************************/
+
+void OGRProxiedLayer::SetReadingInProgress(int bInProgress)
+{
+    if( bInProgress == bReadingInProgress )
+        return;
+
+    CPLMutexHolderD( poPool->GetMutex() );
+
+    bReadingInProgress = bInProgress;
+    if( bInProgress )
+        nUseCount ++;
+    else
+        nUseCount --;
 }
 
 /************************************************************************/
@@ -216,13 +341,26 @@ void OGRProxiedLayer::CloseUnderlyingLayer()
     poUnderlyingLayer = NULL;
 }
 
+/************************************************************************/
+/*                          SaveSpatialFilter()                         */
+/************************************************************************/
+
+void OGRProxiedLayer::SaveSpatialFilter( int iGeomField, OGRGeometry * poGeom )
+{
+    delete poSpatialFilter;
+    poSpatialFilter = (poGeom != NULL) ? poGeom->clone() : NULL;
+    iSpatialFilterGeomField = iGeomField;
+    SetReadingInProgress(FALSE);
+}
+
 /************************************************************************/
 /*                          GetSpatialFilter()                          */
 /************************************************************************/
 
 OGRGeometry *OGRProxiedLayer::GetSpatialFilter()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return NULL;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return NULL;
     return poUnderlyingLayer->GetSpatialFilter();
 }
 
@@ -232,8 +370,10 @@ OGRGeometry *OGRProxiedLayer::GetSpatialFilter()
 
 void        OGRProxiedLayer::SetSpatialFilter( OGRGeometry * poGeom )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return;
     poUnderlyingLayer->SetSpatialFilter(poGeom);
+    SaveSpatialFilter(0, poGeom);
 }
 
 /************************************************************************/
@@ -242,17 +382,28 @@ void        OGRProxiedLayer::SetSpatialFilter( OGRGeometry * poGeom )
 
 void        OGRProxiedLayer::SetSpatialFilter( int iGeomField, OGRGeometry * poGeom )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return;
     poUnderlyingLayer->SetSpatialFilter(iGeomField, poGeom);
+    SaveSpatialFilter(iGeomField, poGeom);
 }
+
 /************************************************************************/
 /*                          SetAttributeFilter()                        */
 /************************************************************************/
 
 OGRErr      OGRProxiedLayer::SetAttributeFilter( const char * poAttrFilter )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
-    return poUnderlyingLayer->SetAttributeFilter(poAttrFilter);
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
+    OGRErr eErr = poUnderlyingLayer->SetAttributeFilter(poAttrFilter);
+    if( eErr == OGRERR_NONE )
+    {
+        CPLFree(pszAttributeFilter);
+        pszAttributeFilter = poAttrFilter ? CPLStrdup(poAttrFilter) : NULL;
+    }
+    SetReadingInProgress(FALSE);
+    return eErr;
 }
 
 /************************************************************************/
@@ -261,8 +412,10 @@ OGRErr      OGRProxiedLayer::SetAttributeFilter( const char * poAttrFilter )
 
 void        OGRProxiedLayer::ResetReading()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return;
     poUnderlyingLayer->ResetReading();
+    SetReadingInProgress(FALSE);
 }
 
 /************************************************************************/
@@ -271,8 +424,11 @@ void        OGRProxiedLayer::ResetReading()
 
 OGRFeature *OGRProxiedLayer::GetNextFeature()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return NULL;
-    return poUnderlyingLayer->GetNextFeature();
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return NULL;
+    OGRFeature* poFeature = poUnderlyingLayer->GetNextFeature();
+    SetReadingInProgress(poFeature != NULL);
+    return poFeature;
 }
 
 /************************************************************************/
@@ -281,8 +437,11 @@ OGRFeature *OGRProxiedLayer::GetNextFeature()
 
 OGRErr      OGRProxiedLayer::SetNextByIndex( long nIndex )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
-    return poUnderlyingLayer->SetNextByIndex(nIndex);
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
+    OGRErr eErr = poUnderlyingLayer->SetNextByIndex(nIndex);
+    SetReadingInProgress(eErr == OGRERR_NONE);
+    return eErr;
 }
 
 /************************************************************************/
@@ -291,7 +450,8 @@ OGRErr      OGRProxiedLayer::SetNextByIndex( long nIndex )
 
 OGRFeature *OGRProxiedLayer::GetFeature( long nFID )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return NULL;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return NULL;
     return poUnderlyingLayer->GetFeature(nFID);
 }
 
@@ -301,7 +461,8 @@ OGRFeature *OGRProxiedLayer::GetFeature( long nFID )
 
 OGRErr      OGRProxiedLayer::SetFeature( OGRFeature *poFeature )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->SetFeature(poFeature);
 }
 
@@ -311,7 +472,8 @@ OGRErr      OGRProxiedLayer::SetFeature( OGRFeature *poFeature )
 
 OGRErr      OGRProxiedLayer::CreateFeature( OGRFeature *poFeature )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->CreateFeature(poFeature);
 }
 
@@ -321,7 +483,8 @@ OGRErr      OGRProxiedLayer::CreateFeature( OGRFeature *poFeature )
 
 OGRErr      OGRProxiedLayer::DeleteFeature( long nFID )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->DeleteFeature(nFID);
 }
 
@@ -331,7 +494,8 @@ OGRErr      OGRProxiedLayer::DeleteFeature( long nFID )
 
 const char *OGRProxiedLayer::GetName()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return "";
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return "";
     return poUnderlyingLayer->GetName();
 }
 
@@ -341,7 +505,8 @@ const char *OGRProxiedLayer::GetName()
 
 OGRwkbGeometryType OGRProxiedLayer::GetGeomType()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return wkbUnknown;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return wkbUnknown;
     return poUnderlyingLayer->GetGeomType();
 }
 
@@ -354,7 +519,8 @@ OGRFeatureDefn *OGRProxiedLayer::GetLayerDefn()
     if( poFeatureDefn != NULL )
         return poFeatureDefn;
 
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() )
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() )
     {
         poFeatureDefn = new OGRFeatureDefn("");
     }
@@ -376,7 +542,8 @@ OGRSpatialReference *OGRProxiedLayer::GetSpatialRef()
 {
     if( poSRS != NULL )
         return poSRS;
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return NULL;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return NULL;
     OGRSpatialReference* poRet = poUnderlyingLayer->GetSpatialRef();
     if( poRet != NULL )
     {
@@ -392,7 +559,8 @@ OGRSpatialReference *OGRProxiedLayer::GetSpatialRef()
 
 int         OGRProxiedLayer::GetFeatureCount( int bForce )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return 0;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return 0;
     return poUnderlyingLayer->GetFeatureCount(bForce);
 }
 
@@ -402,7 +570,8 @@ int         OGRProxiedLayer::GetFeatureCount( int bForce )
 
 OGRErr      OGRProxiedLayer::GetExtent(int iGeomField, OGREnvelope *psExtent, int bForce)
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->GetExtent(iGeomField, psExtent, bForce);
 }
 
@@ -412,7 +581,8 @@ OGRErr      OGRProxiedLayer::GetExtent(int iGeomField, OGREnvelope *psExtent, in
 
 OGRErr      OGRProxiedLayer::GetExtent(OGREnvelope *psExtent, int bForce)
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->GetExtent(psExtent, bForce);
 }
 
@@ -422,7 +592,8 @@ OGRErr      OGRProxiedLayer::GetExtent(OGREnvelope *psExtent, int bForce)
 
 int         OGRProxiedLayer::TestCapability( const char * pszCapability )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return FALSE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return FALSE;
     return poUnderlyingLayer->TestCapability(pszCapability);
 }
 
@@ -433,7 +604,8 @@ int         OGRProxiedLayer::TestCapability( const char * pszCapability )
 OGRErr      OGRProxiedLayer::CreateField( OGRFieldDefn *poField,
                                             int bApproxOK )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->CreateField(poField, bApproxOK);
 }
 
@@ -443,7 +615,8 @@ OGRErr      OGRProxiedLayer::CreateField( OGRFieldDefn *poField,
 
 OGRErr      OGRProxiedLayer::DeleteField( int iField )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->DeleteField(iField);
 }
 
@@ -453,7 +626,8 @@ OGRErr      OGRProxiedLayer::DeleteField( int iField )
 
 OGRErr      OGRProxiedLayer::ReorderFields( int* panMap )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->ReorderFields(panMap);
 }
 
@@ -463,7 +637,8 @@ OGRErr      OGRProxiedLayer::ReorderFields( int* panMap )
 
 OGRErr      OGRProxiedLayer::AlterFieldDefn( int iField, OGRFieldDefn* poNewFieldDefn, int nFlags )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->AlterFieldDefn(iField, poNewFieldDefn, nFlags);
 }
 
@@ -473,7 +648,8 @@ OGRErr      OGRProxiedLayer::AlterFieldDefn( int iField, OGRFieldDefn* poNewFiel
 
 OGRErr      OGRProxiedLayer::SyncToDisk()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->SyncToDisk();
 }
 
@@ -483,7 +659,8 @@ OGRErr      OGRProxiedLayer::SyncToDisk()
 
 OGRStyleTable *OGRProxiedLayer::GetStyleTable()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return NULL;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return NULL;
     return poUnderlyingLayer->GetStyleTable();
 }
 
@@ -493,7 +670,8 @@ OGRStyleTable *OGRProxiedLayer::GetStyleTable()
 
 void        OGRProxiedLayer::SetStyleTableDirectly( OGRStyleTable *poStyleTable )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return;
     return poUnderlyingLayer->SetStyleTableDirectly(poStyleTable);
 }
 
@@ -503,7 +681,8 @@ void        OGRProxiedLayer::SetStyleTableDirectly( OGRStyleTable *poStyleTable
 
 void        OGRProxiedLayer::SetStyleTable(OGRStyleTable *poStyleTable)
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return;
     return poUnderlyingLayer->SetStyleTable(poStyleTable);
 }
 
@@ -513,7 +692,8 @@ void        OGRProxiedLayer::SetStyleTable(OGRStyleTable *poStyleTable)
 
 OGRErr      OGRProxiedLayer::StartTransaction()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->StartTransaction();
 }
 
@@ -523,7 +703,8 @@ OGRErr      OGRProxiedLayer::StartTransaction()
 
 OGRErr      OGRProxiedLayer::CommitTransaction()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->CommitTransaction();
 }
 
@@ -533,7 +714,8 @@ OGRErr      OGRProxiedLayer::CommitTransaction()
 
 OGRErr      OGRProxiedLayer::RollbackTransaction()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
     return poUnderlyingLayer->RollbackTransaction();
 }
 
@@ -543,7 +725,8 @@ OGRErr      OGRProxiedLayer::RollbackTransaction()
 
 const char *OGRProxiedLayer::GetFIDColumn()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return "";
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return "";
     return poUnderlyingLayer->GetFIDColumn();
 }
 
@@ -553,7 +736,8 @@ const char *OGRProxiedLayer::GetFIDColumn()
 
 const char *OGRProxiedLayer::GetGeometryColumn()
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return "";
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return "";
     return poUnderlyingLayer->GetGeometryColumn();
 }
 
@@ -563,7 +747,14 @@ const char *OGRProxiedLayer::GetGeometryColumn()
 
 OGRErr      OGRProxiedLayer::SetIgnoredFields( const char **papszFields )
 {
-    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return OGRERR_FAILURE;
-    return poUnderlyingLayer->SetIgnoredFields(papszFields);
+    OGRProxiedLayerUse oUse(this);
+    if( !oUse.IsAcquired() ) return OGRERR_FAILURE;
+    OGRErr eErr = poUnderlyingLayer->SetIgnoredFields(papszFields);
+    if( eErr == OGRERR_NONE )
+    {
+        CSLDestroy(papszIgnoredFields);
+        papszIgnoredFields = CSLDuplicate((char**)papszFields);
+    }
+    return eErr;
 }
 
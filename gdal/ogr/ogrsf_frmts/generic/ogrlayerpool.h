@@ -50,6 +50,7 @@ class OGRAbstractProxiedLayer : public OGRLayer
 
     protected:
         OGRLayerPool              *poPool;
+        int                        nUseCount; /* the layer is not closed while > 0 */
 
         virtual void    CloseUnderlyingLayer() = 0;
 
@@ -69,11 +70,14 @@ class OGRLayerPool
         OGRAbstractProxiedLayer *poLRULayer; /* the least recently used layer (still opened) */
         int                     nMRUListSize; /* the size of the list */
         int                     nMaxSimultaneouslyOpened;
+        void                   *hMutex; /* protects the list and the use counts */
 
     public:
                                 OGRLayerPool(int nMaxSimultaneouslyOpened = 100);
                                ~OGRLayerPool();
 
+        void                  **GetMutex() { return &hMutex; }
+
         void                    SetLastUsedLayer(OGRAbstractProxiedLayer* poProxiedLayer);
         void                    UnchainLayer(OGRAbstractProxiedLayer* poProxiedLayer);
 
@@ -94,7 +98,20 @@ class OGRProxiedLayer : public OGRAbstractProxiedLayer
     OGRFeatureDefn     *poFeatureDefn;
     OGRSpatialReference *poSRS;
 
+    /* State re-applied when the underlying layer is reopened */
+    char               *pszAttributeFilter;
+    int                 iSpatialFilterGeomField;
+    OGRGeometry        *poSpatialFilter;
+    char              **papszIgnoredFields;
+    int                 bReadingInProgress;
+
     int                 OpenUnderlyingLayer();
+    int                 AcquireUnderlyingLayer();
+    void                ReleaseUnderlyingLayer();
+    void                SetReadingInProgress(int bInProgress);
+    void                SaveSpatialFilter(int iGeomField, OGRGeometry* poGeom);
+
+    friend class OGRProxiedLayerUse;
 
   protected:
 
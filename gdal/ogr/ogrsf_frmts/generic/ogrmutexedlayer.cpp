@@ -94,6 +94,18 @@ OGRFeature *OGRMutexedLayer::GetNextFeature()
     return OGRLayerDecorator::GetNextFeature();
 }
 
+int         OGRMutexedLayer::GetNextFeatureInto( OGRFeature *poFeature )
+{
+    CPLMutexHolderOptionalLockD(m_hMutex);
+    return OGRLayerDecorator::GetNextFeatureInto(poFeature);
+}
+
+int         OGRMutexedLayer::GetNextBatch( OGRFeatureBatch *poBatch )
+{
+    CPLMutexHolderOptionalLockD(m_hMutex);
+    return OGRLayerDecorator::GetNextBatch(poBatch);
+}
+
 OGRErr      OGRMutexedLayer::SetNextByIndex( long nIndex )
 {
     CPLMutexHolderOptionalLockD(m_hMutex);
@@ -66,6 +66,8 @@ class CPL_DLL OGRMutexedLayer : public OGRLayerDecorator
 
     virtual void        ResetReading();
     virtual OGRFeature *GetNextFeature();
+    virtual int         GetNextFeatureInto( OGRFeature *poFeature );
+    virtual int         GetNextBatch( OGRFeatureBatch *poBatch );
     virtual OGRErr      SetNextByIndex( long nIndex );
     virtual OGRFeature *GetFeature( long nFID );
     virtual OGRErr      SetFeature( OGRFeature *poFeature );
@@ -30,9 +30,18 @@
 #include "ogrunionlayer.h"
 #include "ogrwarpedlayer.h"
 #include "ogr_p.h"
+#include "cpl_multiproc.h"
+#include "cpl_atomic_ops.h"
 
 CPL_CVSID("$Id$");
 
+/* Number of features a reader thread translates before pushing them */
+#define UNION_READER_BATCH_SIZE 64
+
+/* Number of features a reader thread reads ahead in a source layer whose */
+/* first FID is not known yet */
+#define UNION_READER_MAX_PENDING (16 * UNION_READER_BATCH_SIZE)
+
 /************************************************************************/
 /*                          OGRUnionLayer()                             */
 /************************************************************************/
@@ -73,6 +82,34 @@ OGRUnionLayer::OGRUnionLayer( const char* pszName,
 
     pabModifiedLayers = (int*)CPLCalloc(sizeof(int), nSrcLayers);
     pabCheckIfAutoWrap = (int*)CPLCalloc(sizeof(int), nSrcLayers);
+
+    nNumThreads = 1;
+    bParallelReading = FALSE;
+    hReaderMutex = NULL;
+    hReaderCondNotEmpty = NULL;
+    hReaderCondNotFull = NULL;
+    nReaderThreads = 0;
+    pahReaderThreads = NULL;
+    nActiveReaders = 0;
+    bStopReaders = FALSE;
+    nNextLayerToRead = 0;
+    papanReaderMaps = NULL;
+    papoQueue = NULL;
+    panQueueLayers = NULL;
+    nQueueSize = 0;
+    nQueueFirst = 0;
+    nQueueCount = 0;
+    papoDeferredFeatures = NULL;
+    panDeferredLayers = NULL;
+    nDeferredFeatures = 0;
+    nDeferredAlloc = 0;
+    papoReadyFeatures = NULL;
+    nReadyFeatures = 0;
+    nReadyAlloc = 0;
+    iReadyFeature = 0;
+    panSrcLayerFIDBase = NULL;
+    nKnownFIDBases = 0;
+    panSrcLayerFeatureCount = NULL;
 }
 
 /************************************************************************/
@@ -83,6 +120,8 @@ OGRUnionLayer::~OGRUnionLayer()
 {
     int i;
 
+    StopParallelReading();
+
     if( bHasLayerOwnership )
     {
         for(i = 0; i < nSrcLayers; i++)
@@ -99,6 +138,7 @@ OGRUnionLayer::~OGRUnionLayer()
     CSLDestroy(papszIgnoredFields);
     CPLFree(pabModifiedLayers);
     CPLFree(pabCheckIfAutoWrap);
+    CPLFree(panSrcLayerFeatureCount);
 
     if( poSRS != NULL )
         poSRS->Release();
@@ -206,6 +246,23 @@ void OGRUnionLayer::SetExtent( double dfXMin, double dfYMin,
     sStaticEnvelope.MaxY = dfYMax;
 }
 
+/************************************************************************/
+/*                            SetNumThreads()                           */
+/*                                                                      */
+/*      With more than one thread, the source layers are read           */
+/*      concurrently and features are returned in no particular         */
+/*      order.  The source layers must then be independant objects      */
+/*      that can be safely used from different threads (in particular   */
+/*      they must not share a datasource).                              */
+/************************************************************************/
+
+void OGRUnionLayer::SetNumThreads(int nNumThreadsIn)
+{
+    CPLAssert(poFeatureDefn == NULL);
+
+    nNumThreads = MAX(1, nNumThreadsIn);
+}
+
 /************************************************************************/
 /*                         MergeFieldDefn()                             */
 /************************************************************************/
@@ -352,21 +409,23 @@ OGRwkbGeometryType OGRUnionLayer::GetGeomType()
 }
 
 /************************************************************************/
-/*                        ConfigureActiveLayer()                        */
+/*                          ConfigureSrcLayer()                         */
+/*                                                                      */
+/*      Apply the filters and ignored fields to a source layer, rewind  */
+/*      it, and return the map of its fields to the union fields.       */
 /************************************************************************/
 
-void OGRUnionLayer::ConfigureActiveLayer()
+int* OGRUnionLayer::ConfigureSrcLayer(int iSubLayer)
 {
-    AutoWarpLayerIfNecessary(iCurLayer);
-    ApplyAttributeFilterToSrcLayer(iCurLayer);
-    papoSrcLayers[iCurLayer]->SetSpatialFilter(m_poFilterGeom);
-    papoSrcLayers[iCurLayer]->ResetReading();
+    AutoWarpLayerIfNecessary(iSubLayer);
+    ApplyAttributeFilterToSrcLayer(iSubLayer);
+    papoSrcLayers[iSubLayer]->SetSpatialFilter(m_poFilterGeom);
+    papoSrcLayers[iSubLayer]->ResetReading();
 
     /* Establish map */
     OGRFeatureDefn* poFeatureDefn = GetLayerDefn();
-    OGRFeatureDefn* poSrcFeatureDefn = papoSrcLayers[iCurLayer]->GetLayerDefn();
-    CPLFree(panMap);
-    panMap = (int*) CPLMalloc(poSrcFeatureDefn->GetFieldCount() * sizeof(int));
+    OGRFeatureDefn* poSrcFeatureDefn = papoSrcLayers[iSubLayer]->GetLayerDefn();
+    int* panMap = (int*) CPLMalloc(poSrcFeatureDefn->GetFieldCount() * sizeof(int));
     for(int i=0; i < poSrcFeatureDefn->GetFieldCount(); i++)
     {
         OGRFieldDefn* poSrcFieldDefn = poSrcFeatureDefn->GetFieldDefn(i);
@@ -382,7 +441,7 @@ void OGRUnionLayer::ConfigureActiveLayer()
         }
     }
 
-    if( papoSrcLayers[iCurLayer]->TestCapability(OLCIgnoreFields) )
+    if( papoSrcLayers[iSubLayer]->TestCapability(OLCIgnoreFields) )
     {
         char** papszIter = papszIgnoredFields;
         char** papszFieldsSrc = NULL;
@@ -422,10 +481,22 @@ void OGRUnionLayer::ConfigureActiveLayer()
         }
         CPLFree(panSrcFieldsUsed);
 
-        papoSrcLayers[iCurLayer]->SetIgnoredFields((const char**)papszFieldsSrc);
+        papoSrcLayers[iSubLayer]->SetIgnoredFields((const char**)papszFieldsSrc);
 
         CSLDestroy(papszFieldsSrc);
     }
+
+    return panMap;
+}
+
+/************************************************************************/
+/*                        ConfigureActiveLayer()                        */
+/************************************************************************/
+
+void OGRUnionLayer::ConfigureActiveLayer()
+{
+    CPLFree(panMap);
+    panMap = ConfigureSrcLayer(iCurLayer);
 }
 
 /************************************************************************/
@@ -434,9 +505,15 @@ void OGRUnionLayer::ConfigureActiveLayer()
 
 void OGRUnionLayer::ResetReading()
 {
+    StopParallelReading();
+
     iCurLayer = 0;
-    ConfigureActiveLayer();
     nNextFID = 0;
+
+    /* In parallel mode, the source layers are configured when the */
+    /* reader threads are launched by the next GetNextFeature() */
+    if( nNumThreads == 1 )
+        ConfigureActiveLayer();
 }
 
 /************************************************************************/
@@ -495,6 +572,17 @@ OGRFeature *OGRUnionLayer::GetNextFeature()
     if( iCurLayer == nSrcLayers )
         return NULL;
 
+    if( nNumThreads > 1 )
+    {
+        if( bParallelReading || StartParallelReading() )
+            return GetNextFeatureParallel();
+
+        CPLDebug("OGR", "Cannot launch reader threads for layer %s. "
+                 "Falling back to sequential reading", osName.c_str());
+        nNumThreads = 1;
+        ResetReading();
+    }
+
     while(TRUE)
     {
         OGRFeature* poSrcFeature = papoSrcLayers[iCurLayer]->GetNextFeature();
@@ -510,7 +598,8 @@ OGRFeature *OGRUnionLayer::GetNextFeature()
                 break;
         }
 
-        OGRFeature* poFeature = TranslateFromSrcLayer(poSrcFeature);
+        OGRFeature* poFeature = TranslateFromSrcLayer(poSrcFeature, iCurLayer,
+                                                      panMap, nNextFID ++);
         delete poSrcFeature;
 
         if( (m_poFilterGeom == NULL ||
@@ -526,6 +615,539 @@ OGRFeature *OGRUnionLayer::GetNextFeature()
     return NULL;
 }
 
+/************************************************************************/
+/*                        OGRUnionLayerJobThread()                      */
+/************************************************************************/
+
+typedef struct
+{
+    OGRLayer          **papoLayers;
+    int                 nLayers;
+    volatile int        nNextLayer;
+    int                 bExtent;
+    int                 bForce;
+    int                *panCounts;
+    OGREnvelope        *pasExtents;
+    OGRErr             *paeErrors;
+} OGRUnionLayerJob;
+
+static void OGRUnionLayerJobThread( void* pData )
+{
+    OGRUnionLayerJob* psJob = (OGRUnionLayerJob*) pData;
+
+    while( TRUE )
+    {
+        int i = CPLAtomicInc(&(psJob->nNextLayer)) - 1;
+        if( i >= psJob->nLayers )
+            break;
+
+        if( psJob->bExtent )
+            psJob->paeErrors[i] =
+                psJob->papoLayers[i]->GetExtent(&(psJob->pasExtents[i]),
+                                                psJob->bForce);
+        else
+            psJob->panCounts[i] =
+                psJob->papoLayers[i]->GetFeatureCount(psJob->bForce);
+    }
+}
+
+/************************************************************************/
+/*                           RunSrcLayerJob()                           */
+/*                                                                      */
+/*      Run GetFeatureCount() or GetExtent() on all the source layers,  */
+/*      with up to nNumThreads threads, the calling one included.       */
+/*      The source layers must already be configured.                   */
+/************************************************************************/
+
+void OGRUnionLayer::RunSrcLayerJob(int bExtent, int bForce,
+                                   int* panCounts,
+                                   OGREnvelope* pasExtents,
+                                   OGRErr* paeErrors)
+{
+    OGRUnionLayerJob sJob;
+
+    sJob.papoLayers = papoSrcLayers;
+    sJob.nLayers = nSrcLayers;
+    sJob.nNextLayer = 0;
+    sJob.bExtent = bExtent;
+    sJob.bForce = bForce;
+    sJob.panCounts = panCounts;
+    sJob.pasExtents = pasExtents;
+    sJob.paeErrors = paeErrors;
+
+    int nThreads = MIN(nNumThreads, nSrcLayers);
+    void** pahThreads = (void**) CPLCalloc(nThreads, sizeof(void*));
+    int i;
+
+    /* If a thread cannot be launched, the others will do its share */
+    for(i = 1; i < nThreads; i++)
+        pahThreads[i] = CPLCreateJoinableThread(OGRUnionLayerJobThread, &sJob);
+
+    OGRUnionLayerJobThread(&sJob);
+
+    for(i = 1; i < nThreads; i++)
+    {
+        if( pahThreads[i] != NULL )
+            CPLJoinThread(pahThreads[i]);
+    }
+    CPLFree(pahThreads);
+}
+
+/************************************************************************/
+/*                        UpdateKnownFIDBases()                         */
+/*                                                                      */
+/*      The FID of the first feature of a source layer, as sequential   */
+/*      reading would assign it, is known once the feature counts of    */
+/*      all the previous source layers are known.  They are learnt      */
+/*      from cheap feature counts or when a layer has been read, so     */
+/*      that FIDs do not depend on the scheduling of the reader         */
+/*      threads.  Must be called with the reader mutex held.            */
+/************************************************************************/
+
+void OGRUnionLayer::UpdateKnownFIDBases()
+{
+    while( nKnownFIDBases < nSrcLayers &&
+           panSrcLayerFeatureCount[nKnownFIDBases - 1] >= 0 )
+    {
+        panSrcLayerFIDBase[nKnownFIDBases] =
+            panSrcLayerFIDBase[nKnownFIDBases - 1] +
+            panSrcLayerFeatureCount[nKnownFIDBases - 1];
+        nKnownFIDBases ++;
+    }
+}
+
+/************************************************************************/
+/*                        StartParallelReading()                        */
+/************************************************************************/
+
+int OGRUnionLayer::StartParallelReading()
+{
+    int i;
+
+    CPLAssert(!bParallelReading);
+
+/* -------------------------------------------------------------------- */
+/*      Do in this thread everything that cannot be safely done         */
+/*      concurrently : lazy initializations and auto-warping.  The      */
+/*      filters are installed by the reader threads, on the layers      */
+/*      they read.                                                      */
+/* -------------------------------------------------------------------- */
+    GetLayerDefn();
+    GetSpatialRef();
+    GetAttrFilterPassThroughValue();
+    for(i = 0; i < nSrcLayers; i++)
+    {
+        AutoWarpLayerIfNecessary(i);
+        papoSrcLayers[i]->GetLayerDefn();
+    }
+
+    hReaderCondNotEmpty = CPLCreateCond();
+    hReaderCondNotFull = CPLCreateCond();
+    if( hReaderCondNotEmpty == NULL || hReaderCondNotFull == NULL )
+    {
+        if( hReaderCondNotEmpty != NULL )
+            CPLDestroyCond(hReaderCondNotEmpty);
+        if( hReaderCondNotFull != NULL )
+            CPLDestroyCond(hReaderCondNotFull);
+        hReaderCondNotEmpty = NULL;
+        hReaderCondNotFull = NULL;
+        return FALSE;
+    }
+
+    bParallelReading = TRUE;
+
+    papanReaderMaps = (int**) CPLCalloc(nSrcLayers, sizeof(int*));
+
+    if( panSrcLayerFeatureCount == NULL )
+    {
+        panSrcLayerFeatureCount = (long*) CPLMalloc(nSrcLayers * sizeof(long));
+        for(i = 0; i < nSrcLayers; i++)
+            panSrcLayerFeatureCount[i] = -1;
+    }
+    panSrcLayerFIDBase = (long*) CPLMalloc(nSrcLayers * sizeof(long));
+    panSrcLayerFIDBase[0] = 0;
+    if( bPreserveSrcFID )
+        nKnownFIDBases = nSrcLayers;
+    else
+    {
+        nKnownFIDBases = 1;
+        UpdateKnownFIDBases();
+    }
+
+    int nThreads = MIN(nNumThreads, nSrcLayers);
+    nQueueSize = 4 * UNION_READER_BATCH_SIZE * nThreads;
+    papoQueue = (OGRFeature**) CPLMalloc(nQueueSize * sizeof(OGRFeature*));
+    panQueueLayers = (int*) CPLMalloc(nQueueSize * sizeof(int));
+    nQueueFirst = 0;
+    nQueueCount = 0;
+    nDeferredFeatures = 0;
+    nReadyFeatures = 0;
+    iReadyFeature = 0;
+    nNextLayerToRead = 0;
+    bStopReaders = FALSE;
+
+/* -------------------------------------------------------------------- */
+/*      Launch the reader threads.  They wait for the mutex to be       */
+/*      released before doing anything.                                 */
+/* -------------------------------------------------------------------- */
+    hReaderMutex = CPLCreateMutex(); /* and take implicitely the mutex */
+
+    pahReaderThreads = (void**) CPLCalloc(nThreads, sizeof(void*));
+    nReaderThreads = 0;
+    nActiveReaders = 0;
+    for(i = 0; i < nThreads; i++)
+    {
+        void* hThread = CPLCreateJoinableThread(ReaderThreadFunc, this);
+        if( hThread == NULL )
+            break;
+        pahReaderThreads[nReaderThreads ++] = hThread;
+        nActiveReaders ++;
+    }
+
+    CPLReleaseMutex(hReaderMutex);
+
+    if( nReaderThreads == 0 )
+    {
+        StopParallelReading();
+        return FALSE;
+    }
+
+    CPLDebug("OGR", "Reading layer %s with %d threads",
+             osName.c_str(), nReaderThreads);
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                        StopParallelReading()                         */
+/************************************************************************/
+
+void OGRUnionLayer::StopParallelReading()
+{
+    int i;
+
+    if( !bParallelReading )
+        return;
+
+    if( hReaderMutex != NULL )
+    {
+        CPLAcquireMutex(hReaderMutex, 1000.0);
+        bStopReaders = TRUE;
+        CPLCondBroadcast(hReaderCondNotFull);
+        CPLReleaseMutex(hReaderMutex);
+    }
+
+    for(i = 0; i < nReaderThreads; i++)
+        CPLJoinThread(pahReaderThreads[i]);
+    CPLFree(pahReaderThreads);
+    pahReaderThreads = NULL;
+    nReaderThreads = 0;
+    nActiveReaders = 0;
+
+    for(i = 0; i < nQueueCount; i++)
+        delete papoQueue[(nQueueFirst + i) % nQueueSize];
+    CPLFree(papoQueue);
+    CPLFree(panQueueLayers);
+    papoQueue = NULL;
+    panQueueLayers = NULL;
+    nQueueSize = 0;
+    nQueueFirst = 0;
+    nQueueCount = 0;
+
+    for(i = 0; i < nDeferredFeatures; i++)
+        delete papoDeferredFeatures[i];
+    CPLFree(papoDeferredFeatures);
+    CPLFree(panDeferredLayers);
+    papoDeferredFeatures = NULL;
+    panDeferredLayers = NULL;
+    nDeferredFeatures = 0;
+    nDeferredAlloc = 0;
+
+    for(i = iReadyFeature; i < nReadyFeatures; i++)
+        delete papoReadyFeatures[i];
+    CPLFree(papoReadyFeatures);
+    papoReadyFeatures = NULL;
+    nReadyFeatures = 0;
+    nReadyAlloc = 0;
+    iReadyFeature = 0;
+
+    CPLFree(panSrcLayerFIDBase);
+    panSrcLayerFIDBase = NULL;
+    nKnownFIDBases = 0;
+
+    for(i = 0; i < nSrcLayers; i++)
+        CPLFree(papanReaderMaps[i]);
+    CPLFree(papanReaderMaps);
+    papanReaderMaps = NULL;
+
+    if( hReaderCondNotEmpty != NULL )
+        CPLDestroyCond(hReaderCondNotEmpty);
+    if( hReaderCondNotFull != NULL )
+        CPLDestroyCond(hReaderCondNotFull);
+    if( hReaderMutex != NULL )
+        CPLDestroyMutex(hReaderMutex);
+    hReaderCondNotEmpty = NULL;
+    hReaderCondNotFull = NULL;
+    hReaderMutex = NULL;
+
+    bParallelReading = FALSE;
+    iCurLayer = -1;
+}
+
+/************************************************************************/
+/*                          ReaderThreadFunc()                          */
+/************************************************************************/
+
+void OGRUnionLayer::ReaderThreadFunc(void* pData)
+{
+    ((OGRUnionLayer*) pData)->ReadSrcLayers();
+}
+
+/************************************************************************/
+/*                            ReadSrcLayers()                           */
+/*                                                                      */
+/*      Body of a reader thread : configure and read whole source       */
+/*      layers, taken in turn, and push their translated features in    */
+/*      the queue.  Only the source layer being read is touched by the  */
+/*      thread.  The FIDs of the pushed features are relative to the    */
+/*      first feature of their layer.                                   */
+/************************************************************************/
+
+void OGRUnionLayer::ReadSrcLayers()
+{
+    CPLAcquireMutex(hReaderMutex, 1000.0);
+
+    while( !bStopReaders && nNextLayerToRead < nSrcLayers )
+    {
+        int iLayer = nNextLayerToRead ++;
+        CPLReleaseMutex(hReaderMutex);
+
+        OGRLayer* poSrcLayer = papoSrcLayers[iLayer];
+        papanReaderMaps[iLayer] = ConfigureSrcLayer(iLayer);
+
+/* -------------------------------------------------------------------- */
+/*      A cheap feature count gives the FID base of the next layer      */
+/*      without waiting for this one to be read.                        */
+/* -------------------------------------------------------------------- */
+        if( !bPreserveSrcFID && panSrcLayerFeatureCount[iLayer] < 0 &&
+            poSrcLayer->TestCapability(OLCFastFeatureCount) )
+        {
+            int nCount = poSrcLayer->GetFeatureCount(FALSE);
+            if( nCount >= 0 )
+            {
+                CPLAcquireMutex(hReaderMutex, 1000.0);
+                panSrcLayerFeatureCount[iLayer] = nCount;
+                UpdateKnownFIDBases();
+                CPLCondBroadcast(hReaderCondNotFull);
+                CPLReleaseMutex(hReaderMutex);
+            }
+        }
+
+        long nFID = 0;
+        int bStop = FALSE;
+        int bEOF = FALSE;
+
+        while( !bStop && !bEOF )
+        {
+/* -------------------------------------------------------------------- */
+/*      Translate a batch of features without holding the mutex.        */
+/* -------------------------------------------------------------------- */
+            OGRFeature* apoBatch[UNION_READER_BATCH_SIZE];
+            int nBatchCount = 0;
+            while( nBatchCount < UNION_READER_BATCH_SIZE )
+            {
+                OGRFeature* poSrcFeature = poSrcLayer->GetNextFeature();
+                if( poSrcFeature == NULL )
+                {
+                    bEOF = TRUE;
+                    break;
+                }
+                apoBatch[nBatchCount ++] =
+                    TranslateFromSrcLayer(poSrcFeature, iLayer,
+                                          papanReaderMaps[iLayer], nFID ++);
+                delete poSrcFeature;
+            }
+
+/* -------------------------------------------------------------------- */
+/*      Push it in the queue.                                           */
+/* -------------------------------------------------------------------- */
+            CPLAcquireMutex(hReaderMutex, 1000.0);
+            int i = 0;
+            while( i < nBatchCount )
+            {
+                while( nQueueCount == nQueueSize && !bStopReaders )
+                    CPLCondWait(hReaderCondNotFull, hReaderMutex);
+                if( bStopReaders )
+                {
+                    for( ; i < nBatchCount; i++ )
+                        delete apoBatch[i];
+                    bStop = TRUE;
+                    break;
+                }
+                for( ; i < nBatchCount && nQueueCount < nQueueSize; i++ )
+                {
+                    int iSlot = (nQueueFirst + nQueueCount) % nQueueSize;
+                    papoQueue[iSlot] = apoBatch[i];
+                    panQueueLayers[iSlot] = iLayer;
+                    nQueueCount ++;
+                }
+                CPLCondSignal(hReaderCondNotEmpty);
+            }
+
+/* -------------------------------------------------------------------- */
+/*      The features of a layer whose FID base is not known yet are     */
+/*      held back by the consumer, so bound how far we read ahead.      */
+/* -------------------------------------------------------------------- */
+            while( !bStopReaders && !bEOF && iLayer >= nKnownFIDBases &&
+                   nFID >= UNION_READER_MAX_PENDING )
+                CPLCondWait(hReaderCondNotFull, hReaderMutex);
+            if( bStopReaders )
+                bStop = TRUE;
+            CPLReleaseMutex(hReaderMutex);
+        }
+
+        CPLAcquireMutex(hReaderMutex, 1000.0);
+        if( !bStop )
+        {
+            if( panSrcLayerFeatureCount[iLayer] < 0 )
+            {
+                panSrcLayerFeatureCount[iLayer] = nFID;
+                if( !bPreserveSrcFID )
+                    UpdateKnownFIDBases();
+                CPLCondBroadcast(hReaderCondNotFull);
+                CPLCondSignal(hReaderCondNotEmpty);
+            }
+            else if( nFID != panSrcLayerFeatureCount[iLayer] )
+            {
+                CPLDebug("OGR", "Layer %s returned %ld features, but counted %ld. "
+                         "FIDs of layer %s may be inconsistent",
+                         poSrcLayer->GetName(), nFID,
+                         panSrcLayerFeatureCount[iLayer], osName.c_str());
+            }
+        }
+    }
+
+    nActiveReaders --;
+    CPLCondSignal(hReaderCondNotEmpty);
+    CPLReleaseMutex(hReaderMutex);
+}
+
+/************************************************************************/
+/*                         TakeQueuedFeatures()                         */
+/*                                                                      */
+/*      Move the queued features, and the held back features whose      */
+/*      FID base is now known, to the ready list, with their final      */
+/*      FID.  Must be called with the reader mutex held.                */
+/************************************************************************/
+
+void OGRUnionLayer::TakeQueuedFeatures()
+{
+    int nMaxReady = nReadyFeatures + nDeferredFeatures + nQueueCount;
+    if( nMaxReady > nReadyAlloc )
+    {
+        nReadyAlloc = nMaxReady;
+        papoReadyFeatures = (OGRFeature**)
+            CPLRealloc(papoReadyFeatures, nReadyAlloc * sizeof(OGRFeature*));
+    }
+    if( nDeferredFeatures + nQueueCount > nDeferredAlloc )
+    {
+        nDeferredAlloc = nDeferredFeatures + nQueueCount;
+        papoDeferredFeatures = (OGRFeature**)
+            CPLRealloc(papoDeferredFeatures, nDeferredAlloc * sizeof(OGRFeature*));
+        panDeferredLayers = (int*)
+            CPLRealloc(panDeferredLayers, nDeferredAlloc * sizeof(int));
+    }
+
+    int i, nKept = 0;
+    for( i = 0; i < nDeferredFeatures + nQueueCount; i++ )
+    {
+        OGRFeature* poFeature;
+        int iLayer;
+        if( i < nDeferredFeatures )
+        {
+            poFeature = papoDeferredFeatures[i];
+            iLayer = panDeferredLayers[i];
+        }
+        else
+        {
+            poFeature = papoQueue[nQueueFirst];
+            iLayer = panQueueLayers[nQueueFirst];
+            nQueueFirst = (nQueueFirst + 1) % nQueueSize;
+        }
+
+        if( iLayer < nKnownFIDBases )
+        {
+            if( !bPreserveSrcFID )
+                poFeature->SetFID(poFeature->GetFID() +
+                                  panSrcLayerFIDBase[iLayer]);
+            papoReadyFeatures[nReadyFeatures ++] = poFeature;
+        }
+        else
+        {
+            papoDeferredFeatures[nKept] = poFeature;
+            panDeferredLayers[nKept] = iLayer;
+            nKept ++;
+        }
+    }
+    nDeferredFeatures = nKept;
+    nQueueCount = 0;
+}
+
+/************************************************************************/
+/*                        GetNextFeatureParallel()                      */
+/************************************************************************/
+
+OGRFeature *OGRUnionLayer::GetNextFeatureParallel()
+{
+    while(TRUE)
+    {
+/* -------------------------------------------------------------------- */
+/*      Take all the queued features at once, to limit the contention   */
+/*      on the mutex.                                                   */
+/* -------------------------------------------------------------------- */
+        if( iReadyFeature == nReadyFeatures )
+        {
+            nReadyFeatures = 0;
+            iReadyFeature = 0;
+
+            CPLAcquireMutex(hReaderMutex, 1000.0);
+            while( TRUE )
+            {
+                /* The readers must be woken up even if all the taken */
+                /* features are held back */
+                TakeQueuedFeatures();
+                CPLCondBroadcast(hReaderCondNotFull);
+                if( nReadyFeatures > 0 || nActiveReaders == 0 )
+                    break;
+                CPLCondWait(hReaderCondNotEmpty, hReaderMutex);
+            }
+            CPLReleaseMutex(hReaderMutex);
+
+            if( nReadyFeatures == 0 )
+            {
+                StopParallelReading();
+                iCurLayer = nSrcLayers;
+                return NULL;
+            }
+        }
+
+        OGRFeature* poFeature = papoReadyFeatures[iReadyFeature];
+        papoReadyFeatures[iReadyFeature ++] = NULL;
+
+        /* The union level filters are evaluated here, as the prepared */
+        /* filter geometry must not be used by several threads */
+        if( (m_poFilterGeom == NULL ||
+             FilterGeometry( poFeature->GetGeometryRef() ) ) &&
+            (m_poAttrQuery == NULL ||
+             m_poAttrQuery->Evaluate( poFeature )) )
+        {
+            return poFeature;
+        }
+
+        delete poFeature;
+    }
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
@@ -535,6 +1157,8 @@ OGRFeature *OGRUnionLayer::GetFeature( long nFeatureId )
     if( !bPreserveSrcFID )
         return OGRLayer::GetFeature(nFeatureId);
 
+    StopParallelReading();
+
     for(int i=0;i<nSrcLayers;i++)
     {
         iCurLayer = i;
@@ -543,7 +1167,8 @@ OGRFeature *OGRUnionLayer::GetFeature( long nFeatureId )
         OGRFeature* poSrcFeature = papoSrcLayers[i]->GetFeature(nFeatureId);
         if( poSrcFeature != NULL )
         {
-            OGRFeature* poFeature = TranslateFromSrcLayer(poSrcFeature);
+            OGRFeature* poFeature = TranslateFromSrcLayer(poSrcFeature, i,
+                                                          panMap, nNextFID);
             delete poSrcFeature;
 
             return poFeature;
@@ -583,6 +1208,10 @@ OGRErr OGRUnionLayer::CreateFeature( OGRFeature* poFeature )
         return OGRERR_FAILURE;
     }
 
+    StopParallelReading();
+    CPLFree(panSrcLayerFeatureCount);
+    panSrcLayerFeatureCount = NULL;
+
     const char* pszSrcLayerName = poFeature->GetFieldAsString(0);
     for(int i=0;i<nSrcLayers;i++)
     {
@@ -642,6 +1271,10 @@ OGRErr OGRUnionLayer::SetFeature( OGRFeature* poFeature )
         return OGRERR_FAILURE;
     }
 
+    StopParallelReading();
+    CPLFree(panSrcLayerFeatureCount);
+    panSrcLayerFeatureCount = NULL;
+
     const char* pszSrcLayerName = poFeature->GetFieldAsString(0);
     for(int i=0;i<nSrcLayers;i++)
     {
@@ -754,14 +1387,24 @@ int OGRUnionLayer::GetFeatureCount( int bForce )
     if( !GetAttrFilterPassThroughValue() )
         return OGRLayer::GetFeatureCount(bForce);
 
-    int nRet = 0;
-    for(int i = 0; i < nSrcLayers; i++)
+    StopParallelReading();
+
+    int i;
+    for(i = 0; i < nSrcLayers; i++)
     {
         AutoWarpLayerIfNecessary(i);
         ApplyAttributeFilterToSrcLayer(i);
         papoSrcLayers[i]->SetSpatialFilter(m_poFilterGeom);
-        nRet += papoSrcLayers[i]->GetFeatureCount(bForce);
     }
+
+    int* panCounts = (int*) CPLMalloc(nSrcLayers * sizeof(int));
+    RunSrcLayerJob(FALSE, bForce, panCounts, NULL, NULL);
+
+    int nRet = 0;
+    for(i = 0; i < nSrcLayers; i++)
+        nRet += panCounts[i];
+    CPLFree(panCounts);
+
     ResetReading();
     return nRet;
 }
@@ -780,6 +1423,10 @@ OGRErr OGRUnionLayer::SetAttributeFilter( const char * pszAttributeFilterIn )
 
     if( poFeatureDefn == NULL ) GetLayerDefn();
 
+    StopParallelReading();
+    CPLFree(panSrcLayerFeatureCount);
+    panSrcLayerFeatureCount = NULL;
+
     bAttrFilterPassThroughValue = -1;
 
     OGRErr eErr = OGRLayer::SetAttributeFilter(pszAttributeFilterIn);
@@ -811,6 +1458,8 @@ int  OGRUnionLayer::TestCapability( const char * pszCap )
         if( !GetAttrFilterPassThroughValue() )
             return FALSE;
 
+        StopParallelReading();
+
         for(int i = 0; i < nSrcLayers; i++)
         {
             AutoWarpLayerIfNecessary(i);
@@ -827,6 +1476,8 @@ int  OGRUnionLayer::TestCapability( const char * pszCap )
         if( sStaticEnvelope.IsInit() )
             return TRUE;
 
+        StopParallelReading();
+
         for(int i = 0; i < nSrcLayers; i++)
         {
             AutoWarpLayerIfNecessary(i);
@@ -838,6 +1489,8 @@ int  OGRUnionLayer::TestCapability( const char * pszCap )
 
     if( EQUAL(pszCap, OLCFastSpatialFilter) )
     {
+        StopParallelReading();
+
         for(int i = 0; i < nSrcLayers; i++)
         {
             AutoWarpLayerIfNecessary(i);
@@ -934,24 +1587,33 @@ OGRErr OGRUnionLayer::GetExtent( OGREnvelope *psExtent, int bForce )
         return OGRERR_NONE;
     }
 
+    StopParallelReading();
+
+    int i;
+    for(i = 0; i < nSrcLayers; i++)
+        AutoWarpLayerIfNecessary(i);
+
+    OGREnvelope* pasExtents = new OGREnvelope[nSrcLayers];
+    OGRErr* paeErrors = (OGRErr*) CPLMalloc(nSrcLayers * sizeof(OGRErr));
+    RunSrcLayerJob(TRUE, bForce, NULL, pasExtents, paeErrors);
+
     int bInit = FALSE;
-    for(int i = 0; i < nSrcLayers; i++)
+    for(i = 0; i < nSrcLayers; i++)
     {
-        AutoWarpLayerIfNecessary(i);
+        if( paeErrors[i] != OGRERR_NONE )
+            continue;
         if( !bInit )
         {
-            if( papoSrcLayers[i]->GetExtent(psExtent, bForce) == OGRERR_NONE )
-                bInit = TRUE;
+            memcpy(psExtent, &pasExtents[i], sizeof(OGREnvelope));
+            bInit = TRUE;
         }
         else
-        {
-            OGREnvelope sExtent;
-            if( papoSrcLayers[i]->GetExtent(&sExtent, bForce) == OGRERR_NONE )
-            {
-                psExtent->Merge(sExtent);
-            }
-        }
+            psExtent->Merge(pasExtents[i]);
     }
+
+    delete[] pasExtents;
+    CPLFree(paeErrors);
+
     return (bInit) ? OGRERR_NONE : OGRERR_FAILURE;
 }
 
@@ -961,6 +1623,10 @@ OGRErr OGRUnionLayer::GetExtent( OGREnvelope *psExtent, int bForce )
 
 void OGRUnionLayer::SetSpatialFilter( OGRGeometry * poGeomIn )
 {
+    StopParallelReading();
+    CPLFree(panSrcLayerFeatureCount);
+    panSrcLayerFeatureCount = NULL;
+
     OGRLayer::SetSpatialFilter(poGeomIn);
 
     if( iCurLayer >= 0 && iCurLayer < nSrcLayers)
@@ -986,18 +1652,21 @@ void OGRUnionLayer::SetSpatialFilter( int iGeomField, OGRGeometry *poGeom )
 /*                        TranslateFromSrcLayer()                       */
 /************************************************************************/
 
-OGRFeature* OGRUnionLayer::TranslateFromSrcLayer(OGRFeature* poSrcFeature)
+OGRFeature* OGRUnionLayer::TranslateFromSrcLayer(OGRFeature* poSrcFeature,
+                                                 int iSubLayer,
+                                                 const int* panMapIn,
+                                                 long nFID)
 {
-    CPLAssert(panMap != NULL);
-    CPLAssert(iCurLayer >= 0 && iCurLayer < nSrcLayers);
+    CPLAssert(panMapIn != NULL);
+    CPLAssert(iSubLayer >= 0 && iSubLayer < nSrcLayers);
 
     OGRFeature* poFeature = new OGRFeature(poFeatureDefn);
-    poFeature->SetFrom(poSrcFeature, panMap, TRUE);
+    poFeature->SetFrom(poSrcFeature, (int*)panMapIn, TRUE);
 
     if( osSourceLayerFieldName.size() &&
         !poFeatureDefn->GetFieldDefn(0)->IsIgnored() )
     {
-        poFeature->SetField(0, papoSrcLayers[iCurLayer]->GetName());
+        poFeature->SetField(0, papoSrcLayers[iSubLayer]->GetName());
     }
 
     if( poFeatureDefn->IsGeometryIgnored() )
@@ -1012,7 +1681,7 @@ OGRFeature* OGRUnionLayer::TranslateFromSrcLayer(OGRFeature* poSrcFeature)
     if( bPreserveSrcFID )
         poFeature->SetFID(poSrcFeature->GetFID());
     else
-        poFeature->SetFID(nNextFID ++);
+        poFeature->SetFID(nFID);
     return poFeature;
 }
 
@@ -1022,6 +1691,8 @@ OGRFeature* OGRUnionLayer::TranslateFromSrcLayer(OGRFeature* poSrcFeature)
 
 OGRErr OGRUnionLayer::SetIgnoredFields( const char **papszFields )
 {
+    StopParallelReading();
+
     OGRErr eErr = OGRLayer::SetIgnoredFields(papszFields);
     if( eErr != OGRERR_NONE )
         return eErr;
@@ -1038,6 +1709,8 @@ OGRErr OGRUnionLayer::SetIgnoredFields( const char **papszFields )
 
 OGRErr OGRUnionLayer::SyncToDisk()
 {
+    StopParallelReading();
+
     for(int i = 0; i < nSrcLayers; i++)
     {
         if (pabModifiedLayers[i])
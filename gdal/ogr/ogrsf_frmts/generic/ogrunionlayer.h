@@ -85,12 +85,57 @@ class OGRUnionLayer : public OGRLayer
     int                *pabModifiedLayers;
     int                *pabCheckIfAutoWrap;
 
+    /* Parallel reading state, only used when nNumThreads > 1 */
+    int                 nNumThreads;
+    int                 bParallelReading;
+    void               *hReaderMutex;
+    void               *hReaderCondNotEmpty;
+    void               *hReaderCondNotFull;
+    int                 nReaderThreads;
+    void              **pahReaderThreads;
+    int                 nActiveReaders;
+    int                 bStopReaders;
+    int                 nNextLayerToRead;
+    int               **papanReaderMaps;
+    OGRFeature        **papoQueue;
+    int                *panQueueLayers;
+    int                 nQueueSize;
+    int                 nQueueFirst;
+    int                 nQueueCount;
+    OGRFeature        **papoDeferredFeatures;
+    int                *panDeferredLayers;
+    int                 nDeferredFeatures;
+    int                 nDeferredAlloc;
+    OGRFeature        **papoReadyFeatures;
+    int                 nReadyFeatures;
+    int                 nReadyAlloc;
+    int                 iReadyFeature;
+    long               *panSrcLayerFIDBase;
+    int                 nKnownFIDBases;
+    long               *panSrcLayerFeatureCount; /* kept until the filters change */
+
     void                AutoWarpLayerIfNecessary(int iSubLayer);
-    OGRFeature         *TranslateFromSrcLayer(OGRFeature* poSrcFeature);
+    OGRFeature         *TranslateFromSrcLayer(OGRFeature* poSrcFeature,
+                                              int iSubLayer,
+                                              const int* panMapIn,
+                                              long nFID);
     void                ApplyAttributeFilterToSrcLayer(int iSubLayer);
     int                 GetAttrFilterPassThroughValue();
+    int                *ConfigureSrcLayer(int iSubLayer);
     void                ConfigureActiveLayer();
 
+    void                RunSrcLayerJob(int bExtent, int bForce,
+                                       int* panCounts,
+                                       OGREnvelope* pasExtents,
+                                       OGRErr* paeErrors);
+    void                UpdateKnownFIDBases();
+    void                TakeQueuedFeatures();
+    int                 StartParallelReading();
+    void                StopParallelReading();
+    void                ReadSrcLayers();
+    static void         ReaderThreadFunc(void* pData);
+    OGRFeature         *GetNextFeatureParallel();
+
   public:
                         OGRUnionLayer( const char* pszName,
                                        int nSrcLayers, /* must be >= 1 */
@@ -111,6 +156,7 @@ class OGRUnionLayer : public OGRLayer
     void                SetPreserveSrcFID(int bPreserveSrcFID);
     void                SetFeatureCount(int nFeatureCount);
     void                SetExtent(double dfXMin, double dfYMin, double dfXMax, double dfYMax);
+    void                SetNumThreads(int nNumThreads);
 
     virtual const char  *GetName() { return osName.c_str(); }
     virtual OGRwkbGeometryType GetGeomType();
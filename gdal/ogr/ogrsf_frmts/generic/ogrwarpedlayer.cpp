@@ -214,6 +214,27 @@ OGRFeature *OGRWarpedLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/*                                                                      */
+/*      Do not forward to the decorated layer, whose features must be   */
+/*      warped.                                                         */
+/************************************************************************/
+
+int OGRWarpedLayer::GetNextFeatureInto( OGRFeature *poFeature )
+{
+    return OGRLayer::GetNextFeatureInto(poFeature);
+}
+
+/************************************************************************/
+/*                            GetNextBatch()                            */
+/************************************************************************/
+
+int OGRWarpedLayer::GetNextBatch( OGRFeatureBatch *poBatch )
+{
+    return OGRLayer::GetNextBatch(poBatch);
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
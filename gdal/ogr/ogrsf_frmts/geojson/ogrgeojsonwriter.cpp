@@ -33,6 +33,7 @@
 #include <json_object_private.h>
 #include <printbuf.h>
 #include <ogr_api.h>
+#include "ogr_p.h"
 
 /************************************************************************/
 /*                           OGRGeoJSONWriteFeature                     */
@@ -675,8 +676,15 @@ static int OGR_json_double_with_precision_to_string(struct json_object *jso,
 {
     char szBuffer[75]; 
     int nPrecision = (int) (size_t) jso->_userdata;
-    int ret = json_OGRFormatDouble( szBuffer, sizeof(szBuffer), jso->o.c_double, '.', 
-                                   (nPrecision < 0) ? 15 : nPrecision ); 
+    int ret;
+    /* Without explicit precision, optionally write the shortest exact */
+    /* representation */
+    if( nPrecision < 0 && OGRUseDoubleRoundTripFormat() )
+        ret = OGRFormatDoubleRoundTrip( szBuffer, sizeof(szBuffer),
+                                        jso->o.c_double );
+    else
+        ret = json_OGRFormatDouble( szBuffer, sizeof(szBuffer), jso->o.c_double, '.', 
+                                    (nPrecision < 0) ? 15 : nPrecision ); 
     if (ret < 0) 
         return ret; 
     return printbuf_memappend(pb, szBuffer, ret); 
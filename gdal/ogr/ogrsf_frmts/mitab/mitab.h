@@ -666,6 +666,9 @@ class MIFFile: public IMapInfoFile
     int         m_nRegions;
     int         m_nTexts;
 
+    long        *m_panMatchingFIDs; // candidates from the generic spatial index
+    int         m_iMatchingFID;
+
     int         m_nPreloadedId;  // preloaded mif line is for this feature id
     MIDDATAFile  *m_poMIDFile;   // Mid file
     MIDDATAFile  *m_poMIFFile;   // Mif File
@@ -721,6 +721,55 @@ GInt32 TABINDFile::FindNext(int nIndexNumber, GByte *pKeyValue)
 }
 
 
+/**********************************************************************
+ *                   TABINDFile::FindFirstInRange()
+ *
+ * Start an ordered traversal of one of the indexes, returning the first
+ * entry whose key is >= pKeyMin and <= pKeyMax.  Keys are compared as
+ * built by BuildKey(), i.e. byte by byte.  Since BuildKey() returns an
+ * internal buffer, pKeyMin and pKeyMax must be copies owned by the caller.
+ *
+ * Note that index numbers are positive values starting at 1.
+ *
+ * Return value:
+ *  - the key's corresponding record number in the .DAT file (greater than 0)
+ *  - 0 if there is no key in the range
+ *  - or -1 if an error happened
+ **********************************************************************/
+GInt32 TABINDFile::FindFirstInRange(int nIndexNumber, GByte *pKeyMin,
+                                    GByte *pKeyMax)
+{
+    if (ValidateIndexNo(nIndexNumber) != 0)
+        return -1;
+
+    return m_papoIndexRootNodes[nIndexNumber-1]->FindFirstInRange(pKeyMin,
+                                                                  pKeyMax);
+}
+
+/**********************************************************************
+ *                   TABINDFile::FindNextInRange()
+ *
+ * Continue the traversal previously initiated by FindFirstInRange(),
+ * returning the next entry in key order as long as its key is <= pKeyMax.
+ * NOTE: FindFirstInRange() MUST have been previously called for this
+ *       call to work...
+ *
+ * Note that index numbers are positive values starting at 1.
+ *
+ * Return value:
+ *  - the key's corresponding record number in the .DAT file (greater than 0)
+ *  - 0 if there are no more keys in the range
+ *  - or -1 if an error happened
+ **********************************************************************/
+GInt32 TABINDFile::FindNextInRange(int nIndexNumber, GByte *pKeyMax)
+{
+    if (ValidateIndexNo(nIndexNumber) != 0)
+        return -1;
+
+    return m_papoIndexRootNodes[nIndexNumber-1]->FindNextInRange(pKeyMax);
+}
+
+
 /**********************************************************************
  *                   TABINDFile::CreateIndex()
  *
@@ -1413,6 +1462,158 @@ GInt32 TABINDNode::FindNext(GByte *pKeyValue)
 }
 
 
+/**********************************************************************
+ *                   TABINDNode::FindFirstInRange()
+ *
+ * Start an ordered traversal in this node and its children, positioning
+ * on the first entry whose key is >= pKeyMin.
+ *
+ * Unlike FindFirst(), this does not rely on the search being confined
+ * to a single leaf node: leaf nodes are chained together, so when the
+ * end of a leaf is reached we simply continue with the next one.  This
+ * is also what lets FindNextInRange() walk the keys in order.
+ *
+ * Return value:
+ *  - the corresponding record number in the .DAT file (greater than 0)
+ *    if that first entry is also <= pKeyMax
+ *  - 0 if there is no key in the range
+ *  - or -1 if an error happened
+ **********************************************************************/
+GInt32 TABINDNode::FindFirstInRange(GByte *pKeyMin, GByte *pKeyMax)
+{
+    if (m_poDataBlock == NULL)
+    {
+        CPLError(CE_Failure, CPLE_AssertionFailed,
+                 "TABINDNode::Search(): Node has not been initialized yet!");
+        return -1;
+    }
+
+    m_nCurIndexEntry = 0;
+
+    if (m_nSubTreeDepth == 1)
+    {
+        /*-------------------------------------------------------------
+         * Leaf node level... skip the entries < pKeyMin, possibly
+         * moving on to the next nodes in the chain.
+         *------------------------------------------------------------*/
+        while(TRUE)
+        {
+            while(m_nCurIndexEntry < m_numEntriesInNode &&
+                  IndexKeyCmp(pKeyMin, m_nCurIndexEntry) > 0)
+                m_nCurIndexEntry++;
+
+            if (m_nCurIndexEntry < m_numEntriesInNode)
+                break;
+
+            if (m_nNextNodePtr <= 0)
+                return 0;
+            if (GotoNodePtr(m_nNextNodePtr) != 0)
+                return -1;
+            m_nCurIndexEntry = 0;
+        }
+
+        if (IndexKeyCmp(pKeyMax, m_nCurIndexEntry) < 0)
+            return 0;
+
+        return ReadIndexEntry(m_nCurIndexEntry, NULL);
+    }
+
+    /*-----------------------------------------------------------------
+     * Index Node: the key of each entry is the first key of its child
+     * node, so we descend in the last child whose first key is
+     * < pKeyMin (or the first child).  With non-unique indexes, keys
+     * equal to pKeyMin may be found at the end of that child.
+     *----------------------------------------------------------------*/
+    if (m_numEntriesInNode == 0)
+        return 0;
+
+    while(m_nCurIndexEntry+1 < m_numEntriesInNode &&
+          IndexKeyCmp(pKeyMin, m_nCurIndexEntry+1) > 0)
+        m_nCurIndexEntry++;
+
+    int nChildNodePtr = ReadIndexEntry(m_nCurIndexEntry, NULL);
+    if (nChildNodePtr == 0)
+    {
+        /* Invalid child node??? */
+        return 0;
+    }
+    else if (m_poCurChildNode == NULL)
+    {
+        /* Child node has never been initialized...do it now!*/
+
+        m_poCurChildNode = new TABINDNode(m_eAccessMode);
+        if ( m_poCurChildNode->InitNode(m_fp, nChildNodePtr, 
+                                        m_nKeyLength, 
+                                        m_nSubTreeDepth-1,
+                                        m_bUnique,
+                                        m_poBlockManagerRef, 
+                                        this) != 0 ||
+             m_poCurChildNode->SetFieldType(m_eFieldType)!=0)
+        {
+            // An error happened... and was already reported
+            return -1;
+        }
+    }
+
+    if (m_poCurChildNode->GotoNodePtr(nChildNodePtr) != 0)
+    {
+        // An error happened and has already been reported
+        return -1;
+    }
+
+    return m_poCurChildNode->FindFirstInRange(pKeyMin, pKeyMax);
+}
+
+/**********************************************************************
+ *                   TABINDNode::FindNextInRange()
+ *
+ * Continue the traversal previously started by FindFirstInRange(),
+ * moving to the next entry in key order.
+ *
+ * Return value:
+ *  - the corresponding record number in the .DAT file (greater than 0)
+ *    if the next entry is <= pKeyMax
+ *  - 0 if there are no more keys in the range
+ *  - or -1 if an error happened
+ **********************************************************************/
+GInt32 TABINDNode::FindNextInRange(GByte *pKeyMax)
+{
+    if (m_poDataBlock == NULL)
+    {
+        CPLError(CE_Failure, CPLE_AssertionFailed,
+                 "TABINDNode::Search(): Node has not been initialized yet!");
+        return -1;
+    }
+
+    if (m_nSubTreeDepth == 1)
+    {
+        m_nCurIndexEntry++;
+        while (m_nCurIndexEntry >= m_numEntriesInNode)
+        {
+            // We're at the end of a node ... continue with next node
+            if (m_nNextNodePtr <= 0)
+                return 0;
+            if (GotoNodePtr(m_nNextNodePtr) != 0)
+                return -1;
+            m_nCurIndexEntry = 0;
+        }
+
+        if (IndexKeyCmp(pKeyMax, m_nCurIndexEntry) < 0)
+            return 0;
+
+        return ReadIndexEntry(m_nCurIndexEntry, NULL);
+    }
+
+    /*-----------------------------------------------------------------
+     * Index Node: just pass the search to the child node.
+     *----------------------------------------------------------------*/
+    if (m_poCurChildNode != NULL)
+        return m_poCurChildNode->FindNextInRange(pKeyMax);
+
+    return 0;
+}
+
+
 /**********************************************************************
  *                   TABINDNode::CommitToFile()
  *
@@ -192,6 +192,7 @@
 
 #include "mitab.h"
 #include "mitab_utils.h"
+#include "ogr_spatialind.h"
 #include <ctype.h>
 
 /*=====================================================================
@@ -245,6 +246,9 @@ MIFFile::MIFFile()
     m_nPoints = m_nLines = m_nRegions = m_nTexts = 0;
 
     m_bExtentsSet = FALSE;
+
+    m_panMatchingFIDs = NULL;
+    m_iMatchingFID = 0;
 }
 
 /**********************************************************************
@@ -468,6 +472,21 @@ int MIFFile::Open(const char *pszFname, const char *pszAccess,
         m_poDefn->Reference();
     }
 
+    /*-----------------------------------------------------------------
+     * MIF files have no spatial index of their own, but with the
+     * generic one spatial filters can skip to the matching features
+     * without parsing the geometry of the others.
+     *----------------------------------------------------------------*/
+    if (m_eAccessMode == TABRead)
+    {
+        pszTmpFname = CPLStrdup(m_pszFname);
+#ifndef _WIN32
+        TABAdjustFilenameExtension(pszTmpFname);
+#endif
+        InitializeSpatialIndexSupport(pszTmpFname);
+        CPLFree(pszTmpFname);
+    }
+
     return 0;
 }
 
@@ -1188,6 +1207,10 @@ int MIFFile::Close()
         m_poCurFeature = NULL;
     }
 
+    CPLFree(m_panMatchingFIDs);
+    m_panMatchingFIDs = NULL;
+    m_iMatchingFID = 0;
+
     /*-----------------------------------------------------------------
      * Note: we have to check the reference count before deleting 
      * m_poSpatialRef and m_poDefn
@@ -1249,6 +1272,31 @@ int MIFFile::GetNextFeatureId(int nPrevId)
         return -1;
     }
 
+    /*-----------------------------------------------------------------
+     * Use the generic spatial index if there is one for the current
+     * spatial filter.  The list of candidates is established again at
+     * the start of each read pass, since GotoFeature() may call
+     * ResetReading() on its own.
+     *----------------------------------------------------------------*/
+    if (m_poFilterGeom != NULL && m_poSpatialIndex != NULL &&
+        m_poSpatialIndex->IsBuilt())
+    {
+        if (nPrevId <= 0 || m_panMatchingFIDs == NULL)
+        {
+            CPLFree(m_panMatchingFIDs);
+            m_iMatchingFID = 0;
+            m_panMatchingFIDs =
+                m_poSpatialIndex->GetMatches(&m_sFilterEnvelope, NULL);
+        }
+        if (m_panMatchingFIDs != NULL)
+        {
+            if (m_panMatchingFIDs[m_iMatchingFID] == OGRNullFID)
+                return -1;
+
+            return (int) m_panMatchingFIDs[m_iMatchingFID++];
+        }
+    }
+
     if (nPrevId <= 0 && m_poMIFFile->GetLastLine() != NULL)
         return 1;       // Feature Ids start at 1
     else if (nPrevId > 0 && m_poMIFFile->GetLastLine() != NULL)
@@ -2261,7 +2309,7 @@ int MIFFile::TestCapability( const char * pszCap )
         return m_bPreParsed;
 
     else if( EQUAL(pszCap,OLCFastSpatialFilter) )
-        return FALSE;
+        return m_poSpatialIndex != NULL && m_poSpatialIndex->IsBuilt();
 
     else if( EQUAL(pszCap,OLCFastGetExtent) )
         return m_bPreParsed;
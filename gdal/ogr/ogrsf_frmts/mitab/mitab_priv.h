@@ -1505,6 +1505,8 @@ class TABINDNode
 
     GInt32      FindFirst(GByte *pKeyValue);
     GInt32      FindNext(GByte *pKeyValue);
+    GInt32      FindFirstInRange(GByte *pKeyMin, GByte *pKeyMax);
+    GInt32      FindNextInRange(GByte *pKeyMax);
 
     int         CommitToFile();
 
@@ -1572,6 +1574,9 @@ class TABINDFile
     GByte      *BuildKey(int nIndexNumber, double dValue);
     GInt32      FindFirst(int nIndexNumber, GByte *pKeyValue);
     GInt32      FindNext(int nIndexNumber, GByte *pKeyValue);
+    GInt32      FindFirstInRange(int nIndexNumber, GByte *pKeyMin,
+                                 GByte *pKeyMax);
+    GInt32      FindNextInRange(int nIndexNumber, GByte *pKeyMax);
 
     int         CreateIndex(TABFieldType eType, int nFieldSize);
     int         AddEntry(int nIndexNumber, GByte *pKeyValue, GInt32 nRecordNo);
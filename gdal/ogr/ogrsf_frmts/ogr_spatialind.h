@@ -0,0 +1,75 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Generic persistent spatial index for layers without a native one.
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef _OGR_SPATIALIND_H_INCLUDED
+#define _OGR_SPATIALIND_H_INCLUDED
+
+#include "ogrsf_frmts.h"
+
+/************************************************************************/
+/*                         OGRLayerSpatialIndex                         */
+/*                                                                      */
+/*      Packed Hilbert R-tree of the (envelope, FID) pairs of the       */
+/*      first geometry field of a layer, stored in a .ogrsidx          */
+/*      sidecar file next to the data file.  Features without           */
+/*      geometry are not indexed.                                       */
+/************************************************************************/
+
+class CPL_DLL OGRLayerSpatialIndex
+{
+    OGRLayer    *poLayer;
+    char        *pszDataFilename;
+    char        *pszIndexFilename;
+
+    int          nNodeSize;
+    int          nItemCount;
+    int          nLevelCount;
+    int         *panLevelStart;
+    double      *padfBoxes;     /* MinX, MinY, MaxX, MaxY of every node */
+    GIntBig     *panItemFIDs;
+
+    void         Clear();
+    OGRErr       Load();
+    OGRErr       Save( GIntBig nDataSize, GIntBig nDataMTime );
+    void         ComputeLevels();
+
+public:
+                OGRLayerSpatialIndex();
+               ~OGRLayerSpatialIndex();
+
+    OGRErr      Initialize( const char *pszDataFilename, OGRLayer * );
+
+    const char *GetIndexFilename() { return pszIndexFilename; }
+    int         IsBuilt() { return nItemCount > 0; }
+
+    OGRErr      IndexAllFeatures( int nNodeSizeIn = 16 );
+    OGRErr      DropIndex();
+
+    long       *GetMatches( const OGREnvelope *psEnvelope, int *pnFIDCount );
+};
+
+#endif /* ndef _OGR_SPATIALIND_H_INCLUDED */
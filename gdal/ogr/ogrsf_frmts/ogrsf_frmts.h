@@ -41,6 +41,7 @@
  */
 
 class OGRLayerAttrIndex;
+class OGRLayerSpatialIndex;
 class OGRSFDriver;
 
 /************************************************************************/
@@ -57,10 +58,13 @@ class OGRSFDriver;
 
 class CPL_DLL OGRLayer
 {
+    friend class OGRLayerSpatialIndex;
+
   protected:
     int          m_bFilterIsEnvelope;
     OGRGeometry *m_poFilterGeom;
     OGRPreparedGeometry *m_pPreparedFilterGeom; /* m_poFilterGeom compiled as a prepared geometry */
+    int          m_bPreparedFilterGeomTried; /* OGRCreatePreparedGeometry() already called */
     OGREnvelope  m_sFilterEnvelope;
     int          m_iGeomFieldFilter; // specify the index on which the spatial
                                      // filter is active.
@@ -68,6 +72,7 @@ class CPL_DLL OGRLayer
     int          FilterGeometry( OGRGeometry * );
     //int          FilterGeometry( OGRGeometry *, OGREnvelope* psGeometryEnvelope);
     int          InstallFilter( OGRGeometry * );
+    OGRPreparedGeometry *GetPreparedFilterGeom();
     
     OGRErr       GetExtentInternal(int iGeomField, OGREnvelope *psExtent, int bForce );
 
@@ -89,6 +94,8 @@ class CPL_DLL OGRLayer
 
     virtual void        ResetReading() = 0;
     virtual OGRFeature *GetNextFeature() = 0;
+    virtual int         GetNextFeatureInto( OGRFeature *poFeature );
+    virtual int         GetNextBatch( OGRFeatureBatch *poBatch );
     virtual OGRErr      SetNextByIndex( long nIndex );
     virtual OGRFeature *GetFeature( long nFID );
     virtual OGRErr      SetFeature( OGRFeature *poFeature );
@@ -186,11 +193,14 @@ class CPL_DLL OGRLayer
     /* consider these private */
     OGRErr               InitializeIndexSupport( const char * );
     OGRLayerAttrIndex   *GetIndex() { return m_poAttrIndex; }
+    OGRErr               InitializeSpatialIndexSupport( const char * );
+    OGRLayerSpatialIndex *GetSpatialIndex() { return m_poSpatialIndex; }
 
  protected:
     OGRStyleTable       *m_poStyleTable;
     OGRFeatureQuery     *m_poAttrQuery;
     OGRLayerAttrIndex   *m_poAttrIndex;
+    OGRLayerSpatialIndex *m_poSpatialIndex;
 
     int                  m_nRefCount;
 
@@ -272,6 +282,8 @@ class CPL_DLL OGRDataSource
 
     OGRErr              ProcessSQLCreateIndex( const char * );
     OGRErr              ProcessSQLDropIndex( const char * );
+    OGRErr              ProcessSQLCreateSpatialIndex( const char * );
+    OGRErr              ProcessSQLDropSpatialIndex( const char * );
     OGRErr              ProcessSQLDropTable( const char * );
     OGRErr              ProcessSQLAlterTableAddColumn( const char * );
     OGRErr              ProcessSQLAlterTableDropColumn( const char * );
@@ -1715,7 +1715,7 @@ void OGROSMDataSource::ProcessWaysBatch()
         poLS = new OGRLineString();
         poGeom = poLS;
 
-        poLS->setNumPoints((int)nFound);
+        poLS->setNumPoints((int)nFound, FALSE);
         for(i=0;i<nFound;i++)
         {
             poLS->setPoint(i,
@@ -2220,7 +2220,7 @@ OGRGeometry* OGROSMDataSource::BuildMultiPolygon(OSMRelation* psRelation,
                 poMLS->addGeometryDirectly(poLS);
             }
 
-            poLS->setNumPoints(nPoints);
+            poLS->setNumPoints(nPoints, FALSE);
             for(int j=0;j<nPoints;j++)
             {
                 poLS->setPoint( j,
@@ -2343,7 +2343,7 @@ OGRGeometry* OGROSMDataSource::BuildGeometryCollection(OSMRelation* psRelation,
             poLS = new OGRLineString();
             poColl->addGeometryDirectly(poLS);
 
-            poLS->setNumPoints(nPoints);
+            poLS->setNumPoints(nPoints, FALSE);
             for(int j=0;j<nPoints;j++)
             {
                 poLS->setPoint( j,
@@ -2562,7 +2562,7 @@ void OGROSMDataSource::ProcessPolygonsStandalone()
             poPoly->addRingDirectly(poRing);
             poLS = poRing;
 
-            poLS->setNumPoints(nPoints);
+            poLS->setNumPoints(nPoints, FALSE);
             for(int j=0;j<nPoints;j++)
             {
                 poLS->setPoint( j,
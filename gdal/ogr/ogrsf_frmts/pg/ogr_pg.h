@@ -197,8 +197,9 @@ class OGRPGLayer : public OGRLayer
 
     int                 ReadResultDefinition(PGresult *hInitialResultIn);
 
-    OGRFeature         *RecordToFeature( int iRecord );
-    OGRFeature         *GetNextRawFeature();
+    OGRFeature         *RecordToFeature( int iRecord,
+                                         OGRFeature *poFeatureToFill = NULL );
+    OGRFeature         *GetNextRawFeature( OGRFeature *poFeatureToFill = NULL );
 
   public:
                         OGRPGLayer();
@@ -280,6 +281,8 @@ class OGRPGTableLayer : public OGRPGLayer
     int                 bCreateSpatialIndexFlag;
     int                 bInResetReading;
 
+    OGRFeature         *GetNextFeatureInternal( OGRFeature *poFeatureToFill );
+
     virtual CPLString   GetFromClauseForGetExtent() { return pszSqlTableName; }
 
 public:
@@ -297,6 +300,7 @@ public:
     virtual OGRFeature *GetFeature( long nFeatureId );
     virtual void        ResetReading();
     virtual OGRFeature *GetNextFeature();
+    virtual int         GetNextFeatureInto( OGRFeature *poFeature );
     virtual int         GetFeatureCount( int );
 
     virtual void        SetSpatialFilter( OGRGeometry *poGeom ) { SetSpatialFilter(0, poGeom); }
@@ -360,6 +364,8 @@ class OGRPGResultLayer : public OGRPGLayer
     char                *pszGeomTableSchemaName;
 
     CPLString           osWHERE;
+
+    OGRFeature         *GetNextFeatureInternal( OGRFeature *poFeatureToFill );
     
     virtual CPLString   GetFromClauseForGetExtent()
         { CPLString osStr("(");
@@ -380,6 +386,7 @@ class OGRPGResultLayer : public OGRPGLayer
     virtual int         TestCapability( const char * );
 
     virtual OGRFeature *GetNextFeature();
+    virtual int         GetNextFeatureInto( OGRFeature *poFeature );
 
     virtual void        ResolveSRID(OGRPGGeomFieldDefn* poGFldDefn);
 };
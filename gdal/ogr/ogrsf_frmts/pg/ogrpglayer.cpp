@@ -555,17 +555,28 @@ static char ** OGRPGTokenizeStringListFromText(const char* pszText)
 /*                          RecordToFeature()                           */
 /*                                                                      */
 /*      Convert the indicated record of the current result set into     */
-/*      a feature.                                                      */
+/*      a feature.  If poFeatureToFill is not NULL, it is reset and     */
+/*      filled rather than a new feature being created.                 */
 /************************************************************************/
 
-OGRFeature *OGRPGLayer::RecordToFeature( int iRecord )
+OGRFeature *OGRPGLayer::RecordToFeature( int iRecord,
+                                         OGRFeature *poFeatureToFill )
 
 {
 /* -------------------------------------------------------------------- */
-/*      Create a feature from the current result.                       */
+/*      Create a feature from the current result, or recycle the one    */
+/*      we were given.                                                  */
 /* -------------------------------------------------------------------- */
     int         iField;
-    OGRFeature *poFeature = new OGRFeature( poFeatureDefn );
+    OGRFeature *poFeature;
+
+    if( poFeatureToFill != NULL )
+    {
+        poFeature = poFeatureToFill;
+        poFeature->Reset();
+    }
+    else
+        poFeature = new OGRFeature( poFeatureDefn );
 
     poFeature->SetFID( iNextShapeId );
     m_nFeaturesRead++;
@@ -1376,7 +1387,7 @@ void OGRPGLayer::SetInitialQueryCursor()
 /*                         GetNextRawFeature()                          */
 /************************************************************************/
 
-OGRFeature *OGRPGLayer::GetNextRawFeature()
+OGRFeature *OGRPGLayer::GetNextRawFeature( OGRFeature *poFeatureToFill )
 
 {
     PGconn      *hPGConn = poDS->GetPGConn();
@@ -1438,7 +1449,7 @@ OGRFeature *OGRPGLayer::GetNextRawFeature()
 /* -------------------------------------------------------------------- */
 /*      Create a feature from the current result.                       */
 /* -------------------------------------------------------------------- */
-    OGRFeature *poFeature = RecordToFeature( nResultOffset );
+    OGRFeature *poFeature = RecordToFeature( nResultOffset, poFeatureToFill );
 
     nResultOffset++;
     iNextShapeId++;
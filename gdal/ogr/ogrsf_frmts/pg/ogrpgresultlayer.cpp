@@ -229,18 +229,51 @@ int OGRPGResultLayer::TestCapability( const char * pszCap )
 
 OGRFeature *OGRPGResultLayer::GetNextFeature()
 
+{
+    return GetNextFeatureInternal( NULL );
+}
+
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/************************************************************************/
+
+int OGRPGResultLayer::GetNextFeatureInto( OGRFeature *poFeature )
+
+{
+    if( poFeature->GetDefnRef() != poFeatureDefn )
+        return OGRLayer::GetNextFeatureInto( poFeature );
+
+    return GetNextFeatureInternal( poFeature ) != NULL;
+}
+
+/************************************************************************/
+/*                       GetNextFeatureInternal()                       */
+/*                                                                      */
+/*      Features rejected by the filters are filled again with the      */
+/*      next record, rather than destroyed.  If poFeatureToFill is not  */
+/*      NULL, it is the only feature used.                              */
+/************************************************************************/
+
+OGRFeature *OGRPGResultLayer::GetNextFeatureInternal( OGRFeature *poFeatureToFill )
+
 {
     OGRPGGeomFieldDefn* poGeomFieldDefn = NULL;
     if( poFeatureDefn->GetGeomFieldCount() != 0 )
         poGeomFieldDefn = poFeatureDefn->myGetGeomFieldDefn(m_iGeomFieldFilter);
 
+    OGRFeature  *poRecycledFeature = poFeatureToFill;
+
     for( ; TRUE; )
     {
         OGRFeature      *poFeature;
 
-        poFeature = GetNextRawFeature();
+        poFeature = GetNextRawFeature( poRecycledFeature );
         if( poFeature == NULL )
+        {
+            if( poRecycledFeature != poFeatureToFill )
+                delete poRecycledFeature;
             return NULL;
+        }
 
         if( (m_poFilterGeom == NULL
             || poGeomFieldDefn == NULL
@@ -251,7 +284,7 @@ OGRFeature *OGRPGResultLayer::GetNextFeature()
                 || m_poAttrQuery->Evaluate( poFeature )) )
             return poFeature;
 
-        delete poFeature;
+        poRecycledFeature = poFeature;
     }
 }
 
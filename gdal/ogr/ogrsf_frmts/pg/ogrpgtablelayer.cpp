@@ -793,19 +793,52 @@ void OGRPGTableLayer::ResetReading()
 
 OGRFeature *OGRPGTableLayer::GetNextFeature()
 
+{
+    return GetNextFeatureInternal( NULL );
+}
+
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/************************************************************************/
+
+int OGRPGTableLayer::GetNextFeatureInto( OGRFeature *poFeature )
+
+{
+    if( poFeature->GetDefnRef() != poFeatureDefn )
+        return OGRLayer::GetNextFeatureInto( poFeature );
+
+    return GetNextFeatureInternal( poFeature ) != NULL;
+}
+
+/************************************************************************/
+/*                       GetNextFeatureInternal()                       */
+/*                                                                      */
+/*      Features rejected by the filters are filled again with the      */
+/*      next record, rather than destroyed.  If poFeatureToFill is not  */
+/*      NULL, it is the only feature used.                              */
+/************************************************************************/
+
+OGRFeature *OGRPGTableLayer::GetNextFeatureInternal( OGRFeature *poFeatureToFill )
+
 {
     OGRPGGeomFieldDefn* poGeomFieldDefn = NULL;
     if( poFeatureDefn->GetGeomFieldCount() != 0 )
         poGeomFieldDefn = poFeatureDefn->myGetGeomFieldDefn(m_iGeomFieldFilter);
     poFeatureDefn->GetFieldCount();
 
+    OGRFeature  *poRecycledFeature = poFeatureToFill;
+
     for( ; TRUE; )
     {
         OGRFeature      *poFeature;
 
-        poFeature = GetNextRawFeature();
+        poFeature = GetNextRawFeature( poRecycledFeature );
         if( poFeature == NULL )
+        {
+            if( poRecycledFeature != poFeatureToFill )
+                delete poRecycledFeature;
             return NULL;
+        }
 
         /* We just have to look if there is a geometry filter */
         /* If there's a PostGIS geometry column, the spatial filter */
@@ -818,7 +851,7 @@ OGRFeature *OGRPGTableLayer::GetNextFeature()
             || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) )  )
             return poFeature;
 
-        delete poFeature;
+        poRecycledFeature = poFeature;
     }
 }
 
@@ -47,8 +47,10 @@
 /* ==================================================================== */
 OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                                OGRFeatureDefn * poDefn, int iShape, 
-                               SHPObject *psShape, const char *pszSHPEncoding );
-OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape );
+                               SHPObject *psShape, const char *pszSHPEncoding,
+                               OGRFeature *poFeatureToFill = NULL );
+OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape,
+                               OGRGeometry *poGeomToReuse = NULL );
 OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
                                        SHPHandle hSHP, DBFHandle hDBF,
                                        const char *pszSHPEncoding );
@@ -139,7 +141,9 @@ class OGRShapeLayer : public OGRAbstractProxiedLayer
 
     const char         *GetFullName() { return pszFullName; }
 
-    OGRFeature *        FetchShape(int iShapeId);
+    OGRFeature *        FetchShape(int iShapeId,
+                                   OGRFeature *poFeatureToFill = NULL);
+    OGRFeature *        GetNextFeatureInternal(OGRFeature *poFeatureToFill);
     int                 GetFeatureCountWithSpatialFilterOnly();
 
   public:
@@ -153,6 +157,8 @@ class OGRShapeLayer : public OGRAbstractProxiedLayer
 
     void                ResetReading();
     OGRFeature *        GetNextFeature();
+    int                 GetNextFeatureInto( OGRFeature *poFeature );
+    int                 GetNextBatch( OGRFeatureBatch *poBatch );
     virtual OGRErr      SetNextByIndex( long nIndex );
 
     OGRFeature         *GetFeature( long nFeatureId );
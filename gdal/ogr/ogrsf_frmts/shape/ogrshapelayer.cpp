@@ -635,10 +635,13 @@ OGRErr OGRShapeLayer::SetNextByIndex( long nIndex )
 /*                             FetchShape()                             */
 /*                                                                      */
 /*      Take a shape id, a geometry, and a feature, and set the feature */
-/*      if the shapeid bbox intersects the geometry.                    */
+/*      if the shapeid bbox intersects the geometry.  If                */
+/*      poFeatureToFill is not NULL, it is filled rather than a new     */
+/*      feature being created.                                          */
 /************************************************************************/
 
-OGRFeature *OGRShapeLayer::FetchShape(int iShapeId /*, OGREnvelope* psShapeExtent */)
+OGRFeature *OGRShapeLayer::FetchShape(int iShapeId /*, OGREnvelope* psShapeExtent */,
+                                      OGRFeature *poFeatureToFill)
 
 {
     OGRFeature *poFeature;
@@ -660,7 +663,8 @@ OGRFeature *OGRShapeLayer::FetchShape(int iShapeId /*, OGREnvelope* psShapeExten
             || psShape->nSHPType == SHPT_NULL )
         {
             poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn,
-                                           iShapeId, psShape, osEncoding );
+                                           iShapeId, psShape, osEncoding,
+                                           poFeatureToFill );
         }
         else if( m_sFilterEnvelope.MaxX < psShape->dfXMin 
                  || m_sFilterEnvelope.MaxY < psShape->dfYMin
@@ -677,13 +681,15 @@ OGRFeature *OGRShapeLayer::FetchShape(int iShapeId /*, OGREnvelope* psShapeExten
             psShapeExtent->MaxX = psShape->dfXMax;
             psShapeExtent->MaxY = psShape->dfYMax;*/
             poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn,
-                                           iShapeId, psShape, osEncoding );
+                                           iShapeId, psShape, osEncoding,
+                                           poFeatureToFill );
         }                
     } 
     else 
     {
         poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn,
-                                       iShapeId, NULL, osEncoding );
+                                       iShapeId, NULL, osEncoding,
+                                       poFeatureToFill );
     }    
     
     return poFeature;
@@ -695,11 +701,146 @@ OGRFeature *OGRShapeLayer::FetchShape(int iShapeId /*, OGREnvelope* psShapeExten
 
 OGRFeature *OGRShapeLayer::GetNextFeature()
 
+{
+    return GetNextFeatureInternal( NULL );
+}
+
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/************************************************************************/
+
+int OGRShapeLayer::GetNextFeatureInto( OGRFeature *poFeature )
+
+{
+    if( poFeature->GetDefnRef() != poFeatureDefn )
+        return OGRLayer::GetNextFeatureInto( poFeature );
+
+    return GetNextFeatureInternal( poFeature ) != NULL;
+}
+
+/************************************************************************/
+/*                            GetNextBatch()                            */
+/*                                                                      */
+/*      When there are no filters, fill the columns directly from the   */
+/*      DBF records, without going through OGRFeature.                  */
+/************************************************************************/
+
+int OGRShapeLayer::GetNextBatch( OGRFeatureBatch *poBatch )
+
+{
+    if( m_poAttrQuery != NULL || m_poFilterGeom != NULL
+        || panMatchingFIDs != NULL )
+        return OGRLayer::GetNextBatch( poBatch );
+
+    if (!TouchLayer())
+        return 0;
+
+    poBatch->Prepare( poFeatureDefn );
+
+    int iColumn, nColumns = poBatch->GetColumnCount();
+
+    /* Dates are formatted by OGRFeature */
+    for( iColumn = 0; iColumn < nColumns; iColumn++ )
+    {
+        if( poFeatureDefn->GetFieldDefn( poBatch->GetColumnFieldIndex(
+                iColumn ) )->GetType() == OFTDate )
+            return OGRLayer::GetNextBatch( poBatch );
+    }
+
+    int bReadGeometry = hSHP != NULL && poBatch->HasGeometry();
+    OGRGeometry *poGeom = NULL;
+
+    while( !poBatch->IsFull() && iNextShapeId < nTotalShapeCount )
+    {
+        int iShape = iNextShapeId;
+
+        if( hDBF )
+        {
+            if( DBFIsRecordDeleted( hDBF, iShape ) )
+            {
+                iNextShapeId++;
+                continue;
+            }
+            if( VSIFEofL((VSILFILE*)hDBF->fp) )
+                break; /* There's an I/O error */
+        }
+
+        poBatch->BeginFeature( iShape );
+
+        for( iColumn = 0; iColumn < nColumns; iColumn++ )
+        {
+            int iField = poBatch->GetColumnFieldIndex( iColumn );
+
+            switch( poBatch->GetColumnType( iColumn ) )
+            {
+              case OFTInteger:
+                if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                    poBatch->SetInteger( iColumn,
+                        DBFReadIntegerAttribute( hDBF, iShape, iField ) );
+                break;
+
+              case OFTReal:
+                if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                    poBatch->SetDouble( iColumn,
+                        DBFReadDoubleAttribute( hDBF, iShape, iField ) );
+                break;
+
+              default:
+              {
+                  const char *pszFieldVal =
+                      DBFReadStringAttribute( hDBF, iShape, iField );
+                  if( pszFieldVal == NULL || pszFieldVal[0] == '\0' )
+                      break;
+
+                  if( osEncoding != "" )
+                  {
+                      char *pszUTF8Field = CPLRecode( pszFieldVal,
+                                                      osEncoding,
+                                                      CPL_ENC_UTF8 );
+                      poBatch->SetString( iColumn, pszUTF8Field );
+                      CPLFree( pszUTF8Field );
+                  }
+                  else
+                      poBatch->SetString( iColumn, pszFieldVal );
+              }
+              break;
+            }
+        }
+
+        if( bReadGeometry )
+        {
+            /* The geometry is only encoded, so reuse it for the next shape */
+            poGeom = SHPReadOGRObject( hSHP, iShape, NULL, poGeom );
+            poBatch->SetGeometry( poGeom );
+        }
+
+        poBatch->EndFeature();
+
+        m_nFeaturesRead++;
+        iNextShapeId++;
+    }
+
+    delete poGeom;
+
+    return poBatch->GetFeatureCount();
+}
+
+/************************************************************************/
+/*                       GetNextFeatureInternal()                       */
+/*                                                                      */
+/*      Features rejected by the filters are filled again with the      */
+/*      next shape, rather than destroyed.  If poFeatureToFill is not   */
+/*      NULL, it is the only feature used.                              */
+/************************************************************************/
+
+OGRFeature *OGRShapeLayer::GetNextFeatureInternal( OGRFeature *poFeatureToFill )
+
 {
     if (!TouchLayer())
         return NULL;
 
     OGRFeature  *poFeature = NULL;
+    OGRFeature  *poRecycledFeature = poFeatureToFill;
 
 /* -------------------------------------------------------------------- */
 /*      Collect a matching list if we have attribute or spatial         */
@@ -723,12 +864,15 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
         {
             if( panMatchingFIDs[iMatchingFID] == OGRNullFID )
             {
+                if( poRecycledFeature != poFeatureToFill )
+                    delete poRecycledFeature;
                 return NULL;
             }
             
             // Check the shape object's geometry, and if it matches
             // any spatial filter, return it.  
-            poFeature = FetchShape(panMatchingFIDs[iMatchingFID] /*, &oShapeExtent*/);
+            poFeature = FetchShape(panMatchingFIDs[iMatchingFID] /*, &oShapeExtent*/,
+                                   poRecycledFeature);
             
             iMatchingFID++;
 
@@ -737,6 +881,8 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
         {
             if( iNextShapeId >= nTotalShapeCount )
             {
+                if( poRecycledFeature != poFeatureToFill )
+                    delete poRecycledFeature;
                 return NULL;
             }
 
@@ -745,12 +891,18 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
                 if (DBFIsRecordDeleted( hDBF, iNextShapeId ))
                     poFeature = NULL;
                 else if( VSIFEofL((VSILFILE*)hDBF->fp) )
+                {
+                    if( poRecycledFeature != poFeatureToFill )
+                        delete poRecycledFeature;
                     return NULL; /* There's an I/O error */
+                }
                 else
-                    poFeature = FetchShape(iNextShapeId /*, &oShapeExtent */);
+                    poFeature = FetchShape(iNextShapeId /*, &oShapeExtent */,
+                                           poRecycledFeature);
             }
             else
-                poFeature = FetchShape(iNextShapeId /*, &oShapeExtent */);
+                poFeature = FetchShape(iNextShapeId /*, &oShapeExtent */,
+                                       poRecycledFeature);
 
             iNextShapeId++;
         }
@@ -771,7 +923,7 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
                 return poFeature;
             }
 
-            delete poFeature;
+            poRecycledFeature = poFeature;
         }
     }
 }
@@ -1183,7 +1335,7 @@ int OGRShapeLayer::GetFeatureCountWithSpatialFilterOnly()
                     }
                     if( poGeometry == NULL )
                         nFeatureCount ++;
-                    else if ( m_pPreparedFilterGeom != NULL )
+                    else if ( GetPreparedFilterGeom() != NULL )
                     {
                         if( OGRPreparedGeometryIntersects(m_pPreparedFilterGeom,
                                                           poGeometry) )
@@ -87,9 +87,14 @@ static OGRLinearRing * CreateLinearRing ( SHPObject *psShape, int ring, int bHas
 /*                                                                      */
 /*      Read an item in a shapefile, and translate to OGR geometry      */
 /*      representation.                                                 */
+/*                                                                      */
+/*      If poGeomToReuse is not NULL, ownership is transferred to this  */
+/*      function, which fills it again for points and simple lines      */
+/*      rather than instanciating a new geometry, or destroys it.       */
 /************************************************************************/
 
-OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
+OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape,
+                               OGRGeometry *poGeomToReuse )
 {
     // CPLDebug( "Shape", "SHPReadOGRObject( iShape=%d )\n", iShape );
 
@@ -100,26 +105,38 @@ OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
 
     if( psShape == NULL )
     {
+        delete poGeomToReuse;
         return NULL;
     }
 
 /* -------------------------------------------------------------------- */
 /*      Point.                                                          */
 /* -------------------------------------------------------------------- */
-    else if( psShape->nSHPType == SHPT_POINT )
-    {
-        poOGR = new OGRPoint( psShape->padfX[0], psShape->padfY[0] );
-    }
-    else if(psShape->nSHPType == SHPT_POINTZ )
+    else if( psShape->nSHPType == SHPT_POINT
+             || psShape->nSHPType == SHPT_POINTZ
+             || psShape->nSHPType == SHPT_POINTM )
     {
-        poOGR = new OGRPoint( psShape->padfX[0], psShape->padfY[0],
-                              psShape->padfZ[0] );
-    }
-    else if(psShape->nSHPType == SHPT_POINTM )
-    {
-        // Read XYM as XYZ
-        poOGR = new OGRPoint( psShape->padfX[0], psShape->padfY[0],
-                              psShape->padfM[0] );
+        OGRPoint *poOGRPoint;
+
+        if( poGeomToReuse != NULL
+            && wkbFlatten(poGeomToReuse->getGeometryType()) == wkbPoint )
+        {
+            poOGRPoint = (OGRPoint *) poGeomToReuse;
+            poGeomToReuse = NULL;
+            poOGRPoint->setCoordinateDimension( 2 );
+            poOGRPoint->setX( psShape->padfX[0] );
+            poOGRPoint->setY( psShape->padfY[0] );
+        }
+        else
+            poOGRPoint = new OGRPoint( psShape->padfX[0], psShape->padfY[0] );
+
+        if( psShape->nSHPType == SHPT_POINTZ )
+            poOGRPoint->setZ( psShape->padfZ[0] );
+        else if( psShape->nSHPType == SHPT_POINTM )
+            // Read XYM as XYZ
+            poOGRPoint->setZ( psShape->padfM[0] );
+
+        poOGR = poOGRPoint;
     }
 /* -------------------------------------------------------------------- */
 /*      Multipoint.                                                     */
@@ -171,7 +188,17 @@ OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
         }
         else if( psShape->nParts == 1 )
         {
-            OGRLineString *poOGRLine = new OGRLineString();
+            OGRLineString *poOGRLine;
+
+            /* Reuse the point array of the previous line if possible */
+            if( poGeomToReuse != NULL
+                && EQUAL(poGeomToReuse->getGeometryName(), "LINESTRING") )
+            {
+                poOGRLine = (OGRLineString *) poGeomToReuse;
+                poGeomToReuse = NULL;
+            }
+            else
+                poOGRLine = new OGRLineString();
 
             if( psShape->nSHPType == SHPT_ARCZ )
                 poOGRLine->setPoints( psShape->nVertices,
@@ -452,6 +479,8 @@ OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
 /* -------------------------------------------------------------------- */
     SHPDestroyObject( psShape );
 
+    delete poGeomToReuse;
+
     return poOGR;
 }
 
@@ -983,7 +1012,8 @@ OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
 
 OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                                OGRFeatureDefn * poDefn, int iShape,
-                               SHPObject *psShape, const char *pszSHPEncoding )
+                               SHPObject *psShape, const char *pszSHPEncoding,
+                               OGRFeature *poFeatureToFill )
 
 {
     if( iShape < 0 
@@ -1004,7 +1034,22 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
         return NULL;
     }
 
-    OGRFeature  *poFeature = new OGRFeature( poDefn );
+/* -------------------------------------------------------------------- */
+/*      Create the feature, or recycle the one we were given, keeping   */
+/*      its geometry aside so that it can be reused too.                */
+/* -------------------------------------------------------------------- */
+    OGRFeature  *poFeature;
+    OGRGeometry *poGeomToReuse = NULL;
+
+    if( poFeatureToFill != NULL )
+    {
+        poFeature = poFeatureToFill;
+        if( poFeature->GetGeomFieldCount() > 0 )
+            poGeomToReuse = poFeature->StealGeometry();
+        poFeature->Reset();
+    }
+    else
+        poFeature = new OGRFeature( poDefn );
 
 /* -------------------------------------------------------------------- */
 /*      Fetch geometry from Shapefile to OGRFeature.                    */
@@ -1014,7 +1059,9 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
         if( !poDefn->IsGeometryIgnored() )
         {
             OGRGeometry* poGeometry = NULL;
-            poGeometry = SHPReadOGRObject( hSHP, iShape, psShape );
+            poGeometry = SHPReadOGRObject( hSHP, iShape, psShape,
+                                           poGeomToReuse );
+            poGeomToReuse = NULL;
 
             /*
             * NOTE - mloskot:
@@ -1123,6 +1170,8 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
     if( poFeature != NULL )
         poFeature->SetFID( iShape );
 
+    delete poGeomToReuse;
+
     return( poFeature );
 }
 
@@ -254,6 +254,8 @@ class OGRSQLiteLayer : public OGRLayer
 
     int                 bAllowMultipleGeomFields;
 
+    OGRFeature         *GetNextFeatureInternal( OGRFeature *poFeatureToFill );
+
   public:
                         OGRSQLiteLayer();
     virtual             ~OGRSQLiteLayer();
@@ -261,8 +263,9 @@ class OGRSQLiteLayer : public OGRLayer
     virtual void        Finalize();
 
     virtual void        ResetReading();
-    virtual OGRFeature *GetNextRawFeature();
+    virtual OGRFeature *GetNextRawFeature( OGRFeature *poFeatureToFill = NULL );
     virtual OGRFeature *GetNextFeature();
+    virtual int         GetNextFeatureInto( OGRFeature *poFeature );
 
     virtual OGRFeature *GetFeature( long nFeatureId );
     
@@ -397,6 +400,7 @@ class OGRSQLiteTableLayer : public OGRSQLiteLayer
     virtual OGRErr      AlterFieldDefn( int iField, OGRFieldDefn* poNewFieldDefn, int nFlags );
 
     virtual OGRFeature *GetNextFeature();
+    virtual int         GetNextFeatureInto( OGRFeature *poFeature );
     virtual OGRFeature *GetFeature( long nFeatureId );
 
     virtual int         TestCapability( const char * );
@@ -478,6 +482,7 @@ class OGRSQLiteViewLayer : public OGRSQLiteLayer
     int                 HasLayerDefnError() { GetLayerDefn(); return bLayerDefnError; }
 
     virtual OGRFeature *GetNextFeature();
+    virtual int         GetNextFeatureInto( OGRFeature *poFeature );
     virtual int         GetFeatureCount( int );
 
     virtual void        SetSpatialFilter( OGRGeometry * );
@@ -521,6 +526,7 @@ class OGRSQLiteSelectLayer : public OGRSQLiteLayer
     virtual void        ResetReading();
 
     virtual OGRFeature *GetNextFeature();
+    virtual int         GetNextFeatureInto( OGRFeature *poFeature );
     virtual int         GetFeatureCount( int );
 
     virtual void        SetSpatialFilter( OGRGeometry * poGeom ) { SetSpatialFilter(0, poGeom); }
@@ -482,13 +482,46 @@ void OGRSQLiteLayer::ResetReading()
 OGRFeature *OGRSQLiteLayer::GetNextFeature()
 
 {
+    return GetNextFeatureInternal( NULL );
+}
+
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/************************************************************************/
+
+int OGRSQLiteLayer::GetNextFeatureInto( OGRFeature *poFeature )
+
+{
+    if( poFeature->GetDefnRef() != poFeatureDefn )
+        return OGRLayer::GetNextFeatureInto( poFeature );
+
+    return GetNextFeatureInternal( poFeature ) != NULL;
+}
+
+/************************************************************************/
+/*                       GetNextFeatureInternal()                       */
+/*                                                                      */
+/*      Features rejected by the filters are filled again with the      */
+/*      next row, rather than destroyed.  If poFeatureToFill is not     */
+/*      NULL, it is the only feature used.                              */
+/************************************************************************/
+
+OGRFeature *OGRSQLiteLayer::GetNextFeatureInternal( OGRFeature *poFeatureToFill )
+
+{
+    OGRFeature  *poRecycledFeature = poFeatureToFill;
+
     for( ; TRUE; )
     {
         OGRFeature      *poFeature;
 
-        poFeature = GetNextRawFeature();
+        poFeature = GetNextRawFeature( poRecycledFeature );
         if( poFeature == NULL )
+        {
+            if( poRecycledFeature != poFeatureToFill )
+                delete poRecycledFeature;
             return NULL;
+        }
 
         if( (m_poFilterGeom == NULL
             || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) )
@@ -496,15 +529,18 @@ OGRFeature *OGRSQLiteLayer::GetNextFeature()
                 || m_poAttrQuery->Evaluate( poFeature )) )
             return poFeature;
 
-        delete poFeature;
+        poRecycledFeature = poFeature;
     }
 }
 
 /************************************************************************/
 /*                         GetNextRawFeature()                          */
+/*                                                                      */
+/*      If poFeatureToFill is not NULL, it is reset and filled rather   */
+/*      than a new feature being created.                               */
 /************************************************************************/
 
-OGRFeature *OGRSQLiteLayer::GetNextRawFeature()
+OGRFeature *OGRSQLiteLayer::GetNextRawFeature( OGRFeature *poFeatureToFill )
 
 {
     if( hStmt == NULL )
@@ -541,10 +577,19 @@ OGRFeature *OGRSQLiteLayer::GetNextRawFeature()
         bDoStep = TRUE;
 
 /* -------------------------------------------------------------------- */
-/*      Create a feature from the current result.                       */
+/*      Create a feature from the current result, or recycle the one    */
+/*      we were given.                                                  */
 /* -------------------------------------------------------------------- */
     int         iField;
-    OGRFeature *poFeature = new OGRFeature( poFeatureDefn );
+    OGRFeature *poFeature;
+
+    if( poFeatureToFill != NULL )
+    {
+        poFeature = poFeatureToFill;
+        poFeature->Reset();
+    }
+    else
+        poFeature = new OGRFeature( poFeatureDefn );
 
 /* -------------------------------------------------------------------- */
 /*      Set FID if we have a column to set it from.                     */
@@ -600,12 +645,22 @@ OGRFeature *OGRSQLiteLayer::GetNextRawFeature()
                     poGeomFieldDefn->bTriedAsSpatiaLite = TRUE;
                 }
 
-                if( poGeomFieldDefn->eGeomFormat == OSGF_WKB &&
-                    OGRGeometryFactory::createFromWkb( 
-                        (GByte*)sqlite3_column_blob( hStmt, poGeomFieldDefn->iCol ),
-                        NULL, &poGeometry, nBytes ) == OGRERR_NONE )
+                /* Only check the structure of the WKB and keep it as is in */
+                /* the feature. It is decoded if and when the geometry is */
+                /* requested, and written back as is by the SQLite layers. */
+                if( poGeomFieldDefn->eGeomFormat == OSGF_WKB )
                 {
-                    poFeature->SetGeomFieldDirectly( iField, poGeometry );
+                    const GByte* pabyBlob = (const GByte*)
+                        sqlite3_column_blob( hStmt, poGeomFieldDefn->iCol );
+                    OGRWKBGeometryView oView;
+
+                    if( oView.Init( pabyBlob, nBytes ) == OGRERR_NONE )
+                    {
+                        GByte* pabyWKB = (GByte*) CPLMalloc(oView.getWkbSize());
+                        memcpy( pabyWKB, pabyBlob, oView.getWkbSize() );
+                        poFeature->SetGeomFieldWkbDirectly( iField, pabyWKB,
+                                                            oView.getWkbSize() );
+                    }
                 }
             }
             else if ( poGeomFieldDefn->eGeomFormat == OSGF_FGF )
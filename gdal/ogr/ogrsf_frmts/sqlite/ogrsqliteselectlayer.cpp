@@ -155,6 +155,18 @@ OGRFeature *OGRSQLiteSelectLayer::GetNextFeature()
     return OGRSQLiteLayer::GetNextFeature();
 }
 
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/************************************************************************/
+
+int OGRSQLiteSelectLayer::GetNextFeatureInto( OGRFeature *poFeature )
+{
+    if( bEmptyLayer )
+        return FALSE;
+
+    return OGRSQLiteLayer::GetNextFeatureInto( poFeature );
+}
+
 /************************************************************************/
 /*                           GetNextFeature()                           */
 /************************************************************************/
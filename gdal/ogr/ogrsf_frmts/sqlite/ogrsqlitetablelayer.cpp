@@ -455,6 +455,19 @@ OGRFeature *OGRSQLiteTableLayer::GetNextFeature()
     return OGRSQLiteLayer::GetNextFeature();
 }
 
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/************************************************************************/
+
+int OGRSQLiteTableLayer::GetNextFeatureInto( OGRFeature *poFeature )
+
+{
+    if( HasLayerDefnError() )
+        return FALSE;
+
+    return OGRSQLiteLayer::GetNextFeatureInto( poFeature );
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
@@ -1631,6 +1644,39 @@ OGRErr OGRSQLiteTableLayer::ReorderFields( int* panMap )
     return eErr;
 }
 
+/************************************************************************/
+/*                     OGRSQLiteGetFeatureEnvelope()                    */
+/*                                                                      */
+/*      Return TRUE and the envelope of the geometry of the feature     */
+/*      if it is not NULL or empty, without decoding pending WKB.       */
+/************************************************************************/
+
+static int OGRSQLiteGetFeatureEnvelope( OGRFeature *poFeature,
+                                        OGREnvelope *psEnvelope )
+{
+    int nWKBLen = 0;
+    const GByte* pabyWKB = poFeature->GetGeomFieldWkbRef(0, &nWKBLen);
+
+    if( pabyWKB != NULL )
+    {
+        OGRWKBGeometryView oView;
+        if( oView.Init( pabyWKB, nWKBLen ) == OGRERR_NONE )
+        {
+            if( oView.getNumPoints() == 0 )
+                return FALSE;
+            oView.getEnvelope( psEnvelope );
+            return TRUE;
+        }
+    }
+
+    OGRGeometry *poGeom = poFeature->GetGeometryRef();
+    if( poGeom == NULL || poGeom->IsEmpty() )
+        return FALSE;
+
+    poGeom->getEnvelope( psEnvelope );
+    return TRUE;
+}
+
 /************************************************************************/
 /*                             BindValues()                             */
 /************************************************************************/
@@ -1653,8 +1699,29 @@ OGRErr OGRSQLiteTableLayer::BindValues( OGRFeature *poFeature,
     if( poFeatureDefn->GetGeomFieldCount() != 0 &&
         eGeomFormat != OSGF_FGF )
     {
-        OGRGeometry* poGeom = poFeature->GetGeometryRef();
-        if ( poGeom != NULL )
+        /* WKB that has not been decoded yet can be written as is, if it */
+        /* is already what exportToWkb(wkbNDR) would write. Otherwise */
+        /* (XDR, other type codes...) it is decoded and written below. */
+        int nPendingWKBLen = 0;
+        const GByte* pabyPendingWKB = NULL;
+        OGRWKBGeometryView oPendingView;
+        if( eGeomFormat == OSGF_WKB )
+        {
+            pabyPendingWKB = poFeature->GetGeomFieldWkbRef(0, &nPendingWKBLen);
+            if( pabyPendingWKB != NULL &&
+                (oPendingView.Init( pabyPendingWKB, nPendingWKBLen ) != OGRERR_NONE ||
+                 !oPendingView.IsCanonicalNDR()) )
+                pabyPendingWKB = NULL;
+        }
+
+        OGRGeometry* poGeom = NULL;
+        if( pabyPendingWKB != NULL )
+        {
+            rc = sqlite3_bind_blob( hStmt, nBindField++, pabyPendingWKB,
+                                    oPendingView.getWkbSize(),
+                                    SQLITE_TRANSIENT );
+        }
+        else if ( (poGeom = poFeature->GetGeometryRef()) != NULL )
         {
             if ( eGeomFormat == OSGF_WKT )
             {
@@ -1979,12 +2046,10 @@ OGRErr OGRSQLiteTableLayer::SetFeature( OGRFeature *poFeature )
 
     sqlite3_finalize( hUpdateStmt );
 
-    OGRGeometry *poGeom = poFeature->GetGeometryRef();
+    OGREnvelope sGeomEnvelope;
     if( bCachedExtentIsValid &&
-        poGeom != NULL && !poGeom->IsEmpty() )
+        OGRSQLiteGetFeatureEnvelope( poFeature, &sGeomEnvelope ) )
     {
-        OGREnvelope sGeomEnvelope;
-        poGeom->getEnvelope(&sGeomEnvelope);
         oCachedExtent.Merge(sGeomEnvelope);
     }
     bStatisticsNeedsToBeFlushed = TRUE;
@@ -2039,10 +2104,15 @@ OGRErr OGRSQLiteTableLayer::CreateFeature( OGRFeature *poFeature )
 /* -------------------------------------------------------------------- */
 /*      Add geometry.                                                   */
 /* -------------------------------------------------------------------- */
-    OGRGeometry *poGeom = poFeature->GetGeometryRef();
+    int bHasGeom = FALSE;
+    if( eGeomFormat == OSGF_WKB &&
+        poFeature->GetGeomFieldWkbRef(0, NULL) != NULL )
+        bHasGeom = TRUE;
+    else
+        bHasGeom = poFeature->GetGeometryRef() != NULL;
 
     if( poFeatureDefn->GetGeomFieldCount() != 0 &&
-        poGeom != NULL &&
+        bHasGeom &&
         eGeomFormat != OSGF_FGF )
     {
 
@@ -2163,11 +2233,10 @@ OGRErr OGRSQLiteTableLayer::CreateFeature( OGRFeature *poFeature )
 
     sqlite3_reset( hInsertStmt );
 
+    OGREnvelope sGeomEnvelope;
     if( (bCachedExtentIsValid || nFeatureCount == 0) &&
-        poGeom != NULL && !poGeom->IsEmpty() )
+        OGRSQLiteGetFeatureEnvelope( poFeature, &sGeomEnvelope ) )
     {
-        OGREnvelope sGeomEnvelope;
-        poGeom->getEnvelope(&sGeomEnvelope);
         oCachedExtent.Merge(sGeomEnvelope);
         bCachedExtentIsValid = TRUE;
         bStatisticsNeedsToBeFlushed = TRUE;
@@ -304,6 +304,19 @@ OGRFeature *OGRSQLiteViewLayer::GetNextFeature()
     return OGRSQLiteLayer::GetNextFeature();
 }
 
+/************************************************************************/
+/*                         GetNextFeatureInto()                         */
+/************************************************************************/
+
+int OGRSQLiteViewLayer::GetNextFeatureInto( OGRFeature *poFeature )
+
+{
+    if( HasLayerDefnError() )
+        return FALSE;
+
+    return OGRSQLiteLayer::GetNextFeatureInto( poFeature );
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
@@ -30,6 +30,7 @@
 #include "ogr_vrt.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_multiproc.h"
 #include "ogrwarpedlayer.h"
 #include "ogrunionlayer.h"
 
@@ -551,6 +552,20 @@ OGRLayer*  OGRVRTDataSource::InstanciateUnionLayer(
                             CPLAtof(pszExtentYMax) );
     }
 
+/* -------------------------------------------------------------------- */
+/*      Set number of reader threads if provided                        */
+/* -------------------------------------------------------------------- */
+    const char* pszNumThreads = CPLGetXMLValue( psLTree, "NumThreads", NULL );
+    if( pszNumThreads != NULL )
+    {
+        int nNumThreads;
+        if( EQUAL(pszNumThreads, "ALL_CPUS") )
+            nNumThreads = CPLGetNumCPUs();
+        else
+            nNumThreads = atoi(pszNumThreads);
+        poLayer->SetNumThreads(nNumThreads);
+    }
+
     return poLayer;
 }
 
@@ -157,6 +157,341 @@ void OGRFormatDouble( char *pszBuffer, int nBufferLen, double dfVal, char chDeci
 
 }
 
+/************************************************************************/
+/*                          adfExactPowerOfTen                          */
+/*                                                                      */
+/*      Powers of ten that are exactly representable as doubles.       */
+/*      Multiplying or dividing an integer below 2^53 by one of them    */
+/*      yields the correctly rounded result, which is what makes the    */
+/*      fast paths of OGRFastAtof() and OGRFormatDoubleRoundTrip()      */
+/*      exact.                                                          */
+/************************************************************************/
+
+static const double adfExactPowerOfTen[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+    1e21, 1e22
+};
+
+#define OGR_MAX_EXACT_POWER_OF_TEN  22
+#define OGR_MAX_EXACT_INTEGER       9007199254740992.0 /* 2^53 */
+
+/* The x87 FPU computes in extended precision by default, and the */
+/* double rounding defeats the exactness of the fast paths. */
+#if defined(__i386__) && !defined(__SSE2_MATH__)
+#  define OGR_NO_EXACT_FAST_PATH
+#endif
+
+/************************************************************************/
+/*                         OGRParseDoubleFast()                         */
+/*                                                                      */
+/*      Parse [+|-]digits[.digits][(e|E)[+|-]digits] when the result    */
+/*      can be computed exactly (Clinger's fast path: a mantissa        */
+/*      below 2^53 and a power of ten up to 10^22).  Returns the        */
+/*      number of characters read, or 0 if the caller must fall back    */
+/*      to CPLAtof().                                                   */
+/************************************************************************/
+
+static int OGRParseDoubleFast( const char *pszStr, double *pdfValue )
+
+{
+#ifdef OGR_NO_EXACT_FAST_PATH
+    return 0;
+#else
+    const char *p = pszStr;
+    GUIntBig    nMantissa = 0;
+    int         nSignificantDigits = 0;
+    int         nExp10 = 0;
+    int         bNegative = FALSE;
+    int         bHasDigits = FALSE;
+
+    if( *p == '+' )
+        p++;
+    else if( *p == '-' )
+    {
+        bNegative = TRUE;
+        p++;
+    }
+
+    for( ; *p >= '0' && *p <= '9'; p++ )
+    {
+        bHasDigits = TRUE;
+        if( nMantissa == 0 && *p == '0' )
+            continue;
+        if( ++nSignificantDigits > 18 )
+            return 0;
+        nMantissa = nMantissa * 10 + (*p - '0');
+    }
+
+    if( *p == '.' )
+    {
+        for( p++; *p >= '0' && *p <= '9'; p++ )
+        {
+            bHasDigits = TRUE;
+            nExp10 --;
+            if( nMantissa == 0 && *p == '0' )
+                continue;
+            if( ++nSignificantDigits > 18 )
+                return 0;
+            nMantissa = nMantissa * 10 + (*p - '0');
+        }
+    }
+
+    if( !bHasDigits )
+        return 0;
+
+    if( *p == 'e' || *p == 'E' )
+    {
+        const char *pszExp = p + 1;
+        int bNegativeExp = FALSE;
+        int nExp = 0;
+
+        if( *pszExp == '+' )
+            pszExp++;
+        else if( *pszExp == '-' )
+        {
+            bNegativeExp = TRUE;
+            pszExp++;
+        }
+
+        if( *pszExp >= '0' && *pszExp <= '9' )
+        {
+            for( ; *pszExp >= '0' && *pszExp <= '9'; pszExp++ )
+            {
+                nExp = nExp * 10 + (*pszExp - '0');
+                if( nExp > 1000 )
+                    return 0;
+            }
+            nExp10 += bNegativeExp ? -nExp : nExp;
+            p = pszExp;
+        }
+    }
+
+    /* Let strtod() deal with hexadecimal numbers */
+    if( *p == 'x' || *p == 'X' )
+        return 0;
+
+    double dfValue = (double) nMantissa;
+
+    if( nMantissa == 0 )
+        ;
+    else if( nMantissa > (((GUIntBig)1) << 53)
+             || nExp10 > OGR_MAX_EXACT_POWER_OF_TEN
+             || nExp10 < -OGR_MAX_EXACT_POWER_OF_TEN )
+        return 0;
+    else if( nExp10 < 0 )
+        dfValue /= adfExactPowerOfTen[-nExp10];
+    else
+        dfValue *= adfExactPowerOfTen[nExp10];
+
+    *pdfValue = bNegative ? -dfValue : dfValue;
+
+    return (int) (p - pszStr);
+#endif
+}
+
+/************************************************************************/
+/*                        OGRFormatDecimalDigits()                      */
+/*                                                                      */
+/*      Write sign, digits and decimal point position as a number,      */
+/*      in positional notation with at least one decimal (as            */
+/*      OGRFormatDouble() does) when it is reasonably short, or in      */
+/*      exponential notation otherwise.  The value is                   */
+/*      0.<pszDigits> * 10^nPointPos.                                   */
+/************************************************************************/
+
+static int OGRFormatDecimalDigits( char *pszBuffer, int nBufferLen,
+                                   int bNegative, const char *pszDigits,
+                                   int nDigits, int nPointPos )
+
+{
+    char szTmp[64];
+    int  i, n = 0;
+
+    /* Trailing zeros carry no information */
+    while( nDigits > 1 && pszDigits[nDigits-1] == '0' )
+        nDigits --;
+
+    if( bNegative )
+        szTmp[n++] = '-';
+
+    if( nPointPos > 25 || nPointPos < -25 )
+    {
+        szTmp[n++] = pszDigits[0];
+        if( nDigits > 1 )
+        {
+            szTmp[n++] = '.';
+            for( i = 1; i < nDigits; i++ )
+                szTmp[n++] = pszDigits[i];
+        }
+        n += sprintf( szTmp + n, "e%c%02d", nPointPos - 1 < 0 ? '-' : '+',
+                      ABS(nPointPos - 1) );
+    }
+    else if( nPointPos <= 0 )
+    {
+        szTmp[n++] = '0';
+        szTmp[n++] = '.';
+        for( i = 0; i < -nPointPos; i++ )
+            szTmp[n++] = '0';
+        for( i = 0; i < nDigits; i++ )
+            szTmp[n++] = pszDigits[i];
+    }
+    else
+    {
+        for( i = 0; i < nPointPos; i++ )
+            szTmp[n++] = (i < nDigits) ? pszDigits[i] : '0';
+        szTmp[n++] = '.';
+        if( nDigits <= nPointPos )
+            szTmp[n++] = '0';
+        for( i = nPointPos; i < nDigits; i++ )
+            szTmp[n++] = pszDigits[i];
+    }
+
+    if( n >= nBufferLen )
+        return -1;
+
+    memcpy( pszBuffer, szTmp, n );
+    pszBuffer[n] = '\0';
+
+    return n;
+}
+
+/************************************************************************/
+/*                      OGRFormatDoubleRoundTrip()                      */
+/************************************************************************/
+
+/**
+ * Format a double with as few digits as needed to read it back exactly.
+ *
+ * Unlike OGRFormatDouble(), which prints a fixed number of decimals and
+ * trims what looks like roundoff error, the result always converts back
+ * to the very same double with CPLAtof() or OGRFastAtof().  The decimal
+ * separator is always '.', whatever the locale.  Integral values get a
+ * ".0" suffix, and values of very large or very small magnitude are
+ * written in exponential notation.
+ *
+ * Most coordinates are formatted without calling the C library: the
+ * value is scaled by increasing powers of ten until it becomes an exact
+ * integer.  Otherwise, 15, 16 and then 17 significant digits are tried.
+ *
+ * @param pszBuffer output buffer.
+ * @param nBufferLen size of the output buffer (64 bytes are always enough).
+ * @param dfVal value to format.
+ *
+ * @return the length of the string, or -1 if the buffer is too small.
+ */
+
+int OGRFormatDoubleRoundTrip( char *pszBuffer, int nBufferLen, double dfVal )
+
+{
+    char szDigits[32];
+    int  nDigits, bNegative = (dfVal < 0);
+    double dfAbs = bNegative ? -dfVal : dfVal;
+
+    if( CPLIsNan(dfVal) || CPLIsInf(dfVal) )
+    {
+        const char *pszVal = CPLIsNan(dfVal) ? "nan" : bNegative ? "-inf" : "inf";
+        if( (int)strlen(pszVal) >= nBufferLen )
+            return -1;
+        strcpy( pszBuffer, pszVal );
+        return strlen(pszBuffer);
+    }
+
+    if( dfAbs == 0.0 )
+        return OGRFormatDecimalDigits( pszBuffer, nBufferLen, FALSE, "0", 1, 1 );
+
+#ifndef OGR_NO_EXACT_FAST_PATH
+/* -------------------------------------------------------------------- */
+/*      Fast path: find the smallest number of decimals k such that     */
+/*      m, the integer nearest to dfAbs * 10^k, gives dfAbs back as     */
+/*      m / 10^k.  Since m and 10^k are exact, "m e-k" then reads       */
+/*      back as dfAbs.                                                  */
+/* -------------------------------------------------------------------- */
+    if( dfAbs < OGR_MAX_EXACT_INTEGER )
+    {
+        int k;
+        for( k = 0; k <= OGR_MAX_EXACT_POWER_OF_TEN; k++ )
+        {
+            double dfScaled = floor(dfAbs * adfExactPowerOfTen[k] + 0.5);
+            if( dfScaled >= OGR_MAX_EXACT_INTEGER )
+                break;
+            if( dfScaled / adfExactPowerOfTen[k] == dfAbs )
+            {
+                GUIntBig nScaled = (GUIntBig) dfScaled;
+                char szReversed[32];
+                int  i;
+
+                nDigits = 0;
+                do
+                {
+                    szReversed[nDigits++] = (char) ('0' + (int)(nScaled % 10));
+                    nScaled /= 10;
+                } while( nScaled != 0 );
+
+                for( i = 0; i < nDigits; i++ )
+                    szDigits[i] = szReversed[nDigits - 1 - i];
+
+                return OGRFormatDecimalDigits( pszBuffer, nBufferLen,
+                                               bNegative, szDigits, nDigits,
+                                               nDigits - k );
+            }
+        }
+    }
+#endif
+
+/* -------------------------------------------------------------------- */
+/*      General case: 15, 16 or 17 significant digits with printf().    */
+/*      The mantissa is extracted by hand since its decimal             */
+/*      separator depends on the locale.                                */
+/* -------------------------------------------------------------------- */
+    int nRet = -1;
+    for( int nPrecision = 15; nPrecision <= 17; nPrecision++ )
+    {
+        char szTmp[64];
+        const char *pszIter = szTmp;
+
+        snprintf( szTmp, sizeof(szTmp), "%.*e", nPrecision - 1, dfAbs );
+
+        nDigits = 0;
+        while( *pszIter != '\0' && *pszIter != 'e' && *pszIter != 'E' )
+        {
+            if( *pszIter >= '0' && *pszIter <= '9' )
+                szDigits[nDigits++] = *pszIter;
+            pszIter ++;
+        }
+        if( *pszIter == '\0' || nDigits == 0 )
+            break;
+
+        nRet = OGRFormatDecimalDigits( pszBuffer, nBufferLen, bNegative,
+                                       szDigits, nDigits,
+                                       atoi(pszIter + 1) + 1 );
+        if( nRet < 0 || nPrecision == 17
+            || OGRFastAtof( pszBuffer ) == dfVal )
+            break;
+    }
+
+    return nRet;
+}
+
+/************************************************************************/
+/*                     OGRUseDoubleRoundTripFormat()                    */
+/*                                                                      */
+/*      Whether doubles written as text (WKT coordinates and the        */
+/*      formats built on OGRMakeWktCoordinate(), GeoJSON without        */
+/*      COORDINATE_PRECISION, OGR SQL constants) use                    */
+/*      OGRFormatDoubleRoundTrip() instead of the traditional 15        */
+/*      significant digits.  Off by default, since it changes the       */
+/*      output of all those writers.                                    */
+/************************************************************************/
+
+int OGRUseDoubleRoundTripFormat()
+
+{
+    return CSLTestBoolean(
+        CPLGetConfigOption( "OGR_DOUBLE_ROUND_TRIP", "NO" ) );
+}
+
 /************************************************************************/
 /*                        OGRMakeWktCoordinate()                        */
 /*                                                                      */
@@ -166,6 +501,10 @@ void OGRFormatDouble( char *pszBuffer, int nBufferLen, double dfVal, char chDeci
 /*                                                                      */
 /*      Currently a new point should require no more than 64            */
 /*      characters barring the X or Y value being extremely large.      */
+/*                                                                      */
+/*      With OGR_DOUBLE_ROUND_TRIP=YES, non integral values are         */
+/*      written with as many digits as needed to read them back         */
+/*      exactly.                                                        */
 /************************************************************************/
 
 void OGRMakeWktCoordinate( char *pszTarget, double x, double y, double z, 
@@ -182,12 +521,18 @@ void OGRMakeWktCoordinate( char *pszTarget, double x, double y, double z,
     szZ[0] = '\0';
 
     int nLenX, nLenY;
+    int bRoundTrip = -1;
 
     if( x == (int) x && y == (int) y )
     {
         snprintf( szX, bufSize, "%d", (int) x );
         snprintf( szY, bufSize, "%d", (int) y );
     }
+    else if( (bRoundTrip = OGRUseDoubleRoundTripFormat()) )
+    {
+        OGRFormatDoubleRoundTrip( szX, bufSize, x );
+        OGRFormatDoubleRoundTrip( szY, bufSize, y );
+    }
     else
     {
         OGRFormatDouble( szX, bufSize, x, '.' );
@@ -205,7 +550,12 @@ void OGRMakeWktCoordinate( char *pszTarget, double x, double y, double z,
         }
         else
         {
-            OGRFormatDouble( szZ, bufSize, z, '.' );
+            if( bRoundTrip < 0 )
+                bRoundTrip = OGRUseDoubleRoundTripFormat();
+            if( bRoundTrip )
+                OGRFormatDoubleRoundTrip( szZ, bufSize, z );
+            else
+                OGRFormatDouble( szZ, bufSize, z, '.' );
         }
     }
 
@@ -300,6 +650,65 @@ const char *OGRWktReadToken( const char * pszInput, char * pszToken )
     return( pszInput );
 }
 
+/************************************************************************/
+/*                       OGRWktReadNumberToken()                        */
+/*                                                                      */
+/*      Read one token or delimeter exactly as OGRWktReadToken()        */
+/*      does, but without copying it.  *pchFirst receives its first     */
+/*      character ('\0' for an empty token) and, if it looks like a     */
+/*      number, *pdfValue receives its value.                           */
+/************************************************************************/
+
+#define OGRWktIsNumberStart(ch) (isdigit(ch) || (ch) == '-' || (ch) == '.')
+
+static const char *OGRWktReadNumberToken( const char *pszInput,
+                                          char *pchFirst, double *pdfValue )
+
+{
+    while( *pszInput == ' ' || *pszInput == '\t' )
+        pszInput++;
+
+    if( *pszInput == '(' || *pszInput == ')' || *pszInput == ',' )
+    {
+        *pchFirst = *pszInput;
+        pszInput++;
+    }
+    else
+    {
+        const char *pszToken = pszInput;
+        int         nLen = 0;
+
+        while( nLen < OGR_WKT_TOKEN_MAX-1
+               && ((*pszInput >= 'a' && *pszInput <= 'z')
+                   || (*pszInput >= 'A' && *pszInput <= 'Z')
+                   || (*pszInput >= '0' && *pszInput <= '9')
+                   || *pszInput == '.' 
+                   || *pszInput == '+' 
+                   || *pszInput == '-') )
+        {
+            pszInput++;
+            nLen++;
+        }
+
+        *pchFirst = (nLen > 0) ? *pszToken : '\0';
+
+        if( OGRWktIsNumberStart(*pchFirst)
+            && OGRParseDoubleFast( pszToken, pdfValue ) != nLen )
+        {
+            char szToken[OGR_WKT_TOKEN_MAX];
+
+            memcpy( szToken, pszToken, nLen );
+            szToken[nLen] = '\0';
+            *pdfValue = CPLAtof( szToken );
+        }
+    }
+
+    while( *pszInput == ' ' || *pszInput == '\t' )
+        pszInput++;
+
+    return pszInput;
+}
+
 /************************************************************************/
 /*                          OGRWktReadPoints()                          */
 /*                                                                      */
@@ -344,20 +753,19 @@ const char * OGRWktReadPoints( const char * pszInput,
 /*      run out of well formed points, or a closing bracket is          */
 /*      encountered.                                                    */
 /* ==================================================================== */
-    char        szDelim[OGR_WKT_TOKEN_MAX];
+    char        chDelim;
     
     do {
 /* -------------------------------------------------------------------- */
 /*      Read the X and Y values, verify they are numeric.               */
 /* -------------------------------------------------------------------- */
-        char    szTokenX[OGR_WKT_TOKEN_MAX];
-        char    szTokenY[OGR_WKT_TOKEN_MAX];
+        char    chX, chY;
+        double  dfX = 0.0, dfY = 0.0, dfValue = 0.0;
 
-        pszInput = OGRWktReadToken( pszInput, szTokenX );
-        pszInput = OGRWktReadToken( pszInput, szTokenY );
+        pszInput = OGRWktReadNumberToken( pszInput, &chX, &dfX );
+        pszInput = OGRWktReadNumberToken( pszInput, &chY, &dfY );
 
-        if( (!isdigit(szTokenX[0]) && szTokenX[0] != '-' && szTokenX[0] != '.' )
-            || (!isdigit(szTokenY[0]) && szTokenY[0] != '-' && szTokenY[0] != '.') )
+        if( !OGRWktIsNumberStart(chX) || !OGRWktIsNumberStart(chY) )
             return NULL;
 
 /* -------------------------------------------------------------------- */
@@ -379,24 +787,24 @@ const char * OGRWktReadPoints( const char * pszInput,
 /* -------------------------------------------------------------------- */
 /*      Add point to list.                                              */
 /* -------------------------------------------------------------------- */
-        (*ppaoPoints)[*pnPointsRead].x = CPLAtof(szTokenX);
-        (*ppaoPoints)[*pnPointsRead].y = CPLAtof(szTokenY);
+        (*ppaoPoints)[*pnPointsRead].x = dfX;
+        (*ppaoPoints)[*pnPointsRead].y = dfY;
 
 /* -------------------------------------------------------------------- */
 /*      Do we have a Z coordinate?                                      */
 /* -------------------------------------------------------------------- */
-        pszInput = OGRWktReadToken( pszInput, szDelim );
+        pszInput = OGRWktReadNumberToken( pszInput, &chDelim, &dfValue );
 
-        if( isdigit(szDelim[0]) || szDelim[0] == '-' || szDelim[0] == '.' )
+        if( OGRWktIsNumberStart(chDelim) )
         {
             if( *ppadfZ == NULL )
             {
                 *ppadfZ = (double *) CPLCalloc(sizeof(double),*pnMaxPoints);
             }
 
-            (*ppadfZ)[*pnPointsRead] = CPLAtof(szDelim);
+            (*ppadfZ)[*pnPointsRead] = dfValue;
 
-            pszInput = OGRWktReadToken( pszInput, szDelim );
+            pszInput = OGRWktReadNumberToken( pszInput, &chDelim, &dfValue );
         }
         else if ( *ppadfZ != NULL )
             (*ppadfZ)[*pnPointsRead] = 0.0;
@@ -407,25 +815,25 @@ const char * OGRWktReadPoints( const char * pszInput,
 /*      Do we have a M coordinate?                                      */
 /*      If we do, just skip it.                                         */
 /* -------------------------------------------------------------------- */
-        if( isdigit(szDelim[0]) || szDelim[0] == '-' || szDelim[0] == '.' )
+        if( OGRWktIsNumberStart(chDelim) )
         {
-            pszInput = OGRWktReadToken( pszInput, szDelim );
+            pszInput = OGRWktReadNumberToken( pszInput, &chDelim, &dfValue );
         }
         
 /* -------------------------------------------------------------------- */
 /*      Read next delimeter ... it should be a comma if there are       */
 /*      more points.                                                    */
 /* -------------------------------------------------------------------- */
-        if( szDelim[0] != ')' && szDelim[0] != ',' )
+        if( chDelim != ')' && chDelim != ',' )
         {
             CPLDebug( "OGR",
                       "Corrupt input in OGRWktReadPoints()\n"
-                      "Got `%s' when expecting `,' or `)', near `%s' in %s.\n",
-                      szDelim, pszInput, pszOrigInput );
+                      "Got `%c' when expecting `,' or `)', near `%s' in %s.\n",
+                      chDelim ? chDelim : ' ', pszInput, pszOrigInput );
             return NULL;
         }
         
-    } while( szDelim[0] == ',' );
+    } while( chDelim == ',' );
 
     return pszInput;
 }
@@ -1296,7 +1704,7 @@ int OGRCompareDate(   OGRField *psFirstTuple,
 /* On Windows, atof() is very slow if the number */
 /* is followed by other long content. */
 /* So we just extract the number into a short string */
-/* before calling atof() on it */
+/* before calling CPLAtof() on it */
 static
 double OGRCallAtofOnShortString(const char* pszStr)
 {
@@ -1313,80 +1721,34 @@ double OGRCallAtofOnShortString(const char* pszStr)
     {
         szTemp[nCounter++] = *(p++);
         if (nCounter == 127)
-            return atof(pszStr);
+            return CPLAtof(pszStr);
     }
     szTemp[nCounter] = '\0';
-    return atof(szTemp);
+    return CPLAtof(szTemp);
 }
 
-/** Same contract as CPLAtof, except than it doesn't always call the
- *  system atof() that may be slow on some platforms. For simple but
- *  common strings, it'll use a faster implementation (up to 20x faster
- *  than atof() on MS runtime libraries) that has no garanty to return
- *  exactly the same floating point number.
+/**
+ * Same contract as CPLAtof, except than it doesn't always call the
+ * system atof() that may be slow on some platforms. For simple but
+ * common strings (about 15 significant digits, small exponents), it
+ * computes the value directly, which is both much faster and exact: the
+ * result is the same floating point number as CPLAtof() returns.  Other
+ * decimal numbers are handed to CPLAtof(), so the result never depends
+ * on the locale.  Hexadecimal numbers, "inf" and "nan" are not supported.
  */
- 
+
 double OGRFastAtof(const char* pszStr)
 {
-    double dfVal = 0;
-    double dfSign = 1.0;
     const char* p = pszStr;
-    
-    static const double adfTenPower[] =
-    {
-        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
-        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
-        1e21, 1e22, 1e23, 1e24, 1e25, 1e26, 1e27, 1e28, 1e29, 1e30, 1e31
-    };
-        
+    double dfVal;
+
     while(*p == ' ' || *p == '\t')
         p++;
 
-    if (*p == '+')
-        p++;
-    else if (*p == '-')
-    {
-        dfSign = -1.0;
-        p++;
-    }
-    
-    while(TRUE)
-    {
-        if (*p >= '0' && *p <= '9')
-        {
-            dfVal = dfVal * 10.0 + (*p - '0');
-            p++;
-        }
-        else if (*p == '.')
-        {
-            p++;
-            break;
-        }
-        else if (*p == 'e' || *p == 'E' || *p == 'd' || *p == 'D')
-            return OGRCallAtofOnShortString(pszStr);
-        else
-            return dfSign * dfVal;
-    }
-    
-    unsigned int countFractionnal = 0;
-    while(TRUE)
-    {
-        if (*p >= '0' && *p <= '9')
-        {
-            dfVal = dfVal * 10.0 + (*p - '0');
-            countFractionnal ++;
-            p++;
-        }
-        else if (*p == 'e' || *p == 'E' || *p == 'd' || *p == 'D')
-            return OGRCallAtofOnShortString(pszStr);
-        else
-        {
-            if (countFractionnal < sizeof(adfTenPower) / sizeof(adfTenPower[0]))
-                return dfSign * (dfVal / adfTenPower[countFractionnal]);
-            else
-                return OGRCallAtofOnShortString(pszStr);
-        }
-    }
+    if( OGRParseDoubleFast( p, &dfVal ) > 0 )
+        return dfVal;
+
+    return OGRCallAtofOnShortString(pszStr);
 }
 
 /**
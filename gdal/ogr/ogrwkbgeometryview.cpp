@@ -0,0 +1,598 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  The OGRWKBGeometryView class, a read-only view over a well
+ *           known binary geometry that does not copy its coordinates.
+ *
+ ******************************************************************************
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_geometry.h"
+#include "ogr_p.h"
+
+CPL_CVSID("$Id$");
+
+/************************************************************************/
+/*                         OGRWKBGeometryView()                         */
+/************************************************************************/
+
+OGRWKBGeometryView::OGRWKBGeometryView()
+
+{
+    pabyData = NULL;
+    nSize = 0;
+    eGeometryType = wkbUnknown;
+    nCoordDimension = 0;
+    nTotalPoints = 0;
+    bCanonicalNDR = FALSE;
+    nSequences = 0;
+    nMaxSequences = 0;
+    pasSequences = NULL;
+}
+
+/************************************************************************/
+/*                         OGRWKBGeometryView()                         */
+/************************************************************************/
+
+/**
+ * Constructor.
+ *
+ * Equivalent to the default constructor followed by Init().  IsValid()
+ * can be used to check that the buffer was recognised.
+ *
+ * @param pabyDataIn the WKB buffer, which is not copied.
+ * @param nSizeIn the size of the buffer in bytes.
+ */
+
+OGRWKBGeometryView::OGRWKBGeometryView( const GByte *pabyDataIn,
+                                        int nSizeIn )
+
+{
+    pabyData = NULL;
+    nSize = 0;
+    eGeometryType = wkbUnknown;
+    nCoordDimension = 0;
+    nTotalPoints = 0;
+    bCanonicalNDR = FALSE;
+    nSequences = 0;
+    nMaxSequences = 0;
+    pasSequences = NULL;
+
+    Init( pabyDataIn, nSizeIn );
+}
+
+/************************************************************************/
+/*                        ~OGRWKBGeometryView()                         */
+/************************************************************************/
+
+OGRWKBGeometryView::~OGRWKBGeometryView()
+
+{
+    CPLFree( pasSequences );
+}
+
+/************************************************************************/
+/*                                Init()                                */
+/************************************************************************/
+
+/**
+ * Attach the view to a WKB buffer.
+ *
+ * The structure of the geometry is validated (byte orders, geometry
+ * types, element counts against the buffer size) and the offsets of its
+ * point sequences are recorded.  Coordinates are not read.
+ *
+ * Points, line strings, polygons, their multi variants and geometry
+ * collections are supported.
+ *
+ * IsCanonicalNDR() then tells whether the buffer is already byte for
+ * byte what exportToWkb(wkbNDR) would write for the decoded geometry, in
+ * which case it can be copied as is where such WKB is expected.
+ *
+ * @param pabyDataIn the WKB buffer, which is not copied and must outlive
+ * the view.
+ * @param nSizeIn the size of the buffer in bytes.  Trailing bytes after
+ * the geometry are ignored.
+ *
+ * @return OGRERR_NONE on success, OGRERR_NOT_ENOUGH_DATA,
+ * OGRERR_CORRUPT_DATA or OGRERR_UNSUPPORTED_GEOMETRY_TYPE otherwise, in
+ * which case the view is left empty.
+ */
+
+OGRErr OGRWKBGeometryView::Init( const GByte *pabyDataIn, int nSizeIn )
+
+{
+    OGRErr eErr;
+    int    nBytesConsumed = 0;
+
+    pabyData = pabyDataIn;
+    nSize = nSizeIn;
+    eGeometryType = wkbUnknown;
+    nCoordDimension = 0;
+    nTotalPoints = 0;
+    bCanonicalNDR = TRUE;
+    nSequences = 0;
+
+    if( pabyDataIn == NULL || nSizeIn < 5 )
+        eErr = OGRERR_NOT_ENOUGH_DATA;
+    else
+        eErr = Walk( 0, 0, &nBytesConsumed );
+
+    if( eErr != OGRERR_NONE )
+    {
+        pabyData = NULL;
+        nSize = 0;
+        eGeometryType = wkbUnknown;
+        nCoordDimension = 0;
+        nTotalPoints = 0;
+        bCanonicalNDR = FALSE;
+        nSequences = 0;
+        return eErr;
+    }
+
+    nSize = nBytesConsumed;
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                            AddSequence()                             */
+/************************************************************************/
+
+OGRErr OGRWKBGeometryView::AddSequence( int nOffset, int nPoints,
+                                        int bNeedSwap, int bHasZ )
+
+{
+    OGRWKBPointSequence *psSeq;
+
+    if( bHasZ )
+        nCoordDimension = 3;
+
+    /* Empty sequences carry no coordinates, and skipping them keeps */
+    /* the binary search in FindSequence() simple. */
+    if( nPoints == 0 )
+        return OGRERR_NONE;
+
+/* -------------------------------------------------------------------- */
+/*      The first sequence lives in the object itself, which spares     */
+/*      an allocation for points and line strings.                      */
+/* -------------------------------------------------------------------- */
+    if( nSequences == 0 )
+        psSeq = &sInlineSequence;
+    else
+    {
+        if( nSequences + 1 > nMaxSequences )
+        {
+            nMaxSequences = nMaxSequences * 2 + 8;
+            pasSequences = (OGRWKBPointSequence *)
+                VSIRealloc( pasSequences,
+                            sizeof(OGRWKBPointSequence) * nMaxSequences );
+            if( pasSequences == NULL )
+            {
+                nMaxSequences = 0;
+                return OGRERR_NOT_ENOUGH_MEMORY;
+            }
+        }
+        if( nSequences == 1 )
+            pasSequences[0] = sInlineSequence;
+        psSeq = pasSequences + nSequences;
+    }
+
+    psSeq->nOffset = nOffset;
+    psSeq->nPoints = nPoints;
+    psSeq->nFirstPoint = nTotalPoints;
+    psSeq->bNeedSwap = bNeedSwap;
+    psSeq->bHasZ = bHasZ;
+
+    nSequences ++;
+    nTotalPoints += nPoints;
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                                Walk()                                */
+/*                                                                      */
+/*      Validate the geometry starting at nOffset and record its        */
+/*      point sequences.                                                */
+/************************************************************************/
+
+OGRErr OGRWKBGeometryView::Walk( int nOffset, int nRecLevel,
+                                 int *pnBytesConsumed )
+
+{
+    const GByte *pabyGeom = pabyData + nOffset;
+    int          nRemaining = nSize - nOffset;
+    OGRErr       eErr;
+
+    /* Arbitrary value, but certainly large enough for reasonable usages ! */
+    if( nRecLevel == 32 )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Too many recursion levels (%d) while parsing WKB geometry.",
+                  nRecLevel );
+        return OGRERR_CORRUPT_DATA;
+    }
+
+    if( nRemaining < 5 )
+        return OGRERR_NOT_ENOUGH_DATA;
+
+/* -------------------------------------------------------------------- */
+/*      Get the byte order, geometry type and dimension, in the same    */
+/*      way as the importFromWkb() methods.                             */
+/* -------------------------------------------------------------------- */
+    OGRwkbByteOrder    eByteOrder;
+    OGRwkbGeometryType eType;
+    int                bIs3D, bNeedSwap, nCoordSize;
+
+    eByteOrder = DB2_V72_FIX_BYTE_ORDER((OGRwkbByteOrder) *pabyGeom);
+    if( eByteOrder != wkbXDR && eByteOrder != wkbNDR )
+        return OGRERR_CORRUPT_DATA;
+
+    if( eByteOrder == wkbNDR )
+    {
+        eType = (OGRwkbGeometryType) pabyGeom[1];
+        bIs3D = pabyGeom[4] & 0x80 || pabyGeom[2] & 0x80;
+    }
+    else
+    {
+        eType = (OGRwkbGeometryType) pabyGeom[4];
+        bIs3D = pabyGeom[1] & 0x80 || pabyGeom[3] & 0x80;
+    }
+
+    bNeedSwap = OGR_SWAP( eByteOrder );
+    nCoordSize = bIs3D ? 24 : 16;
+
+    if( nRecLevel == 0 )
+    {
+        eGeometryType = (OGRwkbGeometryType)
+            (eType | (bIs3D ? wkb25DBit : 0));
+        nCoordDimension = bIs3D ? 3 : 2;
+    }
+    else if( bIs3D )
+        nCoordDimension = 3;
+
+/* -------------------------------------------------------------------- */
+/*      exportToWkb(wkbNDR) writes a little endian header with the OGR  */
+/*      type code, and members with the dimension of the top level      */
+/*      geometry.  Anything else is not canonical.                      */
+/* -------------------------------------------------------------------- */
+    if( bCanonicalNDR )
+    {
+        GUInt32 nTypeCode;
+
+        memcpy( &nTypeCode, pabyGeom + 1, 4 );
+        CPL_LSBPTR32( &nTypeCode );
+
+        if( *pabyGeom != wkbNDR
+            || nTypeCode != ((GUInt32) eType | (bIs3D ? wkb25DBit : 0))
+            || bIs3D != ((eGeometryType & wkb25DBit) != 0) )
+            bCanonicalNDR = FALSE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Point.                                                          */
+/* -------------------------------------------------------------------- */
+    if( eType == wkbPoint )
+    {
+        if( nRemaining < 5 + nCoordSize )
+            return OGRERR_NOT_ENOUGH_DATA;
+
+        *pnBytesConsumed = 5 + nCoordSize;
+        return AddSequence( nOffset + 5, 1, bNeedSwap, bIs3D );
+    }
+
+    if( eType != wkbLineString && eType != wkbPolygon
+        && eType != wkbMultiPoint && eType != wkbMultiLineString
+        && eType != wkbMultiPolygon && eType != wkbGeometryCollection )
+        return OGRERR_UNSUPPORTED_GEOMETRY_TYPE;
+
+/* -------------------------------------------------------------------- */
+/*      All other types start with an element count.                    */
+/* -------------------------------------------------------------------- */
+    GInt32 nCount;
+
+    if( nRemaining < 9 )
+        return OGRERR_NOT_ENOUGH_DATA;
+
+    memcpy( &nCount, pabyGeom + 5, 4 );
+    if( bNeedSwap )
+        CPL_SWAP32PTR( &nCount );
+
+    if( nCount < 0 )
+        return OGRERR_CORRUPT_DATA;
+
+/* -------------------------------------------------------------------- */
+/*      LineString.                                                     */
+/* -------------------------------------------------------------------- */
+    if( eType == wkbLineString )
+    {
+        if( nCount > (nRemaining - 9) / nCoordSize )
+            return OGRERR_NOT_ENOUGH_DATA;
+
+        *pnBytesConsumed = 9 + nCount * nCoordSize;
+        return AddSequence( nOffset + 9, nCount, bNeedSwap, bIs3D );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Polygon: the rings have no header of their own.                 */
+/* -------------------------------------------------------------------- */
+    if( eType == wkbPolygon )
+    {
+        int iRing, nRingOffset = 9;
+
+        /* Each ring takes at least 4 bytes for its point count. */
+        if( nCount > (nRemaining - 9) / 4 )
+            return OGRERR_NOT_ENOUGH_DATA;
+
+        for( iRing = 0; iRing < nCount; iRing++ )
+        {
+            GInt32 nPoints;
+
+            if( nRemaining - nRingOffset < 4 )
+                return OGRERR_NOT_ENOUGH_DATA;
+
+            memcpy( &nPoints, pabyGeom + nRingOffset, 4 );
+            if( bNeedSwap )
+                CPL_SWAP32PTR( &nPoints );
+            nRingOffset += 4;
+
+            if( nPoints < 0 )
+                return OGRERR_CORRUPT_DATA;
+            if( nPoints > (nRemaining - nRingOffset) / nCoordSize )
+                return OGRERR_NOT_ENOUGH_DATA;
+
+            eErr = AddSequence( nOffset + nRingOffset, nPoints,
+                                bNeedSwap, bIs3D );
+            if( eErr != OGRERR_NONE )
+                return eErr;
+
+            nRingOffset += nPoints * nCoordSize;
+        }
+
+        *pnBytesConsumed = nRingOffset;
+        return OGRERR_NONE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Multi geometries and collections: each member is a complete     */
+/*      WKB geometry with its own byte order.                           */
+/* -------------------------------------------------------------------- */
+    OGRwkbGeometryType eMemberType = wkbUnknown;
+    int iGeom, nGeomOffset = 9;
+
+    if( eType == wkbMultiPoint )
+        eMemberType = wkbPoint;
+    else if( eType == wkbMultiLineString )
+        eMemberType = wkbLineString;
+    else if( eType == wkbMultiPolygon )
+        eMemberType = wkbPolygon;
+
+    /* Each member takes at least 9 bytes. */
+    if( nCount > (nRemaining - 9) / 9 )
+        return OGRERR_NOT_ENOUGH_DATA;
+
+    /* The dimension of a collection comes from its members only, so */
+    /* an empty one is always written as 2D. */
+    if( nCount == 0 && bIs3D )
+        bCanonicalNDR = FALSE;
+
+    for( iGeom = 0; iGeom < nCount; iGeom++ )
+    {
+        int nSubBytesConsumed = 0;
+
+        if( eMemberType != wkbUnknown && nRemaining - nGeomOffset >= 5 )
+        {
+            const GByte *pabySub = pabyGeom + nGeomOffset;
+            OGRwkbGeometryType eSubType;
+
+            if( DB2_V72_FIX_BYTE_ORDER((OGRwkbByteOrder) *pabySub) == wkbNDR )
+                eSubType = (OGRwkbGeometryType) pabySub[1];
+            else
+                eSubType = (OGRwkbGeometryType) pabySub[4];
+
+            if( eSubType != eMemberType )
+                return OGRERR_CORRUPT_DATA;
+        }
+
+        eErr = Walk( nOffset + nGeomOffset, nRecLevel + 1,
+                     &nSubBytesConsumed );
+        if( eErr != OGRERR_NONE )
+            return eErr;
+
+        nGeomOffset += nSubBytesConsumed;
+    }
+
+    *pnBytesConsumed = nGeomOffset;
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                            FindSequence()                            */
+/************************************************************************/
+
+const OGRWKBGeometryView::OGRWKBPointSequence *
+OGRWKBGeometryView::FindSequence( int iPoint ) const
+
+{
+    if( iPoint < 0 || iPoint >= nTotalPoints )
+        return NULL;
+
+    if( nSequences == 1 )
+        return &sInlineSequence;
+
+/* -------------------------------------------------------------------- */
+/*      Binary search for the last sequence starting at or before       */
+/*      iPoint.                                                         */
+/* -------------------------------------------------------------------- */
+    int nLo = 0, nHi = nSequences - 1;
+
+    while( nLo < nHi )
+    {
+        int nMid = (nLo + nHi + 1) / 2;
+
+        if( pasSequences[nMid].nFirstPoint <= iPoint )
+            nLo = nMid;
+        else
+            nHi = nMid - 1;
+    }
+
+    return pasSequences + nLo;
+}
+
+/************************************************************************/
+/*                             ReadCoord()                              */
+/************************************************************************/
+
+double OGRWKBGeometryView::ReadCoord( int iPoint, int iCoord ) const
+
+{
+    const OGRWKBPointSequence *psSeq = FindSequence( iPoint );
+    double dfValue;
+
+    if( psSeq == NULL )
+        return 0.0;
+
+    memcpy( &dfValue,
+            pabyData + psSeq->nOffset
+            + (iPoint - psSeq->nFirstPoint) * (psSeq->bHasZ ? 24 : 16)
+            + iCoord * 8, 8 );
+    if( psSeq->bNeedSwap )
+        CPL_SWAPDOUBLE( &dfValue );
+
+    return dfValue;
+}
+
+/************************************************************************/
+/*                                getZ()                                */
+/************************************************************************/
+
+/**
+ * Fetch the Z coordinate of a vertex.
+ *
+ * Vertices are numbered across all the point sequences of the geometry,
+ * in WKB order.
+ *
+ * @param iPoint the vertex index, between 0 and getNumPoints()-1.
+ *
+ * @return the Z value, or 0 if the vertex has no Z or is out of range.
+ */
+
+double OGRWKBGeometryView::getZ( int iPoint ) const
+
+{
+    const OGRWKBPointSequence *psSeq = FindSequence( iPoint );
+
+    if( psSeq == NULL || !psSeq->bHasZ )
+        return 0.0;
+
+    return ReadCoord( iPoint, 2 );
+}
+
+/************************************************************************/
+/*                            getEnvelope()                             */
+/************************************************************************/
+
+/**
+ * Compute the 2D envelope of the geometry from the WKB buffer.
+ *
+ * The result is identical to OGRGeometry::getEnvelope() on the decoded
+ * geometry.  An empty geometry yields an envelope of zeros.
+ *
+ * @param psEnvelope the structure in which to place the results.
+ */
+
+void OGRWKBGeometryView::getEnvelope( OGREnvelope *psEnvelope ) const
+
+{
+    const OGRWKBPointSequence *pasSeq =
+        (nSequences == 1) ? &sInlineSequence : pasSequences;
+    int iSeq, bFirst = TRUE;
+
+    psEnvelope->MinX = psEnvelope->MaxX = 0;
+    psEnvelope->MinY = psEnvelope->MaxY = 0;
+
+    for( iSeq = 0; iSeq < nSequences; iSeq++ )
+    {
+        const OGRWKBPointSequence *psSeq = pasSeq + iSeq;
+        const GByte *pabyPoint = pabyData + psSeq->nOffset;
+        int nStride = psSeq->bHasZ ? 24 : 16;
+        int i;
+
+        for( i = 0; i < psSeq->nPoints; i++, pabyPoint += nStride )
+        {
+            double adfXY[2];
+
+            memcpy( adfXY, pabyPoint, 16 );
+            if( psSeq->bNeedSwap )
+            {
+                CPL_SWAPDOUBLE( adfXY );
+                CPL_SWAPDOUBLE( adfXY + 1 );
+            }
+
+            if( bFirst )
+            {
+                psEnvelope->MinX = psEnvelope->MaxX = adfXY[0];
+                psEnvelope->MinY = psEnvelope->MaxY = adfXY[1];
+                bFirst = FALSE;
+                continue;
+            }
+
+            if( adfXY[0] < psEnvelope->MinX )
+                psEnvelope->MinX = adfXY[0];
+            else if( adfXY[0] > psEnvelope->MaxX )
+                psEnvelope->MaxX = adfXY[0];
+            if( adfXY[1] < psEnvelope->MinY )
+                psEnvelope->MinY = adfXY[1];
+            else if( adfXY[1] > psEnvelope->MaxY )
+                psEnvelope->MaxY = adfXY[1];
+        }
+    }
+}
+
+/************************************************************************/
+/*                           createGeometry()                           */
+/************************************************************************/
+
+/**
+ * Materialize the viewed geometry as an OGRGeometry.
+ *
+ * @param poSRS spatial reference to assign to the geometry, or NULL.
+ * @param ppoReturn location in which the new geometry is returned.  It
+ * becomes the responsibility of the caller.
+ *
+ * @return OGRERR_NONE on success, or the error of
+ * OGRGeometryFactory::createFromWkb().
+ */
+
+OGRErr OGRWKBGeometryView::createGeometry( OGRSpatialReference *poSRS,
+                                           OGRGeometry **ppoReturn ) const
+
+{
+    *ppoReturn = NULL;
+
+    if( pabyData == NULL )
+        return OGRERR_CORRUPT_DATA;
+
+    return OGRGeometryFactory::createFromWkb( (unsigned char *) pabyData,
+                                              poSRS, ppoReturn, nSize );
+}
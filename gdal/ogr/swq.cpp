@@ -233,6 +233,8 @@ int swqlex( YYSTYPE *ppNode, swq_parse_context *context )
             nReturn = SWQT_WHERE;
         else if( EQUAL(osToken,"ON") )
             nReturn = SWQT_ON;
+        else if( EQUAL(osToken,"GROUP") )
+            nReturn = SWQT_GROUP;
         else if( EQUAL(osToken,"ORDER") )
             nReturn = SWQT_ORDER;
         else if( EQUAL(osToken,"BY") )
@@ -762,6 +764,7 @@ static const char* apszSQLReservedKeywords[] = {
     "JOIN",
     "WHERE",
     "ON",
+    "GROUP",
     "ORDER",
     "BY",
     "FROM",
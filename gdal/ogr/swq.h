@@ -204,7 +204,7 @@ CPLErr swq_expr_compile2( const char *where_clause,
 /*
 ** Evaluation related.
 */
-int swq_test_like( const char *input, const char *pattern );
+int swq_test_like( const char *input, const char *pattern, char chEscape );
 
 swq_expr_node *SWQGeneralEvaluator( swq_expr_node *, swq_expr_node **);
 swq_field_type SWQGeneralChecker( swq_expr_node *node );
@@ -219,6 +219,7 @@ const char*    SWQFieldTypeToString( swq_field_type field_type );
 #define SWQM_SUMMARY_RECORD  1
 #define SWQM_RECORDSET       2
 #define SWQM_DISTINCT_LIST   3
+#define SWQM_GROUP_BY        4
 
 typedef enum {
     SWQCF_NONE = 0,
@@ -262,6 +263,13 @@ typedef struct {
     int   ascending_flag;
 } swq_order_def;
 
+typedef struct {
+    char *field_name;
+    int   table_index;
+    int   field_index;
+    swq_field_type field_type;
+} swq_group_def;
+
 typedef struct {
     int        secondary_table;
 
@@ -304,6 +312,10 @@ public:
 
     swq_expr_node *where_expr;
 
+    void        PushGroupBy( const char *pszFieldName );
+    int         group_by_count;
+    swq_group_def *group_by_defs;
+
     void        PushOrderBy( const char *pszFieldName, int bAscending );
     int         order_specs;
     swq_order_def *order_defs;
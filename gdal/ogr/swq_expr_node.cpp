@@ -31,6 +31,7 @@
 #include "cpl_multiproc.h"
 #include "swq.h"
 #include "ogr_geometry.h"
+#include "ogr_p.h"
 #include <vector>
 
 /************************************************************************/
@@ -385,6 +386,15 @@ char *swq_expr_node::Unparse( swq_field_list *field_list, char chColumnQuote )
 
         if( field_type == SWQ_INTEGER || field_type == SWQ_BOOLEAN )
             osExpr.Printf( "%d", int_value );
+        else if( field_type == SWQ_FLOAT && OGRUseDoubleRoundTripFormat() )
+        {
+            /* Shortest exact representation, whatever the locale. It */
+            /* always has a '.' or an exponent, so that it is interpreted */
+            /* as a floating point value and not as an integer later */
+            char szBuffer[64];
+            OGRFormatDoubleRoundTrip( szBuffer, sizeof(szBuffer), float_value );
+            osExpr = szBuffer;
+        }
         else if( field_type == SWQ_FLOAT )
         {
             osExpr.Printf( "%.15g", float_value );
@@ -69,6 +69,7 @@
 %token SWQT_JOIN                "JOIN"
 %token SWQT_WHERE               "WHERE"
 %token SWQT_ON                  "ON"
+%token SWQT_GROUP               "GROUP"
 %token SWQT_ORDER               "ORDER"
 %token SWQT_BY                  "BY"
 %token SWQT_FROM                "FROM"
@@ -548,7 +549,7 @@ select_statement:
     | '(' select_core ')' opt_union_all
 
 select_core:
-    SWQT_SELECT select_field_list SWQT_FROM table_def opt_joins opt_where opt_order_by
+    SWQT_SELECT select_field_list SWQT_FROM table_def opt_joins opt_where opt_group_by opt_order_by
     {
         delete $4;
     }
@@ -806,6 +807,21 @@ opt_joins:
             delete $7;
 	    }
 
+opt_group_by:
+    | SWQT_GROUP SWQT_BY group_spec_list
+
+group_spec_list:
+    group_spec ',' group_spec_list
+    | group_spec
+
+group_spec:
+    field_value
+        {
+            context->poCurSelect->PushGroupBy( $1->string_value );
+            delete $1;
+            $1 = NULL;
+        }
+
 opt_order_by:
     | SWQT_ORDER SWQT_BY sort_spec_list
 
@@ -52,6 +52,9 @@ swq_select::swq_select()
     
     where_expr = NULL;
 
+    group_by_count = 0;
+    group_by_defs = NULL;
+
     order_specs = 0;
     order_defs = NULL;
 
@@ -104,6 +107,13 @@ swq_select::~swq_select()
 
     CPLFree( column_summary );
 
+    for( i = 0; i < group_by_count; i++ )
+    {
+        CPLFree( group_by_defs[i].field_name );
+    }
+
+    CPLFree( group_by_defs );
+
     for( i = 0; i < order_specs; i++ )
     {
         CPLFree( order_defs[i].field_name );
@@ -204,6 +214,8 @@ void swq_select::Dump( FILE *fp )
         fprintf( fp, "  QUERY MODE: RECORDSET\n" );
     else if( query_mode == SWQM_DISTINCT_LIST )
         fprintf( fp, "  QUERY MODE: DISTINCT LIST\n" );
+    else if( query_mode == SWQM_GROUP_BY )
+        fprintf( fp, "  QUERY MODE: GROUP BY\n" );
     else
         fprintf( fp, "  QUERY MODE: %d/unknown\n", query_mode );
 
@@ -300,6 +312,18 @@ void swq_select::Dump( FILE *fp )
         where_expr->Dump( fp, 2 );
     }
 
+/* -------------------------------------------------------------------- */
+/*      Group by                                                        */
+/* -------------------------------------------------------------------- */
+
+    for( i = 0; i < group_by_count; i++ )
+    {
+        fprintf( fp, "  GROUP BY: %s (%d/%d)\n",
+                 group_by_defs[i].field_name,
+                 group_by_defs[i].table_index,
+                 group_by_defs[i].field_index );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Order by                                                        */
 /* -------------------------------------------------------------------- */
@@ -575,6 +599,23 @@ int swq_select::PushTableDef( const char *pszDataSource,
     return table_count-1;
 }
 
+/************************************************************************/
+/*                            PushGroupBy()                             */
+/************************************************************************/
+
+void swq_select::PushGroupBy( const char *pszFieldName )
+
+{
+    group_by_count++;
+    group_by_defs = (swq_group_def *) 
+        CPLRealloc( group_by_defs, sizeof(swq_group_def) * group_by_count );
+
+    group_by_defs[group_by_count-1].field_name = CPLStrdup(pszFieldName);
+    group_by_defs[group_by_count-1].table_index = -1;
+    group_by_defs[group_by_count-1].field_index = -1;
+    group_by_defs[group_by_count-1].field_type = SWQ_OTHER;
+}
+
 /************************************************************************/
 /*                            PushOrderBy()                             */
 /************************************************************************/
@@ -911,13 +952,105 @@ CPLErr swq_select::parse( swq_field_list *field_list,
         }
     }
 
+/* -------------------------------------------------------------------- */
+/*      Process column names in group by specs.                         */
+/* -------------------------------------------------------------------- */
+    for( i = 0; i < group_by_count; i++ )
+    {
+        swq_group_def *def = group_by_defs + i;
+
+        /* identify field */
+        def->field_index = swq_identify_field( def->field_name, field_list,
+                                               &(def->field_type),
+                                               &(def->table_index) );
+        if( def->field_index == -1 )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined, 
+                      "Unrecognised field name %s in GROUP BY.", 
+                     def->field_name );
+            return CE_Failure;
+        }
+
+        if( def->table_index != 0 )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "Cannot use field '%s' of a secondary table in a GROUP BY clause",
+                      def->field_name );
+            return CE_Failure;
+        }
+
+        if( def->field_type == SWQ_GEOMETRY )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "Cannot use geometry field '%s' in a GROUP BY clause",
+                      def->field_name );
+            return CE_Failure;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      In GROUP BY mode, each column must either be a column           */
+/*      function, or one of the grouping fields.                        */
+/* -------------------------------------------------------------------- */
+    if( group_by_count > 0 )
+    {
+        for( i = 0; i < result_columns; i++ )
+        {
+            swq_col_def *def = column_defs + i;
+
+            if( def->col_func == SWQCF_CUSTOM )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined,
+                          "Custom column functions not supported with GROUP BY." );
+                return CE_Failure;
+            }
+
+            if( def->col_func != SWQCF_NONE )
+            {
+                if( def->col_func == SWQCF_COUNT &&
+                    def->distinct_flag &&
+                    def->field_type == SWQ_GEOMETRY )
+                {
+                    CPLError( CE_Failure, CPLE_AppDefined,
+                              "SELECT COUNT DISTINCT on a geometry not supported." );
+                    return CE_Failure;
+                }
+                continue;
+            }
+
+            int iGroup;
+            for( iGroup = 0; iGroup < group_by_count; iGroup++ )
+            {
+                if( def->table_index == group_by_defs[iGroup].table_index &&
+                    def->field_index == group_by_defs[iGroup].field_index )
+                    break;
+            }
+
+            if( def->distinct_flag || def->field_index == -1 ||
+                (def->expr != NULL && def->expr->eNodeType != SNT_COLUMN) ||
+                def->target_type != SWQ_OTHER ||
+                iGroup == group_by_count )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined,
+                          "Column '%s' should be a GROUP BY field or be used "
+                          "in a column function.",
+                          def->field_name );
+                return CE_Failure;
+            }
+        }
+
+        query_mode = SWQM_GROUP_BY;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Check if we are producing a one row summary result or a set     */
 /*      of records.  Generate an error if we get conflicting            */
 /*      indications.                                                    */
 /* -------------------------------------------------------------------- */
-    query_mode = -1;
-    for( i = 0; i < result_columns; i++ )
+    else
+        query_mode = -1;
+
+    for( i = 0; i < result_columns && query_mode != SWQM_GROUP_BY; i++ )
     {
         swq_col_def *def = column_defs + i;
         int this_indicator = -1;
@@ -974,7 +1107,7 @@ CPLErr swq_select::parse( swq_field_list *field_list,
                   "SELECTing more than one DISTINCT field is a query not supported." );
         return CE_Failure;
     }
-    else if (result_columns == 0)
+    else if (result_columns == 0 && query_mode != SWQM_GROUP_BY)
     {
         query_mode = SWQM_RECORDSET;
     }
@@ -1063,6 +1196,25 @@ CPLErr swq_select::parse( swq_field_list *field_list,
                       def->field_name );
             return CE_Failure;
         }
+
+        if( query_mode == SWQM_GROUP_BY )
+        {
+            int iGroup;
+            for( iGroup = 0; iGroup < group_by_count; iGroup++ )
+            {
+                if( def->field_index == group_by_defs[iGroup].field_index )
+                    break;
+            }
+            if( iGroup == group_by_count )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined,
+                          "Only GROUP BY fields can be used in the ORDER BY "
+                          "clause of a GROUP BY query, which is not the "
+                          "case of '%s'.",
+                          def->field_name );
+                return CE_Failure;
+            }
+        }
     }
 
 /* -------------------------------------------------------------------- */